@@ -39,8 +39,10 @@ varying vec3 vBitangent;
 // Helper function to convert normal from tangent space to world space
 vec3 calculateNormal() {
     if (u_HasNormalTexture) {
-        // Sample normal from texture and convert from [0,1] to [-1,1]
-        vec3 normalMap = normalize(texture2D(u_NormalTexture, vTexCoord).rgb * 2.0 - 1.0);
+        // Sample normal from texture and convert from [0,1] to [-1,1]. Z is
+        // rebuilt from XY so two-channel (BC5) normal maps work as well
+        vec2 normalXY = texture2D(u_NormalTexture, vTexCoord).rg * 2.0 - 1.0;
+        vec3 normalMap = vec3(normalXY, sqrt(max(1.0 - dot(normalXY, normalXY), 0.0)));
         
         // Transform from tangent space to world space
         mat3 TBN = mat3(normalize(vTangent), normalize(vBitangent), normalize(vNormal));
@@ -7,6 +7,9 @@ uniform sampler2D uFontAtlasTexture;
 
 void main()
 {
-    float alpha = texture2D(uFontAtlasTexture, texCoord).r;
+    // Glyphs are signed distance fields with the edge at 0.5
+    float distance = texture2D(uFontAtlasTexture, texCoord).r;
+    float smoothing = fwidth(distance);
+    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
     gl_FragColor = vec4(color.rgb, color.a * alpha);
 }
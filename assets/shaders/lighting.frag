@@ -41,8 +41,10 @@ uniform int u_HasARMTexture;
 // Helper function to convert normal from tangent space to world space
 float3 calculateNormal(FragmentInput input) {
     if (u_HasNormalTexture) {
-        // Sample normal from texture and convert from [0,1] to [-1,1]
-        float3 normalMap = normalize(tex2D(u_NormalTexture, input.texCoord).rgb * 2.0f - 1.0f);
+        // Sample normal from texture and convert from [0,1] to [-1,1]. Z is
+        // rebuilt from XY so cooked normal maps only need two good channels
+        float2 normalXY = tex2D(u_NormalTexture, input.texCoord).rg * 2.0f - 1.0f;
+        float3 normalMap = float3(normalXY, sqrt(max(1.0f - dot(normalXY, normalXY), 0.0f)));
         
         // Transform from tangent space to world space
         float3x3 TBN = float3x3(normalize(input.tangent), normalize(input.bitangent), normalize(input.normal));
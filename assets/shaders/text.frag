@@ -10,8 +10,11 @@ struct FragmentInput {
 uniform sampler2D uFontAtlasTexture;
 
 float4 main(FragmentInput input) : COLOR {
-    // Sample alpha from font atlas texture
-    float alpha = tex2D(uFontAtlasTexture, input.texCoord).r;
+    // Glyphs are signed distance fields with the edge at 0.5; fade over
+    // about one screen pixel so edges stay sharp at any text size
+    float distance = tex2D(uFontAtlasTexture, input.texCoord).r;
+    float smoothing = fwidth(distance);
+    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
     
     // Apply alpha to color
     return float4(input.color.rgb, input.color.a * alpha);
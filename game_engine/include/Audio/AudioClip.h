@@ -0,0 +1,33 @@
+#ifndef AUDIO_CLIP_H
+#define AUDIO_CLIP_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GameEngine {
+
+class AudioDecoder;
+
+// Decoded PCM shared by every voice that plays it. Samples are interleaved
+// int16 (mono or stereo) at the file's own rate; the mixer resamples on the fly
+struct AudioClip {
+    std::string path;
+    int channels;
+    int sampleRate;
+    std::vector<int16_t> samples;
+
+    AudioClip() : channels(0), sampleRate(0) {}
+    size_t getFrameCount() const { return channels > 0 ? samples.size() / channels : 0; }
+    size_t getByteSize() const { return samples.size() * sizeof(int16_t); }
+
+    // Any format AudioDecoder reads. Returns nullptr (and logs) on failure
+    static std::shared_ptr<AudioClip> load(const std::string& filePath);
+    // Decodes the rest of an open decoder
+    static std::shared_ptr<AudioClip> decode(AudioDecoder& decoder);
+};
+
+} // namespace GameEngine
+
+#endif // AUDIO_CLIP_H
@@ -0,0 +1,43 @@
+#ifndef AUDIO_DECODER_H
+#define AUDIO_DECODER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace GameEngine {
+
+// Pulls interleaved int16 frames out of a sound file a chunk at a time, so
+// a clip can be decoded whole or a long track streamed through a small
+// ring. WAV (8/16 bit PCM) and Ogg Vorbis (stb_vorbis), picked by the
+// file's magic bytes
+class AudioDecoder {
+public:
+    virtual ~AudioDecoder() {}
+
+    int getChannels() const { return channels; }
+    int getSampleRate() const { return sampleRate; }
+    // Total frames in the file, as read from its header
+    uint64_t getFrameCount() const { return frameCount; }
+    const std::string& getPath() const { return path; }
+
+    // Decodes up to `frames` frames; fewer only at the end of the file
+    virtual size_t read(int16_t* output, size_t frames) = 0;
+    virtual bool rewind() = 0;
+
+    // Opens and validates the file (header only). nullptr and a log line on failure
+    static std::unique_ptr<AudioDecoder> open(const std::string& filePath);
+    static std::string resolvePath(const std::string& filePath);
+
+protected:
+    AudioDecoder() : channels(0), sampleRate(0), frameCount(0) {}
+
+    std::string path;
+    int channels;
+    int sampleRate;
+    uint64_t frameCount;
+};
+
+} // namespace GameEngine
+
+#endif // AUDIO_DECODER_H
@@ -2,22 +2,19 @@
 #define AUDIO_MANAGER_H
 
 #include "Core/ThreadManager.h"
+#include "Audio/AudioMixer.h"
+#include "Audio/AudioOutput.h"
 #include "Platform.h"
 #include <string>
 #include <atomic>
-#include <vector>
+#include <memory>
 #include <mutex>
-
-#ifdef LINUX_BUILD
-#include <AL/al.h>
-#include <AL/alc.h>
-#elif defined(VITA_BUILD)
-#include <psp2/audioout.h>
-#endif
+#include <unordered_map>
+#include <vector>
 
 namespace GameEngine {
 
-class SoundComponent;
+struct CameraSnapshot;
 
 enum class AudioCommandType {
     PLAY_SOUND,
@@ -55,16 +52,40 @@ public:
     bool isInitialized() const { return initialized; }
     float getMasterVolume() const { return masterVolume; }
     
-#ifdef VITA_BUILD
-    void registerSoundComponent(SoundComponent* component);
-    void unregisterSoundComponent(SoundComponent* component);
-#endif
+    // Every sound plays through this one mixer; nullptr until initialized
+    AudioMixer* getMixer() const { return mixer.get(); }
+    const char* getOutputName() const { return output ? output->getName() : "none"; }
+    
+    static const int MAX_VOICES = 64;          // playing sounds, audible or virtual
+    static const int MAX_MIXED_VOICES = 32;    // mixed each period
+    static const int OUTPUT_SAMPLE_RATE = 48000;
+    static const int PERIOD_FRAMES = 256;   // 5.3 ms at 48 kHz
+    // Sounds bigger than this once decoded stream from disk instead of being cached
+    static const size_t STREAMING_THRESHOLD_BYTES = 1024 * 1024;
     
-#ifdef LINUX_BUILD
-    ALCdevice* getDevice() const { return alDevice; }
-    ALCcontext* getContext() const { return alContext; }
-#elif defined(VITA_BUILD)
-#endif
+    // Short sounds come back as a clip shared by everything that loads the
+    // same path, freed with its last user; long ones as a private stream.
+    // Exactly one of the two is set on success
+    bool loadSound(const std::string& path, std::shared_ptr<const AudioClip>& clip, std::shared_ptr<AudioStream>& stream);
+    // Cached or freshly decoded, whatever its length
+    std::shared_ptr<const AudioClip> getClip(const std::string& path);
+    // Decodes a sound that loadSound would cache, from any thread, so the
+    // caller can hold it until its components load. Long sounds are left to
+    // stream and come back null, like failures
+    std::shared_ptr<const AudioClip> preloadClip(const std::string& path);
+    bool hasClip(const std::string& path) const;
+    
+    // 3D sounds queue their moves here during the frame; updateSpatial()
+    // hands them and the listener to the mixer in one batch
+    void submitEmitter(VoiceId voice, const glm::vec3& position, const glm::vec3& velocity);
+    // Once per frame after the scene update; the listener follows the camera
+    void updateSpatial(float deltaTime, const CameraSnapshot* camera);
+    const AudioListener& getListener() const { return listener; }
+    // Per-frame displacement as a velocity, zero for a teleport or a zero-length frame
+    static glm::vec3 estimateVelocity(const glm::vec3& from, const glm::vec3& to, float deltaTime);
+    size_t getCachedClipCount() const;
+    size_t getCachedClipBytes() const;
+    void clearCache();
     
 private:
     AudioManager();
@@ -82,16 +103,19 @@ private:
     float masterVolume;
     bool paused;
     
-#ifdef VITA_BUILD
-    std::vector<SoundComponent*> activeSoundComponents;
-    std::mutex soundComponentsMutex;
-#endif
+    std::unique_ptr<AudioMixer> mixer;
+    std::unique_ptr<AudioOutput> output;
+    std::vector<int16_t> periodBuffer;
+    
+    AudioListener listener;
+    bool listenerPlaced;
+    std::vector<VoiceEmitter> pendingEmitters;
+    
+    std::unordered_map<std::string, std::weak_ptr<const AudioClip>> clipCache;
+    mutable std::mutex clipCacheMutex;
     
-#ifdef LINUX_BUILD
-    ALCdevice* alDevice;
-    ALCcontext* alContext;
-#elif defined(VITA_BUILD)
-#endif
+    std::shared_ptr<const AudioClip> findCachedClip(const std::string& path) const;
+    std::shared_ptr<const AudioClip> cacheClip(const std::shared_ptr<const AudioClip>& clip);
     
     void audioThreadFunction();
     void processAudioCommand(const AudioCommand& cmd);
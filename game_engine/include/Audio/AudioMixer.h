@@ -0,0 +1,190 @@
+#ifndef AUDIO_MIXER_H
+#define AUDIO_MIXER_H
+
+#include "Audio/AudioClip.h"
+#include "Audio/AudioStream.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace GameEngine {
+
+// Identifies one playback of a clip. Slot index in the low 16 bits and the
+// slot's generation above it, so a handle to a finished or stolen voice
+// simply stops matching. 0 is never a valid voice
+typedef uint32_t VoiceId;
+const VoiceId INVALID_VOICE = 0;
+
+struct VoiceParams {
+    float volume;
+    float pitch;        // playback speed, 0.5 to 2.0
+    bool loop;
+    int priority;       // higher priority voices steal from lower ones when the pool is full
+
+    // 3D voices are panned and attenuated against the listener: full volume
+    // inside minDistance, inverse distance rolloff beyond it and silent past
+    // maxDistance, where they go virtual. Position and velocity in world units
+    bool spatial;
+    float minDistance;
+    float maxDistance;
+    float rolloff;
+    glm::vec3 position;
+    glm::vec3 velocity;
+
+    VoiceParams()
+        : volume(1.0f), pitch(1.0f), loop(false), priority(0)
+        , spatial(false), minDistance(1.0f), maxDistance(50.0f), rolloff(1.0f)
+        , position(0.0f), velocity(0.0f) {}
+};
+
+struct AudioListener {
+    glm::vec3 position;
+    glm::vec3 velocity;
+    glm::vec3 forward;
+    glm::vec3 up;
+
+    AudioListener() : position(0.0f), velocity(0.0f), forward(0.0f, 0.0f, -1.0f), up(0.0f, 1.0f, 0.0f) {}
+};
+
+// One moved 3D voice in a batch for AudioMixer::updateSpatial
+struct VoiceEmitter {
+    VoiceId voice;
+    glm::vec3 position;
+    glm::vec3 velocity;
+};
+
+struct AudioMixerStats {
+    uint32_t voicesStarted;
+    uint32_t voicesStolen;
+    uint32_t voicesRejected;    // pool full of higher priority voices
+    uint32_t periodsMixed;
+    uint32_t peakActiveVoices;
+    uint32_t streamUnderruns;   // periods a stream voice ran ahead of its decoder
+    uint32_t peakVirtualVoices; // playing but inaudible or over the mixed voice limit
+
+    AudioMixerStats() { reset(); }
+    void reset() {
+        voicesStarted = voicesStolen = voicesRejected = periodsMixed = peakActiveVoices = 0;
+        streamUnderruns = peakVirtualVoices = 0;
+    }
+};
+
+// Mixes every active voice into one interleaved stereo int16 stream. The
+// voice pool and mix buffer are allocated up front, so the cost of a period
+// is bounded by the pool size however many sound components a scene holds.
+// Pitch and sample rate conversion read the clip through a fixed-point
+// cursor with linear interpolation; clips are never copied or resampled.
+// Stream voices read the same way out of an AudioStream's ring.
+// At most maxMixedVoices voices are mixed each period, the highest priority
+// and loudest first; the rest, and every 3D voice out of range, are virtual:
+// their cursor keeps time without reading a sample, so they come back in
+// step when they become audible again.
+// Control calls come from the game thread, updateStreams() and mix() from
+// the audio thread
+class AudioMixer {
+public:
+    static const int OUTPUT_CHANNELS = 2;
+    static const int MAX_PERIOD_FRAMES = 1024;
+
+    // maxMixedVoices 0 mixes every voice in the pool
+    AudioMixer(int maxVoices = 32, int outputSampleRate = 48000, int maxMixedVoices = 0);
+
+    VoiceId play(const std::shared_ptr<const AudioClip>& clip, const VoiceParams& params);
+    // Restarts the stream from its first frame. A stream feeds one voice at a time
+    VoiceId playStream(const std::shared_ptr<AudioStream>& stream, const VoiceParams& params);
+    void stop(VoiceId voice);
+    void pause(VoiceId voice);
+    void resume(VoiceId voice);
+    void stopAll();
+
+    void setVolume(VoiceId voice, float volume);
+    void setPitch(VoiceId voice, float pitch);
+    void setLoop(VoiceId voice, bool loop);
+    void setDistanceModel(VoiceId voice, float minDistance, float maxDistance, float rolloff);
+
+    // Moves the listener and the emitters that changed under one lock, then
+    // recomputes pan, attenuation and Doppler shift for every 3D voice.
+    // Meant to be called once per game frame
+    void updateSpatial(const AudioListener& listener, const VoiceEmitter* emitters, size_t count);
+
+    bool isPlaying(VoiceId voice) const;
+    bool isPaused(VoiceId voice) const;
+    // Playing but not mixed in the last period
+    bool isVirtual(VoiceId voice) const;
+
+    void setMasterVolume(float volume);
+    float getMasterVolume() const;
+    // Outputs silence without advancing any voice
+    void setPaused(bool paused);
+
+    // Decodes ahead for every playing stream, outside the mixer lock so
+    // control calls never wait on a decoder. Call before each mix()
+    void updateStreams();
+    // Fills `frames` interleaved stereo frames
+    void mix(int16_t* output, int frames);
+
+    int getMaxVoices() const { return static_cast<int>(voices.size()); }
+    int getMaxMixedVoices() const { return maxMixedVoices; }
+    int getOutputSampleRate() const { return outputSampleRate; }
+    int getActiveVoiceCount() const;
+    AudioMixerStats getStats() const;
+    void resetStats();
+
+private:
+    struct Voice {
+        std::shared_ptr<const AudioClip> clip;
+        std::shared_ptr<AudioStream> stream;    // set instead of clip for streamed sounds
+        uint64_t position;      // 32.32 fixed point, in clip frames (absolute stream frames)
+        uint64_t step;          // per output frame, pitch * doppler * clip rate / output rate
+        float volume;
+        float pitch;
+        float doppler;
+        float gainLeft;         // volume, attenuation and pan
+        float gainRight;
+        glm::vec3 emitterPosition;
+        glm::vec3 emitterVelocity;
+        float minDistance;
+        float maxDistance;
+        float rolloff;
+        int priority;
+        uint32_t generation;
+        uint32_t startOrder;
+        bool active;
+        bool paused;
+        bool loop;
+        bool spatial;
+        bool mixed;             // chosen for the last period
+    };
+
+    std::vector<Voice> voices;
+    std::vector<float> mixBuffer;
+    std::vector<std::shared_ptr<AudioStream>> pendingStreams;   // updateStreams() scratch
+    std::vector<Voice*> playingVoices;                          // mix() scratch
+    AudioListener listener;
+    glm::vec3 listenerRight;
+    int maxMixedVoices;
+    int outputSampleRate;
+    float masterVolume;
+    bool mixerPaused;
+    uint32_t nextStartOrder;
+    AudioMixerStats stats;
+    mutable std::mutex mutex;
+
+    Voice* findVoice(VoiceId voice);
+    const Voice* findVoice(VoiceId voice) const;
+    int selectSlot(int priority);
+    VoiceId startVoice(int slot, const VoiceParams& params);
+    void releaseVoice(Voice& voice);
+    uint64_t computeStep(int sampleRate, float rate) const;
+    int getSampleRate(const Voice& voice) const;
+    void updateGains(Voice& voice);
+    void mixVoice(Voice& voice, float* output, int frames);
+    void mixStreamVoice(Voice& voice, float* output, int frames);
+    void advanceVoice(Voice& voice, int frames);
+};
+
+} // namespace GameEngine
+
+#endif // AUDIO_MIXER_H
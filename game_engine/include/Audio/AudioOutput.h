@@ -0,0 +1,104 @@
+#ifndef AUDIO_OUTPUT_H
+#define AUDIO_OUTPUT_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#ifdef LINUX_BUILD
+#include <AL/al.h>
+#include <AL/alc.h>
+#endif
+
+namespace GameEngine {
+
+enum class AudioBackend {
+    DEVICE,         // OpenAL on Linux, one sceAudioOut port on Vita
+    NULL_DEVICE     // no sound card, paced by the clock or as fast as possible
+};
+
+// The single stream the mixer feeds. write() takes one period of
+// interleaved stereo int16 and blocks until the device has room for it,
+// which is what paces the audio thread
+class AudioOutput {
+public:
+    virtual ~AudioOutput() {}
+
+    virtual bool open(int sampleRate, int periodFrames) = 0;
+    virtual void close() = 0;
+    virtual bool write(const int16_t* samples) = 0;
+    virtual const char* getName() const = 0;
+
+    static bool parseBackend(const std::string& name, AudioBackend& result);
+};
+
+// Swallows the stream. In realtime mode write() sleeps so periods go out at
+// the device rate (voices finish when they would on hardware); otherwise it
+// returns at once, for tests that mix faster than realtime
+class NullAudioOutput : public AudioOutput {
+public:
+    explicit NullAudioOutput(bool realtime = true);
+
+    bool open(int sampleRate, int periodFrames) override;
+    void close() override;
+    bool write(const int16_t* samples) override;
+    const char* getName() const override { return "null"; }
+
+    uint64_t getFramesWritten() const { return framesWritten; }
+    // Largest absolute sample seen, for checks that something was audible
+    int getPeakSample() const { return peakSample; }
+
+private:
+    bool realtime;
+    int sampleRate;
+    int periodFrames;
+    uint64_t framesWritten;
+    int peakSample;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+#ifdef LINUX_BUILD
+// One streaming OpenAL source fed from a small ring of queued buffers
+class OpenALAudioOutput : public AudioOutput {
+public:
+    OpenALAudioOutput();
+    ~OpenALAudioOutput();
+
+    bool open(int sampleRate, int periodFrames) override;
+    void close() override;
+    bool write(const int16_t* samples) override;
+    const char* getName() const override { return "openal"; }
+
+private:
+    static const int BUFFER_COUNT = 4;
+
+    ALCdevice* device;
+    ALCcontext* context;
+    ALuint source;
+    ALuint buffers[BUFFER_COUNT];
+    int queuedBuffers;
+    int sampleRate;
+    int periodFrames;
+
+    bool openDevice();
+};
+#elif defined(VITA_BUILD)
+// One stereo BGM port; sceAudioOutOutput blocks until the hardware takes the period
+class VitaAudioOutput : public AudioOutput {
+public:
+    VitaAudioOutput();
+    ~VitaAudioOutput();
+
+    bool open(int sampleRate, int periodFrames) override;
+    void close() override;
+    bool write(const int16_t* samples) override;
+    const char* getName() const override { return "sceAudioOut"; }
+
+private:
+    int port;
+};
+#endif
+
+} // namespace GameEngine
+
+#endif // AUDIO_OUTPUT_H
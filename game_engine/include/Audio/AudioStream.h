@@ -0,0 +1,66 @@
+#ifndef AUDIO_STREAM_H
+#define AUDIO_STREAM_H
+
+#include "Audio/AudioDecoder.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace GameEngine {
+
+// A long sound decoded on the fly into a ring of RING_BLOCKS blocks, so a
+// music track costs 64 KB of PCM however long it is. Frames are addressed by
+// an absolute index: the mixer reads behind the write cursor and fill()
+// decodes a block whenever one has been consumed. Looping rewinds the decoder
+// without a gap. fill() and the cursors belong to the audio thread once the
+// stream is playing; restart() and setLoop() are safe from any thread
+class AudioStream {
+public:
+    static const int BLOCK_FRAMES = 4096;
+    static const int RING_BLOCKS = 4;
+    static const int RING_FRAMES = BLOCK_FRAMES * RING_BLOCKS;
+
+    explicit AudioStream(std::unique_ptr<AudioDecoder> decoder);
+
+    const std::string& getPath() const { return decoder->getPath(); }
+    int getChannels() const { return channels; }
+    int getSampleRate() const { return sampleRate; }
+
+    void setLoop(bool enable) { loop.store(enable); }
+    bool isLooping() const { return loop.load(); }
+
+    // Rewinds on the next fill(); the mixer holds the voice silent until then
+    void restart() { restartPending.store(true); }
+    bool isRestartPending() const { return restartPending.load(); }
+
+    // Decodes into every free block
+    void fill();
+
+    // Decoder exhausted: the voice ends once it reaches getWriteFrame()
+    bool isEnded() const { return ended; }
+    uint64_t getWriteFrame() const { return writeFrame; }
+    uint64_t getReadFrame() const { return readFrame; }
+    void setReadFrame(uint64_t frame) { readFrame = frame; }
+    // Moves both cursors back by a multiple of RING_FRAMES to keep them small
+    void rebase(uint64_t frames) { readFrame -= frames; writeFrame -= frames; }
+
+    // Frame `index` lives at getRingData() + (index & (RING_FRAMES - 1)) * channels
+    const int16_t* getRingData() const { return ring.data(); }
+    size_t getByteSize() const { return ring.size() * sizeof(int16_t); }
+
+private:
+    std::unique_ptr<AudioDecoder> decoder;
+    std::vector<int16_t> ring;
+    int channels;
+    int sampleRate;
+    uint64_t readFrame;
+    uint64_t writeFrame;
+    std::atomic<bool> loop;
+    std::atomic<bool> restartPending;
+    bool ended;
+};
+
+} // namespace GameEngine
+
+#endif // AUDIO_STREAM_H
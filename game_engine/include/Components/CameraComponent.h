@@ -6,6 +6,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <memory>
 #include <vector>
+#include <cstdint>
 
 namespace GameEngine {
 
@@ -17,6 +18,30 @@ enum class ProjectionType {
     ORTHOGRAPHIC
 };
 
+// Everything derived from a camera's transform and projection, recomputed only
+// when one of them changes. Consumers copy it once per frame so they all work
+// from the same state even if the camera moves mid-frame
+struct CameraSnapshot {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+    glm::mat4 inverseView;
+    glm::vec3 position;
+    glm::vec3 forward;
+    glm::vec4 frustumPlanes[6];     // xyz: normalized inward normal, w: distance
+    ProjectionType projectionType;
+    float fov;
+    float aspectRatio;
+    float nearPlane;
+    float farPlane;
+    uint32_t version;               // bumped each time the snapshot is recomputed
+
+    CameraSnapshot();
+
+    // True unless the transformed box lies fully outside one frustum plane
+    bool isAABBVisible(const glm::vec3& min, const glm::vec3& max, const glm::mat4& transform) const;
+};
+
 class CameraComponent : public Component {
 public:
     CameraComponent();
@@ -26,9 +51,12 @@ public:
     
     virtual void update(float deltaTime) override;
     
-    glm::mat4 getViewMatrix();
-    glm::mat4 getProjectionMatrix();
-    glm::mat4 getViewProjectionMatrix();
+    // Refreshes the snapshot first if the transform or projection changed
+    const CameraSnapshot& getSnapshot();
+    
+    glm::mat4 getViewMatrix() { return getSnapshot().view; }
+    glm::mat4 getProjectionMatrix() { return getSnapshot().projection; }
+    glm::mat4 getViewProjectionMatrix() { return getSnapshot().viewProjection; }
     
     ProjectionType getProjectionType() const { return projectionType; }
     void setProjectionType(ProjectionType type) { projectionType = type; updateProjection(); }
@@ -107,7 +135,13 @@ private:
     mutable glm::mat4 projectionMatrix;
     mutable bool projectionDirty;
     
+    CameraSnapshot snapshot;
+    glm::mat4 snapshotWorldMatrix;
+    bool snapshotHidden;
+    bool snapshotDirty;
+    
     void updateProjection();
+    void refreshSnapshot(const glm::mat4& worldMatrix, bool hidden);
     
     void handleKeyboardInput(float deltaTime);
     void handleMouseInput();
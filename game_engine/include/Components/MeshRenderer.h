@@ -23,6 +23,12 @@ public:
     void setMaterial(std::shared_ptr<Material> material);
     std::shared_ptr<Material> getMaterial() const { return material; }
     
+    // Shared materials belong to every prefab instance using them; anything
+    // that edits this renderer's material takes a unique copy first
+    void setSharedMaterial(std::shared_ptr<Material> material);
+    bool isMaterialShared() const { return materialShared; }
+    std::shared_ptr<Material> getUniqueMaterial();
+    
     bool getCastShadows() const { return castShadows; }
     void setCastShadows(bool cast) { castShadows = cast; }
     
@@ -34,6 +40,7 @@ public:
 private:
     std::shared_ptr<Mesh> mesh;
     std::shared_ptr<Material> material;
+    bool materialShared;
     bool castShadows;
     bool receiveShadows;
 };
@@ -4,6 +4,7 @@
 #include "Components/Component.h"
 #include "Rendering/Mesh.h"
 #include "Rendering/Material.h"
+#include <iosfwd>
 #include <memory>
 #include <string>
 #include <vector>
@@ -18,11 +19,22 @@ namespace tinygltf {
 
 namespace GameEngine {
 
+struct CameraSnapshot;
+
+struct MeshLOD {
+    std::shared_ptr<Mesh> mesh;
+    float error;        // geometric error in mesh-local units
+
+    MeshLOD() : error(0.0f) {}
+};
+
 struct ModelData {
     std::vector<std::shared_ptr<Mesh>> meshes;
     std::vector<std::shared_ptr<Material>> materials;
     std::vector<glm::mat4> meshNodeTransforms;
     std::vector<int> meshMaterialIndices;
+    // Simplified levels of each mesh, finest first; meshes[i] is level 0
+    std::vector<std::vector<MeshLOD>> meshLODs;
     std::string modelPath;
     std::string modelName;
     bool isLoaded;
@@ -30,6 +42,20 @@ struct ModelData {
     ModelData() : isLoaded(false) {}
 };
 
+// CPU half of a glTF load (see ModelRenderer::prepareModel). The meshes still
+// hold their vertex data, and nothing is uploaded, cached or logged yet
+struct PreparedModel {
+    std::string modelPath;          // cache key, as the scene names it
+    std::string sourcePath;         // with the platform device prefix
+    std::shared_ptr<tinygltf::Model> gltf;
+    ModelData data;
+    std::string log;                // printed by finishPreparedModel
+    std::string errors;
+    bool parsed;
+
+    PreparedModel() : parsed(false) {}
+};
+
 class ModelRenderer : public Component {
 public:
     ModelRenderer();
@@ -49,6 +75,24 @@ public:
     const std::vector<std::shared_ptr<Mesh>>& getMeshes() const { return modelData.meshes; }
     const std::vector<std::shared_ptr<Material>>& getMaterials() const { return modelData.materials; }
     
+    // Each mesh draws the coarsest level whose error projects to at most
+    // LOD_SCREEN_ERROR of the viewport height (scaled by the LOD bias).
+    // Switching back needs the error to cross the threshold by LOD_HYSTERESIS
+    static constexpr int LOD_LEVELS = 3;
+    static constexpr float LOD_MAX_ERROR = 0.05f;       // relative to the mesh extent
+    static constexpr size_t LOD_MIN_TRIANGLES = 256;
+    static constexpr float LOD_SCREEN_ERROR = 1.0f / VITA_HEIGHT;
+    static constexpr float LOD_HYSTERESIS = 0.25f;
+
+    std::shared_ptr<Mesh> selectLOD(size_t meshIndex, const glm::mat4& modelMatrix, const CameraSnapshot& camera);
+    size_t getLODCount(size_t meshIndex) const;
+    int getCurrentLOD(size_t meshIndex) const;
+    // -1 selects automatically
+    int getForcedLOD() const { return forcedLOD; }
+    void setForcedLOD(int lod) { forcedLOD = lod; }
+    float getLODBias() const { return lodBias; }
+    void setLODBias(float bias) { lodBias = bias; }
+
     bool getCastShadows() const { return castShadows; }
     void setCastShadows(bool cast) { castShadows = cast; }
     
@@ -58,19 +102,42 @@ public:
     virtual void drawInspector() override;
     
     static std::vector<std::string> discoverModels(const std::string& directory = "assets/models");
+
+    // Split load for scene loading: prepareModel parses the file and builds
+    // the meshes and LODs without GL or shared state, so several models can
+    // be prepared on worker threads at once. finishPreparedModel runs on the
+    // GL thread: materials, uploads, skeletons and animations, then the cache
+    // loadModel reads. Only .gltf/.glb split; .bmodel loads through loadModel
+    static bool canPrepareModel(const std::string& modelPath);
+    static bool prepareModel(const std::string& modelPath, PreparedModel& prepared);
+    static bool finishPreparedModel(PreparedModel& prepared);
+    static bool hasCachedModel(const std::string& modelPath);
+    // Hands a prepared model to the first loadModel of its path, so its
+    // uploads land where a plain load would have made them
+    static void addPreparedModel(PreparedModel& prepared);
+    static void clearPreparedModels();
     
 private:
     ModelData modelData;
     bool castShadows;
     bool receiveShadows;
-    
-    bool loadGLTFModel(const std::string& modelPath);
-    std::shared_ptr<Mesh> createMeshFromGLTF(const tinygltf::Model& gltfModel, const tinygltf::Mesh& gltfMesh, const tinygltf::Primitive& primitive);
-    std::shared_ptr<Material> createMaterialFromGLTF(const tinygltf::Model& gltfModel, int materialIndex, const std::string& modelPath);
+    int forcedLOD;
+    float lodBias;
+    std::vector<int> currentLODs;
+    
+    // The mesh and its levels come back with their CPU data, not uploaded
+    static std::shared_ptr<Mesh> createMeshFromGLTF(const tinygltf::Model& gltfModel, const tinygltf::Mesh& gltfMesh, const tinygltf::Primitive& primitive,
+                                                    std::vector<MeshLOD>& lods, std::ostream& log, std::ostream& errors);
+    // Needs the mesh's CPU data; the levels are left for the caller to upload
+    static void generateLODs(const Mesh& mesh, std::vector<MeshLOD>& lods, std::ostream& log);
+    static std::shared_ptr<Material> createMaterialFromGLTF(const tinygltf::Model& gltfModel, int materialIndex, const std::string& modelPath);
+    static void loadGLTFAnimations(const tinygltf::Model& gltfModel, const std::string& modelPath);
     
     static glm::mat4 computeNodeTransform(const tinygltf::Node& node);
-    void traverseGLTFNodes(const tinygltf::Model& gltfModel, const tinygltf::Node& node, 
-                          const glm::mat4& parentTransform);
+    static void traverseGLTFNodes(const tinygltf::Model& gltfModel, const tinygltf::Node& node, 
+                                  const glm::mat4& parentTransform, ModelData& data, std::ostream& log, std::ostream& errors);
+    // Adds the app0: device prefix on Vita
+    static std::string resolveModelPath(const std::string& modelPath);
     
     bool loadBinaryModel(const std::string& modelPath);
     bool saveBinaryModel(const std::string& modelPath);
@@ -79,6 +146,7 @@ private:
     static std::string getFileName(const std::string& filepath);
     
     static std::unordered_map<std::string, std::shared_ptr<ModelData>> meshCache;
+    static std::unordered_map<std::string, PreparedModel> preparedModels;
     static std::shared_ptr<ModelData> getCachedModel(const std::string& modelPath);
     static void clearMeshCache();
 };
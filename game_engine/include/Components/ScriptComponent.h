@@ -4,11 +4,22 @@
 #include "Components/Component.h"
 #include <string>
 #include <memory>
+#include <cstdint>
 
 struct lua_State;
 
 namespace GameEngine {
 
+// Per-script cost of the update() callback
+struct ScriptTimings {
+    uint64_t updateCalls = 0;
+    double lastUpdateMs = 0.0;
+    double maxUpdateMs = 0.0;
+    double totalUpdateMs = 0.0;
+    
+    double getAverageUpdateMs() const { return updateCalls ? totalUpdateMs / updateCalls : 0.0; }
+};
+
 class ScriptComponent : public Component {
 public:
     ScriptComponent();
@@ -36,18 +47,38 @@ public:
     
     void callScriptFunction(const std::string& functionName);
     void callScriptFunction(const std::string& functionName, float param);
+    void callScriptFunction(const std::string& functionName, const std::string& param);
+    void callScriptFunction(const std::string& functionName, const std::string& param1, const std::string& param2);
     
     void setScriptProperty(const std::string& name, const std::string& value);
     std::string getScriptProperty(const std::string& name) const;
     
+    const ScriptTimings& getTimings() const { return timings; }
+    void resetTimings() { timings = ScriptTimings(); }
+    
 private:
+    // Shared component VM (owned by ScriptManager); script globals live in envRef
     lua_State* luaState;
+    int envRef;
+    // Lifecycle callbacks resolved once after (re)load; LUA_NOREF when absent
+    int startRef;
+    int updateRef;
+    int renderRef;
+    int destroyRef;
+    ScriptTimings timings;
     std::string scriptPath;
+    const char* profileZoneName;    // the script path, interned for the profiler
     bool scriptLoaded;
     bool scriptStarted;
     bool pauseExempt = false;
     
     bool hasScriptFunction(const std::string& functionName);
+    bool pushScriptFunction(const std::string& functionName);
+    
+    void resolveFunctionRefs();
+    void releaseFunctionRefs();
+    void callFunctionRef(int ref, const char* functionName);
+    void callFunctionRef(int ref, const char* functionName, float param);
     
     void handleLuaError(const std::string& operation);
     
@@ -57,7 +88,11 @@ private:
     void bindEngineToLua();
     void bindCommonFunctions();
     void bindTransformToLua();
+    void bindNodeHandlesToLua();
     void bindPickupZoneToLua();
+    // Pushes the calling script's pickup zones (kept in its environment), or
+    // nil when no script is running
+    static bool pushPickupZones(lua_State* L);
     void bindArea3DToLua();
     void bindInputToLua();
     void bindCameraToLua();
@@ -67,6 +102,7 @@ private:
     void bindAnimationToLua();
     void bindSoundToLua();
     void bindSkyboxToLua();
+    void bindProfilerToLua();
 };
 
 } // namespace GameEngine
@@ -2,18 +2,10 @@
 #define SOUND_COMPONENT_H
 
 #include "Components/Component.h"
-#include "../../include/Platform.h"
+#include "Audio/AudioClip.h"
+#include "Audio/AudioMixer.h"
 #include <string>
 #include <memory>
-#include <atomic>
-
-#ifdef LINUX_BUILD
-#include <AL/al.h>
-#include <AL/alc.h>
-#elif defined(VITA_BUILD)
-#include <psp2/audioout.h>
-#include <stdint.h>
-#endif
 
 namespace GameEngine {
 
@@ -50,57 +42,52 @@ public:
     void setLoop(bool loop);
     bool isLooping() const { return looping; }
     
+    // Decides which voices are stolen when the mixer's voice pool is full
+    void setPriority(int priority) { this->priority = priority; }
+    int getPriority() const { return priority; }
+    
+    // 3D sounds follow their node and are panned and attenuated against the
+    // active camera; out of range they go virtual. Applies from the next play()
+    void setSpatial(bool enable) { spatial = enable; }
+    bool isSpatial() const { return spatial; }
+    void setDistanceRange(float minDistance, float maxDistance);
+    float getMinDistance() const { return minDistance; }
+    float getMaxDistance() const { return maxDistance; }
+    void setRolloff(float rolloff);
+    float getRolloff() const { return rolloff; }
+    
     bool isPlaying() const;
     bool isPaused() const;
     
     virtual void drawInspector() override;
     
-#ifdef VITA_BUILD
-    void streamAudio();
-#endif
-    
 private:
     std::string soundFilePath;
     float volume;
     float pitch;  // Playback pitch/speed (0.5 to 2.0, 1.0 = normal)
     bool looping;
+    int priority;
+    bool spatial;
+    float minDistance;
+    float maxDistance;
+    float rolloff;
     bool loaded;
     bool wasPlayingBeforePause;  // Track if sound was playing before game pause
     
-#ifdef LINUX_BUILD
-    // OpenAL resources
-    ALuint source;
-    ALuint buffer;
-    ALenum state;
+    // Shared with every component playing the same file, or for long
+    // sounds a stream of our own; the mixer reads either in place
+    std::shared_ptr<const AudioClip> clip;
+    std::shared_ptr<AudioStream> stream;
+    VoiceId voice;
     
-    bool initializeOpenAL();
-    void cleanupOpenAL();
-    bool loadWAVFile(const std::string& filePath, ALuint& buffer);
+    // Last emitter state sent to the mixer, so only moves are submitted
+    glm::vec3 emitterPosition;
+    glm::vec3 emitterVelocity;
     
-#elif defined(VITA_BUILD)
-    int audioPort;
-    int16_t* audioBuffer; 
-    size_t audioBufferSize;
-    size_t audioDataSize;
-    int16_t* originalAudioBuffer; 
-    size_t originalAudioDataSize;
-    int sampleRate;
-    int channels;
-    std::atomic<bool> isStreaming;
-    std::atomic<bool> isPausedState;
-    std::atomic<size_t> currentStreamPos;
-    
-    bool initializeVitaAudio();
-    void cleanupVitaAudio();
-    bool loadWAVFile(const std::string& filePath);
-    void resampleAudioBuffer();
-    
-#endif
-    
-    void updatePlayback();
+    AudioMixer* getMixer() const;
+    glm::vec3 getWorldPosition() const;
 };
 
 } // namespace GameEngine
 
 #endif // SOUND_COMPONENT_H
-
@@ -2,6 +2,7 @@
 #define TEXT_COMPONENT_H
 
 #include "Components/Component.h"
+#include "Rendering/TextRenderer.h"
 #include "Platform.h"
 #include <glm/glm.hpp>
 #include <memory>
@@ -10,26 +11,14 @@
 
 namespace GameEngine {
     class Renderer;
-    class Shader;
     class Texture;
     class FontManager;
     class SceneNode;
+    struct FontFace;
 }
 
-#include "../../vendor/stb/stb_truetype.h"
-
 namespace GameEngine {
 
-struct TextVertex {
-    glm::vec3 position;
-    glm::vec4 color;
-    glm::vec2 texCoord;
-    
-    TextVertex() : position(0.0f), color(1.0f), texCoord(0.0f) {}
-    TextVertex(const glm::vec3& pos, const glm::vec4& col, const glm::vec2& tex)
-        : position(pos), color(col), texCoord(tex) {}
-};
-
 enum class TextAlignment {
     LEFT,
     CENTER,
@@ -54,8 +43,8 @@ public:
     void render(Renderer& renderer, const glm::mat4& worldTransform);
     virtual void destroy() override;
     
-    void renderWorldSpaceDirectly(const glm::mat4& worldTransform, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
-    void renderScreenSpaceDirectly();
+    // Queues the cached glyph run on the TextRenderer; drawn at its next flush
+    void submit(const glm::mat4& worldTransform);
     
     void setText(const std::string& text);
     const std::string& getText() const { return text; }
@@ -97,39 +86,23 @@ private:
     float scale;
     float lineSpacing;
     
-    std::vector<stbtt_packedchar> packedChars;
-    std::vector<stbtt_aligned_quad> alignedQuads;
-    std::shared_ptr<Texture> fontAtlasTexture;
-    uint32_t atlasWidth;
-    uint32_t atlasHeight;
-    uint32_t charsToInclude;
-    uint32_t firstCharCodePoint;
-    
-    std::vector<TextVertex> vertices;
-    std::vector<unsigned int> indices;
-    std::shared_ptr<Shader> textShader;
+    std::shared_ptr<FontFace> fontFace;
     
-    GLuint vao;
-    GLuint vbo;
-    GLuint ebo;
+    // Tessellated once per text/layout change (or glyph cache eviction),
+    // resubmitted every frame
+    GlyphRun glyphRun;
     
     bool needsUpdate;
     bool isInitialized;
     
     void initializeFont();
     void updateTextMesh();
-    void setupBuffers();
-    void cleanupBuffers();
-    void renderWorldSpace(Renderer& renderer);
-    void renderWorldSpace(Renderer& renderer, const glm::mat4& worldTransform);
-    void renderScreenSpace(Renderer& renderer);
     
     glm::vec2 calculateTextSize() const;
+    float getGlyphScale() const;
     void generateVertices();
-    void updateBuffers();
     
-    bool generateFontAtlas();
-    void cleanupFontAtlas();
+    void releaseFont();
 };
 
 } // namespace GameEngine
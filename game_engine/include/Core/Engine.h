@@ -1,6 +1,7 @@
 #ifndef ENGINE_H
 #define ENGINE_H
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <glm/glm.hpp>
@@ -19,6 +20,8 @@
 
 namespace GameEngine {
 
+class FramePipeline;
+
 enum class EngineMode {
     GAME,
     EDITOR
@@ -30,7 +33,14 @@ public:
     ~Engine();
     
     bool initialize(EngineMode mode = EngineMode::GAME);
+    // Applies a JSON engine config; keys it leaves out keep their values.
+    // initialize() loads CONFIG_PATH, so every platform reads the same file
+    static const char* const CONFIG_PATH;
+    bool loadConfig(const std::string& path);
     void run();
+    // One handleEvents/update/render pass; false once the engine stops.
+    // Lets headless harnesses drive a fixed number of frames
+    bool runFrame();
     void shutdown();
     
     SceneManager& getSceneManager() { return *sceneManager; }
@@ -47,12 +57,24 @@ public:
     bool isRunning() const { return running; }
     void setRunning(bool state) { running = state; }
     
+    // Frames the picture trails the simulation by. 0 (the default) updates
+    // and then renders; 1 simulates frame N+1 on a second thread while the
+    // render thread draws a snapshot of frame N (game mode only, see
+    // FramePipeline). Set by "frameLatency" in the engine config, or by
+    // GAME_ENGINE_FRAME_LATENCY on Linux; clamped to 0..MAX_FRAME_LATENCY
+    static const int MAX_FRAME_LATENCY = 1;
+    void setFrameLatency(int frames);
+    int getFrameLatency() const { return frameLatency; }
+    bool isPipelined() const { return frameLatency > 0 && mode == EngineMode::GAME; }
+    
     void setWindowTitle(const std::string& title);
     glm::ivec2 getWindowSize() const;
     
 private:
-    bool running;
+    std::atomic<bool> running;     // scripts may stop the engine from the simulation thread
     EngineMode mode;
+    int frameLatency;
+    std::unique_ptr<FramePipeline> pipeline;
     
     std::unique_ptr<SceneManager> sceneManager;
     std::unique_ptr<Renderer> renderer;
@@ -70,6 +92,12 @@ private:
     void update();
     void render();
     void handleEvents();
+    
+    void pollInput();
+    void simulate();
+    void runPipelinedFrame();
+    void captureFrame();
+    void submitFrame();
 };
 
 Engine& GetEngine();
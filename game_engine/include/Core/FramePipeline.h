@@ -0,0 +1,64 @@
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include <functional>
+#include <memory>
+#include "Core/ThreadManager.h"
+
+namespace GameEngine {
+
+class ProxyRenderDevice;
+
+// Runs the simulation half of the frame on its own thread so the render
+// thread can submit frame N while frame N+1 simulates. The render thread
+// (the one holding the GL context) captures what the last simulation left
+// in the scene, calls kick(), submits and presents, then calls wait()
+// before capturing again; the scene is only ever touched by one side.
+// Render device calls the simulation makes (texture and mesh loads, GL
+// object releases) go through a ProxyRenderDevice and run on the render
+// thread while it waits
+class FramePipeline {
+public:
+    FramePipeline();
+    ~FramePipeline();
+
+    // Starts the simulation thread; simulate runs once per kick()
+    bool start(const std::function<void()>& simulate);
+    // Waits for a kicked frame, then ends the thread
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Render thread only
+    void kick();
+    void wait();
+    bool isSimulating() const { return frameRequested; }
+
+    // Runs task on the render thread and returns once it has. Any thread
+    // but the render thread
+    void runOnRenderThread(const std::function<void()>& task);
+
+private:
+    FramePipeline(const FramePipeline&) = delete;
+    FramePipeline& operator=(const FramePipeline&) = delete;
+
+    void simulationThread();
+    // Render thread, with the lock held
+    void runPendingTask(UniqueLock& lock);
+
+    std::function<void()> simulate;
+    std::unique_ptr<ProxyRenderDevice> proxyDevice;
+    ThreadHandle thread;
+
+    Mutex mutex;
+    ConditionVariable renderCondition;      // a task was posted or the frame finished
+    ConditionVariable simulationCondition;  // a frame was kicked, a task ran, or stop
+    bool running;
+    bool stopRequested;
+    bool frameRequested;                    // kicked and not yet waited for
+    bool frameDone;
+    const std::function<void()>* pendingTask;
+};
+
+} // namespace GameEngine
+
+#endif // FRAME_PIPELINE_H
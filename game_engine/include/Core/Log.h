@@ -0,0 +1,119 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <atomic>
+#include <cstdint>
+
+// Levels below ENGINE_LOG_LEVEL compile out entirely, arguments and all.
+// Debug builds keep everything; release builds keep INFO and up
+#ifndef ENGINE_LOG_LEVEL
+#ifdef DEBUG
+#define ENGINE_LOG_LEVEL 0
+#else
+#define ENGINE_LOG_LEVEL 2
+#endif
+#endif
+
+namespace GameEngine {
+
+enum class LogLevel {
+    TRACE = 0,                      // per frame or per object
+    VERBOSE = 1,
+    INFO = 2,
+    WARNING = 3,
+    ERROR = 4
+};
+
+// Leveled, asynchronous logger. A message is formatted on the calling thread
+// into a fixed slot of a bounded lock-free queue, and a writer thread does
+// the console I/O, so logging from a hot path costs a vsnprintf and never
+// waits on the console (on the Vita a printf can take a whole frame). When
+// the queue is full the message is dropped and counted instead. Until
+// start() and after stop(), messages are written by the caller
+class Log {
+public:
+    static const uint32_t QUEUE_CAPACITY = 256;     // a power of two
+    static const uint32_t MESSAGE_SIZE = 256;       // longer messages are cut
+
+    static Log& getInstance();
+
+    void start();
+    // Writes whatever is queued and ends the writer thread
+    void stop();
+
+    // Messages below the level are skipped at run time; levels stripped at
+    // compile time stay stripped. GAME_ENGINE_LOG_LEVEL sets it on Linux
+    void setLevel(LogLevel level) { this->level.store(static_cast<int>(level), std::memory_order_relaxed); }
+    LogLevel getLevel() const { return static_cast<LogLevel>(level.load(std::memory_order_relaxed)); }
+    bool isEnabled(LogLevel messageLevel) const {
+        return static_cast<int>(messageLevel) >= level.load(std::memory_order_relaxed);
+    }
+
+    void write(LogLevel messageLevel, const char* format, ...)
+#ifdef __GNUC__
+        __attribute__((format(printf, 3, 4)))
+#endif
+        ;
+
+    uint32_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    static const char* getLevelName(LogLevel level);
+    static bool parseLevel(const char* name, LogLevel& level);
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        LogLevel level;
+        char text[MESSAGE_SIZE];
+    };
+
+    Log();
+    ~Log();
+
+    bool pop(Slot& out);
+    void writerThread();
+    static void output(LogLevel messageLevel, const char* text);
+
+    Slot slots[QUEUE_CAPACITY];
+    std::atomic<uint32_t> enqueuePos;
+    std::atomic<uint32_t> dequeuePos;
+    std::atomic<int> level;
+    std::atomic<uint32_t> dropped;
+    std::atomic<bool> running;
+};
+
+} // namespace GameEngine
+
+#define ENGINE_LOG(level, ...) \
+    do { \
+        if (::GameEngine::Log::getInstance().isEnabled(level)) \
+            ::GameEngine::Log::getInstance().write(level, __VA_ARGS__); \
+    } while (0)
+
+#if ENGINE_LOG_LEVEL <= 0
+#define LOG_TRACE(...) ENGINE_LOG(::GameEngine::LogLevel::TRACE, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) do {} while (0)
+#endif
+
+#if ENGINE_LOG_LEVEL <= 1
+#define LOG_VERBOSE(...) ENGINE_LOG(::GameEngine::LogLevel::VERBOSE, __VA_ARGS__)
+#else
+#define LOG_VERBOSE(...) do {} while (0)
+#endif
+
+#if ENGINE_LOG_LEVEL <= 2
+#define LOG_INFO(...) ENGINE_LOG(::GameEngine::LogLevel::INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+
+#if ENGINE_LOG_LEVEL <= 3
+#define LOG_WARNING(...) ENGINE_LOG(::GameEngine::LogLevel::WARNING, __VA_ARGS__)
+#else
+#define LOG_WARNING(...) do {} while (0)
+#endif
+
+#define LOG_ERROR(...) ENGINE_LOG(::GameEngine::LogLevel::ERROR, __VA_ARGS__)
+
+#endif // LOG_H
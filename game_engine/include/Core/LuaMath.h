@@ -0,0 +1,51 @@
+#ifndef LUA_MATH_H
+#define LUA_MATH_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+struct lua_State;
+
+namespace GameEngine {
+
+// Native vec3 / quat / mat4 value types for Lua. Values are full userdata with
+// arithmetic metamethods and in-place mutators (v:add(o), q:slerp(o, t), ...),
+// so scripts can keep and reuse them instead of building a table per call.
+//
+// Bindings use the helpers below so every vector argument accepts either a
+// vec3 or three numbers, and every vector result can be written into a vec3
+// the script passes in (no allocation) or returned as plain numbers.
+class LuaMath {
+public:
+    // Creates the metatables and the vec3 / quat / mat4 constructor globals
+    static void registerTypes(lua_State* L);
+
+    static glm::vec3* pushVec3(lua_State* L, const glm::vec3& v);
+    static glm::vec3* toVec3(lua_State* L, int index);
+    // vec3 userdata at index, or three numbers starting at index
+    static glm::vec3 checkVec3(lua_State* L, int index);
+    // Non-raising variant of checkVec3; returns false if index holds neither
+    static bool testVec3(lua_State* L, int index, glm::vec3& out);
+    // Copies v into the vec3 at outIndex and returns it when the caller passed
+    // one there, otherwise pushes x, y, z
+    static int returnVec3(lua_State* L, const glm::vec3& v, int outIndex);
+
+    static glm::quat* pushQuat(lua_State* L, const glm::quat& q);
+    static glm::quat* toQuat(lua_State* L, int index);
+    static glm::quat checkQuat(lua_State* L, int index);
+    static int returnQuat(lua_State* L, const glm::quat& q, int outIndex);
+
+    static glm::mat4* pushMat4(lua_State* L, const glm::mat4& m);
+    static glm::mat4* toMat4(lua_State* L, int index);
+    static glm::mat4 checkMat4(lua_State* L, int index);
+    static int returnMat4(lua_State* L, const glm::mat4& m, int outIndex);
+
+private:
+    static void registerVec3(lua_State* L);
+    static void registerQuat(lua_State* L);
+    static void registerMat4(lua_State* L);
+};
+
+} // namespace GameEngine
+
+#endif // LUA_MATH_H
@@ -12,6 +12,7 @@
 namespace GameEngine {
     class Renderer;
     class SceneNode;
+    class ScriptComponent;
     class TextComponent;
 }
 
@@ -42,8 +43,10 @@ struct MenuItem {
     glm::vec2 position;
     float fontSize;
     glm::vec4 color;
+    // Script whose environment defines action; nullptr looks it up in _G
+    ScriptComponent* actionOwner;
     
-    MenuItem() : enabled(true), position(0.0f), fontSize(24.0f), color(1.0f, 1.0f, 1.0f, 1.0f) {}
+    MenuItem() : enabled(true), position(0.0f), fontSize(24.0f), color(1.0f, 1.0f, 1.0f, 1.0f), actionOwner(nullptr) {}
 };
 
 struct Menu {
@@ -56,6 +59,7 @@ struct Menu {
     std::string onShowCallback;
     std::string onHideCallback;
     std::string onUpdateCallback;
+    ScriptComponent* callbackOwner;     // as MenuItem::actionOwner
     
     bool showBackground;
     glm::vec4 backgroundColor;
@@ -65,6 +69,7 @@ struct Menu {
         , state(MenuState::HIDDEN)
         , selectedIndex(0)
         , pauseGame(true)
+        , callbackOwner(nullptr)
         , showBackground(true)
         , backgroundColor(0.0f, 0.0f, 0.0f, 0.7f)
     {}
@@ -103,6 +108,8 @@ public:
     void render(Renderer& renderer);
     
     void bindToLua(lua_State* L);
+    // Drops the actions and callbacks a destroyed script registered
+    void releaseScript(ScriptComponent* script);
     
     bool isAnyMenuVisible() const;
     std::vector<std::string> getVisibleMenus() const;
@@ -120,7 +127,7 @@ private:
     
     void handleMenuInput();
     
-    void callMenuCallback(const std::string& callbackName, const std::string& menuId);
+    void callMenuCallback(ScriptComponent* owner, const std::string& callbackName, const std::string& menuId);
     
     void renderMenuBackground(Renderer& renderer, const Menu& menu);
     void renderMenuItems(Renderer& renderer, const Menu& menu);
@@ -0,0 +1,147 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Build with -DENGINE_PROFILER=0 to compile every PROFILE_ZONE out
+#ifndef ENGINE_PROFILER
+#define ENGINE_PROFILER 1
+#endif
+
+namespace GameEngine {
+
+// One finished zone. Times are nanoseconds since the profiler started
+struct ProfileZoneRecord {
+    const char* name;
+    uint64_t begin;
+    uint64_t end;
+    uint32_t depth;                 // 0 for a zone with no parent on its thread
+};
+
+// Frame `index` ran from `begin` until the next frame began
+struct ProfileFrameRecord {
+    uint64_t index;
+    uint64_t begin;
+    uint64_t end;
+};
+
+struct ProfileThreadCapture {
+    std::string name;
+    uint32_t id;                    // order of the thread's first zone
+    std::vector<ProfileZoneRecord> zones;
+};
+
+// A copy of some frames and every zone that overlaps them, safe to keep
+// while the rings move on
+struct ProfileCapture {
+    std::vector<ProfileFrameRecord> frames;
+    std::vector<ProfileThreadCapture> threads;
+
+    void clear() { frames.clear(); threads.clear(); }
+    uint64_t getBegin() const { return frames.empty() ? 0 : frames.front().begin; }
+    uint64_t getEnd() const { return frames.empty() ? 0 : frames.back().end; }
+};
+
+struct ProfileThreadRing;
+
+// Scoped-zone CPU profiler. Each thread writes its finished zones into its
+// own ring of ZONE_CAPACITY records; only that thread writes it, publishing
+// each record with a release store of the ring's head, so recording takes no
+// lock and never allocates after the thread's first zone. Readers copy a
+// ring and drop whatever the writer lapped while they copied. Frames are
+// marked by the main loop, and capture() cuts the rings down to whole frames
+// for the editor's timeline and for Chrome trace export (chrome://tracing,
+// ui.perfetto.dev). With a hitch threshold set, a frame over it keeps a
+// capture of itself and the frames before it, so a hitch seen on a device
+// can be read back without a profiler attached
+class Profiler {
+public:
+    static const uint32_t ZONE_CAPACITY = 8192;     // per thread, a power of two
+    static const uint32_t FRAME_CAPACITY = 256;
+    static const uint32_t MAX_THREADS = 16;         // threads past this record nothing
+    static const uint32_t MAX_DEPTH = 32;           // deeper zones are not recorded
+    static const uint32_t HITCH_FRAMES = 8;
+
+    static Profiler& getInstance();
+
+    void setEnabled(bool enabled) { this->enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Names the calling thread in captures. ThreadManager names its threads
+    void setThreadName(const std::string& name);
+
+    // Main thread, once at the start of every frame
+    void markFrame();
+    uint64_t getFrameIndex() const { return frameCount; }
+    // Length of the last whole frame
+    float getLastFrameMs() const;
+
+    // Zones must nest on each thread. Names are kept by pointer, so they must
+    // be string literals or come from internName()
+    void beginZone(const char* name);
+    void endZone();
+    // A stable copy of `name`, for zones named at run time (kept until exit)
+    static const char* internName(const std::string& name);
+
+    static uint64_t getTime();
+
+    // The last `frameCount` whole frames and the zones of every thread that
+    // overlap them. Main thread, like markFrame()
+    void capture(uint32_t frameCount, ProfileCapture& out) const;
+
+    // Frames longer than this keep a capture of the last HITCH_FRAMES frames;
+    // 0 turns it off. With a path, each hitch capture is also written there
+    // as a Chrome trace (the frame that writes it is not counted as a hitch)
+    void setHitchThreshold(float milliseconds, const std::string& tracePath = "");
+    float getHitchThreshold() const { return hitchThresholdMs; }
+    uint32_t getHitchCount() const { return hitchCount; }
+    const ProfileCapture& getLastHitch() const { return lastHitch; }
+
+    static std::string toChromeTrace(const ProfileCapture& capture);
+    static bool saveChromeTrace(const ProfileCapture& capture, const std::string& path);
+
+private:
+    Profiler();
+
+    ProfileThreadRing* getThreadRing(bool create);
+    void checkHitch();
+
+    std::atomic<bool> enabled;
+    std::atomic<ProfileThreadRing*> rings[MAX_THREADS];
+    std::atomic<uint32_t> ringCount;
+
+    uint64_t frameBegins[FRAME_CAPACITY];
+    uint64_t frameCount;
+
+    float hitchThresholdMs;
+    std::string hitchTracePath;
+    uint32_t hitchCount;
+    bool skipHitchCheck;
+    ProfileCapture lastHitch;
+};
+
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) { Profiler::getInstance().beginZone(name); }
+    ~ProfileZone() { Profiler::getInstance().endZone(); }
+
+private:
+    ProfileZone(const ProfileZone&);
+    ProfileZone& operator=(const ProfileZone&);
+};
+
+} // namespace GameEngine
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if ENGINE_PROFILER
+#define PROFILE_ZONE(name) ::GameEngine::ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) do {} while (0)
+#endif
+
+#endif // PROFILER_H
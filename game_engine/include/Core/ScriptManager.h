@@ -19,6 +19,7 @@ class Component;
 class InputManager;
 class PhysicsManager;
 class Renderer;
+class ScriptComponent;
 
 class ScriptManager {
 public:
@@ -28,6 +29,8 @@ public:
     void shutdown();
     ~ScriptManager();
     
+    // Run in the component VM's _G, so whatever they define is visible to
+    // every component script
     bool executeScript(const std::string& scriptPath);
     bool executeScriptString(const std::string& scriptCode);
     
@@ -35,19 +38,47 @@ public:
     void hotReloadScript(const std::string& scriptPath);
     void hotReloadAllScripts();
     
-    lua_State* getGlobalLuaState() { return globalLuaState; }
+    // The one Lua VM: every ScriptComponent runs in it (created on first use)
+    // and keeps its own _ENV table inside it
+    lua_State* getComponentLuaState();
+    bool isComponentLuaStateAlive(lua_State* L) const { return L && L == componentLuaState; }
+    
+    // Pushes the compiled main chunk of a script onto the component VM, compiling
+    // it only the first time a path is seen
+    bool loadCachedChunk(const std::string& scriptPath);
+    void invalidateCachedChunk(const std::string& scriptPath);
+    size_t getCachedChunkCount() const { return chunkCache.size(); }
+    
+    // Batched per-frame dispatch of ScriptComponent::update. Components register
+    // once their script has loaded; only those under sceneRoot (and in active
+    // nodes) run, and while paused only pause-exempt ones do
+    void registerScriptComponent(ScriptComponent* component);
+    void unregisterScriptComponent(ScriptComponent* component);
+    void updateScriptComponents(SceneNode* sceneRoot, float deltaTime, bool paused);
+    size_t getScriptComponentCount() const { return scriptComponents.size(); }
+    double getLastScriptUpdateMs() const { return lastScriptUpdateMs; }
+    
+    // Component VM collector tuning. pause/stepMul are the Lua incremental GC
+    // percentages; a budget > 0 ms switches to manual collection, stepped by
+    // stepScriptGC for at most that long (0 = automatic). While stepping
+    // manually, a heap over the memory limit gets a full collection instead
+    // (0 KB = no limit)
+    void setScriptGCParameters(int pause, int stepMul);
+    void setScriptGCBudget(double milliseconds);
+    void setScriptMemoryLimit(int kilobytes);
+    int getScriptGCPause() const { return gcPause; }
+    int getScriptGCStepMul() const { return gcStepMul; }
+    double getScriptGCBudget() const { return gcBudgetMs; }
+    int getScriptMemoryLimit() const { return gcMemoryLimitKB; }
+    double getLastGCStepMs() const { return lastGCStepMs; }
+    int getFullCollectionCount() const { return fullCollectionCount; }
+    
+    // Called by Engine::simulate once a frame, after every script has run
+    void stepScriptGC();
     
     void watchScriptFile(const std::string& scriptPath);
     void unwatchScriptFile(const std::string& scriptPath);
     
-    void bindEngineSystems();
-    void bindInputSystem();
-    void bindPhysicsSystem();
-    void bindRendererSystem();
-    void bindSceneSystem();
-    void bindPickupZoneSystem();
-    void bindMenuSystem();
-    
     std::string getScriptDirectory() const { return scriptDirectory; }
     void setScriptDirectory(const std::string& dir) { scriptDirectory = dir; }
     
@@ -58,7 +89,24 @@ private:
     
     static std::unique_ptr<ScriptManager> instance;
     
-    lua_State* globalLuaState;
+    lua_State* componentLuaState;
+    
+    // Script path -> precompiled bytecode for the component VM
+    std::unordered_map<std::string, std::string> chunkCache;
+    
+    // Components driven by updateScriptComponents; entries removed mid-dispatch
+    // are nulled and compacted once the loop finishes
+    std::vector<ScriptComponent*> scriptComponents;
+    bool dispatchingScripts;
+    bool scriptComponentsDirty;
+    double lastScriptUpdateMs;
+    
+    int gcPause;
+    int gcStepMul;
+    double gcBudgetMs;
+    int gcMemoryLimitKB;
+    double lastGCStepMs;
+    int fullCollectionCount;
     
     std::string scriptDirectory;
     bool hotReloadEnabled;
@@ -68,12 +116,9 @@ private:
     
     std::function<void(const std::string&)> errorCallback;
     
-    bool initializeLua();
     void cleanupLua();
     
-    void bindCommonFunctions();
-    void bindMathFunctions();
-    void bindUtilityFunctions();
+    void applyGCSettings();
     
     time_t getFileModificationTime(const std::string& filePath);
     bool hasFileChanged(const std::string& filePath);
@@ -0,0 +1,90 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Build with -DENGINE_COUNT_ALLOCATIONS=0 to keep the global operator new as
+// the C++ library ships it (the "Allocations" counter then stays at 0)
+#ifndef ENGINE_COUNT_ALLOCATIONS
+#define ENGINE_COUNT_ALLOCATIONS 1
+#endif
+
+namespace GameEngine {
+
+enum class StatType {
+    COUNTER,                        // added to during a frame, the frame's total is sampled
+    GAUGE                           // set to a level, the last value is sampled
+};
+
+// One named value. Writes are relaxed atomics, so any thread may update a
+// stat from a hot path without a lock
+class Stat {
+public:
+    void add(int64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+    void set(int64_t amount) { value.store(amount, std::memory_order_relaxed); }
+    int64_t get() const { return value.load(std::memory_order_relaxed); }
+
+    const char* getName() const { return name; }
+    StatType getType() const { return type; }
+
+private:
+    friend class Stats;
+    Stat() : value(0), name(""), type(StatType::GAUGE) {}
+
+    std::atomic<int64_t> value;
+    const char* name;
+    StatType type;
+};
+
+// Registry of engine counters and gauges (draw calls, culled objects,
+// physics bodies, active voices, Lua memory, allocations). Stats live until
+// exit, so a caller looks one up once and keeps the reference:
+//     static Stat& drawCalls = Stats::getInstance().getGauge("Draw calls");
+// The main loop samples every stat once per frame into a history of the
+// last HISTORY_FRAMES frames, resetting counters as it goes
+class Stats {
+public:
+    static const uint32_t MAX_STATS = 64;           // registering more returns a shared dummy
+    static const uint32_t HISTORY_FRAMES = 240;
+
+    static Stats& getInstance();
+
+    // The stat with that name, registered on first use. Names are kept by
+    // pointer, so they must be string literals
+    Stat& getCounter(const char* name) { return getStat(name, StatType::COUNTER); }
+    Stat& getGauge(const char* name) { return getStat(name, StatType::GAUGE); }
+
+    // Main thread, once at the start of every frame
+    void sampleFrame();
+
+    uint32_t getStatCount() const { return statCount.load(std::memory_order_acquire); }
+    const Stat& getStatAt(uint32_t index) const { return stats[index]; }
+    // -1 if no stat has that name
+    int findStat(const std::string& name) const;
+
+    // Frames sampled so far (the history holds the last HISTORY_FRAMES)
+    uint64_t getSampleCount() const { return sampleCount; }
+    // Stat `index` as sampled `framesAgo` frames back (0 is the latest)
+    int64_t getSample(uint32_t index, uint32_t framesAgo = 0) const;
+    // The retained history of stat `index`, oldest first
+    void getHistory(uint32_t index, std::vector<float>& out) const;
+
+private:
+    Stats();
+
+    Stat& getStat(const char* name, StatType type);
+
+    Stat stats[MAX_STATS];
+    std::atomic<uint32_t> statCount;
+    Stat overflow;
+
+    std::vector<int64_t> history;   // HISTORY_FRAMES per stat
+    uint64_t sampleCount;
+};
+
+} // namespace GameEngine
+
+#endif // STATS_H
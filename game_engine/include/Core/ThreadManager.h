@@ -6,6 +6,7 @@
 #include <atomic>
 #include <queue>
 #include <iostream>
+#include "Core/Log.h"
 
 #ifdef LINUX_BUILD
     #include <thread>
@@ -141,8 +142,8 @@ namespace GameEngine {
                 condId = sceKernelCreateCond(condName, 0, mutexId, nullptr);
                 initialized = (condId >= 0);
                 if (initialized) {
-                    std::cout << "ConditionVariable::init: Created cond (ID: " << condId << ", mutex ID: " << mutexId << ", name: " << condName << ")" << std::endl;
-                    std::cout.flush();
+                    LOG_VERBOSE("ConditionVariable::init: Created cond (ID: %d, mutex ID: %d, name: %s)",
+                                static_cast<int>(condId), static_cast<int>(mutexId), condName);
                 } else {
                     std::cerr << "ConditionVariable::init: Failed to create cond (mutex ID: " << mutexId << ")" << std::endl;
                     std::cerr.flush();
@@ -157,11 +158,9 @@ namespace GameEngine {
         }
         void wait(UniqueLock& lock) { 
             if (initialized && condId >= 0 && lock.getMutexId() == mutexId) {
-                std::cout << "ConditionVariable::wait: About to wait on cond (ID: " << condId << ", mutex ID: " << mutexId << ")" << std::endl;
-                std::cout.flush();
                 int result = sceKernelWaitCond(condId, nullptr);
-                std::cout << "ConditionVariable::wait: Wait returned (result: " << result << ")" << std::endl;
-                std::cout.flush();
+                LOG_TRACE("ConditionVariable::wait: cond %d returned %d", static_cast<int>(condId), result);
+                (void)result;
             } else {
                 std::cerr << "ConditionVariable::wait: Not initialized or invalid! (initialized: " << initialized 
                           << ", condId: " << condId << ", mutexId: " << mutexId << ", lock mutexId: " << lock.getMutexId() << ")" << std::endl;
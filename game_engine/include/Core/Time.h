@@ -26,6 +26,11 @@ public:
     float getScaledDeltaTime() const { return deltaTime * timeScale; }
     float getScaledTotalTime() const { return scaledTotalTime; }
     
+    // Fixed delta time (seconds) replaces the measured one when > 0, so
+    // headless runs step the same simulation regardless of frame cost
+    void setFixedDeltaTime(float dt) { fixedDeltaTime = dt; }
+    float getFixedDeltaTime() const { return fixedDeltaTime; }
+    
     // Frame rate limiting
     void setTargetFrameRate(int fps);
     int getTargetFrameRate() const { return targetFrameRate; }
@@ -43,6 +48,7 @@ private:
     float fps;
     int frameCount;
     int targetFrameRate;
+    float fixedDeltaTime;
     
     // Internal timing
     float lastFrameTime;
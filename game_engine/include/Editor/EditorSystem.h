@@ -60,6 +60,7 @@ public:
     void selectAllChildren(std::shared_ptr<SceneNode> node);
     
     bool saveSceneToFile(const std::string& filepath);
+    bool exportSceneToBinary(const std::string& filepath);
     bool loadSceneFromFile(const std::string& filepath);
     void createNewScene();
     
@@ -75,6 +76,8 @@ private:
     std::shared_ptr<SceneNode> editorCamera;
     
     bool viewportFocused;
+    // Camera the viewport pass is rendering with
+    CameraSnapshot frameCamera;
     
     std::unique_ptr<Framebuffer> viewportFramebuffer;
     glm::vec2 viewportSize;
@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 #include <glm/glm.hpp>
+#include "Core/Profiler.h"
 namespace GameEngine {
 class EditorSystem;
 class Scene;
@@ -27,6 +28,7 @@ public:
     void renderFileExplorer();
     void renderCameraControls();
     void renderInputMapping();
+    void renderProfiler();
     void renderSceneNode(std::shared_ptr<SceneNode> node, int depth = 0);
 
 private:
@@ -38,6 +40,12 @@ private:
     bool showViewport;
     bool showFileExplorer;
     bool showInputMapping;
+    bool showProfiler;
+    
+    // Profiler window: the frames on screen, frozen while paused
+    bool profilerPaused;
+    int profilerFrame;
+    ProfileCapture profilerCapture;
     
     float sceneGraphWidth;
     float propertiesWidth;
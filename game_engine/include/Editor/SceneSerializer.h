@@ -1,9 +1,11 @@
 #ifndef SCENE_SERIALIZER_H
 #define SCENE_SERIALIZER_H
 
+#include <map>
 #include <memory>
 #include <string>
 #include "Scene/Scene.h"
+#include "Scene/SceneDescription.h"
 #include "../../vendor/json/single_include/nlohmann/json.hpp"
 
 namespace GameEngine {
@@ -17,11 +19,22 @@ public:
     static std::string generateVitaMainContent(std::shared_ptr<Scene> scene, const std::vector<std::string>& discoveredTextures);
     static std::string escapeStringForCpp(const std::string& input);
     static std::string generateVisibilityCode(const std::string& nodeName, std::shared_ptr<SceneNode> node);
+    static std::string generateTexturePreloadCode(const std::vector<std::shared_ptr<SceneNode>>& nodes);
     
     static void saveSceneToGame(std::shared_ptr<Scene> scene);
     
     static bool saveSceneToFile(std::shared_ptr<Scene> scene, const std::string& filepath);
-    static std::shared_ptr<Scene> loadSceneFromFile(const std::string& filepath);
+    // Loads a .json or .bscene file. For a .json path, an up-to-date .bscene
+    // next to it is loaded instead. `progress` is called between load steps
+    static std::shared_ptr<Scene> loadSceneFromFile(const std::string& filepath,
+                                                    const SceneLoadCallback& progress = SceneLoadCallback());
+    
+    // Writes the node's subtree as a prefab file (see PrefabLibrary) and makes
+    // the node an instance of it
+    static bool savePrefab(std::shared_ptr<SceneNode> node, const std::string& filepath);
+    
+    // Binary export of the same data the JSON holds (see SceneDescription)
+    static bool saveSceneToBinaryFile(std::shared_ptr<Scene> scene, const std::string& filepath);
     
     static std::vector<std::string> discoverAndGenerateTextureAssets();
     static void updateMakefileWithTextures(const std::vector<std::string>& discoveredTextures);
@@ -41,6 +54,9 @@ public:
     
     static void updateMakefileWithAssets(const std::vector<std::string>& discoveredTextures, const std::vector<std::string>& discoveredFonts, const std::vector<std::string>& discoveredModels, const std::vector<std::string>& discoveredScripts);
     
+    // Whole file in one read (resolved under app0: on Vita)
+    static bool readSceneFile(const std::string& filepath, std::vector<uint8_t>& data);
+    
     static std::string convertToVitaPath(const std::string& path);
     static std::string convertToLinuxPath(const std::string& path);
 
@@ -48,11 +64,21 @@ private:
     static std::vector<std::shared_ptr<SceneNode>> getAllSceneNodesFromScene(std::shared_ptr<Scene> scene);
     static void collectAllNodesRecursive(std::shared_ptr<SceneNode> node, std::vector<std::shared_ptr<SceneNode>>& allNodes);
     static std::string sanitizeNodeName(const std::string& name);
+    // Prefab instances leave `nodes` with their subtrees; the generated mains
+    // create each through PrefabLibrary from its override JSON
+    static std::vector<std::shared_ptr<SceneNode>> extractPrefabInstances(std::vector<std::shared_ptr<SceneNode>>& nodes);
+    static std::string generatePrefabInstanceCode(const std::vector<std::shared_ptr<SceneNode>>& instances,
+                                                  const std::map<SceneNode*, std::string>& nodeNameMap);
     
+    // Instance roots are written as their prefab path and what differs from it
     static nlohmann::json serializeNodeToJson(std::shared_ptr<SceneNode> node);
-    static std::shared_ptr<SceneNode> deserializeNodeFromJson(const nlohmann::json& nodeJson);
+    static nlohmann::json serializePrefabInstance(const nlohmann::json& nodeJson, const std::string& prefabPath);
+    static nlohmann::json buildSceneJson(std::shared_ptr<Scene> scene);
     static std::string serializeSceneToJson(std::shared_ptr<Scene> scene);
-    static std::shared_ptr<Scene> deserializeSceneFromJson(const std::string& jsonData);
+    // .bscene or JSON, told apart by the file's magic
+    static std::shared_ptr<Scene> loadSceneData(const std::string& filepath, const SceneLoadCallback& progress);
+    
+    static bool writeSceneFile(const std::string& filepath, const void* data, size_t size);
 };
 
 } // namespace GameEngine
@@ -0,0 +1,21 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include "LinearMath/btThreads.h"
+
+namespace GameEngine {
+
+// btParallelFor on the task scheduler PhysicsManager (or a tool) installed.
+// Built with BT_THREADSAFE, Bullet uses the scheduler without a null check,
+// so when none is installed the body runs inline on the calling thread
+inline void parallelForOrInline(int begin, int end, int grainSize, const btIParallelForBody& body) {
+    if (btGetTaskScheduler()) {
+        btParallelFor(begin, end, grainSize, body);
+    } else {
+        body.forLoop(begin, end);
+    }
+}
+
+} // namespace GameEngine
+
+#endif // PARALLEL_FOR_H
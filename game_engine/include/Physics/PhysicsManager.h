@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
 
 class btDiscreteDynamicsWorld;
@@ -36,6 +37,19 @@ public:
     void shutdown();
     void update(float deltaTime);
     
+    // Advances the world by exactly one step of the given length (no accumulator,
+    // no interpolation) so runs are reproducible step for step
+    void stepFixed(float fixedTimeStep);
+    
+    // Worker thread count used by the next initialize() (0 = pick automatically)
+    void setRequestedThreadCount(int count) { requestedThreadCount = count; }
+    int getRequestedThreadCount() const { return requestedThreadCount; }
+    int getThreadCount() const;
+    
+    // Statistics
+    int getRigidBodyCount() const;
+    int getContactCount() const;
+    uint64_t computeStateHash() const;
     
     // Physics world management
     btDiscreteDynamicsWorld* getDynamicsWorld() const { return dynamicsWorld; }
@@ -87,6 +101,8 @@ private:
     
     // Debug drawing
     bool debugDrawEnabled;
+    
+    int requestedThreadCount;
 
     void cleanupPhysicsObjects();
     
@@ -5,6 +5,7 @@
 #include <memory>
 #include <unordered_map>
 #include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
 
 namespace GameEngine {
@@ -15,51 +16,107 @@ namespace GameEngine {
 
 namespace GameEngine {
 
-struct FontAtlas {
-    std::shared_ptr<Texture> texture;
-    std::vector<stbtt_packedchar> packedChars;
-    std::vector<stbtt_aligned_quad> alignedQuads;
-    uint32_t atlasWidth;
-    uint32_t atlasHeight;
-    uint32_t fontSize;
-    uint32_t charsToInclude;
-    uint32_t firstCharCodePoint;
-    
-    FontAtlas() : atlasWidth(0), atlasHeight(0), fontSize(0), charsToInclude(0), firstCharCodePoint(0) {}
+// A loaded TrueType file; its glyphs are rasterized on demand into the shared
+// glyph cache. Metrics are in SDF base pixels (FontManager::SDF_BASE_SIZE)
+struct FontFace {
+    std::string path;
+    std::vector<uint8_t> data;
+    stbtt_fontinfo info;
+    uint32_t id;
+    float sdfScale;
+    float ascent;
+    float descent;
+    float lineGap;
+
+    FontFace() : id(0), sdfScale(0.0f), ascent(0.0f), descent(0.0f), lineGap(0.0f) {}
 };
 
+struct GlyphInfo {
+    uint32_t pageId;
+    glm::vec2 uvMin;        // top-left texel of the glyph in its page
+    glm::vec2 uvMax;
+    glm::vec2 offset;       // top-left of the quad relative to the pen, y down
+    glm::vec2 size;
+    float advance;
+    bool hasBitmap;         // false for whitespace
+
+    GlyphInfo() : pageId(0), uvMin(0.0f), uvMax(0.0f), offset(0.0f), size(0.0f), advance(0.0f), hasBitmap(false) {}
+};
+
+// Owns font files and a dynamically packed cache of signed-distance-field
+// glyphs. One SDF rasterization serves every text size, pages are packed
+// with a skyline allocator and, once the memory budget is reached, the least
+// recently used page is cleared and reused
 class FontManager {
 public:
+    static const int SDF_BASE_SIZE = 48;    // pixel height glyphs are rasterized at
+    static const int SDF_PADDING = 6;       // distance field spread in pixels
+    static const int PAGE_SIZE = 512;
+
     static FontManager& getInstance();
-    
-    std::shared_ptr<FontAtlas> loadFont(const std::string& fontPath, float fontSize, 
-                                       uint32_t atlasWidth = 512, uint32_t atlasHeight = 512,
-                                       uint32_t charsToInclude = 95, uint32_t firstCharCodePoint = 32);
-    
-    std::shared_ptr<FontAtlas> getFont(const std::string& fontPath, float fontSize);
-    
-    bool generateFontAtlas(const std::string& fontPath, float fontSize, FontAtlas& atlas,
-                          uint32_t atlasWidth = 512, uint32_t atlasHeight = 512,
-                          uint32_t charsToInclude = 95, uint32_t firstCharCodePoint = 32);
-    
+
+    std::shared_ptr<FontFace> loadFace(const std::string& fontPath);
+    std::shared_ptr<FontFace> getFace(const std::string& fontPath);
+
+    // Looks the glyph up, rasterizing it on first use. Code points the font
+    // lacks map to its .notdef glyph; returns nullptr only if caching failed
+    const GlyphInfo* getGlyph(FontFace& face, uint32_t codepoint);
+    std::shared_ptr<Texture> getPageTexture(uint32_t pageId) const;
+    // Marks a page as used this frame so it is not the next one evicted
+    void touchPage(uint32_t pageId);
+
+    // Bumped whenever a page is evicted; glyph runs built against an older
+    // epoch may reference cleared texels and must be rebuilt
+    uint32_t getCacheEpoch() const { return cacheEpoch; }
+
+    void setCacheBudget(size_t bytes);
+    size_t getCacheBudget() const { return cacheBudget; }
+    size_t getCacheMemory() const;
+    size_t getCachedGlyphCount() const { return glyphs.size(); }
+
     void clearCache();
-    void removeFont(const std::string& fontPath, float fontSize);
-    
-    std::string getFontKey(const std::string& fontPath, float fontSize) const;
-    bool isFontLoaded(const std::string& fontPath, float fontSize) const;
-    
+    void removeFont(const std::string& fontPath);
+    bool isFontLoaded(const std::string& fontPath) const;
+
+    // Decodes the code point starting at index and moves index past it;
+    // malformed sequences yield U+FFFD and skip one byte
+    static uint32_t decodeUTF8(const std::string& text, size_t& index);
+
 private:
-    FontManager() = default;
+    FontManager();
     ~FontManager() = default;
-    
+
     FontManager(const FontManager&) = delete;
     FontManager& operator=(const FontManager&) = delete;
-    
-    std::unordered_map<std::string, std::shared_ptr<FontAtlas>> fontCache;
-    
+
+    struct SkylineNode {
+        int x;
+        int y;
+        int width;
+    };
+
+    struct GlyphPage {
+        std::shared_ptr<Texture> texture;
+        std::vector<SkylineNode> skyline;
+        std::vector<uint64_t> glyphKeys;
+        uint64_t lastUsed;
+    };
+
+    std::unordered_map<std::string, std::shared_ptr<FontFace>> faces;
+    std::unordered_map<uint64_t, GlyphInfo> glyphs;     // (face id, glyph index)
+    std::vector<GlyphPage> pages;
+
+    uint32_t nextFaceId;
+    uint32_t cacheEpoch;
+    uint64_t useClock;
+    size_t cacheBudget;
+
     bool loadFontFile(const std::string& fontPath, std::vector<uint8_t>& fontData);
-    bool createFontAtlasTexture(const std::vector<uint8_t>& atlasData, uint32_t width, uint32_t height, 
-                               std::shared_ptr<Texture>& texture);
+    bool allocateGlyphRect(int width, int height, uint32_t& pageId, int& x, int& y);
+    bool packIntoPage(GlyphPage& page, int width, int height, int& x, int& y);
+    bool createPage();
+    void evictPage(uint32_t pageId);
+    void clearPageTexture(GlyphPage& page);
 };
 
 } // namespace GameEngine
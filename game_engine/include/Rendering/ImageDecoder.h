@@ -0,0 +1,40 @@
+#ifndef IMAGE_DECODER_H
+#define IMAGE_DECODER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace GameEngine {
+
+// An image decoded on the CPU and waiting for its GL upload
+struct DecodedImage {
+    std::string path;
+    int width;
+    int height;
+    int channels;
+    std::vector<uint8_t> pixels;    // top row first, `channels` bytes per pixel
+    std::string error;              // why decoding failed, empty on success
+
+    DecodedImage() : width(0), height(0), channels(0) {}
+    bool isValid() const { return !pixels.empty(); }
+};
+
+// Reads and decodes PNG/JPG files with stb_image. Pure CPU work that needs
+// no GL context, so a batch can be decoded on Bullet's task scheduler
+// threads and uploaded serially afterwards on the GL thread
+class ImageDecoder {
+public:
+    // desiredChannels 0 keeps the channel count stored in the file
+    static bool decode(const std::string& path, DecodedImage& image, int desiredChannels = 0);
+    // One image per path, in input order. Failed entries come back invalid
+    // with their error set; nothing is logged from the worker threads
+    static void decodeAll(const std::vector<std::string>& paths, std::vector<DecodedImage>& images,
+                          int desiredChannels = 0);
+
+    static bool readFile(const std::string& path, std::vector<uint8_t>& data);
+};
+
+} // namespace GameEngine
+
+#endif // IMAGE_DECODER_H
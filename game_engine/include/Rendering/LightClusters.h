@@ -0,0 +1,140 @@
+#ifndef LIGHT_CLUSTERS_H
+#define LIGHT_CLUSTERS_H
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+namespace GameEngine {
+
+// Light as seen by the cluster pass. Point and spot lights are bounded by a
+// sphere of the given range; directional lights (or lights without a range)
+// affect every cluster
+struct ClusterLight {
+    glm::vec3 position;     // world space
+    float range;
+    bool directional;
+
+    ClusterLight() : position(0.0f), range(0.0f), directional(false) {}
+    ClusterLight(const glm::vec3& pos, float r, bool isDirectional)
+        : position(pos), range(r), directional(isDirectional) {}
+};
+
+struct LightCluster {
+    uint32_t offset;        // first entry in LightClusterGrid::getLightIndices()
+    uint32_t count;
+};
+
+// Froxel grid over the camera frustum: tilesX x tilesY screen tiles and
+// exponentially spaced depth slices. build() assigns every bounded light to
+// the clusters its sphere touches and stores the result as one compact index
+// list plus an (offset, count) pair per cluster. Assignment runs in parallel
+// over clusters on Bullet's task scheduler and needs no GL context
+class LightClusterGrid {
+public:
+    static const int DEFAULT_TILES_X = 16;
+    static const int DEFAULT_TILES_Y = 9;
+    static const int DEFAULT_SLICES = 24;
+
+    LightClusterGrid();
+
+    void setDimensions(int tilesX, int tilesY, int slices);
+    int getTilesX() const { return tilesX; }
+    int getTilesY() const { return tilesY; }
+    int getSlices() const { return slices; }
+    size_t getClusterCount() const { return clusters.size(); }
+
+    // Light indices written to the grid refer to positions in lights
+    void build(const glm::mat4& view, const glm::mat4& projection,
+               float nearPlane, float farPlane,
+               const std::vector<ClusterLight>& lights);
+
+    size_t getClusterIndex(int x, int y, int z) const {
+        return (static_cast<size_t>(z) * tilesY + y) * tilesX + x;
+    }
+    const LightCluster& getCluster(size_t index) const { return clusters[index]; }
+    const std::vector<uint32_t>& getLightIndices() const { return lightIndices; }
+    // Directional and unbounded lights, not stored per cluster
+    const std::vector<uint32_t>& getGlobalLights() const { return globalLights; }
+    // Bounded lights overlapping the depth range of the grid this frame
+    const std::vector<uint32_t>& getVisibleLights() const { return visibleLights; }
+
+    // View-space bounds of a cluster
+    void getClusterBounds(size_t index, glm::vec3& outMin, glm::vec3& outMax) const;
+    const glm::vec3& getViewPosition(uint32_t lightIndex) const { return viewLights[lightIndex].center; }
+
+    // Appends every bounded light that may touch a world-space box (given as a
+    // local box and its transform) inside the frustum, each at most once.
+    // Global lights are not included
+    void gatherLights(const glm::vec3& localMin, const glm::vec3& localMax,
+                      const glm::mat4& modelMatrix, std::vector<uint32_t>& out) const;
+
+    static bool sphereIntersectsAABB(const glm::vec3& center, float radius,
+                                     const glm::vec3& boxMin, const glm::vec3& boxMax);
+
+    struct Stats {
+        double buildMs;
+        size_t assignments;         // total (cluster, light) pairs
+        uint32_t maxLightsPerCluster;
+    };
+    const Stats& getLastBuildStats() const { return lastStats; }
+
+private:
+    struct ViewLight {
+        glm::vec3 center;           // view space
+        float radius;
+    };
+
+    struct ClusterRange {
+        int minX, maxX;
+        int minY, maxY;
+        int minZ, maxZ;
+    };
+
+    int tilesX;
+    int tilesY;
+    int slices;
+
+    std::vector<LightCluster> clusters;
+    std::vector<uint32_t> lightIndices;
+    std::vector<uint32_t> globalLights;
+    std::vector<uint32_t> visibleLights;
+
+    // Per-cluster view-space AABBs, rebuilt only when the projection changes
+    std::vector<glm::vec3> boundsMin;
+    std::vector<glm::vec3> boundsMax;
+    glm::mat4 boundsProjection;
+    float boundsNear;
+    float boundsFar;
+    bool boundsValid;
+
+    glm::mat4 viewMatrix;
+    glm::mat4 projectionMatrix;
+    float nearPlane;
+    float farPlane;
+    float sliceScale;               // slices / log(far / near)
+
+    std::vector<ViewLight> viewLights;
+    // Lights overlapping each depth slice, so a cluster only tests candidates
+    std::vector<std::vector<uint32_t>> sliceLights;
+
+    mutable std::vector<uint32_t> gatherStamps;
+    mutable uint32_t gatherStamp;
+
+    Stats lastStats;
+
+    void rebuildClusterBounds();
+    int depthToSlice(float depth) const;
+    // Conservative cluster range covered by a view-space box; false if the
+    // box lies entirely outside the depth range of the grid
+    bool computeRange(const glm::vec3& viewMin, const glm::vec3& viewMax, ClusterRange& out) const;
+    uint32_t countClusterLights(size_t clusterIndex) const;
+    void fillClusterLights(size_t clusterIndex);
+
+    friend struct ClusterCountBody;
+    friend struct ClusterFillBody;
+};
+
+} // namespace GameEngine
+
+#endif // LIGHT_CLUSTERS_H
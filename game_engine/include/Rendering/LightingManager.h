@@ -1,38 +1,78 @@
 #ifndef LIGHTING_MANAGER_H
 #define LIGHTING_MANAGER_H
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
 #include "Components/LightComponent.h"
+#include "Rendering/LightClusters.h"
 
 namespace GameEngine {
 
+// Any number of lights can be registered. Each frame buildClusters() bins
+// them into a froxel grid and, per draw, selectLightsForBounds() picks the at
+// most MAX_LIGHTS lights that reach the object; that selection is what
+// getLightDataArray()/getActiveLightCount() report to materials
 class LightingManager {
 public:
     static LightingManager& getInstance();
-    
+
     void addLight(LightComponent* light);
     void removeLight(LightComponent* light);
     void clearLights();
-    
+
     const std::vector<LightComponent*>& getLights() const { return lights; }
-    
-    std::vector<LightComponent::LightData> getLightDataArray() const;
-    
+
+    // Lights uploaded for the current draw, padded to MAX_LIGHTS entries
+    const std::vector<LightComponent::LightData>& getLightDataArray();
+
+    // Size of the shader light array, i.e. the most lights a single draw sees
     static constexpr size_t MAX_LIGHTS = 16;
-    size_t getActiveLightCount() const { return std::min(lights.size(), MAX_LIGHTS); }
+    size_t getActiveLightCount();
     size_t getLightCount() const { return lights.size(); }
-    
+
     void update();
-    
+
+    // Copies every enabled light for this frame. Until the next update() the
+    // clusters and the default selection use the copies and never read a
+    // LightComponent, so lights can change while the frame is drawn
+    void captureLights();
+    // Assigns the frame's lights (captured now if they were not) to the
+    // clusters of the given camera. Without a build, draws fall back to the
+    // first MAX_LIGHTS
+    void buildClusters(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane);
+    // Selects the lights affecting a box (in model space) for the next draw:
+    // directional lights first, then the nearest clustered lights relative to
+    // their range
+    void selectLightsForBounds(const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& modelMatrix);
+    void clearSelection();
+
+    const LightClusterGrid& getClusterGrid() const { return clusterGrid; }
+
 private:
-    LightingManager() = default;
+    LightingManager();
     ~LightingManager() = default;
     LightingManager(const LightingManager&) = delete;
     LightingManager& operator=(const LightingManager&) = delete;
-    
+
     std::vector<LightComponent*> lights;
+
+    LightClusterGrid clusterGrid;
+    bool lightsCaptured;
+    bool clustersBuilt;
+    // Per-frame copies, indexed like the cluster light indices
+    std::vector<LightComponent::LightData> frameLightData;
+    std::vector<ClusterLight> frameClusterLights;
+
+    std::vector<LightComponent::LightData> selectedLightData;
+    size_t selectedCount;
+    bool hasSelection;
+    std::atomic<bool> defaultSelectionDirty;    // also set by addLight/removeLight
+    std::vector<uint32_t> candidateLights;
+
+    void buildDefaultSelection();
+    void padSelection();
 };
 
 } // namespace GameEngine
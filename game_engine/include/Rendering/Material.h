@@ -1,6 +1,8 @@
 #ifndef MATERIAL_H
 #define MATERIAL_H
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <unordered_map>
@@ -12,6 +14,30 @@ namespace GameEngine {
 class Shader;
 class Texture;
 
+// Everything Material::apply() uploads, held by value. The renderer copies one
+// per material when it captures a frame, so submitting the frame never reads
+// a Material the simulation may be editing at the same time
+struct MaterialUniforms {
+    std::shared_ptr<Shader> shader;
+    
+    glm::vec3 color = glm::vec3(1.0f);
+    float reflectionStrength = 0.0f;
+    
+    std::unordered_map<std::string, float> floatProperties;
+    std::unordered_map<std::string, int> intProperties;
+    std::unordered_map<std::string, bool> boolProperties;
+    std::unordered_map<std::string, glm::vec2> vec2Properties;
+    std::unordered_map<std::string, glm::vec3> vec3Properties;
+    std::unordered_map<std::string, glm::vec4> vec4Properties;
+    std::unordered_map<std::string, glm::mat3> mat3Properties;
+    std::unordered_map<std::string, glm::mat4> mat4Properties;
+    std::unordered_map<std::string, std::shared_ptr<Texture>> textureProperties;
+    
+    std::shared_ptr<Texture> diffuseTexture;
+    std::shared_ptr<Texture> normalTexture;
+    std::shared_ptr<Texture> armTexture;
+};
+
 class Material {
 public:
     Material();
@@ -19,7 +45,7 @@ public:
     ~Material();
     
     void setShader(std::shared_ptr<Shader> shader);
-    std::shared_ptr<Shader> getShader() const { return shader; }
+    std::shared_ptr<Shader> getShader() const { return uniforms.shader; }
     
     void setFloat(const std::string& name, float value);
     void setInt(const std::string& name, int value);
@@ -32,12 +58,20 @@ public:
     void setTexture(const std::string& name, std::shared_ptr<Texture> texture);
     
     void apply() const;
-    
-    glm::vec3 getColor() const { return color; }
+    // Uploads a copy taken with getUniforms(); touches no Material
+    static void applyUniforms(const MaterialUniforms& uniforms);
+    const MaterialUniforms& getUniforms() const { return uniforms; }
+    // Creation order; the renderer sorts on this rather than on addresses so draw order is reproducible
+    uint32_t getSortId() const { return sortId; }
+    // Same properties and textures under a new sort id, for editing one user
+    // of a shared material
+    std::shared_ptr<Material> clone() const;
+    
+    glm::vec3 getColor() const { return uniforms.color; }
     void setColor(const glm::vec3& c) { 
-        color = c; 
-        setVec3("diffuseColor", color);
-        setVec3("u_Color", color);
+        uniforms.color = c; 
+        setVec3("diffuseColor", c);
+        setVec3("u_Color", c);
     }
     
     float getMetallic() const { return metallic; }
@@ -46,16 +80,16 @@ public:
     float getRoughness() const { return roughness; }
     void setRoughness(float r) { roughness = r; setFloat("u_Roughness", roughness); }
     
-    float getReflectionStrength() const { return reflectionStrength; }
-    void setReflectionStrength(float r) { reflectionStrength = r; setFloat("u_ReflectionStrength", reflectionStrength); }
+    float getReflectionStrength() const { return uniforms.reflectionStrength; }
+    void setReflectionStrength(float r) { uniforms.reflectionStrength = r; setFloat("u_ReflectionStrength", r); }
     
-    std::shared_ptr<Texture> getDiffuseTexture() const { return diffuseTexture; }
+    std::shared_ptr<Texture> getDiffuseTexture() const { return uniforms.diffuseTexture; }
     void setDiffuseTexture(std::shared_ptr<Texture> texture, const std::string& path = "");
     
-    std::shared_ptr<Texture> getNormalTexture() const { return normalTexture; }
+    std::shared_ptr<Texture> getNormalTexture() const { return uniforms.normalTexture; }
     void setNormalTexture(std::shared_ptr<Texture> texture, const std::string& path = "");
     
-    std::shared_ptr<Texture> getARMTexture() const { return armTexture; }
+    std::shared_ptr<Texture> getARMTexture() const { return uniforms.armTexture; }
     void setARMTexture(std::shared_ptr<Texture> texture, const std::string& path = "");
     
     std::string getDiffuseTexturePath() const { return diffuseTexturePath; }
@@ -67,45 +101,31 @@ public:
     std::string getARMTexturePath() const { return armTexturePath; }
     void setARMTexturePath(const std::string& path) { armTexturePath = path; }
     
-    bool hasDiffuseTexture() const { return diffuseTexture != nullptr; }
-    bool hasNormalTexture() const { return normalTexture != nullptr; }
-    bool hasARMTexture() const { return armTexture != nullptr; }
+    bool hasDiffuseTexture() const { return uniforms.diffuseTexture != nullptr; }
+    bool hasNormalTexture() const { return uniforms.normalTexture != nullptr; }
+    bool hasARMTexture() const { return uniforms.armTexture != nullptr; }
     
     void drawInspector();
     
-    void setupLightingUniforms() const;
     void setCameraPosition(const glm::vec3& cameraPos);
     
     static std::shared_ptr<Material> getDefaultMaterial();
     static std::shared_ptr<Material> getErrorMaterial();
     
 private:
-    std::shared_ptr<Shader> shader;
+    static std::atomic<uint32_t> nextSortId;
+    uint32_t sortId;
     
-    std::unordered_map<std::string, float> floatProperties;
-    std::unordered_map<std::string, int> intProperties;
-    std::unordered_map<std::string, bool> boolProperties;
-    std::unordered_map<std::string, glm::vec2> vec2Properties;
-    std::unordered_map<std::string, glm::vec3> vec3Properties;
-    std::unordered_map<std::string, glm::vec4> vec4Properties;
-    std::unordered_map<std::string, glm::mat3> mat3Properties;
-    std::unordered_map<std::string, glm::mat4> mat4Properties;
-    std::unordered_map<std::string, std::shared_ptr<Texture>> textureProperties;
-    
-    glm::vec3 color;
+    MaterialUniforms uniforms;
     float metallic;
     float roughness;
-    float reflectionStrength;
-    
-    std::shared_ptr<Texture> diffuseTexture;
-    std::shared_ptr<Texture> normalTexture;
-    std::shared_ptr<Texture> armTexture;
     
     std::string diffuseTexturePath;
     std::string normalTexturePath;
     std::string armTexturePath;
     
-    void applyProperties() const;
+    static void applyProperties(const MaterialUniforms& uniforms);
+    static void setupLightingUniforms(const MaterialUniforms& uniforms);
 };
 
 } // namespace GameEngine
@@ -6,6 +6,8 @@
 #include <glm/glm.hpp>
 #include <memory>
 #include "Platform.h"
+#include "Rendering/VertexFormat.h"
+#include "Rendering/MeshOptimizer.h"
 
 namespace GameEngine {
 
@@ -47,6 +49,14 @@ public:
     void setIndices(const std::vector<unsigned int>& indices);
     void upload();
     void uploadAndClearCPUData();
+
+    // Reorders CPU-side triangle data for the post-transform cache, overdraw
+    // and vertex fetch; must run before the CPU data is cleared
+    MeshOptimizer::Stats optimize(const MeshOptimizer::Options& options = MeshOptimizer::Options());
+    // Optimized, simplified copy for a lower LOD. triangleRatio applies to the
+    // triangle count; maxError and resultError are relative to the largest
+    // bounds extent. Null without CPU data or when nothing could be removed
+    std::shared_ptr<Mesh> createSimplified(float triangleRatio, float maxError, float* resultError = nullptr) const;
     
     void bind() const;
     void unbind() const;
@@ -64,7 +74,20 @@ public:
     
     void setRenderMode(GLenum mode) { renderMode = mode; }
     GLenum getRenderMode() const { return renderMode; }
+    // GL_UNSIGNED_SHORT when the uploaded mesh has at most 65536 vertices
+    GLenum getIndexType() const { return indexType; }
     
+    // GPU layout used on the next upload; AUTO picks the smallest layout the
+    // vertex data fits
+    void setVertexFormat(VertexFormat format);
+    VertexFormat getVertexFormat() const { return vertexFormat; }
+    const VertexLayout& getVertexLayout() const { return vertexLayout; }
+    size_t getVertexBufferSize() const { return vertexLayout.getStride() * getVertexCount(); }
+
+    // Compact layouts are on by default; when off every mesh uploads FULL
+    static void setCompactVertexFormats(bool enabled);
+    static bool getCompactVertexFormats();
+
     const std::vector<Vertex>& getVertices() const { return vertices; }
     const std::vector<unsigned int>& getIndices() const { return indices; }
     
@@ -102,6 +125,13 @@ private:
     MeshType meshType;
     
     GLenum renderMode;
+    GLenum indexType;
+
+    VertexFormat vertexFormat;
+    VertexLayout vertexLayout;
+    // Bone data of layouts without per-vertex bone attributes
+    glm::vec4 constantBoneWeights;
+    glm::vec4 constantBoneIndices;
     
     void calculateBounds();
     void calculateTangents();
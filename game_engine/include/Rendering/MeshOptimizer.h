@@ -0,0 +1,75 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace GameEngine {
+
+struct Vertex;
+
+// Cook-time reordering of indexed triangle lists. Pure CPU work, needs no GL
+// context. optimize() runs the whole pipeline; the individual passes are
+// exposed for tools and tests
+class MeshOptimizer {
+public:
+    struct Options {
+        bool deduplicate;           // merge bitwise identical vertices
+        bool optimizeVertexCache;   // Tipsify triangle order
+        bool optimizeOverdraw;      // reorder cache-friendly clusters front-to-back
+        bool optimizeVertexFetch;   // vertices in first-use order
+        unsigned int cacheSize;     // FIFO post-transform cache entries
+        float overdrawThreshold;    // allowed ACMR growth from overdraw reordering
+
+        Options()
+            : deduplicate(true)
+            , optimizeVertexCache(true)
+            , optimizeOverdraw(true)
+            , optimizeVertexFetch(true)
+            , cacheSize(16)
+            , overdrawThreshold(1.05f)
+        {}
+    };
+
+    struct Stats {
+        size_t verticesBefore;
+        size_t verticesAfter;
+        size_t triangles;
+        float acmrBefore;           // average cache misses per triangle
+        float acmrAfter;
+        float atvrBefore;           // cache misses per vertex, 1.0 is optimal
+        float atvrAfter;
+        bool fitsIn16Bit;
+        double optimizeMs;
+    };
+
+    // Triangle lists only. Unindexed input gets an index buffer; triangles
+    // made degenerate by deduplication are dropped
+    static Stats optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                          const Options& options = Options());
+
+    // Returns the new vertex count and fills remap[old] = new
+    static size_t generateDeduplicationRemap(const std::vector<Vertex>& vertices, std::vector<unsigned int>& remap);
+    static void applyRemap(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                           const std::vector<unsigned int>& remap, size_t newVertexCount);
+    static size_t removeDegenerateTriangles(std::vector<unsigned int>& indices);
+
+    // Tipsify (Sander et al. 2007). clusterStarts, if given, receives the
+    // first triangle of each run that began after a cache flush
+    static void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount,
+                                    unsigned int cacheSize, std::vector<unsigned int>* clusterStarts = nullptr);
+    // Splits the hard clusters where their local ACMR allows it, then sorts
+    // the clusters so outward-facing ones are drawn first
+    static void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+                                 const std::vector<unsigned int>& clusterStarts,
+                                 unsigned int cacheSize, float threshold);
+    static void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+    // FIFO cache simulation, misses per triangle
+    static float computeACMR(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize);
+};
+
+} // namespace GameEngine
+
+#endif // MESH_OPTIMIZER_H
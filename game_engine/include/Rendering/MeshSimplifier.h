@@ -0,0 +1,31 @@
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include <vector>
+#include <cstddef>
+
+namespace GameEngine {
+
+struct Vertex;
+
+// Quadric error metric edge collapse (Garland & Heckbert). Vertices collapse
+// onto existing neighbours, so the output indexes the input vertex array and
+// every attribute (UVs, normals, bone data) stays valid. Vertices on open
+// borders or attribute seams (several vertices sharing a position) are
+// locked. Pure CPU work, needs no GL context
+class MeshSimplifier {
+public:
+    // Collapses edges cheapest first until the triangle list is down to
+    // targetIndexCount indices or the next collapse would move the surface by
+    // more than targetError (relative to the largest bounds extent). Returns
+    // the error reached, in the same relative units
+    static float simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                          size_t targetIndexCount, float targetError, std::vector<unsigned int>& result);
+
+    // Largest extent of the vertex bounds; relative errors scale by this
+    static float computeExtent(const std::vector<Vertex>& vertices);
+};
+
+} // namespace GameEngine
+
+#endif // MESH_SIMPLIFIER_H
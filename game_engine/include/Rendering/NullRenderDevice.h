@@ -0,0 +1,141 @@
+#ifndef NULL_RENDER_DEVICE_H
+#define NULL_RENDER_DEVICE_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Rendering/RenderDevice.h"
+
+namespace GameEngine {
+
+// No GPU behind it. Hands out object names, keeps enough state to answer
+// the queries the engine makes (viewport, depth, polygon mode, bindings),
+// reports every shader and framebuffer as valid, and counts what a real
+// device would have done. With recording on, every call is also appended
+// to a command log that tests can compare frame to frame
+class NullRenderDevice : public RenderDevice {
+public:
+    NullRenderDevice();
+
+    void setRecording(bool enabled) { recording = enabled; }
+    bool isRecording() const { return recording; }
+    const std::vector<RenderDeviceCommand>& getCommands() const { return commands; }
+    void clearCommands() { commands.clear(); }
+    // Objects created and not yet deleted, for leak checks
+    size_t getLiveObjectCount() const { return liveObjects.size(); }
+
+    void enable(GLenum cap) override;
+    void disable(GLenum cap) override;
+    GLboolean isEnabled(GLenum cap) override;
+    void getIntegerv(GLenum pname, GLint* data) override;
+    void getBooleanv(GLenum pname, GLboolean* data) override;
+    void viewport(GLint x, GLint y, GLsizei width, GLsizei height) override;
+    void clearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) override;
+    void clear(GLbitfield mask) override;
+    void cullFace(GLenum mode) override;
+    void depthFunc(GLenum func) override;
+    void depthMask(GLboolean flag) override;
+    void polygonMode(GLenum face, GLenum mode) override;
+    void blendFunc(GLenum sfactor, GLenum dfactor) override;
+    void pixelStorei(GLenum pname, GLint param) override;
+
+    void genBuffers(GLsizei n, GLuint* buffers) override;
+    void deleteBuffers(GLsizei n, const GLuint* buffers) override;
+    void bindBuffer(GLenum target, GLuint buffer) override;
+    void bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) override;
+    void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) override;
+    void genVertexArrays(GLsizei n, GLuint* arrays) override;
+    void deleteVertexArrays(GLsizei n, const GLuint* arrays) override;
+    void bindVertexArray(GLuint array) override;
+    void enableVertexAttribArray(GLuint index) override;
+    void disableVertexAttribArray(GLuint index) override;
+    void vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                             GLsizei stride, const void* pointer) override;
+    void vertexAttrib4fv(GLuint index, const GLfloat* values) override;
+
+    void drawArrays(GLenum mode, GLint first, GLsizei count) override;
+    void drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) override;
+
+    void activeTexture(GLenum unit) override;
+    void genTextures(GLsizei n, GLuint* textures) override;
+    void deleteTextures(GLsizei n, const GLuint* textures) override;
+    void bindTexture(GLenum target, GLuint texture) override;
+    void texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                    GLint border, GLenum format, GLenum type, const void* pixels) override;
+    void texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                       GLsizei height, GLenum format, GLenum type, const void* pixels) override;
+    void compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width,
+                              GLsizei height, GLint border, GLsizei imageSize, const void* data) override;
+    void texParameteri(GLenum target, GLenum pname, GLint param) override;
+    void generateMipmap(GLenum target) override;
+
+    void genFramebuffers(GLsizei n, GLuint* framebuffers) override;
+    void deleteFramebuffers(GLsizei n, const GLuint* framebuffers) override;
+    void bindFramebuffer(GLenum target, GLuint framebuffer) override;
+    void framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget,
+                              GLuint texture, GLint level) override;
+    GLenum checkFramebufferStatus(GLenum target) override;
+
+    GLuint createShader(GLenum type) override;
+    void deleteShader(GLuint shader) override;
+    void shaderSource(GLuint shader, GLsizei count, const GLchar* const* source, const GLint* length) override;
+    void compileShader(GLuint shader) override;
+    void getShaderiv(GLuint shader, GLenum pname, GLint* params) override;
+    void getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) override;
+    GLuint createProgram() override;
+    void deleteProgram(GLuint program) override;
+    void attachShader(GLuint program, GLuint shader) override;
+    void bindAttribLocation(GLuint program, GLuint index, const GLchar* name) override;
+    void linkProgram(GLuint program) override;
+    void getProgramiv(GLuint program, GLenum pname, GLint* params) override;
+    void getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) override;
+    void useProgram(GLuint program) override;
+    GLint getUniformLocation(GLuint program, const GLchar* name) override;
+    GLint getAttribLocation(GLuint program, const GLchar* name) override;
+    void uniform1i(GLint location, GLint value) override;
+    void uniform1f(GLint location, GLfloat value) override;
+    void uniform2fv(GLint location, GLsizei count, const GLfloat* value) override;
+    void uniform3fv(GLint location, GLsizei count, const GLfloat* value) override;
+    void uniform4fv(GLint location, GLsizei count, const GLfloat* value) override;
+    void uniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) override;
+    void uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) override;
+
+private:
+    bool recording;
+    std::vector<RenderDeviceCommand> commands;
+
+    GLuint nextName;
+    std::set<GLuint> liveObjects;
+    std::set<GLenum> enabledCaps;
+    GLint viewportRect[4];
+    GLfloat clearColorValue[4];
+    GLenum cullFaceMode;
+    GLenum depthFuncValue;
+    GLboolean depthMaskValue;
+    GLenum polygonModeValue;
+    GLenum blendSource;
+    GLenum blendDestination;
+    GLenum activeTextureUnit;
+    GLuint currentProgram;
+    GLuint boundVertexArray;
+    GLuint boundFramebuffer;
+    std::map<GLenum, GLuint> boundBuffers;
+    std::map<std::pair<GLenum, GLenum>, GLuint> boundTextures;   // (unit, target)
+    // Uniform and attribute names get stable per-program locations
+    std::map<std::pair<GLuint, std::string>, GLint> locations;
+    std::map<GLuint, GLint> nextLocation;
+
+    void record(const char* name, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0);
+    template<typename T>
+    bool changeState(T& current, const T& value);
+    void generateNames(GLsizei n, GLuint* names);
+    void deleteNames(GLsizei n, const GLuint* names);
+    void uploadUniform(GLint location, size_t bytes);
+    void countDraw(GLsizei count);
+};
+
+} // namespace GameEngine
+
+#endif // NULL_RENDER_DEVICE_H
@@ -0,0 +1,102 @@
+#ifndef PROXY_RENDER_DEVICE_H
+#define PROXY_RENDER_DEVICE_H
+
+#include <functional>
+#include "Rendering/RenderDevice.h"
+
+namespace GameEngine {
+
+// Stands in for the render device on a thread that has no GL context (the
+// simulation thread of a pipelined frame). Every call is handed to `run`,
+// which executes it on the render thread and returns once it has, so
+// out-parameters and return values work as usual. Meant for the occasional
+// load or release, not for drawing: each call waits for the render thread
+class ProxyRenderDevice : public RenderDevice {
+public:
+    typedef std::function<void(const std::function<void()>&)> Runner;
+
+    explicit ProxyRenderDevice(const Runner& runner) : run(runner) {}
+
+    void enable(GLenum cap) override;
+    void disable(GLenum cap) override;
+    GLboolean isEnabled(GLenum cap) override;
+    void getIntegerv(GLenum pname, GLint* data) override;
+    void getBooleanv(GLenum pname, GLboolean* data) override;
+    void viewport(GLint x, GLint y, GLsizei width, GLsizei height) override;
+    void clearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) override;
+    void clear(GLbitfield mask) override;
+    void cullFace(GLenum mode) override;
+    void depthFunc(GLenum func) override;
+    void depthMask(GLboolean flag) override;
+    void polygonMode(GLenum face, GLenum mode) override;
+    void blendFunc(GLenum sfactor, GLenum dfactor) override;
+    void pixelStorei(GLenum pname, GLint param) override;
+
+    void genBuffers(GLsizei n, GLuint* buffers) override;
+    void deleteBuffers(GLsizei n, const GLuint* buffers) override;
+    void bindBuffer(GLenum target, GLuint buffer) override;
+    void bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) override;
+    void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) override;
+    void genVertexArrays(GLsizei n, GLuint* arrays) override;
+    void deleteVertexArrays(GLsizei n, const GLuint* arrays) override;
+    void bindVertexArray(GLuint array) override;
+    void enableVertexAttribArray(GLuint index) override;
+    void disableVertexAttribArray(GLuint index) override;
+    void vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                             GLsizei stride, const void* pointer) override;
+    void vertexAttrib4fv(GLuint index, const GLfloat* values) override;
+
+    void drawArrays(GLenum mode, GLint first, GLsizei count) override;
+    void drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) override;
+
+    void activeTexture(GLenum unit) override;
+    void genTextures(GLsizei n, GLuint* textures) override;
+    void deleteTextures(GLsizei n, const GLuint* textures) override;
+    void bindTexture(GLenum target, GLuint texture) override;
+    void texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                    GLint border, GLenum format, GLenum type, const void* pixels) override;
+    void texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                       GLsizei height, GLenum format, GLenum type, const void* pixels) override;
+    void compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width,
+                              GLsizei height, GLint border, GLsizei imageSize, const void* data) override;
+    void texParameteri(GLenum target, GLenum pname, GLint param) override;
+    void generateMipmap(GLenum target) override;
+
+    void genFramebuffers(GLsizei n, GLuint* framebuffers) override;
+    void deleteFramebuffers(GLsizei n, const GLuint* framebuffers) override;
+    void bindFramebuffer(GLenum target, GLuint framebuffer) override;
+    void framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget,
+                              GLuint texture, GLint level) override;
+    GLenum checkFramebufferStatus(GLenum target) override;
+
+    GLuint createShader(GLenum type) override;
+    void deleteShader(GLuint shader) override;
+    void shaderSource(GLuint shader, GLsizei count, const GLchar* const* source, const GLint* length) override;
+    void compileShader(GLuint shader) override;
+    void getShaderiv(GLuint shader, GLenum pname, GLint* params) override;
+    void getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) override;
+    GLuint createProgram() override;
+    void deleteProgram(GLuint program) override;
+    void attachShader(GLuint program, GLuint shader) override;
+    void bindAttribLocation(GLuint program, GLuint index, const GLchar* name) override;
+    void linkProgram(GLuint program) override;
+    void getProgramiv(GLuint program, GLenum pname, GLint* params) override;
+    void getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) override;
+    void useProgram(GLuint program) override;
+    GLint getUniformLocation(GLuint program, const GLchar* name) override;
+    GLint getAttribLocation(GLuint program, const GLchar* name) override;
+    void uniform1i(GLint location, GLint value) override;
+    void uniform1f(GLint location, GLfloat value) override;
+    void uniform2fv(GLint location, GLsizei count, const GLfloat* value) override;
+    void uniform3fv(GLint location, GLsizei count, const GLfloat* value) override;
+    void uniform4fv(GLint location, GLsizei count, const GLfloat* value) override;
+    void uniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) override;
+    void uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) override;
+
+private:
+    Runner run;
+};
+
+} // namespace GameEngine
+
+#endif // PROXY_RENDER_DEVICE_H
@@ -0,0 +1,237 @@
+#ifndef RENDER_DEVICE_H
+#define RENDER_DEVICE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Platform.h"
+
+namespace GameEngine {
+
+enum class RenderBackend {
+    OPENGL,         // the platform's GL context (GLFW window, vitaGL)
+    SOFTWARE,       // real GL in a hidden Mesa llvmpipe/OSMesa context
+    NULL_DEVICE     // no context at all, commands are recorded and counted
+};
+
+// Counted by the null device; the GL devices forward without bookkeeping
+struct RenderDeviceStats {
+    unsigned int commands;
+    unsigned int drawCalls;
+    unsigned int verticesSubmitted;     // vertices or indices drawn
+    unsigned int stateChanges;          // binds, enables, program/blend/depth state that changed
+    unsigned int redundantStateChanges; // the same calls setting what was already set
+    unsigned int uniformUploads;
+    unsigned int bufferUploads;
+    unsigned int textureUploads;
+    size_t bytesUploaded;               // buffer, texture and uniform data
+
+    RenderDeviceStats() { reset(); }
+    void reset() {
+        commands = drawCalls = verticesSubmitted = stateChanges = redundantStateChanges = 0;
+        uniformUploads = bufferUploads = textureUploads = 0;
+        bytesUploaded = 0;
+    }
+};
+
+struct RenderDeviceCommand {
+    const char* name;   // device method, e.g. "bindTexture"
+    uint32_t args[3];   // first integer arguments (targets, names, counts)
+};
+
+// Every GL entry point the render path uses. Renderer, Mesh, Texture,
+// Shader, Framebuffer and the text/font code go through this instead of
+// calling GL directly, so the backend can be picked at startup with
+// setBackend() (or GAME_ENGINE_RENDER_BACKEND=gl|software|null on Linux)
+// before the Engine initializes. Methods mirror their glXxx namesakes
+class RenderDevice {
+public:
+    virtual ~RenderDevice() {}
+
+    static RenderDevice& getInstance();
+    // Makes getInstance() return `device` on the calling thread (nullptr
+    // restores the backend), e.g. a ProxyRenderDevice on a thread that has
+    // no GL context
+    static void setThreadDevice(RenderDevice* device);
+    static void setBackend(RenderBackend backend);
+    static RenderBackend getBackend() { return backend; }
+    // Applies GAME_ENGINE_RENDER_BACKEND when set; false on an unknown name
+    static bool selectBackendFromEnvironment();
+    static bool parseBackend(const std::string& name, RenderBackend& result);
+    static const char* getBackendName(RenderBackend backend);
+
+    const RenderDeviceStats& getStats() const { return stats; }
+    void resetStats() { stats.reset(); }
+
+    // Fixed-function and pipeline state
+    virtual void enable(GLenum cap) = 0;
+    virtual void disable(GLenum cap) = 0;
+    virtual GLboolean isEnabled(GLenum cap) = 0;
+    virtual void getIntegerv(GLenum pname, GLint* data) = 0;
+    virtual void getBooleanv(GLenum pname, GLboolean* data) = 0;
+    virtual void viewport(GLint x, GLint y, GLsizei width, GLsizei height) = 0;
+    virtual void clearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) = 0;
+    virtual void clear(GLbitfield mask) = 0;
+    virtual void cullFace(GLenum mode) = 0;
+    virtual void depthFunc(GLenum func) = 0;
+    virtual void depthMask(GLboolean flag) = 0;
+    virtual void polygonMode(GLenum face, GLenum mode) = 0;
+    virtual void blendFunc(GLenum sfactor, GLenum dfactor) = 0;
+    virtual void pixelStorei(GLenum pname, GLint param) = 0;
+
+    // Buffers and vertex arrays
+    virtual void genBuffers(GLsizei n, GLuint* buffers) = 0;
+    virtual void deleteBuffers(GLsizei n, const GLuint* buffers) = 0;
+    virtual void bindBuffer(GLenum target, GLuint buffer) = 0;
+    virtual void bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) = 0;
+    virtual void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) = 0;
+    virtual void genVertexArrays(GLsizei n, GLuint* arrays) = 0;
+    virtual void deleteVertexArrays(GLsizei n, const GLuint* arrays) = 0;
+    virtual void bindVertexArray(GLuint array) = 0;
+    virtual void enableVertexAttribArray(GLuint index) = 0;
+    virtual void disableVertexAttribArray(GLuint index) = 0;
+    virtual void vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                                     GLsizei stride, const void* pointer) = 0;
+    virtual void vertexAttrib4fv(GLuint index, const GLfloat* values) = 0;
+
+    // Drawing
+    virtual void drawArrays(GLenum mode, GLint first, GLsizei count) = 0;
+    virtual void drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) = 0;
+
+    // Textures
+    virtual void activeTexture(GLenum unit) = 0;
+    virtual void genTextures(GLsizei n, GLuint* textures) = 0;
+    virtual void deleteTextures(GLsizei n, const GLuint* textures) = 0;
+    virtual void bindTexture(GLenum target, GLuint texture) = 0;
+    virtual void texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                            GLint border, GLenum format, GLenum type, const void* pixels) = 0;
+    virtual void texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                               GLsizei height, GLenum format, GLenum type, const void* pixels) = 0;
+    virtual void compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width,
+                                      GLsizei height, GLint border, GLsizei imageSize, const void* data) = 0;
+    virtual void texParameteri(GLenum target, GLenum pname, GLint param) = 0;
+    virtual void generateMipmap(GLenum target) = 0;
+
+    // Framebuffers
+    virtual void genFramebuffers(GLsizei n, GLuint* framebuffers) = 0;
+    virtual void deleteFramebuffers(GLsizei n, const GLuint* framebuffers) = 0;
+    virtual void bindFramebuffer(GLenum target, GLuint framebuffer) = 0;
+    virtual void framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget,
+                                      GLuint texture, GLint level) = 0;
+    virtual GLenum checkFramebufferStatus(GLenum target) = 0;
+
+    // Shaders and uniforms
+    virtual GLuint createShader(GLenum type) = 0;
+    virtual void deleteShader(GLuint shader) = 0;
+    virtual void shaderSource(GLuint shader, GLsizei count, const GLchar* const* source, const GLint* length) = 0;
+    virtual void compileShader(GLuint shader) = 0;
+    virtual void getShaderiv(GLuint shader, GLenum pname, GLint* params) = 0;
+    virtual void getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) = 0;
+    virtual GLuint createProgram() = 0;
+    virtual void deleteProgram(GLuint program) = 0;
+    virtual void attachShader(GLuint program, GLuint shader) = 0;
+    virtual void bindAttribLocation(GLuint program, GLuint index, const GLchar* name) = 0;
+    virtual void linkProgram(GLuint program) = 0;
+    virtual void getProgramiv(GLuint program, GLenum pname, GLint* params) = 0;
+    virtual void getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) = 0;
+    virtual void useProgram(GLuint program) = 0;
+    virtual GLint getUniformLocation(GLuint program, const GLchar* name) = 0;
+    virtual GLint getAttribLocation(GLuint program, const GLchar* name) = 0;
+    virtual void uniform1i(GLint location, GLint value) = 0;
+    virtual void uniform1f(GLint location, GLfloat value) = 0;
+    virtual void uniform2fv(GLint location, GLsizei count, const GLfloat* value) = 0;
+    virtual void uniform3fv(GLint location, GLsizei count, const GLfloat* value) = 0;
+    virtual void uniform4fv(GLint location, GLsizei count, const GLfloat* value) = 0;
+    virtual void uniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) = 0;
+    virtual void uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) = 0;
+
+protected:
+    RenderDeviceStats stats;
+
+private:
+    static RenderBackend backend;
+};
+
+// Forwards every call to the current GL context
+class GLRenderDevice : public RenderDevice {
+public:
+    void enable(GLenum cap) override;
+    void disable(GLenum cap) override;
+    GLboolean isEnabled(GLenum cap) override;
+    void getIntegerv(GLenum pname, GLint* data) override;
+    void getBooleanv(GLenum pname, GLboolean* data) override;
+    void viewport(GLint x, GLint y, GLsizei width, GLsizei height) override;
+    void clearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) override;
+    void clear(GLbitfield mask) override;
+    void cullFace(GLenum mode) override;
+    void depthFunc(GLenum func) override;
+    void depthMask(GLboolean flag) override;
+    void polygonMode(GLenum face, GLenum mode) override;
+    void blendFunc(GLenum sfactor, GLenum dfactor) override;
+    void pixelStorei(GLenum pname, GLint param) override;
+
+    void genBuffers(GLsizei n, GLuint* buffers) override;
+    void deleteBuffers(GLsizei n, const GLuint* buffers) override;
+    void bindBuffer(GLenum target, GLuint buffer) override;
+    void bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) override;
+    void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) override;
+    void genVertexArrays(GLsizei n, GLuint* arrays) override;
+    void deleteVertexArrays(GLsizei n, const GLuint* arrays) override;
+    void bindVertexArray(GLuint array) override;
+    void enableVertexAttribArray(GLuint index) override;
+    void disableVertexAttribArray(GLuint index) override;
+    void vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                             GLsizei stride, const void* pointer) override;
+    void vertexAttrib4fv(GLuint index, const GLfloat* values) override;
+
+    void drawArrays(GLenum mode, GLint first, GLsizei count) override;
+    void drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) override;
+
+    void activeTexture(GLenum unit) override;
+    void genTextures(GLsizei n, GLuint* textures) override;
+    void deleteTextures(GLsizei n, const GLuint* textures) override;
+    void bindTexture(GLenum target, GLuint texture) override;
+    void texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                    GLint border, GLenum format, GLenum type, const void* pixels) override;
+    void texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                       GLsizei height, GLenum format, GLenum type, const void* pixels) override;
+    void compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width,
+                              GLsizei height, GLint border, GLsizei imageSize, const void* data) override;
+    void texParameteri(GLenum target, GLenum pname, GLint param) override;
+    void generateMipmap(GLenum target) override;
+
+    void genFramebuffers(GLsizei n, GLuint* framebuffers) override;
+    void deleteFramebuffers(GLsizei n, const GLuint* framebuffers) override;
+    void bindFramebuffer(GLenum target, GLuint framebuffer) override;
+    void framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget,
+                              GLuint texture, GLint level) override;
+    GLenum checkFramebufferStatus(GLenum target) override;
+
+    GLuint createShader(GLenum type) override;
+    void deleteShader(GLuint shader) override;
+    void shaderSource(GLuint shader, GLsizei count, const GLchar* const* source, const GLint* length) override;
+    void compileShader(GLuint shader) override;
+    void getShaderiv(GLuint shader, GLenum pname, GLint* params) override;
+    void getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) override;
+    GLuint createProgram() override;
+    void deleteProgram(GLuint program) override;
+    void attachShader(GLuint program, GLuint shader) override;
+    void bindAttribLocation(GLuint program, GLuint index, const GLchar* name) override;
+    void linkProgram(GLuint program) override;
+    void getProgramiv(GLuint program, GLenum pname, GLint* params) override;
+    void getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) override;
+    void useProgram(GLuint program) override;
+    GLint getUniformLocation(GLuint program, const GLchar* name) override;
+    GLint getAttribLocation(GLuint program, const GLchar* name) override;
+    void uniform1i(GLint location, GLint value) override;
+    void uniform1f(GLint location, GLfloat value) override;
+    void uniform2fv(GLint location, GLsizei count, const GLfloat* value) override;
+    void uniform3fv(GLint location, GLsizei count, const GLfloat* value) override;
+    void uniform4fv(GLint location, GLsizei count, const GLfloat* value) override;
+    void uniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) override;
+    void uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) override;
+};
+
+} // namespace GameEngine
+
+#endif // RENDER_DEVICE_H
@@ -3,16 +3,18 @@
 
 #include <glm/glm.hpp>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include "Platform.h"
+#include "Components/CameraComponent.h"
+#include "Rendering/Material.h"
 
 namespace GameEngine {
 
 class Scene;
 class SceneNode;
 class Mesh;
-class Material;
-class CameraComponent;
+class Texture;
 class SkyboxComponent;
 
 struct RenderCommand {
@@ -22,6 +24,41 @@ struct RenderCommand {
     glm::mat3 normalMatrix;
     std::vector<glm::mat4> boneTransforms;
     bool disableCulling = false;
+    // Set by submitRenderCommand: the material's copy in RenderSnapshot::materials
+    uint32_t materialIndex = 0;
+};
+
+// Everything a frame draws, copied out of the scene by captureScene(): the
+// draw commands with their world matrices and bone palettes, the uniforms of
+// every material they use, the camera and the skybox (the lights are copied
+// into the LightingManager alongside). Submitting it reads no scene state and
+// writes no Material, so with a pipelined frame the next frame can simulate
+// while this one is drawn
+struct RenderSnapshot {
+    std::vector<RenderCommand> commands;
+    // One copy per material, shared by its commands; the frame's camera
+    // position and environment map are written into these, not the Materials
+    std::vector<MaterialUniforms> materials;
+    std::unordered_map<const Material*, uint32_t> materialIndices;
+    CameraSnapshot camera;
+    bool cameraValid = false;
+    bool cameraCaptured = false;    // the active camera was looked at this frame
+    bool sceneCaptured = false;     // and not submitted yet
+    // Set when the scene's active skybox is enabled
+    std::shared_ptr<Texture> environmentMap;
+    std::shared_ptr<Mesh> skyboxMesh;
+    MaterialUniforms skyboxMaterial;
+    
+    // Keeps the command storage for the next frame
+    void clear() {
+        commands.clear();
+        materials.clear();
+        materialIndices.clear();
+        cameraValid = cameraCaptured = sceneCaptured = false;
+        environmentMap.reset();
+        skyboxMesh.reset();
+        skyboxMaterial = MaterialUniforms();
+    }
 };
 
 class Renderer {
@@ -36,7 +73,12 @@ public:
     void endFrame();
     void present();
     
+    // captureScene() then submitScene()
     void renderScene(Scene& scene);
+    // Walks the scene into this frame's snapshot; no device calls
+    void captureScene(Scene& scene);
+    // Draws the captured snapshot, its skybox and the queued text
+    void submitScene();
     void renderNode(SceneNode& node, const glm::mat4& parentTransform = glm::mat4(1.0f));
     
     void renderMesh(const Mesh& mesh, const Material& material, const glm::mat4& modelMatrix);
@@ -59,7 +101,11 @@ public:
     bool isFrustumCullingEnabled() const { return frustumCullingEnabled; }
     
     void updateLightingUniforms();
-    glm::vec3 extractCameraPosition(const glm::mat4& viewMatrix);
+    
+    // Camera state every pass of the current frame renders with; captured
+    // once per renderScene so late camera moves don't tear a frame
+    const CameraSnapshot& getFrameCamera() const { return frame.camera; }
+    bool hasFrameCamera() const { return frame.cameraValid; }
     
     struct RenderStats {
         int drawCalls;
@@ -75,11 +121,10 @@ public:
     
 private:
     CameraComponent* activeCamera;
-    Scene* currentScene;
     glm::ivec4 viewport;
     glm::vec3 clearColor;
     
-    std::vector<RenderCommand> renderQueue;
+    RenderSnapshot frame;
     RenderStats stats;
     
     bool wireframeEnabled;
@@ -87,23 +132,12 @@ private:
     bool cullFaceEnabled;
     bool frustumCullingEnabled;
     
-    glm::mat4 cachedViewMatrix;
-    glm::mat4 cachedProjectionMatrix;
-    bool matricesCached;
-    
-    struct FrustumPlane {
-        glm::vec3 normal;
-        float distance;
-    };
-    std::vector<FrustumPlane> frustumPlanes;
-    
     void processRenderQueue();
     void setupCamera();
-    void applyMaterial(const Material& material);
-    void updateFrustum();
-    void renderSkybox(Scene& scene);
-    bool isMeshInFrustum(const Mesh& mesh, const glm::mat4& modelMatrix) const;
-    bool isAABBInFrustum(const glm::vec3& min, const glm::vec3& max, const glm::mat4& transform) const;
+    void captureSkybox(Scene& scene);
+    uint32_t captureMaterial(const Material& material);
+    void renderSkybox();
+    void renderText();
 };
 
 } // namespace GameEngine
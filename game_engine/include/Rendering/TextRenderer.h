@@ -0,0 +1,115 @@
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+#include "Platform.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace GameEngine {
+
+class Shader;
+class Texture;
+
+struct TextVertex {
+    glm::vec3 position;
+    glm::vec4 color;
+    glm::vec2 texCoord;
+
+    TextVertex() : position(0.0f), color(1.0f), texCoord(0.0f) {}
+    TextVertex(const glm::vec3& pos, const glm::vec4& col, const glm::vec2& tex)
+        : position(pos), color(col), texCoord(tex) {}
+};
+
+enum class TextSpace {
+    WORLD,      // Transformed by the camera view-projection
+    SCREEN      // Orthographic overlay, drawn without depth test
+};
+
+// Tessellated glyphs of one string in local space, 4 vertices per glyph,
+// grouped into one span per glyph cache page. Owners keep it and rebuild it
+// only when the text, its layout or the glyph cache epoch changes; color and
+// transform are applied when the run is submitted
+struct GlyphRun {
+    struct Span {
+        std::shared_ptr<Texture> page;
+        uint32_t pageId;
+        size_t firstVertex;
+        size_t vertexCount;
+    };
+
+    std::vector<Span> spans;
+    std::vector<TextVertex> vertices;
+    uint32_t cacheEpoch;
+
+    GlyphRun() : cacheEpoch(0) {}
+
+    size_t getGlyphCount() const { return vertices.size() / 4; }
+    bool empty() const { return spans.empty(); }
+    void clear() { spans.clear(); vertices.clear(); }
+};
+
+// Collects all text submitted during a frame and draws it from one streamed
+// vertex buffer, one draw call per (atlas page, space) pair
+class TextRenderer {
+public:
+    static TextRenderer& getInstance();
+
+    void submit(const GlyphRun& run, const glm::mat4& transform, const glm::vec4& color, TextSpace space);
+
+    // Draws and clears everything queued since the last flush. Screen-space text
+    // uses an orthographic projection 2 units high at the given aspect ratio.
+    // Returns the number of draw calls issued
+    int flush(const glm::mat4& viewProjection, float screenAspectRatio);
+    void discard();
+
+    void shutdown();
+
+    struct Stats {
+        int drawCalls;
+        int glyphs;
+        int batches;
+        void reset() { drawCalls = glyphs = batches = 0; }
+    };
+    const Stats& getLastFlushStats() const { return lastFlushStats; }
+
+private:
+    TextRenderer();
+    ~TextRenderer() = default;
+
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    struct Batch {
+        std::shared_ptr<Texture> page;
+        TextSpace space;
+        std::vector<TextVertex> vertices;
+        size_t streamOffset;
+    };
+
+    // Batches are reused across frames so their vertex storage stays allocated
+    std::vector<Batch> batches;
+    size_t activeBatches;
+    std::vector<TextVertex> streamVertices;
+
+    std::shared_ptr<Shader> textShader;
+    GLuint vao;
+    GLuint vbo;
+    GLuint ebo;
+    size_t vboCapacity;     // in vertices
+    size_t quadCapacity;    // quads covered by the shared index buffer
+    bool shaderFailed;
+
+    Stats lastFlushStats;
+
+    Batch& getBatch(const std::shared_ptr<Texture>& page, TextSpace space);
+    bool ensureResources();
+    bool createShader();
+    void ensureQuadIndices(size_t quadCount);
+    int drawBatches(TextSpace space, const glm::mat4& viewProjection);
+};
+
+} // namespace GameEngine
+
+#endif // TEXT_RENDERER_H
@@ -5,9 +5,12 @@
 #include <memory>
 #include <vector>
 #include "Platform.h"
+#include "Rendering/TextureCooker.h"
 
 namespace GameEngine {
 
+struct DecodedImage;
+
 enum class TextureFilter {
     NEAREST,
     LINEAR,
@@ -45,6 +48,15 @@ public:
     bool isCubemap() const { return isCubemapTexture; }
     
     bool loadSTBImage(const std::string& filepath);
+    // Uploads an image decoded ahead of time (see ImageDecoder). GL work
+    // only, so batches decode on worker threads and upload here in order
+    bool loadFromImage(const std::string& filepath, const DecodedImage& image);
+    
+    // Where the source image is actually read from: unchanged on Linux,
+    // flattened into app0:/ on Vita
+    static std::string getSourcePath(const std::string& filepath);
+    // True when loadFromFile would take a cooked .btex instead of decoding
+    static bool hasCookedVersion(const std::string& filepath);
     
     void bind(int textureUnit = 0) const;
     void unbind() const;
@@ -60,6 +72,26 @@ public:
     void setWrap(TextureWrap wrapS, TextureWrap wrapT);
     void generateMipmaps();
     
+    // Cooked textures (.btex, see TextureCooker) keep their mip table and
+    // read levels from the file on demand. Loading uploads only the levels
+    // up to STREAM_INITIAL_SIZE; TextureManager moves the finest resident
+    // level up and down against its memory budget
+    bool loadCooked(const std::string& cookedPath);
+    bool isStreamed() const { return !cookedMips.empty(); }
+    int getMipCount() const { return static_cast<int>(cookedMips.size()); }
+    int getResidentMip() const { return residentMip; }
+    // Coarsest level eviction may drop a streamed texture to
+    int getStreamFloorMip() const;
+    bool setResidentMip(int level);
+    // Bytes resident if `level` were the finest level
+    size_t getMipChainBytes(int level) const;
+    size_t getResidentBytes() const { return residentBytes; }
+    unsigned int getLastUsedFrame() const { return lastUsedFrame; }
+    
+    static const int STREAM_INITIAL_SIZE = 64;
+    static void setCurrentFrame(unsigned int frame) { currentFrame = frame; }
+    static bool isFormatSupported(CookedTextureFormat format);
+    
     static std::shared_ptr<Texture> getWhiteTexture();
     static std::shared_ptr<Texture> getBlackTexture();
     static std::shared_ptr<Texture> getErrorTexture();
@@ -71,6 +103,23 @@ private:
     std::string filepath;
     bool isCubemapTexture;
     
+    // Sampler state, reapplied when a streamed texture is recreated
+    GLenum minFilterMode;
+    GLenum magFilterMode;
+    GLenum wrapSMode;
+    GLenum wrapTMode;
+    
+    std::string cookedPath;
+    std::vector<CookedMipLevel> cookedMips;
+    CookedTextureFormat cookedFormat;
+    int residentMip;
+    size_t residentBytes;
+    mutable unsigned int lastUsedFrame;
+    static unsigned int currentFrame;
+    
+    bool uploadCookedLevels(int firstLevel);
+    void applySamplerState() const;
+    
     GLenum getGLFormat(TextureFormat fmt) const;
     GLenum getGLFilter(TextureFilter filter) const;
     GLenum getGLWrap(TextureWrap wrap) const;
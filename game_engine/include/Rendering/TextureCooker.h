@@ -0,0 +1,92 @@
+#ifndef TEXTURE_COOKER_H
+#define TEXTURE_COOKER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace GameEngine {
+
+// GPU formats a cooked texture can hold. BC1/BC3 are DXT1/DXT5 and work on
+// both desktop GL (EXT_texture_compression_s3tc) and vitaGL; BC5 (RGTC2) is
+// desktop only and used for two-channel normal maps
+enum class CookedTextureFormat : uint32_t {
+    RGBA8 = 0,
+    BC1 = 1,
+    BC3 = 2,
+    BC5 = 3
+};
+
+enum class CookTarget {
+    LINUX,
+    VITA
+};
+
+// .btex layout: header, mipCount CookedMipLevel entries, then the level data
+// finest first, so levels [n, mipCount) are one contiguous read
+struct CookedTextureHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t mipCount;
+    uint32_t format;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+struct CookedMipLevel {
+    uint32_t width;
+    uint32_t height;
+    uint32_t offset;
+    uint32_t size;
+};
+
+// Offline texture processing: mip chain generation, block compression and
+// the .btex container. Pure CPU work, needs no GL context
+class TextureCooker {
+public:
+    static const uint32_t VERSION = 1;
+    static const uint32_t FLAG_NORMAL_MAP = 1;
+    static const uint32_t MAX_MIP_COUNT = 16;   // enough for 32768x32768
+
+    struct Image {
+        int width;
+        int height;
+        std::vector<uint8_t> pixels;    // RGBA8, top row first
+
+        Image() : width(0), height(0) {}
+    };
+
+    // Full chain down to 1x1, level 0 is a copy of base. Normal map levels
+    // are renormalized after filtering
+    static void generateMipChain(const Image& base, bool normalMap, std::vector<Image>& mips);
+
+    // BC5 for normal maps on Linux (BC1 on Vita, the shaders rebuild Z from
+    // RG), BC3 when any pixel is translucent, BC1 otherwise
+    static CookedTextureFormat chooseFormat(const Image& image, bool normalMap, CookTarget target);
+
+    static size_t getLevelSize(CookedTextureFormat format, uint32_t width, uint32_t height);
+    static void compress(const Image& image, CookedTextureFormat format, std::vector<uint8_t>& out);
+    // Back to RGBA8; BC5 gets Z rebuilt into blue. Used when the GPU lacks
+    // the format and by the cooker's quality check
+    static bool decompress(const uint8_t* data, size_t size, CookedTextureFormat format,
+                           uint32_t width, uint32_t height, std::vector<uint8_t>& rgba);
+
+    // Builds a whole .btex file in memory
+    static void cook(const Image& image, CookedTextureFormat format, bool normalMap, std::vector<uint8_t>& file);
+    // Validates the header and mip table of a .btex file prefix
+    static bool parseHeader(const uint8_t* data, size_t size, CookedTextureHeader& header,
+                            std::vector<CookedMipLevel>& mips);
+    static size_t getHeaderSize(uint32_t mipCount);
+
+    // Same path with the extension swapped for .btex
+    static std::string getCookedPath(const std::string& sourcePath);
+    static bool isNormalMapPath(const std::string& path);
+    static const char* getFormatName(CookedTextureFormat format);
+};
+
+} // namespace GameEngine
+
+#endif // TEXTURE_COOKER_H
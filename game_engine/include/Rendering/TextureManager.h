@@ -9,12 +9,26 @@
 
 namespace GameEngine {
 
+struct DecodedImage;
+
 class TextureManager {
 public:
     static TextureManager& getInstance();
     
     std::shared_ptr<Texture> loadTexture(const std::string& filepath);
     std::shared_ptr<Texture> getTexture(const std::string& filepath);
+    // Loads every path not already cached: sources are decoded in parallel
+    // (ImageDecoder) and uploaded one by one on the calling GL thread.
+    // Cooked textures and failed decodes go through loadTexture as usual
+    void preloadTextures(const std::vector<std::string>& filepaths);
+    // The two halves of preloadTextures, for loaders that decode textures
+    // alongside other assets. selectTexturesToDecode loads cooked textures
+    // right away and returns the uncached paths whose Texture::getSourcePath
+    // still needs decoding; addDecodedTexture uploads one and frees its pixels
+    void selectTexturesToDecode(const std::vector<std::string>& filepaths, std::vector<std::string>& pending);
+    void addDecodedTexture(const std::string& filepath, DecodedImage& image);
+    // Decoded images a preload holds at once
+    static size_t getPreloadBatchSize() { return PRELOAD_BATCH_SIZE; }
     
     std::vector<std::string> discoverTextures(const std::string& directory);
     std::vector<std::string> discoverAllTextures(const std::string& rootDirectory);
@@ -34,14 +48,35 @@ public:
     bool hasTexture(const std::string& filepath) const;
     void clearCache();
     
+    // Resident texture memory budget. update() runs once per frame: while
+    // over budget it releases cache entries nothing else holds, then drops
+    // the finest mip of streamed textures, least recently bound first. Any
+    // headroom left streams one finer level into recently bound textures
+    void setMemoryBudget(size_t bytes) { memoryBudget = bytes; }
+    size_t getMemoryBudget() const { return memoryBudget; }
+    size_t getResidentBytes() const;
+    void update();
+    
 private:
-    TextureManager() = default;
+    TextureManager();
     ~TextureManager() = default;
     TextureManager(const TextureManager&) = delete;
     TextureManager& operator=(const TextureManager&) = delete;
     
     std::unordered_map<std::string, std::shared_ptr<Texture>> textureCache;
     std::vector<std::string> discoveredTextures;
+    size_t memoryBudget;
+    unsigned int frame;
+    
+    static const size_t DEFAULT_MEMORY_BUDGET;
+    static const size_t STREAM_BYTES_PER_FRAME;
+    // Textures bound within this many frames count as in use
+    static const unsigned int STREAM_IN_FRAMES = 2;
+    // Decoded images held at once by preloadTextures
+    static const size_t PRELOAD_BATCH_SIZE;
+    
+    size_t evict(size_t residentBytes);
+    void streamIn(size_t residentBytes);
     
     bool discoverTexturesInDirectory(const std::string& directory);
     bool discoverTexturesRecursively(const std::string& rootDirectory);
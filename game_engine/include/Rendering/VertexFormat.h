@@ -0,0 +1,92 @@
+#ifndef VERTEX_FORMAT_H
+#define VERTEX_FORMAT_H
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "Platform.h"
+
+namespace GameEngine {
+
+struct Vertex;
+
+// GPU-side vertex layouts. Meshes keep full-precision Vertex data on the CPU
+// and are packed into one of these when uploaded
+enum class VertexFormat {
+    AUTO,               // STATIC_COMPACT, or SKINNED_COMPACT if any vertex has bone weights
+    FULL,               // Every attribute as float, 76 bytes
+    STATIC_COMPACT,     // float3 position, packed normal/tangent, half2 UV, no bone data
+    SKINNED_COMPACT     // STATIC_COMPACT plus uint8 bone indices and unorm8 weights
+};
+
+// Attribute slots match the locations bound in Shader (position, normal,
+// texCoords, tangent, boneWeights, boneIndices)
+enum VertexAttributeSlot {
+    ATTRIB_POSITION = 0,
+    ATTRIB_NORMAL,
+    ATTRIB_TEXCOORD,
+    ATTRIB_TANGENT,
+    ATTRIB_BONE_WEIGHTS,
+    ATTRIB_BONE_INDICES,
+    ATTRIB_COUNT
+};
+
+struct VertexAttribute {
+    bool enabled;
+    GLint size;
+    GLenum type;
+    GLboolean normalized;
+    uint32_t offset;
+};
+
+// What the current GL context can fetch natively
+struct VertexFormatSupport {
+    bool halfFloat;         // GL_HALF_FLOAT attributes
+    bool packed1010102;     // GL_INT_2_10_10_10_REV attributes
+
+    // Queried once, requires a current context
+    static const VertexFormatSupport& get();
+};
+
+class VertexLayout {
+public:
+    VertexLayout();
+
+    static VertexLayout create(VertexFormat format, const VertexFormatSupport& support);
+
+    // Resolves AUTO for the given vertices; skinned data that cannot be
+    // packed (bone index above 255) falls back to FULL
+    static VertexFormat choose(VertexFormat requested, const std::vector<Vertex>& vertices);
+
+    VertexFormat getFormat() const { return format; }
+    uint32_t getStride() const { return stride; }
+    const VertexAttribute& getAttribute(int slot) const { return attributes[slot]; }
+
+    // Writes vertices in this layout, stride bytes apart
+    void pack(const std::vector<Vertex>& vertices, std::vector<uint8_t>& out) const;
+    // Binds the attribute pointers of the currently bound GL_ARRAY_BUFFER
+    void applyAttributes() const;
+
+private:
+    VertexFormat format;
+    uint32_t stride;
+    VertexAttribute attributes[ATTRIB_COUNT];
+
+    void addAttribute(int slot, GLint size, GLenum type, GLboolean normalized, uint32_t bytes);
+};
+
+// Quantization helpers, exposed for tools and tests
+namespace VertexPacking {
+    uint16_t floatToHalf(float value);
+    float halfToFloat(uint16_t value);
+    // Signed normalized 10-10-10-2 (GL_INT_2_10_10_10_REV); xyz in [-1, 1], w in {-1, 0, 1}
+    uint32_t packSnorm1010102(const glm::vec4& value);
+    glm::vec4 unpackSnorm1010102(uint32_t packed);
+    void packSnorm8x4(const glm::vec4& value, int8_t out[4]);
+    // Unorm8 weights that still sum to exactly 255
+    void packWeights(const glm::vec4& weights, uint8_t out[4]);
+}
+
+} // namespace GameEngine
+
+#endif // VERTEX_FORMAT_H
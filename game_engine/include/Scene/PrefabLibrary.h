@@ -0,0 +1,66 @@
+#ifndef PREFAB_LIBRARY_H
+#define PREFAB_LIBRARY_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Scene/SceneDescription.h"
+#include "Rendering/Mesh.h"
+
+namespace GameEngine {
+
+class SceneNode;
+class Material;
+
+// Prefabs are node subtrees saved once, as scene files whose rootNode is the
+// prefab (assets/prefabs/*.json). A scene node with a "prefab" path is an
+// instance: the prefab's subtree replaces it when the scene is read, and the
+// node's own values are overrides. Its name, transform and any visible or
+// active flag replace the prefab root's; its components merge into the
+// prefab's by type (the k-th of a type into the k-th) and its children into
+// the prefab's children of the same name, recursively. Only the values an
+// override sets replace the prefab's; components and children with no match
+// are added. Template components no override touched are marked FROM_PREFAB,
+// and the data they build (primitive meshes, materials) is shared by every
+// instance, held here weakly so it goes with the last instance
+class PrefabLibrary {
+public:
+    static PrefabLibrary& getInstance();
+
+    // The prefab file, read and expanded once; null if it can't be read
+    const SceneDescription* getPrefab(const std::string& path);
+    // Replaces every instance node of a freshly read description with its
+    // prefab's subtree. Called by SceneJsonReader
+    void expandInstances(SceneDescription& description);
+
+    // A detached instance, from its node JSON as a scene file stores it
+    std::shared_ptr<SceneNode> instantiate(const std::string& instanceJson);
+    // A detached instance with no overrides; the prefab root's name if `name`
+    // is empty
+    std::shared_ptr<SceneNode> instantiatePrefab(const std::string& path, const std::string& name = "");
+
+    // Dropped prefabs are read again on next use (the editor saved them)
+    void reload(const std::string& path);
+    void clear();
+
+    std::shared_ptr<Mesh> getSharedMesh(MeshType type) const;
+    void setSharedMesh(MeshType type, const std::shared_ptr<Mesh>& mesh);
+    std::shared_ptr<Material> getSharedMaterial(const std::string& key) const;
+    void setSharedMaterial(const std::string& key, const std::shared_ptr<Material>& material);
+
+private:
+    PrefabLibrary() {}
+
+    // A null entry is a prefab that failed to load
+    std::unordered_map<std::string, std::unique_ptr<SceneDescription>> prefabs;
+    // Prefabs being read, so one that instances itself fails instead of recursing
+    std::vector<std::string> loading;
+
+    std::unordered_map<int, std::weak_ptr<Mesh>> sharedMeshes;
+    std::unordered_map<std::string, std::weak_ptr<Material>> sharedMaterials;
+};
+
+} // namespace GameEngine
+
+#endif // PREFAB_LIBRARY_H
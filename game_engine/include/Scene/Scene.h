@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <glm/glm.hpp>
 #include "Scene/SceneNode.h"
 
@@ -24,12 +25,18 @@ public:
     void removeNode(std::shared_ptr<SceneNode> node);
     void removeNode(const std::string& name);
     
+    // Name lookups go through a name->handle index, rebuilt lazily whenever the
+    // node hierarchy changes; the first match in search order wins, as before
     std::shared_ptr<SceneNode> findNode(const std::string& name);
+    NodeHandle findNodeHandle(const std::string& name);
     std::vector<std::shared_ptr<SceneNode>> findNodesByTag(const std::string& tag);
     
     void start();
     void update(float deltaTime);
     void render(Renderer& renderer);
+    // The capture half of render(): picks the camera and fills the
+    // renderer's snapshot, leaving the drawing to Renderer::submitScene
+    void capture(Renderer& renderer);
     void destroy();
     
     const std::string& getName() const { return name; }
@@ -60,6 +67,12 @@ private:
     
     size_t nodeCounter;
     
+    std::unordered_map<std::string, NodeHandle> nameIndex;
+    uint32_t nameIndexVersion;
+    
+    void rebuildNameIndex();
+    void indexChildren(SceneNode* node);
+    
     std::string generateUniqueName(const std::string& baseName);
     size_t countNodes(const std::shared_ptr<SceneNode>& node) const;
 };
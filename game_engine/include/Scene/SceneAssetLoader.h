@@ -0,0 +1,57 @@
+#ifndef SCENE_ASSET_LOADER_H
+#define SCENE_ASSET_LOADER_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GameEngine {
+
+class SceneDescription;
+struct AudioClip;
+
+// Where a scene load is, for loading screens. Every asset job and every node
+// counts as one step of `fraction`, which covers the whole load
+struct SceneLoadProgress {
+    enum Phase { LOADING_ASSETS, CREATING_NODES, DONE };
+    Phase phase;
+    size_t completed;               // steps done in this phase
+    size_t total;
+    float fraction;
+};
+
+// Called on the loading thread between steps, so it may draw a frame
+typedef std::function<void(const SceneLoadProgress&)> SceneLoadCallback;
+
+// Loads what a description references before its nodes are built. The
+// unique models, sounds and textures are read and decoded as one job list on
+// Bullet's task scheduler, a batch of TextureManager::getPreloadBatchSize()
+// jobs at a time. GL work stays on the calling thread and in the order the
+// node-by-node load used: each batch's textures upload before the next batch
+// starts, and a prepared model uploads when its first node loads it. Scripts,
+// fonts and skyboxes still load with their nodes (the Lua state and the font
+// atlas are single threaded)
+class SceneAssetLoader {
+public:
+    explicit SceneAssetLoader(const SceneLoadCallback& callback = SceneLoadCallback());
+    ~SceneAssetLoader();
+
+    void load(const SceneDescription& description);
+    void reportNodes(size_t created);
+    void reportDone();
+
+private:
+    SceneLoadCallback callback;
+    size_t jobCount;
+    size_t nodeCount;
+    // Clips sit in the audio cache only while something holds them
+    std::vector<std::shared_ptr<const AudioClip>> clips;
+
+    void report(SceneLoadProgress::Phase phase, size_t completed, size_t total) const;
+};
+
+} // namespace GameEngine
+
+#endif // SCENE_ASSET_LOADER_H
@@ -0,0 +1,303 @@
+#ifndef SCENE_DESCRIPTION_H
+#define SCENE_DESCRIPTION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Scene/SceneAssetLoader.h"
+
+namespace GameEngine {
+
+class Scene;
+class SceneNode;
+class Material;
+
+enum class SceneComponentType : uint16_t {
+    CAMERA = 1,
+    MESH_RENDERER,
+    MODEL_RENDERER,
+    LIGHT,
+    PHYSICS,
+    TEXT,
+    SCRIPT,
+    SOUND,
+    SKYBOX,
+    AREA3D,
+    ANIMATION
+};
+
+// Strings are indices into the description's string table. Each record
+// carries a `fields` mask of the values the source actually set, so a load
+// only calls the setters a JSON load would (anything else keeps the
+// component's default). Enums are stored as the engine's enum values
+struct CameraRecord {
+    enum { FOV = 1 << 0, NEAR_PLANE = 1 << 1, FAR_PLANE = 1 << 2 };
+    float fov;
+    float nearPlane;
+    float farPlane;
+};
+
+struct MeshRendererRecord {
+    enum { MESH = 1 << 0, MATERIAL = 1 << 1, COLOR = 1 << 2, METALLIC = 1 << 3, ROUGHNESS = 1 << 4,
+           REFLECTION_STRENGTH = 1 << 5 };
+    uint32_t meshType;              // MeshType
+    float color[3];
+    float metallic;
+    float roughness;
+    float reflectionStrength;
+    uint32_t diffuseTexture;
+    uint32_t normalTexture;
+    uint32_t armTexture;
+};
+
+struct ModelRendererRecord {
+    enum { CAST_SHADOWS = 1 << 0, RECEIVE_SHADOWS = 1 << 1 };
+    uint32_t modelPath;
+    uint8_t castShadows;
+    uint8_t receiveShadows;
+    uint8_t padding[2];
+};
+
+struct LightRecord {
+    enum { TYPE = 1 << 0, COLOR = 1 << 1, INTENSITY = 1 << 2, RANGE = 1 << 3, SHOW_GIZMO = 1 << 4,
+           DIRECTION = 1 << 5, CUT_OFF = 1 << 6, OUTER_CUT_OFF = 1 << 7 };
+    uint32_t type;                  // LightType
+    float color[3];
+    float intensity;
+    float range;
+    float direction[3];
+    float cutOff;
+    float outerCutOff;
+    uint8_t showGizmo;
+    uint8_t padding[3];
+};
+
+struct PhysicsRecord {
+    enum { SHAPE = 1 << 0, BODY_TYPE = 1 << 1, MASS = 1 << 2, FRICTION = 1 << 3, RESTITUTION = 1 << 4,
+           LINEAR_DAMPING = 1 << 5, ANGULAR_DAMPING = 1 << 6, SHOW_COLLISION_SHAPE = 1 << 7 };
+    uint32_t shape;                 // CollisionShapeType
+    uint32_t bodyType;              // PhysicsBodyType
+    float mass;
+    float friction;
+    float restitution;
+    float linearDamping;
+    float angularDamping;
+    uint8_t showCollisionShape;
+    uint8_t padding[3];
+};
+
+struct TextRecord {
+    enum { FONT_SIZE = 1 << 0, COLOR = 1 << 1, RENDER_MODE = 1 << 2, ALIGNMENT = 1 << 3, SCALE = 1 << 4,
+           LINE_SPACING = 1 << 5 };
+    uint32_t text;
+    uint32_t fontPath;
+    float fontSize;
+    float color[4];
+    uint32_t renderMode;            // TextRenderMode
+    uint32_t alignment;             // TextAlignment
+    float scale;
+    float lineSpacing;
+};
+
+struct ScriptRecord {
+    enum { PAUSE_EXEMPT = 1 << 0 };
+    uint32_t scriptPath;
+    uint8_t pauseExempt;
+    uint8_t padding[3];
+};
+
+struct SoundRecord {
+    enum { VOLUME = 1 << 0, LOOP = 1 << 1, PITCH = 1 << 2, PRIORITY = 1 << 3, SPATIAL = 1 << 4,
+           DISTANCE_RANGE = 1 << 5, ROLLOFF = 1 << 6 };
+    uint32_t soundFile;
+    float volume;
+    float pitch;
+    int32_t priority;
+    float minDistance;
+    float maxDistance;
+    float rolloff;
+    uint8_t loop;
+    uint8_t spatial;
+    uint8_t padding[2];
+};
+
+struct SkyboxRecord {
+    enum { ACTIVE = 1 << 0 };
+    uint32_t faces[6];              // right, left, top, bottom, front, back
+    uint8_t active;
+    uint8_t padding[3];
+};
+
+struct Area3DRecord {
+    enum { SHAPE = 1 << 0, DIMENSIONS = 1 << 1, RADIUS = 1 << 2, HEIGHT = 1 << 3, MONITOR_MODE = 1 << 4,
+           SHOW_DEBUG_SHAPE = 1 << 5 };
+    uint32_t shape;                 // Area3DShape
+    float dimensions[3];
+    float radius;
+    float height;
+    uint32_t group;
+    uint8_t monitorMode;
+    uint8_t showDebugShape;
+    uint8_t padding[2];
+};
+
+struct AnimationRecord {
+    enum { LOOP = 1 << 0, SPEED = 1 << 1, ROOT_MOTION = 1 << 2, AUTO_PLAY = 1 << 3 };
+    uint32_t skeletonName;
+    uint32_t animationClipName;
+    float speed;
+    uint8_t loop;
+    uint8_t enableRootMotion;
+    uint8_t padding[2];
+};
+
+// Fixed size, so the component array is one block in memory and on disk
+struct SceneComponentRecord {
+    // FROM_PREFAB: a prefab's component no instance override touched, so
+    // every instance can share what it builds (see PrefabLibrary)
+    enum { FROM_PREFAB = 1 << 0 };
+    uint16_t type;                  // SceneComponentType
+    uint16_t origin;
+    uint32_t fields;
+    union {
+        CameraRecord camera;
+        MeshRendererRecord meshRenderer;
+        ModelRendererRecord modelRenderer;
+        LightRecord light;
+        PhysicsRecord physics;
+        TextRecord text;
+        ScriptRecord script;
+        SoundRecord sound;
+        SkyboxRecord skybox;
+        Area3DRecord area3D;
+        AnimationRecord animation;
+    };
+};
+
+struct SceneNodeRecord {
+    // HAS_VISIBLE / HAS_ACTIVE: the source wrote the flag, so a prefab
+    // override replaces the prefab's value
+    enum { VISIBLE = 1 << 0, ACTIVE = 1 << 1, HAS_POSITION = 1 << 2, HAS_ROTATION = 1 << 3, HAS_SCALE = 1 << 4,
+           HAS_VISIBLE = 1 << 5, HAS_ACTIVE = 1 << 6 };
+    uint32_t name;
+    int32_t parent;                 // always before the node itself, -1 for the root
+    uint32_t flags;
+    float position[3];
+    float rotation[3];              // euler degrees
+    float scale[3];
+    uint32_t firstComponent;        // a node's components are contiguous
+    uint32_t componentCount;
+    uint32_t prefab;                // path of the prefab this node instances, NO_STRING if none
+};
+
+// .bscene layout (little endian, every section 4-byte aligned): header,
+// stringCount + 1 offsets into the string data, the node array in
+// depth-first order, the component array, then the NUL-terminated string data
+struct BinarySceneHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t nodeCount;
+    uint32_t componentCount;
+    uint32_t stringCount;
+    uint32_t stringBytes;
+    uint32_t name;
+    uint32_t activeCamera;
+    uint32_t activeSkybox;
+    uint32_t reserved;
+};
+
+// .bscene files are cooked on the desktop and read on the Vita with a plain
+// memcpy, so every record's size is pinned here. Changing one means bumping
+// SceneDescription::VERSION (and these sizes) so old files are rejected
+static_assert(sizeof(CameraRecord) == 12, "CameraRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(MeshRendererRecord) == 40, "MeshRendererRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(ModelRendererRecord) == 8, "ModelRendererRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(LightRecord) == 48, "LightRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(PhysicsRecord) == 32, "PhysicsRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(TextRecord) == 44, "TextRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(ScriptRecord) == 8, "ScriptRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(SoundRecord) == 32, "SoundRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(SkyboxRecord) == 28, "SkyboxRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(Area3DRecord) == 32, "Area3DRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(AnimationRecord) == 16, "AnimationRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(SceneComponentRecord) == 56, "SceneComponentRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(SceneNodeRecord) == 60, "SceneNodeRecord layout changed: bump SceneDescription::VERSION");
+static_assert(sizeof(BinarySceneHeader) == 40, "BinarySceneHeader layout changed: bump SceneDescription::VERSION");
+
+// Flat, pointer-free form of a scene file. SceneJsonReader fills one from
+// the JSON and a .bscene loads straight into one; instantiate() turns either
+// into live nodes and components
+class SceneDescription {
+public:
+    static const uint32_t VERSION = 2;
+    static const uint32_t NO_STRING = 0xFFFFFFFFu;
+
+    uint32_t name;
+    uint32_t activeCamera;
+    uint32_t activeSkybox;
+    std::vector<SceneNodeRecord> nodes;
+    std::vector<SceneComponentRecord> components;
+
+    SceneDescription();
+
+    void clear();
+    // Interns the string; equal strings share one entry
+    uint32_t addString(const std::string& value);
+    std::string getString(uint32_t index) const;
+    size_t getStringCount() const { return stringOffsets.empty() ? 0 : stringOffsets.size() - 1; }
+
+    // Appends a node with its transform at identity; components must be added
+    // before the next node
+    SceneNodeRecord& addNode(const std::string& nodeName, int32_t parent);
+    SceneComponentRecord& addComponent(SceneComponentType type);
+    // Unattached records for builders that fill the arrays in another order
+    static SceneNodeRecord createNode(uint32_t nodeName, int32_t parent);
+    static SceneComponentRecord createComponent(SceneComponentType type);
+
+    // Copies of another description's records with their strings interned
+    // here; the node keeps its parent and component range
+    SceneNodeRecord importNode(const SceneDescription& from, const SceneNodeRecord& node);
+    SceneComponentRecord importComponent(const SceneDescription& from, const SceneComponentRecord& record);
+    // Applies an override of the same type: only the values it set (its
+    // `fields` and its strings) replace the record's
+    static void applyOverride(SceneComponentRecord& record, const SceneComponentRecord& override);
+
+    // Material textures in node order, for TextureManager
+    void collectTexturePaths(std::vector<std::string>& paths) const;
+
+    // Builds the scene, starting the components a JSON load starts. The
+    // active camera and skybox are resolved by name like the JSON loader does.
+    // Assets load first through SceneAssetLoader, which reports progress
+    std::shared_ptr<Scene> instantiate(const SceneLoadCallback& progress = SceneLoadCallback()) const;
+    // The root node and its subtree, unattached (prefab instances)
+    std::shared_ptr<SceneNode> instantiateNode() const;
+
+    // Same nodes and components, with strings compared by text rather than
+    // by index (two builders may intern them in different orders)
+    bool matches(const SceneDescription& other) const;
+
+    void writeBinary(std::vector<uint8_t>& file) const;
+    // Validates every index before accepting the file
+    bool readBinary(const uint8_t* data, size_t size);
+
+    static bool isBinary(const uint8_t* data, size_t size);
+    // Same path with the extension swapped for .bscene
+    static std::string getBinaryPath(const std::string& sourcePath);
+
+private:
+    std::vector<uint32_t> stringOffsets;
+    std::vector<char> stringData;
+    std::unordered_map<std::string, uint32_t> stringLookup;
+
+    // Builds every node, `root` standing in for node 0
+    void createNodes(const std::shared_ptr<SceneNode>& root, SceneAssetLoader& assets,
+                     std::vector<std::shared_ptr<SceneNode>>& created) const;
+    std::shared_ptr<Material> createMaterial(const MeshRendererRecord& data, uint32_t fields) const;
+};
+
+} // namespace GameEngine
+
+#endif // SCENE_DESCRIPTION_H
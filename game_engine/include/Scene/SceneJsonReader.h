@@ -0,0 +1,26 @@
+#ifndef SCENE_JSON_READER_H
+#define SCENE_JSON_READER_H
+
+#include <string>
+#include "Scene/SceneDescription.h"
+#include "../../vendor/json/single_include/nlohmann/json.hpp"
+
+namespace GameEngine {
+
+// Turns the scene JSON the editor writes into a SceneDescription. Both entry
+// points share one field mapping, so they always describe the same scene.
+// Prefab instances are expanded before either returns (see PrefabLibrary)
+class SceneJsonReader {
+public:
+    // Streams the text through nlohmann's SAX interface and fills the
+    // description as tokens arrive. No DOM is built: besides the description,
+    // only the fields of the nodes and component currently open are held
+    static bool read(const std::string& jsonData, SceneDescription& description);
+
+    // From a DOM that already exists (the editor exporting a live scene)
+    static bool readDom(const nlohmann::json& sceneJson, SceneDescription& description);
+};
+
+} // namespace GameEngine
+
+#endif // SCENE_JSON_READER_H
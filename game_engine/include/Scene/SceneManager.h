@@ -5,6 +5,7 @@
 #include <string>
 #include <unordered_map>
 #include "Scene/Scene.h"
+#include "Scene/SceneAssetLoader.h"
 
 namespace GameEngine {
 
@@ -24,14 +25,18 @@ public:
     
     void update(float deltaTime);
     void render();
+    void capture();
     
     std::vector<std::string> getSceneNames() const;
     
     bool saveScene(const std::string& name, const std::string& filepath);
     bool loadSceneFromFile(const std::string& name, const std::string& filepath);
+    // Receives the progress of every loadSceneFromFile, e.g. for a loading screen
+    void setLoadProgressCallback(const SceneLoadCallback& callback) { loadProgressCallback = callback; }
     
 private:
     std::shared_ptr<Scene> currentScene;
+    SceneLoadCallback loadProgressCallback;
     std::unordered_map<std::string, std::shared_ptr<Scene>> scenes;
 };
 
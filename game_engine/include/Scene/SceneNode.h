@@ -7,6 +7,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
+#include <cstdint>
 #include "Core/Transform.h"
 #include "Rendering/LightingManager.h"
 
@@ -15,7 +16,18 @@ namespace GameEngine {
 class Component;
 class Renderer;
 
-class SceneNode {
+// Generational reference to a SceneNode. Resolves in O(1) and goes stale (rather
+// than dangling) once the node is destroyed and its slot reused
+struct NodeHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0; // 0 = null handle
+    
+    bool isNull() const { return generation == 0; }
+    bool operator==(const NodeHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const NodeHandle& other) const { return !(*this == other); }
+};
+
+class SceneNode : public std::enable_shared_from_this<SceneNode> {
 public:
     SceneNode(const std::string& name = "Node");
     virtual ~SceneNode();
@@ -39,7 +51,14 @@ public:
     glm::mat4 getLocalMatrix() const { return transform.getMatrix(); }
     
     const std::string& getName() const { return name; }
-    void setName(const std::string& newName) { name = newName; }
+    void setName(const std::string& newName) { name = newName; markHierarchyChanged(); }
+    
+    NodeHandle getHandle() const { return handle; }
+    // Returns nullptr for null or stale handles
+    static SceneNode* resolve(NodeHandle handle);
+    // Kept on the root: bumped on any rename, attach, detach or reorder in its
+    // tree, so a scene's name index only rebuilds for changes to that scene
+    uint32_t getHierarchyVersion() const { return hierarchyVersion; }
     
     bool isVisible() const { return visible; }
     void setVisible(bool state) { visible = state; }
@@ -75,6 +94,12 @@ public:
     bool hasTag(const std::string& tag) const;
     const std::vector<std::string>& getTags() const { return tags; }
     
+    // Set on the root of a prefab instance; saving writes only what differs
+    // from the prefab
+    const std::string& getPrefabPath() const { return prefabPath; }
+    void setPrefabPath(const std::string& path) { prefabPath = path; }
+    bool isPrefabInstance() const { return !prefabPath.empty(); }
+    
 protected:
     std::string name;
     Transform transform;
@@ -82,6 +107,9 @@ protected:
     std::vector<std::shared_ptr<SceneNode>> children;
     std::vector<std::unique_ptr<Component>> components;
     std::vector<std::string> tags;
+    std::string prefabPath;
+    NodeHandle handle;
+    uint32_t hierarchyVersion;
     
     bool visible;
     bool active;
@@ -89,6 +117,7 @@ protected:
     
     void updateChildren(float deltaTime);
     void renderChildren(Renderer& renderer);
+    void markHierarchyChanged();
 };
 
 template<typename T, typename... Args>
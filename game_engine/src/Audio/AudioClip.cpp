@@ -0,0 +1,45 @@
+#include "Audio/AudioClip.h"
+#include "Audio/AudioDecoder.h"
+#include <iostream>
+
+namespace GameEngine {
+
+std::shared_ptr<AudioClip> AudioClip::load(const std::string& filePath) {
+    std::unique_ptr<AudioDecoder> decoder = AudioDecoder::open(filePath);
+    if (!decoder) {
+        return nullptr;
+    }
+    return decode(*decoder);
+}
+
+std::shared_ptr<AudioClip> AudioClip::decode(AudioDecoder& decoder) {
+    std::shared_ptr<AudioClip> clip = std::make_shared<AudioClip>();
+    clip->path = decoder.getPath();
+    clip->channels = decoder.getChannels();
+    clip->sampleRate = decoder.getSampleRate();
+
+    // The header's length is a hint; keep reading until the decoder runs dry
+    const size_t chunkFrames = 4096;
+    size_t frames = 0;
+    clip->samples.resize(static_cast<size_t>(decoder.getFrameCount() + chunkFrames) * clip->channels);
+    for (;;) {
+        if ((frames + chunkFrames) * clip->channels > clip->samples.size()) {
+            clip->samples.resize(clip->samples.size() * 2);
+        }
+        size_t got = decoder.read(clip->samples.data() + frames * clip->channels, chunkFrames);
+        if (got == 0) {
+            break;
+        }
+        frames += got;
+    }
+    clip->samples.resize(frames * clip->channels);
+    clip->samples.shrink_to_fit();
+
+    if (frames == 0) {
+        std::cerr << "AudioClip: No audio data in " << clip->path << std::endl;
+        return nullptr;
+    }
+    return clip;
+}
+
+} // namespace GameEngine
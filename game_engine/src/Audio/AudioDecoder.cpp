@@ -0,0 +1,241 @@
+#include "Audio/AudioDecoder.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#define STB_VORBIS_NO_PUSHDATA_API
+#include "../../vendor/stb/stb_vorbis.c"
+
+namespace GameEngine {
+
+namespace {
+
+class WavDecoder : public AudioDecoder {
+public:
+    WavDecoder() : bytesPerSample(2), framesRead(0) {}
+
+    bool open(const std::string& filePath, const std::string& resolvedPath) {
+        path = filePath;
+        file.open(resolvedPath, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "AudioDecoder: Failed to open file: " << resolvedPath << std::endl;
+            return false;
+        }
+
+        char riff[4];
+        uint32_t chunkSize;
+        char wave[4];
+        file.read(riff, 4);
+        file.read(reinterpret_cast<char*>(&chunkSize), 4);
+        file.read(wave, 4);
+
+        if (!file || strncmp(riff, "RIFF", 4) != 0 || strncmp(wave, "WAVE", 4) != 0) {
+            std::cerr << "AudioDecoder: Invalid WAV file (not RIFF WAVE): " << resolvedPath << std::endl;
+            return false;
+        }
+
+        char chunkId[4];
+        uint32_t chunkSizeVal;
+        uint16_t audioFormat = 0;
+        uint16_t numChannels = 0;
+        uint32_t rate = 0;
+        uint32_t byteRate = 0;
+        uint16_t blockAlign = 0;
+        uint16_t bitsPerSample = 0;
+        bool foundFmt = false;
+
+        while (file.read(chunkId, 4)) {
+            file.read(reinterpret_cast<char*>(&chunkSizeVal), 4);
+
+            if (strncmp(chunkId, "fmt ", 4) == 0) {
+                file.read(reinterpret_cast<char*>(&audioFormat), 2);
+                file.read(reinterpret_cast<char*>(&numChannels), 2);
+                file.read(reinterpret_cast<char*>(&rate), 4);
+                file.read(reinterpret_cast<char*>(&byteRate), 4);
+                file.read(reinterpret_cast<char*>(&blockAlign), 2);
+                file.read(reinterpret_cast<char*>(&bitsPerSample), 2);
+
+                // Skip any extra fmt data
+                if (chunkSizeVal > 16) {
+                    file.seekg(chunkSizeVal - 16, std::ios::cur);
+                }
+                foundFmt = true;
+            } else if (strncmp(chunkId, "data", 4) == 0) {
+                if (!foundFmt) {
+                    std::cerr << "AudioDecoder: Found data chunk before fmt chunk: " << resolvedPath << std::endl;
+                    return false;
+                }
+                if (audioFormat != 1) {
+                    std::cerr << "AudioDecoder: Only PCM format supported (format: " << audioFormat << ")" << std::endl;
+                    return false;
+                }
+                if (numChannels != 1 && numChannels != 2) {
+                    std::cerr << "AudioDecoder: Unsupported channel count: " << numChannels << std::endl;
+                    return false;
+                }
+                if (bitsPerSample != 8 && bitsPerSample != 16) {
+                    std::cerr << "AudioDecoder: Unsupported bit depth: " << bitsPerSample << std::endl;
+                    return false;
+                }
+
+                channels = numChannels;
+                sampleRate = static_cast<int>(rate);
+                bytesPerSample = bitsPerSample / 8;
+                dataStart = file.tellg();
+                frameCount = chunkSizeVal / (bytesPerSample * channels);
+                framesRead = 0;
+
+                if (frameCount == 0 || sampleRate <= 0) {
+                    std::cerr << "AudioDecoder: WAV file has no audio data: " << resolvedPath << std::endl;
+                    return false;
+                }
+                return true;
+            } else {
+                file.seekg(chunkSizeVal, std::ios::cur);
+            }
+
+            if (chunkSizeVal % 2 != 0) {
+                file.seekg(1, std::ios::cur);
+            }
+        }
+
+        std::cerr << "AudioDecoder: Could not find data chunk in WAV file: " << resolvedPath << std::endl;
+        return false;
+    }
+
+    size_t read(int16_t* output, size_t frames) override {
+        size_t wanted = static_cast<size_t>(std::min<uint64_t>(frames, frameCount - framesRead));
+        if (wanted == 0) {
+            return 0;
+        }
+
+        size_t samples = wanted * channels;
+        size_t got = 0;
+        if (bytesPerSample == 2) {
+            file.read(reinterpret_cast<char*>(output), samples * sizeof(int16_t));
+            got = static_cast<size_t>(file.gcount()) / (sizeof(int16_t) * channels);
+        } else {
+            // 8-bit WAV is unsigned, centered on 128
+            scratch.resize(samples);
+            file.read(reinterpret_cast<char*>(scratch.data()), samples);
+            got = static_cast<size_t>(file.gcount()) / channels;
+            for (size_t i = 0; i < got * channels; ++i) {
+                output[i] = static_cast<int16_t>((scratch[i] - 128) << 8);
+            }
+        }
+
+        if (got < wanted) {
+            // Truncated file: treat what is there as the whole sound
+            frameCount = framesRead + got;
+        }
+        framesRead += got;
+        return got;
+    }
+
+    bool rewind() override {
+        file.clear();
+        file.seekg(dataStart);
+        framesRead = 0;
+        return static_cast<bool>(file);
+    }
+
+private:
+    std::ifstream file;
+    std::streampos dataStart;
+    int bytesPerSample;
+    uint64_t framesRead;
+    std::vector<uint8_t> scratch;
+};
+
+class VorbisDecoder : public AudioDecoder {
+public:
+    VorbisDecoder() : vorbis(nullptr) {}
+    ~VorbisDecoder() {
+        if (vorbis) {
+            stb_vorbis_close(vorbis);
+        }
+    }
+
+    bool open(const std::string& filePath, const std::string& resolvedPath) {
+        path = filePath;
+        int error = 0;
+        vorbis = stb_vorbis_open_filename(resolvedPath.c_str(), &error, nullptr);
+        if (!vorbis) {
+            std::cerr << "AudioDecoder: Failed to open Ogg Vorbis file (error " << error << "): " << resolvedPath << std::endl;
+            return false;
+        }
+
+        stb_vorbis_info info = stb_vorbis_get_info(vorbis);
+        if (info.channels < 1 || info.channels > 2) {
+            std::cerr << "AudioDecoder: Unsupported channel count: " << info.channels << std::endl;
+            return false;
+        }
+        channels = info.channels;
+        sampleRate = static_cast<int>(info.sample_rate);
+        frameCount = stb_vorbis_stream_length_in_samples(vorbis);
+        return sampleRate > 0;
+    }
+
+    size_t read(int16_t* output, size_t frames) override {
+        size_t total = 0;
+        while (total < frames) {
+            int got = stb_vorbis_get_samples_short_interleaved(vorbis, channels, output + total * channels,
+                                                               static_cast<int>((frames - total) * channels));
+            if (got <= 0) {
+                break;
+            }
+            total += got;
+        }
+        return total;
+    }
+
+    bool rewind() override {
+        return stb_vorbis_seek_start(vorbis) != 0;
+    }
+
+private:
+    stb_vorbis* vorbis;
+};
+
+} // namespace
+
+std::string AudioDecoder::resolvePath(const std::string& filePath) {
+#ifdef VITA_BUILD
+    if (filePath.find("assets/") == 0) {
+        return "app0:/" + filePath;
+    }
+#endif
+    return filePath;
+}
+
+std::unique_ptr<AudioDecoder> AudioDecoder::open(const std::string& filePath) {
+    std::string resolvedPath = resolvePath(filePath);
+
+    char magic[4] = {0, 0, 0, 0};
+    {
+        std::ifstream probe(resolvedPath, std::ios::binary);
+        if (!probe.is_open()) {
+            std::cerr << "AudioDecoder: Failed to open file: " << resolvedPath << std::endl;
+            return nullptr;
+        }
+        probe.read(magic, 4);
+    }
+
+    if (strncmp(magic, "OggS", 4) == 0) {
+        std::unique_ptr<VorbisDecoder> decoder(new VorbisDecoder());
+        if (!decoder->open(filePath, resolvedPath)) {
+            return nullptr;
+        }
+        return std::unique_ptr<AudioDecoder>(decoder.release());
+    }
+
+    std::unique_ptr<WavDecoder> decoder(new WavDecoder());
+    if (!decoder->open(filePath, resolvedPath)) {
+        return nullptr;
+    }
+    return std::unique_ptr<AudioDecoder>(decoder.release());
+}
+
+} // namespace GameEngine
@@ -1,12 +1,20 @@
 #include "Audio/AudioManager.h"
-#include "Components/SoundComponent.h"
+#include "Audio/AudioDecoder.h"
+#include "Components/CameraComponent.h"
 #include "Core/ThreadManager.h"
+#include "Core/Profiler.h"
+#include "Core/Stats.h"
 #include <iostream>
-#include <cstring>
-#include <algorithm>
+#include <cstdlib>
 
 namespace GameEngine {
 
+const int AudioManager::MAX_VOICES;
+const int AudioManager::MAX_MIXED_VOICES;
+const int AudioManager::OUTPUT_SAMPLE_RATE;
+const int AudioManager::PERIOD_FRAMES;
+const size_t AudioManager::STREAMING_THRESHOLD_BYTES;
+
 AudioManager& AudioManager::getInstance() {
     static AudioManager instance;
     return instance;
@@ -19,10 +27,8 @@ AudioManager::AudioManager()
     , audioThreadRunning(false)
     , masterVolume(1.0f)
     , paused(false)
-#ifdef LINUX_BUILD
-    , alDevice(nullptr)
-    , alContext(nullptr)
-#endif
+    , listener()
+    , listenerPlaced(false)
 {
 }
 
@@ -74,6 +80,8 @@ void AudioManager::enableThreading(bool enable) {
     threadingEnabled = enable;
     
     if (enable && !audioThreadRunning.load()) {
+        // Set before the thread starts so an early shutdown() still joins it
+        audioThreadRunning.store(true);
         audioThread = ThreadManager::getInstance().createThread(
             "AudioThread",
             [this]() { this->audioThreadFunction(); }
@@ -82,6 +90,7 @@ void AudioManager::enableThreading(bool enable) {
         if (!ThreadManager::getInstance().isValid(audioThread)) {
             std::cerr << "AudioManager: Failed to create audio thread!" << std::endl;
             threadingEnabled = false;
+            audioThreadRunning.store(false);
         }
     } else if (!enable && audioThreadRunning.load()) {
         AudioCommand shutdownCmd;
@@ -123,6 +132,7 @@ void AudioManager::stopSound(const std::string& path) {
 void AudioManager::setVolume(float volume) {
     if (!threadingEnabled) {
         masterVolume = volume;
+        if (mixer) mixer->setMasterVolume(volume);
         return;
     }
     
@@ -136,6 +146,7 @@ void AudioManager::setVolume(float volume) {
 void AudioManager::pause() {
     if (!threadingEnabled) {
         paused = true;
+        if (mixer) mixer->setPaused(true);
         return;
     }
     
@@ -148,6 +159,7 @@ void AudioManager::pause() {
 void AudioManager::resume() {
     if (!threadingEnabled) {
         paused = false;
+        if (mixer) mixer->setPaused(false);
         return;
     }
     
@@ -158,52 +170,26 @@ void AudioManager::resume() {
 }
 
 void AudioManager::audioThreadFunction() {
-    audioThreadRunning.store(true);
-    
-    int loopCounter = 0;
-    
     while (audioThreadRunning.load()) {
-#ifdef VITA_BUILD
-        // Copy component pointers while holding lock, then release lock before calling methods
-        // This prevents accessing deleted components and reduces lock
-        std::unique_lock<std::mutex> lock(soundComponentsMutex, std::try_to_lock);
-        if (lock.owns_lock()) {
-            std::vector<SoundComponent*> componentsToStream = activeSoundComponents;
-            lock.unlock();
-            
-            for (SoundComponent* component : componentsToStream) {
-                if (!component) continue;
-                
-                if (component->isPlaying()) {
-                    // Call streamAudio() multiple times per iteration to keep hardware buffer filled
-                    // sceAudioOutOutput() is blocking and naturally throttles when hardware isn't ready
-                    for (int i = 0; i < 5; i++) {
-                        if (!component->isPlaying()) {
-                            break;
-                        }
-                        component->streamAudio();
-                    }
-                }
-            }
-        }
-        
-        // Process commands less frequently to prioritize audio streaming
-        if (loopCounter % 10 == 0) {
-            AudioCommand cmd;
-            if (commandQueue.tryPop(cmd)) {
-                processAudioCommand(cmd);
-            }
-        }
-        loopCounter++;
-#else
         AudioCommand cmd;
-        if (commandQueue.tryPop(cmd)) {
+        while (audioThreadRunning.load() && commandQueue.tryPop(cmd)) {
             processAudioCommand(cmd);
         }
-        loopCounter++;
-#endif
+        if (!audioThreadRunning.load()) {
+            break;
+        }
         
-        ThreadManager::getInstance().sleep(0);
+        // One period per iteration; write() blocks until the device wants more
+        {
+            PROFILE_ZONE("AudioMixer::mix");
+            mixer->updateStreams();
+            mixer->mix(periodBuffer.data(), PERIOD_FRAMES);
+        }
+        static Stat& activeVoices = Stats::getInstance().getGauge("Active voices");
+        activeVoices.set(mixer->getActiveVoiceCount());
+        if (!output->write(periodBuffer.data())) {
+            ThreadManager::getInstance().sleep(PERIOD_FRAMES * 1000 / OUTPUT_SAMPLE_RATE);
+        }
     }
 }
 
@@ -217,14 +203,17 @@ void AudioManager::processAudioCommand(const AudioCommand& cmd) {
             
         case AudioCommandType::SET_VOLUME:
             masterVolume = cmd.volume;
+            mixer->setMasterVolume(masterVolume);
             break;
             
         case AudioCommandType::PAUSE:
             paused = true;
+            mixer->setPaused(true);
             break;
             
         case AudioCommandType::RESUME:
             paused = false;
+            mixer->setPaused(false);
             break;
             
         case AudioCommandType::SHUTDOWN:
@@ -233,113 +222,205 @@ void AudioManager::processAudioCommand(const AudioCommand& cmd) {
     }
 }
 
-bool AudioManager::initializeAudioSystem() {
-#ifdef LINUX_BUILD
-    const ALCchar* deviceList = nullptr;
-    if (alcIsExtensionPresent(nullptr, "ALC_ENUMERATE_ALL_EXT")) {
-        deviceList = alcGetString(nullptr, ALC_ALL_DEVICES_SPECIFIER);
-    } else {
-        deviceList = alcGetString(nullptr, ALC_DEVICE_SPECIFIER);
+std::shared_ptr<const AudioClip> AudioManager::findCachedClip(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(clipCacheMutex);
+    auto it = clipCache.find(path);
+    return it != clipCache.end() ? it->second.lock() : nullptr;
+}
+
+std::shared_ptr<const AudioClip> AudioManager::cacheClip(const std::shared_ptr<const AudioClip>& clip) {
+    std::lock_guard<std::mutex> lock(clipCacheMutex);
+    // Another thread may have decoded the same file meanwhile; keep the first
+    std::weak_ptr<const AudioClip>& entry = clipCache[clip->path];
+    std::shared_ptr<const AudioClip> existing = entry.lock();
+    if (existing) {
+        return existing;
     }
+    entry = clip;
     
-    alDevice = alcOpenDevice(nullptr);
-    
-    if (!alDevice && deviceList && deviceList[0] != '\0') {
-        const ALCchar* device = deviceList;
-        while (*device != '\0' && !alDevice) {
-            alDevice = alcOpenDevice(device);
-            if (alDevice) {
-                break;
-            }
-            device += strlen(device) + 1;
+    for (auto it = clipCache.begin(); it != clipCache.end();) {
+        if (it->second.expired()) {
+            it = clipCache.erase(it);
+        } else {
+            ++it;
         }
     }
-    
-    if (!alDevice) {
-        const char* alsaDevices[] = {
-            "alsa",
-            "ALSA",
-            "sysdefault",
-            "plughw:0,0",
-            "hw:0,0"
-        };
-        
-        for (const char* deviceName : alsaDevices) {
-            alDevice = alcOpenDevice(deviceName);
-            if (alDevice) {
-                break;
-            }
-        }
+    return clip;
+}
+
+bool AudioManager::loadSound(const std::string& path, std::shared_ptr<const AudioClip>& clip, std::shared_ptr<AudioStream>& stream) {
+    clip = findCachedClip(path);
+    stream.reset();
+    if (clip) {
+        return true;
     }
     
-    if (!alDevice) {
-        std::cerr << "AudioManager: Failed to open OpenAL device (audio will be disabled)" << std::endl;
-        std::cerr << "AudioManager: This may indicate that OpenAL Soft was not built with ALSA/PulseAudio support" << std::endl;
-        std::cerr << "AudioManager: Try installing PulseAudio: sudo apt install pulseaudio" << std::endl;
+    std::unique_ptr<AudioDecoder> decoder = AudioDecoder::open(path);
+    if (!decoder) {
         return false;
     }
     
-    alContext = alcCreateContext(alDevice, nullptr);
-    if (!alContext || alcMakeContextCurrent(alContext) == ALC_FALSE) {
-        std::cerr << "AudioManager: Failed to create OpenAL context (audio will be disabled)" << std::endl;
-        if (alContext) {
-            alcDestroyContext(alContext);
-            alContext = nullptr;
-        }
-        alcCloseDevice(alDevice);
-        alDevice = nullptr;
-        return false;
+    uint64_t decodedBytes = decoder->getFrameCount() * decoder->getChannels() * sizeof(int16_t);
+    if (decodedBytes > STREAMING_THRESHOLD_BYTES) {
+        stream = std::make_shared<AudioStream>(std::move(decoder));
+        // Prefill here so the first period has data; the audio thread keeps it topped up
+        stream->fill();
+        return true;
     }
     
+    std::shared_ptr<AudioClip> decoded = AudioClip::decode(*decoder);
+    if (!decoded) {
+        return false;
+    }
+    clip = cacheClip(decoded);
     return true;
+}
+
+std::shared_ptr<const AudioClip> AudioManager::getClip(const std::string& path) {
+    std::shared_ptr<const AudioClip> clip = findCachedClip(path);
+    if (clip) {
+        return clip;
+    }
     
-#elif defined(VITA_BUILD)
-    return true;
-#else
-    return false;
-#endif
+    std::shared_ptr<AudioClip> decoded = AudioClip::load(path);
+    return decoded ? cacheClip(decoded) : nullptr;
 }
 
-void AudioManager::shutdownAudioSystem() {
-#ifdef LINUX_BUILD
-    if (alContext) {
-        alcMakeContextCurrent(nullptr);
-        alcDestroyContext(alContext);
-        alContext = nullptr;
+std::shared_ptr<const AudioClip> AudioManager::preloadClip(const std::string& path) {
+    std::shared_ptr<const AudioClip> clip = findCachedClip(path);
+    if (clip) {
+        return clip;
     }
-    if (alDevice) {
-        alcCloseDevice(alDevice);
-        alDevice = nullptr;
+    
+    std::unique_ptr<AudioDecoder> decoder = AudioDecoder::open(path);
+    if (!decoder) {
+        return nullptr;
     }
-#elif defined(VITA_BUILD)
-    std::lock_guard<std::mutex> lock(soundComponentsMutex);
-    activeSoundComponents.clear();
-#endif
+    
+    uint64_t decodedBytes = decoder->getFrameCount() * decoder->getChannels() * sizeof(int16_t);
+    if (decodedBytes > STREAMING_THRESHOLD_BYTES) {
+        return nullptr;
+    }
+    
+    std::shared_ptr<AudioClip> decoded = AudioClip::decode(*decoder);
+    return decoded ? cacheClip(decoded) : nullptr;
 }
 
-#ifdef VITA_BUILD
-void AudioManager::registerSoundComponent(SoundComponent* component) {
-    if (!component) return;
-    
-    std::lock_guard<std::mutex> lock(soundComponentsMutex);
-    for (SoundComponent* existing : activeSoundComponents) {
-        if (existing == component) {
-            return;
-        }
+bool AudioManager::hasClip(const std::string& path) const {
+    return findCachedClip(path) != nullptr;
+}
+
+size_t AudioManager::getCachedClipCount() const {
+    std::lock_guard<std::mutex> lock(clipCacheMutex);
+    size_t count = 0;
+    for (const auto& entry : clipCache) {
+        if (!entry.second.expired()) count++;
     }
-    activeSoundComponents.push_back(component);
+    return count;
+}
+
+size_t AudioManager::getCachedClipBytes() const {
+    std::lock_guard<std::mutex> lock(clipCacheMutex);
+    size_t bytes = 0;
+    for (const auto& entry : clipCache) {
+        std::shared_ptr<const AudioClip> clip = entry.second.lock();
+        if (clip) bytes += clip->getByteSize();
+    }
+    return bytes;
+}
+
+void AudioManager::clearCache() {
+    // Components keep their clips; only the sharing between later loads is lost
+    std::lock_guard<std::mutex> lock(clipCacheMutex);
+    clipCache.clear();
+}
+
+void AudioManager::submitEmitter(VoiceId voice, const glm::vec3& position, const glm::vec3& velocity) {
+    VoiceEmitter emitter;
+    emitter.voice = voice;
+    emitter.position = position;
+    emitter.velocity = velocity;
+    pendingEmitters.push_back(emitter);
 }
 
-void AudioManager::unregisterSoundComponent(SoundComponent* component) {
-    if (!component) return;
+void AudioManager::updateSpatial(float deltaTime, const CameraSnapshot* camera) {
+    if (camera) {
+        glm::vec3 up = glm::vec3(camera->inverseView[1]);
+        listener.velocity = listenerPlaced ? estimateVelocity(listener.position, camera->position, deltaTime)
+                                           : glm::vec3(0.0f);
+        listener.position = camera->position;
+        listener.forward = camera->forward;
+        listener.up = glm::length(up) > 1e-6f ? glm::normalize(up) : glm::vec3(0.0f, 1.0f, 0.0f);
+        listenerPlaced = true;
+    }
     
-    std::lock_guard<std::mutex> lock(soundComponentsMutex);
-    activeSoundComponents.erase(
-        std::remove(activeSoundComponents.begin(), activeSoundComponents.end(), component),
-        activeSoundComponents.end()
-    );
+    if (mixer) {
+        mixer->updateSpatial(listener, pendingEmitters.data(), pendingEmitters.size());
+    }
+    pendingEmitters.clear();
+}
+
+glm::vec3 AudioManager::estimateVelocity(const glm::vec3& from, const glm::vec3& to, float deltaTime) {
+    if (deltaTime <= 0.0f) {
+        return glm::vec3(0.0f);
+    }
+    glm::vec3 velocity = (to - from) / deltaTime;
+    // Faster than sound is a respawn or a camera cut, not motion to pitch shift
+    return glm::length(velocity) < 340.0f ? velocity : glm::vec3(0.0f);
 }
+
+bool AudioManager::initializeAudioSystem() {
+    AudioBackend backend = AudioBackend::DEVICE;
+#ifdef LINUX_BUILD
+    const char* backendName = getenv("GAME_ENGINE_AUDIO_BACKEND");
+    if (backendName && *backendName && !AudioOutput::parseBackend(backendName, backend)) {
+        std::cerr << "AudioManager: Unknown GAME_ENGINE_AUDIO_BACKEND '" << backendName << "' (device or null)" << std::endl;
+    }
+#endif
+    
+    if (backend == AudioBackend::DEVICE) {
+#ifdef LINUX_BUILD
+        output.reset(new OpenALAudioOutput());
+#elif defined(VITA_BUILD)
+        output.reset(new VitaAudioOutput());
 #endif
+        if (output && !output->open(OUTPUT_SAMPLE_RATE, PERIOD_FRAMES)) {
+            output.reset();
+#ifdef LINUX_BUILD
+            // Keep mixing without a sound card so playback state still advances
+            std::cerr << "AudioManager: No audio device, falling back to the null output (silent)" << std::endl;
+            backend = AudioBackend::NULL_DEVICE;
+#endif
+        }
+    }
+    
+    if (backend == AudioBackend::NULL_DEVICE) {
+        output.reset(new NullAudioOutput(true));
+        output->open(OUTPUT_SAMPLE_RATE, PERIOD_FRAMES);
+    }
+    
+    if (!output) {
+        return false;
+    }
+    
+    mixer.reset(new AudioMixer(MAX_VOICES, OUTPUT_SAMPLE_RATE, MAX_MIXED_VOICES));
+    mixer->setMasterVolume(masterVolume);
+    mixer->setPaused(paused);
+    periodBuffer.assign(PERIOD_FRAMES * AudioMixer::OUTPUT_CHANNELS, 0);
+    
+    std::cout << "AudioManager: Mixing up to " << MAX_MIXED_VOICES << " of " << MAX_VOICES << " voices at " << OUTPUT_SAMPLE_RATE
+              << " Hz into the " << output->getName() << " output" << std::endl;
+    return true;
+}
 
-} // namespace GameEngine
+void AudioManager::shutdownAudioSystem() {
+    if (mixer) {
+        mixer->stopAll();
+    }
+    if (output) {
+        output->close();
+        output.reset();
+    }
+}
 
+} // namespace GameEngine
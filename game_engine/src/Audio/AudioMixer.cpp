@@ -0,0 +1,756 @@
+#include "Audio/AudioMixer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+    #define AUDIO_MIXER_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define AUDIO_MIXER_NEON 1
+#endif
+
+namespace GameEngine {
+
+namespace {
+
+const uint64_t FIXED_ONE = 1ULL << 32;
+const float FIXED_TO_FLOAT = 1.0f / 4294967296.0f;
+
+// Interleaved stereo read straight from the clip into the mix, each
+// channel with its own gain
+void accumulateSamples(const int16_t* src, float gainLeft, float gainRight, float* dst, int count) {
+    int i = 0;
+#if defined(AUDIO_MIXER_SSE2)
+    __m128 gainVector = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+    for (; i + 8 <= count; i += 8) {
+        __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+        __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+        __m128 a = _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_cvtepi32_ps(low), gainVector));
+        __m128 b = _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_mul_ps(_mm_cvtepi32_ps(high), gainVector));
+        _mm_storeu_ps(dst + i, a);
+        _mm_storeu_ps(dst + i + 4, b);
+    }
+#elif defined(AUDIO_MIXER_NEON)
+    const float gains[4] = { gainLeft, gainRight, gainLeft, gainRight };
+    float32x4_t gainVector = vld1q_f32(gains);
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t packed = vld1q_s16(src + i);
+        float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(packed)));
+        float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(packed)));
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), low, gainVector));
+        vst1q_f32(dst + i + 4, vmlaq_f32(vld1q_f32(dst + i + 4), high, gainVector));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] += src[i] * ((i & 1) ? gainRight : gainLeft);
+    }
+}
+
+// Mono clip into the stereo mix: both channels get every sample
+void accumulateMonoSamples(const int16_t* src, float gainLeft, float gainRight, float* dst, int frames) {
+    int i = 0;
+#if defined(AUDIO_MIXER_SSE2)
+    __m128 gainVector = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+    for (; i + 4 <= frames; i += 4) {
+        __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+        __m128 samples = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16));
+        float* out = dst + i * 2;
+        __m128 low = _mm_mul_ps(_mm_unpacklo_ps(samples, samples), gainVector);
+        __m128 high = _mm_mul_ps(_mm_unpackhi_ps(samples, samples), gainVector);
+        _mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), low));
+        _mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), high));
+    }
+#elif defined(AUDIO_MIXER_NEON)
+    const float gains[4] = { gainLeft, gainRight, gainLeft, gainRight };
+    float32x4_t gainVector = vld1q_f32(gains);
+    for (; i + 4 <= frames; i += 4) {
+        float32x4_t samples = vcvtq_f32_s32(vmovl_s16(vld1_s16(src + i)));
+        float32x4x2_t doubled = vzipq_f32(samples, samples);
+        float* out = dst + i * 2;
+        vst1q_f32(out, vmlaq_f32(vld1q_f32(out), doubled.val[0], gainVector));
+        vst1q_f32(out + 4, vmlaq_f32(vld1q_f32(out + 4), doubled.val[1], gainVector));
+    }
+#endif
+    for (; i < frames; ++i) {
+        dst[i * 2] += src[i] * gainLeft;
+        dst[i * 2 + 1] += src[i] * gainRight;
+    }
+}
+
+// Applies the master gain and saturates to int16
+void convertSamples(const float* src, float gain, int16_t* dst, int count) {
+    int i = 0;
+#if defined(AUDIO_MIXER_SSE2)
+    __m128 gainVector = _mm_set1_ps(gain);
+    __m128 maxVector = _mm_set1_ps(32767.0f);
+    __m128 minVector = _mm_set1_ps(-32768.0f);
+    for (; i + 8 <= count; i += 8) {
+        __m128 a = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(src + i), gainVector), maxVector), minVector);
+        __m128 b = _mm_max_ps(_mm_min_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), gainVector), maxVector), minVector);
+        __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+    }
+#elif defined(AUDIO_MIXER_NEON)
+    float32x4_t maxVector = vdupq_n_f32(32767.0f);
+    float32x4_t minVector = vdupq_n_f32(-32768.0f);
+    float32x4_t half = vdupq_n_f32(0.5f);
+    for (; i + 8 <= count; i += 8) {
+        float32x4_t a = vmaxq_f32(vminq_f32(vmulq_n_f32(vld1q_f32(src + i), gain), maxVector), minVector);
+        float32x4_t b = vmaxq_f32(vminq_f32(vmulq_n_f32(vld1q_f32(src + i + 4), gain), maxVector), minVector);
+        // vcvtq truncates; nudge away from zero first to round to nearest
+        a = vaddq_f32(a, vbslq_f32(vcltq_f32(a, vdupq_n_f32(0.0f)), vnegq_f32(half), half));
+        b = vaddq_f32(b, vbslq_f32(vcltq_f32(b, vdupq_n_f32(0.0f)), vnegq_f32(half), half));
+        int16x8_t packed = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)), vqmovn_s32(vcvtq_s32_f32(b)));
+        vst1q_s16(dst + i, packed);
+    }
+#endif
+    for (; i < count; ++i) {
+        float sample = src[i] * gain;
+        if (sample > 32767.0f) sample = 32767.0f;
+        if (sample < -32768.0f) sample = -32768.0f;
+        dst[i] = static_cast<int16_t>(sample >= 0.0f ? sample + 0.5f : sample - 0.5f);
+    }
+}
+
+float clampPitch(float pitch) {
+    return std::min(2.0f, std::max(0.5f, pitch));
+}
+
+float clampVolume(float volume) {
+    return std::min(1.0f, std::max(0.0f, volume));
+}
+
+const float SPEED_OF_SOUND = 343.3f;    // m/s, world units taken as meters
+const float DISTANCE_FADE = 0.1f;       // fraction of maxDistance faded out to avoid a click
+
+// Higher priority, then louder, gets mixed first
+bool mixesBefore(float loudnessA, int priorityA, float loudnessB, int priorityB) {
+    return priorityA != priorityB ? priorityA > priorityB : loudnessA > loudnessB;
+}
+
+} // namespace
+
+AudioMixer::AudioMixer(int maxVoices, int outputSampleRate, int maxMixedVoices)
+    : voices(std::max(1, std::min(maxVoices, 0xFFFF)))
+    , mixBuffer(MAX_PERIOD_FRAMES * OUTPUT_CHANNELS)
+    , pendingStreams()
+    , playingVoices()
+    , listener()
+    , listenerRight(1.0f, 0.0f, 0.0f)
+    , maxMixedVoices(maxMixedVoices > 0 ? std::min(maxMixedVoices, static_cast<int>(voices.size()))
+                                        : static_cast<int>(voices.size()))
+    , outputSampleRate(outputSampleRate)
+    , masterVolume(1.0f)
+    , mixerPaused(false)
+    , nextStartOrder(0)
+{
+    for (auto& voice : voices) {
+        voice.position = 0;
+        voice.step = FIXED_ONE;
+        voice.volume = 1.0f;
+        voice.pitch = 1.0f;
+        voice.doppler = 1.0f;
+        voice.gainLeft = 1.0f;
+        voice.gainRight = 1.0f;
+        voice.emitterPosition = glm::vec3(0.0f);
+        voice.emitterVelocity = glm::vec3(0.0f);
+        voice.minDistance = 1.0f;
+        voice.maxDistance = 50.0f;
+        voice.rolloff = 1.0f;
+        voice.priority = 0;
+        voice.generation = 0;
+        voice.startOrder = 0;
+        voice.active = false;
+        voice.paused = false;
+        voice.loop = false;
+        voice.spatial = false;
+        voice.mixed = false;
+    }
+    pendingStreams.reserve(voices.size());
+    playingVoices.reserve(voices.size());
+}
+
+AudioMixer::Voice* AudioMixer::findVoice(VoiceId voice) {
+    uint32_t index = voice & 0xFFFF;
+    if (voice == INVALID_VOICE || index >= voices.size()) {
+        return nullptr;
+    }
+    Voice& slot = voices[index];
+    return (slot.active && slot.generation == (voice >> 16)) ? &slot : nullptr;
+}
+
+const AudioMixer::Voice* AudioMixer::findVoice(VoiceId voice) const {
+    return const_cast<AudioMixer*>(this)->findVoice(voice);
+}
+
+int AudioMixer::selectSlot(int priority) {
+    int victim = -1;
+    for (size_t i = 0; i < voices.size(); ++i) {
+        const Voice& voice = voices[i];
+        if (!voice.active) {
+            return static_cast<int>(i);
+        }
+        if (victim < 0) {
+            victim = static_cast<int>(i);
+            continue;
+        }
+        // Lowest priority first, then out of earshot, then paused voices, then the oldest
+        const Voice& current = voices[victim];
+        bool silent = (voice.gainLeft <= 0.0f && voice.gainRight <= 0.0f);
+        bool currentSilent = (current.gainLeft <= 0.0f && current.gainRight <= 0.0f);
+        if (voice.priority != current.priority) {
+            if (voice.priority < current.priority) victim = static_cast<int>(i);
+        } else if (silent != currentSilent) {
+            if (silent) victim = static_cast<int>(i);
+        } else if (voice.paused != current.paused) {
+            if (voice.paused) victim = static_cast<int>(i);
+        } else if (voice.startOrder - current.startOrder > 0x7FFFFFFFu) {
+            victim = static_cast<int>(i);
+        }
+    }
+
+    if (victim < 0 || voices[victim].priority > priority) {
+        return -1;
+    }
+    stats.voicesStolen++;
+    return victim;
+}
+
+uint64_t AudioMixer::computeStep(int sampleRate, float rate) const {
+    double ratio = static_cast<double>(rate) * sampleRate / outputSampleRate;
+    return static_cast<uint64_t>(ratio * static_cast<double>(FIXED_ONE) + 0.5);
+}
+
+int AudioMixer::getSampleRate(const Voice& voice) const {
+    return voice.stream ? voice.stream->getSampleRate() : voice.clip->sampleRate;
+}
+
+void AudioMixer::updateGains(Voice& voice) {
+    if (!voice.spatial) {
+        voice.gainLeft = voice.gainRight = voice.volume;
+        voice.doppler = 1.0f;
+        voice.step = computeStep(getSampleRate(voice), voice.pitch);
+        return;
+    }
+
+    glm::vec3 offset = voice.emitterPosition - listener.position;
+    float distance = glm::length(offset);
+
+    // Inverse distance clamped, as OpenAL's default model, faded to silence
+    // just inside maxDistance so going virtual is not heard as a click
+    float attenuation = 0.0f;
+    if (distance < voice.maxDistance) {
+        float clamped = std::max(distance, voice.minDistance);
+        attenuation = voice.minDistance / (voice.minDistance + voice.rolloff * (clamped - voice.minDistance));
+        float fade = (voice.maxDistance - distance) / (voice.maxDistance * DISTANCE_FADE);
+        attenuation *= std::min(1.0f, fade);
+    }
+
+    // Sine law pan, scaled so a centered source keeps full volume
+    float pan = 0.0f;
+    glm::vec3 direction(0.0f);
+    if (distance > 1e-4f) {
+        direction = offset / distance;
+        pan = std::max(-1.0f, std::min(1.0f, glm::dot(direction, listenerRight)));
+    }
+    float angle = (pan + 1.0f) * 0.78539816f;
+    float gain = voice.volume * attenuation;
+    voice.gainLeft = gain * std::min(1.0f, 1.41421356f * std::cos(angle));
+    voice.gainRight = gain * std::min(1.0f, 1.41421356f * std::sin(angle));
+
+    // Doppler along the line between them; positive speeds close the gap
+    float listenerSpeed = std::min(glm::dot(listener.velocity, direction), SPEED_OF_SOUND * 0.5f);
+    float sourceSpeed = std::min(-glm::dot(voice.emitterVelocity, direction), SPEED_OF_SOUND * 0.5f);
+    float doppler = (SPEED_OF_SOUND + listenerSpeed) / (SPEED_OF_SOUND - sourceSpeed);
+    if (std::fabs(doppler - 1.0f) < 1e-3f) {
+        doppler = 1.0f;     // keeps still sources on the straight copy path
+    }
+    voice.doppler = std::max(0.5f, std::min(2.0f, doppler));
+    voice.step = computeStep(getSampleRate(voice), voice.pitch * voice.doppler);
+}
+
+VoiceId AudioMixer::startVoice(int slot, const VoiceParams& params) {
+    Voice& voice = voices[slot];
+    voice.position = 0;
+    voice.pitch = clampPitch(params.pitch);
+    voice.volume = clampVolume(params.volume);
+    voice.spatial = params.spatial;
+    voice.emitterPosition = params.position;
+    voice.emitterVelocity = params.velocity;
+    voice.minDistance = std::max(0.01f, params.minDistance);
+    voice.maxDistance = std::max(voice.minDistance, params.maxDistance);
+    voice.rolloff = std::max(0.0f, params.rolloff);
+    voice.mixed = false;
+    updateGains(voice);
+    voice.priority = params.priority;
+    voice.loop = params.loop;
+    voice.paused = false;
+    voice.active = true;
+    voice.startOrder = nextStartOrder++;
+    voice.generation = (voice.generation + 1) & 0xFFFF;
+    if (voice.generation == 0) {
+        voice.generation = 1;
+    }
+    stats.voicesStarted++;
+
+    return (voice.generation << 16) | static_cast<uint32_t>(slot);
+}
+
+void AudioMixer::releaseVoice(Voice& voice) {
+    voice.active = false;
+    voice.clip.reset();
+    voice.stream.reset();
+}
+
+VoiceId AudioMixer::play(const std::shared_ptr<const AudioClip>& clip, const VoiceParams& params) {
+    if (!clip || clip->getFrameCount() == 0 || clip->channels < 1 || clip->channels > 2) {
+        return INVALID_VOICE;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    int slot = selectSlot(params.priority);
+    if (slot < 0) {
+        stats.voicesRejected++;
+        return INVALID_VOICE;
+    }
+
+    voices[slot].stream.reset();
+    voices[slot].clip = clip;
+    return startVoice(slot, params);
+}
+
+VoiceId AudioMixer::playStream(const std::shared_ptr<AudioStream>& stream, const VoiceParams& params) {
+    if (!stream || stream->getChannels() < 1 || stream->getChannels() > 2) {
+        return INVALID_VOICE;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // A voice still reading this stream would fight the new one over its cursor
+    for (auto& voice : voices) {
+        if (voice.active && voice.stream == stream) {
+            releaseVoice(voice);
+        }
+    }
+
+    int slot = selectSlot(params.priority);
+    if (slot < 0) {
+        stats.voicesRejected++;
+        return INVALID_VOICE;
+    }
+
+    stream->setLoop(params.loop);
+    stream->restart();
+    voices[slot].clip.reset();
+    voices[slot].stream = stream;
+    return startVoice(slot, params);
+}
+
+void AudioMixer::stop(VoiceId voiceId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Voice* voice = findVoice(voiceId)) {
+        releaseVoice(*voice);
+    }
+}
+
+void AudioMixer::pause(VoiceId voiceId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Voice* voice = findVoice(voiceId)) {
+        voice->paused = true;
+    }
+}
+
+void AudioMixer::resume(VoiceId voiceId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Voice* voice = findVoice(voiceId)) {
+        voice->paused = false;
+    }
+}
+
+void AudioMixer::stopAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& voice : voices) {
+        releaseVoice(voice);
+    }
+}
+
+void AudioMixer::setVolume(VoiceId voiceId, float volume) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Voice* voice = findVoice(voiceId)) {
+        voice->volume = clampVolume(volume);
+        updateGains(*voice);
+    }
+}
+
+void AudioMixer::setPitch(VoiceId voiceId, float pitch) {
+    // Only the cursor step changes; the voice keeps its position in the clip
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Voice* voice = findVoice(voiceId)) {
+        voice->pitch = clampPitch(pitch);
+        updateGains(*voice);
+    }
+}
+
+void AudioMixer::setLoop(VoiceId voiceId, bool loop) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Voice* voice = findVoice(voiceId)) {
+        voice->loop = loop;
+        if (voice->stream) {
+            voice->stream->setLoop(loop);
+        }
+    }
+}
+
+void AudioMixer::setDistanceModel(VoiceId voiceId, float minDistance, float maxDistance, float rolloff) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (Voice* voice = findVoice(voiceId)) {
+        voice->minDistance = std::max(0.01f, minDistance);
+        voice->maxDistance = std::max(voice->minDistance, maxDistance);
+        voice->rolloff = std::max(0.0f, rolloff);
+        updateGains(*voice);
+    }
+}
+
+void AudioMixer::updateSpatial(const AudioListener& newListener, const VoiceEmitter* emitters, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    listener = newListener;
+    glm::vec3 right = glm::cross(listener.forward, listener.up);
+    float length = glm::length(right);
+    listenerRight = length > 1e-6f ? right / length : glm::vec3(1.0f, 0.0f, 0.0f);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (Voice* voice = findVoice(emitters[i].voice)) {
+            voice->emitterPosition = emitters[i].position;
+            voice->emitterVelocity = emitters[i].velocity;
+        }
+    }
+    for (auto& voice : voices) {
+        if (voice.active && voice.spatial) {
+            updateGains(voice);
+        }
+    }
+}
+
+bool AudioMixer::isPlaying(VoiceId voiceId) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Voice* voice = findVoice(voiceId);
+    return voice && !voice->paused;
+}
+
+bool AudioMixer::isPaused(VoiceId voiceId) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Voice* voice = findVoice(voiceId);
+    return voice && voice->paused;
+}
+
+bool AudioMixer::isVirtual(VoiceId voiceId) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Voice* voice = findVoice(voiceId);
+    return voice && !voice->paused && !voice->mixed;
+}
+
+void AudioMixer::setMasterVolume(float volume) {
+    std::lock_guard<std::mutex> lock(mutex);
+    masterVolume = clampVolume(volume);
+}
+
+float AudioMixer::getMasterVolume() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return masterVolume;
+}
+
+void AudioMixer::setPaused(bool paused) {
+    std::lock_guard<std::mutex> lock(mutex);
+    mixerPaused = paused;
+}
+
+int AudioMixer::getActiveVoiceCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    int count = 0;
+    for (const auto& voice : voices) {
+        if (voice.active) count++;
+    }
+    return count;
+}
+
+AudioMixerStats AudioMixer::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void AudioMixer::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.reset();
+}
+
+void AudioMixer::mixVoice(Voice& voice, float* output, int frames) {
+    const AudioClip& clip = *voice.clip;
+    const int16_t* data = clip.samples.data();
+    const uint64_t frameCount = clip.getFrameCount();
+    const uint64_t length = frameCount << 32;
+    const float gainLeft = voice.gainLeft;
+    const float gainRight = voice.gainRight;
+    const bool stereo = (clip.channels == 2);
+
+    if (voice.step == FIXED_ONE && (voice.position & 0xFFFFFFFFULL) == 0) {
+        // Native rate at pitch 1: straight runs of the clip, vectorized
+        int remaining = frames;
+        while (remaining > 0) {
+            uint64_t index = voice.position >> 32;
+            if (index >= frameCount) {
+                if (!voice.loop) {
+                    releaseVoice(voice);
+                    return;
+                }
+                voice.position = 0;
+                index = 0;
+            }
+
+            int count = static_cast<int>(std::min<uint64_t>(remaining, frameCount - index));
+            if (stereo) {
+                accumulateSamples(data + index * 2, gainLeft, gainRight, output, count * 2);
+            } else {
+                accumulateMonoSamples(data + index, gainLeft, gainRight, output, count);
+            }
+            voice.position += static_cast<uint64_t>(count) << 32;
+            output += count * OUTPUT_CHANNELS;
+            remaining -= count;
+        }
+        return;
+    }
+
+    for (int i = 0; i < frames; ++i) {
+        if (voice.position >= length) {
+            if (!voice.loop) {
+                releaseVoice(voice);
+                return;
+            }
+            voice.position %= length;
+        }
+
+        uint64_t index = voice.position >> 32;
+        uint64_t next = index + 1;
+        if (next >= frameCount) {
+            next = voice.loop ? 0 : index;
+        }
+        float fraction = static_cast<float>(voice.position & 0xFFFFFFFFULL) * FIXED_TO_FLOAT;
+
+        float* out = output + i * OUTPUT_CHANNELS;
+        if (stereo) {
+            float left = data[index * 2] + (data[next * 2] - data[index * 2]) * fraction;
+            float right = data[index * 2 + 1] + (data[next * 2 + 1] - data[index * 2 + 1]) * fraction;
+            out[0] += left * gainLeft;
+            out[1] += right * gainRight;
+        } else {
+            float sample = data[index] + (data[next] - data[index]) * fraction;
+            out[0] += sample * gainLeft;
+            out[1] += sample * gainRight;
+        }
+        voice.position += voice.step;
+    }
+}
+
+void AudioMixer::mixStreamVoice(Voice& voice, float* output, int frames) {
+    AudioStream& stream = *voice.stream;
+    if (stream.isRestartPending()) {
+        return;
+    }
+
+    const int16_t* data = stream.getRingData();
+    const uint64_t mask = AudioStream::RING_FRAMES - 1;
+    const float gainLeft = voice.gainLeft;
+    const float gainRight = voice.gainRight;
+    const bool stereo = (stream.getChannels() == 2);
+    const uint64_t written = stream.getWriteFrame();
+
+    int i = 0;
+    if (voice.step == FIXED_ONE && (voice.position & 0xFFFFFFFFULL) == 0) {
+        // Same vectorized runs as a clip, split where the ring wraps
+        while (i < frames) {
+            uint64_t index = voice.position >> 32;
+            if (index >= written) {
+                break;
+            }
+            uint64_t offset = index & mask;
+            int count = static_cast<int>(std::min<uint64_t>(std::min<uint64_t>(frames - i, written - index),
+                                                            AudioStream::RING_FRAMES - offset));
+            float* out = output + i * OUTPUT_CHANNELS;
+            if (stereo) {
+                accumulateSamples(data + offset * 2, gainLeft, gainRight, out, count * 2);
+            } else {
+                accumulateMonoSamples(data + offset, gainLeft, gainRight, out, count);
+            }
+            voice.position += static_cast<uint64_t>(count) << 32;
+            i += count;
+        }
+    } else {
+        for (; i < frames; ++i) {
+            uint64_t index = voice.position >> 32;
+            uint64_t next = index + 1;
+            if (next >= written) {
+                // The last decoded frame only plays once nothing follows it
+                if (!stream.isEnded() || index >= written) {
+                    break;
+                }
+                next = index;
+            }
+            uint64_t current = index & mask;
+            next &= mask;
+            float fraction = static_cast<float>(voice.position & 0xFFFFFFFFULL) * FIXED_TO_FLOAT;
+
+            float* out = output + i * OUTPUT_CHANNELS;
+            if (stereo) {
+                float left = data[current * 2] + (data[next * 2] - data[current * 2]) * fraction;
+                float right = data[current * 2 + 1] + (data[next * 2 + 1] - data[current * 2 + 1]) * fraction;
+                out[0] += left * gainLeft;
+                out[1] += right * gainRight;
+            } else {
+                float sample = data[current] + (data[next] - data[current]) * fraction;
+                out[0] += sample * gainLeft;
+                out[1] += sample * gainRight;
+            }
+            voice.position += voice.step;
+        }
+    }
+
+    uint64_t index = voice.position >> 32;
+    if (i < frames) {
+        if (stream.isEnded() && index >= written) {
+            releaseVoice(voice);
+            return;
+        }
+        // Ran ahead of the decoder: hold position and play silence until it catches up
+        stats.streamUnderruns++;
+    }
+
+    stream.setReadFrame(std::min(index, written));
+    if (stream.getReadFrame() >= static_cast<uint64_t>(AudioStream::RING_FRAMES)) {
+        stream.rebase(AudioStream::RING_FRAMES);
+        voice.position -= static_cast<uint64_t>(AudioStream::RING_FRAMES) << 32;
+    }
+}
+
+void AudioMixer::advanceVoice(Voice& voice, int frames) {
+    uint64_t target = voice.position + voice.step * static_cast<uint64_t>(frames);
+
+    if (voice.stream) {
+        // Consume the ring as if mixed; never past what has been decoded
+        AudioStream& stream = *voice.stream;
+        if (stream.isRestartPending()) {
+            return;
+        }
+        uint64_t written = stream.getWriteFrame();
+        if ((target >> 32) >= written) {
+            if (stream.isEnded()) {
+                releaseVoice(voice);
+                return;
+            }
+            target = written << 32;
+        }
+        voice.position = target;
+        stream.setReadFrame(target >> 32);
+        if (stream.getReadFrame() >= static_cast<uint64_t>(AudioStream::RING_FRAMES)) {
+            stream.rebase(AudioStream::RING_FRAMES);
+            voice.position -= static_cast<uint64_t>(AudioStream::RING_FRAMES) << 32;
+        }
+        return;
+    }
+
+    uint64_t length = static_cast<uint64_t>(voice.clip->getFrameCount()) << 32;
+    if (target >= length) {
+        if (!voice.loop) {
+            releaseVoice(voice);
+            return;
+        }
+        target %= length;
+    }
+    voice.position = target;
+}
+
+void AudioMixer::updateStreams() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& voice : voices) {
+            if (voice.active && voice.stream) {
+                pendingStreams.push_back(voice.stream);
+            }
+        }
+    }
+    for (const auto& stream : pendingStreams) {
+        stream->fill();
+    }
+    pendingStreams.clear();
+}
+
+void AudioMixer::mix(int16_t* output, int frames) {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.periodsMixed++;
+
+    if (mixerPaused) {
+        memset(output, 0, static_cast<size_t>(frames) * OUTPUT_CHANNELS * sizeof(int16_t));
+        return;
+    }
+
+    // Pick the voices worth mixing this period: audible ones, highest
+    // priority and loudest first, up to the mixed voice limit
+    uint32_t activeVoices = 0;
+    uint32_t virtualVoices = 0;
+    playingVoices.clear();
+    for (auto& voice : voices) {
+        if (!voice.active) continue;
+        activeVoices++;
+        voice.mixed = false;
+        if (voice.paused) continue;
+        if (voice.gainLeft > 0.0f || voice.gainRight > 0.0f) {
+            playingVoices.push_back(&voice);
+        } else {
+            virtualVoices++;
+        }
+    }
+    if (playingVoices.size() > static_cast<size_t>(maxMixedVoices)) {
+        std::nth_element(playingVoices.begin(), playingVoices.begin() + maxMixedVoices, playingVoices.end(),
+                         [](const Voice* a, const Voice* b) {
+                             return mixesBefore(std::max(a->gainLeft, a->gainRight), a->priority,
+                                                std::max(b->gainLeft, b->gainRight), b->priority);
+                         });
+        virtualVoices += static_cast<uint32_t>(playingVoices.size()) - maxMixedVoices;
+        playingVoices.resize(maxMixedVoices);
+    }
+    for (Voice* voice : playingVoices) {
+        voice->mixed = true;
+    }
+    stats.peakVirtualVoices = std::max(stats.peakVirtualVoices, virtualVoices);
+
+    const int totalFrames = frames;
+    while (frames > 0) {
+        int chunk = std::min(frames, static_cast<int>(MAX_PERIOD_FRAMES));
+        float* buffer = mixBuffer.data();
+        memset(buffer, 0, static_cast<size_t>(chunk) * OUTPUT_CHANNELS * sizeof(float));
+
+        for (Voice* voice : playingVoices) {
+            if (!voice->active) continue;
+            if (voice->stream) {
+                mixStreamVoice(*voice, buffer, chunk);
+            } else {
+                mixVoice(*voice, buffer, chunk);
+            }
+        }
+
+        convertSamples(buffer, masterVolume, output, chunk * OUTPUT_CHANNELS);
+        output += chunk * OUTPUT_CHANNELS;
+        frames -= chunk;
+    }
+
+    // Virtual voices keep time so they resume in step when audible again
+    for (auto& voice : voices) {
+        if (voice.active && !voice.paused && !voice.mixed) {
+            advanceVoice(voice, totalFrames);
+        }
+    }
+
+    stats.peakActiveVoices = std::max(stats.peakActiveVoices, activeVoices);
+}
+
+} // namespace GameEngine
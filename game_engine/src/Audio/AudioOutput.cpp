@@ -0,0 +1,268 @@
+#include "Audio/AudioOutput.h"
+#include "Audio/AudioMixer.h"
+#include "Core/ThreadManager.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef VITA_BUILD
+#include <psp2/audioout.h>
+#endif
+
+namespace GameEngine {
+
+bool AudioOutput::parseBackend(const std::string& name, AudioBackend& result) {
+    if (name == "device" || name == "openal" || name == "default") {
+        result = AudioBackend::DEVICE;
+    } else if (name == "null") {
+        result = AudioBackend::NULL_DEVICE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+NullAudioOutput::NullAudioOutput(bool realtime)
+    : realtime(realtime)
+    , sampleRate(48000)
+    , periodFrames(256)
+    , framesWritten(0)
+    , peakSample(0)
+{
+}
+
+bool NullAudioOutput::open(int rate, int frames) {
+    sampleRate = rate;
+    periodFrames = frames;
+    framesWritten = 0;
+    peakSample = 0;
+    startTime = std::chrono::steady_clock::now();
+    return true;
+}
+
+void NullAudioOutput::close() {
+}
+
+bool NullAudioOutput::write(const int16_t* samples) {
+    for (int i = 0; i < periodFrames * AudioMixer::OUTPUT_CHANNELS; ++i) {
+        int magnitude = std::abs(static_cast<int>(samples[i]));
+        if (magnitude > peakSample) peakSample = magnitude;
+    }
+    framesWritten += periodFrames;
+
+    if (realtime) {
+        // Sleep until the wall clock catches up with what has been "played"
+        std::chrono::microseconds played(framesWritten * 1000000ULL / sampleRate);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime);
+        if (played > elapsed) {
+            int ms = static_cast<int>((played - elapsed).count() / 1000);
+            if (ms > 0) {
+                ThreadManager::getInstance().sleep(ms);
+            }
+        }
+    }
+    return true;
+}
+
+#ifdef LINUX_BUILD
+
+OpenALAudioOutput::OpenALAudioOutput()
+    : device(nullptr)
+    , context(nullptr)
+    , source(0)
+    , queuedBuffers(0)
+    , sampleRate(48000)
+    , periodFrames(256)
+{
+    memset(buffers, 0, sizeof(buffers));
+}
+
+OpenALAudioOutput::~OpenALAudioOutput() {
+    close();
+}
+
+bool OpenALAudioOutput::openDevice() {
+    const ALCchar* deviceList = nullptr;
+    if (alcIsExtensionPresent(nullptr, "ALC_ENUMERATE_ALL_EXT")) {
+        deviceList = alcGetString(nullptr, ALC_ALL_DEVICES_SPECIFIER);
+    } else {
+        deviceList = alcGetString(nullptr, ALC_DEVICE_SPECIFIER);
+    }
+
+    device = alcOpenDevice(nullptr);
+
+    if (!device && deviceList && deviceList[0] != '\0') {
+        const ALCchar* name = deviceList;
+        while (*name != '\0' && !device) {
+            device = alcOpenDevice(name);
+            if (device) {
+                break;
+            }
+            name += strlen(name) + 1;
+        }
+    }
+
+    if (!device) {
+        const char* alsaDevices[] = {
+            "alsa",
+            "ALSA",
+            "sysdefault",
+            "plughw:0,0",
+            "hw:0,0"
+        };
+
+        for (const char* deviceName : alsaDevices) {
+            device = alcOpenDevice(deviceName);
+            if (device) {
+                break;
+            }
+        }
+    }
+
+    if (!device) {
+        std::cerr << "AudioOutput: Failed to open OpenAL device" << std::endl;
+        std::cerr << "AudioOutput: This may indicate that OpenAL Soft was not built with ALSA/PulseAudio support" << std::endl;
+        return false;
+    }
+
+    context = alcCreateContext(device, nullptr);
+    if (!context || alcMakeContextCurrent(context) == ALC_FALSE) {
+        std::cerr << "AudioOutput: Failed to create OpenAL context" << std::endl;
+        if (context) {
+            alcDestroyContext(context);
+            context = nullptr;
+        }
+        alcCloseDevice(device);
+        device = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool OpenALAudioOutput::open(int rate, int frames) {
+    sampleRate = rate;
+    periodFrames = frames;
+
+    if (!openDevice()) {
+        return false;
+    }
+
+    alGetError();
+    alGenSources(1, &source);
+    alGenBuffers(BUFFER_COUNT, buffers);
+    if (alGetError() != AL_NO_ERROR) {
+        std::cerr << "AudioOutput: Failed to create OpenAL stream source" << std::endl;
+        close();
+        return false;
+    }
+    queuedBuffers = 0;
+    return true;
+}
+
+void OpenALAudioOutput::close() {
+    if (source != 0) {
+        alSourceStop(source);
+        alSourcei(source, AL_BUFFER, 0);
+        alDeleteSources(1, &source);
+        source = 0;
+    }
+    if (buffers[0] != 0) {
+        alDeleteBuffers(BUFFER_COUNT, buffers);
+        memset(buffers, 0, sizeof(buffers));
+    }
+    queuedBuffers = 0;
+
+    if (context) {
+        alcMakeContextCurrent(nullptr);
+        alcDestroyContext(context);
+        context = nullptr;
+    }
+    if (device) {
+        alcCloseDevice(device);
+        device = nullptr;
+    }
+}
+
+bool OpenALAudioOutput::write(const int16_t* samples) {
+    if (source == 0) {
+        return false;
+    }
+
+    ALsizei bytes = periodFrames * AudioMixer::OUTPUT_CHANNELS * sizeof(int16_t);
+    ALuint buffer = 0;
+
+    if (queuedBuffers < BUFFER_COUNT) {
+        // Priming: every buffer goes in once before the source starts
+        buffer = buffers[queuedBuffers++];
+    } else {
+        ALint processed = 0;
+        alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+        while (processed <= 0) {
+            ThreadManager::getInstance().sleep(1);
+            alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+        }
+        alSourceUnqueueBuffers(source, 1, &buffer);
+    }
+
+    alBufferData(buffer, AL_FORMAT_STEREO16, samples, bytes, sampleRate);
+    alSourceQueueBuffers(source, 1, &buffer);
+
+    ALint state = AL_PLAYING;
+    alGetSourcei(source, AL_SOURCE_STATE, &state);
+    if (state != AL_PLAYING && queuedBuffers == BUFFER_COUNT) {
+        // Not started yet, or starved and stopped
+        alSourcePlay(source);
+    }
+
+    return alGetError() == AL_NO_ERROR;
+}
+
+#elif defined(VITA_BUILD)
+
+VitaAudioOutput::VitaAudioOutput()
+    : port(-1)
+{
+}
+
+VitaAudioOutput::~VitaAudioOutput() {
+    close();
+}
+
+bool VitaAudioOutput::open(int sampleRate, int periodFrames) {
+    port = sceAudioOutOpenPort(SCE_AUDIO_OUT_PORT_TYPE_BGM, periodFrames, sampleRate, SCE_AUDIO_OUT_MODE_STEREO);
+    if (port < 0) {
+        std::cerr << "AudioOutput: Failed to open Vita audio port: " << port << std::endl;
+        port = -1;
+        return false;
+    }
+
+    int volArray[2] = {SCE_AUDIO_VOLUME_0DB, SCE_AUDIO_VOLUME_0DB};
+    sceAudioOutSetVolume(port,
+        (SceAudioOutChannelFlag)(SCE_AUDIO_VOLUME_FLAG_L_CH | SCE_AUDIO_VOLUME_FLAG_R_CH),
+        volArray);
+    return true;
+}
+
+void VitaAudioOutput::close() {
+    if (port >= 0) {
+        sceAudioOutReleasePort(port);
+        port = -1;
+    }
+}
+
+bool VitaAudioOutput::write(const int16_t* samples) {
+    if (port < 0) {
+        return false;
+    }
+    int result = sceAudioOutOutput(port, samples);
+    if (result < 0) {
+        std::cerr << "AudioOutput: Audio output error: " << result << std::endl;
+        return false;
+    }
+    return true;
+}
+
+#endif
+
+} // namespace GameEngine
@@ -0,0 +1,57 @@
+#include "Audio/AudioStream.h"
+#include <algorithm>
+
+namespace GameEngine {
+
+AudioStream::AudioStream(std::unique_ptr<AudioDecoder> source)
+    : decoder(std::move(source))
+    , channels(decoder->getChannels())
+    , sampleRate(decoder->getSampleRate())
+    , readFrame(0)
+    , writeFrame(0)
+    , loop(false)
+    , restartPending(false)
+    , ended(false)
+{
+    ring.resize(static_cast<size_t>(RING_FRAMES) * channels);
+}
+
+void AudioStream::fill() {
+    if (restartPending.exchange(false)) {
+        decoder->rewind();
+        readFrame = 0;
+        writeFrame = 0;
+        ended = false;
+    }
+    if (ended) {
+        // Loop switched on after the decoder ran out: carry on from the start
+        if (!loop.load() || !decoder->rewind()) {
+            return;
+        }
+        ended = false;
+    }
+
+    bool rewound = false;
+    while (RING_FRAMES - (writeFrame - readFrame) >= static_cast<uint64_t>(BLOCK_FRAMES)) {
+        size_t offset = static_cast<size_t>(writeFrame & (RING_FRAMES - 1));
+        size_t wanted = std::min<size_t>(BLOCK_FRAMES, RING_FRAMES - offset);
+        size_t got = decoder->read(ring.data() + offset * channels, wanted);
+        writeFrame += got;
+        if (got > 0) {
+            rewound = false;
+        }
+        if (got == wanted) {
+            continue;
+        }
+
+        // End of file. An empty decode straight after a rewind means there
+        // is nothing to loop, so stop rather than spin
+        if (!loop.load() || rewound || !decoder->rewind()) {
+            ended = true;
+            return;
+        }
+        rewound = true;
+    }
+}
+
+} // namespace GameEngine
@@ -5,6 +5,7 @@
 #include "Rendering/Mesh.h"
 #include "Rendering/Material.h"
 #include "Rendering/Shader.h"
+#include "Rendering/RenderDevice.h"
 #include "Components/PhysicsComponent.h"
 #include <algorithm>
 #include <iostream>
@@ -642,9 +643,10 @@ void Area3DComponent::renderDebugWireframe(const glm::mat4& viewMatrix, const gl
     }
     
     // Store OpenGL state
+    auto& device = RenderDevice::getInstance();
     GLint currentPolygonMode[2];
-    glGetIntegerv(GL_POLYGON_MODE, currentPolygonMode);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    device.getIntegerv(GL_POLYGON_MODE, currentPolygonMode);
+    device.polygonMode(GL_FRONT_AND_BACK, GL_LINE);
     
     // Bind and render wireframe mesh
     wireframeMesh->bind();
@@ -667,7 +669,7 @@ void Area3DComponent::renderDebugWireframe(const glm::mat4& viewMatrix, const gl
     wireframeMesh->unbind();
     
     // Restore OpenGL state
-    glPolygonMode(GL_FRONT_AND_BACK, currentPolygonMode[0]);
+    device.polygonMode(GL_FRONT_AND_BACK, currentPolygonMode[0]);
 #endif
 }
 
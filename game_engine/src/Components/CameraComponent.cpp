@@ -14,6 +14,54 @@
 
 namespace GameEngine {
 
+CameraSnapshot::CameraSnapshot()
+    : view(1.0f)
+    , projection(1.0f)
+    , viewProjection(1.0f)
+    , inverseView(1.0f)
+    , position(0.0f)
+    , forward(0.0f, 0.0f, -1.0f)
+    , projectionType(ProjectionType::PERSPECTIVE)
+    , fov(45.0f)
+    , aspectRatio(16.0f / 9.0f)
+    , nearPlane(0.1f)
+    , farPlane(1000.0f)
+    , version(0)
+{
+    for (int i = 0; i < 6; ++i) {
+        frustumPlanes[i] = glm::vec4(0.0f);
+    }
+}
+
+bool CameraSnapshot::isAABBVisible(const glm::vec3& min, const glm::vec3& max, const glm::mat4& transform) const {
+    if (min.x >= max.x || min.y >= max.y || min.z >= max.z) {
+        return true;
+    }
+    
+    glm::vec3 corners[8];
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 corner((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z);
+        corners[i] = glm::vec3(transform * glm::vec4(corner, 1.0f));
+    }
+    
+    const float margin = -0.1f;
+    for (int p = 0; p < 6; ++p) {
+        glm::vec3 normal(frustumPlanes[p]);
+        bool inside = false;
+        for (int i = 0; i < 8; ++i) {
+            if (glm::dot(normal, corners[i]) + frustumPlanes[p].w > margin) {
+                inside = true;
+                break;
+            }
+        }
+        if (!inside) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
 CameraComponent::CameraComponent()
     : projectionType(ProjectionType::PERSPECTIVE)
     , fov(45.0f)
@@ -30,6 +78,9 @@ CameraComponent::CameraComponent()
     , mouseSensitivity(0.1f)
     , projectionMatrix(1.0f)
     , projectionDirty(true)
+    , snapshotWorldMatrix(1.0f)
+    , snapshotHidden(false)
+    , snapshotDirty(true)
 #ifdef EDITOR_BUILD
     , showGizmo(false)
     , showFrustum(true)
@@ -219,26 +270,59 @@ void CameraComponent::rotate(float yawDelta, float pitchDelta) {
     updateRotation();
 }
 
-glm::mat4 CameraComponent::getViewMatrix() {
-    if (!owner) return glm::mat4(1.0f);
-    
-    if (!owner->isActive() || !owner->isVisible()) {
-        return glm::mat4(1.0f);
-    }
-    
-    glm::mat4 worldMatrix = owner->getWorldMatrix();
-    return glm::inverse(worldMatrix);
-}
-
-glm::mat4 CameraComponent::getProjectionMatrix() {
+const CameraSnapshot& CameraComponent::getSnapshot() {
     if (projectionDirty) {
         updateProjection();
     }
-    return projectionMatrix;
+    
+    // A detached or hidden camera keeps the identity view, as before
+    bool hidden = !owner || !owner->isActive() || !owner->isVisible();
+    glm::mat4 worldMatrix = hidden ? glm::mat4(1.0f) : owner->getWorldMatrix();
+    
+    if (snapshotDirty || hidden != snapshotHidden || worldMatrix != snapshotWorldMatrix) {
+        refreshSnapshot(worldMatrix, hidden);
+    }
+    return snapshot;
 }
 
-glm::mat4 CameraComponent::getViewProjectionMatrix() {
-    return getProjectionMatrix() * getViewMatrix();
+void CameraComponent::refreshSnapshot(const glm::mat4& worldMatrix, bool hidden) {
+    snapshot.inverseView = worldMatrix;
+    snapshot.view = hidden ? glm::mat4(1.0f) : glm::inverse(worldMatrix);
+    snapshot.projection = projectionMatrix;
+    snapshot.viewProjection = projectionMatrix * snapshot.view;
+    snapshot.position = glm::vec3(worldMatrix[3]);
+    snapshot.forward = glm::normalize(-glm::vec3(worldMatrix[2]));
+    snapshot.projectionType = projectionType;
+    snapshot.fov = fov;
+    snapshot.aspectRatio = aspectRatio;
+    snapshot.nearPlane = nearPlane;
+    snapshot.farPlane = farPlane;
+    
+    // Gribb/Hartmann plane extraction: left, right, bottom, top, near, far
+    const glm::mat4& m = snapshot.viewProjection;
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+    snapshot.frustumPlanes[0] = row3 + row0;
+    snapshot.frustumPlanes[1] = row3 - row0;
+    snapshot.frustumPlanes[2] = row3 + row1;
+    snapshot.frustumPlanes[3] = row3 - row1;
+    snapshot.frustumPlanes[4] = row3 + row2;
+    snapshot.frustumPlanes[5] = row3 - row2;
+    
+    const float epsilon = 0.0001f;
+    for (int i = 0; i < 6; ++i) {
+        float length = glm::length(glm::vec3(snapshot.frustumPlanes[i]));
+        if (length > epsilon) {
+            snapshot.frustumPlanes[i] /= length;
+        }
+    }
+    
+    snapshot.version++;
+    snapshotWorldMatrix = worldMatrix;
+    snapshotHidden = hidden;
+    snapshotDirty = false;
 }
 
 glm::vec3 CameraComponent::getForward() const {
@@ -391,6 +475,7 @@ void CameraComponent::updateProjection() {
     }
     
     projectionDirty = false;
+    snapshotDirty = true;
     
 #ifdef EDITOR_BUILD
     updateFrustumMesh();
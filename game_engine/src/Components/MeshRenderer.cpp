@@ -13,6 +13,7 @@ namespace GameEngine {
 MeshRenderer::MeshRenderer()
     : mesh(nullptr)
     , material(nullptr)
+    , materialShared(false)
     , castShadows(true)
     , receiveShadows(true)
 {
@@ -51,6 +52,20 @@ void MeshRenderer::setMesh(std::shared_ptr<Mesh> newMesh) {
 
 void MeshRenderer::setMaterial(std::shared_ptr<Material> newMaterial) {
     material = newMaterial;
+    materialShared = false;
+}
+
+void MeshRenderer::setSharedMaterial(std::shared_ptr<Material> newMaterial) {
+    material = newMaterial;
+    materialShared = material != nullptr;
+}
+
+std::shared_ptr<Material> MeshRenderer::getUniqueMaterial() {
+    if (materialShared) {
+        material = material->clone();
+        materialShared = false;
+    }
+    return material;
 }
 
 void MeshRenderer::drawInspector() {
@@ -68,7 +83,13 @@ void MeshRenderer::drawInspector() {
         }
         
         // Show material inspector if material is present
-        if (material) {
+        if (material && materialShared) {
+            ImGui::Separator();
+            ImGui::TextDisabled("Material shared with other prefab instances");
+            if (ImGui::Button("Edit Unique Copy")) {
+                getUniqueMaterial();
+            }
+        } else if (material) {
             ImGui::Separator();
             material->drawInspector();
         }
@@ -6,10 +6,12 @@
 #include "Rendering/Material.h"
 #include "Scene/SceneNode.h"
 #include "Components/AnimationComponent.h"
+#include "Components/CameraComponent.h"
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
 #include <set>
+#include <sstream>
 #include <unordered_map>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -35,10 +37,13 @@
 namespace GameEngine {
 
 std::unordered_map<std::string, std::shared_ptr<ModelData>> ModelRenderer::meshCache;
+std::unordered_map<std::string, PreparedModel> ModelRenderer::preparedModels;
 
 ModelRenderer::ModelRenderer()
     : castShadows(true)
     , receiveShadows(true)
+    , forcedLOD(-1)
+    , lodBias(1.0f)
 {
     // Initialize model data
     modelData.isLoaded = false;
@@ -68,11 +73,11 @@ void ModelRenderer::render(Renderer& renderer) {
         boneTransforms = animComp->getBoneTransforms();
     }
     
+    bool selectLODs = renderer.hasFrameCamera();
+    
     // Render each mesh in the model
     for (size_t i = 0; i < modelData.meshes.size(); ++i) {
-        auto mesh = modelData.meshes[i];
-        
-        if (!mesh) continue;
+        if (!modelData.meshes[i]) continue;
         
         std::shared_ptr<Material> material = nullptr;
         if (i < modelData.meshMaterialIndices.size()) {
@@ -87,6 +92,10 @@ void ModelRenderer::render(Renderer& renderer) {
             : glm::mat4(1.0f);
         glm::mat4 modelMatrix = sceneNodeMatrix * gltfNodeTransform;
         
+        std::shared_ptr<Mesh> mesh = selectLODs
+            ? selectLOD(i, modelMatrix, renderer.getFrameCamera())
+            : modelData.meshes[i];
+        
         // Create render command
         RenderCommand command;
         command.mesh = mesh;
@@ -111,42 +120,34 @@ bool ModelRenderer::loadModel(const std::string& modelPath) {
     
     auto cached = getCachedModel(modelPath);
     if (cached && cached->isLoaded) {
-        modelData.meshes = cached->meshes;
-        modelData.materials = cached->materials;
-        modelData.meshNodeTransforms = cached->meshNodeTransforms;
-        modelData.meshMaterialIndices = cached->meshMaterialIndices;
-        modelData.modelPath = cached->modelPath;
-        modelData.modelName = cached->modelName;
-        modelData.isLoaded = cached->isLoaded;
+        modelData = *cached;
         std::cout << "ModelRenderer: Using cached model: " << modelPath << std::endl;
         return true;
     }
     
-    // Convert filepath to Vita format (app0:/path for VPK files) on Vita builds
-    std::string actualPath = modelPath;
-#ifdef VITA_BUILD
-    // Check if path already has a device prefix (app0:, ux0:, ur0:, etc.)
-    if (modelPath.find("app0:") == std::string::npos && 
-        modelPath.find("ux0:") == std::string::npos && 
-        modelPath.find("ur0:") == std::string::npos &&
-        modelPath.find("uma0:") == std::string::npos &&
-        modelPath.find("imc0:") == std::string::npos &&
-        modelPath.find("xmc0:") == std::string::npos &&
-        modelPath.find("vs0:") == std::string::npos &&
-        modelPath.find("vd0:") == std::string::npos) {
-        // No device prefix found, prepend app0: for VPK access
-        actualPath = "app0:/" + modelPath;
+    if (canPrepareModel(modelPath)) {
+        PreparedModel prepared;
+        auto pending = preparedModels.find(modelPath);
+        if (pending != preparedModels.end()) {
+            prepared = std::move(pending->second);
+            preparedModels.erase(pending);
+        } else {
+            prepareModel(modelPath, prepared);
+        }
+        if (!finishPreparedModel(prepared)) {
+            return false;
+        }
+        modelData = *getCachedModel(modelPath);
+        return true;
     }
-#endif
     
+    std::string actualPath = resolveModelPath(modelPath);
     std::string extension = getFileExtension(actualPath);
     std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
     
     bool success = false;
     
-    if (extension == ".gltf" || extension == ".glb") {
-        success = loadGLTFModel(actualPath);
-    } else if (extension == ".bmodel") {
+    if (extension == ".bmodel") {
         // Custom binary format for Vita
         success = loadBinaryModel(actualPath);
     } else {
@@ -158,16 +159,7 @@ bool ModelRenderer::loadModel(const std::string& modelPath) {
         modelData.modelPath = modelPath;
         modelData.modelName = getFileName(modelPath);
         modelData.isLoaded = true;
-        
-        auto cachedData = std::make_shared<ModelData>();
-        cachedData->meshes = modelData.meshes;
-        cachedData->materials = modelData.materials;
-        cachedData->meshNodeTransforms = modelData.meshNodeTransforms;
-        cachedData->meshMaterialIndices = modelData.meshMaterialIndices;
-        cachedData->modelPath = modelData.modelPath;
-        cachedData->modelName = modelData.modelName;
-        cachedData->isLoaded = modelData.isLoaded;
-        meshCache[modelPath] = cachedData;
+        meshCache[modelPath] = std::make_shared<ModelData>(modelData);
         std::cout << "ModelRenderer: Cached model: " << modelPath << std::endl;
     } else {
         std::cerr << "ModelRenderer: Failed to load model: " << modelPath << std::endl;
@@ -176,11 +168,53 @@ bool ModelRenderer::loadModel(const std::string& modelPath) {
     return success;
 }
 
+std::string ModelRenderer::resolveModelPath(const std::string& modelPath) {
+    // Convert filepath to Vita format (app0:/path for VPK files) on Vita builds
+    std::string actualPath = modelPath;
+#ifdef VITA_BUILD
+    // Check if path already has a device prefix (app0:, ux0:, ur0:, etc.)
+    if (modelPath.find("app0:") == std::string::npos && 
+        modelPath.find("ux0:") == std::string::npos && 
+        modelPath.find("ur0:") == std::string::npos &&
+        modelPath.find("uma0:") == std::string::npos &&
+        modelPath.find("imc0:") == std::string::npos &&
+        modelPath.find("xmc0:") == std::string::npos &&
+        modelPath.find("vs0:") == std::string::npos &&
+        modelPath.find("vd0:") == std::string::npos) {
+        // No device prefix found, prepend app0: for VPK access
+        actualPath = "app0:/" + modelPath;
+    }
+#endif
+    return actualPath;
+}
+
+bool ModelRenderer::canPrepareModel(const std::string& modelPath) {
+    std::string extension = getFileExtension(modelPath);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension == ".gltf" || extension == ".glb";
+}
+
+bool ModelRenderer::hasCachedModel(const std::string& modelPath) {
+    auto cached = getCachedModel(modelPath);
+    return cached && cached->isLoaded;
+}
+
+void ModelRenderer::addPreparedModel(PreparedModel& prepared) {
+    std::string modelPath = prepared.modelPath;
+    preparedModels[modelPath] = std::move(prepared);
+}
+
+void ModelRenderer::clearPreparedModels() {
+    preparedModels.clear();
+}
+
 void ModelRenderer::unloadModel() {
     modelData.meshes.clear();
     modelData.materials.clear();
     modelData.meshNodeTransforms.clear();
     modelData.meshMaterialIndices.clear();
+    modelData.meshLODs.clear();
+    currentLODs.clear();
     modelData.modelPath.clear();
     modelData.modelName.clear();
     modelData.isLoaded = false;
@@ -232,7 +266,7 @@ glm::mat4 ModelRenderer::computeNodeTransform(const tinygltf::Node& node) {
 }
 
 void ModelRenderer::traverseGLTFNodes(const tinygltf::Model& gltfModel, const tinygltf::Node& node, 
-                                      const glm::mat4& parentTransform) {
+                                      const glm::mat4& parentTransform, ModelData& data, std::ostream& log, std::ostream& errors) {
     glm::mat4 nodeTransform = computeNodeTransform(node);
     glm::mat4 worldTransform = parentTransform * nodeTransform;
     
@@ -241,64 +275,59 @@ void ModelRenderer::traverseGLTFNodes(const tinygltf::Model& gltfModel, const ti
         
         for (size_t j = 0; j < gltfMesh.primitives.size(); ++j) {
             const auto& primitive = gltfMesh.primitives[j];
-            auto mesh = createMeshFromGLTF(gltfModel, gltfMesh, primitive);
+            std::vector<MeshLOD> lods;
+            auto mesh = createMeshFromGLTF(gltfModel, gltfMesh, primitive, lods, log, errors);
             if (mesh && mesh->getVertexCount() > 0) {
-                modelData.meshes.push_back(mesh);
-                modelData.meshNodeTransforms.push_back(worldTransform);
+                data.meshes.push_back(mesh);
+                data.meshLODs.push_back(lods);
+                data.meshNodeTransforms.push_back(worldTransform);
                 
                 int materialIndex = (primitive.material >= 0 && primitive.material < static_cast<int>(gltfModel.materials.size())) 
                     ? primitive.material 
                     : -1;
-                modelData.meshMaterialIndices.push_back(materialIndex);
+                data.meshMaterialIndices.push_back(materialIndex);
             } else {
-                std::cerr << "ModelRenderer: Failed to load primitive " << j 
-                          << " from mesh '" << gltfMesh.name << "'" << std::endl;
+                errors << "ModelRenderer: Failed to load primitive " << j 
+                       << " from mesh '" << gltfMesh.name << "'" << std::endl;
             }
         }
     }
     
     for (int childIndex : node.children) {
         if (childIndex >= 0 && childIndex < static_cast<int>(gltfModel.nodes.size())) {
-            traverseGLTFNodes(gltfModel, gltfModel.nodes[childIndex], worldTransform);
+            traverseGLTFNodes(gltfModel, gltfModel.nodes[childIndex], worldTransform, data, log, errors);
         }
     }
 }
 
-bool ModelRenderer::loadGLTFModel(const std::string& modelPath) {
-    tinygltf::Model gltfModel;
+bool ModelRenderer::prepareModel(const std::string& modelPath, PreparedModel& prepared) {
+    prepared.modelPath = modelPath;
+    prepared.sourcePath = resolveModelPath(modelPath);
+    prepared.gltf = std::make_shared<tinygltf::Model>();
+    tinygltf::Model& gltfModel = *prepared.gltf;
     tinygltf::TinyGLTF loader;
     std::string err, warn;
+    std::ostringstream log;
+    std::ostringstream errors;
     
-    bool success = false;
-    std::string extension = getFileExtension(modelPath);
+    std::string extension = getFileExtension(prepared.sourcePath);
     std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
     
     if (extension == ".glb") {
-        success = loader.LoadBinaryFromFile(&gltfModel, &err, &warn, modelPath);
+        prepared.parsed = loader.LoadBinaryFromFile(&gltfModel, &err, &warn, prepared.sourcePath);
     } else {
-        success = loader.LoadASCIIFromFile(&gltfModel, &err, &warn, modelPath);
+        prepared.parsed = loader.LoadASCIIFromFile(&gltfModel, &err, &warn, prepared.sourcePath);
     }
     
-    if (!success) {
-        std::cerr << "ModelRenderer: Failed to load GLTF model: " << err << std::endl;
+    if (!prepared.parsed) {
+        errors << "ModelRenderer: Failed to load GLTF model: " << err << std::endl;
         if (!warn.empty()) {
-            std::cerr << "Warnings: " << warn << std::endl;
+            errors << "Warnings: " << warn << std::endl;
         }
+        prepared.errors = errors.str();
         return false;
     }
     
-    
-    // Extract model name early for skeleton/animation extraction
-    std::string modelName = getFileName(modelPath);
-    
-    // Load materials first
-    for (size_t i = 0; i < gltfModel.materials.size(); ++i) {
-        auto material = createMaterialFromGLTF(gltfModel, i, modelPath);
-        if (material) {
-            modelData.materials.push_back(material);
-        }
-    }
-    
     // Traverse scene graph starting from scene root nodes
     // Use the default scene (index 0) or the first available scene
     int sceneIndex = gltfModel.defaultScene >= 0 ? gltfModel.defaultScene : 0;
@@ -312,7 +341,7 @@ bool ModelRenderer::loadGLTFModel(const std::string& modelPath) {
         
         for (int rootNodeIndex : scene.nodes) {
             if (rootNodeIndex >= 0 && rootNodeIndex < static_cast<int>(gltfModel.nodes.size())) {
-                traverseGLTFNodes(gltfModel, gltfModel.nodes[rootNodeIndex], rootTransform);
+                traverseGLTFNodes(gltfModel, gltfModel.nodes[rootNodeIndex], rootTransform, prepared.data, log, errors);
             }
         }
     } else {
@@ -328,10 +357,61 @@ bool ModelRenderer::loadGLTFModel(const std::string& modelPath) {
         for (size_t i = 0; i < gltfModel.nodes.size(); ++i) {
             if (childNodes.find(static_cast<int>(i)) == childNodes.end()) {
                 // This is a root node
-                traverseGLTFNodes(gltfModel, gltfModel.nodes[i], glm::mat4(1.0f));
+                traverseGLTFNodes(gltfModel, gltfModel.nodes[i], glm::mat4(1.0f), prepared.data, log, errors);
+            }
+        }
+    }
+    
+    prepared.log = log.str();
+    prepared.errors = errors.str();
+    return true;
+}
+
+bool ModelRenderer::finishPreparedModel(PreparedModel& prepared) {
+    std::cout << prepared.log << std::flush;
+    std::cerr << prepared.errors << std::flush;
+    
+    ModelData& data = prepared.data;
+    if (prepared.parsed) {
+        const tinygltf::Model& gltfModel = *prepared.gltf;
+        
+        // Materials first, so textures get their GL names before the meshes
+        for (size_t i = 0; i < gltfModel.materials.size(); ++i) {
+            auto material = createMaterialFromGLTF(gltfModel, i, prepared.sourcePath);
+            if (material) {
+                data.materials.push_back(material);
             }
         }
+        
+        // Each mesh's levels go up before the mesh itself, as they were
+        // created. Use uploadAndClearCPUData to save memory on PS Vita
+        // Note: Bounds are preserved even after clearing CPU data
+        for (size_t i = 0; i < data.meshes.size(); ++i) {
+            for (auto& lod : data.meshLODs[i]) {
+                lod.mesh->uploadAndClearCPUData();
+            }
+            data.meshes[i]->uploadAndClearCPUData();
+        }
+        
+        loadGLTFAnimations(gltfModel, prepared.sourcePath);
     }
+    prepared.gltf.reset();
+    
+    if (data.meshes.empty()) {
+        std::cerr << "ModelRenderer: Failed to load model: " << prepared.modelPath << std::endl;
+        return false;
+    }
+    
+    data.modelPath = prepared.modelPath;
+    data.modelName = getFileName(prepared.modelPath);
+    data.isLoaded = true;
+    meshCache[prepared.modelPath] = std::make_shared<ModelData>(data);
+    std::cout << "ModelRenderer: Cached model: " << prepared.modelPath << std::endl;
+    return true;
+}
+
+void ModelRenderer::loadGLTFAnimations(const tinygltf::Model& gltfModel, const std::string& modelPath) {
+    std::string modelName = getFileName(modelPath);
     
     // Extract skeletons from skins
     auto& animManager = AnimationManager::getInstance();
@@ -361,16 +441,15 @@ bool ModelRenderer::loadGLTFModel(const std::string& modelPath) {
         
         animManager.loadAnimationClip(modelPath, static_cast<int>(i), targetSkeleton, animName);
     }
-    
-    return !modelData.meshes.empty();
 }
 
-std::shared_ptr<Mesh> ModelRenderer::createMeshFromGLTF(const tinygltf::Model& gltfModel, const tinygltf::Mesh& gltfMesh, const tinygltf::Primitive& primitive) {
+std::shared_ptr<Mesh> ModelRenderer::createMeshFromGLTF(const tinygltf::Model& gltfModel, const tinygltf::Mesh& gltfMesh, const tinygltf::Primitive& primitive,
+                                                        std::vector<MeshLOD>& lods, std::ostream& log, std::ostream& errors) {
     auto mesh = std::make_shared<Mesh>();
     
     // Get vertex positions (required)
     if (primitive.attributes.find("POSITION") == primitive.attributes.end()) {
-        std::cerr << "ModelRenderer: Primitive missing POSITION attribute" << std::endl;
+        errors << "ModelRenderer: Primitive missing POSITION attribute" << std::endl;
         return nullptr;
     }
     
@@ -516,17 +595,28 @@ std::shared_ptr<Mesh> ModelRenderer::createMeshFromGLTF(const tinygltf::Model& g
             if (!indices.empty()) {
                 mesh->setIndices(indices);
             }
-            // Use uploadAndClearCPUData to save memory on PS Vita
-            // Note: Bounds are preserved even after clearing CPU data
-            mesh->uploadAndClearCPUData();
+            // Rigged primitives keep per-vertex bone data; the layout still
+            // falls back to FULL if a joint index does not fit in a byte
+            bool skinned = boneWeights && (boneIndices || boneIndicesU8);
+            mesh->setVertexFormat(skinned ? VertexFormat::SKINNED_COMPACT : VertexFormat::STATIC_COMPACT);
+
+            // Cook the triangle order once at import; the mesh is shared
+            // through the model cache
+            if (primitive.mode == TINYGLTF_MODE_TRIANGLES || primitive.mode < 0) {
+                MeshOptimizer::Stats stats = mesh->optimize();
+                log << "ModelRenderer: Optimized mesh: " << stats.verticesBefore << " -> " << stats.verticesAfter
+                    << " vertices, " << stats.triangles << " triangles, ACMR " << stats.acmrBefore
+                    << " -> " << stats.acmrAfter << (stats.fitsIn16Bit ? ", 16-bit indices" : "") << std::endl;
+                generateLODs(*mesh, lods, log);
+            }
             return mesh;
         } else {
-            std::cerr << "ModelRenderer: No vertices created for mesh" << std::endl;
+            errors << "ModelRenderer: No vertices created for mesh" << std::endl;
             return nullptr;
         }
     }
     
-    std::cerr << "ModelRenderer: Failed to process mesh primitive" << std::endl;
+    errors << "ModelRenderer: Failed to process mesh primitive" << std::endl;
     return nullptr;
 }
 
@@ -738,6 +828,14 @@ bool ModelRenderer::loadBinaryModel(const std::string& modelPath) {
     modelData.meshes = binaryModel.createMeshes();
     modelData.materials = binaryModel.createMaterials();
     
+    modelData.meshLODs.resize(modelData.meshes.size());
+    for (size_t i = 0; i < modelData.meshes.size(); ++i) {
+        generateLODs(*modelData.meshes[i], modelData.meshLODs[i], std::cout);
+        for (auto& lod : modelData.meshLODs[i]) {
+            lod.mesh->uploadAndClearCPUData();
+        }
+    }
+    
     modelData.meshNodeTransforms.resize(modelData.meshes.size(), glm::mat4(1.0f));
     
     modelData.meshMaterialIndices.resize(modelData.meshes.size());
@@ -797,6 +895,103 @@ std::vector<std::string> ModelRenderer::discoverModels(const std::string& direct
     return models;
 }
 
+void ModelRenderer::generateLODs(const Mesh& mesh, std::vector<MeshLOD>& lods, std::ostream& log) {
+    lods.clear();
+    if (mesh.getTriangleCount() < LOD_MIN_TRIANGLES) return;
+    
+    glm::vec3 size = mesh.getBoundsSize();
+    float extent = std::max(size.x, std::max(size.y, size.z));
+    size_t previousTriangles = mesh.getTriangleCount();
+    float ratio = 1.0f;
+    
+    for (int level = 1; level <= LOD_LEVELS; ++level) {
+        ratio *= 0.5f;
+        float error = 0.0f;
+        auto lod = mesh.createSimplified(ratio, LOD_MAX_ERROR, &error);
+        // Stop once the error cap or locked seams/borders stall simplification
+        if (!lod || lod->getTriangleCount() > previousTriangles * 8 / 10) break;
+        
+        previousTriangles = lod->getTriangleCount();
+        
+        MeshLOD entry;
+        entry.mesh = lod;
+        entry.error = error * extent;
+        lods.push_back(entry);
+    }
+    
+    if (!lods.empty()) {
+        log << "ModelRenderer: Generated " << lods.size() << " LOD(s): " << mesh.getTriangleCount();
+        for (size_t i = 0; i < lods.size(); ++i) {
+            log << " -> " << lods[i].mesh->getTriangleCount();
+        }
+        log << " triangles" << std::endl;
+    }
+}
+
+size_t ModelRenderer::getLODCount(size_t meshIndex) const {
+    if (meshIndex >= modelData.meshes.size()) return 0;
+    size_t simplified = (meshIndex < modelData.meshLODs.size()) ? modelData.meshLODs[meshIndex].size() : 0;
+    return simplified + 1;
+}
+
+int ModelRenderer::getCurrentLOD(size_t meshIndex) const {
+    return (meshIndex < currentLODs.size()) ? currentLODs[meshIndex] : 0;
+}
+
+std::shared_ptr<Mesh> ModelRenderer::selectLOD(size_t meshIndex, const glm::mat4& modelMatrix, const CameraSnapshot& camera) {
+    if (meshIndex >= modelData.meshes.size()) return nullptr;
+    const std::shared_ptr<Mesh>& baseMesh = modelData.meshes[meshIndex];
+    if (!baseMesh || meshIndex >= modelData.meshLODs.size() || modelData.meshLODs[meshIndex].empty()) {
+        return baseMesh;
+    }
+    
+    const std::vector<MeshLOD>& lods = modelData.meshLODs[meshIndex];
+    if (currentLODs.size() != modelData.meshes.size()) {
+        currentLODs.assign(modelData.meshes.size(), 0);
+    }
+    int levelCount = static_cast<int>(lods.size()) + 1;
+    int level = std::min(currentLODs[meshIndex], levelCount - 1);
+    
+    if (forcedLOD >= 0) {
+        level = std::min(forcedLOD, levelCount - 1);
+    } else {
+        // Bounding sphere of the full-detail mesh in world space
+        float scale = std::max(glm::length(glm::vec3(modelMatrix[0])),
+                               std::max(glm::length(glm::vec3(modelMatrix[1])), glm::length(glm::vec3(modelMatrix[2]))));
+        glm::vec3 center = glm::vec3(modelMatrix * glm::vec4(baseMesh->getBoundsCenter(), 1.0f));
+        float radius = 0.5f * glm::length(baseMesh->getBoundsSize()) * scale;
+        
+        // Fraction of the viewport height covered by one world unit at the
+        // nearest point of the sphere
+        float unitToScreen = camera.projection[1][1] * 0.5f;
+        bool inside = false;
+        if (camera.projectionType == ProjectionType::PERSPECTIVE) {
+            float distance = glm::length(center - camera.position) - radius;
+            inside = (distance <= camera.nearPlane);
+            if (!inside) {
+                unitToScreen /= distance;
+            }
+        }
+        
+        if (inside) {
+            level = 0;
+        } else {
+            float threshold = LOD_SCREEN_ERROR * lodBias;
+            float upper = threshold * (1.0f + LOD_HYSTERESIS);
+            float lower = threshold * (1.0f - LOD_HYSTERESIS);
+            while (level > 0 && lods[level - 1].error * scale * unitToScreen > upper) {
+                --level;
+            }
+            while (level + 1 < levelCount && lods[level].error * scale * unitToScreen <= lower) {
+                ++level;
+            }
+        }
+    }
+    
+    currentLODs[meshIndex] = level;
+    return (level == 0) ? baseMesh : lods[level - 1].mesh;
+}
+
 void ModelRenderer::drawInspector() {
 #ifdef EDITOR_BUILD
     if (ImGui::CollapsingHeader("Model Renderer", ImGuiTreeNodeFlags_DefaultOpen)) {
@@ -806,6 +1001,12 @@ void ModelRenderer::drawInspector() {
         if (modelData.isLoaded) {
             ImGui::Text("Meshes: %zu", modelData.meshes.size());
             ImGui::Text("Materials: %zu", modelData.materials.size());
+            
+            for (size_t i = 0; i < modelData.meshes.size(); ++i) {
+                ImGui::Text("Mesh %zu: LOD %d of %zu", i, getCurrentLOD(i), getLODCount(i));
+            }
+            ImGui::SliderInt("Forced LOD", &forcedLOD, -1, LOD_LEVELS);
+            ImGui::SliderFloat("LOD Bias", &lodBias, 0.25f, 8.0f);
         }
         
         ImGui::Checkbox("Cast Shadows", &castShadows);
@@ -6,8 +6,8 @@
 #include "Rendering/Mesh.h"
 #include "Rendering/Material.h"
 #include "Rendering/Shader.h"
+#include "Core/Log.h"
 #include <algorithm>
-#include <iostream>
 
 // Bullet includes
 #include <btBulletDynamicsCommon.h>
@@ -248,14 +248,14 @@ void PickupZoneComponent::performCollisionDetection() {
                 // Get the node name as the object identifier
                 std::string objectTag = physicsComp->getOwner()->getName();
                 
-                // Debug output
-                std::cout << "PICKUP ZONE: Checking object '" << objectTag << "' at distance " << distance << " (radius: " << detectionRadius << ")" << std::endl;
+                LOG_TRACE("PICKUP ZONE: Checking object '%s' at distance %f (radius: %f)", objectTag.c_str(), distance,
+                          detectionRadius);
                 
                 // Check if this object matches our detection tags
                 if (detectionTags.empty() || 
                     std::find(detectionTags.begin(), detectionTags.end(), objectTag) != detectionTags.end()) {
                     objectsInZone.push_back(objectTag);
-                    std::cout << "PICKUP ZONE: Object '" << objectTag << "' added to zone!" << std::endl;
+                    LOG_TRACE("PICKUP ZONE: Object '%s' added to zone!", objectTag.c_str());
                 }
             }
         }
@@ -267,7 +267,7 @@ void PickupZoneComponent::handleCollisionEvents() {
     for (const auto& objectTag : objectsInZone) {
         if (std::find(previousObjectsInZone.begin(), previousObjectsInZone.end(), objectTag) == previousObjectsInZone.end()) {
             // Object entered the zone
-            std::cout << "PICKUP ZONE: Object '" << objectTag << "' ENTERED pickup zone!" << std::endl;
+            LOG_VERBOSE("PICKUP ZONE: Object '%s' ENTERED pickup zone!", objectTag.c_str());
             if (onEnterCallback) {
                 onEnterCallback(objectTag);
             }
@@ -278,7 +278,7 @@ void PickupZoneComponent::handleCollisionEvents() {
     for (const auto& objectTag : previousObjectsInZone) {
         if (std::find(objectsInZone.begin(), objectsInZone.end(), objectTag) == objectsInZone.end()) {
             // Object exited the zone
-            std::cout << "PICKUP ZONE: Object '" << objectTag << "' EXITED pickup zone!" << std::endl;
+            LOG_VERBOSE("PICKUP ZONE: Object '%s' EXITED pickup zone!", objectTag.c_str());
             if (onExitCallback) {
                 onExitCallback(objectTag);
             }
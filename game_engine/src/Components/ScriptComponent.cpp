@@ -10,10 +10,16 @@
 #include "Components/SkyboxComponent.h"
 #include "Rendering/AnimationManager.h"
 #include "Scene/SceneNode.h"
+#include "Scene/PrefabLibrary.h"
 #include "Input/InputManager.h"
 #include "Physics/PhysicsManager.h"
 #include "Rendering/Renderer.h"
 #include "Core/Transform.h"
+#include "Core/LuaMath.h"
+#include "Core/Profiler.h"
+#include "Core/Stats.h"
+#include "Core/Log.h"
+#include <algorithm>
 #include <iostream>
 #include <filesystem>
 #include <chrono>
@@ -42,8 +48,77 @@ namespace GameEngine {
 // Static map for editor UI buffers - declared at namespace level to persist
 static std::map<ScriptComponent*, std::string> scriptPathBuffers;
 
+// Bindings read the calling component from _currentScriptComponent; point it at
+// this component for the duration of a call and restore the previous value so
+// nested calls (callNodeScriptFunction) unwind correctly
+class CurrentScriptScope {
+public:
+    CurrentScriptScope(lua_State* L, ScriptComponent* component) : L(L) {
+        lua_getglobal(L, "_currentScriptComponent");
+        previous = lua_touserdata(L, -1);
+        lua_pop(L, 1);
+        lua_pushlightuserdata(L, component);
+        lua_setglobal(L, "_currentScriptComponent");
+    }
+    ~CurrentScriptScope() {
+        if (previous) {
+            lua_pushlightuserdata(L, previous);
+        } else {
+            lua_pushnil(L);
+        }
+        lua_setglobal(L, "_currentScriptComponent");
+    }
+private:
+    lua_State* L;
+    void* previous;
+};
+
+// Moves a node to a WORLD position (converted into its parent's space) and
+// pushes the change into any collision shapes in its subtree
+static void setNodeWorldPosition(SceneNode* node, const glm::vec3& worldPos) {
+    auto parent = node->getParent();
+    if (parent) {
+        glm::mat4 parentWorldInv = glm::inverse(parent->getWorldMatrix());
+        node->getTransform().setPosition(glm::vec3(parentWorldInv * glm::vec4(worldPos, 1.0f)));
+    } else {
+        // No parent - world position equals local position
+        node->getTransform().setPosition(worldPos);
+    }
+    
+    std::function<void(SceneNode*)> updatePhysicsRecursive = [&](SceneNode* n) {
+        auto physicsComp = n->getComponent<PhysicsComponent>();
+        if (physicsComp) {
+            physicsComp->forceUpdateCollisionShape();
+        }
+        for (size_t i = 0; i < n->getChildCount(); ++i) {
+            auto child = n->getChild(i);
+            if (child) {
+                updatePhysicsRecursive(child.get());
+            }
+        }
+    };
+    updatePhysicsRecursive(node);
+}
+
+// Points a node at a WORLD position, converting the target into its parent's space
+static void lookAtWorldPosition(SceneNode* node, const glm::vec3& targetPosition, const glm::vec3& up) {
+    glm::vec3 localTargetPosition = targetPosition;
+    auto parent = node->getParent();
+    if (parent) {
+        glm::mat4 parentWorldInv = glm::inverse(parent->getWorldMatrix());
+        localTargetPosition = glm::vec3(parentWorldInv * glm::vec4(targetPosition, 1.0f));
+    }
+    node->getTransform().lookAt(localTargetPosition, up);
+}
+
 ScriptComponent::ScriptComponent()
     : luaState(nullptr)
+    , envRef(LUA_NOREF)
+    , startRef(LUA_NOREF)
+    , updateRef(LUA_NOREF)
+    , renderRef(LUA_NOREF)
+    , destroyRef(LUA_NOREF)
+    , profileZoneName("ScriptComponent::update")
     , scriptLoaded(false)
     , scriptStarted(false)
     , pauseExempt(false)
@@ -52,6 +127,8 @@ ScriptComponent::ScriptComponent()
 }
 
 ScriptComponent::~ScriptComponent() {
+    // Menu actions and callbacks this script registered die with it
+    MenuManager::getInstance().releaseScript(this);
     cleanupLuaState();
     
 #ifdef EDITOR_BUILD
@@ -89,26 +166,16 @@ void ScriptComponent::start() {
         return;
     }
     
-    if (hasScriptFunction("start")) {
+    if (startRef != LUA_NOREF) {
 #ifdef VITA_BUILD
         printf("ScriptComponent: Found start function, calling it\n");
 #else
         std::cout << "ScriptComponent: Found start function, calling it" << std::endl;
 #endif
-        callScriptFunction("start");
+        // Errors are reported (and popped) by callFunctionRef; the shared VM's
+        // stack may hold a caller's values here, so don't inspect it
+        callFunctionRef(startRef, "start");
         scriptStarted = true;
-        
-        if (luaState) {
-            const char* error = lua_tostring(luaState, -1);
-            if (error) {
-#ifdef VITA_BUILD
-                printf("ScriptComponent: Lua error in start(): %s\n", error);
-#else
-                std::cout << "ScriptComponent: Lua error in start(): " << error << std::endl;
-#endif
-                lua_pop(luaState, 1); // Remove error message from stack
-            }
-        }
 #ifdef VITA_BUILD
         printf("ScriptComponent: Called start() for script: %s\n", scriptPath.c_str());
 #else
@@ -128,17 +195,24 @@ void ScriptComponent::update(float deltaTime) {
         return;
     }
     
-    // Debug: Print if this is a pause-exempt script being updated while paused
-    static int debugFrameCount = 0;
     if (pauseExempt && MenuManager::getInstance().isGamePaused()) {
-        if (++debugFrameCount % 60 == 0) {  // Print every 60 frames
-            std::cout << "ScriptComponent: Updating pause-exempt script: " << scriptPath 
-                      << " (pauseExempt=" << (pauseExempt ? "true" : "false") << ")" << std::endl;
-        }
+        LOG_TRACE("ScriptComponent: Updating pause-exempt script while paused: %s", scriptPath.c_str());
+    }
+    
+    if (updateRef == LUA_NOREF) {
+        return;
     }
     
-    if (hasScriptFunction("update")) {
-        callScriptFunction("update", deltaTime);
+    PROFILE_ZONE(profileZoneName);
+    auto begin = std::chrono::high_resolution_clock::now();
+    callFunctionRef(updateRef, "update", deltaTime);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+    
+    timings.updateCalls++;
+    timings.lastUpdateMs = ms;
+    timings.totalUpdateMs += ms;
+    if (ms > timings.maxUpdateMs) {
+        timings.maxUpdateMs = ms;
     }
 }
 
@@ -147,8 +221,8 @@ void ScriptComponent::render(Renderer& renderer) {
         return;
     }
     
-    if (hasScriptFunction("render")) {
-        callScriptFunction("render");
+    if (renderRef != LUA_NOREF) {
+        callFunctionRef(renderRef, "render");
     }
 }
 
@@ -157,8 +231,8 @@ void ScriptComponent::destroy() {
         return;
     }
     
-    if (hasScriptFunction("destroy")) {
-        callScriptFunction("destroy");
+    if (destroyRef != LUA_NOREF) {
+        callFunctionRef(destroyRef, "destroy");
         std::cout << "ScriptComponent: Called destroy() for script: " << scriptPath << std::endl;
     }
     
@@ -177,7 +251,23 @@ bool ScriptComponent::loadScript(const std::string& scriptPath) {
         return false;
     }
     
-    int result = luaL_dofile(luaState, scriptPath.c_str());
+    if (!ScriptManager::getInstance().loadCachedChunk(scriptPath)) {
+        handleLuaError("loadScript");
+        cleanupLuaState();
+        return false;
+    }
+    
+    // Run the chunk with this component's environment as its _ENV
+    lua_rawgeti(luaState, LUA_REGISTRYINDEX, envRef);
+    if (!lua_setupvalue(luaState, -2, 1)) {
+        lua_pop(luaState, 1);
+    }
+    
+    int result;
+    {
+        CurrentScriptScope scope(luaState, this);
+        result = lua_pcall(luaState, 0, 0, 0);
+    }
     if (result != LUA_OK) {
         handleLuaError("loadScript");
         cleanupLuaState();
@@ -185,9 +275,14 @@ bool ScriptComponent::loadScript(const std::string& scriptPath) {
     }
     
     this->scriptPath = scriptPath;
+    profileZoneName = Profiler::internName(scriptPath);
     scriptLoaded = true;
     scriptStarted = false;
     
+    resolveFunctionRefs();
+    resetTimings();
+    ScriptManager::getInstance().registerScriptComponent(this);
+    
     std::cout << "ScriptComponent: Successfully loaded script: " << scriptPath 
               << " (pauseExempt=" << (pauseExempt ? "true" : "false") << ")" << std::endl;
     return true;
@@ -199,6 +294,7 @@ void ScriptComponent::reloadScript() {
     }
     
     std::cout << "ScriptComponent: Reloading script: " << scriptPath << std::endl;
+    ScriptManager::getInstance().invalidateCachedChunk(scriptPath);
     loadScript(scriptPath);
 }
 
@@ -213,14 +309,12 @@ void ScriptComponent::callScriptFunction(const std::string& functionName) {
         return;
     }
     
-    // Get the function from Lua
-    lua_getglobal(luaState, functionName.c_str());
-    if (!lua_isfunction(luaState, -1)) {
-        lua_pop(luaState, 1); // Remove non-function value
+    if (!pushScriptFunction(functionName)) {
         return;
     }
     
     // Call the function
+    CurrentScriptScope scope(luaState, this);
     int result = lua_pcall(luaState, 0, 0, 0);
     if (result != LUA_OK) {
         handleLuaError("callScriptFunction: " + functionName);
@@ -232,10 +326,7 @@ void ScriptComponent::callScriptFunction(const std::string& functionName, float
         return;
     }
     
-    // Get the function from Lua
-    lua_getglobal(luaState, functionName.c_str());
-    if (!lua_isfunction(luaState, -1)) {
-        lua_pop(luaState, 1); // Remove non-function value
+    if (!pushScriptFunction(functionName)) {
         return;
     }
     
@@ -243,19 +334,59 @@ void ScriptComponent::callScriptFunction(const std::string& functionName, float
     lua_pushnumber(luaState, param);
     
     // Call the function
+    CurrentScriptScope scope(luaState, this);
+    int result = lua_pcall(luaState, 1, 0, 0);
+    if (result != LUA_OK) {
+        handleLuaError("callScriptFunction: " + functionName);
+    }
+}
+
+void ScriptComponent::callScriptFunction(const std::string& functionName, const std::string& param) {
+    if (!luaState || !scriptLoaded) {
+        return;
+    }
+    
+    if (!pushScriptFunction(functionName)) {
+        return;
+    }
+    
+    lua_pushstring(luaState, param.c_str());
+    
+    CurrentScriptScope scope(luaState, this);
     int result = lua_pcall(luaState, 1, 0, 0);
     if (result != LUA_OK) {
         handleLuaError("callScriptFunction: " + functionName);
     }
 }
 
+void ScriptComponent::callScriptFunction(const std::string& functionName, const std::string& param1, const std::string& param2) {
+    if (!luaState || !scriptLoaded) {
+        return;
+    }
+    
+    if (!pushScriptFunction(functionName)) {
+        return;
+    }
+    
+    lua_pushstring(luaState, param1.c_str());
+    lua_pushstring(luaState, param2.c_str());
+    
+    CurrentScriptScope scope(luaState, this);
+    int result = lua_pcall(luaState, 2, 0, 0);
+    if (result != LUA_OK) {
+        handleLuaError("callScriptFunction: " + functionName);
+    }
+}
+
 void ScriptComponent::setScriptProperty(const std::string& name, const std::string& value) {
     if (!luaState || !scriptLoaded) {
         return;
     }
     
+    lua_rawgeti(luaState, LUA_REGISTRYINDEX, envRef);
     lua_pushstring(luaState, value.c_str());
-    lua_setglobal(luaState, name.c_str());
+    lua_setfield(luaState, -2, name.c_str());
+    lua_pop(luaState, 1);
 }
 
 std::string ScriptComponent::getScriptProperty(const std::string& name) const {
@@ -263,14 +394,15 @@ std::string ScriptComponent::getScriptProperty(const std::string& name) const {
         return "";
     }
     
-    lua_getglobal(luaState, name.c_str());
+    lua_rawgeti(luaState, LUA_REGISTRYINDEX, envRef);
+    lua_getfield(luaState, -1, name.c_str());
     if (lua_isstring(luaState, -1)) {
         std::string value = lua_tostring(luaState, -1);
-        lua_pop(luaState, 1);
+        lua_pop(luaState, 2);
         return value;
     }
     
-    lua_pop(luaState, 1);
+    lua_pop(luaState, 2);
     return "";
 }
 
@@ -279,10 +411,70 @@ bool ScriptComponent::hasScriptFunction(const std::string& functionName) {
         return false;
     }
     
-    lua_getglobal(luaState, functionName.c_str());
-    bool isFunction = lua_isfunction(luaState, -1);
+    if (!pushScriptFunction(functionName)) {
+        return false;
+    }
     lua_pop(luaState, 1);
-    return isFunction;
+    return true;
+}
+
+void ScriptComponent::resolveFunctionRefs() {
+    releaseFunctionRefs();
+    
+    struct { const char* name; int* ref; } callbacks[] = {
+        { "start", &startRef },
+        { "update", &updateRef },
+        { "render", &renderRef },
+        { "destroy", &destroyRef },
+    };
+    for (auto& callback : callbacks) {
+        if (pushScriptFunction(callback.name)) {
+            *callback.ref = luaL_ref(luaState, LUA_REGISTRYINDEX);
+        }
+    }
+}
+
+void ScriptComponent::releaseFunctionRefs() {
+    int* refs[] = { &startRef, &updateRef, &renderRef, &destroyRef };
+    bool alive = ScriptManager::getInstance().isComponentLuaStateAlive(luaState);
+    for (int* ref : refs) {
+        if (*ref != LUA_NOREF && alive) {
+            luaL_unref(luaState, LUA_REGISTRYINDEX, *ref);
+        }
+        *ref = LUA_NOREF;
+    }
+}
+
+void ScriptComponent::callFunctionRef(int ref, const char* functionName) {
+    lua_rawgeti(luaState, LUA_REGISTRYINDEX, ref);
+    
+    CurrentScriptScope scope(luaState, this);
+    if (lua_pcall(luaState, 0, 0, 0) != LUA_OK) {
+        handleLuaError(std::string("callScriptFunction: ") + functionName);
+    }
+}
+
+void ScriptComponent::callFunctionRef(int ref, const char* functionName, float param) {
+    lua_rawgeti(luaState, LUA_REGISTRYINDEX, ref);
+    lua_pushnumber(luaState, param);
+    
+    CurrentScriptScope scope(luaState, this);
+    if (lua_pcall(luaState, 1, 0, 0) != LUA_OK) {
+        handleLuaError(std::string("callScriptFunction: ") + functionName);
+    }
+}
+
+bool ScriptComponent::pushScriptFunction(const std::string& functionName) {
+    // Only the script's own environment is searched, not the shared _G
+    lua_rawgeti(luaState, LUA_REGISTRYINDEX, envRef);
+    lua_pushstring(luaState, functionName.c_str());
+    lua_rawget(luaState, -2);
+    lua_remove(luaState, -2);
+    if (!lua_isfunction(luaState, -1)) {
+        lua_pop(luaState, 1);
+        return false;
+    }
+    return true;
 }
 
 void ScriptComponent::handleLuaError(const std::string& operation) {
@@ -301,26 +493,46 @@ void ScriptComponent::handleLuaError(const std::string& operation) {
 }
 
 bool ScriptComponent::initializeLuaState() {
-    luaState = luaL_newstate();
+    luaState = ScriptManager::getInstance().getComponentLuaState();
     if (!luaState) {
-        std::cerr << "ScriptComponent: Failed to create Lua state" << std::endl;
+        std::cerr << "ScriptComponent: Failed to get component Lua state" << std::endl;
         return false;
     }
     
-    // Open standard libraries
-    luaL_openlibs(luaState);
+    // Engine bindings are registered once per VM into the shared _G
+    lua_getfield(luaState, LUA_REGISTRYINDEX, "_scriptComponentBindings");
+    bool bound = lua_toboolean(luaState, -1) != 0;
+    lua_pop(luaState, 1);
+    if (!bound) {
+        bindEngineToLua();
+        lua_pushboolean(luaState, 1);
+        lua_setfield(luaState, LUA_REGISTRYINDEX, "_scriptComponentBindings");
+    }
     
-    // Bind engine systems to Lua
-    bindEngineToLua();
+    // Per-script environment: globals the script defines stay private to it,
+    // lookups of anything else fall through to _G
+    lua_newtable(luaState);
+    lua_newtable(luaState);
+    lua_pushglobaltable(luaState);
+    lua_setfield(luaState, -2, "__index");
+    lua_setmetatable(luaState, -2);
+    envRef = luaL_ref(luaState, LUA_REGISTRYINDEX);
     
     return true;
 }
 
 void ScriptComponent::cleanupLuaState() {
+    ScriptManager::getInstance().unregisterScriptComponent(this);
+    releaseFunctionRefs();
+    
     if (luaState) {
-        lua_close(luaState);
+        // The VM may already be gone if ScriptManager shut down first
+        if (envRef != LUA_NOREF && ScriptManager::getInstance().isComponentLuaStateAlive(luaState)) {
+            luaL_unref(luaState, LUA_REGISTRYINDEX, envRef);
+        }
         luaState = nullptr;
     }
+    envRef = LUA_NOREF;
     scriptLoaded = false;
     scriptStarted = false;
 }
@@ -330,6 +542,9 @@ void ScriptComponent::bindEngineToLua() {
         return;
     }
 
+    // Native vec3/quat/mat4 types used by the bindings below
+    LuaMath::registerTypes(luaState);
+    
     // Bind common functions first
     bindCommonFunctions();
 
@@ -342,6 +557,7 @@ void ScriptComponent::bindEngineToLua() {
     // Bind Area3D component system
     bindArea3DToLua();
     
+    bindNodeHandlesToLua();
     bindInputToLua();
     bindCameraToLua();
     // bindPhysicsToLua();
@@ -350,19 +566,18 @@ void ScriptComponent::bindEngineToLua() {
     bindAnimationToLua();
     bindSoundToLua();
     bindSkyboxToLua();
+    bindProfilerToLua();
     
     // Bind MenuManager
     MenuManager::getInstance().bindToLua(luaState);
 }
 
 void ScriptComponent::bindTransformToLua() {
-    if (!luaState || !owner) {
+    if (!luaState) {
         return;
     }
     
-    // Store this component pointer in a global variable for the functions to access
-    lua_pushlightuserdata(luaState, this);
-    lua_setglobal(luaState, "_currentScriptComponent");
+    // _currentScriptComponent is set around every call into a script (see CurrentScriptScope)
     
     // Use global functions without upvalues
     lua_pushcfunction(luaState, [](lua_State* L) -> int {
@@ -370,10 +585,11 @@ void ScriptComponent::bindTransformToLua() {
         ScriptComponent* self = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
         lua_pop(L, 1); // Remove the userdata from stack
         
-        if (self && self->owner && lua_isnumber(L, 1) && lua_isnumber(L, 2) && lua_isnumber(L, 3)) {
-            float x = lua_tonumber(L, 1);
-            float y = lua_tonumber(L, 2);
-            float z = lua_tonumber(L, 3);
+        glm::vec3 args;
+        if (self && self->owner && LuaMath::testVec3(L, 1, args)) {
+            float x = args.x;
+            float y = args.y;
+            float z = args.z;
             self->owner->getTransform().setPosition(glm::vec3(x, y, z));
         }
         return 0;
@@ -385,10 +601,11 @@ void ScriptComponent::bindTransformToLua() {
         ScriptComponent* self = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
         lua_pop(L, 1); // Remove the userdata from stack
         
-        if (self && self->owner && lua_isnumber(L, 1) && lua_isnumber(L, 2) && lua_isnumber(L, 3)) {
-            float x = lua_tonumber(L, 1);
-            float y = lua_tonumber(L, 2);
-            float z = lua_tonumber(L, 3);
+        glm::vec3 args;
+        if (self && self->owner && LuaMath::testVec3(L, 1, args)) {
+            float x = args.x;
+            float y = args.y;
+            float z = args.z;
             self->owner->getTransform().setEulerAngles(glm::vec3(x, y, z));
         }
         return 0;
@@ -424,10 +641,11 @@ void ScriptComponent::bindTransformToLua() {
                 ScriptComponent* self = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
                 lua_pop(L, 1);
                 
-                if (self && self->owner && lua_isnumber(L, 1) && lua_isnumber(L, 2) && lua_isnumber(L, 3)) {
-                    float x = lua_tonumber(L, 1);
-                    float y = lua_tonumber(L, 2);
-                    float z = lua_tonumber(L, 3);
+                glm::vec3 args;
+                if (self && self->owner && LuaMath::testVec3(L, 1, args)) {
+                    float x = args.x;
+                    float y = args.y;
+                    float z = args.z;
                     
                     glm::vec3 currentPos = self->owner->getTransform().getPosition();
                     self->owner->getTransform().setPosition(currentPos + glm::vec3(x, y, z));
@@ -442,10 +660,11 @@ void ScriptComponent::bindTransformToLua() {
                 ScriptComponent* self = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
                 lua_pop(L, 1);
                 
-                if (self && self->owner && lua_isnumber(L, 1) && lua_isnumber(L, 2) && lua_isnumber(L, 3)) {
-                    float x = lua_tonumber(L, 1);
-                    float y = lua_tonumber(L, 2);
-                    float z = lua_tonumber(L, 3);
+                glm::vec3 args;
+                if (self && self->owner && LuaMath::testVec3(L, 1, args)) {
+                    float x = args.x;
+                    float y = args.y;
+                    float z = args.z;
                     self->owner->getTransform().setPosition(glm::vec3(x, y, z));
                 }
                 return 0;
@@ -460,10 +679,7 @@ void ScriptComponent::bindTransformToLua() {
                 
                 if (self && self->owner) {
                     glm::vec3 pos = self->owner->getTransform().getPosition();
-                    lua_pushnumber(L, pos.x);
-                    lua_pushnumber(L, pos.y);
-                    lua_pushnumber(L, pos.z);
-                    return 3;
+                    return LuaMath::returnVec3(L, pos, 1);
                 }
                 lua_pushnil(L);
                 lua_pushnil(L);
@@ -508,10 +724,11 @@ void ScriptComponent::bindTransformToLua() {
                 ScriptComponent* self = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
                 lua_pop(L, 1);
                 
-                if (self && self->owner && self->owner->getParent() && lua_isnumber(L, 1) && lua_isnumber(L, 2) && lua_isnumber(L, 3)) {
-                    float x = lua_tonumber(L, 1);
-                    float y = lua_tonumber(L, 2);
-                    float z = lua_tonumber(L, 3);
+                glm::vec3 args;
+                if (self && self->owner && self->owner->getParent() && LuaMath::testVec3(L, 1, args)) {
+                    float x = args.x;
+                    float y = args.y;
+                    float z = args.z;
                     
                     glm::vec3 currentPos = self->owner->getParent()->getTransform().getPosition();
                     self->owner->getParent()->getTransform().setPosition(currentPos + glm::vec3(x, y, z));
@@ -526,10 +743,11 @@ void ScriptComponent::bindTransformToLua() {
                 ScriptComponent* self = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
                 lua_pop(L, 1);
                 
-                if (self && self->owner && self->owner->getParent() && lua_isnumber(L, 1) && lua_isnumber(L, 2) && lua_isnumber(L, 3)) {
-                    float x = lua_tonumber(L, 1);
-                    float y = lua_tonumber(L, 2);
-                    float z = lua_tonumber(L, 3);
+                glm::vec3 args;
+                if (self && self->owner && self->owner->getParent() && LuaMath::testVec3(L, 1, args)) {
+                    float x = args.x;
+                    float y = args.y;
+                    float z = args.z;
                     self->owner->getParent()->getTransform().setPosition(glm::vec3(x, y, z));
                 }
                 return 0;
@@ -544,10 +762,7 @@ void ScriptComponent::bindTransformToLua() {
                 
                 if (self && self->owner && self->owner->getParent()) {
                     glm::vec3 pos = self->owner->getParent()->getTransform().getPosition();
-                    lua_pushnumber(L, pos.x);
-                    lua_pushnumber(L, pos.y);
-                    lua_pushnumber(L, pos.z);
-                    return 3;
+                    return LuaMath::returnVec3(L, pos, 1);
                 }
                 lua_pushnil(L);
                 lua_pushnil(L);
@@ -618,10 +833,7 @@ void ScriptComponent::bindTransformToLua() {
                         if (self && self->owner && self->owner->getParent() && self->owner->getParent()->getParent()) {
                             auto grandparent = self->owner->getParent()->getParent();
                             glm::vec3 pos = grandparent->getTransform().getPosition();
-                            lua_pushnumber(L, pos.x);
-                            lua_pushnumber(L, pos.y);
-                            lua_pushnumber(L, pos.z);
-                            return 3;
+                            return LuaMath::returnVec3(L, pos, 1);
                         }
                         lua_pushnil(L);
                         lua_pushnil(L);
@@ -645,6 +857,253 @@ void ScriptComponent::bindTransformToLua() {
     lua_setglobal(luaState, "getParent");
 }
 
+// Userdata wrapper around a NodeHandle; methods resolve the node in O(1) and
+// quietly do nothing (or return zeros/nil) once the node has been destroyed.
+// Vector getters return x, y, z, or fill a vec3 passed as their last argument
+static const char* NODE_HANDLE_METATABLE = "SceneNodeHandle";
+
+static void pushNodeHandle(lua_State* L, SceneNode* node) {
+    if (!node) {
+        lua_pushnil(L);
+        return;
+    }
+    NodeHandle* handle = static_cast<NodeHandle*>(lua_newuserdata(L, sizeof(NodeHandle)));
+    *handle = node->getHandle();
+    luaL_setmetatable(L, NODE_HANDLE_METATABLE);
+}
+
+static SceneNode* checkNodeHandle(lua_State* L, int index) {
+    NodeHandle* handle = static_cast<NodeHandle*>(luaL_checkudata(L, index, NODE_HANDLE_METATABLE));
+    return SceneNode::resolve(*handle);
+}
+
+void ScriptComponent::bindNodeHandlesToLua() {
+    if (!luaState) {
+        return;
+    }
+    
+    static const luaL_Reg nodeMethods[] = {
+        { "isValid", [](lua_State* L) -> int {
+            lua_pushboolean(L, checkNodeHandle(L, 1) != nullptr);
+            return 1;
+        }},
+        { "getName", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            if (node) {
+                lua_pushstring(L, node->getName().c_str());
+            } else {
+                lua_pushnil(L);
+            }
+            return 1;
+        }},
+        // WORLD position, same convention as getNodePosition/setNodePosition
+        { "getPosition", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            return LuaMath::returnVec3(L, node ? glm::vec3(node->getWorldMatrix()[3]) : glm::vec3(0.0f), 2);
+        }},
+        { "setPosition", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            glm::vec3 position = LuaMath::checkVec3(L, 2);
+            if (node) {
+                setNodeWorldPosition(node, position);
+            }
+            return 0;
+        }},
+        { "getLocalPosition", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            return LuaMath::returnVec3(L, node ? node->getTransform().getPosition() : glm::vec3(0.0f), 2);
+        }},
+        { "setLocalPosition", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            glm::vec3 position = LuaMath::checkVec3(L, 2);
+            if (node) {
+                node->getTransform().setPosition(position);
+            }
+            return 0;
+        }},
+        { "getRotation", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            return LuaMath::returnVec3(L, node ? node->getTransform().getEulerAngles() : glm::vec3(0.0f), 2);
+        }},
+        { "setRotation", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            glm::vec3 rotation = LuaMath::checkVec3(L, 2);
+            if (node) {
+                node->getTransform().setEulerAngles(rotation);
+            }
+            return 0;
+        }},
+        { "getRotationQuat", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            return LuaMath::returnQuat(L, node ? node->getTransform().getRotation() : glm::quat(1.0f, 0.0f, 0.0f, 0.0f), 2);
+        }},
+        { "setRotationQuat", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            glm::quat rotation = LuaMath::checkQuat(L, 2);
+            if (node) {
+                node->getTransform().setRotation(rotation);
+            }
+            return 0;
+        }},
+        { "getWorldMatrix", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            return LuaMath::returnMat4(L, node ? node->getWorldMatrix() : glm::mat4(1.0f), 2);
+        }},
+        { "getScale", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            return LuaMath::returnVec3(L, node ? node->getTransform().getScale() : glm::vec3(1.0f), 2);
+        }},
+        { "setScale", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            glm::vec3 scale = LuaMath::checkVec3(L, 2);
+            if (node) {
+                node->getTransform().setScale(scale);
+            }
+            return 0;
+        }},
+        // lookAt(target [, up]) in WORLD space; target/up are vec3s or three numbers each
+        { "lookAt", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            glm::vec3 target = LuaMath::checkVec3(L, 2);
+            glm::vec3 up(0.0f, 1.0f, 0.0f);
+            int upIndex = LuaMath::toVec3(L, 2) ? 3 : 5;
+            if (lua_gettop(L) >= upIndex) {
+                up = LuaMath::checkVec3(L, upIndex);
+            }
+            if (node) {
+                lookAtWorldPosition(node, target, up);
+            }
+            return 0;
+        }},
+        { "getVelocity", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            auto physicsComp = node ? node->getComponent<PhysicsComponent>() : nullptr;
+            return LuaMath::returnVec3(L, physicsComp ? physicsComp->getLinearVelocity() : glm::vec3(0.0f), 2);
+        }},
+        { "setVelocity", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            glm::vec3 velocity = LuaMath::checkVec3(L, 2);
+            auto physicsComp = node ? node->getComponent<PhysicsComponent>() : nullptr;
+            if (physicsComp) {
+                physicsComp->setLinearVelocity(velocity);
+            }
+            return 0;
+        }},
+        { "setAngularVelocity", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            glm::vec3 velocity = LuaMath::checkVec3(L, 2);
+            auto physicsComp = node ? node->getComponent<PhysicsComponent>() : nullptr;
+            if (physicsComp) {
+                physicsComp->setAngularVelocity(velocity);
+            }
+            return 0;
+        }},
+        { "setAngularFactor", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            glm::vec3 factor = LuaMath::checkVec3(L, 2);
+            auto physicsComp = node ? node->getComponent<PhysicsComponent>() : nullptr;
+            if (physicsComp) {
+                physicsComp->setAngularFactor(factor);
+                if (factor == glm::vec3(0.0f)) {
+                    physicsComp->setAngularVelocity(glm::vec3(0.0f));
+                }
+            }
+            return 0;
+        }},
+        { "isVisible", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            lua_pushboolean(L, node && node->isVisible());
+            return 1;
+        }},
+        { "setVisible", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            if (node) {
+                node->setVisible(lua_toboolean(L, 2) != 0);
+            }
+            return 0;
+        }},
+        { "isActive", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            lua_pushboolean(L, node && node->isActive());
+            return 1;
+        }},
+        { "setActive", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            if (node) {
+                node->setActive(lua_toboolean(L, 2) != 0);
+            }
+            return 0;
+        }},
+        { "getParent", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            pushNodeHandle(L, node ? node->getParent() : nullptr);
+            return 1;
+        }},
+        { "getChild", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            const char* childName = luaL_checkstring(L, 2);
+            pushNodeHandle(L, node ? node->findByName(childName, true).get() : nullptr);
+            return 1;
+        }},
+        // callFunction(name [, param]) on the node's ScriptComponent
+        { "callFunction", [](lua_State* L) -> int {
+            SceneNode* node = checkNodeHandle(L, 1);
+            const char* functionName = luaL_checkstring(L, 2);
+            auto scriptComp = node ? node->getComponent<ScriptComponent>() : nullptr;
+            if (scriptComp) {
+                if (lua_gettop(L) >= 3) {
+                    scriptComp->callScriptFunction(functionName, static_cast<float>(luaL_checknumber(L, 3)));
+                } else {
+                    scriptComp->callScriptFunction(functionName);
+                }
+            }
+            return 0;
+        }},
+        { nullptr, nullptr }
+    };
+    
+    luaL_newmetatable(luaState, NODE_HANDLE_METATABLE);
+    
+    lua_newtable(luaState);
+    luaL_setfuncs(luaState, nodeMethods, 0);
+    lua_setfield(luaState, -2, "__index");
+    
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        NodeHandle* a = static_cast<NodeHandle*>(luaL_checkudata(L, 1, NODE_HANDLE_METATABLE));
+        NodeHandle* b = static_cast<NodeHandle*>(luaL_checkudata(L, 2, NODE_HANDLE_METATABLE));
+        lua_pushboolean(L, *a == *b);
+        return 1;
+    });
+    lua_setfield(luaState, -2, "__eq");
+    
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        SceneNode* node = checkNodeHandle(L, 1);
+        lua_pushfstring(L, "SceneNode(%s)", node ? node->getName().c_str() : "<destroyed>");
+        return 1;
+    });
+    lua_setfield(luaState, -2, "__tostring");
+    
+    lua_pop(luaState, 1);
+    
+    // getNode(name) resolves a node once through the scene's name index and returns
+    // a handle to keep; getNode() with no argument returns the script's own node
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        if (lua_gettop(L) == 0 || lua_isnil(L, 1)) {
+            lua_getglobal(L, "_currentScriptComponent");
+            ScriptComponent* self = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
+            lua_pop(L, 1);
+            pushNodeHandle(L, self ? self->getOwner() : nullptr);
+            return 1;
+        }
+        
+        const char* nodeName = luaL_checkstring(L, 1);
+        auto activeScene = GetEngine().getSceneManager().getCurrentScene();
+        pushNodeHandle(L, activeScene ? SceneNode::resolve(activeScene->findNodeHandle(nodeName)) : nullptr);
+        return 1;
+    });
+    lua_setglobal(luaState, "getNode");
+}
+
 void ScriptComponent::bindInputToLua() {
     if (!luaState) {
         return;
@@ -943,10 +1402,11 @@ void ScriptComponent::bindCameraToLua() {
         ScriptComponent* self = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
         lua_pop(L, 1); // Remove the userdata from stack
         
-        if (self && self->owner && lua_isnumber(L, 1) && lua_isnumber(L, 2) && lua_isnumber(L, 3)) {
-            float x = lua_tonumber(L, 1);
-            float y = lua_tonumber(L, 2);
-            float z = lua_tonumber(L, 3);
+        glm::vec3 args;
+        if (self && self->owner && LuaMath::testVec3(L, 1, args)) {
+            float x = args.x;
+            float y = args.y;
+            float z = args.z;
             
             glm::vec3 currentPos = self->owner->getTransform().getPosition();
             self->owner->getTransform().setPosition(currentPos + glm::vec3(x, y, z));
@@ -962,10 +1422,11 @@ void ScriptComponent::bindCameraToLua() {
         ScriptComponent* self = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
         lua_pop(L, 1); // Remove the userdata from stack
         
-        if (self && self->owner && lua_isnumber(L, 1) && lua_isnumber(L, 2) && lua_isnumber(L, 3)) {
-            float x = lua_tonumber(L, 1);
-            float y = lua_tonumber(L, 2);
-            float z = lua_tonumber(L, 3);
+        glm::vec3 args;
+        if (self && self->owner && LuaMath::testVec3(L, 1, args)) {
+            float x = args.x;
+            float y = args.y;
+            float z = args.z;
             self->owner->getTransform().setPosition(glm::vec3(x, y, z));
         }
         return 0;
@@ -981,15 +1442,9 @@ void ScriptComponent::bindCameraToLua() {
         
         if (self && self->owner) {
             glm::vec3 pos = self->owner->getTransform().getPosition();
-            lua_pushnumber(L, pos.x);
-            lua_pushnumber(L, pos.y);
-            lua_pushnumber(L, pos.z);
-            return 3;
-        }
-        lua_pushnumber(L, 0);
-        lua_pushnumber(L, 0);
-        lua_pushnumber(L, 0);
-        return 3;
+            return LuaMath::returnVec3(L, pos, 1);
+        }
+        return LuaMath::returnVec3(L, glm::vec3(0.0f), 1);
     });
     lua_settable(luaState, -3);
     
@@ -1000,10 +1455,11 @@ void ScriptComponent::bindCameraToLua() {
         ScriptComponent* self = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
         lua_pop(L, 1); // Remove the userdata from stack
         
-        if (self && self->owner && lua_isnumber(L, 1) && lua_isnumber(L, 2) && lua_isnumber(L, 3)) {
-            float x = lua_tonumber(L, 1);
-            float y = lua_tonumber(L, 2);
-            float z = lua_tonumber(L, 3);
+        glm::vec3 args;
+        if (self && self->owner && LuaMath::testVec3(L, 1, args)) {
+            float x = args.x;
+            float y = args.y;
+            float z = args.z;
             self->owner->getTransform().setEulerAngles(glm::vec3(x, y, z));
         }
         return 0;
@@ -1019,15 +1475,9 @@ void ScriptComponent::bindCameraToLua() {
         
         if (self && self->owner) {
             glm::vec3 rot = self->owner->getTransform().getEulerAngles();
-            lua_pushnumber(L, rot.x);
-            lua_pushnumber(L, rot.y);
-            lua_pushnumber(L, rot.z);
-            return 3;
-        }
-        lua_pushnumber(L, 0);
-        lua_pushnumber(L, 0);
-        lua_pushnumber(L, 0);
-        return 3;
+            return LuaMath::returnVec3(L, rot, 1);
+        }
+        return LuaMath::returnVec3(L, glm::vec3(0.0f), 1);
     });
     lua_settable(luaState, -3);
     
@@ -1287,11 +1737,7 @@ void ScriptComponent::bindCommonFunctions() {
                     // Get the world matrix to get the actual world position
                     auto worldMatrix = cameraNode->getWorldMatrix();
                     glm::vec3 worldPosition = glm::vec3(worldMatrix[3]);
-                    
-                    lua_pushnumber(L, worldPosition.x);
-                    lua_pushnumber(L, worldPosition.y);
-                    lua_pushnumber(L, worldPosition.z);
-                    return 3;
+                    return LuaMath::returnVec3(L, worldPosition, 2);
                 }
             }
 #ifndef VITA_BUILD
@@ -1326,11 +1772,7 @@ void ScriptComponent::bindCommonFunctions() {
                     // Get the node's world matrix to get the actual world position
                     auto worldMatrix = node->getWorldMatrix();
                     glm::vec3 worldPosition = glm::vec3(worldMatrix[3]);
-                    
-                    lua_pushnumber(L, worldPosition.x);
-                    lua_pushnumber(L, worldPosition.y);
-                    lua_pushnumber(L, worldPosition.z);
-                    return 3;
+                    return LuaMath::returnVec3(L, worldPosition, 2);
                 }
             }
 #ifndef VITA_BUILD
@@ -1340,10 +1782,7 @@ void ScriptComponent::bindCommonFunctions() {
 #endif
         
         // Fallback position if node not found
-        lua_pushnumber(L, 0.0f);
-        lua_pushnumber(L, 0.0f);
-        lua_pushnumber(L, 0.0f);
-        return 3;
+        return LuaMath::returnVec3(L, glm::vec3(0.0f), 2);
     });
     lua_setglobal(luaState, "getNodePosition");
     
@@ -1363,11 +1802,7 @@ void ScriptComponent::bindCommonFunctions() {
                 if (node) {
                     // Get the node's LOCAL position (not world position)
                     glm::vec3 localPosition = node->getTransform().getPosition();
-                    
-                    lua_pushnumber(L, localPosition.x);
-                    lua_pushnumber(L, localPosition.y);
-                    lua_pushnumber(L, localPosition.z);
-                    return 3;
+                    return LuaMath::returnVec3(L, localPosition, 2);
                 }
             }
 #ifndef VITA_BUILD
@@ -1377,10 +1812,7 @@ void ScriptComponent::bindCommonFunctions() {
 #endif
         
         // Fallback position if node not found
-        lua_pushnumber(L, 0.0f);
-        lua_pushnumber(L, 0.0f);
-        lua_pushnumber(L, 0.0f);
-        return 3;
+        return LuaMath::returnVec3(L, glm::vec3(0.0f), 2);
     });
     lua_setglobal(luaState, "getNodeLocalPosition");
     
@@ -1483,18 +1915,7 @@ void ScriptComponent::bindCommonFunctions() {
             if (activeScene) {
                 auto node = activeScene->findNode(nodeName);
                 if (node) {
-                    // Convert target position to local space if node has a parent
-                    glm::vec3 localTargetPosition = targetPosition;
-                    auto parent = node->getParent();
-                    if (parent) {
-                        glm::mat4 parentWorldMatrix = parent->getWorldMatrix();
-                        glm::mat4 parentWorldInv = glm::inverse(parentWorldMatrix);
-                        glm::vec4 targetWorld4(targetPosition, 1.0f);
-                        glm::vec4 targetLocal4 = parentWorldInv * targetWorld4;
-                        localTargetPosition = glm::vec3(targetLocal4);
-                    }
-                    
-                    node->getTransform().lookAt(localTargetPosition, up);
+                    lookAtWorldPosition(node.get(), targetPosition, up);
                     
                     lua_pushboolean(L, true);
                     return 1;
@@ -1529,11 +1950,7 @@ void ScriptComponent::bindCommonFunctions() {
                     // Get the node's world matrix to get the actual world position
                     auto worldMatrix = node->getWorldMatrix();
                     glm::vec3 worldPosition = glm::vec3(worldMatrix[3]);
-                    
-                    lua_pushnumber(L, worldPosition.x);
-                    lua_pushnumber(L, worldPosition.y);
-                    lua_pushnumber(L, worldPosition.z);
-                    return 3;
+                    return LuaMath::returnVec3(L, worldPosition, 2);
                 }
             }
 #ifndef VITA_BUILD
@@ -1543,10 +1960,7 @@ void ScriptComponent::bindCommonFunctions() {
 #endif
         
         // Fallback position if node not found
-        lua_pushnumber(L, 0.0f);
-        lua_pushnumber(L, 0.0f);
-        lua_pushnumber(L, 0.0f);
-        return 3;
+        return LuaMath::returnVec3(L, glm::vec3(0.0f), 2);
     });
     lua_setglobal(luaState, "getNodeWorldPosition");
     
@@ -1570,36 +1984,7 @@ void ScriptComponent::bindCommonFunctions() {
                 if (node) {
                     // setNodePosition accepts WORLD coordinates and converts to local
                     // This matches how getNodePosition returns world coordinates
-                    glm::vec3 worldPos(x, y, z);
-                    
-                    auto parent = node->getParent();
-                    if (parent) {
-                        // Convert world position to local position
-                        glm::mat4 parentWorldMatrix = parent->getWorldMatrix();
-                        glm::mat4 parentWorldInv = glm::inverse(parentWorldMatrix);
-                        glm::vec4 worldPos4(worldPos, 1.0f);
-                        glm::vec4 localPos4 = parentWorldInv * worldPos4;
-                        glm::vec3 localPos = glm::vec3(localPos4);
-                        
-                        node->getTransform().setPosition(localPos);
-                    } else {
-                        // No parent - world position equals local position
-                        node->getTransform().setPosition(worldPos);
-                    }
-                    
-                    std::function<void(std::shared_ptr<SceneNode>)> updatePhysicsRecursive = [&](std::shared_ptr<SceneNode> n) {
-                        auto physicsComp = n->getComponent<PhysicsComponent>();
-                        if (physicsComp) {
-                            physicsComp->forceUpdateCollisionShape();
-                        }
-                        for (size_t i = 0; i < n->getChildCount(); ++i) {
-                            auto child = n->getChild(i);
-                            if (child) {
-                                updatePhysicsRecursive(child);
-                            }
-                        }
-                    };
-                    updatePhysicsRecursive(node);
+                    setNodeWorldPosition(node.get(), glm::vec3(x, y, z));
                 } else {
                     #ifdef _DEBUG
                     std::cout << "setNodePosition: Node '" << nodeName << "' not found!" << std::endl;
@@ -1666,10 +2051,7 @@ void ScriptComponent::bindCommonFunctions() {
                     auto physicsComp = node->getComponent<PhysicsComponent>();
                     if (physicsComp) {
                         glm::vec3 velocity = physicsComp->getLinearVelocity();
-                        lua_pushnumber(L, velocity.x);
-                        lua_pushnumber(L, velocity.y);
-                        lua_pushnumber(L, velocity.z);
-                        return 3;
+                        return LuaMath::returnVec3(L, velocity, 2);
                     }
                 }
             }
@@ -1679,10 +2061,7 @@ void ScriptComponent::bindCommonFunctions() {
         }
 #endif
         
-        lua_pushnumber(L, 0);
-        lua_pushnumber(L, 0);
-        lua_pushnumber(L, 0);
-        return 3;
+        return LuaMath::returnVec3(L, glm::vec3(0.0f), 2);
     });
     lua_setglobal(luaState, "getNodeVelocity");
     
@@ -1804,10 +2183,7 @@ void ScriptComponent::bindCommonFunctions() {
                     auto physicsComp = node->getComponent<PhysicsComponent>();
                     if (physicsComp) {
                         glm::vec3 factor = physicsComp->getAngularFactor();
-                        lua_pushnumber(L, factor.x);
-                        lua_pushnumber(L, factor.y);
-                        lua_pushnumber(L, factor.z);
-                        return 3;
+                        return LuaMath::returnVec3(L, factor, 2);
                     }
                 }
             }
@@ -1875,10 +2251,7 @@ void ScriptComponent::bindCommonFunctions() {
                 auto node = activeScene->findNode(nodeName);
                 if (node) {
                     glm::vec3 rot = node->getTransform().getEulerAngles();
-                    lua_pushnumber(L, rot.x);
-                    lua_pushnumber(L, rot.y);
-                    lua_pushnumber(L, rot.z);
-                    return 3;
+                    return LuaMath::returnVec3(L, rot, 2);
                 }
             }
 #ifndef VITA_BUILD
@@ -1887,10 +2260,7 @@ void ScriptComponent::bindCommonFunctions() {
         }
 #endif
         
-        lua_pushnumber(L, 0);
-        lua_pushnumber(L, 0);
-        lua_pushnumber(L, 0);
-        return 3;
+        return LuaMath::returnVec3(L, glm::vec3(0.0f), 2);
     });
     lua_setglobal(luaState, "getNodeRotation");
     
@@ -2119,14 +2489,11 @@ void ScriptComponent::bindCommonFunctions() {
             if (activeScene) {
                 auto activeCamera = activeScene->getActiveCamera();
                 if (activeCamera) {
-                    // Get the world matrix to get the actual world position
-                    auto worldMatrix = activeCamera->getWorldMatrix();
-                    glm::vec3 worldPosition = glm::vec3(worldMatrix[3]);
-                    
-                    lua_pushnumber(L, worldPosition.x);
-                    lua_pushnumber(L, worldPosition.y);
-                    lua_pushnumber(L, worldPosition.z);
-                    return 3;
+                    // The camera snapshot already holds the world position
+                    auto cameraComponent = activeCamera->getComponent<CameraComponent>();
+                    glm::vec3 worldPosition = cameraComponent ? cameraComponent->getSnapshot().position
+                                                              : glm::vec3(activeCamera->getWorldMatrix()[3]);
+                    return LuaMath::returnVec3(L, worldPosition, 1);
                 }
             }
 #ifndef VITA_BUILD
@@ -2136,10 +2503,7 @@ void ScriptComponent::bindCommonFunctions() {
 #endif
         
         // Fallback position if active camera not found
-        lua_pushnumber(L, 0.0f);
-        lua_pushnumber(L, 2.0f);
-        lua_pushnumber(L, 8.0f);
-        return 3;
+        return LuaMath::returnVec3(L, glm::vec3(0.0f, 2.0f, 8.0f), 1);
     });
     lua_setglobal(luaState, "getActiveCameraPosition");
 }
@@ -2188,6 +2552,12 @@ void ScriptComponent::drawInspector() {
             if (hasScriptFunction("update")) ImGui::BulletText("update(deltaTime)");
             if (hasScriptFunction("render")) ImGui::BulletText("render()");
             if (hasScriptFunction("destroy")) ImGui::BulletText("destroy()");
+            
+            if (timings.updateCalls > 0) {
+                ImGui::Text("update(): %.3f ms avg, %.3f ms max (%llu calls)",
+                            timings.getAverageUpdateMs(), timings.maxUpdateMs,
+                            static_cast<unsigned long long>(timings.updateCalls));
+            }
         }
 
         ImGui::Separator();
@@ -2196,22 +2566,44 @@ void ScriptComponent::drawInspector() {
 #endif
 }
 
+// Key of a script's zones table in its environment; light userdata, so the
+// script cannot reach or overwrite it by name
+static char pickupZonesKey;
+static const char* const pickupZoneFields[] = { "x", "y", "z", "width", "height", "depth" };
+
+bool ScriptComponent::pushPickupZones(lua_State* L) {
+    lua_getglobal(L, "_currentScriptComponent");
+    ScriptComponent* component = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+    if (!component || component->envRef == LUA_NOREF) {
+        lua_pushnil(L);
+        return false;
+    }
+    
+    lua_rawgeti(L, LUA_REGISTRYINDEX, component->envRef);
+    lua_pushlightuserdata(L, &pickupZonesKey);
+    lua_rawget(L, -2);
+    if (!lua_istable(L, -1)) {
+        lua_pop(L, 1);
+        lua_newtable(L);
+        lua_pushlightuserdata(L, &pickupZonesKey);
+        lua_pushvalue(L, -2);
+        lua_rawset(L, -4);
+    }
+    lua_remove(L, -2); // the environment
+    return true;
+}
+
 void ScriptComponent::bindPickupZoneToLua() {
     if (!luaState) {
         return;
     }
     
-    // Binding pickup zone system to individual Lua state
-    
-    // Create pickup zone table
-    lua_newtable(luaState);
-    
-    // Global pickup zone state
-    lua_pushstring(luaState, "zones");
+    // Zones belong to the script that created them: two scripts may both
+    // use a zone called "pickup" without seeing each other's objects
     lua_newtable(luaState);
-    lua_settable(luaState, -3);
     
-    // Create pickup zone function
+    // pickupZone.createZone(name, x, y, z, width, height, depth) -> zone
     lua_pushstring(luaState, "createZone");
     lua_pushcfunction(luaState, [](lua_State* L) -> int {
         if (lua_gettop(L) != 7) {
@@ -2220,65 +2612,27 @@ void ScriptComponent::bindPickupZoneToLua() {
             return 0;
         }
         
-        const char* name = lua_tostring(L, 1);
-        double x = lua_tonumber(L, 2);
-        double y = lua_tonumber(L, 3);
-        double z = lua_tonumber(L, 4);
-        double width = lua_tonumber(L, 5);
-        double height = lua_tonumber(L, 6);
-        double depth = lua_tonumber(L, 7);
+        const char* name = luaL_checkstring(L, 1);
         
-        // Create zone table
         lua_newtable(L);
-        
-        // Set properties
-        lua_pushstring(L, "name");
         lua_pushstring(L, name);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "x");
-        lua_pushnumber(L, x);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "y");
-        lua_pushnumber(L, y);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "z");
-        lua_pushnumber(L, z);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "width");
-        lua_pushnumber(L, width);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "height");
-        lua_pushnumber(L, height);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "depth");
-        lua_pushnumber(L, depth);
-        lua_settable(L, -3);
-        
-        // Store in global zones table
-        lua_getglobal(L, "pickupZone");
-        if (lua_istable(L, -1)) {
-            lua_pushstring(L, "zones");
-            lua_gettable(L, -2);
-            if (lua_istable(L, -1)) {
-                lua_pushstring(L, name);
-                lua_pushvalue(L, -4); // Copy the zone table
-                lua_settable(L, -3);
-            }
-            lua_pop(L, 1); // Pop zones table
+        lua_setfield(L, -2, "name");
+        for (int i = 0; i < 6; ++i) {
+            lua_pushnumber(L, lua_tonumber(L, i + 2));
+            lua_setfield(L, -2, pickupZoneFields[i]);
         }
-        lua_pop(L, 1); // Pop pickupZone table
+        int zone = lua_gettop(L);
         
-        return 1; // Return the zone table
+        if (pushPickupZones(L)) {
+            lua_pushvalue(L, zone);
+            lua_setfield(L, -2, name);
+        }
+        lua_pushvalue(L, zone);
+        return 1;
     });
     lua_settable(luaState, -3);
     
-    // Check if object is in zone function
+    // pickupZone.isObjectInZone(zoneName, objectName)
     lua_pushstring(luaState, "isObjectInZone");
     lua_pushcfunction(luaState, [](lua_State* L) -> int {
         if (lua_gettop(L) != 2) {
@@ -2287,37 +2641,23 @@ void ScriptComponent::bindPickupZoneToLua() {
             return 0;
         }
         
-        const char* zoneName = lua_tostring(L, 1);
-        const char* objectName = lua_tostring(L, 2);
-        
-        // Get zones table
-        lua_getglobal(L, "pickupZone");
-        lua_pushstring(L, "zones");
-        lua_gettable(L, -2);
-        lua_pushstring(L, zoneName);
-        lua_gettable(L, -2);
-        
-        if (lua_istable(L, -1)) {
-            lua_pushstring(L, "objects");
-            lua_gettable(L, -2);
+        bool exists = false;
+        if (pushPickupZones(L)) {
+            lua_getfield(L, -1, luaL_checkstring(L, 1));
             if (lua_istable(L, -1)) {
-                lua_pushstring(L, objectName);
-                lua_gettable(L, -2);
-                bool exists = !lua_isnil(L, -1);
-                lua_pop(L, 1);
-                lua_pushboolean(L, exists);
-                lua_pop(L, 3); // Clean up stack
-                return 1;
+                lua_getfield(L, -1, "objects");
+                if (lua_istable(L, -1)) {
+                    lua_getfield(L, -1, luaL_checkstring(L, 2));
+                    exists = !lua_isnil(L, -1);
+                }
             }
         }
-        
-        lua_pushboolean(L, false);
-        lua_pop(L, 2); // Clean up stack
+        lua_pushboolean(L, exists);
         return 1;
     });
     lua_settable(luaState, -3);
     
-    // Add object to zone function
+    // pickupZone.addObjectToZone(zoneName, objectName)
     lua_pushstring(luaState, "addObjectToZone");
     lua_pushcfunction(luaState, [](lua_State* L) -> int {
         if (lua_gettop(L) != 2) {
@@ -2326,38 +2666,27 @@ void ScriptComponent::bindPickupZoneToLua() {
             return 0;
         }
         
-        const char* zoneName = lua_tostring(L, 1);
-        const char* objectName = lua_tostring(L, 2);
-        
-        // Get zones table
-        lua_getglobal(L, "pickupZone");
-        lua_pushstring(L, "zones");
-        lua_gettable(L, -2);
-        lua_pushstring(L, zoneName);
-        lua_gettable(L, -2);
-        
-        if (lua_istable(L, -1)) {
-            lua_pushstring(L, "objects");
-            lua_gettable(L, -2);
-            if (!lua_istable(L, -1)) {
-                lua_pop(L, 1);
-                lua_newtable(L);
-                lua_pushstring(L, "objects");
-                lua_pushvalue(L, -2);
-                lua_settable(L, -4);
-            }
-            lua_pushstring(L, objectName);
-            lua_pushboolean(L, true);
-            lua_settable(L, -3);
-            lua_pop(L, 2); // Clean up stack
+        if (!pushPickupZones(L)) {
+            return 0;
         }
-        
-        lua_pop(L, 2); // Clean up stack
+        lua_getfield(L, -1, luaL_checkstring(L, 1));
+        if (!lua_istable(L, -1)) {
+            return 0;
+        }
+        lua_getfield(L, -1, "objects");
+        if (!lua_istable(L, -1)) {
+            lua_pop(L, 1);
+            lua_newtable(L);
+            lua_pushvalue(L, -1);
+            lua_setfield(L, -3, "objects");
+        }
+        lua_pushboolean(L, 1);
+        lua_setfield(L, -2, luaL_checkstring(L, 2));
         return 0;
     });
     lua_settable(luaState, -3);
     
-    // Remove object from zone function
+    // pickupZone.removeObjectFromZone(zoneName, objectName)
     lua_pushstring(luaState, "removeObjectFromZone");
     lua_pushcfunction(luaState, [](lua_State* L) -> int {
         if (lua_gettop(L) != 2) {
@@ -2366,33 +2695,22 @@ void ScriptComponent::bindPickupZoneToLua() {
             return 0;
         }
         
-        const char* zoneName = lua_tostring(L, 1);
-        const char* objectName = lua_tostring(L, 2);
-        
-        // Get zones table
-        lua_getglobal(L, "pickupZone");
-        lua_pushstring(L, "zones");
-        lua_gettable(L, -2);
-        lua_pushstring(L, zoneName);
-        lua_gettable(L, -2);
-        
+        if (!pushPickupZones(L)) {
+            return 0;
+        }
+        lua_getfield(L, -1, luaL_checkstring(L, 1));
         if (lua_istable(L, -1)) {
-            lua_pushstring(L, "objects");
-            lua_gettable(L, -2);
+            lua_getfield(L, -1, "objects");
             if (lua_istable(L, -1)) {
-                lua_pushstring(L, objectName);
                 lua_pushnil(L);
-                lua_settable(L, -3);
+                lua_setfield(L, -2, luaL_checkstring(L, 2));
             }
-            lua_pop(L, 1);
         }
-        
-        lua_pop(L, 2); // Clean up stack
         return 0;
     });
     lua_settable(luaState, -3);
     
-    // Get objects in zone function
+    // pickupZone.getObjectsInZone(zoneName) -> { objectName = true, ... }
     lua_pushstring(luaState, "getObjectsInZone");
     lua_pushcfunction(luaState, [](lua_State* L) -> int {
         if (lua_gettop(L) != 1) {
@@ -2401,33 +2719,21 @@ void ScriptComponent::bindPickupZoneToLua() {
             return 0;
         }
         
-        const char* zoneName = lua_tostring(L, 1);
-        
-        // Get zones table
-        lua_getglobal(L, "pickupZone");
-        lua_pushstring(L, "zones");
-        lua_gettable(L, -2);
-        lua_pushstring(L, zoneName);
-        lua_gettable(L, -2);
-        
-        if (lua_istable(L, -1)) {
-            lua_pushstring(L, "objects");
-            lua_gettable(L, -2);
+        if (pushPickupZones(L)) {
+            lua_getfield(L, -1, luaL_checkstring(L, 1));
             if (lua_istable(L, -1)) {
-                lua_pop(L, 2); // Clean up stack, keep objects table
-                return 1; // Return objects table
+                lua_getfield(L, -1, "objects");
+                if (lua_istable(L, -1)) {
+                    return 1;
+                }
             }
         }
-        
-        lua_newtable(L); // Return empty table
-        lua_pop(L, 2); // Clean up stack
-        return 1; // Return objects table
+        lua_newtable(L);
+        return 1;
     });
     lua_settable(luaState, -3);
     
     lua_setglobal(luaState, "pickupZone");
-    
-    // Pickup zone system bound successfully
 }
 
 void ScriptComponent::bindArea3DToLua() {
@@ -2897,6 +3203,32 @@ void ScriptComponent::bindSceneToLua() {
     });
     lua_settable(luaState, -3);
     
+    // scene.instantiatePrefab(path [, name [, x, y, z]]) adds an instance under
+    // the scene root and returns its name, or nil
+    lua_pushstring(luaState, "instantiatePrefab");
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        const char* prefabPath = luaL_checkstring(L, 1);
+        const char* nodeName = luaL_optstring(L, 2, "");
+        
+        auto activeScene = GetEngine().getSceneManager().getCurrentScene();
+        auto node = activeScene ? PrefabLibrary::getInstance().instantiatePrefab(prefabPath, nodeName) : nullptr;
+        if (!node) {
+            lua_pushnil(L);
+            return 1;
+        }
+        
+        if (lua_gettop(L) >= 5) {
+            node->getTransform().setPosition(glm::vec3(static_cast<float>(luaL_checknumber(L, 3)),
+                                                       static_cast<float>(luaL_checknumber(L, 4)),
+                                                       static_cast<float>(luaL_checknumber(L, 5))));
+        }
+        activeScene->getRootNode()->addChild(node);
+        node->start();
+        lua_pushstring(L, node->getName().c_str());
+        return 1;
+    });
+    lua_settable(luaState, -3);
+    
     lua_setglobal(luaState, "scene");
 }
 
@@ -3492,6 +3824,34 @@ void ScriptComponent::bindSoundToLua() {
             });
             lua_settable(L, -3);
             
+            // setSpatial(enabled) - positional from the next play()
+            lua_pushstring(L, "setSpatial");
+            lua_pushcfunction(L, [](lua_State* L) -> int {
+                lua_getfield(L, 1, "_soundComponent");
+                SoundComponent* comp = static_cast<SoundComponent*>(lua_touserdata(L, -1));
+                lua_pop(L, 1);
+                
+                if (comp && lua_isboolean(L, 2)) {
+                    comp->setSpatial(lua_toboolean(L, 2) != 0);
+                }
+                return 0;
+            });
+            lua_settable(L, -3);
+            
+            // setDistanceRange(minDistance, maxDistance)
+            lua_pushstring(L, "setDistanceRange");
+            lua_pushcfunction(L, [](lua_State* L) -> int {
+                lua_getfield(L, 1, "_soundComponent");
+                SoundComponent* comp = static_cast<SoundComponent*>(lua_touserdata(L, -1));
+                lua_pop(L, 1);
+                
+                if (comp && lua_isnumber(L, 2) && lua_isnumber(L, 3)) {
+                    comp->setDistanceRange(lua_tonumber(L, 2), lua_tonumber(L, 3));
+                }
+                return 0;
+            });
+            lua_settable(L, -3);
+            
             return 1;
 #ifndef VITA_BUILD
         } catch (...) {
@@ -3717,4 +4077,91 @@ void ScriptComponent::bindSkyboxToLua() {
     lua_setglobal(luaState, "setSkyboxEnabled");
 }
 
+void ScriptComponent::bindProfilerToLua() {
+    if (!luaState) {
+        return;
+    }
+    
+    lua_newtable(luaState);
+    
+    // profiler.setEnabled(enabled)
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        Profiler::getInstance().setEnabled(lua_toboolean(L, 1) != 0);
+        return 0;
+    });
+    lua_setfield(luaState, -2, "setEnabled");
+    
+    // profiler.getFrameMs() is the length of the last whole frame
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        lua_pushnumber(L, Profiler::getInstance().getLastFrameMs());
+        return 1;
+    });
+    lua_setfield(luaState, -2, "getFrameMs");
+    
+    // profiler.setHitchThreshold(ms [, tracePath]); frames over ms are kept,
+    // and written to tracePath as a Chrome trace when one is given
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        float milliseconds = static_cast<float>(luaL_checknumber(L, 1));
+        Profiler::getInstance().setHitchThreshold(milliseconds, luaL_optstring(L, 2, ""));
+        return 0;
+    });
+    lua_setfield(luaState, -2, "setHitchThreshold");
+    
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        lua_pushinteger(L, Profiler::getInstance().getHitchCount());
+        return 1;
+    });
+    lua_setfield(luaState, -2, "getHitchCount");
+    
+    // profiler.writeTrace(path [, frames]) saves the last frames (60 by default)
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        const char* path = luaL_checkstring(L, 1);
+        int frames = static_cast<int>(luaL_optinteger(L, 2, 60));
+        ProfileCapture capture;
+        Profiler::getInstance().capture(static_cast<uint32_t>(std::max(1, frames)), capture);
+        lua_pushboolean(L, Profiler::saveChromeTrace(capture, path));
+        return 1;
+    });
+    lua_setfield(luaState, -2, "writeTrace");
+    
+    // profiler.getStat(name [, framesAgo]) is an engine stat as sampled at a
+    // frame start ("Draw calls", "Lua memory (KB)", ...), nil if unknown
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        const Stats& stats = Stats::getInstance();
+        int index = stats.findStat(luaL_checkstring(L, 1));
+        if (index < 0) {
+            lua_pushnil(L);
+            return 1;
+        }
+        int framesAgo = static_cast<int>(luaL_optinteger(L, 2, 0));
+        lua_pushinteger(L, static_cast<lua_Integer>(stats.getSample(index, static_cast<uint32_t>(std::max(0, framesAgo)))));
+        return 1;
+    });
+    lua_setfield(luaState, -2, "getStat");
+    
+    // profiler.setScriptGC(budgetMs [, pause, stepMul [, memoryLimitKB]]) retunes
+    // the script collector at run time; budgetMs 0 hands it back to Lua
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        ScriptManager& scripts = ScriptManager::getInstance();
+        scripts.setScriptGCBudget(luaL_checknumber(L, 1));
+        int pause = static_cast<int>(luaL_optinteger(L, 2, scripts.getScriptGCPause()));
+        int stepMul = static_cast<int>(luaL_optinteger(L, 3, scripts.getScriptGCStepMul()));
+        scripts.setScriptGCParameters(pause, stepMul);
+        if (!lua_isnoneornil(L, 4)) {
+            scripts.setScriptMemoryLimit(static_cast<int>(luaL_checkinteger(L, 4)));
+        }
+        return 0;
+    });
+    lua_setfield(luaState, -2, "setScriptGC");
+    
+    // profiler.getScriptGCMs() is how long the last frame's GC step took
+    lua_pushcfunction(luaState, [](lua_State* L) -> int {
+        lua_pushnumber(L, ScriptManager::getInstance().getLastGCStepMs());
+        return 1;
+    });
+    lua_setfield(luaState, -2, "getScriptGCMs");
+    
+    lua_setglobal(luaState, "profiler");
+}
+
 } // namespace GameEngine
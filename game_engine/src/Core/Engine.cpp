@@ -1,11 +1,21 @@
 #include "Core/Engine.h"
 #include "Scene/SceneManager.h"
 #include "Rendering/Renderer.h"
+#include "Rendering/TextureManager.h"
+#include "Rendering/RenderDevice.h"
 #include "Input/InputManager.h"
 #include "Core/Time.h"
 #include "Core/MenuManager.h"
 #include "Core/ScriptManager.h"
+#include "Core/FramePipeline.h"
+#include "Core/Profiler.h"
+#include "Core/Stats.h"
+#include "Core/Log.h"
 #include "Audio/AudioManager.h"
+#include "Components/CameraComponent.h"
+#include "Editor/SceneSerializer.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 
 #ifdef EDITOR_BUILD
@@ -18,9 +28,13 @@ namespace GameEngine {
 
 static Engine* s_engineInstance = nullptr;
 
+const int Engine::MAX_FRAME_LATENCY;
+const char* const Engine::CONFIG_PATH = "assets/engine.json";
+
 Engine::Engine()
     : running(false)
     , mode(EngineMode::GAME)
+    , frameLatency(0)
     , sceneManager(nullptr)
     , renderer(nullptr)
     , inputManager(nullptr)
@@ -42,6 +56,9 @@ Engine::~Engine() {
 bool Engine::initialize(EngineMode engineMode) {
     mode = engineMode;
     
+    Profiler::getInstance().setThreadName("Main");
+    Log::getInstance().start();
+    
     if (!initializePlatform()) {
         return false;
     }
@@ -50,16 +67,128 @@ bool Engine::initialize(EngineMode engineMode) {
         return false;
     }
     
+    loadConfig(CONFIG_PATH);
+#ifdef LINUX_BUILD
+    const char* latency = getenv("GAME_ENGINE_FRAME_LATENCY");
+    if (latency && *latency) {
+        setFrameLatency(atoi(latency));
+    }
+#endif
+    
     running = true;
     return true;
 }
 
+bool Engine::loadConfig(const std::string& path) {
+    std::vector<uint8_t> data;
+    if (!SceneSerializer::readSceneFile(path, data)) {
+        return false;
+    }
+    
+    // No exceptions on the Vita: parse errors come back as a discarded value
+    nlohmann::json config = nlohmann::json::parse(data.begin(), data.end(), nullptr, false);
+    if (config.is_discarded() || !config.is_object()) {
+        LOG_WARNING("Engine: Ignoring malformed config %s", path.c_str());
+        return false;
+    }
+    
+    auto it = config.find("frameLatency");
+    if (it != config.end() && it->is_number_integer()) {
+        setFrameLatency(it->get<int>());
+    }
+    
+    ScriptManager& scripts = ScriptManager::getInstance();
+    it = config.find("scriptGCBudgetMs");
+    if (it != config.end() && it->is_number()) {
+        scripts.setScriptGCBudget(it->get<double>());
+    }
+    int pause = scripts.getScriptGCPause();
+    int stepMul = scripts.getScriptGCStepMul();
+    it = config.find("scriptGCPause");
+    if (it != config.end() && it->is_number_integer()) {
+        pause = it->get<int>();
+    }
+    it = config.find("scriptGCStepMul");
+    if (it != config.end() && it->is_number_integer()) {
+        stepMul = it->get<int>();
+    }
+    scripts.setScriptGCParameters(pause, stepMul);
+    it = config.find("scriptMemoryLimitKB");
+    if (it != config.end() && it->is_number_integer()) {
+        scripts.setScriptMemoryLimit(it->get<int>());
+    }
+    
+    LOG_INFO("Engine: Loaded config %s (frame latency %d, script GC budget %.2f ms, script memory limit %d KB)",
+             path.c_str(), frameLatency, scripts.getScriptGCBudget(), scripts.getScriptMemoryLimit());
+    return true;
+}
+
+void Engine::setFrameLatency(int frames) {
+    frameLatency = std::max(0, std::min(frames, MAX_FRAME_LATENCY));
+}
+
 void Engine::run() {
     while (running) {
-        handleEvents();
+        runFrame();
+    }
+}
+
+bool Engine::runFrame() {
+    // The simulation the last frame kicked finishes before anything reads the scene
+    if (pipeline && pipeline->isRunning()) {
+        pipeline->wait();
+        if (!isPipelined()) {
+            pipeline->stop();
+        }
+    }
+    
+    Profiler::getInstance().markFrame();
+    // Samples what the last frame counted
+    static Stat& frameTime = Stats::getInstance().getGauge("Frame time (us)");
+    frameTime.set(static_cast<int64_t>(Profiler::getInstance().getLastFrameMs() * 1000.0f));
+    Stats::getInstance().sampleFrame();
+    
+    handleEvents();
+    if (isPipelined()) {
+        runPipelinedFrame();
+    } else {
         update();
         render();
     }
+    return running;
+}
+
+// Frame N is captured from the scene the last simulation left, frame N+1
+// simulates on the pipeline's thread while frame N is submitted and
+// presented here, on the thread that owns the GL context
+void Engine::runPipelinedFrame() {
+    if (!pipeline) {
+        pipeline = std::unique_ptr<FramePipeline>(new FramePipeline());
+    }
+    if (!pipeline->isRunning()) {
+        bool started = pipeline->start([this]() {
+            PROFILE_ZONE("Engine::update");
+            timeSystem->beginFrame();
+            timeSystem->update();
+            simulate();
+        });
+        if (!started) {
+            std::cerr << "Engine: Failed to start the simulation thread, running frames in order" << std::endl;
+            frameLatency = 0;
+            update();
+            render();
+            return;
+        }
+    }
+    
+    pollInput();
+    if (!running) {
+        return;
+    }
+    
+    captureFrame();
+    pipeline->kick();
+    submitFrame();
 }
 
 void Engine::shutdown() {
@@ -67,6 +196,11 @@ void Engine::shutdown() {
     
     running = false;
     
+    if (pipeline) {
+        pipeline->stop();
+        pipeline.reset();
+    }
+    
 #ifdef EDITOR_BUILD
     if (editor) {
         editor->shutdown();
@@ -101,10 +235,29 @@ void Engine::shutdown() {
     AudioManager::getInstance().shutdown();
     
     platformShutdown();
+    
+    Log::getInstance().stop();
 }
 
 bool Engine::initializePlatform() {
 #ifdef LINUX_BUILD
+    if (!RenderDevice::selectBackendFromEnvironment()) {
+        return false;
+    }
+    
+    RenderBackend backend = RenderDevice::getBackend();
+    if (backend == RenderBackend::NULL_DEVICE) {
+        // ImGui needs a real GL context and window
+        if (mode == EngineMode::EDITOR) {
+            std::cerr << "Engine: The editor cannot run on the null render backend" << std::endl;
+            return false;
+        }
+        std::cout << "Engine: Null render backend, no window or GL context" << std::endl;
+        return true;
+    }
+    
+    platformSetHeadless(backend == RenderBackend::SOFTWARE);
+    
     // On Linux (both Editor and Game), use platformInit()
     return platformInit();
 #else
@@ -170,27 +323,48 @@ Renderer& Engine::getRenderer() {
 }
 
 void Engine::update() {
+    PROFILE_ZONE("Engine::update");
+    
     timeSystem->beginFrame();
     timeSystem->update();
     
-    inputManager->update();
+    pollInput();
+    if (!running) {
+        return;
+    }
+    
+    simulate();
+}
+
+void Engine::pollInput() {
+    {
+        PROFILE_ZONE("Input");
+        inputManager->update();
+    }
     
 #ifdef LINUX_BUILD
     if (inputManager->shouldExit()) {
         running = false;
-        return;
     }
 #endif
-    
+}
+
+// Everything that advances the game; no render device work of its own
+void Engine::simulate() {
 #ifdef EDITOR_BUILD
     if (editor && mode == EngineMode::EDITOR) {
+        PROFILE_ZONE("Editor::update");
         editor->update(timeSystem->getDeltaTime());
     }
 #endif
     
-    MenuManager::getInstance().update(timeSystem->getDeltaTime());
+    {
+        PROFILE_ZONE("MenuManager::update");
+        MenuManager::getInstance().update(timeSystem->getDeltaTime());
+    }
     
     if (sceneManager->getCurrentScene()) {
+        PROFILE_ZONE("SceneManager::update");
         sceneManager->update(timeSystem->getDeltaTime());
     }
     
@@ -198,14 +372,33 @@ void Engine::update() {
         PhysicsManager::getInstance().update(timeSystem->getDeltaTime());
     }
     
-    if (renderer) {
-        renderer->updateLightingUniforms();
+    // Listener and moved 3D sounds go to the mixer together, once a frame
+    CameraComponent* camera = renderer ? renderer->getActiveCamera() : nullptr;
+    {
+        PROFILE_ZONE("AudioManager::updateSpatial");
+        AudioManager::getInstance().updateSpatial(timeSystem->getDeltaTime(), camera ? &camera->getSnapshot() : nullptr);
     }
     
+    // After scripts, collision callbacks and menus have all run for the frame
+    ScriptManager::getInstance().stepScriptGC();
+    
     timeSystem->endFrame();
 }
 
 void Engine::render() {
+    PROFILE_ZONE("Engine::render");
+    
+    // Evict and stream texture mips before this frame binds anything
+    {
+        PROFILE_ZONE("TextureManager::update");
+        TextureManager::getInstance().update();
+    }
+    
+    {
+        PROFILE_ZONE("Renderer::updateLightingUniforms");
+        renderer->updateLightingUniforms();
+    }
+    
     renderer->beginFrame();
     
 #ifdef EDITOR_BUILD
@@ -213,6 +406,7 @@ void Engine::render() {
         renderer->setClearColor(0.1f, 0.1f, 0.1f);
         renderer->clear();
         
+        PROFILE_ZONE("Editor::render");
         editor->render();
     } else {
 #endif
@@ -220,16 +414,67 @@ void Engine::render() {
         renderer->clear();
         
         if (sceneManager->getCurrentScene()) {
+            PROFILE_ZONE("SceneManager::render");
             sceneManager->render();
         }
         
-        MenuManager::getInstance().render(*renderer);
+        {
+            PROFILE_ZONE("MenuManager::render");
+            MenuManager::getInstance().render(*renderer);
+        }
 #ifdef EDITOR_BUILD
     }
 #endif
     
     renderer->endFrame();
-    renderer->present();
+    
+    {
+        PROFILE_ZONE("Renderer::present");
+        renderer->present();
+    }
+}
+
+// The half of render() that reads the scene, done while the simulation
+// thread is idle
+void Engine::captureFrame() {
+    PROFILE_ZONE("Engine::captureFrame");
+    
+    {
+        PROFILE_ZONE("TextureManager::update");
+        TextureManager::getInstance().update();
+    }
+    
+    {
+        PROFILE_ZONE("Renderer::updateLightingUniforms");
+        renderer->updateLightingUniforms();
+    }
+    
+    renderer->beginFrame();
+    
+    if (sceneManager->getCurrentScene()) {
+        PROFILE_ZONE("SceneManager::capture");
+        sceneManager->capture();
+    }
+    
+    {
+        PROFILE_ZONE("MenuManager::render");
+        MenuManager::getInstance().render(*renderer);
+    }
+}
+
+// The half that only reads the snapshot, overlapping the next simulation
+void Engine::submitFrame() {
+    PROFILE_ZONE("Engine::submitFrame");
+    
+    renderer->setClearColor(0.2f, 0.3f, 0.3f);
+    renderer->clear();
+    renderer->submitScene();
+    renderer->endFrame();
+    
+    {
+        PROFILE_ZONE("Renderer::present");
+        renderer->present();
+    }
 }
 
 void Engine::handleEvents() {
@@ -0,0 +1,126 @@
+#include "Core/FramePipeline.h"
+#include "Core/Profiler.h"
+#include "Rendering/ProxyRenderDevice.h"
+
+namespace GameEngine {
+
+FramePipeline::FramePipeline()
+#ifndef LINUX_BUILD
+    : mutex("FramePipeline")
+    , running(false)
+#else
+    : running(false)
+#endif
+    , stopRequested(false)
+    , frameRequested(false)
+    , frameDone(false)
+    , pendingTask(nullptr)
+{
+#ifndef LINUX_BUILD
+    renderCondition.init(mutex.getMutexId());
+    simulationCondition.init(mutex.getMutexId());
+#endif
+    proxyDevice.reset(new ProxyRenderDevice([this](const std::function<void()>& task) {
+        this->runOnRenderThread(task);
+    }));
+}
+
+FramePipeline::~FramePipeline() {
+    stop();
+}
+
+bool FramePipeline::start(const std::function<void()>& simulateFrame) {
+    if (running) {
+        return true;
+    }
+    simulate = simulateFrame;
+    stopRequested = false;
+    frameRequested = false;
+    frameDone = false;
+
+    thread = ThreadManager::getInstance().createThread("Simulation", [this]() { this->simulationThread(); });
+    running = ThreadManager::getInstance().isValid(thread);
+    return running;
+}
+
+void FramePipeline::stop() {
+    if (!running) {
+        return;
+    }
+    wait();
+    {
+        LockGuard lock(mutex);
+        stopRequested = true;
+        simulationCondition.notify_all();
+    }
+    ThreadManager::getInstance().joinThread(thread);
+    running = false;
+}
+
+void FramePipeline::kick() {
+    LockGuard lock(mutex);
+    frameRequested = true;
+    frameDone = false;
+    simulationCondition.notify_all();
+}
+
+void FramePipeline::wait() {
+    if (!frameRequested) {
+        return;
+    }
+    PROFILE_ZONE("FramePipeline::wait");
+    UniqueLock lock(mutex);
+    for (;;) {
+        if (pendingTask) {
+            runPendingTask(lock);
+        } else if (frameDone) {
+            break;
+        } else {
+            renderCondition.wait(lock);
+        }
+    }
+    frameRequested = false;
+}
+
+void FramePipeline::runOnRenderThread(const std::function<void()>& task) {
+    UniqueLock lock(mutex);
+    pendingTask = &task;
+    renderCondition.notify_all();
+    while (pendingTask) {
+        simulationCondition.wait(lock);
+    }
+}
+
+void FramePipeline::runPendingTask(UniqueLock& lock) {
+    const std::function<void()>* task = pendingTask;
+    lock.unlock();
+    (*task)();
+    lock.lock();
+    pendingTask = nullptr;
+    simulationCondition.notify_all();
+}
+
+void FramePipeline::simulationThread() {
+    // GL only works on the render thread, so calls made here are forwarded
+    RenderDevice::setThreadDevice(proxyDevice.get());
+    for (;;) {
+        {
+            UniqueLock lock(mutex);
+            while (!stopRequested && (!frameRequested || frameDone)) {
+                simulationCondition.wait(lock);
+            }
+            if (stopRequested) {
+                break;
+            }
+        }
+
+        simulate();
+
+        LockGuard lock(mutex);
+        frameDone = true;
+        renderCondition.notify_all();
+    }
+    RenderDevice::setThreadDevice(nullptr);
+}
+
+} // namespace GameEngine
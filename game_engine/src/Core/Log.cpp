@@ -0,0 +1,214 @@
+#include "Core/Log.h"
+#include "Core/ThreadManager.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace GameEngine {
+
+const uint32_t Log::QUEUE_CAPACITY;
+const uint32_t Log::MESSAGE_SIZE;
+
+namespace {
+
+const uint32_t QUEUE_MASK = Log::QUEUE_CAPACITY - 1;
+// How long the writer sleeps when the queue is empty
+const int WRITER_IDLE_MS = 2;
+
+ThreadHandle writerHandle;
+
+} // namespace
+
+Log& Log::getInstance() {
+    static Log instance;
+    return instance;
+}
+
+Log::Log()
+    : enqueuePos(0)
+    , dequeuePos(0)
+    , level(static_cast<int>(LogLevel::INFO))
+    , dropped(0)
+    , running(false)
+{
+    for (uint32_t i = 0; i < QUEUE_CAPACITY; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+#ifdef LINUX_BUILD
+    LogLevel envLevel;
+    const char* env = getenv("GAME_ENGINE_LOG_LEVEL");
+    if (env && parseLevel(env, envLevel)) {
+        setLevel(envLevel);
+    }
+#endif
+}
+
+Log::~Log() {
+    stop();
+}
+
+void Log::start() {
+    if (running.exchange(true)) {
+        return;
+    }
+    writerHandle = ThreadManager::getInstance().createThread("LogWriter", [this]() { this->writerThread(); });
+    if (!ThreadManager::getInstance().isValid(writerHandle)) {
+        running.store(false);
+    }
+}
+
+void Log::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    ThreadManager::getInstance().joinThread(writerHandle);
+
+    Slot slot;
+    while (pop(slot)) {
+        output(slot.level, slot.text);
+    }
+    fflush(stdout);
+}
+
+void Log::write(LogLevel messageLevel, const char* format, ...) {
+    if (!isEnabled(messageLevel)) {
+        return;
+    }
+    if (!running.load(std::memory_order_relaxed)) {
+        char text[MESSAGE_SIZE];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+        output(messageLevel, text);
+        return;
+    }
+
+    // Claim a slot (bounded MPMC queue: each slot's sequence says whose turn it is)
+    uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots[pos & QUEUE_MASK];
+        uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int32_t diff = static_cast<int32_t>(sequence - pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Full: the writer is behind, and waiting for it is what we avoid
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = messageLevel;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(slot->text, sizeof(slot->text), format, args);
+    va_end(args);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    if (!running.load(std::memory_order_relaxed)) {
+        // stop() may have drained before this message landed
+        Slot late;
+        while (pop(late)) {
+            output(late.level, late.text);
+        }
+    }
+}
+
+bool Log::pop(Slot& out) {
+    uint32_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots[pos & QUEUE_MASK];
+        uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int32_t diff = static_cast<int32_t>(sequence - (pos + 1));
+        if (diff == 0) {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    out.level = slot->level;
+    memcpy(out.text, slot->text, sizeof(out.text));
+    slot->sequence.store(pos + QUEUE_CAPACITY, std::memory_order_release);
+    return true;
+}
+
+void Log::writerThread() {
+    Slot slot;
+    uint32_t reportedDrops = 0;
+    while (running.load(std::memory_order_relaxed)) {
+        bool wrote = false;
+        while (pop(slot)) {
+            output(slot.level, slot.text);
+            wrote = true;
+        }
+
+        uint32_t drops = getDroppedCount();
+        if (drops != reportedDrops) {
+            char text[64];
+            snprintf(text, sizeof(text), "Log: %u messages dropped (queue full)", drops - reportedDrops);
+            output(LogLevel::WARNING, text);
+            reportedDrops = drops;
+            wrote = true;
+        }
+
+        if (wrote) {
+            fflush(stdout);
+        } else {
+            ThreadManager::getInstance().sleep(WRITER_IDLE_MS);
+        }
+    }
+}
+
+void Log::output(LogLevel messageLevel, const char* text) {
+#ifdef VITA_BUILD
+    if (messageLevel == LogLevel::INFO) {
+        printf("%s\n", text);
+    } else {
+        printf("[%s] %s\n", getLevelName(messageLevel), text);
+    }
+#else
+    FILE* stream = messageLevel >= LogLevel::WARNING ? stderr : stdout;
+    if (messageLevel == LogLevel::INFO) {
+        fprintf(stream, "%s\n", text);
+    } else {
+        fprintf(stream, "[%s] %s\n", getLevelName(messageLevel), text);
+    }
+#endif
+}
+
+const char* Log::getLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::TRACE: return "trace";
+        case LogLevel::VERBOSE: return "verbose";
+        case LogLevel::INFO: return "info";
+        case LogLevel::WARNING: return "warning";
+        case LogLevel::ERROR: return "error";
+    }
+    return "unknown";
+}
+
+bool Log::parseLevel(const char* name, LogLevel& level) {
+    for (int i = static_cast<int>(LogLevel::TRACE); i <= static_cast<int>(LogLevel::ERROR); ++i) {
+        if (strcmp(name, getLevelName(static_cast<LogLevel>(i))) == 0) {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace GameEngine
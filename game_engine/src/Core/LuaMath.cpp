@@ -0,0 +1,719 @@
+#include "Core/LuaMath.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstring>
+
+extern "C" {
+    #include <lua.h>
+    #include <lauxlib.h>
+    #include <lualib.h>
+}
+
+namespace GameEngine {
+
+static const char* VEC3_METATABLE = "vec3";
+static const char* QUAT_METATABLE = "quat";
+static const char* MAT4_METATABLE = "mat4";
+
+// Single-character component name of a string key, or 0
+static char componentKey(lua_State* L, int index) {
+    if (lua_type(L, index) != LUA_TSTRING) {
+        return 0;
+    }
+    size_t length = 0;
+    const char* key = lua_tolstring(L, index, &length);
+    return length == 1 ? key[0] : 0;
+}
+
+// __index shared by all three types: component fields first, then the methods
+// table held as upvalue 1
+static int lookupMethod(lua_State* L) {
+    lua_pushvalue(L, 2);
+    lua_rawget(L, lua_upvalueindex(1));
+    return 1;
+}
+
+static void newMetatable(lua_State* L, const char* name, const luaL_Reg* metamethods,
+                         const luaL_Reg* methods, lua_CFunction index) {
+    luaL_newmetatable(L, name);
+    luaL_setfuncs(L, metamethods, 0);
+
+    lua_newtable(L);
+    luaL_setfuncs(L, methods, 0);
+    lua_pushcclosure(L, index, 1);
+    lua_setfield(L, -2, "__index");
+
+    lua_pop(L, 1);
+}
+
+// Constructor global: a table of static helpers that is itself callable
+static void newConstructor(lua_State* L, const char* name, lua_CFunction call, const luaL_Reg* statics) {
+    lua_newtable(L);
+    if (statics) {
+        luaL_setfuncs(L, statics, 0);
+    }
+    lua_newtable(L);
+    lua_pushcfunction(L, call);
+    lua_setfield(L, -2, "__call");
+    lua_setmetatable(L, -2);
+    lua_setglobal(L, name);
+}
+
+// ---------------------------------------------------------------------------
+// vec3
+// ---------------------------------------------------------------------------
+
+glm::vec3* LuaMath::pushVec3(lua_State* L, const glm::vec3& v) {
+    glm::vec3* result = static_cast<glm::vec3*>(lua_newuserdata(L, sizeof(glm::vec3)));
+    *result = v;
+    luaL_setmetatable(L, VEC3_METATABLE);
+    return result;
+}
+
+glm::vec3* LuaMath::toVec3(lua_State* L, int index) {
+    return static_cast<glm::vec3*>(luaL_testudata(L, index, VEC3_METATABLE));
+}
+
+glm::vec3 LuaMath::checkVec3(lua_State* L, int index) {
+    glm::vec3* v = toVec3(L, index);
+    if (v) {
+        return *v;
+    }
+    return glm::vec3(luaL_checknumber(L, index), luaL_checknumber(L, index + 1), luaL_checknumber(L, index + 2));
+}
+
+bool LuaMath::testVec3(lua_State* L, int index, glm::vec3& out) {
+    glm::vec3* v = toVec3(L, index);
+    if (v) {
+        out = *v;
+        return true;
+    }
+    if (lua_isnumber(L, index) && lua_isnumber(L, index + 1) && lua_isnumber(L, index + 2)) {
+        out = glm::vec3(lua_tonumber(L, index), lua_tonumber(L, index + 1), lua_tonumber(L, index + 2));
+        return true;
+    }
+    return false;
+}
+
+int LuaMath::returnVec3(lua_State* L, const glm::vec3& v, int outIndex) {
+    glm::vec3* out = outIndex > 0 ? toVec3(L, outIndex) : nullptr;
+    if (out) {
+        *out = v;
+        lua_pushvalue(L, outIndex);
+        return 1;
+    }
+    lua_pushnumber(L, v.x);
+    lua_pushnumber(L, v.y);
+    lua_pushnumber(L, v.z);
+    return 3;
+}
+
+static glm::vec3& selfVec3(lua_State* L) {
+    return *static_cast<glm::vec3*>(luaL_checkudata(L, 1, VEC3_METATABLE));
+}
+
+static float checkScalar(lua_State* L, int index) {
+    return static_cast<float>(luaL_checknumber(L, index));
+}
+
+static int vec3Index(lua_State* L) {
+    glm::vec3& v = selfVec3(L);
+    switch (componentKey(L, 2)) {
+        case 'x': lua_pushnumber(L, v.x); return 1;
+        case 'y': lua_pushnumber(L, v.y); return 1;
+        case 'z': lua_pushnumber(L, v.z); return 1;
+        default: return lookupMethod(L);
+    }
+}
+
+static int vec3NewIndex(lua_State* L) {
+    glm::vec3& v = selfVec3(L);
+    switch (componentKey(L, 2)) {
+        case 'x': v.x = checkScalar(L, 3); return 0;
+        case 'y': v.y = checkScalar(L, 3); return 0;
+        case 'z': v.z = checkScalar(L, 3); return 0;
+        default: return luaL_error(L, "vec3 has no field '%s'", luaL_tolstring(L, 2, nullptr));
+    }
+}
+
+static int vec3Add(lua_State* L) {
+    LuaMath::pushVec3(L, LuaMath::checkVec3(L, 1) + LuaMath::checkVec3(L, 2));
+    return 1;
+}
+
+static int vec3Sub(lua_State* L) {
+    LuaMath::pushVec3(L, LuaMath::checkVec3(L, 1) - LuaMath::checkVec3(L, 2));
+    return 1;
+}
+
+// vec3 * number, number * vec3, vec3 * vec3 (component-wise)
+static int vec3Mul(lua_State* L) {
+    if (lua_isnumber(L, 1)) {
+        glm::vec3* v = static_cast<glm::vec3*>(luaL_checkudata(L, 2, VEC3_METATABLE));
+        LuaMath::pushVec3(L, checkScalar(L, 1) * *v);
+        return 1;
+    }
+    glm::vec3& a = selfVec3(L);
+    if (lua_isnumber(L, 2)) {
+        LuaMath::pushVec3(L, a * checkScalar(L, 2));
+    } else {
+        LuaMath::pushVec3(L, a * LuaMath::checkVec3(L, 2));
+    }
+    return 1;
+}
+
+static int vec3Div(lua_State* L) {
+    glm::vec3& a = selfVec3(L);
+    if (lua_isnumber(L, 2)) {
+        LuaMath::pushVec3(L, a / checkScalar(L, 2));
+    } else {
+        LuaMath::pushVec3(L, a / LuaMath::checkVec3(L, 2));
+    }
+    return 1;
+}
+
+static int vec3Unm(lua_State* L) {
+    LuaMath::pushVec3(L, -selfVec3(L));
+    return 1;
+}
+
+static int vec3Eq(lua_State* L) {
+    glm::vec3* a = LuaMath::toVec3(L, 1);
+    glm::vec3* b = LuaMath::toVec3(L, 2);
+    lua_pushboolean(L, a && b && *a == *b);
+    return 1;
+}
+
+static int vec3ToString(lua_State* L) {
+    glm::vec3& v = selfVec3(L);
+    lua_pushfstring(L, "vec3(%f, %f, %f)", (double)v.x, (double)v.y, (double)v.z);
+    return 1;
+}
+
+// Mutators return self so calls can be chained: v:set(1, 2, 3):normalize()
+static int vec3Set(lua_State* L) {
+    selfVec3(L) = LuaMath::checkVec3(L, 2);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int vec3AddInPlace(lua_State* L) {
+    selfVec3(L) += LuaMath::checkVec3(L, 2);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int vec3SubInPlace(lua_State* L) {
+    selfVec3(L) -= LuaMath::checkVec3(L, 2);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int vec3ScaleInPlace(lua_State* L) {
+    selfVec3(L) *= checkScalar(L, 2);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int vec3NormalizeInPlace(lua_State* L) {
+    glm::vec3& v = selfVec3(L);
+    float length = glm::length(v);
+    if (length > 0.0f) {
+        v /= length;
+    }
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int vec3LerpInPlace(lua_State* L) {
+    glm::vec3& v = selfVec3(L);
+    glm::vec3 target = *static_cast<glm::vec3*>(luaL_checkudata(L, 2, VEC3_METATABLE));
+    v = glm::mix(v, target, checkScalar(L, 3));
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int vec3Length(lua_State* L) {
+    lua_pushnumber(L, glm::length(selfVec3(L)));
+    return 1;
+}
+
+static int vec3LengthSquared(lua_State* L) {
+    glm::vec3& v = selfVec3(L);
+    lua_pushnumber(L, glm::dot(v, v));
+    return 1;
+}
+
+static int vec3Distance(lua_State* L) {
+    lua_pushnumber(L, glm::distance(selfVec3(L), LuaMath::checkVec3(L, 2)));
+    return 1;
+}
+
+static int vec3Dot(lua_State* L) {
+    lua_pushnumber(L, glm::dot(selfVec3(L), LuaMath::checkVec3(L, 2)));
+    return 1;
+}
+
+static int vec3Cross(lua_State* L) {
+    LuaMath::pushVec3(L, glm::cross(selfVec3(L), LuaMath::checkVec3(L, 2)));
+    return 1;
+}
+
+static int vec3Clone(lua_State* L) {
+    LuaMath::pushVec3(L, selfVec3(L));
+    return 1;
+}
+
+static int vec3Unpack(lua_State* L) {
+    return LuaMath::returnVec3(L, selfVec3(L), 0);
+}
+
+// vec3(), vec3(s), vec3(x, y, z), vec3(other)
+static int vec3New(lua_State* L) {
+    int args = lua_gettop(L) - 1; // arg 1 is the vec3 table itself
+    if (args == 0) {
+        LuaMath::pushVec3(L, glm::vec3(0.0f));
+    } else if (args == 1 && lua_isnumber(L, 2)) {
+        LuaMath::pushVec3(L, glm::vec3(checkScalar(L, 2)));
+    } else {
+        LuaMath::pushVec3(L, LuaMath::checkVec3(L, 2));
+    }
+    return 1;
+}
+
+void LuaMath::registerVec3(lua_State* L) {
+    static const luaL_Reg metamethods[] = {
+        { "__newindex", vec3NewIndex },
+        { "__add", vec3Add },
+        { "__sub", vec3Sub },
+        { "__mul", vec3Mul },
+        { "__div", vec3Div },
+        { "__unm", vec3Unm },
+        { "__eq", vec3Eq },
+        { "__tostring", vec3ToString },
+        { nullptr, nullptr }
+    };
+    static const luaL_Reg methods[] = {
+        { "set", vec3Set },
+        { "add", vec3AddInPlace },
+        { "sub", vec3SubInPlace },
+        { "scale", vec3ScaleInPlace },
+        { "normalize", vec3NormalizeInPlace },
+        { "lerp", vec3LerpInPlace },
+        { "length", vec3Length },
+        { "lengthSquared", vec3LengthSquared },
+        { "distance", vec3Distance },
+        { "dot", vec3Dot },
+        { "cross", vec3Cross },
+        { "clone", vec3Clone },
+        { "unpack", vec3Unpack },
+        { nullptr, nullptr }
+    };
+    newMetatable(L, VEC3_METATABLE, metamethods, methods, vec3Index);
+    newConstructor(L, "vec3", vec3New, nullptr);
+}
+
+// ---------------------------------------------------------------------------
+// quat
+// ---------------------------------------------------------------------------
+
+glm::quat* LuaMath::pushQuat(lua_State* L, const glm::quat& q) {
+    glm::quat* result = static_cast<glm::quat*>(lua_newuserdata(L, sizeof(glm::quat)));
+    *result = q;
+    luaL_setmetatable(L, QUAT_METATABLE);
+    return result;
+}
+
+glm::quat* LuaMath::toQuat(lua_State* L, int index) {
+    return static_cast<glm::quat*>(luaL_testudata(L, index, QUAT_METATABLE));
+}
+
+glm::quat LuaMath::checkQuat(lua_State* L, int index) {
+    return *static_cast<glm::quat*>(luaL_checkudata(L, index, QUAT_METATABLE));
+}
+
+int LuaMath::returnQuat(lua_State* L, const glm::quat& q, int outIndex) {
+    glm::quat* out = outIndex > 0 ? toQuat(L, outIndex) : nullptr;
+    if (out) {
+        *out = q;
+        lua_pushvalue(L, outIndex);
+    } else {
+        pushQuat(L, q);
+    }
+    return 1;
+}
+
+static glm::quat& selfQuat(lua_State* L) {
+    return *static_cast<glm::quat*>(luaL_checkudata(L, 1, QUAT_METATABLE));
+}
+
+static int quatIndex(lua_State* L) {
+    glm::quat& q = selfQuat(L);
+    switch (componentKey(L, 2)) {
+        case 'x': lua_pushnumber(L, q.x); return 1;
+        case 'y': lua_pushnumber(L, q.y); return 1;
+        case 'z': lua_pushnumber(L, q.z); return 1;
+        case 'w': lua_pushnumber(L, q.w); return 1;
+        default: return lookupMethod(L);
+    }
+}
+
+static int quatNewIndex(lua_State* L) {
+    glm::quat& q = selfQuat(L);
+    switch (componentKey(L, 2)) {
+        case 'x': q.x = checkScalar(L, 3); return 0;
+        case 'y': q.y = checkScalar(L, 3); return 0;
+        case 'z': q.z = checkScalar(L, 3); return 0;
+        case 'w': q.w = checkScalar(L, 3); return 0;
+        default: return luaL_error(L, "quat has no field '%s'", luaL_tolstring(L, 2, nullptr));
+    }
+}
+
+// quat * quat composes rotations; quat * vec3 rotates the vector
+static int quatMul(lua_State* L) {
+    glm::quat& q = selfQuat(L);
+    glm::vec3* v = LuaMath::toVec3(L, 2);
+    if (v) {
+        LuaMath::pushVec3(L, q * *v);
+    } else {
+        LuaMath::pushQuat(L, q * LuaMath::checkQuat(L, 2));
+    }
+    return 1;
+}
+
+static int quatEq(lua_State* L) {
+    glm::quat* a = LuaMath::toQuat(L, 1);
+    glm::quat* b = LuaMath::toQuat(L, 2);
+    lua_pushboolean(L, a && b && *a == *b);
+    return 1;
+}
+
+static int quatToString(lua_State* L) {
+    glm::quat& q = selfQuat(L);
+    lua_pushfstring(L, "quat(%f, %f, %f, %f)", (double)q.w, (double)q.x, (double)q.y, (double)q.z);
+    return 1;
+}
+
+static int quatSet(lua_State* L) {
+    selfQuat(L) = LuaMath::checkQuat(L, 2);
+    lua_settop(L, 1);
+    return 1;
+}
+
+// Euler angles in degrees, matching Transform::setEulerAngles
+static int quatSetEuler(lua_State* L) {
+    selfQuat(L) = glm::quat(glm::radians(LuaMath::checkVec3(L, 2)));
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int quatToEuler(lua_State* L) {
+    return LuaMath::returnVec3(L, glm::degrees(glm::eulerAngles(selfQuat(L))), 2);
+}
+
+static int quatMultiplyInPlace(lua_State* L) {
+    glm::quat& q = selfQuat(L);
+    q = q * LuaMath::checkQuat(L, 2);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int quatNormalizeInPlace(lua_State* L) {
+    glm::quat& q = selfQuat(L);
+    q = glm::normalize(q);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int quatInverseInPlace(lua_State* L) {
+    glm::quat& q = selfQuat(L);
+    q = glm::inverse(q);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int quatSlerpInPlace(lua_State* L) {
+    glm::quat& q = selfQuat(L);
+    q = glm::slerp(q, LuaMath::checkQuat(L, 2), checkScalar(L, 3));
+    lua_settop(L, 1);
+    return 1;
+}
+
+// q:rotate(v [, out]) - rotated copy of v, written into out when given
+static int quatRotate(lua_State* L) {
+    glm::quat& q = selfQuat(L);
+    glm::vec3* v = static_cast<glm::vec3*>(luaL_checkudata(L, 2, VEC3_METATABLE));
+    glm::vec3* out = LuaMath::toVec3(L, 3);
+    if (out) {
+        *out = q * *v;
+        lua_settop(L, 3);
+    } else {
+        LuaMath::pushVec3(L, q * *v);
+    }
+    return 1;
+}
+
+static int quatClone(lua_State* L) {
+    LuaMath::pushQuat(L, selfQuat(L));
+    return 1;
+}
+
+// quat() identity, quat(w, x, y, z), quat(other)
+static int quatNew(lua_State* L) {
+    int args = lua_gettop(L) - 1;
+    if (args == 0) {
+        LuaMath::pushQuat(L, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    } else if (args == 1) {
+        LuaMath::pushQuat(L, LuaMath::checkQuat(L, 2));
+    } else {
+        LuaMath::pushQuat(L, glm::quat(checkScalar(L, 2), checkScalar(L, 3), checkScalar(L, 4), checkScalar(L, 5)));
+    }
+    return 1;
+}
+
+static int quatFromEuler(lua_State* L) {
+    LuaMath::pushQuat(L, glm::quat(glm::radians(LuaMath::checkVec3(L, 1))));
+    return 1;
+}
+
+static int quatFromAxisAngle(lua_State* L) {
+    glm::vec3 axis = LuaMath::checkVec3(L, 1);
+    int angleIndex = LuaMath::toVec3(L, 1) ? 2 : 4;
+    LuaMath::pushQuat(L, glm::angleAxis(glm::radians(checkScalar(L, angleIndex)), glm::normalize(axis)));
+    return 1;
+}
+
+void LuaMath::registerQuat(lua_State* L) {
+    static const luaL_Reg metamethods[] = {
+        { "__newindex", quatNewIndex },
+        { "__mul", quatMul },
+        { "__eq", quatEq },
+        { "__tostring", quatToString },
+        { nullptr, nullptr }
+    };
+    static const luaL_Reg methods[] = {
+        { "set", quatSet },
+        { "setEuler", quatSetEuler },
+        { "toEuler", quatToEuler },
+        { "multiply", quatMultiplyInPlace },
+        { "normalize", quatNormalizeInPlace },
+        { "inverse", quatInverseInPlace },
+        { "slerp", quatSlerpInPlace },
+        { "rotate", quatRotate },
+        { "clone", quatClone },
+        { nullptr, nullptr }
+    };
+    static const luaL_Reg statics[] = {
+        { "fromEuler", quatFromEuler },
+        { "fromAxisAngle", quatFromAxisAngle },
+        { nullptr, nullptr }
+    };
+    newMetatable(L, QUAT_METATABLE, metamethods, methods, quatIndex);
+    newConstructor(L, "quat", quatNew, statics);
+}
+
+// ---------------------------------------------------------------------------
+// mat4
+// ---------------------------------------------------------------------------
+
+glm::mat4* LuaMath::pushMat4(lua_State* L, const glm::mat4& m) {
+    glm::mat4* result = static_cast<glm::mat4*>(lua_newuserdata(L, sizeof(glm::mat4)));
+    *result = m;
+    luaL_setmetatable(L, MAT4_METATABLE);
+    return result;
+}
+
+glm::mat4* LuaMath::toMat4(lua_State* L, int index) {
+    return static_cast<glm::mat4*>(luaL_testudata(L, index, MAT4_METATABLE));
+}
+
+glm::mat4 LuaMath::checkMat4(lua_State* L, int index) {
+    return *static_cast<glm::mat4*>(luaL_checkudata(L, index, MAT4_METATABLE));
+}
+
+int LuaMath::returnMat4(lua_State* L, const glm::mat4& m, int outIndex) {
+    glm::mat4* out = outIndex > 0 ? toMat4(L, outIndex) : nullptr;
+    if (out) {
+        *out = m;
+        lua_pushvalue(L, outIndex);
+    } else {
+        pushMat4(L, m);
+    }
+    return 1;
+}
+
+static glm::mat4& selfMat4(lua_State* L) {
+    return *static_cast<glm::mat4*>(luaL_checkudata(L, 1, MAT4_METATABLE));
+}
+
+static int mat4Index(lua_State* L) {
+    selfMat4(L);
+    return lookupMethod(L);
+}
+
+// mat4 * mat4 composes; mat4 * vec3 transforms the vector as a point
+static int mat4Mul(lua_State* L) {
+    glm::mat4& m = selfMat4(L);
+    glm::vec3* v = LuaMath::toVec3(L, 2);
+    if (v) {
+        LuaMath::pushVec3(L, glm::vec3(m * glm::vec4(*v, 1.0f)));
+    } else {
+        LuaMath::pushMat4(L, m * LuaMath::checkMat4(L, 2));
+    }
+    return 1;
+}
+
+static int mat4Eq(lua_State* L) {
+    glm::mat4* a = LuaMath::toMat4(L, 1);
+    glm::mat4* b = LuaMath::toMat4(L, 2);
+    lua_pushboolean(L, a && b && *a == *b);
+    return 1;
+}
+
+static int mat4ToString(lua_State* L) {
+    glm::mat4& m = selfMat4(L);
+    lua_pushfstring(L, "mat4(translation %f, %f, %f)", (double)m[3].x, (double)m[3].y, (double)m[3].z);
+    return 1;
+}
+
+// Row/column accessors use 1-based indices, column-major like glm
+static int mat4Get(lua_State* L) {
+    glm::mat4& m = selfMat4(L);
+    int column = static_cast<int>(luaL_checkinteger(L, 2));
+    int row = static_cast<int>(luaL_checkinteger(L, 3));
+    luaL_argcheck(L, column >= 1 && column <= 4, 2, "column out of range");
+    luaL_argcheck(L, row >= 1 && row <= 4, 3, "row out of range");
+    lua_pushnumber(L, m[column - 1][row - 1]);
+    return 1;
+}
+
+static int mat4SetElement(lua_State* L) {
+    glm::mat4& m = selfMat4(L);
+    int column = static_cast<int>(luaL_checkinteger(L, 2));
+    int row = static_cast<int>(luaL_checkinteger(L, 3));
+    luaL_argcheck(L, column >= 1 && column <= 4, 2, "column out of range");
+    luaL_argcheck(L, row >= 1 && row <= 4, 3, "row out of range");
+    m[column - 1][row - 1] = checkScalar(L, 4);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int mat4Set(lua_State* L) {
+    selfMat4(L) = LuaMath::checkMat4(L, 2);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int mat4IdentityInPlace(lua_State* L) {
+    selfMat4(L) = glm::mat4(1.0f);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int mat4InverseInPlace(lua_State* L) {
+    glm::mat4& m = selfMat4(L);
+    m = glm::inverse(m);
+    lua_settop(L, 1);
+    return 1;
+}
+
+static int mat4MultiplyInPlace(lua_State* L) {
+    glm::mat4& m = selfMat4(L);
+    m = m * LuaMath::checkMat4(L, 2);
+    lua_settop(L, 1);
+    return 1;
+}
+
+// m:compose(translation, rotation, scale) - T * R * S, like Transform::getMatrix
+static int mat4ComposeInPlace(lua_State* L) {
+    glm::mat4& m = selfMat4(L);
+    glm::vec3 translation = *static_cast<glm::vec3*>(luaL_checkudata(L, 2, VEC3_METATABLE));
+    glm::quat rotation = LuaMath::checkQuat(L, 3);
+    glm::vec3 scale = *static_cast<glm::vec3*>(luaL_checkudata(L, 4, VEC3_METATABLE));
+    m = glm::translate(glm::mat4(1.0f), translation) * glm::mat4_cast(rotation) * glm::scale(glm::mat4(1.0f), scale);
+    lua_settop(L, 1);
+    return 1;
+}
+
+// m:transformPoint(v [, out]) / m:transformDirection(v [, out])
+static int mat4TransformPoint(lua_State* L) {
+    glm::mat4& m = selfMat4(L);
+    glm::vec3 v = *static_cast<glm::vec3*>(luaL_checkudata(L, 2, VEC3_METATABLE));
+    glm::vec3 result(m * glm::vec4(v, 1.0f));
+    glm::vec3* out = LuaMath::toVec3(L, 3);
+    if (out) {
+        *out = result;
+        lua_settop(L, 3);
+    } else {
+        LuaMath::pushVec3(L, result);
+    }
+    return 1;
+}
+
+static int mat4TransformDirection(lua_State* L) {
+    glm::mat4& m = selfMat4(L);
+    glm::vec3 v = *static_cast<glm::vec3*>(luaL_checkudata(L, 2, VEC3_METATABLE));
+    glm::vec3 result(m * glm::vec4(v, 0.0f));
+    glm::vec3* out = LuaMath::toVec3(L, 3);
+    if (out) {
+        *out = result;
+        lua_settop(L, 3);
+    } else {
+        LuaMath::pushVec3(L, result);
+    }
+    return 1;
+}
+
+static int mat4GetTranslation(lua_State* L) {
+    return LuaMath::returnVec3(L, glm::vec3(selfMat4(L)[3]), 2);
+}
+
+static int mat4Clone(lua_State* L) {
+    LuaMath::pushMat4(L, selfMat4(L));
+    return 1;
+}
+
+// mat4() identity, mat4(other)
+static int mat4New(lua_State* L) {
+    if (lua_gettop(L) >= 2) {
+        LuaMath::pushMat4(L, LuaMath::checkMat4(L, 2));
+    } else {
+        LuaMath::pushMat4(L, glm::mat4(1.0f));
+    }
+    return 1;
+}
+
+void LuaMath::registerMat4(lua_State* L) {
+    static const luaL_Reg metamethods[] = {
+        { "__mul", mat4Mul },
+        { "__eq", mat4Eq },
+        { "__tostring", mat4ToString },
+        { nullptr, nullptr }
+    };
+    static const luaL_Reg methods[] = {
+        { "get", mat4Get },
+        { "setElement", mat4SetElement },
+        { "set", mat4Set },
+        { "identity", mat4IdentityInPlace },
+        { "inverse", mat4InverseInPlace },
+        { "multiply", mat4MultiplyInPlace },
+        { "compose", mat4ComposeInPlace },
+        { "transformPoint", mat4TransformPoint },
+        { "transformDirection", mat4TransformDirection },
+        { "getTranslation", mat4GetTranslation },
+        { "clone", mat4Clone },
+        { nullptr, nullptr }
+    };
+    newMetatable(L, MAT4_METATABLE, metamethods, methods, mat4Index);
+    newConstructor(L, "mat4", mat4New, nullptr);
+}
+
+void LuaMath::registerTypes(lua_State* L) {
+    if (!L) {
+        return;
+    }
+    registerVec3(L);
+    registerQuat(L);
+    registerMat4(L);
+}
+
+} // namespace GameEngine
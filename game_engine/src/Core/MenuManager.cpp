@@ -4,6 +4,7 @@
 #include "Core/Engine.h"
 #include "Core/Time.h"
 #include "Core/ScriptManager.h"
+#include "Components/ScriptComponent.h"
 #include "Input/InputManager.h"
 #include <iostream>
 
@@ -147,7 +148,7 @@ void MenuManager::showMenu(const std::string& menuId) {
     }
     
     if (!menu.onShowCallback.empty()) {
-        callMenuCallback(menu.onShowCallback, menuId);
+        callMenuCallback(menu.callbackOwner, menu.onShowCallback, menuId);
     }
     
     std::cout << "MenuManager: Showing menu '" << menuId << "'" << std::endl;
@@ -190,7 +191,7 @@ void MenuManager::hideMenu(const std::string& menuId) {
     }
     
     if (!menu.onHideCallback.empty()) {
-        callMenuCallback(menu.onHideCallback, menuId);
+        callMenuCallback(menu.callbackOwner, menu.onHideCallback, menuId);
     }
     
     std::cout << "MenuManager: Hiding menu '" << menuId << "'" << std::endl;
@@ -299,9 +300,15 @@ void MenuManager::activateSelectedItem(const std::string& menuId) {
         return;
     }
     
-    if (!item.action.empty()) {
+    if (!item.action.empty() && item.actionOwner) {
+        // Script functions live in the script's own environment, not _G.
+        // Copies, since the action may change the menu's items
+        std::string action = item.action;
+        std::string itemId = item.id;
+        item.actionOwner->callScriptFunction(action, menuId, itemId);
+    } else if (!item.action.empty()) {
         if (!luaState) {
-            luaState = ScriptManager::getInstance().getGlobalLuaState();
+            luaState = ScriptManager::getInstance().getComponentLuaState();
         }
         
         if (luaState) {
@@ -341,7 +348,7 @@ void MenuManager::update(float deltaTime) {
     for (const auto& menuId : visibleMenuStack) {
         auto it = menus.find(menuId);
         if (it != menus.end() && !it->second.onUpdateCallback.empty()) {
-            callMenuCallback(it->second.onUpdateCallback, menuId);
+            callMenuCallback(it->second.callbackOwner, it->second.onUpdateCallback, menuId);
         }
     }
 }
@@ -428,9 +435,15 @@ void MenuManager::handleMenuInput() {
     }
 }
 
-void MenuManager::callMenuCallback(const std::string& callbackName, const std::string& menuId) {
+void MenuManager::callMenuCallback(ScriptComponent* owner, const std::string& callbackName, const std::string& menuId) {
+    if (owner && !callbackName.empty()) {
+        std::string name = callbackName;
+        owner->callScriptFunction(name, menuId);
+        return;
+    }
+    
     if (!luaState) {
-        luaState = ScriptManager::getInstance().getGlobalLuaState();
+        luaState = ScriptManager::getInstance().getComponentLuaState();
     }
     
     if (!luaState || callbackName.empty()) {
@@ -464,6 +477,32 @@ std::vector<std::string> MenuManager::getVisibleMenus() const {
     return visibleMenuStack;
 }
 
+// The ScriptComponent whose code is calling into the bindings, if any
+static ScriptComponent* currentScript(lua_State* L) {
+    lua_getglobal(L, "_currentScriptComponent");
+    ScriptComponent* script = static_cast<ScriptComponent*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+    return script;
+}
+
+void MenuManager::releaseScript(ScriptComponent* script) {
+    for (auto& pair : menus) {
+        Menu& menu = pair.second;
+        for (MenuItem& item : menu.items) {
+            if (item.actionOwner == script) {
+                item.action.clear();
+                item.actionOwner = nullptr;
+            }
+        }
+        if (menu.callbackOwner == script) {
+            menu.onShowCallback.clear();
+            menu.onHideCallback.clear();
+            menu.onUpdateCallback.clear();
+            menu.callbackOwner = nullptr;
+        }
+    }
+}
+
 void MenuManager::bindToLua(lua_State* L) {
     if (!L) {
         return;
@@ -520,6 +559,7 @@ void MenuManager::bindToLua(lua_State* L) {
         item.id = itemId;
         item.text = text;
         item.action = action;
+        item.actionOwner = currentScript(L);
         
         if (lua_istable(L, 5)) {
             lua_getfield(L, 5, "x");
@@ -547,6 +587,10 @@ void MenuManager::bindToLua(lua_State* L) {
             menu->pauseGame = lua_toboolean(L, 2);
         }
         
+        if (lua_isstring(L, 3) || lua_isstring(L, 4) || lua_isstring(L, 5)) {
+            menu->callbackOwner = currentScript(L);
+        }
+        
         if (lua_isstring(L, 3)) {
             menu->onShowCallback = lua_tostring(L, 3);
         }
@@ -0,0 +1,328 @@
+#include "Core/Profiler.h"
+#include "../../vendor/json/single_include/nlohmann/json.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <unordered_set>
+
+#ifdef VITA_BUILD
+#include <psp2/kernel/processmgr.h>
+#else
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace GameEngine {
+
+const uint32_t Profiler::ZONE_CAPACITY;
+const uint32_t Profiler::FRAME_CAPACITY;
+const uint32_t Profiler::MAX_THREADS;
+const uint32_t Profiler::MAX_DEPTH;
+const uint32_t Profiler::HITCH_FRAMES;
+
+struct ProfileThreadRing {
+    struct OpenZone {
+        const char* name;
+        uint64_t begin;
+        bool recorded;              // false if the profiler was off when it began
+    };
+
+    ProfileZoneRecord zones[Profiler::ZONE_CAPACITY];
+    std::atomic<uint64_t> head;     // zones ever written; the next goes to head % capacity
+    std::atomic<const char*> name;
+    uint32_t id;
+
+    // Only the owning thread touches these
+    OpenZone open[Profiler::MAX_DEPTH];
+    uint32_t depth;
+
+    ProfileThreadRing() : head(0), name(nullptr), id(0), depth(0) {}
+};
+
+namespace {
+
+const uint64_t ZONE_MASK = Profiler::ZONE_CAPACITY - 1;
+
+#ifdef VITA_BUILD
+const SceUInt64 processStart = sceKernelGetProcessTimeWide();
+#else
+const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+#endif
+
+// Rings live until exit, so a capture can still read one whose thread ended
+thread_local ProfileThreadRing* threadRing = nullptr;
+thread_local bool threadRingUnavailable = false;
+thread_local const char* threadName = nullptr;
+
+nlohmann::json makeEvent(const char* phase, const char* name, uint32_t tid) {
+    nlohmann::json event;
+    event["ph"] = phase;
+    event["name"] = name;
+    event["pid"] = 1;
+    event["tid"] = tid;
+    return event;
+}
+
+} // namespace
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler()
+    : enabled(true)
+    , ringCount(0)
+    , frameCount(0)
+    , hitchThresholdMs(0.0f)
+    , hitchCount(0)
+    , skipHitchCheck(false)
+{
+    for (uint32_t i = 0; i < MAX_THREADS; ++i) {
+        rings[i].store(nullptr, std::memory_order_relaxed);
+    }
+    std::fill(frameBegins, frameBegins + FRAME_CAPACITY, 0);
+}
+
+uint64_t Profiler::getTime() {
+#ifdef VITA_BUILD
+    return (sceKernelGetProcessTimeWide() - processStart) * 1000;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - processStart).count();
+#endif
+}
+
+const char* Profiler::internName(const std::string& name) {
+    static std::mutex mutex;
+    static std::unordered_set<std::string> names;
+    std::lock_guard<std::mutex> lock(mutex);
+    return names.insert(name).first->c_str();
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    threadName = internName(name);
+    ProfileThreadRing* ring = getThreadRing(true);
+    if (ring) {
+        ring->name.store(threadName, std::memory_order_release);
+    }
+}
+
+ProfileThreadRing* Profiler::getThreadRing(bool create) {
+    if (threadRing || !create || threadRingUnavailable) {
+        return threadRing;
+    }
+
+    uint32_t slot = ringCount.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= MAX_THREADS) {
+        threadRingUnavailable = true;
+        return nullptr;
+    }
+
+    ProfileThreadRing* ring = new ProfileThreadRing();
+    ring->id = slot;
+    ring->name.store(threadName ? threadName : internName("Thread " + std::to_string(slot)),
+                     std::memory_order_relaxed);
+    rings[slot].store(ring, std::memory_order_release);
+    threadRing = ring;
+    return ring;
+}
+
+void Profiler::beginZone(const char* name) {
+    bool record = isEnabled();
+    ProfileThreadRing* ring = getThreadRing(record);
+    if (!ring) {
+        return;
+    }
+
+    // Zones too deep still count, so their ends pair up with the right begins
+    uint32_t depth = ring->depth++;
+    if (depth < MAX_DEPTH) {
+        ProfileThreadRing::OpenZone& zone = ring->open[depth];
+        zone.name = name;
+        zone.recorded = record;
+        zone.begin = record ? getTime() : 0;
+    }
+}
+
+void Profiler::endZone() {
+    ProfileThreadRing* ring = getThreadRing(false);
+    if (!ring || ring->depth == 0) {
+        // Began before this thread's first recorded zone
+        return;
+    }
+
+    uint32_t depth = --ring->depth;
+    if (depth >= MAX_DEPTH || !ring->open[depth].recorded) {
+        return;
+    }
+
+    const ProfileThreadRing::OpenZone& zone = ring->open[depth];
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    ProfileZoneRecord& record = ring->zones[head & ZONE_MASK];
+    record.name = zone.name;
+    record.begin = zone.begin;
+    record.end = getTime();
+    record.depth = depth;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::markFrame() {
+    frameBegins[frameCount % FRAME_CAPACITY] = getTime();
+    frameCount++;
+    checkHitch();
+}
+
+float Profiler::getLastFrameMs() const {
+    if (frameCount < 2) {
+        return 0.0f;
+    }
+    uint64_t begin = frameBegins[(frameCount - 2) % FRAME_CAPACITY];
+    uint64_t end = frameBegins[(frameCount - 1) % FRAME_CAPACITY];
+    return static_cast<float>(end - begin) / 1.0e6f;
+}
+
+void Profiler::capture(uint32_t count, ProfileCapture& out) const {
+    out.clear();
+
+    // The frame in progress has no end yet
+    uint64_t whole = frameCount > 0 ? frameCount - 1 : 0;
+    uint64_t frames = std::min<uint64_t>(count, std::min<uint64_t>(whole, FRAME_CAPACITY - 1));
+    for (uint64_t i = whole - frames; i < whole; ++i) {
+        ProfileFrameRecord frame;
+        frame.index = i;
+        frame.begin = frameBegins[i % FRAME_CAPACITY];
+        frame.end = frameBegins[(i + 1) % FRAME_CAPACITY];
+        out.frames.push_back(frame);
+    }
+    if (out.frames.empty()) {
+        return;
+    }
+
+    const uint64_t begin = out.getBegin();
+    const uint64_t end = out.getEnd();
+    std::vector<uint64_t> indices;
+    uint32_t threads = std::min(ringCount.load(std::memory_order_acquire), MAX_THREADS);
+    for (uint32_t t = 0; t < threads; ++t) {
+        const ProfileThreadRing* ring = rings[t].load(std::memory_order_acquire);
+        if (!ring) {
+            continue;
+        }
+
+        ProfileThreadCapture thread;
+        thread.name = ring->name.load(std::memory_order_acquire);
+        thread.id = ring->id;
+
+        indices.clear();
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (uint64_t i = head > ZONE_CAPACITY ? head - ZONE_CAPACITY : 0; i < head; ++i) {
+            const ProfileZoneRecord& record = ring->zones[i & ZONE_MASK];
+            if (record.end >= begin && record.begin <= end) {
+                thread.zones.push_back(record);
+                indices.push_back(i);
+            }
+        }
+
+        // Anything the writer may have reached while we copied is dropped,
+        // including the slot it could be halfway through
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = ring->head.load(std::memory_order_relaxed);
+        uint64_t firstValid = after >= ZONE_CAPACITY ? after - ZONE_CAPACITY + 1 : 0;
+        size_t kept = 0;
+        for (size_t i = 0; i < indices.size(); ++i) {
+            if (indices[i] >= firstValid) {
+                thread.zones[kept++] = thread.zones[i];
+            }
+        }
+        thread.zones.resize(kept);
+
+        out.threads.push_back(thread);
+    }
+}
+
+void Profiler::setHitchThreshold(float milliseconds, const std::string& tracePath) {
+    hitchThresholdMs = std::max(0.0f, milliseconds);
+    hitchTracePath = tracePath;
+}
+
+void Profiler::checkHitch() {
+    if (hitchThresholdMs <= 0.0f || !isEnabled() || frameCount < 2) {
+        return;
+    }
+    if (skipHitchCheck) {
+        skipHitchCheck = false;
+        return;
+    }
+    if (getLastFrameMs() <= hitchThresholdMs) {
+        return;
+    }
+
+    hitchCount++;
+    capture(HITCH_FRAMES, lastHitch);
+    if (!hitchTracePath.empty()) {
+        PROFILE_ZONE("Profiler::saveHitch");
+        saveChromeTrace(lastHitch, hitchTracePath);
+        skipHitchCheck = true;
+    }
+}
+
+std::string Profiler::toChromeTrace(const ProfileCapture& capture) {
+    // Timestamps are microseconds. Frames get a lane of their own above the threads
+    nlohmann::json events = nlohmann::json::array();
+
+    nlohmann::json process = makeEvent("M", "process_name", 0);
+    process["args"]["name"] = "Engine";
+    events.push_back(process);
+
+    nlohmann::json framesLane = makeEvent("M", "thread_name", 0);
+    framesLane["args"]["name"] = "Frames";
+    events.push_back(framesLane);
+    for (const auto& frame : capture.frames) {
+        std::string name = "Frame " + std::to_string(frame.index);
+        nlohmann::json event = makeEvent("X", name.c_str(), 0);
+        event["ts"] = frame.begin / 1000.0;
+        event["dur"] = (frame.end - frame.begin) / 1000.0;
+        events.push_back(event);
+    }
+
+    for (const auto& thread : capture.threads) {
+        uint32_t tid = thread.id + 1;
+        nlohmann::json threadName = makeEvent("M", "thread_name", tid);
+        threadName["args"]["name"] = thread.name;
+        events.push_back(threadName);
+        nlohmann::json sortIndex = makeEvent("M", "thread_sort_index", tid);
+        sortIndex["args"]["sort_index"] = tid;
+        events.push_back(sortIndex);
+
+        for (const auto& zone : thread.zones) {
+            nlohmann::json event = makeEvent("X", zone.name, tid);
+            event["ts"] = zone.begin / 1000.0;
+            event["dur"] = (zone.end - zone.begin) / 1000.0;
+            events.push_back(event);
+        }
+    }
+
+    nlohmann::json trace;
+    trace["traceEvents"] = events;
+    trace["displayTimeUnit"] = "ms";
+    // Zone names may be script paths; bad UTF-8 is replaced rather than thrown on
+    return trace.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+bool Profiler::saveChromeTrace(const ProfileCapture& capture, const std::string& path) {
+    std::string trace = toChromeTrace(capture);
+    FILE* file = fopen(path.c_str(), "wb");
+    bool written = file && fwrite(trace.data(), 1, trace.size(), file) == trace.size();
+    if (file) {
+        written = fclose(file) == 0 && written;
+    }
+    if (!written) {
+#ifdef VITA_BUILD
+        printf("Profiler: Failed to write trace: %s\n", path.c_str());
+#else
+        std::cerr << "Profiler: Failed to write trace: " << path << std::endl;
+#endif
+    }
+    return written;
+}
+
+} // namespace GameEngine
@@ -1,23 +1,15 @@
 #include "Core/ScriptManager.h"
-#include "Input/InputManager.h"
-#include "Physics/PhysicsManager.h"
-#include "Rendering/Renderer.h"
-#include "Scene/SceneManager.h"
-#include "Scene/Scene.h"
-#include "Components/CameraComponent.h"
-#include "Core/Engine.h"
-#include "Core/MenuManager.h"
+#include "Scene/SceneNode.h"
+#include "Core/Profiler.h"
+#include "Core/Stats.h"
+#include "Core/Log.h"
+#include "Components/ScriptComponent.h"
 #include <iostream>
 #include <ctime>
-#include <cmath>
-#include <cstring>
+#include <chrono>
+#include <algorithm>
 #ifndef VITA_BUILD
 #include <filesystem>
-#include <chrono>
-#endif
-
-#ifdef LINUX_BUILD
-    #include <GLFW/glfw3.h>
 #endif
 
 // Lua includes
@@ -39,7 +31,16 @@ ScriptManager& ScriptManager::getInstance() {
 }
 
 ScriptManager::ScriptManager()
-    : globalLuaState(nullptr)
+    : componentLuaState(nullptr)
+    , dispatchingScripts(false)
+    , scriptComponentsDirty(false)
+    , lastScriptUpdateMs(0.0)
+    , gcPause(200)
+    , gcStepMul(200)
+    , gcBudgetMs(0.0)
+    , gcMemoryLimitKB(16 * 1024)
+    , lastGCStepMs(0.0)
+    , fullCollectionCount(0)
     , scriptDirectory("scripts/")
     , hotReloadEnabled(false)
     , initialized(false)
@@ -62,12 +63,11 @@ bool ScriptManager::initialize() {
     std::cout << "ScriptManager: Initializing..." << std::endl;
 #endif
     
-    if (!initializeLua()) {
+    // One VM for every script; ScriptComponents bind the engine into it
+    if (!getComponentLuaState()) {
         return false;
     }
     
-    bindEngineSystems();
-    
     initialized = true;
     std::cout << "ScriptManager: Successfully initialized" << std::endl;
     return true;
@@ -87,14 +87,14 @@ void ScriptManager::shutdown() {
 }
 
 bool ScriptManager::executeScript(const std::string& scriptPath) {
-    if (!globalLuaState || !initialized) {
+    if (!componentLuaState || !initialized) {
         std::cerr << "ScriptManager: Cannot execute script - not initialized" << std::endl;
         return false;
     }
     
     std::cout << "ScriptManager: Executing script: " << scriptPath << std::endl;
     
-    int result = luaL_dofile(globalLuaState, scriptPath.c_str());
+    int result = luaL_dofile(componentLuaState, scriptPath.c_str());
     if (result != LUA_OK) {
         handleLuaError("executeScript: " + scriptPath);
         return false;
@@ -109,12 +109,12 @@ bool ScriptManager::executeScript(const std::string& scriptPath) {
 }
 
 bool ScriptManager::executeScriptString(const std::string& scriptCode) {
-    if (!globalLuaState || !initialized) {
+    if (!componentLuaState || !initialized) {
         std::cerr << "ScriptManager: Cannot execute script string - not initialized" << std::endl;
         return false;
     }
     
-    int result = luaL_dostring(globalLuaState, scriptCode.c_str());
+    int result = luaL_dostring(componentLuaState, scriptCode.c_str());
     if (result != LUA_OK) {
         handleLuaError("executeScriptString");
         return false;
@@ -134,6 +134,7 @@ void ScriptManager::hotReloadScript(const std::string& scriptPath) {
     
     std::cout << "ScriptManager: Hot reloading script: " << scriptPath << std::endl;
     
+    invalidateCachedChunk(scriptPath);
     executeScript(scriptPath);
     
     scriptFileTimes[scriptPath] = getFileModificationTime(scriptPath);
@@ -149,862 +150,214 @@ void ScriptManager::hotReloadAllScripts() {
     }
 }
 
-void ScriptManager::watchScriptFile(const std::string& scriptPath) {
-    if (!hotReloadEnabled) {
-        return;
+lua_State* ScriptManager::getComponentLuaState() {
+    if (componentLuaState) {
+        return componentLuaState;
     }
     
-    scriptFileTimes[scriptPath] = getFileModificationTime(scriptPath);
-    std::cout << "ScriptManager: Watching script file: " << scriptPath << std::endl;
-}
-
-void ScriptManager::unwatchScriptFile(const std::string& scriptPath) {
-    auto it = scriptFileTimes.find(scriptPath);
-    if (it != scriptFileTimes.end()) {
-        scriptFileTimes.erase(it);
-        std::cout << "ScriptManager: Stopped watching script file: " << scriptPath << std::endl;
+    componentLuaState = luaL_newstate();
+    if (!componentLuaState) {
+        std::cerr << "ScriptManager: Failed to create component Lua state" << std::endl;
+        return nullptr;
     }
-}
-
-void ScriptManager::bindEngineSystems() {
-    if (!globalLuaState) {
-        return;
-    }
-    
-#ifdef VITA_BUILD
-    printf("ScriptManager: Binding engine systems to Lua...\n");
-#else
-    std::cout << "ScriptManager: Binding engine systems to Lua..." << std::endl;
-#endif
     
-    bindCommonFunctions();
-    bindMathFunctions();
-    bindUtilityFunctions();
-    bindInputSystem();
-    bindPhysicsSystem();
-    bindRendererSystem();
-    bindSceneSystem();
-    bindPickupZoneSystem();
-    bindMenuSystem();
+    luaL_openlibs(componentLuaState);
+    lua_atpanic(componentLuaState, luaErrorHandler);
+    applyGCSettings();
     
-    std::cout << "ScriptManager: Engine systems bound to Lua" << std::endl;
+    std::cout << "ScriptManager: Component Lua state initialized" << std::endl;
+    return componentLuaState;
 }
 
-void ScriptManager::setErrorCallback(std::function<void(const std::string&)> callback) {
-    errorCallback = callback;
+static int writeChunk(lua_State* L, const void* data, size_t size, void* userData) {
+    static_cast<std::string*>(userData)->append(static_cast<const char*>(data), size);
+    return 0;
 }
 
-bool ScriptManager::initializeLua() {
-    globalLuaState = luaL_newstate();
-    if (!globalLuaState) {
-        std::cerr << "ScriptManager: Failed to create global Lua state" << std::endl;
+bool ScriptManager::loadCachedChunk(const std::string& scriptPath) {
+    lua_State* L = getComponentLuaState();
+    if (!L) {
         return false;
     }
     
-    luaL_openlibs(globalLuaState);
+    auto it = chunkCache.find(scriptPath);
+    if (it != chunkCache.end()) {
+        std::string chunkName = "@" + scriptPath;
+        return luaL_loadbufferx(L, it->second.data(), it->second.size(), chunkName.c_str(), "b") == LUA_OK;
+    }
     
-    lua_atpanic(globalLuaState, luaErrorHandler);
+    if (luaL_loadfile(L, scriptPath.c_str()) != LUA_OK) {
+        return false;
+    }
     
-    std::cout << "ScriptManager: Lua state initialized" << std::endl;
+    // Keep debug info so error messages still carry line numbers
+    std::string bytecode;
+    if (lua_dump(L, writeChunk, &bytecode, 0) == 0 && !bytecode.empty()) {
+        chunkCache[scriptPath] = bytecode;
+    }
     return true;
 }
 
-void ScriptManager::cleanupLua() {
-    if (globalLuaState) {
-        lua_close(globalLuaState);
-        globalLuaState = nullptr;
-    }
-    
-    scriptFileTimes.clear();
+void ScriptManager::invalidateCachedChunk(const std::string& scriptPath) {
+    chunkCache.erase(scriptPath);
 }
 
-void ScriptManager::bindCommonFunctions() {
-    if (!globalLuaState) {
-        return;
+void ScriptManager::registerScriptComponent(ScriptComponent* component) {
+    if (std::find(scriptComponents.begin(), scriptComponents.end(), component) == scriptComponents.end()) {
+        scriptComponents.push_back(component);
     }
-    
-    // Print function
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* message = lua_tostring(L, 1);
-        if (message) {
-#ifdef VITA_BUILD
-            // Use printf for Vita as std::cout might not work
-            printf("Lua: %s\n", message);
-#else
-            std::cout << "Lua: " << message << std::endl;
-#endif
-        }
-        return 0;
-    });
-    lua_setglobal(globalLuaState, "print");
-    
-    // Time functions
-#ifndef VITA_BUILD
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        auto now = std::chrono::high_resolution_clock::now();
-        auto duration = now.time_since_epoch();
-        auto seconds = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() / 1000.0;
-        lua_pushnumber(L, seconds);
-        return 1;
-    });
-    lua_setglobal(globalLuaState, "getTime");
-#else
-    // Vita build - simplified time function
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        lua_pushnumber(L, 0.0); // Placeholder time
-        return 1;
-    });
-    lua_setglobal(globalLuaState, "getTime");
-#endif
-    
-    lua_newtable(globalLuaState);
-    lua_pushnumber(globalLuaState, 0);
-    lua_setfield(globalLuaState, -2, "score");
-    lua_setglobal(globalLuaState, "gameState");
-    
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-#ifndef VITA_BUILD
-        auto now = std::chrono::high_resolution_clock::now();
-        auto duration = now.time_since_epoch();
-        auto seconds = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() / 1000.0;
-#else
-        double seconds = 0.0;
-#endif
-        
-        float x = std::sin(seconds * 0.5) * 3;
-        float y = 2 + std::sin(seconds * 2) * 0.5;
-        float z = std::cos(seconds * 0.3) * 2;
-        
-        lua_pushnumber(L, x);
-        lua_pushnumber(L, y);
-        lua_pushnumber(L, z);
-        return 3;
-    });
-    lua_setglobal(globalLuaState, "getCameraPosition");
-    
 }
 
-void ScriptManager::bindMathFunctions() {
-    if (!globalLuaState) {
+void ScriptManager::unregisterScriptComponent(ScriptComponent* component) {
+    auto it = std::find(scriptComponents.begin(), scriptComponents.end(), component);
+    if (it == scriptComponents.end()) {
         return;
     }
     
-    lua_newtable(globalLuaState);
-    
-    lua_pushstring(globalLuaState, "vec3");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        float x = luaL_optnumber(L, 1, 0.0);
-        float y = luaL_optnumber(L, 2, 0.0);
-        float z = luaL_optnumber(L, 3, 0.0);
-        
-        lua_newtable(L);
-        lua_pushstring(L, "x");
-        lua_pushnumber(L, x);
-        lua_settable(L, -3);
-        lua_pushstring(L, "y");
-        lua_pushnumber(L, y);
-        lua_settable(L, -3);
-        lua_pushstring(L, "z");
-        lua_pushnumber(L, z);
-        lua_settable(L, -3);
-        
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_setglobal(globalLuaState, "math");
+    if (dispatchingScripts) {
+        *it = nullptr;
+        scriptComponentsDirty = true;
+    } else {
+        scriptComponents.erase(it);
+    }
 }
 
-void ScriptManager::bindUtilityFunctions() {
-    if (!globalLuaState) {
-        return;
+static bool isActiveUnder(const SceneNode* node, const SceneNode* root) {
+    for (; node; node = node->getParent()) {
+        if (!node->isActive()) {
+            return false;
+        }
+        if (node == root) {
+            return true;
+        }
     }
-    
-    lua_newtable(globalLuaState);
-    
-    // Random functions
-    lua_pushstring(globalLuaState, "random");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        float min = luaL_optnumber(L, 1, 0.0);
-        float max = luaL_optnumber(L, 2, 1.0);
-        float result = min + (max - min) * (rand() / (float)RAND_MAX);
-        lua_pushnumber(L, result);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_setglobal(globalLuaState, "util");
+    return false;
 }
 
-void ScriptManager::bindInputSystem() {
-    if (!globalLuaState) {
-        std::cout << "ScriptManager: ERROR - globalLuaState is null, cannot bind input system!" << std::endl;
-        return;
-    }
-    
-#ifdef VITA_BUILD
-    printf("ScriptManager: Binding input system to Lua...\n");
-#else
-    std::cout << "ScriptManager: Binding input system to Lua..." << std::endl;
-#endif
+void ScriptManager::updateScriptComponents(SceneNode* sceneRoot, float deltaTime, bool paused) {
+    PROFILE_ZONE("ScriptManager::updateScriptComponents");
+    auto begin = std::chrono::high_resolution_clock::now();
     
-    lua_newtable(globalLuaState);
-    
-    // Action-based input functions
-    lua_pushstring(globalLuaState, "isActionPressed");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* actionName = luaL_checkstring(L, 1);
-        auto& inputManager = GetEngine().getInputManager();
-        bool result = inputManager.isActionPressed(actionName);
-        lua_pushboolean(L, result);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "isActionHeld");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* actionName = luaL_checkstring(L, 1);
-        std::cout << "ScriptManager: isActionHeld called for action: " << actionName << std::endl;
-        auto& inputManager = GetEngine().getInputManager();
-        bool result = inputManager.isActionHeld(actionName);
-        lua_pushboolean(L, result);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "isActionReleased");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* actionName = luaL_checkstring(L, 1);
-        auto& inputManager = GetEngine().getInputManager();
-        bool result = inputManager.isActionReleased(actionName);
-        lua_pushboolean(L, result);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "getActionAxis");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* actionName = luaL_checkstring(L, 1);
-        std::cout << "ScriptManager: getActionAxis called for action: " << actionName << std::endl;
-        auto& inputManager = GetEngine().getInputManager();
-        float result = inputManager.getActionAxis(actionName);
-        lua_pushnumber(L, result);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "getActionVector2");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* actionName = luaL_checkstring(L, 1);
-        auto& inputManager = GetEngine().getInputManager();
-        glm::vec2 result = inputManager.getActionVector2(actionName);
-        lua_pushnumber(L, result.x);
-        lua_pushnumber(L, result.y);
-        return 2;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    // Legacy direct input functions (for backward compatibility)
-    lua_pushstring(globalLuaState, "isKeyPressed");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* keyName = luaL_checkstring(L, 1);
-        auto& inputManager = GetEngine().getInputManager();
-        
-#ifdef LINUX_BUILD
-        // Map string keys to GLFW codes
-        int keyCode = 0;
-        if (strcmp(keyName, "W") == 0) keyCode = GLFW_KEY_W;
-        else if (strcmp(keyName, "A") == 0) keyCode = GLFW_KEY_A;
-        else if (strcmp(keyName, "S") == 0) keyCode = GLFW_KEY_S;
-        else if (strcmp(keyName, "D") == 0) keyCode = GLFW_KEY_D;
-        else if (strcmp(keyName, "SPACE") == 0) keyCode = GLFW_KEY_SPACE;
-        else if (strcmp(keyName, "SHIFT") == 0) keyCode = GLFW_KEY_LEFT_SHIFT;
-        else if (strcmp(keyName, "LEFT") == 0) keyCode = GLFW_KEY_LEFT;
-        else if (strcmp(keyName, "RIGHT") == 0) keyCode = GLFW_KEY_RIGHT;
-        else if (strcmp(keyName, "UP") == 0) keyCode = GLFW_KEY_UP;
-        else if (strcmp(keyName, "DOWN") == 0) keyCode = GLFW_KEY_DOWN;
-        
-        bool result = inputManager.isKeyPressed(keyCode);
-        lua_pushboolean(L, result);
-#else
-        lua_pushboolean(L, false);
-#endif
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "isKeyDown");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* keyName = luaL_checkstring(L, 1);
-        auto& inputManager = GetEngine().getInputManager();
-        
-#ifdef LINUX_BUILD
-        // Map string keys to GLFW codes
-        int keyCode = 0;
-        if (strcmp(keyName, "W") == 0) keyCode = GLFW_KEY_W;
-        else if (strcmp(keyName, "A") == 0) keyCode = GLFW_KEY_A;
-        else if (strcmp(keyName, "S") == 0) keyCode = GLFW_KEY_S;
-        else if (strcmp(keyName, "D") == 0) keyCode = GLFW_KEY_D;
-        else if (strcmp(keyName, "SPACE") == 0) keyCode = GLFW_KEY_SPACE;
-        else if (strcmp(keyName, "SHIFT") == 0) keyCode = GLFW_KEY_LEFT_SHIFT;
-        else if (strcmp(keyName, "LEFT") == 0) keyCode = GLFW_KEY_LEFT;
-        else if (strcmp(keyName, "RIGHT") == 0) keyCode = GLFW_KEY_RIGHT;
-        else if (strcmp(keyName, "UP") == 0) keyCode = GLFW_KEY_UP;
-        else if (strcmp(keyName, "DOWN") == 0) keyCode = GLFW_KEY_DOWN;
-        else if (strcmp(keyName, "ENTER") == 0 || strcmp(keyName, "Return") == 0) keyCode = GLFW_KEY_ENTER;
-        
-        bool result = inputManager.isKeyHeld(keyCode);
-        lua_pushboolean(L, result);
-#else
-        lua_pushboolean(L, false);
-#endif
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    // Vita-specific functions
-    lua_pushstring(globalLuaState, "isButtonPressed");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        uint32_t button = (uint32_t)luaL_checkinteger(L, 1);
-        auto& inputManager = GetEngine().getInputManager();
-        bool result = inputManager.isButtonPressed(button);
-        lua_pushboolean(L, result);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "getLeftStick");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        auto& inputManager = GetEngine().getInputManager();
-        glm::vec2 stick = inputManager.getLeftStick();
-        lua_pushnumber(L, stick.x);
-        lua_pushnumber(L, stick.y);
-        return 2;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "getRightStick");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        auto& inputManager = GetEngine().getInputManager();
-        glm::vec2 stick = inputManager.getRightStick();
-        lua_pushnumber(L, stick.x);
-        lua_pushnumber(L, stick.y);
-        return 2;
-    });
-    lua_settable(globalLuaState, -3);
-    
-#ifdef LINUX_BUILD
-    // Mouse input functions (Linux only)
-    lua_pushstring(globalLuaState, "setMouseCapture");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        bool enabled = lua_toboolean(L, 1) != 0;
-        auto& inputManager = GetEngine().getInputManager();
-        inputManager.setMouseCapture(enabled);
-        return 0;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "isMouseCaptured");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        auto& inputManager = GetEngine().getInputManager();
-        bool result = inputManager.isMouseCaptured();
-        lua_pushboolean(L, result);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "setDebugMouseInput");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        bool enabled = lua_toboolean(L, 1) != 0;
-        auto& inputManager = GetEngine().getInputManager();
-        inputManager.setDebugMouseInput(enabled);
-        std::cout << "Lua: setDebugMouseInput(" << (enabled ? "true" : "false") << ")" << std::endl;
-        return 0;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "getMousePosition");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        auto& inputManager = GetEngine().getInputManager();
-        glm::vec2 pos = inputManager.getMousePosition();
-        lua_pushnumber(L, pos.x);
-        lua_pushnumber(L, pos.y);
-        return 2;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "getMouseDelta");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        auto& inputManager = GetEngine().getInputManager();
-        glm::vec2 delta = inputManager.getMouseDelta();
-        lua_pushnumber(L, delta.x);
-        lua_pushnumber(L, delta.y);
-        return 2;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "isMouseButtonPressed");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* buttonName = luaL_checkstring(L, 1);
-        auto& inputManager = GetEngine().getInputManager();
-        
-        // Map button names to GLFW button codes
-        int button = GLFW_MOUSE_BUTTON_LEFT; // Default to left button
-        if (strcmp(buttonName, "LEFT") == 0 || strcmp(buttonName, "0") == 0) {
-            button = GLFW_MOUSE_BUTTON_LEFT;
-        } else if (strcmp(buttonName, "RIGHT") == 0 || strcmp(buttonName, "1") == 0) {
-            button = GLFW_MOUSE_BUTTON_RIGHT;
-        } else if (strcmp(buttonName, "MIDDLE") == 0 || strcmp(buttonName, "2") == 0) {
-            button = GLFW_MOUSE_BUTTON_MIDDLE;
-        } else {
-            // Try to parse as number
-            button = (int)luaL_optnumber(L, 1, GLFW_MOUSE_BUTTON_LEFT);
+    dispatchingScripts = true;
+    // Indexed loop: scripts may load other scripts (push_back) while we iterate
+    for (size_t i = 0; i < scriptComponents.size(); ++i) {
+        ScriptComponent* component = scriptComponents[i];
+        if (!component || !component->isEnabled()) {
+            continue;
         }
-        
-        bool result = inputManager.isMouseButtonPressed(button);
-        lua_pushboolean(L, result);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "isMouseButtonHeld");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* buttonName = luaL_checkstring(L, 1);
-        auto& inputManager = GetEngine().getInputManager();
-        
-        // Map button names to GLFW button codes
-        int button = GLFW_MOUSE_BUTTON_LEFT; // Default to left button
-        if (strcmp(buttonName, "LEFT") == 0 || strcmp(buttonName, "0") == 0) {
-            button = GLFW_MOUSE_BUTTON_LEFT;
-        } else if (strcmp(buttonName, "RIGHT") == 0 || strcmp(buttonName, "1") == 0) {
-            button = GLFW_MOUSE_BUTTON_RIGHT;
-        } else if (strcmp(buttonName, "MIDDLE") == 0 || strcmp(buttonName, "2") == 0) {
-            button = GLFW_MOUSE_BUTTON_MIDDLE;
-        } else {
-            // Try to parse as number
-            button = (int)luaL_optnumber(L, 1, GLFW_MOUSE_BUTTON_LEFT);
+        if (paused && !component->isPauseExempt()) {
+            continue;
         }
-        
-        bool result = inputManager.isMouseButtonHeld(button);
-        lua_pushboolean(L, result);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "isMouseButtonReleased");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* buttonName = luaL_checkstring(L, 1);
-        auto& inputManager = GetEngine().getInputManager();
-        
-        // Map button names to GLFW button codes
-        int button = GLFW_MOUSE_BUTTON_LEFT; // Default to left button
-        if (strcmp(buttonName, "LEFT") == 0 || strcmp(buttonName, "0") == 0) {
-            button = GLFW_MOUSE_BUTTON_LEFT;
-        } else if (strcmp(buttonName, "RIGHT") == 0 || strcmp(buttonName, "1") == 0) {
-            button = GLFW_MOUSE_BUTTON_RIGHT;
-        } else if (strcmp(buttonName, "MIDDLE") == 0 || strcmp(buttonName, "2") == 0) {
-            button = GLFW_MOUSE_BUTTON_MIDDLE;
-        } else {
-            // Try to parse as number
-            button = (int)luaL_optnumber(L, 1, GLFW_MOUSE_BUTTON_LEFT);
+        if (!isActiveUnder(component->getOwner(), sceneRoot)) {
+            continue;
         }
-        
-        bool result = inputManager.isMouseButtonReleased(button);
-        lua_pushboolean(L, result);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "getMouseWheel");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        auto& inputManager = GetEngine().getInputManager();
-        float wheel = inputManager.getMouseWheel();
-        lua_pushnumber(L, wheel);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-#endif
-    
-    lua_setglobal(globalLuaState, "input");
-    
-    // Quit game function
-    lua_pushstring(globalLuaState, "quitGame");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        auto& engine = GetEngine();
-        engine.setRunning(false);
-        return 0;
-    });
-    lua_setglobal(globalLuaState, "quitGame");
-    
-    // Verify the input table was set correctly
-    lua_getglobal(globalLuaState, "input");
-    if (lua_istable(globalLuaState, -1)) {
-#ifdef VITA_BUILD
-        printf("ScriptManager: Input table verified as table in global scope\n");
-#else
-        std::cout << "ScriptManager: Input table verified as table in global scope" << std::endl;
-#endif
-    } else {
-#ifdef VITA_BUILD
-        printf("ScriptManager: ERROR - Input table is NOT a table! Type: %s\n", lua_typename(globalLuaState, -1));
-#else
-        std::cout << "ScriptManager: ERROR - Input table is NOT a table! Type: " << lua_typename(globalLuaState, -1) << std::endl;
-#endif
+        component->update(deltaTime);
     }
-    lua_pop(globalLuaState, 1); // Remove the table from stack
+    dispatchingScripts = false;
     
-#ifdef VITA_BUILD
-    printf("ScriptManager: Input system bound to Lua successfully!\n");
-#else
-    std::cout << "ScriptManager: Input system bound to Lua successfully!" << std::endl;
-#endif
-}
-
-void ScriptManager::bindPhysicsSystem() {
-    if (!globalLuaState) {
-        return;
+    if (scriptComponentsDirty) {
+        scriptComponents.erase(std::remove(scriptComponents.begin(), scriptComponents.end(), nullptr),
+                               scriptComponents.end());
+        scriptComponentsDirty = false;
     }
     
-    lua_newtable(globalLuaState);
+    lastScriptUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
     
-    lua_pushstring(globalLuaState, "addForce");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        return 0;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "setVelocity");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        return 0;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_setglobal(globalLuaState, "physics");
+    static Stat& luaMemory = Stats::getInstance().getGauge("Lua memory (KB)");
+    luaMemory.set(componentLuaState ? lua_gc(componentLuaState, LUA_GCCOUNT, 0) : 0);
+}
+
+void ScriptManager::setScriptGCParameters(int pause, int stepMul) {
+    gcPause = pause;
+    gcStepMul = stepMul;
+    applyGCSettings();
+}
+
+void ScriptManager::setScriptGCBudget(double milliseconds) {
+    gcBudgetMs = milliseconds > 0.0 ? milliseconds : 0.0;
+    applyGCSettings();
 }
 
-void ScriptManager::bindRendererSystem() {
-    if (!globalLuaState) {
+void ScriptManager::setScriptMemoryLimit(int kilobytes) {
+    gcMemoryLimitKB = kilobytes > 0 ? kilobytes : 0;
+}
+
+void ScriptManager::applyGCSettings() {
+    if (!componentLuaState) {
         return;
     }
     
-    lua_newtable(globalLuaState);
-    
-    lua_pushstring(globalLuaState, "drawText");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        return 0;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_setglobal(globalLuaState, "renderer");
+    lua_gc(componentLuaState, LUA_GCSETPAUSE, gcPause);
+    lua_gc(componentLuaState, LUA_GCSETSTEPMUL, gcStepMul);
+    // With a budget the collector only runs from stepScriptGC, never in the
+    // middle of a script callback
+    lua_gc(componentLuaState, gcBudgetMs > 0.0 ? LUA_GCSTOP : LUA_GCRESTART, 0);
 }
 
-void ScriptManager::bindSceneSystem() {
-    if (!globalLuaState) {
+void ScriptManager::stepScriptGC() {
+    lastGCStepMs = 0.0;
+    if (!componentLuaState || gcBudgetMs <= 0.0) {
         return;
     }
     
-    lua_newtable(globalLuaState);
-    
-    lua_pushstring(globalLuaState, "findNode");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        lua_pushnil(L);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
+    PROFILE_ZONE("ScriptManager::stepScriptGC");
+    auto begin = std::chrono::high_resolution_clock::now();
     
-    lua_pushstring(globalLuaState, "setActiveCamera");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* cameraNodeName = luaL_checkstring(L, 1);
-        
-        if (!cameraNodeName) {
-            lua_pushboolean(L, false);
-            return 1;
-        }
-        
-        auto& engine = GetEngine();
-        auto& sceneManager = engine.getSceneManager();
-        auto activeScene = sceneManager.getCurrentScene();
-        
-        if (activeScene && cameraNodeName) {
-            auto cameraNode = activeScene->findNode(cameraNodeName);
-            if (cameraNode) {
-                auto cameraComponent = cameraNode->getComponent<CameraComponent>();
-                if (cameraComponent) {
-                    activeScene->setActiveCamera(cameraNode);
-                    lua_pushboolean(L, true);
-                    return 1;
-                } else {
-                    std::cout << "setActiveCamera: Node '" << cameraNodeName << "' does not have a CameraComponent" << std::endl;
-                }
-            } else {
-                std::cout << "setActiveCamera: Camera node '" << cameraNodeName << "' not found" << std::endl;
-            }
-        }
-        
-        lua_pushboolean(L, false);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "loadScene");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* sceneName = luaL_checkstring(L, 1);
-        
-        if (!sceneName) {
-            lua_pushboolean(L, false);
-            return 1;
+    // The collector is stopped between steps, so garbage made faster than the
+    // budget reclaims it would pile up: past the limit, take the hitch once
+    int kilobytes = lua_gc(componentLuaState, LUA_GCCOUNT, 0);
+    if (gcMemoryLimitKB > 0 && kilobytes >= gcMemoryLimitKB) {
+        lua_gc(componentLuaState, LUA_GCCOLLECT, 0);
+        lastGCStepMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+        // Warn once; a budget this short of the garbage rate stays short
+        if (++fullCollectionCount == 1) {
+            LOG_WARNING("ScriptManager: Lua heap at %d KB (limit %d KB), full collection took %.2f ms; raise the GC budget",
+                        kilobytes, gcMemoryLimitKB, lastGCStepMs);
+        } else {
+            LOG_VERBOSE("ScriptManager: Lua heap at %d KB, full collection took %.2f ms", kilobytes, lastGCStepMs);
         }
-        
-        auto& engine = GetEngine();
-        auto& sceneManager = engine.getSceneManager();
-        
-        // Try to load scene by name
-        bool success = sceneManager.loadScene(sceneName);
-        lua_pushboolean(L, success);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
+        return;
+    }
     
-    lua_pushstring(globalLuaState, "loadSceneFromFile");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* sceneName = luaL_checkstring(L, 1);
-        const char* filepath = luaL_checkstring(L, 2);
-        
-        if (!sceneName || !filepath) {
-            lua_pushboolean(L, false);
-            return 1;
+    // Smallest incremental steps until the budget is spent or a cycle completes
+    while (lastGCStepMs < gcBudgetMs) {
+        bool cycleDone = lua_gc(componentLuaState, LUA_GCSTEP, 0) != 0;
+        lastGCStepMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+        if (cycleDone) {
+            break;
         }
-        
-        auto& engine = GetEngine();
-        auto& sceneManager = engine.getSceneManager();
-        
-        bool success = sceneManager.loadSceneFromFile(sceneName, filepath);
-        lua_pushboolean(L, success);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_setglobal(globalLuaState, "scene");
+    }
 }
 
-void ScriptManager::bindPickupZoneSystem() {
-    if (!globalLuaState) {
+void ScriptManager::watchScriptFile(const std::string& scriptPath) {
+    if (!hotReloadEnabled) {
         return;
     }
     
-    lua_newtable(globalLuaState);
-    
-    lua_pushstring(globalLuaState, "zones");
-    lua_newtable(globalLuaState);
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "createZone");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* name = luaL_checkstring(L, 1);
-        float x = luaL_optnumber(L, 2, 0.0);
-        float y = luaL_optnumber(L, 3, 0.0);
-        float z = luaL_optnumber(L, 4, 0.0);
-        float width = luaL_optnumber(L, 5, 1.0);
-        float height = luaL_optnumber(L, 6, 1.0);
-        float depth = luaL_optnumber(L, 7, 1.0);
-        
-        lua_newtable(L);
-        lua_pushstring(L, "name");
-        lua_pushstring(L, name);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "x");
-        lua_pushnumber(L, x);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "y");
-        lua_pushnumber(L, y);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "z");
-        lua_pushnumber(L, z);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "width");
-        lua_pushnumber(L, width);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "height");
-        lua_pushnumber(L, height);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "depth");
-        lua_pushnumber(L, depth);
-        lua_settable(L, -3);
-        
-        lua_pushstring(L, "objects");
-        lua_newtable(L);
-        lua_settable(L, -3);
-        
-        // Store in global zones table
-        lua_getglobal(L, "pickupZone");
-        lua_pushstring(L, "zones");
-        lua_gettable(L, -2);
-        lua_pushstring(L, name);
-        lua_pushvalue(L, -4); // Copy the zone table
-        lua_settable(L, -3);
-        lua_pop(L, 2); // Remove zones table and pickupZone table
-        
-        return 1; // Return the zone table
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "isObjectInZone");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* zoneName = luaL_checkstring(L, 1);
-        const char* objectName = luaL_checkstring(L, 2);
-        
-        lua_getglobal(L, "pickupZone");
-        lua_pushstring(L, "zones");
-        lua_gettable(L, -2);
-        lua_pushstring(L, zoneName);
-        lua_gettable(L, -2);
-        
-        if (lua_isnil(L, -1)) {
-            lua_pop(L, 3); // Clean up stack
-            lua_pushboolean(L, false);
-            return 1;
-        }
-        
-        lua_pushstring(L, "objects");
-        lua_gettable(L, -2);
-        
-        if (lua_isnil(L, -1)) {
-            lua_pop(L, 4);
-            lua_pushboolean(L, false);
-            return 1;
-        }
-        
-        lua_pushstring(L, objectName);
-        lua_gettable(L, -2);
-        bool isInZone = !lua_isnil(L, -1);
-        lua_pop(L, 5); // Clean up stack
-        
-        lua_pushboolean(L, isInZone);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "addObjectToZone");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* zoneName = luaL_checkstring(L, 1);
-        const char* objectName = luaL_checkstring(L, 2);
-        
-        lua_getglobal(L, "pickupZone");
-        lua_pushstring(L, "zones");
-        lua_gettable(L, -2);
-        lua_pushstring(L, zoneName);
-        lua_gettable(L, -2);
-        
-        if (lua_isnil(L, -1)) {
-            lua_pop(L, 3); // Clean up stack
-            lua_pushboolean(L, false);
-            return 1;
-        }
-        
-        lua_pushstring(L, "objects");
-        lua_gettable(L, -2);
-        
-        if (lua_isnil(L, -1)) {
-            lua_pop(L, 4);
-            lua_pushboolean(L, false);
-            return 1;
-        }
-        
-        lua_pushstring(L, objectName);
-        lua_pushboolean(L, true);
-        lua_settable(L, -3);
-        
-        lua_pop(L, 4); // Clean up stack
-        lua_pushboolean(L, true);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "removeObjectFromZone");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* zoneName = luaL_checkstring(L, 1);
-        const char* objectName = luaL_checkstring(L, 2);
-        
-        lua_getglobal(L, "pickupZone");
-        lua_pushstring(L, "zones");
-        lua_gettable(L, -2);
-        lua_pushstring(L, zoneName);
-        lua_gettable(L, -2);
-        
-        if (lua_isnil(L, -1)) {
-            lua_pop(L, 3); // Clean up stack
-            lua_pushboolean(L, false);
-            return 1;
-        }
-        
-        lua_pushstring(L, "objects");
-        lua_gettable(L, -2);
-        
-        if (lua_isnil(L, -1)) {
-            lua_pop(L, 4);
-            lua_pushboolean(L, false);
-            return 1;
-        }
-        
-        lua_pushstring(L, objectName);
-        lua_pushnil(L);
-        lua_settable(L, -3);
-        
-        lua_pop(L, 4); // Clean up stack
-        lua_pushboolean(L, true);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_pushstring(globalLuaState, "getObjectsInZone");
-    lua_pushcfunction(globalLuaState, [](lua_State* L) -> int {
-        const char* zoneName = luaL_checkstring(L, 1);
-        
-        lua_getglobal(L, "pickupZone");
-        lua_pushstring(L, "zones");
-        lua_gettable(L, -2);
-        lua_pushstring(L, zoneName);
-        lua_gettable(L, -2);
-        
-        if (lua_isnil(L, -1)) {
-            lua_pop(L, 3);
-            lua_newtable(L);
-            return 1;
-        }
-        
-        lua_pushstring(L, "objects");
-        lua_gettable(L, -2);
-        
-        if (lua_isnil(L, -1)) {
-            lua_pop(L, 4);
-            lua_newtable(L);
-            return 1;
-        }
-        
-        lua_pop(L, 3);
-        return 1;
-    });
-    lua_settable(globalLuaState, -3);
-    
-    lua_setglobal(globalLuaState, "pickupZone");
+    scriptFileTimes[scriptPath] = getFileModificationTime(scriptPath);
+    std::cout << "ScriptManager: Watching script file: " << scriptPath << std::endl;
 }
 
-void ScriptManager::bindMenuSystem() {
-    if (!globalLuaState) {
-        return;
+void ScriptManager::unwatchScriptFile(const std::string& scriptPath) {
+    auto it = scriptFileTimes.find(scriptPath);
+    if (it != scriptFileTimes.end()) {
+        scriptFileTimes.erase(it);
+        std::cout << "ScriptManager: Stopped watching script file: " << scriptPath << std::endl;
+    }
+}
+
+void ScriptManager::setErrorCallback(std::function<void(const std::string&)> callback) {
+    errorCallback = callback;
+}
+
+void ScriptManager::cleanupLua() {
+    if (componentLuaState) {
+        lua_close(componentLuaState);
+        componentLuaState = nullptr;
     }
     
-    // Bind MenuManager to Lua
-    // MenuManager has its own bindToLua method that sets up all the bindings
-    MenuManager::getInstance().bindToLua(globalLuaState);
-    
-    std::cout << "ScriptManager: Menu system bound to Lua" << std::endl;
+    chunkCache.clear();
+    scriptFileTimes.clear();
 }
 
 time_t ScriptManager::getFileModificationTime(const std::string& filePath) {
@@ -1035,12 +388,12 @@ bool ScriptManager::hasFileChanged(const std::string& filePath) {
 }
 
 void ScriptManager::handleLuaError(const std::string& operation) {
-    if (!globalLuaState) {
+    if (!componentLuaState) {
         std::cerr << "ScriptManager: Lua error in " << operation << " - No Lua state" << std::endl;
         return;
     }
     
-    const char* errorMsg = lua_tostring(globalLuaState, -1);
+    const char* errorMsg = lua_tostring(componentLuaState, -1);
     if (errorMsg) {
         std::string error = "ScriptManager: Lua error in " + operation + ": " + errorMsg;
         std::cerr << error << std::endl;
@@ -1049,7 +402,7 @@ void ScriptManager::handleLuaError(const std::string& operation) {
             errorCallback(error);
         }
         
-        lua_pop(globalLuaState, 1); // Remove error message
+        lua_pop(componentLuaState, 1); // Remove error message
     } else {
         std::string error = "ScriptManager: Unknown Lua error in " + operation;
         std::cerr << error << std::endl;
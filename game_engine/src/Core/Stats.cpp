@@ -0,0 +1,134 @@
+#include "Core/Stats.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace GameEngine {
+
+const uint32_t Stats::MAX_STATS;
+const uint32_t Stats::HISTORY_FRAMES;
+
+namespace {
+
+// operator new counts here rather than in a Stat, so it works before (and
+// while) the registry itself is constructed
+std::atomic<int64_t> allocationCount(0);
+
+std::mutex& getRegistryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+} // namespace
+
+Stats& Stats::getInstance() {
+    static Stats instance;
+    return instance;
+}
+
+Stats::Stats()
+    : statCount(0)
+    , history(MAX_STATS * HISTORY_FRAMES, 0)
+    , sampleCount(0)
+{
+    overflow.name = "(overflow)";
+    getCounter("Allocations");
+}
+
+Stat& Stats::getStat(const char* name, StatType type) {
+    std::lock_guard<std::mutex> lock(getRegistryMutex());
+    uint32_t count = statCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (strcmp(stats[i].name, name) == 0) {
+            return stats[i];
+        }
+    }
+    if (count >= MAX_STATS) {
+        return overflow;
+    }
+
+    Stat& stat = stats[count];
+    stat.name = name;
+    stat.type = type;
+    statCount.store(count + 1, std::memory_order_release);
+    return stat;
+}
+
+int Stats::findStat(const std::string& name) const {
+    uint32_t count = getStatCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (name == stats[i].name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void Stats::sampleFrame() {
+    stats[0].add(allocationCount.exchange(0, std::memory_order_relaxed));
+
+    const uint32_t slot = sampleCount % HISTORY_FRAMES;
+    const uint32_t count = getStatCount();
+    for (uint32_t i = 0; i < count; ++i) {
+        Stat& stat = stats[i];
+        int64_t value = stat.type == StatType::COUNTER ? stat.value.exchange(0, std::memory_order_relaxed)
+                                                       : stat.get();
+        history[i * HISTORY_FRAMES + slot] = value;
+    }
+    sampleCount++;
+}
+
+int64_t Stats::getSample(uint32_t index, uint32_t framesAgo) const {
+    if (index >= getStatCount() || framesAgo >= sampleCount || framesAgo >= HISTORY_FRAMES) {
+        return 0;
+    }
+    return history[index * HISTORY_FRAMES + (sampleCount - 1 - framesAgo) % HISTORY_FRAMES];
+}
+
+void Stats::getHistory(uint32_t index, std::vector<float>& out) const {
+    out.clear();
+    uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(sampleCount, HISTORY_FRAMES));
+    for (uint32_t i = frames; i-- > 0;) {
+        out.push_back(static_cast<float>(getSample(index, i)));
+    }
+}
+
+} // namespace GameEngine
+
+#if ENGINE_COUNT_ALLOCATIONS
+// Replaces the global allocator with the same malloc it uses, plus a count.
+// new[] and the nothrow forms go through these
+void* operator new(std::size_t size) {
+    GameEngine::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    for (;;) {
+        void* memory = malloc(size);
+        if (memory) {
+            return memory;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+            throw std::bad_alloc();
+#else
+            abort();
+#endif
+        }
+        handler();
+    }
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+#if __cplusplus >= 201402L
+void operator delete(void* memory, std::size_t) noexcept {
+    free(memory);
+}
+#endif
+#endif
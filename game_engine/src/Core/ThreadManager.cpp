@@ -1,4 +1,5 @@
 #include "Core/ThreadManager.h"
+#include "Core/Profiler.h"
 #include <iostream>
 #include <cstring>
 #include <cstdint>
@@ -24,6 +25,7 @@ ThreadHandle ThreadManager::createThread(const std::string& name, std::function<
         #ifdef __linux__
             pthread_setname_np(pthread_self(), name.c_str());
         #endif
+        Profiler::getInstance().setThreadName(name);
         func();
     });
     
@@ -96,6 +98,7 @@ static int vitaThreadEntry(SceSize args, void* argp) {
     
     std::cout << "vitaThreadEntry: About to call function, context=" << data->context << std::endl;
     
+    Profiler::getInstance().setThreadName(data->name);
     data->func(data->context);
     
     std::cout << "vitaThreadEntry: Function call completed" << std::endl;
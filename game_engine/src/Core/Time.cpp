@@ -11,6 +11,7 @@ Time::Time()
     , fps(0.0f)
     , frameCount(0)
     , targetFrameRate(0)
+    , fixedDeltaTime(0.0f)
     , lastFrameTime(0.0f)
     , frameStartTime(0.0f)
     , fpsUpdateTimer(0.0f)
@@ -29,10 +30,15 @@ bool Time::initialize() {
 
 void Time::update() {
     float currentTime = getCurrentTime();
-    deltaTime = currentTime - lastFrameTime;
+    if (fixedDeltaTime > 0.0f) {
+        deltaTime = fixedDeltaTime;
+        totalTime += fixedDeltaTime;
+    } else {
+        deltaTime = currentTime - lastFrameTime;
+        totalTime = currentTime;
+    }
     lastFrameTime = currentTime;
     
-    totalTime = currentTime;
     scaledTotalTime += deltaTime * timeScale;
     frameCount++;
     
@@ -11,6 +11,7 @@
 #include "Components/ModelRenderer.h"
 #include "Components/LightComponent.h"
 #include "Components/TextComponent.h"
+#include "Rendering/TextRenderer.h"
 #include "Components/Area3DComponent.h"
 #include "Components/PhysicsComponent.h"
 #include "Components/SkyboxComponent.h"
@@ -110,6 +111,7 @@ void EditorSystem::render() {
     ui->renderViewport();
     ui->renderFileExplorer();
     ui->renderInputMapping();
+    ui->renderProfiler();
     
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
@@ -490,18 +492,28 @@ void EditorSystem::renderSceneToViewport() {
 void EditorSystem::renderSceneDirectly(Scene& scene, CameraComponent* camera) {
     if (!camera) return;
     
-    glm::mat4 viewMatrix = camera->getViewMatrix();
-    glm::mat4 projectionMatrix = camera->getProjectionMatrix();
+    // One copy for the whole viewport pass, even if gizmos move the camera
+    frameCamera = camera->getSnapshot();
+    const glm::mat4& viewMatrix = frameCamera.view;
+    const glm::mat4& projectionMatrix = frameCamera.projection;
     
     bool isEditorCamera = (cameraMode == CameraMode::EDITOR_CAMERA);
     
+    auto& lightingManager = LightingManager::getInstance();
+    lightingManager.buildClusters(viewMatrix, projectionMatrix, frameCamera.nearPlane, frameCamera.farPlane);
+    
     auto rootNode = scene.getRootNode();
     if (rootNode) {
         renderNodeDirectly(rootNode, glm::mat4(1.0f), viewMatrix, projectionMatrix, isEditorCamera);
     }
+    lightingManager.clearSelection();
     
     renderSkyboxDirectly(scene, camera, viewMatrix, projectionMatrix);
     
+    // Viewport overlays use Vita's aspect ratio (960x544) like the game build
+    glEnable(GL_DEPTH_TEST);
+    TextRenderer::getInstance().flush(projectionMatrix * viewMatrix, 960.0f / 544.0f);
+    
     renderPhysicsDebugShapes(viewMatrix, projectionMatrix);
 }
 
@@ -593,6 +605,7 @@ void EditorSystem::renderNodeDirectly(std::shared_ptr<SceneNode> node, const glm
                 }
             }
 
+            LightingManager::getInstance().selectLightsForBounds(mesh->getBoundsMin(), mesh->getBoundsMax(), worldTransform);
             material->apply();
             
             auto shader = material->getShader();
@@ -604,15 +617,14 @@ void EditorSystem::renderNodeDirectly(std::shared_ptr<SceneNode> node, const glm
                 glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(worldTransform)));
                 shader->setMat3("normalMatrix", normalMatrix);
                 
-                glm::vec3 cameraPos = glm::vec3(glm::inverse(viewMatrix)[3]);
-                shader->setVec3("u_CameraPos", cameraPos);
+                shader->setVec3("u_CameraPos", frameCamera.position);
                 
                 auto& lightingManager = LightingManager::getInstance();
                 size_t numLights = lightingManager.getActiveLightCount();
                 
                 if (numLights > 0) {
                     try {
-                        auto lightDataArray = lightingManager.getLightDataArray();
+                        const auto& lightDataArray = lightingManager.getLightDataArray();
                         shader->setInt("u_NumLights", (int)numLights);
                         
                         for (size_t i = 0; i < numLights; ++i) {
@@ -644,12 +656,13 @@ void EditorSystem::renderNodeDirectly(std::shared_ptr<SceneNode> node, const glm
             auto materials = modelRenderer->getMaterials();
             
             for (size_t i = 0; i < meshes.size(); ++i) {
-                auto mesh = meshes[i];
+                auto mesh = modelRenderer->selectLOD(i, worldTransform, frameCamera);
                 auto material = (i < materials.size()) ? materials[i] : nullptr;
                 
                 if (!mesh) continue;
                 
                 if (material) {
+                    LightingManager::getInstance().selectLightsForBounds(mesh->getBoundsMin(), mesh->getBoundsMax(), worldTransform);
                     material->apply();
                     
                     auto shader = material->getShader();
@@ -661,15 +674,14 @@ void EditorSystem::renderNodeDirectly(std::shared_ptr<SceneNode> node, const glm
                         glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(worldTransform)));
                         shader->setMat3("normalMatrix", normalMatrix);
                         
-                        glm::vec3 cameraPos = glm::vec3(glm::inverse(viewMatrix)[3]);
-                        shader->setVec3("u_CameraPosition", cameraPos);
+                        shader->setVec3("u_CameraPosition", frameCamera.position);
                         
                         auto& lightingManager = LightingManager::getInstance();
                         size_t numLights = lightingManager.getActiveLightCount();
                         
                         if (numLights > 0) {
                             try {
-                                auto lightDataArray = lightingManager.getLightDataArray();
+                                const auto& lightDataArray = lightingManager.getLightDataArray();
                                 shader->setInt("u_NumLights", (int)numLights);
                                 
                                 for (size_t j = 0; j < numLights; ++j) {
@@ -710,17 +722,8 @@ void EditorSystem::renderNodeDirectly(std::shared_ptr<SceneNode> node, const glm
     auto textComponent = node->getComponent<TextComponent>();
     if (textComponent && textComponent->isEnabled()) {
         if (!isEditorCamera || textComponent->getRenderMode() == TextRenderMode::WORLD_SPACE) {
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            glEnable(GL_DEPTH_TEST);
-            
-            if (textComponent->getRenderMode() == TextRenderMode::WORLD_SPACE) {
-                textComponent->renderWorldSpaceDirectly(worldTransform, viewMatrix, projectionMatrix);
-            } else {
-                textComponent->renderScreenSpaceDirectly();
-            }
-            
-            glDisable(GL_BLEND);
+            // Batched and drawn by renderSceneDirectly once the scene is done
+            textComponent->submit(worldTransform);
         }
     }
     
@@ -915,6 +918,15 @@ bool EditorSystem::saveSceneToFile(const std::string& filepath) {
     return SceneSerializer::saveSceneToFile(activeScene, filepath);
 }
 
+bool EditorSystem::exportSceneToBinary(const std::string& filepath) {
+    if (!activeScene) {
+        std::cerr << "No active scene to export" << std::endl;
+        return false;
+    }
+    
+    return SceneSerializer::saveSceneToBinaryFile(activeScene, filepath);
+}
+
 bool EditorSystem::loadSceneFromFile(const std::string& filepath) {
     auto loadedScene = SceneSerializer::loadSceneFromFile(filepath);
     if (loadedScene) {
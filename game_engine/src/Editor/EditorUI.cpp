@@ -25,8 +25,12 @@
 #include "Rendering/Texture.h"
 #include "Physics/PhysicsManager.h"
 #include "Input/InputMapping.h"
+#include "Core/Profiler.h"
+#include "Core/Stats.h"
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <iostream>
+#include <map>
 #include <memory>
 
 // ImGui includes
@@ -47,6 +51,9 @@ EditorUI::EditorUI(EditorSystem& editorSystem)
     , showProperties(true)
     , showViewport(true)
     , showFileExplorer(false)
+    , showProfiler(false)
+    , profilerPaused(false)
+    , profilerFrame(-1)
     , sceneGraphWidth(300.0f)
     , propertiesWidth(350.0f)
     , fileExplorerHeight(200.0f)
@@ -87,7 +94,7 @@ void EditorUI::renderMenuBar() {
                 editor.createNewScene();
             }
             if (ImGui::MenuItem("Open Scene...", "Ctrl+O")) {
-                std::string filepath = FileDialog::openFileDialog("Open Scene", "*.json");
+                std::string filepath = FileDialog::openFileDialog("Open Scene", "*.json *.bscene");
                 if (FileDialog::isValidResult(filepath)) {
                     if (editor.loadSceneFromFile(filepath)) {
                         std::cout << "Scene loaded from: " << filepath << std::endl;
@@ -112,6 +119,17 @@ void EditorUI::renderMenuBar() {
                     }
                 }
             }
+            if (ImGui::MenuItem("Export Binary Scene...")) {
+                // Saved next to scene.json, the game loads it in place of the JSON
+                std::string filepath = FileDialog::saveFileDialog("Export Binary Scene", "*.bscene", "scene.bscene");
+                if (FileDialog::isValidResult(filepath)) {
+                    if (editor.exportSceneToBinary(filepath)) {
+                        std::cout << "Scene exported to: " << filepath << std::endl;
+                    } else {
+                        std::cout << "Failed to export scene to: " << filepath << std::endl;
+                    }
+                }
+            }
             ImGui::Separator();
             if (ImGui::MenuItem("Exit")) {
                 GetEngine().setRunning(false);
@@ -125,6 +143,7 @@ void EditorUI::renderMenuBar() {
             ImGui::MenuItem("Viewport", nullptr, &showViewport);
             ImGui::MenuItem("File Explorer", nullptr, &showFileExplorer);
             ImGui::MenuItem("Input Mapping", nullptr, &showInputMapping);
+            ImGui::MenuItem("Profiler", nullptr, &showProfiler);
             ImGui::Separator();
             ImGui::MenuItem("Demo Window", nullptr, &showDemoWindow);
             
@@ -1068,6 +1087,20 @@ void EditorUI::renderSceneNode(std::shared_ptr<SceneNode> node, int depth) {
                 }
             }
             
+            if (ImGui::MenuItem("Save as Prefab...")) {
+                std::string filepath = FileDialog::saveFileDialog("Save as Prefab", "*.json", node->getName() + ".json");
+                if (FileDialog::isValidResult(filepath)) {
+                    // Scenes reference prefabs by project-relative path
+                    size_t assets = filepath.find("assets/");
+                    if (assets != std::string::npos) {
+                        filepath = filepath.substr(assets);
+                    }
+                    if (!SceneSerializer::savePrefab(node, filepath)) {
+                        std::cout << "Failed to save prefab to: " << filepath << std::endl;
+                    }
+                }
+            }
+            
             if (ImGui::MenuItem("Delete")) {
                 editor.deleteNode(node);
             }
@@ -1786,6 +1819,197 @@ void EditorUI::renderInputMapping() {
     ImGui::End();
 }
 
+namespace {
+
+// Frames shown in the profiler's frame graph
+const uint32_t PROFILER_FRAMES = 120;
+
+ImU32 getZoneColor(const char* name) {
+    // Same name, same color, whichever thread or frame it is in
+    uint32_t hash = 2166136261u;
+    for (const char* c = name; *c; ++c) {
+        hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+    }
+    return ImColor::HSV((hash % 360) / 360.0f, 0.55f, 0.8f);
+}
+
+} // namespace
+
+void EditorUI::renderProfiler() {
+    if (!showProfiler) return;
+    
+    ImGui::Begin("Profiler", &showProfiler);
+    
+    auto& profiler = Profiler::getInstance();
+    bool recording = profiler.isEnabled();
+    if (ImGui::Checkbox("Record", &recording)) {
+        profiler.setEnabled(recording);
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Pause", &profilerPaused);
+    ImGui::SameLine();
+    float hitchThreshold = profiler.getHitchThreshold();
+    ImGui::SetNextItemWidth(100.0f);
+    if (ImGui::DragFloat("Hitch ms", &hitchThreshold, 0.5f, 0.0f, 1000.0f, "%.1f")) {
+        profiler.setHitchThreshold(hitchThreshold);
+    }
+    ImGui::SameLine();
+    ImGui::Text("Hitches: %u", profiler.getHitchCount());
+    
+    if (ImGui::Button("Show Last Hitch") && !profiler.getLastHitch().frames.empty()) {
+        profilerCapture = profiler.getLastHitch();
+        profilerPaused = true;
+        profilerFrame = static_cast<int>(profilerCapture.frames.size()) - 1;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace...")) {
+        std::string filepath = FileDialog::saveFileDialog("Export Chrome Trace", "*.json", "profile.json");
+        if (FileDialog::isValidResult(filepath)) {
+            Profiler::saveChromeTrace(profilerCapture, filepath);
+        }
+    }
+    
+    // Engine counters and gauges over the last Stats::HISTORY_FRAMES frames
+    if (ImGui::CollapsingHeader("Engine Stats")) {
+        const Stats& stats = Stats::getInstance();
+        std::vector<float> history;
+        ImGui::Columns(5, "ProfilerStats");
+        ImGui::Text("Stat"); ImGui::NextColumn();
+        ImGui::Text("Last"); ImGui::NextColumn();
+        ImGui::Text("Avg"); ImGui::NextColumn();
+        ImGui::Text("Max"); ImGui::NextColumn();
+        ImGui::Text("History"); ImGui::NextColumn();
+        ImGui::Separator();
+        for (uint32_t i = 0; i < stats.getStatCount(); ++i) {
+            stats.getHistory(i, history);
+            float average = 0.0f;
+            float maximum = 0.0f;
+            for (float value : history) {
+                average += value;
+                maximum = std::max(maximum, value);
+            }
+            average = history.empty() ? 0.0f : average / history.size();
+            
+            ImGui::Text("%s", stats.getStatAt(i).getName()); ImGui::NextColumn();
+            ImGui::Text("%lld", static_cast<long long>(stats.getSample(i))); ImGui::NextColumn();
+            ImGui::Text("%.1f", average); ImGui::NextColumn();
+            ImGui::Text("%.0f", maximum); ImGui::NextColumn();
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::PlotLines("##History", history.data(), static_cast<int>(history.size()), 0, nullptr,
+                             0.0f, std::max(1.0f, maximum), ImVec2(-1.0f, ImGui::GetTextLineHeight()));
+            ImGui::PopID();
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+    }
+    
+    if (!profilerPaused) {
+        profiler.capture(PROFILER_FRAMES, profilerCapture);
+        profilerFrame = -1;
+    }
+    const auto& frames = profilerCapture.frames;
+    if (frames.empty()) {
+        ImGui::Text("No frames recorded yet");
+        ImGui::End();
+        return;
+    }
+    if (profilerFrame < 0 || profilerFrame >= static_cast<int>(frames.size())) {
+        profilerFrame = static_cast<int>(frames.size()) - 1;
+    }
+    
+    // Frame graph; clicking a bar pauses on that frame
+    std::vector<float> frameMs(frames.size());
+    float maxMs = 1000.0f / 60.0f;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        frameMs[i] = (frames[i].end - frames[i].begin) / 1.0e6f;
+        maxMs = std::max(maxMs, frameMs[i]);
+    }
+    ImGui::PlotHistogram("##ProfilerFrames", frameMs.data(), static_cast<int>(frameMs.size()), 0, nullptr,
+                         0.0f, maxMs, ImVec2(-1.0f, 60.0f));
+    if (ImGui::IsItemClicked()) {
+        ImVec2 graphMin = ImGui::GetItemRectMin();
+        ImVec2 graphMax = ImGui::GetItemRectMax();
+        float t = (ImGui::GetIO().MousePos.x - graphMin.x) / std::max(1.0f, graphMax.x - graphMin.x);
+        profilerFrame = std::min(static_cast<int>(frames.size()) - 1, std::max(0, static_cast<int>(t * frames.size())));
+        profilerPaused = true;
+    }
+    
+    const ProfileFrameRecord& frame = frames[profilerFrame];
+    const double frameNs = static_cast<double>(std::max<uint64_t>(1, frame.end - frame.begin));
+    ImGui::Text("Frame %llu: %.3f ms", static_cast<unsigned long long>(frame.index), frameNs / 1.0e6);
+    ImGui::Separator();
+    
+    // One lane per thread, a row per nesting depth, scaled to the frame
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+    const float width = std::max(1.0f, ImGui::GetContentRegionAvail().x);
+    std::map<std::string, std::pair<int, double>> totals;
+    for (const auto& thread : profilerCapture.threads) {
+        uint32_t maxDepth = 0;
+        for (const auto& zone : thread.zones) {
+            if (zone.end >= frame.begin && zone.begin <= frame.end) {
+                maxDepth = std::max(maxDepth, zone.depth);
+            }
+        }
+        
+        ImGui::Text("%s", thread.name.c_str());
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImGui::PushID(static_cast<int>(thread.id));
+        ImGui::InvisibleButton("##Lane", ImVec2(width, (maxDepth + 1) * rowHeight));
+        ImGui::PopID();
+        bool laneHovered = ImGui::IsItemHovered();
+        ImVec2 mouse = ImGui::GetIO().MousePos;
+        
+        for (const auto& zone : thread.zones) {
+            if (zone.end < frame.begin || zone.begin > frame.end) continue;
+            
+            double begin = std::max<double>(0.0, static_cast<double>(zone.begin) - frame.begin) / frameNs;
+            double end = std::min<double>(frameNs, static_cast<double>(zone.end) - frame.begin) / frameNs;
+            ImVec2 rectMin(origin.x + static_cast<float>(begin) * width, origin.y + zone.depth * rowHeight);
+            ImVec2 rectMax(std::max(rectMin.x + 1.0f, origin.x + static_cast<float>(end) * width), rectMin.y + rowHeight - 1.0f);
+            drawList->AddRectFilled(rectMin, rectMax, getZoneColor(zone.name));
+            if (rectMax.x - rectMin.x > 20.0f) {
+                drawList->PushClipRect(rectMin, rectMax, true);
+                drawList->AddText(ImVec2(rectMin.x + 2.0f, rectMin.y + 2.0f), IM_COL32(0, 0, 0, 255), zone.name);
+                drawList->PopClipRect();
+            }
+            
+            double ms = (zone.end - zone.begin) / 1.0e6;
+            if (laneHovered && mouse.x >= rectMin.x && mouse.x < rectMax.x && mouse.y >= rectMin.y && mouse.y < rectMax.y) {
+                ImGui::SetTooltip("%s\n%.3f ms", zone.name, ms);
+            }
+            // Totals count zones that lie within the frame
+            if (zone.begin >= frame.begin && zone.end <= frame.end) {
+                auto& total = totals[zone.name];
+                total.first++;
+                total.second += ms;
+            }
+        }
+    }
+    
+    // Where the frame went, by zone name across threads. Nested zones are
+    // counted in their parents too
+    ImGui::Separator();
+    std::vector<std::pair<std::string, std::pair<int, double>>> sorted(totals.begin(), totals.end());
+    std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, std::pair<int, double>>& a,
+                                               const std::pair<std::string, std::pair<int, double>>& b) {
+        return a.second.second > b.second.second;
+    });
+    ImGui::Columns(3, "ProfilerTotals");
+    ImGui::Text("Zone"); ImGui::NextColumn();
+    ImGui::Text("Calls"); ImGui::NextColumn();
+    ImGui::Text("Total ms"); ImGui::NextColumn();
+    ImGui::Separator();
+    for (const auto& entry : sorted) {
+        ImGui::Text("%s", entry.first.c_str()); ImGui::NextColumn();
+        ImGui::Text("%d", entry.second.first); ImGui::NextColumn();
+        ImGui::Text("%.3f", entry.second.second); ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+    
+    ImGui::End();
+}
+
 void EditorUI::renderCameraControls() {
     // Safety check - only render if we have a valid scene
     if (!editor.getActiveScene()) {
@@ -1,6 +1,8 @@
 #include "Editor/SceneSerializer.h"
 #include "Scene/Scene.h"
 #include "Scene/SceneNode.h"
+#include "Scene/SceneJsonReader.h"
+#include "Scene/PrefabLibrary.h"
 #include "Components/CameraComponent.h"
 #include "Components/MeshRenderer.h"
 #include "Components/ModelRenderer.h"
@@ -61,6 +63,35 @@ std::string SceneSerializer::generateVisibilityCode(const std::string& nodeName,
     return code;
 }
 
+std::string SceneSerializer::generateTexturePreloadCode(const std::vector<std::shared_ptr<SceneNode>>& nodes) {
+    std::vector<std::string> paths;
+    for (const auto& node : nodes) {
+        auto meshRenderer = node ? node->getComponent<MeshRenderer>() : nullptr;
+        auto material = meshRenderer ? meshRenderer->getMaterial() : nullptr;
+        if (!material) continue;
+        
+        const std::string materialPaths[] = {
+            material->getDiffuseTexturePath(),
+            material->getNormalTexturePath(),
+            material->getARMTexturePath()
+        };
+        for (const auto& path : materialPaths) {
+            if (!path.empty() && std::find(paths.begin(), paths.end(), path) == paths.end()) {
+                paths.push_back(path);
+            }
+        }
+    }
+    if (paths.empty()) return "";
+    
+    std::string code = "    // Decode the scene's textures in parallel before the nodes below fetch them\n";
+    code += "    textureManager.preloadTextures({\n";
+    for (const auto& path : paths) {
+        code += "        \"" + escapeStringForCpp(path) + "\",\n";
+    }
+    code += "    });\n\n";
+    return code;
+}
+
 #ifdef LINUX_BUILD
 void SceneSerializer::saveSceneToGame(std::shared_ptr<Scene> scene) {
     if (!scene) return;
@@ -107,6 +138,7 @@ std::string SceneSerializer::generateGameMainContent(std::shared_ptr<Scene> scen
 #include "../game_engine/include/Core/Engine.h"
 #include "../game_engine/include/Scene/Scene.h"
 #include "../game_engine/include/Scene/SceneNode.h"
+#include "../game_engine/include/Scene/PrefabLibrary.h"
 #include "../game_engine/include/Components/CameraComponent.h"
 #include "../game_engine/include/Components/MeshRenderer.h"
 #include "../game_engine/include/Components/ModelRenderer.h"
@@ -147,6 +179,8 @@ int main() {
     int shapeCounter = 0;
     if (scene) {
         auto allNodes = getAllSceneNodesFromScene(scene);
+        content += generateTexturePreloadCode(allNodes);
+        auto prefabInstances = extractPrefabInstances(allNodes);
         std::map<SceneNode*, std::string> nodeNameMap;
         
         int physicsCounter = 0;
@@ -788,6 +822,8 @@ int main() {
             }
         }
         
+        content += generatePrefabInstanceCode(prefabInstances, nodeNameMap);
+        
         std::string outputMessage = "    std::cout << \"Game scene loaded with camera, " + 
                                     std::to_string(shapeCounter) + " shape(s), " + 
                                     std::to_string(physicsCounter) + " physics component(s), " + 
@@ -829,6 +865,7 @@ std::string SceneSerializer::generateVitaMainContent(std::shared_ptr<Scene> scen
 #include "../game_engine/include/Core/Engine.h"
 #include "../game_engine/include/Scene/Scene.h"
 #include "../game_engine/include/Scene/SceneNode.h"
+#include "../game_engine/include/Scene/PrefabLibrary.h"
 #include "../game_engine/include/Components/CameraComponent.h"
 #include "../game_engine/include/Components/MeshRenderer.h"
 #include "../game_engine/include/Components/ModelRenderer.h"
@@ -879,6 +916,8 @@ int main() {
     if (scene) {
         // Add all mesh objects (recursively process all mesh nodes in the hierarchy)
         auto allNodes = getAllSceneNodesFromScene(scene);
+        content += generateTexturePreloadCode(allNodes);
+        auto prefabInstances = extractPrefabInstances(allNodes);
         std::map<SceneNode*, std::string> nodeNameMap; // Map nodes to their generated names
         int shapeCounter = 0; // Counter for all mesh objects (shapes)
         
@@ -1500,6 +1539,8 @@ int main() {
                 scriptCounter++;
             }
         }
+        
+        content += generatePrefabInstanceCode(prefabInstances, nodeNameMap);
     }
     
     content += R"(
@@ -1520,6 +1561,46 @@ int main() {
 }
 #endif // LINUX_BUILD
 
+std::vector<std::shared_ptr<SceneNode>> SceneSerializer::extractPrefabInstances(std::vector<std::shared_ptr<SceneNode>>& nodes) {
+    std::vector<std::shared_ptr<SceneNode>> instances;
+    std::vector<std::shared_ptr<SceneNode>> remaining;
+    for (const auto& node : nodes) {
+        // The outermost instance root stands for everything under it
+        SceneNode* outermost = nullptr;
+        for (SceneNode* current = node.get(); current; current = current->getParent()) {
+            if (current->isPrefabInstance()) outermost = current;
+        }
+        if (!outermost) {
+            remaining.push_back(node);
+        } else if (outermost == node.get()) {
+            instances.push_back(node);
+        }
+    }
+    nodes.swap(remaining);
+    return instances;
+}
+
+std::string SceneSerializer::generatePrefabInstanceCode(const std::vector<std::shared_ptr<SceneNode>>& instances,
+                                                        const std::map<SceneNode*, std::string>& nodeNameMap) {
+    std::string code;
+    int instanceCounter = 1;
+    for (const auto& instance : instances) {
+        // The same override JSON a scene file holds for the instance
+        std::string instanceName = "prefabInstance" + std::to_string(instanceCounter++);
+        std::string parentName = "gameScene->getRootNode()";
+        auto parentIt = nodeNameMap.find(instance->getParent());
+        if (parentIt != nodeNameMap.end()) {
+            parentName = parentIt->second;
+        }
+        
+        code += "    // Add an instance of " + instance->getPrefabPath() + "\n";
+        code += "    auto " + instanceName + " = PrefabLibrary::getInstance().instantiate(\"" +
+                escapeStringForCpp(serializeNodeToJson(instance).dump()) + "\");\n";
+        code += "    if (" + instanceName + ") " + parentName + "->addChild(" + instanceName + ");\n\n";
+    }
+    return code;
+}
+
 void SceneSerializer::collectAllNodesRecursive(std::shared_ptr<SceneNode> node, std::vector<std::shared_ptr<SceneNode>>& allNodes) {
     if (!node) return;
     
@@ -1567,6 +1648,185 @@ std::string SceneSerializer::sanitizeNodeName(const std::string& name) {
     return sanitized;
 }
 
+namespace {
+
+#ifdef VITA_BUILD
+// Relative paths are read from the VPK (app0:/) unless they name a device
+std::string resolveVitaPath(const std::string& filepath) {
+    const char* devices[] = { "app0:", "ux0:", "ur0:", "uma0:", "imc0:", "xmc0:", "vs0:", "vd0:" };
+    for (const char* device : devices) {
+        if (filepath.find(device) != std::string::npos) {
+            return filepath;
+        }
+    }
+    return "app0:/" + filepath;
+}
+#endif
+
+// A cooked .bscene stands in for its JSON source unless the source was edited since
+bool hasCookedScene(const std::string& sourcePath, const std::string& binaryPath) {
+#ifdef LINUX_BUILD
+    std::error_code error;
+    auto cookedTime = std::filesystem::last_write_time(binaryPath, error);
+    if (error) return false;
+    auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+    if (error) return true;
+    return cookedTime >= sourceTime;
+#else
+    SceIoStat stat;
+    return sceIoGetstat(resolveVitaPath(binaryPath).c_str(), &stat) >= 0;
+#endif
+}
+
+// Values equal as the reader sees them: numbers as the floats they load as
+bool sameJsonValue(const json& a, const json& b) {
+    if (a.is_number() && b.is_number()) {
+        return a.get<float>() == b.get<float>();
+    }
+    if (a.is_array() && b.is_array()) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (!sameJsonValue(a[i], b[i])) return false;
+        }
+        return true;
+    }
+    if (a.is_object() && b.is_object()) {
+        if (a.size() != b.size()) return false;
+        for (auto it = a.begin(); it != a.end(); ++it) {
+            auto other = b.find(it.key());
+            if (other == b.end() || !sameJsonValue(*it, *other)) return false;
+        }
+        return true;
+    }
+    return a == b;
+}
+
+// The keys of `full` that `base` lacks or holds another value for. Nested
+// objects (transform, material) keep only their own differing keys, since
+// the reader merges those key by key too
+json diffJsonObject(const json& full, const json& base) {
+    json diff = json::object();
+    for (auto it = full.begin(); it != full.end(); ++it) {
+        auto baseIt = base.find(it.key());
+        if (baseIt == base.end()) {
+            diff[it.key()] = *it;
+        } else if (it->is_object() && baseIt->is_object()) {
+            json inner = diffJsonObject(*it, *baseIt);
+            if (!inner.empty()) diff[it.key()] = inner;
+        } else if (!sameJsonValue(*it, *baseIt)) {
+            diff[it.key()] = *it;
+        }
+    }
+    return diff;
+}
+
+const json& getArray(const json& object, const char* key) {
+    static const json empty = json::array();
+    auto it = object.find(key);
+    return (it != object.end() && it->is_array()) ? *it : empty;
+}
+
+// Component overrides in the reader's terms: the k-th component of a type
+// overrides the prefab's k-th of that type, so an unchanged one is still
+// written (as just its type) when a later one of its type changed
+json diffComponents(const json& full, const json& base) {
+    std::vector<json> diffs;
+    std::vector<bool> changed;
+    for (size_t i = 0; i < full.size(); ++i) {
+        const json& component = full[i];
+        std::string type = component.value("type", "");
+        size_t ordinal = 0;
+        for (size_t k = 0; k < i; ++k) {
+            if (full[k].value("type", "") == type) ordinal++;
+        }
+
+        const json* match = nullptr;
+        for (const auto& candidate : base) {
+            if (candidate.value("type", "") == type && ordinal-- == 0) {
+                match = &candidate;
+                break;
+            }
+        }
+        if (!match) {
+            diffs.push_back(component);
+            changed.push_back(true);
+            continue;
+        }
+        json diff = diffJsonObject(component, *match);
+        diff.erase("type");
+        changed.push_back(!diff.empty());
+        diff["type"] = type;
+        diffs.push_back(diff);
+    }
+
+    json overrides = json::array();
+    for (size_t i = 0; i < diffs.size(); ++i) {
+        bool needed = changed[i];
+        for (size_t j = i + 1; j < diffs.size() && !needed; ++j) {
+            needed = changed[j] && diffs[j].value("type", "") == diffs[i].value("type", "");
+        }
+        if (needed) overrides.push_back(diffs[i]);
+    }
+    return overrides;
+}
+
+// What a prefab node needs written to come out as `full`. Children are
+// matched by name, a nested instance only with one of the same prefab
+json diffPrefabNode(const json& full, const json& base, bool root) {
+    json diff = json::object();
+    diff["name"] = full.value("name", "Node");
+    if (root) {
+        diff["transform"] = full.value("transform", json::object());
+    } else {
+        json transform = diffJsonObject(full.value("transform", json::object()), base.value("transform", json::object()));
+        if (!transform.empty()) diff["transform"] = transform;
+    }
+    for (const char* flag : { "visible", "active" }) {
+        if (full.contains(flag) && !sameJsonValue(full[flag], base.value(flag, json(true)))) {
+            diff[flag] = full[flag];
+        }
+    }
+    if (full.contains("prefab")) {
+        diff["prefab"] = full["prefab"];
+    }
+
+    json components = diffComponents(getArray(full, "components"), getArray(base, "components"));
+    if (!components.empty()) diff["components"] = components;
+
+    const json& baseChildren = getArray(base, "children");
+    std::vector<bool> used(baseChildren.size(), false);
+    json children = json::array();
+    for (const auto& child : getArray(full, "children")) {
+        std::string name = child.value("name", "Node");
+        std::string prefab = child.value("prefab", "");
+        size_t match = baseChildren.size();
+        for (size_t i = 0; i < baseChildren.size() && match == baseChildren.size(); ++i) {
+            if (!used[i] && baseChildren[i].value("name", "Node") == name &&
+                baseChildren[i].value("prefab", "") == prefab) {
+                match = i;
+            }
+        }
+        if (match == baseChildren.size()) {
+            children.push_back(child);
+            continue;
+        }
+        used[match] = true;
+        json childDiff = diffPrefabNode(child, baseChildren[match], false);
+        childDiff.erase("prefab");
+        if (childDiff.size() > 1) children.push_back(childDiff);
+    }
+    if (!children.empty()) diff["children"] = children;
+    return diff;
+}
+
+// Prefab root nodes as a fresh instance serializes, built once per save
+std::map<std::string, json>& getPrefabJsonCache() {
+    static std::map<std::string, json> cache;
+    return cache;
+}
+
+} // namespace
+
 bool SceneSerializer::saveSceneToFile(std::shared_ptr<Scene> scene, const std::string& filepath) {
     if (!scene) {
 #ifdef VITA_BUILD
@@ -1580,37 +1840,17 @@ bool SceneSerializer::saveSceneToFile(std::shared_ptr<Scene> scene, const std::s
 #ifdef VITA_BUILD
     // Vita build: no exception handling
     std::string jsonData = serializeSceneToJson(scene);
-    
-    // Use Vita file I/O
-    SceUID fd = sceIoOpen(filepath.c_str(), SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
-    if (fd < 0) {
-        printf("Failed to open file for writing: %s (error: 0x%08X)\n", filepath.c_str(), fd);
+    if (!writeSceneFile(filepath, jsonData.data(), jsonData.size())) {
         return false;
     }
-    
-    SceSSize bytesWritten = sceIoWrite(fd, jsonData.c_str(), jsonData.size());
-    sceIoClose(fd);
-    
-    if (bytesWritten < 0 || static_cast<size_t>(bytesWritten) != jsonData.size()) {
-        printf("Failed to write file: %s (error: 0x%08X)\n", filepath.c_str(), bytesWritten);
-        return false;
-    }
-    
     printf("Scene saved successfully to: %s\n", filepath.c_str());
     return true;
 #else
     try {
         std::string jsonData = serializeSceneToJson(scene);
-        
-        std::ofstream file(filepath);
-        if (!file.is_open()) {
-            std::cerr << "Failed to open file for writing: " << filepath << std::endl;
+        if (!writeSceneFile(filepath, jsonData.data(), jsonData.size())) {
             return false;
         }
-        
-        file << jsonData;
-        file.close();
-        
         std::cout << "Scene saved successfully to: " << filepath << std::endl;
         return true;
     } catch (const std::exception& e) {
@@ -1620,99 +1860,167 @@ bool SceneSerializer::saveSceneToFile(std::shared_ptr<Scene> scene, const std::s
 #endif
 }
 
-std::shared_ptr<Scene> SceneSerializer::loadSceneFromFile(const std::string& filepath) {
+bool SceneSerializer::saveSceneToBinaryFile(std::shared_ptr<Scene> scene, const std::string& filepath) {
+    if (!scene) {
 #ifdef VITA_BUILD
-    // Vita build: no exception handling
-    std::string jsonData;
+        printf("Cannot save null scene to file: %s\n", filepath.c_str());
+#else
+        std::cerr << "Cannot save null scene to file: " << filepath << std::endl;
+#endif
+        return false;
+    }
+    
+    // Goes through the JSON DOM so the binary holds exactly what a JSON save would
+    SceneDescription description;
+    SceneJsonReader::readDom(buildSceneJson(scene), description);
+    std::vector<uint8_t> file;
+    description.writeBinary(file);
+    if (!writeSceneFile(filepath, file.data(), file.size())) {
+        return false;
+    }
+    
+#ifdef VITA_BUILD
+    printf("Binary scene saved to: %s (%u nodes, %u components)\n", filepath.c_str(),
+           static_cast<unsigned>(description.nodes.size()), static_cast<unsigned>(description.components.size()));
+#else
+    std::cout << "Binary scene saved to: " << filepath << " (" << description.nodes.size() << " nodes, "
+              << description.components.size() << " components)" << std::endl;
+#endif
+    return true;
+}
+
+std::shared_ptr<Scene> SceneSerializer::loadSceneFromFile(const std::string& filepath, const SceneLoadCallback& progress) {
+    std::string binaryPath = SceneDescription::getBinaryPath(filepath);
+    if (binaryPath != filepath && hasCookedScene(filepath, binaryPath)) {
+        std::shared_ptr<Scene> scene = loadSceneData(binaryPath, progress);
+        if (scene) {
+            return scene;
+        }
+        // Cooked by an older build: the source still loads
+    }
+    return loadSceneData(filepath, progress);
+}
+
+std::shared_ptr<Scene> SceneSerializer::loadSceneData(const std::string& filepath, const SceneLoadCallback& progress) {
+    std::vector<uint8_t> data;
+    if (!readSceneFile(filepath, data)) {
+        return nullptr;
+    }
     
-    // Convert filepath to Vita format (app0:/path for VPK files)
-    std::string vitaPath = filepath;
+    if (data.empty()) {
+#ifdef VITA_BUILD
+        printf("File is empty: %s\n", filepath.c_str());
+#else
+        std::cerr << "File is empty: " << filepath << std::endl;
+#endif
+        return nullptr;
+    }
     
-    // Check if path already has a device prefix (app0:, ux0:, ur0:, etc.)
-    if (filepath.find("app0:") == std::string::npos && 
-        filepath.find("ux0:") == std::string::npos && 
-        filepath.find("ur0:") == std::string::npos &&
-        filepath.find("uma0:") == std::string::npos &&
-        filepath.find("imc0:") == std::string::npos &&
-        filepath.find("xmc0:") == std::string::npos &&
-        filepath.find("vs0:") == std::string::npos &&
-        filepath.find("vd0:") == std::string::npos) {
-        // No device prefix found, prepend app0: for VPK access
-        vitaPath = "app0:/" + filepath;
+    SceneDescription description;
+    if (SceneDescription::isBinary(data.data(), data.size())) {
+        if (!description.readBinary(data.data(), data.size())) {
+#ifdef VITA_BUILD
+            printf("Invalid or outdated binary scene: %s\n", filepath.c_str());
+#else
+            std::cerr << "Invalid or outdated binary scene: " << filepath << std::endl;
+#endif
+            return nullptr;
+        }
+    } else if (!SceneJsonReader::read(std::string(data.begin(), data.end()), description)) {
+        return nullptr;
     }
     
-    // Use Vita file I/O
+    std::shared_ptr<Scene> scene = description.instantiate(progress);
+#ifdef VITA_BUILD
+    printf("Scene loaded successfully from: %s\n", filepath.c_str());
+#else
+    std::cout << "Scene loaded successfully from: " << filepath << std::endl;
+#endif
+    return scene;
+}
+
+bool SceneSerializer::readSceneFile(const std::string& filepath, std::vector<uint8_t>& data) {
+#ifdef VITA_BUILD
+    std::string vitaPath = resolveVitaPath(filepath);
+    
     SceUID fd = sceIoOpen(vitaPath.c_str(), SCE_O_RDONLY, 0);
     if (fd < 0) {
         printf("Failed to open file for reading: %s (tried: %s, error: 0x%08X)\n", filepath.c_str(), vitaPath.c_str(), fd);
-        return nullptr;
+        return false;
     }
     
-    // Get file size
     SceIoStat stat;
     if (sceIoGetstat(vitaPath.c_str(), &stat) < 0) {
         sceIoClose(fd);
         printf("Failed to get file stat: %s (tried: %s)\n", filepath.c_str(), vitaPath.c_str());
-        return nullptr;
+        return false;
     }
     
-    // Read file content
-    std::vector<char> buffer(stat.st_size);
-    SceSSize bytesRead = sceIoRead(fd, buffer.data(), stat.st_size);
+    // One read for the whole file
+    data.resize(static_cast<size_t>(stat.st_size));
+    SceSSize bytesRead = sceIoRead(fd, data.data(), data.size());
     sceIoClose(fd);
     
     if (bytesRead < 0) {
         printf("Failed to read file: %s (tried: %s, error: 0x%08X)\n", filepath.c_str(), vitaPath.c_str(), bytesRead);
-        return nullptr;
+        return false;
     }
-    
-    jsonData = std::string(buffer.data(), bytesRead);
-    
-    if (jsonData.empty()) {
-        printf("File is empty: %s (tried: %s)\n", filepath.c_str(), vitaPath.c_str());
-        return nullptr;
+    data.resize(static_cast<size_t>(bytesRead));
+    return true;
+#else
+    std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file for reading: " << filepath << std::endl;
+        return false;
     }
     
-    std::shared_ptr<Scene> scene = deserializeSceneFromJson(jsonData);
-    if (scene) {
-        printf("Scene loaded successfully from: %s\n", vitaPath.c_str());
+    // One read for the whole file
+    std::streamoff size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    data.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    if (!data.empty() && !file.read(reinterpret_cast<char*>(data.data()), data.size())) {
+        std::cerr << "Failed to read file: " << filepath << std::endl;
+        return false;
+    }
+    return true;
+#endif
+}
+
+bool SceneSerializer::writeSceneFile(const std::string& filepath, const void* data, size_t size) {
+#ifdef VITA_BUILD
+    SceUID fd = sceIoOpen(filepath.c_str(), SCE_O_WRONLY | SCE_O_CREAT | SCE_O_TRUNC, 0777);
+    if (fd < 0) {
+        printf("Failed to open file for writing: %s (error: 0x%08X)\n", filepath.c_str(), fd);
+        return false;
     }
     
-    return scene;
+    SceSSize bytesWritten = sceIoWrite(fd, data, size);
+    sceIoClose(fd);
+    
+    if (bytesWritten < 0 || static_cast<size_t>(bytesWritten) != size) {
+        printf("Failed to write file: %s (error: 0x%08X)\n", filepath.c_str(), bytesWritten);
+        return false;
+    }
+    return true;
 #else
-    try {
-        std::string jsonData;
-        
-        std::ifstream file(filepath);
-        if (!file.is_open()) {
-            std::cerr << "Failed to open file for reading: " << filepath << std::endl;
-            return nullptr;
-        }
-        
-        jsonData = std::string((std::istreambuf_iterator<char>(file)),
-                              std::istreambuf_iterator<char>());
-        file.close();
-        
-        if (jsonData.empty()) {
-            std::cerr << "File is empty: " << filepath << std::endl;
-            return nullptr;
-        }
-        
-        std::shared_ptr<Scene> scene = deserializeSceneFromJson(jsonData);
-        if (scene) {
-            std::cout << "Scene loaded successfully from: " << filepath << std::endl;
-        }
-        
-        return scene;
-    } catch (const std::exception& e) {
-        std::cerr << "Error loading scene from file: " << e.what() << std::endl;
-        return nullptr;
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open file for writing: " << filepath << std::endl;
+        return false;
+    }
+    
+    file.write(static_cast<const char*>(data), size);
+    if (!file) {
+        std::cerr << "Failed to write file: " << filepath << std::endl;
+        return false;
     }
+    return true;
 #endif
 }
 
-std::string SceneSerializer::serializeSceneToJson(std::shared_ptr<Scene> scene) {
-    if (!scene) return "{}";
+nlohmann::json SceneSerializer::buildSceneJson(std::shared_ptr<Scene> scene) {
+    // Prefabs may have been saved since the last scene save
+    getPrefabJsonCache().clear();
     
     json sceneJson;
     sceneJson["name"] = scene->getName();
@@ -1739,78 +2047,12 @@ std::string SceneSerializer::serializeSceneToJson(std::shared_ptr<Scene> scene)
         sceneJson["activeSkybox"] = nullptr;
     }
     
-    return sceneJson.dump(2);
+    return sceneJson;
 }
 
-std::shared_ptr<Scene> SceneSerializer::deserializeSceneFromJson(const std::string& jsonData) {
-#ifndef VITA_BUILD
-    try {
-#endif
-        json sceneJson = json::parse(jsonData);
-        
-        std::string sceneName = sceneJson.value("name", "Loaded Scene");
-        auto scene = std::make_shared<Scene>(sceneName);
-        
-        // Clear the default root node's children
-        scene->getRootNode()->removeAllChildren();
-        
-        // Deserialize root node
-        if (sceneJson.contains("rootNode")) {
-            auto rootNode = deserializeNodeFromJson(sceneJson["rootNode"]);
-            if (rootNode) {
-                // Replace the scene's root node with the loaded one
-                scene->getRootNode()->setName(rootNode->getName());
-                scene->getRootNode()->setVisible(rootNode->isVisible());
-                scene->getRootNode()->setActive(rootNode->isActive());
-                scene->getRootNode()->getTransform() = rootNode->getTransform();
-                
-                // Copy children - collect them first to avoid issues with changing indices
-                std::vector<std::shared_ptr<SceneNode>> childrenToAdd;
-                for (size_t i = 0; i < rootNode->getChildCount(); ++i) {
-                    auto child = rootNode->getChild(i);
-                    if (child) {
-                        childrenToAdd.push_back(child);
-                    }
-                }
-                
-                // Now add all collected children
-                for (auto& child : childrenToAdd) {
-                    scene->getRootNode()->addChild(child);
-                }
-            }
-        }
-        
-        if (sceneJson.contains("activeCamera") && !sceneJson["activeCamera"].is_null()) {
-            std::string activeCameraName = sceneJson["activeCamera"];
-            auto cameraNode = scene->findNode(activeCameraName);
-            if (cameraNode) {
-                scene->setActiveCamera(cameraNode);
-            }
-        }
-        
-        if (sceneJson.contains("activeSkybox") && !sceneJson["activeSkybox"].is_null()) {
-            std::string activeSkyboxName = sceneJson["activeSkybox"];
-            auto skyboxNode = scene->findNode(activeSkyboxName);
-            if (skyboxNode) {
-                scene->setActiveSkybox(skyboxNode);
-            }
-        }
-        
-#ifdef VITA_BUILD
-        printf("Scene loaded successfully from: %s\n", sceneName.c_str());
-#else
-        std::cout << "Scene loaded successfully from: " << sceneName << std::endl;
-#endif
-        return scene;
-#ifndef VITA_BUILD
-    } catch (const json::exception& e) {
-        std::cerr << "Error parsing JSON: " << e.what() << std::endl;
-        return nullptr;
-    } catch (const std::exception& e) {
-        std::cerr << "Error deserializing scene from JSON: " << e.what() << std::endl;
-        return nullptr;
-    }
-#endif
+std::string SceneSerializer::serializeSceneToJson(std::shared_ptr<Scene> scene) {
+    if (!scene) return "{}";
+    return buildSceneJson(scene).dump(2);
 }
 
 nlohmann::json SceneSerializer::serializeNodeToJson(std::shared_ptr<SceneNode> node) {
@@ -2058,6 +2300,12 @@ nlohmann::json SceneSerializer::serializeNodeToJson(std::shared_ptr<SceneNode> n
                         componentJson["soundFile"] = soundComp->getSoundFile();
                         componentJson["volume"] = soundComp->getVolume();
                         componentJson["loop"] = soundComp->isLooping();
+                        componentJson["pitch"] = soundComp->getPitch();
+                        componentJson["priority"] = soundComp->getPriority();
+                        componentJson["spatial"] = soundComp->isSpatial();
+                        componentJson["minDistance"] = soundComp->getMinDistance();
+                        componentJson["maxDistance"] = soundComp->getMaxDistance();
+                        componentJson["rolloff"] = soundComp->getRolloff();
                     }
                 } else if (component->getTypeName() == "SkyboxComponent") {
                     auto skyboxComp = node->getComponent<SkyboxComponent>();
@@ -2094,506 +2342,76 @@ nlohmann::json SceneSerializer::serializeNodeToJson(std::shared_ptr<SceneNode> n
         nodeJson["children"] = childrenArray;
     }
     
+    if (node->isPrefabInstance()) {
+        return serializePrefabInstance(nodeJson, node->getPrefabPath());
+    }
     return nodeJson;
 }
 
-std::shared_ptr<SceneNode> SceneSerializer::deserializeNodeFromJson(const json& nodeJson) {
-#ifndef VITA_BUILD
-    try {
-#endif
-        std::string name = nodeJson.value("name", "Node");
-        auto node = std::make_shared<SceneNode>(name);
-        
-        // Basic properties
-        node->setVisible(nodeJson.value("visible", true));
-        node->setActive(nodeJson.value("active", true));
-        
-        // Transform
-        if (nodeJson.contains("transform")) {
-            auto& transform = node->getTransform();
-            auto& transformJson = nodeJson["transform"];
-            
-            if (transformJson.contains("position")) {
-                auto pos = transformJson["position"];
-                if (pos.is_array() && pos.size() >= 3) {
-                    transform.setPosition(glm::vec3(pos[0], pos[1], pos[2]));
-                }
-            }
-            
-            if (transformJson.contains("rotation")) {
-                auto rot = transformJson["rotation"];
-                if (rot.is_array() && rot.size() >= 3) {
-                    transform.setEulerAngles(glm::vec3(rot[0], rot[1], rot[2]));
-                }
-            }
-            
-            if (transformJson.contains("scale")) {
-                auto scale = transformJson["scale"];
-                if (scale.is_array() && scale.size() >= 3) {
-                    transform.setScale(glm::vec3(scale[0], scale[1], scale[2]));
-                }
-            }
+nlohmann::json SceneSerializer::serializePrefabInstance(const nlohmann::json& nodeJson, const std::string& prefabPath) {
+    auto& cache = getPrefabJsonCache();
+    auto it = cache.find(prefabPath);
+    if (it == cache.end()) {
+        // The prefab is compared as this serializer writes it, so values its
+        // file leaves at their defaults don't read as overrides
+        json rootNode;
+        auto prefab = PrefabLibrary::getInstance().instantiatePrefab(prefabPath);
+        if (prefab) {
+            prefab->setPrefabPath("");
+            rootNode = serializeNodeToJson(prefab);
         }
-        
-        // Components
-        if (nodeJson.contains("components") && nodeJson["components"].is_array()) {
-            auto& componentsArray = nodeJson["components"];
-#ifdef LINUX_BUILD
-            std::cout << "Deserializing node '" << name << "' with " << componentsArray.size() << " component(s)" << std::endl;
-#endif
-            for (const auto& componentJson : componentsArray) {
-                std::string type = componentJson.value("type", "");
-#ifdef LINUX_BUILD
-                std::cout << "  Processing component type: " << type << std::endl;
-#endif
-                
-                if (type == "CameraComponent") {
-                    auto cameraComp = node->addComponent<CameraComponent>();
-                    if (componentJson.contains("fov")) {
-                        cameraComp->setFOV(componentJson["fov"]);
-                    }
-                    if (componentJson.contains("nearPlane")) {
-                        cameraComp->setNearPlane(componentJson["nearPlane"]);
-                    }
-                    if (componentJson.contains("farPlane")) {
-                        cameraComp->setFarPlane(componentJson["farPlane"]);
-                    }
-                    // Don't restore active state from JSON here - let scene->setActiveCamera() handle it
-                    // This ensures the scene's activeCamera reference and component state stay in sync
-                } else if (type == "MeshRenderer") {
-                    auto meshRenderer = node->addComponent<MeshRenderer>();
-                    
-                    if (componentJson.contains("meshType")) {
-                        std::string meshType = componentJson["meshType"];
-                        std::shared_ptr<Mesh> mesh;
-                        
-                        if (meshType == "QUAD") {
-                            mesh = Mesh::createQuad();
-                        } else if (meshType == "PLANE") {
-                            mesh = Mesh::createPlane(1.0f, 1.0f, 1);
-                        } else if (meshType == "CUBE") {
-                            mesh = Mesh::createCube();
-                        } else if (meshType == "SPHERE") {
-                            mesh = Mesh::createSphere(32, 16);
-                        } else if (meshType == "CAPSULE") {
-                            mesh = Mesh::createCapsule(0.5f, 0.5f);
-                        } else if (meshType == "CYLINDER") {
-                            mesh = Mesh::createCylinder(0.5f, 1.0f);
-                        } else {
-                            mesh = Mesh::createCube(); // Default
-                        }
-                        
-                        meshRenderer->setMesh(mesh);
-                    }
-                    
-                    if (componentJson.contains("material")) {
-                        auto material = std::make_shared<Material>();
-                        auto& materialJson = componentJson["material"];
-                        if (materialJson.contains("color")) {
-                            auto color = materialJson["color"];
-                            if (color.is_array() && color.size() >= 3) {
-                                material->setColor(glm::vec3(color[0], color[1], color[2]));
-                            }
-                        }
-                        
-                        if (materialJson.contains("metallic")) {
-                            material->setMetallic(materialJson["metallic"]);
-                        }
-                        if (materialJson.contains("roughness")) {
-                            material->setRoughness(materialJson["roughness"]);
-                        }
-                        if (materialJson.contains("reflectionStrength")) {
-                            material->setReflectionStrength(materialJson["reflectionStrength"]);
-                        }
-                        
-                        auto& textureManager = TextureManager::getInstance();
-                        
-                        if (materialJson.contains("diffuseTexture")) {
-                            std::string diffusePath = materialJson["diffuseTexture"];
-                            auto diffuseTexture = textureManager.getTexture(diffusePath);
-                            if (diffuseTexture) {
-                                material->setDiffuseTexture(diffuseTexture, diffusePath);
-                            }
-                        }
-                        
-                        if (materialJson.contains("normalTexture")) {
-                            std::string normalPath = materialJson["normalTexture"];
-                            auto normalTexture = textureManager.getTexture(normalPath);
-                            if (normalTexture) {
-                                material->setNormalTexture(normalTexture, normalPath);
-                            }
-                        }
-                        
-                        if (materialJson.contains("armTexture")) {
-                            std::string armPath = materialJson["armTexture"];
-                            auto armTexture = textureManager.getTexture(armPath);
-                            if (armTexture) {
-                                material->setARMTexture(armTexture, armPath);
-                            }
-                        }
-                        
-                        meshRenderer->setMaterial(material);
-                    }
-                } else if (type == "ModelRenderer") {
-                    auto modelRenderer = node->addComponent<ModelRenderer>();
-                    
-                    if (componentJson.contains("modelPath")) {
-                        std::string modelPath = componentJson["modelPath"];
-                        modelRenderer->loadModel(modelPath);
-                    }
-                    
-                    if (componentJson.contains("castShadows")) {
-                        modelRenderer->setCastShadows(componentJson["castShadows"]);
-                    }
-                    
-                    if (componentJson.contains("receiveShadows")) {
-                        modelRenderer->setReceiveShadows(componentJson["receiveShadows"]);
-                    }
-                } else if (type == "LightComponent") {
-                    auto lightComp = node->addComponent<LightComponent>();
-                    
-                    if (componentJson.contains("lightType")) {
-                        std::string lightType = componentJson["lightType"];
-                        if (lightType == "POINT") {
-                            lightComp->setType(LightType::POINT);
-                        } else if (lightType == "DIRECTIONAL") {
-                            lightComp->setType(LightType::DIRECTIONAL);
-                        } else if (lightType == "SPOT") {
-                            lightComp->setType(LightType::SPOT);
-                        }
-                    }
-                    
-                    if (componentJson.contains("color")) {
-                        auto color = componentJson["color"];
-                        if (color.is_array() && color.size() >= 3) {
-                            lightComp->setColor(glm::vec3(color[0], color[1], color[2]));
-                        }
-                    }
-                    
-                    if (componentJson.contains("intensity")) {
-                        lightComp->setIntensity(componentJson["intensity"]);
-                    }
-                    
-                    if (componentJson.contains("range")) {
-                        lightComp->setRange(componentJson["range"]);
-                    }
-                    
-                    if (componentJson.contains("showGizmo")) {
-                        lightComp->setShowGizmo(componentJson["showGizmo"]);
-                    }
-                    
-                    if (componentJson.contains("direction")) {
-                        auto direction = componentJson["direction"];
-                        if (direction.is_array() && direction.size() >= 3) {
-                            lightComp->setDirection(glm::vec3(direction[0], direction[1], direction[2]));
-                        }
-                    }
-                    
-                    if (componentJson.contains("cutOff")) {
-                        lightComp->setCutOff(componentJson["cutOff"]);
-                    }
-                    
-                    if (componentJson.contains("outerCutOff")) {
-                        lightComp->setOuterCutOff(componentJson["outerCutOff"]);
-                    }
-                    
-                    lightComp->start(); // Initialize the light
-                } else if (type == "PhysicsComponent") {
-                    auto physicsComp = node->addComponent<PhysicsComponent>();
-                    
-                    if (componentJson.contains("collisionShapeType")) {
-                        std::string shapeType = componentJson["collisionShapeType"];
-                        if (shapeType == "BOX") {
-                            physicsComp->setCollisionShape(CollisionShapeType::BOX);
-                        } else if (shapeType == "SPHERE") {
-                            physicsComp->setCollisionShape(CollisionShapeType::SPHERE);
-                        } else if (shapeType == "CAPSULE") {
-                            physicsComp->setCollisionShape(CollisionShapeType::CAPSULE);
-                        } else if (shapeType == "CYLINDER") {
-                            physicsComp->setCollisionShape(CollisionShapeType::CYLINDER);
-                        } else if (shapeType == "PLANE") {
-                            physicsComp->setCollisionShape(CollisionShapeType::PLANE);
-                        }
-                    }
-                    
-                    if (componentJson.contains("bodyType")) {
-                        std::string bodyType = componentJson["bodyType"];
-                        if (bodyType == "STATIC") {
-                            physicsComp->setBodyType(PhysicsBodyType::STATIC);
-                        } else if (bodyType == "DYNAMIC") {
-                            physicsComp->setBodyType(PhysicsBodyType::DYNAMIC);
-                        } else if (bodyType == "KINEMATIC") {
-                            physicsComp->setBodyType(PhysicsBodyType::KINEMATIC);
-                        }
-                    }
-                    
-                    if (componentJson.contains("mass")) {
-                        physicsComp->setMass(componentJson["mass"]);
-                    }
-                    
-                    if (componentJson.contains("friction")) {
-                        physicsComp->setFriction(componentJson["friction"]);
-                    }
-                    
-                    if (componentJson.contains("restitution")) {
-                        physicsComp->setRestitution(componentJson["restitution"]);
-                    }
-                    
-                    if (componentJson.contains("linearDamping")) {
-                        physicsComp->setLinearDamping(componentJson["linearDamping"]);
-                    }
-                    
-                    if (componentJson.contains("angularDamping")) {
-                        physicsComp->setAngularDamping(componentJson["angularDamping"]);
-                    }
-                    
-                    if (componentJson.contains("showCollisionShape")) {
-                        physicsComp->setShowCollisionShape(componentJson["showCollisionShape"]);
-                    }
-                    
-                } else if (type == "TextComponent") {
-                    auto textComp = node->addComponent<TextComponent>();
-                    
-                    if (componentJson.contains("text")) {
-                        textComp->setText(componentJson["text"]);
-                    }
-                    
-                    if (componentJson.contains("fontPath")) {
-                        textComp->setFontPath(componentJson["fontPath"]);
-                    }
-                    
-                    if (componentJson.contains("fontSize")) {
-                        textComp->setFontSize(componentJson["fontSize"]);
-                    }
-                    
-                    if (componentJson.contains("color") && componentJson["color"].is_array() && componentJson["color"].size() >= 4) {
-                        glm::vec4 color(
-                            componentJson["color"][0],
-                            componentJson["color"][1],
-                            componentJson["color"][2],
-                            componentJson["color"][3]
-                        );
-                        textComp->setColor(color);
-                    }
-                    
-                    if (componentJson.contains("renderMode")) {
-                        std::string renderMode = componentJson["renderMode"];
-                        if (renderMode == "WORLD_SPACE") {
-                            textComp->setRenderMode(TextRenderMode::WORLD_SPACE);
-                        } else if (renderMode == "SCREEN_SPACE") {
-                            textComp->setRenderMode(TextRenderMode::SCREEN_SPACE);
-                        }
-                    }
-                    
-                    if (componentJson.contains("alignment")) {
-                        std::string alignment = componentJson["alignment"];
-                        if (alignment == "LEFT") {
-                            textComp->setAlignment(TextAlignment::LEFT);
-                        } else if (alignment == "CENTER") {
-                            textComp->setAlignment(TextAlignment::CENTER);
-                        } else if (alignment == "RIGHT") {
-                            textComp->setAlignment(TextAlignment::RIGHT);
-                        }
-                    }
-                    
-                    if (componentJson.contains("scale")) {
-                        textComp->setScale(componentJson["scale"]);
-                    }
-                    
-                    if (componentJson.contains("lineSpacing")) {
-                        textComp->setLineSpacing(componentJson["lineSpacing"]);
-                    }
-                    
-                    textComp->start(); // Initialize the text component
-                } else if (type == "ScriptComponent") {
-                    auto scriptComp = node->addComponent<ScriptComponent>();
-                    
-                    // Check for both "scriptPath" (current) and "script" (legacy) for compatibility
-                    std::string scriptPath = "";
-                    if (componentJson.contains("scriptPath") && !componentJson["scriptPath"].is_null()) {
-                        scriptPath = componentJson["scriptPath"];
-                    } else if (componentJson.contains("script") && !componentJson["script"].is_null()) {
-                        scriptPath = componentJson["script"]; // Legacy support
-                    }
-                    
-                    if (!scriptPath.empty()) {
-                        scriptComp->loadScript(scriptPath);
-                        // Don't start scripts during deserialization, they will be started
-                        // when Scene::start() is called after the entire scene is loaded
-                        // This ensures all nodes and components are available when scripts start
-                    } else {
-#ifdef LINUX_BUILD
-                        std::cout << "ScriptComponent on node \"" << name << "\" has empty script path, skipping start()" << std::endl;
-#endif
-                    }
-                    
-                    // Load pause exempt setting
-                    if (componentJson.contains("pauseExempt") && componentJson["pauseExempt"].is_boolean()) {
-                        bool pauseExempt = componentJson["pauseExempt"];
-                        scriptComp->setPauseExempt(pauseExempt);
-#ifdef LINUX_BUILD
-                        std::cout << "ScriptComponent on node \"" << name << "\" pauseExempt set to: " << (pauseExempt ? "true" : "false") << std::endl;
-#endif
-                    } else {
-#ifdef LINUX_BUILD
-                        std::cout << "ScriptComponent on node \"" << name << "\" pauseExempt not found in JSON, defaulting to false" << std::endl;
-#endif
-                    }
-                } else if (type == "SoundComponent") {
-                    auto soundComp = node->addComponent<SoundComponent>();
-                    
-                    if (componentJson.contains("volume")) {
-                        soundComp->setVolume(componentJson["volume"]);
-                    }
-                    
-                    if (componentJson.contains("loop")) {
-                        soundComp->setLoop(componentJson["loop"]);
-                    }
-                    
-                    if (componentJson.contains("soundFile") && !componentJson["soundFile"].is_null()) {
-                        soundComp->setSoundFile(componentJson["soundFile"]);
-                    }
-                    
-                    soundComp->start();
-                } else if (type == "SkyboxComponent") {
-                    auto skyboxComp = node->addComponent<SkyboxComponent>();
-                    
-                    if (componentJson.contains("rightTexture")) {
-                        skyboxComp->setRightTexture(componentJson["rightTexture"]);
-                    }
-                    if (componentJson.contains("leftTexture")) {
-                        skyboxComp->setLeftTexture(componentJson["leftTexture"]);
-                    }
-                    if (componentJson.contains("topTexture")) {
-                        skyboxComp->setTopTexture(componentJson["topTexture"]);
-                    }
-                    if (componentJson.contains("bottomTexture")) {
-                        skyboxComp->setBottomTexture(componentJson["bottomTexture"]);
-                    }
-                    if (componentJson.contains("frontTexture")) {
-                        skyboxComp->setFrontTexture(componentJson["frontTexture"]);
-                    }
-                    if (componentJson.contains("backTexture")) {
-                        skyboxComp->setBackTexture(componentJson["backTexture"]);
-                    }
-                    
-                    skyboxComp->start();
-                    
-                    if (componentJson.contains("active")) {
-                        bool active = componentJson["active"];
-                        skyboxComp->setActive(active);
-                    }
-                } else if (type == "Area3DComponent") {
-#ifdef LINUX_BUILD
-                    std::cout << "Deserializing Area3DComponent for node: " << name << std::endl;
-#endif
-                    auto area3DComp = node->addComponent<Area3DComponent>();
-                    if (!area3DComp) {
-#ifdef LINUX_BUILD
-                        std::cerr << "ERROR: Failed to add Area3DComponent to node: " << name << std::endl;
-#endif
-                    } else {
+        it = cache.insert(std::make_pair(prefabPath, rootNode)).first;
+    }
+    
+    // Without its prefab the whole node is written, still naming the prefab
+    if (!it->second.is_object()) {
+        json full = nodeJson;
+        full["prefab"] = prefabPath;
+        return full;
+    }
+    
+    json instance = diffPrefabNode(nodeJson, it->second, true);
+    instance["prefab"] = prefabPath;
+    return instance;
+}
+
+bool SceneSerializer::savePrefab(std::shared_ptr<SceneNode> node, const std::string& filepath) {
+    if (!node || filepath.empty()) {
+        return false;
+    }
+    
+    // The prefab holds the whole subtree, even when the node was itself an
+    // instance of another prefab
+    std::string previousPrefab = node->getPrefabPath();
+    node->setPrefabPath("");
+    json prefabJson;
+    prefabJson["name"] = node->getName();
+    prefabJson["version"] = "1.0";
+    prefabJson["rootNode"] = serializeNodeToJson(node);
+    
 #ifdef LINUX_BUILD
-                        std::cout << "Successfully added Area3DComponent to node: " << name << std::endl;
+    std::error_code error;
+    std::filesystem::path directory = std::filesystem::path(filepath).parent_path();
+    if (!directory.empty()) {
+        std::filesystem::create_directories(directory, error);
+    }
 #endif
-                    }
-                    
-                    if (componentJson.contains("shapeType")) {
-                        std::string shapeTypeStr = componentJson["shapeType"];
-                        if (shapeTypeStr == "BOX") {
-                            area3DComp->setShape(Area3DShape::BOX);
-                        } else if (shapeTypeStr == "SPHERE") {
-                            area3DComp->setShape(Area3DShape::SPHERE);
-                        } else if (shapeTypeStr == "CAPSULE") {
-                            area3DComp->setShape(Area3DShape::CAPSULE);
-                        } else if (shapeTypeStr == "CYLINDER") {
-                            area3DComp->setShape(Area3DShape::CYLINDER);
-                        } else if (shapeTypeStr == "PLANE") {
-                            area3DComp->setShape(Area3DShape::PLANE);
-                        }
-                    }
-                    
-                    if (componentJson.contains("dimensions")) {
-                        auto dims = componentJson["dimensions"];
-                        if (dims.is_array() && dims.size() >= 3) {
-                            area3DComp->setDimensions(glm::vec3(dims[0], dims[1], dims[2]));
-                        }
-                    }
-                    
-                    if (componentJson.contains("radius")) {
-                        area3DComp->setRadius(componentJson["radius"]);
-                    }
-                    
-                    if (componentJson.contains("height")) {
-                        area3DComp->setHeight(componentJson["height"]);
-                    }
-                    
-                    if (componentJson.contains("group")) {
-                        area3DComp->setGroup(componentJson["group"]);
-                    }
-                    
-                    if (componentJson.contains("monitorMode")) {
-                        area3DComp->setMonitorMode(componentJson["monitorMode"]);
-                    }
-                    
-                    if (componentJson.contains("showDebugShape")) {
-                        area3DComp->setShowDebugShape(componentJson["showDebugShape"]);
-                    }
-                    
-                    area3DComp->start(); // Initialize the area3D component
-                } else if (type == "AnimationComponent") {
-                    auto animComp = node->addComponent<AnimationComponent>();
-                    
-                    if (componentJson.contains("skeletonName")) {
-                        std::string skeletonName = componentJson["skeletonName"];
-                        animComp->setSkeleton(skeletonName);
-                    }
-                    
-                    if (componentJson.contains("animationClipName")) {
-                        std::string clipName = componentJson["animationClipName"];
-                        animComp->setAnimationClip(clipName);
-                    }
-                    
-                    if (componentJson.contains("loop")) {
-                        animComp->setLoop(componentJson["loop"]);
-                    }
-                    
-                    if (componentJson.contains("speed")) {
-                        animComp->setSpeed(componentJson["speed"]);
-                    }
-                    
-                    if (componentJson.contains("enableRootMotion")) {
-                        animComp->setRootMotionEnabled(componentJson["enableRootMotion"]);
-                    }
-                    
-                    if (componentJson.contains("autoPlay") && componentJson["autoPlay"]) {
-                        animComp->play();
-                    }
-                }
-            }
-        }
-        
-        // Children
-        if (nodeJson.contains("children") && nodeJson["children"].is_array()) {
-            auto& childrenArray = nodeJson["children"];
-            for (const auto& childJson : childrenArray) {
-                auto child = deserializeNodeFromJson(childJson);
-                if (child) {
-                    node->addChild(child);
-                }
-            }
-        }
-        
-        return node;
-#ifndef VITA_BUILD
-    } catch (const json::exception& e) {
-        std::cerr << "Error parsing node JSON: " << e.what() << std::endl;
-        return nullptr;
-    } catch (const std::exception& e) {
-        std::cerr << "Error deserializing node from JSON: " << e.what() << std::endl;
-        return nullptr;
+    
+    std::string text = prefabJson.dump(2);
+    if (!writeSceneFile(filepath, text.data(), text.size())) {
+        node->setPrefabPath(previousPrefab);
+        return false;
     }
+    
+    node->setPrefabPath(filepath);
+    getPrefabJsonCache().erase(filepath);
+    PrefabLibrary::getInstance().reload(filepath);
+#ifdef VITA_BUILD
+    printf("Prefab saved to: %s\n", filepath.c_str());
+#else
+    std::cout << "Prefab saved to: " << filepath << std::endl;
 #endif
+    return true;
 }
 
 #ifdef LINUX_BUILD
@@ -2871,6 +2689,8 @@ void SceneSerializer::updateMakefileWithAssets(const std::vector<std::string>& d
         newVpkCommand += "\t\t-a fonts.txt=fonts.txt \\\n";
         newVpkCommand += "\t\t-a scripts.txt=scripts.txt \\\n";
         newVpkCommand += "\t\t-a input_mappings.txt=input_mappings.txt \\\n";
+        // Generated mains instantiate prefabs from their files
+        newVpkCommand += "\t\t$(foreach f,$(wildcard assets/prefabs/*.json),-a $(f)=$(f)) \\\n";
         
         // Add texture assets
         for (const auto& texturePath : discoveredTextures) {
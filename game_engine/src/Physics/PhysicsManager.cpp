@@ -3,6 +3,8 @@
 #include "Components/PhysicsComponent.h"
 #include "Scene/SceneNode.h"
 #include "Core/ThreadManager.h"
+#include "Core/Profiler.h"
+#include "Core/Stats.h"
 
 // Bullet includes
 #include <btBulletDynamicsCommon.h>
@@ -11,6 +13,7 @@
 #include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
 #include "BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
 #include "LinearMath/btThreads.h"
+#include "LinearMath/btQuickprof.h"
 #include <algorithm>
 #include <thread>
 
@@ -28,6 +31,18 @@ static const bool ENABLE_PHYSICS_MULTITHREADING = true;
 static const int MAX_PHYSICS_THREADS = 8;
 #endif
 
+#if ENGINE_PROFILER
+// Bullet's BT_PROFILE scopes (step, broadphase, solver) become zones, on
+// whichever worker runs them
+static void enterBulletZone(const char* name) {
+    Profiler::getInstance().beginZone(name);
+}
+
+static void leaveBulletZone() {
+    Profiler::getInstance().endZone();
+}
+#endif
+
 PhysicsManager::PhysicsManager()
     : dynamicsWorld(nullptr)
     , collisionConfiguration(nullptr)
@@ -35,7 +50,9 @@ PhysicsManager::PhysicsManager()
     , broadphase(nullptr)
     , solver(nullptr)
     , ghostPairCallback(nullptr)
+    , scheduler(nullptr)
     , debugDrawEnabled(false)
+    , requestedThreadCount(0)
 {   
 }
 
@@ -50,6 +67,11 @@ PhysicsManager& PhysicsManager::getInstance() {
 }
 
 bool PhysicsManager::initialize() {
+#if ENGINE_PROFILER
+    btSetCustomEnterProfileZoneFunc(enterBulletZone);
+    btSetCustomLeaveProfileZoneFunc(leaveBulletZone);
+#endif
+    
     collisionConfiguration = new btDefaultCollisionConfiguration();
     
     scheduler = nullptr;
@@ -75,9 +97,15 @@ bool PhysicsManager::initialize() {
             int requestedThreads;
             #ifdef VITA_BUILD
             requestedThreads = MAX_PHYSICS_THREADS_VITA + 1;
+            if (requestedThreadCount > 0) {
+                requestedThreads = std::min(requestedThreadCount, MAX_PHYSICS_THREADS_VITA + 1);
+            }
             #else
             int availableCores = std::thread::hardware_concurrency();
             requestedThreads = std::max(1, std::min(availableCores - 1, MAX_PHYSICS_THREADS));
+            if (requestedThreadCount > 0) {
+                requestedThreads = std::min(requestedThreadCount, MAX_PHYSICS_THREADS);
+            }
             #endif
             
             scheduler->setNumThreads(requestedThreads);
@@ -180,12 +208,30 @@ void PhysicsManager::shutdown() {
 }
 
 void PhysicsManager::update(float deltaTime) {
+    PROFILE_ZONE("PhysicsManager::update");
     if (dynamicsWorld) {
         int maxSubSteps = 20;
         float fixedTimeStep = 1.0f / 60.0f;
         
         dynamicsWorld->stepSimulation(deltaTime, maxSubSteps, fixedTimeStep);
         
+        static Stat& bodies = Stats::getInstance().getGauge("Physics bodies");
+        bodies.set(dynamicsWorld->getNumCollisionObjects());
+        
+        PROFILE_ZONE("PhysicsManager::syncTransforms");
+        for (auto* component : physicsComponents) {
+            if (component && component->isEnabled()) {
+                component->syncTransformFromPhysics();
+            }
+        }
+    }
+}
+
+void PhysicsManager::stepFixed(float fixedTimeStep) {
+    if (dynamicsWorld) {
+        // maxSubSteps = 0 makes Bullet take a single step of exactly fixedTimeStep
+        dynamicsWorld->stepSimulation(fixedTimeStep, 0, fixedTimeStep);
+        
         for (auto* component : physicsComponents) {
             if (component && component->isEnabled()) {
                 component->syncTransformFromPhysics();
@@ -194,6 +240,61 @@ void PhysicsManager::update(float deltaTime) {
     }
 }
 
+int PhysicsManager::getThreadCount() const {
+    return scheduler ? scheduler->getNumThreads() : 1;
+}
+
+int PhysicsManager::getRigidBodyCount() const {
+    return dynamicsWorld ? dynamicsWorld->getNumCollisionObjects() : 0;
+}
+
+int PhysicsManager::getContactCount() const {
+    if (!dispatcher) return 0;
+    
+    int contacts = 0;
+    int numManifolds = dispatcher->getNumManifolds();
+    for (int i = 0; i < numManifolds; i++) {
+        contacts += dispatcher->getManifoldByIndexInternal(i)->getNumContacts();
+    }
+    return contacts;
+}
+
+uint64_t PhysicsManager::computeStateHash() const {
+    // FNV-1a over the raw bits of every body's transform and velocities,
+    // in world order. Any divergence between two runs changes the hash.
+    uint64_t hash = 14695981039346656037ULL;
+    if (!dynamicsWorld) return hash;
+    
+    auto mix = [&hash](const btScalar* values, int count) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+        for (size_t i = 0; i < count * sizeof(btScalar); i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    
+    const btCollisionObjectArray& objects = dynamicsWorld->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); i++) {
+        const btTransform& transform = objects[i]->getWorldTransform();
+        btQuaternion rotation = transform.getRotation();
+        btScalar state[7] = {
+            transform.getOrigin().x(), transform.getOrigin().y(), transform.getOrigin().z(),
+            rotation.x(), rotation.y(), rotation.z(), rotation.w()
+        };
+        mix(state, 7);
+        
+        const btRigidBody* body = btRigidBody::upcast(objects[i]);
+        if (body) {
+            btScalar velocity[6] = {
+                body->getLinearVelocity().x(), body->getLinearVelocity().y(), body->getLinearVelocity().z(),
+                body->getAngularVelocity().x(), body->getAngularVelocity().y(), body->getAngularVelocity().z()
+            };
+            mix(velocity, 6);
+        }
+    }
+    return hash;
+}
+
 void PhysicsManager::addRigidBody(btRigidBody* body) {
     if (dynamicsWorld && body) {
         dynamicsWorld->addRigidBody(body);
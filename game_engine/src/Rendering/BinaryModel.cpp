@@ -148,6 +148,9 @@ std::vector<std::shared_ptr<Mesh>> BinaryModel::createMeshes() {
         
         mesh->setVertices(meshVertices);
         mesh->setIndices(meshIndices);
+        // The binary format carries no skinning data
+        mesh->setVertexFormat(VertexFormat::STATIC_COMPACT);
+        mesh->optimize();
         mesh->upload();
         
         meshes.push_back(mesh);
@@ -1,8 +1,10 @@
 #include "Rendering/FontManager.h"
 #include "Rendering/Texture.h"
+#include "Rendering/RenderDevice.h"
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <climits>
+#include <algorithm>
 
 // Include stb_truetype
 #define STB_TRUETYPE_IMPLEMENTATION
@@ -10,118 +12,367 @@
 
 namespace GameEngine {
 
+const int FontManager::SDF_BASE_SIZE;
+const int FontManager::SDF_PADDING;
+const int FontManager::PAGE_SIZE;
+
+// Four 512x512 single-channel pages
+static const size_t DEFAULT_CACHE_BUDGET = 4 * 512 * 512;
+
 FontManager& FontManager::getInstance() {
     static FontManager instance;
     return instance;
 }
 
-std::shared_ptr<FontAtlas> FontManager::loadFont(const std::string& fontPath, float fontSize, 
-                                                uint32_t atlasWidth, uint32_t atlasHeight,
-                                                uint32_t charsToInclude, uint32_t firstCharCodePoint) {
-    std::string key = getFontKey(fontPath, fontSize);
-    
-    auto it = fontCache.find(key);
-    if (it != fontCache.end()) {
+FontManager::FontManager()
+    : nextFaceId(1)
+    , cacheEpoch(0)
+    , useClock(0)
+    , cacheBudget(DEFAULT_CACHE_BUDGET)
+{
+}
+
+std::shared_ptr<FontFace> FontManager::loadFace(const std::string& fontPath) {
+    auto it = faces.find(fontPath);
+    if (it != faces.end()) {
         return it->second;
     }
-    
-    auto atlas = std::make_shared<FontAtlas>();
-    if (generateFontAtlas(fontPath, fontSize, *atlas, atlasWidth, atlasHeight, charsToInclude, firstCharCodePoint)) {
-        fontCache[key] = atlas;
-        return atlas;
+
+    auto face = std::make_shared<FontFace>();
+    if (!loadFontFile(fontPath, face->data)) {
+        std::cerr << "Failed to load font file: " << fontPath << std::endl;
+        return nullptr;
+    }
+
+    if (!stbtt_InitFont(&face->info, face->data.data(), stbtt_GetFontOffsetForIndex(face->data.data(), 0))) {
+        std::cerr << "Failed to initialize font: " << fontPath << std::endl;
+        return nullptr;
     }
-    
-    return nullptr;
+
+    int ascent, descent, lineGap;
+    stbtt_GetFontVMetrics(&face->info, &ascent, &descent, &lineGap);
+
+    face->path = fontPath;
+    face->id = nextFaceId++;
+    face->sdfScale = stbtt_ScaleForPixelHeight(&face->info, static_cast<float>(SDF_BASE_SIZE));
+    face->ascent = ascent * face->sdfScale;
+    face->descent = descent * face->sdfScale;
+    face->lineGap = lineGap * face->sdfScale;
+
+    faces[fontPath] = face;
+    return face;
 }
 
-std::shared_ptr<FontAtlas> FontManager::getFont(const std::string& fontPath, float fontSize) {
-    std::string key = getFontKey(fontPath, fontSize);
-    auto it = fontCache.find(key);
-    return (it != fontCache.end()) ? it->second : nullptr;
+std::shared_ptr<FontFace> FontManager::getFace(const std::string& fontPath) {
+    auto it = faces.find(fontPath);
+    return (it != faces.end()) ? it->second : nullptr;
 }
 
-bool FontManager::generateFontAtlas(const std::string& fontPath, float fontSize, FontAtlas& atlas,
-                                  uint32_t atlasWidth, uint32_t atlasHeight,
-                                  uint32_t charsToInclude, uint32_t firstCharCodePoint) {
-    std::vector<uint8_t> fontData;
-    if (!loadFontFile(fontPath, fontData)) {
-        std::cerr << "Failed to load font file: " << fontPath << std::endl;
-        return false;
+const GlyphInfo* FontManager::getGlyph(FontFace& face, uint32_t codepoint) {
+    auto& device = RenderDevice::getInstance();
+    // Missing code points resolve to glyph 0 (.notdef) and share its entry
+    int glyphIndex = stbtt_FindGlyphIndex(&face.info, static_cast<int>(codepoint));
+    uint64_t key = (static_cast<uint64_t>(face.id) << 32) | static_cast<uint32_t>(glyphIndex);
+
+    auto it = glyphs.find(key);
+    if (it != glyphs.end()) {
+        if (it->second.hasBitmap) {
+            touchPage(it->second.pageId);
+        }
+        return &it->second;
     }
-    
-    stbtt_fontinfo fontInfo;
-    if (!stbtt_InitFont(&fontInfo, fontData.data(), 0)) {
-        std::cerr << "Failed to initialize font: " << fontPath << std::endl;
-        return false;
+
+    GlyphInfo glyph;
+    int advance, leftSideBearing;
+    stbtt_GetGlyphHMetrics(&face.info, glyphIndex, &advance, &leftSideBearing);
+    glyph.advance = advance * face.sdfScale;
+
+    // Edge at 128, fading to 0 / 255 SDF_PADDING pixels outside / inside
+    const unsigned char onEdge = 128;
+    const float distanceScale = static_cast<float>(onEdge) / SDF_PADDING;
+    int width = 0, height = 0, xoff = 0, yoff = 0;
+    unsigned char* bitmap = stbtt_GetGlyphSDF(&face.info, face.sdfScale, glyphIndex, SDF_PADDING,
+                                              onEdge, distanceScale, &width, &height, &xoff, &yoff);
+
+    if (bitmap) {
+        uint32_t pageId;
+        int x, y;
+        // One texel of gutter so linear filtering never picks up a neighbour
+        if (!allocateGlyphRect(width + 1, height + 1, pageId, x, y)) {
+            stbtt_FreeSDF(bitmap, nullptr);
+            std::cerr << "FontManager: glyph " << codepoint << " does not fit in the glyph cache" << std::endl;
+            return nullptr;
+        }
+
+        GlyphPage& page = pages[pageId];
+        device.bindTexture(GL_TEXTURE_2D, page.texture->getID());
+        device.pixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        device.texSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_LUMINANCE, GL_UNSIGNED_BYTE, bitmap);
+        device.pixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        device.bindTexture(GL_TEXTURE_2D, 0);
+        stbtt_FreeSDF(bitmap, nullptr);
+
+        const float invPage = 1.0f / PAGE_SIZE;
+        glyph.pageId = pageId;
+        glyph.uvMin = glm::vec2(x * invPage, y * invPage);
+        glyph.uvMax = glm::vec2((x + width) * invPage, (y + height) * invPage);
+        glyph.offset = glm::vec2(static_cast<float>(xoff), static_cast<float>(yoff));
+        glyph.size = glm::vec2(static_cast<float>(width), static_cast<float>(height));
+        glyph.hasBitmap = true;
+
+        page.glyphKeys.push_back(key);
+        touchPage(pageId);
     }
-    
-    int fontCount = stbtt_GetNumberOfFonts(fontData.data());
-    std::cout << "Font file: " << fontPath << " has " << fontCount << " fonts" << std::endl;
-    
-    std::vector<uint8_t> atlasData(atlasWidth * atlasHeight);
-    
-    stbtt_pack_context packContext;
-    if (!stbtt_PackBegin(&packContext, atlasData.data(), atlasWidth, atlasHeight, 0, 1, nullptr)) {
-        std::cerr << "Failed to begin font packing" << std::endl;
-        return false;
+
+    return &(glyphs[key] = glyph);
+}
+
+std::shared_ptr<Texture> FontManager::getPageTexture(uint32_t pageId) const {
+    return pageId < pages.size() ? pages[pageId].texture : nullptr;
+}
+
+void FontManager::touchPage(uint32_t pageId) {
+    if (pageId < pages.size()) {
+        pages[pageId].lastUsed = ++useClock;
+    }
+}
+
+void FontManager::setCacheBudget(size_t bytes) {
+    cacheBudget = bytes;
+
+    // Release trailing pages until we are back under budget; ids of the
+    // remaining pages stay valid
+    while (pages.size() > 1 && getCacheMemory() > cacheBudget) {
+        evictPage(static_cast<uint32_t>(pages.size() - 1));
+        pages.pop_back();
+    }
+}
+
+size_t FontManager::getCacheMemory() const {
+    return pages.size() * static_cast<size_t>(PAGE_SIZE) * PAGE_SIZE;
+}
+
+void FontManager::clearCache() {
+    glyphs.clear();
+    pages.clear();
+    faces.clear();
+    cacheEpoch++;
+}
+
+void FontManager::removeFont(const std::string& fontPath) {
+    // Its cached glyphs age out of the pages like any other unused glyph
+    faces.erase(fontPath);
+}
+
+bool FontManager::isFontLoaded(const std::string& fontPath) const {
+    return faces.find(fontPath) != faces.end();
+}
+
+uint32_t FontManager::decodeUTF8(const std::string& text, size_t& index) {
+    static const uint32_t REPLACEMENT = 0xFFFD;
+    static const uint32_t minValue[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+    unsigned char c = static_cast<unsigned char>(text[index]);
+    if (c < 0x80) {
+        index++;
+        return c;
+    }
+
+    int length;
+    uint32_t codepoint;
+    if ((c & 0xE0) == 0xC0) {
+        length = 2;
+        codepoint = c & 0x1F;
+    } else if ((c & 0xF0) == 0xE0) {
+        length = 3;
+        codepoint = c & 0x0F;
+    } else if ((c & 0xF8) == 0xF0) {
+        length = 4;
+        codepoint = c & 0x07;
+    } else {
+        index++;
+        return REPLACEMENT;
+    }
+
+    if (index + length > text.size()) {
+        index++;
+        return REPLACEMENT;
+    }
+
+    for (int i = 1; i < length; i++) {
+        unsigned char continuation = static_cast<unsigned char>(text[index + i]);
+        if ((continuation & 0xC0) != 0x80) {
+            index++;
+            return REPLACEMENT;
+        }
+        codepoint = (codepoint << 6) | (continuation & 0x3F);
+    }
+
+    // Reject overlong encodings, surrogates and values past U+10FFFF
+    if (codepoint < minValue[length] || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        index++;
+        return REPLACEMENT;
     }
-    
-    atlas.packedChars.resize(charsToInclude);
-    
-    if (!stbtt_PackFontRange(&packContext, fontData.data(), 0, fontSize, 
-                            firstCharCodePoint, charsToInclude, atlas.packedChars.data())) {
-        std::cerr << "Failed to pack font range for font: " << fontPath << " (size: " << fontSize << ")" << std::endl;
-        std::cerr << "Atlas size: " << atlasWidth << "x" << atlasHeight << ", Characters: " << charsToInclude << std::endl;
-        stbtt_PackEnd(&packContext);
+
+    index += length;
+    return codepoint;
+}
+
+bool FontManager::allocateGlyphRect(int width, int height, uint32_t& pageId, int& x, int& y) {
+    if (width > PAGE_SIZE || height > PAGE_SIZE) {
         return false;
     }
-    
-    stbtt_PackEnd(&packContext);
-    
-    std::cout << "Successfully generated font atlas for: " << fontPath << " (size: " << fontSize << ")" << std::endl;
-    
-    atlas.alignedQuads.resize(charsToInclude);
-    for (uint32_t i = 0; i < charsToInclude; i++) {
-        float unusedX, unusedY;
-        stbtt_GetPackedQuad(atlas.packedChars.data(), atlasWidth, atlasHeight, i,
-                           &unusedX, &unusedY, &atlas.alignedQuads[i], 0);
-    }
-    
-    if (!createFontAtlasTexture(atlasData, atlasWidth, atlasHeight, atlas.texture)) {
-        std::cerr << "Failed to create font atlas texture" << std::endl;
+
+    for (size_t i = 0; i < pages.size(); ++i) {
+        if (packIntoPage(pages[i], width, height, x, y)) {
+            pageId = static_cast<uint32_t>(i);
+            return true;
+        }
+    }
+
+    if (pages.empty() || getCacheMemory() + static_cast<size_t>(PAGE_SIZE) * PAGE_SIZE <= cacheBudget) {
+        if (!createPage()) {
+            return false;
+        }
+        pageId = static_cast<uint32_t>(pages.size() - 1);
+        return packIntoPage(pages.back(), width, height, x, y);
+    }
+
+    // Over budget: recycle the page that has gone unused the longest
+    uint32_t victim = 0;
+    for (size_t i = 1; i < pages.size(); ++i) {
+        if (pages[i].lastUsed < pages[victim].lastUsed) {
+            victim = static_cast<uint32_t>(i);
+        }
+    }
+    evictPage(victim);
+    pageId = victim;
+    return packIntoPage(pages[victim], width, height, x, y);
+}
+
+// Skyline bottom-left: place the rect where its top edge ends up lowest,
+// preferring the narrower segment on ties
+bool FontManager::packIntoPage(GlyphPage& page, int width, int height, int& x, int& y) {
+    std::vector<SkylineNode>& skyline = page.skyline;
+
+    int bestIndex = -1;
+    int bestTop = INT_MAX;
+    int bestWidth = INT_MAX;
+    int bestY = 0;
+
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        int nodeX = skyline[i].x;
+        if (nodeX + width > PAGE_SIZE) {
+            break;
+        }
+
+        int fitY = 0;
+        int remaining = width;
+        size_t j = i;
+        while (remaining > 0 && j < skyline.size()) {
+            fitY = std::max(fitY, skyline[j].y);
+            remaining -= skyline[j].width;
+            ++j;
+        }
+        if (fitY + height > PAGE_SIZE) {
+            continue;
+        }
+
+        int top = fitY + height;
+        if (top < bestTop || (top == bestTop && skyline[i].width < bestWidth)) {
+            bestIndex = static_cast<int>(i);
+            bestTop = top;
+            bestWidth = skyline[i].width;
+            bestY = fitY;
+        }
+    }
+
+    if (bestIndex < 0) {
         return false;
     }
-    
-    atlas.atlasWidth = atlasWidth;
-    atlas.atlasHeight = atlasHeight;
-    atlas.fontSize = static_cast<uint32_t>(fontSize);
-    atlas.charsToInclude = charsToInclude;
-    atlas.firstCharCodePoint = firstCharCodePoint;
-    
-    std::cout << "Successfully generated font atlas for: " << fontPath 
-              << " (size: " << fontSize << ")" << std::endl;
-    
+
+    x = skyline[bestIndex].x;
+    y = bestY;
+
+    SkylineNode node = { x, y + height, width };
+    skyline.insert(skyline.begin() + bestIndex, node);
+
+    // Trim the segments the new one now covers
+    for (size_t i = bestIndex + 1; i < skyline.size(); ) {
+        const SkylineNode& previous = skyline[i - 1];
+        int overlap = previous.x + previous.width - skyline[i].x;
+        if (overlap <= 0) {
+            break;
+        }
+        skyline[i].x += overlap;
+        skyline[i].width -= overlap;
+        if (skyline[i].width <= 0) {
+            skyline.erase(skyline.begin() + i);
+        } else {
+            break;
+        }
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size(); ) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+
     return true;
 }
 
-void FontManager::clearCache() {
-    fontCache.clear();
-}
+bool FontManager::createPage() {
+    auto& device = RenderDevice::getInstance();
+    GlyphPage page;
+    page.texture = std::make_shared<Texture>();
+    page.lastUsed = useClock;
+
+    GLuint textureID;
+    device.genTextures(1, &textureID);
+    device.bindTexture(GL_TEXTURE_2D, textureID);
+
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-void FontManager::removeFont(const std::string& fontPath, float fontSize) {
-    std::string key = getFontKey(fontPath, fontSize);
-    fontCache.erase(key);
+    device.bindTexture(GL_TEXTURE_2D, 0);
+
+    page.texture->setTextureID(textureID);
+    clearPageTexture(page);
+
+    pages.push_back(page);
+    return true;
 }
 
-std::string FontManager::getFontKey(const std::string& fontPath, float fontSize) const {
-    std::stringstream ss;
-    ss << fontPath << "_" << fontSize;
-    return ss.str();
+void FontManager::evictPage(uint32_t pageId) {
+    GlyphPage& page = pages[pageId];
+    for (uint64_t key : page.glyphKeys) {
+        glyphs.erase(key);
+    }
+    page.glyphKeys.clear();
+    clearPageTexture(page);
+    cacheEpoch++;
 }
 
-bool FontManager::isFontLoaded(const std::string& fontPath, float fontSize) const {
-    std::string key = getFontKey(fontPath, fontSize);
-    return fontCache.find(key) != fontCache.end();
+void FontManager::clearPageTexture(GlyphPage& page) {
+    auto& device = RenderDevice::getInstance();
+    page.skyline.clear();
+    SkylineNode root = { 0, 0, PAGE_SIZE };
+    page.skyline.push_back(root);
+
+    // Distance 0 everywhere so stale texels never pass the edge threshold
+    std::vector<uint8_t> blank(static_cast<size_t>(PAGE_SIZE) * PAGE_SIZE, 0);
+    device.bindTexture(GL_TEXTURE_2D, page.texture->getID());
+    device.pixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    device.texImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, PAGE_SIZE, PAGE_SIZE, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, blank.data());
+    device.pixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    device.bindTexture(GL_TEXTURE_2D, 0);
 }
 
 bool FontManager::loadFontFile(const std::string& fontPath, std::vector<uint8_t>& fontData) {
@@ -130,41 +381,19 @@ bool FontManager::loadFontFile(const std::string& fontPath, std::vector<uint8_t>
         std::cerr << "Failed to open font file: " << fontPath << std::endl;
         return false;
     }
-    
+
     file.seekg(0, std::ios::end);
     size_t fileSize = file.tellg();
     file.seekg(0, std::ios::beg);
-    
+
     fontData.resize(fileSize);
     file.read(reinterpret_cast<char*>(fontData.data()), fileSize);
-    
+
     if (!file.good()) {
         std::cerr << "Failed to read font file: " << fontPath << std::endl;
         return false;
     }
-    
-    return true;
-}
 
-bool FontManager::createFontAtlasTexture(const std::vector<uint8_t>& atlasData, uint32_t width, uint32_t height, 
-                                       std::shared_ptr<Texture>& texture) {
-    texture = std::make_shared<Texture>();
-    
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, atlasData.data());
-    
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    
-    glBindTexture(GL_TEXTURE_2D, 0);
-    
-    texture->setTextureID(textureID);
-    
     return true;
 }
 
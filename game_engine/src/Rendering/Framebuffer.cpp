@@ -1,4 +1,5 @@
 #include "Rendering/Framebuffer.h"
+#include "Rendering/RenderDevice.h"
 #include <glm/glm.hpp>
 #include <iostream>
 
@@ -14,11 +15,12 @@ Framebuffer::~Framebuffer() {
 }
 
 bool Framebuffer::create(int w, int h) {
+    auto& device = RenderDevice::getInstance();
     width = w;
     height = h;
     
-    glGenFramebuffers(1, &framebufferID);
-    glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
+    device.genFramebuffers(1, &framebufferID);
+    device.bindFramebuffer(GL_FRAMEBUFFER, framebufferID);
     
     createTextures();
     attachTextures();
@@ -29,32 +31,35 @@ bool Framebuffer::create(int w, int h) {
         return false;
     }
     
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    device.bindFramebuffer(GL_FRAMEBUFFER, 0);
     return true;
 }
 
 void Framebuffer::destroy() {
+    auto& device = RenderDevice::getInstance();
     if (colorTexture) {
-        glDeleteTextures(1, &colorTexture);
+        device.deleteTextures(1, &colorTexture);
         colorTexture = 0;
     }
     if (depthTexture) {
-        glDeleteTextures(1, &depthTexture);
+        device.deleteTextures(1, &depthTexture);
         depthTexture = 0;
     }
     if (framebufferID) {
-        glDeleteFramebuffers(1, &framebufferID);
+        device.deleteFramebuffers(1, &framebufferID);
         framebufferID = 0;
     }
 }
 
 void Framebuffer::bind() const {
-    glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
-    glViewport(0, 0, width, height);
+    auto& device = RenderDevice::getInstance();
+    device.bindFramebuffer(GL_FRAMEBUFFER, framebufferID);
+    device.viewport(0, 0, width, height);
 }
 
 void Framebuffer::unbind() const {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    auto& device = RenderDevice::getInstance();
+    device.bindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 void Framebuffer::resize(int w, int h) {
@@ -65,39 +70,43 @@ void Framebuffer::resize(int w, int h) {
 }
 
 bool Framebuffer::isValid() const {
-    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    auto& device = RenderDevice::getInstance();
+    return device.checkFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
 }
 
 void Framebuffer::clear(const glm::vec3& clearColor) const {
+    auto& device = RenderDevice::getInstance();
     bind();
-    glClearColor(clearColor.r, clearColor.g, clearColor.b, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    device.clearColor(clearColor.r, clearColor.g, clearColor.b, 1.0f);
+    device.clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 void Framebuffer::createTextures() {
-    glGenTextures(1, &colorTexture);
-    glBindTexture(GL_TEXTURE_2D, colorTexture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    auto& device = RenderDevice::getInstance();
+    device.genTextures(1, &colorTexture);
+    device.bindTexture(GL_TEXTURE_2D, colorTexture);
+    device.texImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     
-    glGenTextures(1, &depthTexture);
-    glBindTexture(GL_TEXTURE_2D, depthTexture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    device.genTextures(1, &depthTexture);
+    device.bindTexture(GL_TEXTURE_2D, depthTexture);
+    device.texImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     
-    glBindTexture(GL_TEXTURE_2D, 0);
+    device.bindTexture(GL_TEXTURE_2D, 0);
 }
 
 void Framebuffer::attachTextures() {
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+    auto& device = RenderDevice::getInstance();
+    device.framebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
     
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+    device.framebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
 }
 
 } // namespace GameEngine
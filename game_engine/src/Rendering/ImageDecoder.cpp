@@ -0,0 +1,104 @@
+#include "Rendering/ImageDecoder.h"
+#include "Physics/ParallelFor.h"
+#include <cstdio>
+
+#ifndef LINUX_BUILD
+    #include <psp2/io/fcntl.h>  // Vita SDK file I/O
+#endif
+
+// stb_image keeps its failure reason thread local, so concurrent decodes are safe
+#include "../../vendor/tinygltf/stb_image.h"
+
+namespace GameEngine {
+
+namespace {
+
+// Images are large and few; one per task keeps every worker busy
+const int DECODE_GRAIN_SIZE = 1;
+
+struct DecodeBody : public btIParallelForBody {
+    const std::vector<std::string>* paths;
+    std::vector<DecodedImage>* images;
+    int desiredChannels;
+
+    DecodeBody(const std::vector<std::string>* p, std::vector<DecodedImage>* i, int channels)
+        : paths(p), images(i), desiredChannels(channels) {}
+
+    void forLoop(int iBegin, int iEnd) const BT_OVERRIDE {
+        for (int i = iBegin; i < iEnd; ++i) {
+            ImageDecoder::decode((*paths)[i], (*images)[i], desiredChannels);
+        }
+    }
+};
+
+} // namespace
+
+bool ImageDecoder::readFile(const std::string& path, std::vector<uint8_t>& data) {
+#ifdef LINUX_BUILD
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (fileSize <= 0) {
+        fclose(file);
+        return false;
+    }
+    data.resize(static_cast<size_t>(fileSize));
+    size_t bytesRead = fread(data.data(), 1, data.size(), file);
+    fclose(file);
+    return bytesRead == data.size();
+#else
+    SceUID fd = sceIoOpen(path.c_str(), SCE_O_RDONLY, 0);
+    if (fd < 0) return false;
+    SceOff fileSize = sceIoLseek(fd, 0, SCE_SEEK_END);
+    sceIoLseek(fd, 0, SCE_SEEK_SET);
+    if (fileSize <= 0) {
+        sceIoClose(fd);
+        return false;
+    }
+    data.resize(static_cast<size_t>(fileSize));
+    int bytesRead = sceIoRead(fd, data.data(), data.size());
+    sceIoClose(fd);
+    return bytesRead == static_cast<int>(data.size());
+#endif
+}
+
+bool ImageDecoder::decode(const std::string& path, DecodedImage& image, int desiredChannels) {
+    image = DecodedImage();
+    image.path = path;
+
+    std::vector<uint8_t> fileData;
+    if (!readFile(path, fileData)) {
+        image.error = "failed to read file";
+        return false;
+    }
+
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = stbi_load_from_memory(fileData.data(), static_cast<int>(fileData.size()),
+                                                  &width, &height, &channels, desiredChannels);
+    if (!pixels) {
+        const char* reason = stbi_failure_reason();
+        image.error = reason ? reason : "unknown stb_image error";
+        return false;
+    }
+
+    image.width = width;
+    image.height = height;
+    image.channels = desiredChannels ? desiredChannels : channels;
+    image.pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * image.channels);
+    stbi_image_free(pixels);
+    return true;
+}
+
+void ImageDecoder::decodeAll(const std::vector<std::string>& paths, std::vector<DecodedImage>& images,
+                             int desiredChannels) {
+    images.clear();
+    images.resize(paths.size());
+    if (paths.empty()) return;
+
+    DecodeBody body(&paths, &images, desiredChannels);
+    parallelForOrInline(0, static_cast<int>(paths.size()), DECODE_GRAIN_SIZE, body);
+}
+
+} // namespace GameEngine
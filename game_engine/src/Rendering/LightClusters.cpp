@@ -0,0 +1,355 @@
+#include "Rendering/LightClusters.h"
+#include "Physics/ParallelFor.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace GameEngine {
+
+// Clusters handed to one task; small enough to balance across worker threads
+static const int CLUSTER_GRAIN_SIZE = 64;
+
+struct ClusterCountBody : public btIParallelForBody {
+    LightClusterGrid* grid;
+    explicit ClusterCountBody(LightClusterGrid* g) : grid(g) {}
+
+    void forLoop(int iBegin, int iEnd) const BT_OVERRIDE {
+        for (int i = iBegin; i < iEnd; ++i) {
+            grid->clusters[i].count = grid->countClusterLights(static_cast<size_t>(i));
+        }
+    }
+};
+
+struct ClusterFillBody : public btIParallelForBody {
+    LightClusterGrid* grid;
+    explicit ClusterFillBody(LightClusterGrid* g) : grid(g) {}
+
+    void forLoop(int iBegin, int iEnd) const BT_OVERRIDE {
+        for (int i = iBegin; i < iEnd; ++i) {
+            grid->fillClusterLights(static_cast<size_t>(i));
+        }
+    }
+};
+
+LightClusterGrid::LightClusterGrid()
+    : tilesX(0)
+    , tilesY(0)
+    , slices(0)
+    , boundsProjection(1.0f)
+    , boundsNear(0.0f)
+    , boundsFar(0.0f)
+    , boundsValid(false)
+    , viewMatrix(1.0f)
+    , projectionMatrix(1.0f)
+    , nearPlane(0.1f)
+    , farPlane(100.0f)
+    , sliceScale(0.0f)
+    , gatherStamp(0)
+{
+    lastStats.buildMs = 0.0;
+    lastStats.assignments = 0;
+    lastStats.maxLightsPerCluster = 0;
+    setDimensions(DEFAULT_TILES_X, DEFAULT_TILES_Y, DEFAULT_SLICES);
+}
+
+void LightClusterGrid::setDimensions(int newTilesX, int newTilesY, int newSlices) {
+    newTilesX = std::max(1, newTilesX);
+    newTilesY = std::max(1, newTilesY);
+    newSlices = std::max(1, newSlices);
+    if (newTilesX == tilesX && newTilesY == tilesY && newSlices == slices) return;
+
+    tilesX = newTilesX;
+    tilesY = newTilesY;
+    slices = newSlices;
+
+    size_t count = static_cast<size_t>(tilesX) * tilesY * slices;
+    LightCluster empty;
+    empty.offset = 0;
+    empty.count = 0;
+    clusters.assign(count, empty);
+    boundsMin.assign(count, glm::vec3(0.0f));
+    boundsMax.assign(count, glm::vec3(0.0f));
+    sliceLights.assign(slices, std::vector<uint32_t>());
+    lightIndices.clear();
+    boundsValid = false;
+}
+
+bool LightClusterGrid::sphereIntersectsAABB(const glm::vec3& center, float radius,
+                                            const glm::vec3& boxMin, const glm::vec3& boxMax) {
+    glm::vec3 closest = glm::clamp(center, boxMin, boxMax);
+    glm::vec3 delta = center - closest;
+    return glm::dot(delta, delta) <= radius * radius;
+}
+
+int LightClusterGrid::depthToSlice(float depth) const {
+    if (depth <= nearPlane) return 0;
+    int slice = static_cast<int>(std::floor(std::log(depth / nearPlane) * sliceScale));
+    return std::min(std::max(slice, 0), slices - 1);
+}
+
+void LightClusterGrid::rebuildClusterBounds() {
+    glm::mat4 inverseProjection = glm::inverse(projectionMatrix);
+
+    // One view-space line per tile corner, through the near and far planes of
+    // the projection; works for perspective and orthographic cameras alike
+    const int cornersX = tilesX + 1;
+    const int cornersY = tilesY + 1;
+    std::vector<glm::vec3> lineNear(cornersX * cornersY);
+    std::vector<glm::vec3> lineFar(cornersX * cornersY);
+    for (int y = 0; y < cornersY; ++y) {
+        for (int x = 0; x < cornersX; ++x) {
+            float ndcX = -1.0f + 2.0f * x / tilesX;
+            float ndcY = -1.0f + 2.0f * y / tilesY;
+            glm::vec4 pointNear = inverseProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+            glm::vec4 pointFar = inverseProjection * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+            lineNear[y * cornersX + x] = glm::vec3(pointNear) / pointNear.w;
+            lineFar[y * cornersX + x] = glm::vec3(pointFar) / pointFar.w;
+        }
+    }
+
+    std::vector<float> sliceDepths(slices + 1);
+    for (int z = 0; z <= slices; ++z) {
+        sliceDepths[z] = nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(z) / slices);
+    }
+
+    for (int z = 0; z < slices; ++z) {
+        for (int y = 0; y < tilesY; ++y) {
+            for (int x = 0; x < tilesX; ++x) {
+                glm::vec3 clusterMin(std::numeric_limits<float>::max());
+                glm::vec3 clusterMax(-std::numeric_limits<float>::max());
+                for (int corner = 0; corner < 4; ++corner) {
+                    int cornerIndex = (y + (corner >> 1)) * cornersX + (x + (corner & 1));
+                    const glm::vec3& a = lineNear[cornerIndex];
+                    const glm::vec3& b = lineFar[cornerIndex];
+                    float span = b.z - a.z;
+                    for (int side = 0; side < 2; ++side) {
+                        float targetZ = -sliceDepths[z + side];
+                        float t = (std::fabs(span) > 1e-6f) ? (targetZ - a.z) / span : 0.0f;
+                        glm::vec3 point = a + (b - a) * t;
+                        clusterMin = glm::min(clusterMin, point);
+                        clusterMax = glm::max(clusterMax, point);
+                    }
+                }
+                size_t index = getClusterIndex(x, y, z);
+                boundsMin[index] = clusterMin;
+                boundsMax[index] = clusterMax;
+            }
+        }
+    }
+
+    boundsProjection = projectionMatrix;
+    boundsNear = nearPlane;
+    boundsFar = farPlane;
+    boundsValid = true;
+}
+
+void LightClusterGrid::getClusterBounds(size_t index, glm::vec3& outMin, glm::vec3& outMax) const {
+    outMin = boundsMin[index];
+    outMax = boundsMax[index];
+}
+
+void LightClusterGrid::build(const glm::mat4& view, const glm::mat4& projection,
+                             float newNearPlane, float newFarPlane,
+                             const std::vector<ClusterLight>& lights) {
+    auto begin = std::chrono::high_resolution_clock::now();
+
+    viewMatrix = view;
+    projectionMatrix = projection;
+    nearPlane = std::max(newNearPlane, 0.001f);
+    farPlane = std::max(newFarPlane, nearPlane * 1.01f);
+    sliceScale = slices / std::log(farPlane / nearPlane);
+
+    if (!boundsValid || boundsNear != nearPlane || boundsFar != farPlane || boundsProjection != projectionMatrix) {
+        rebuildClusterBounds();
+    }
+
+    viewLights.resize(lights.size());
+    globalLights.clear();
+    visibleLights.clear();
+    for (size_t z = 0; z < sliceLights.size(); ++z) {
+        sliceLights[z].clear();
+    }
+
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const ClusterLight& light = lights[i];
+        ViewLight& viewLight = viewLights[i];
+        viewLight.center = glm::vec3(viewMatrix * glm::vec4(light.position, 1.0f));
+        viewLight.radius = light.range;
+
+        uint32_t lightIndex = static_cast<uint32_t>(i);
+        if (light.directional || light.range <= 0.0f) {
+            globalLights.push_back(lightIndex);
+            continue;
+        }
+
+        float depthNear = -viewLight.center.z - light.range;
+        float depthFar = -viewLight.center.z + light.range;
+        if (depthFar < nearPlane || depthNear > farPlane) continue;
+
+        visibleLights.push_back(lightIndex);
+
+        // One slice of slack either side absorbs rounding in the log mapping;
+        // the exact sphere/box test happens per cluster
+        int minZ = std::max(depthToSlice(depthNear) - 1, 0);
+        int maxZ = std::min(depthToSlice(depthFar) + 1, slices - 1);
+        for (int z = minZ; z <= maxZ; ++z) {
+            sliceLights[z].push_back(lightIndex);
+        }
+    }
+
+    // Count, prefix-sum and fill keeps the output compact without per-cluster
+    // scratch storage or a cap on lights per cluster
+    int clusterCount = static_cast<int>(clusters.size());
+    ClusterCountBody countBody(this);
+    parallelForOrInline(0, clusterCount, CLUSTER_GRAIN_SIZE, countBody);
+
+    uint32_t total = 0;
+    uint32_t maxCount = 0;
+    for (size_t i = 0; i < clusters.size(); ++i) {
+        clusters[i].offset = total;
+        total += clusters[i].count;
+        maxCount = std::max(maxCount, clusters[i].count);
+    }
+    lightIndices.resize(total);
+
+    ClusterFillBody fillBody(this);
+    parallelForOrInline(0, clusterCount, CLUSTER_GRAIN_SIZE, fillBody);
+
+    lastStats.assignments = total;
+    lastStats.maxLightsPerCluster = maxCount;
+    lastStats.buildMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+}
+
+uint32_t LightClusterGrid::countClusterLights(size_t clusterIndex) const {
+    const std::vector<uint32_t>& candidates = sliceLights[clusterIndex / (static_cast<size_t>(tilesX) * tilesY)];
+    const glm::vec3& clusterMin = boundsMin[clusterIndex];
+    const glm::vec3& clusterMax = boundsMax[clusterIndex];
+
+    uint32_t count = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const ViewLight& light = viewLights[candidates[i]];
+        if (sphereIntersectsAABB(light.center, light.radius, clusterMin, clusterMax)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void LightClusterGrid::fillClusterLights(size_t clusterIndex) {
+    const std::vector<uint32_t>& candidates = sliceLights[clusterIndex / (static_cast<size_t>(tilesX) * tilesY)];
+    const glm::vec3& clusterMin = boundsMin[clusterIndex];
+    const glm::vec3& clusterMax = boundsMax[clusterIndex];
+
+    uint32_t expected = clusters[clusterIndex].count;
+    if (expected == 0) return;
+
+    uint32_t* out = &lightIndices[clusters[clusterIndex].offset];
+    uint32_t written = 0;
+    for (size_t i = 0; i < candidates.size() && written < expected; ++i) {
+        const ViewLight& light = viewLights[candidates[i]];
+        if (sphereIntersectsAABB(light.center, light.radius, clusterMin, clusterMax)) {
+            out[written++] = candidates[i];
+        }
+    }
+}
+
+bool LightClusterGrid::computeRange(const glm::vec3& viewMin, const glm::vec3& viewMax, ClusterRange& out) const {
+    float depthNear = -viewMax.z;
+    float depthFar = -viewMin.z;
+    if (depthFar < nearPlane || depthNear > farPlane) return false;
+
+    out.minZ = depthToSlice(depthNear);
+    out.maxZ = depthToSlice(depthFar);
+    out.minX = 0;
+    out.maxX = tilesX - 1;
+    out.minY = 0;
+    out.maxY = tilesY - 1;
+
+    // A box crossing the camera plane has no meaningful screen rectangle
+    if (depthNear <= nearPlane) return true;
+
+    glm::vec2 ndcMin(std::numeric_limits<float>::max());
+    glm::vec2 ndcMax(-std::numeric_limits<float>::max());
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 point((corner & 1) ? viewMax.x : viewMin.x,
+                        (corner & 2) ? viewMax.y : viewMin.y,
+                        (corner & 4) ? viewMax.z : viewMin.z);
+        glm::vec4 clip = projectionMatrix * glm::vec4(point, 1.0f);
+        if (clip.w <= 1e-6f) return true;
+        glm::vec2 ndc = glm::vec2(clip) / clip.w;
+        ndcMin = glm::min(ndcMin, ndc);
+        ndcMax = glm::max(ndcMax, ndc);
+    }
+
+    if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f) return false;
+
+    out.minX = std::max(static_cast<int>(std::floor((ndcMin.x * 0.5f + 0.5f) * tilesX)), 0);
+    out.maxX = std::min(static_cast<int>(std::floor((ndcMax.x * 0.5f + 0.5f) * tilesX)), tilesX - 1);
+    out.minY = std::max(static_cast<int>(std::floor((ndcMin.y * 0.5f + 0.5f) * tilesY)), 0);
+    out.maxY = std::min(static_cast<int>(std::floor((ndcMax.y * 0.5f + 0.5f) * tilesY)), tilesY - 1);
+    return true;
+}
+
+void LightClusterGrid::gatherLights(const glm::vec3& localMin, const glm::vec3& localMax,
+                                    const glm::mat4& modelMatrix, std::vector<uint32_t>& out) const {
+    if (visibleLights.empty()) return;
+
+    glm::mat4 modelView = viewMatrix * modelMatrix;
+    glm::vec3 viewMin(std::numeric_limits<float>::max());
+    glm::vec3 viewMax(-std::numeric_limits<float>::max());
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 point((corner & 1) ? localMax.x : localMin.x,
+                        (corner & 2) ? localMax.y : localMin.y,
+                        (corner & 4) ? localMax.z : localMin.z);
+        glm::vec3 viewPoint = glm::vec3(modelView * glm::vec4(point, 1.0f));
+        viewMin = glm::min(viewMin, viewPoint);
+        viewMax = glm::max(viewMax, viewPoint);
+    }
+
+    ClusterRange range;
+    if (!computeRange(viewMin, viewMax, range)) return;
+
+    size_t rangeClusters = static_cast<size_t>(range.maxX - range.minX + 1) *
+                           (range.maxY - range.minY + 1) * (range.maxZ - range.minZ + 1);
+
+    // Large objects cover more clusters than there are lights; testing the
+    // lights against the box directly is cheaper and just as conservative
+    if (rangeClusters > visibleLights.size()) {
+        for (size_t i = 0; i < visibleLights.size(); ++i) {
+            const ViewLight& light = viewLights[visibleLights[i]];
+            if (sphereIntersectsAABB(light.center, light.radius, viewMin, viewMax)) {
+                out.push_back(visibleLights[i]);
+            }
+        }
+        return;
+    }
+
+    if (gatherStamps.size() < viewLights.size()) {
+        gatherStamps.resize(viewLights.size(), 0);
+    }
+    if (++gatherStamp == 0) {
+        std::fill(gatherStamps.begin(), gatherStamps.end(), 0);
+        gatherStamp = 1;
+    }
+
+    for (int z = range.minZ; z <= range.maxZ; ++z) {
+        for (int y = range.minY; y <= range.maxY; ++y) {
+            for (int x = range.minX; x <= range.maxX; ++x) {
+                const LightCluster& cluster = clusters[getClusterIndex(x, y, z)];
+                for (uint32_t i = 0; i < cluster.count; ++i) {
+                    uint32_t lightIndex = lightIndices[cluster.offset + i];
+                    if (gatherStamps[lightIndex] == gatherStamp) continue;
+                    gatherStamps[lightIndex] = gatherStamp;
+
+                    const ViewLight& light = viewLights[lightIndex];
+                    if (sphereIntersectsAABB(light.center, light.radius, viewMin, viewMax)) {
+                        out.push_back(lightIndex);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace GameEngine
@@ -8,9 +8,20 @@ LightingManager& LightingManager::getInstance() {
     return instance;
 }
 
+LightingManager::LightingManager()
+    : lightsCaptured(false)
+    , clustersBuilt(false)
+    , selectedCount(0)
+    , hasSelection(false)
+    , defaultSelectionDirty(true)
+{
+    selectedLightData.reserve(MAX_LIGHTS);
+}
+
 void LightingManager::addLight(LightComponent* light) {
     if (light && std::find(lights.begin(), lights.end(), light) == lights.end()) {
         lights.push_back(light);
+        defaultSelectionDirty = true;
     }
 }
 
@@ -18,35 +29,149 @@ void LightingManager::removeLight(LightComponent* light) {
     auto it = std::find(lights.begin(), lights.end(), light);
     if (it != lights.end()) {
         lights.erase(it);
+        defaultSelectionDirty = true;
     }
 }
 
 void LightingManager::clearLights() {
     lights.clear();
+    frameLightData.clear();
+    frameClusterLights.clear();
+    lightsCaptured = false;
+    clustersBuilt = false;
+    hasSelection = false;
+    defaultSelectionDirty = true;
+}
+
+const std::vector<LightComponent::LightData>& LightingManager::getLightDataArray() {
+    if (!hasSelection) {
+        buildDefaultSelection();
+    }
+    return selectedLightData;
 }
 
-std::vector<LightComponent::LightData> LightingManager::getLightDataArray() const {
-    std::vector<LightComponent::LightData> lightDataArray;
-    lightDataArray.reserve(MAX_LIGHTS);
-    
-    size_t count = std::min(lights.size(), MAX_LIGHTS);
-    for (size_t i = 0; i < count; ++i) {
-        if (lights[i] && lights[i]->isEnabled()) {
-            lightDataArray.push_back(lights[i]->getLightData());
+size_t LightingManager::getActiveLightCount() {
+    if (!hasSelection) {
+        buildDefaultSelection();
+    }
+    return selectedCount;
+}
+
+void LightingManager::padSelection() {
+    selectedCount = selectedLightData.size();
+
+    LightComponent::LightData emptyLight;
+    emptyLight.position = glm::vec4(0.0f);
+    emptyLight.direction = glm::vec4(0.0f);
+    emptyLight.color = glm::vec4(0.0f);
+    emptyLight.params = glm::vec4(0.0f);
+    emptyLight.attenuation = glm::vec4(0.0f);
+    while (selectedLightData.size() < MAX_LIGHTS) {
+        selectedLightData.push_back(emptyLight);
+    }
+}
+
+// Draws issued outside a cluster pass (e.g. without an active camera) see
+// the first MAX_LIGHTS enabled lights, as before clustering existed
+void LightingManager::buildDefaultSelection() {
+    if (!defaultSelectionDirty) return;
+
+    selectedLightData.clear();
+    if (lightsCaptured) {
+        for (size_t i = 0; i < frameLightData.size() && selectedLightData.size() < MAX_LIGHTS; ++i) {
+            selectedLightData.push_back(frameLightData[i]);
+        }
+    } else {
+        for (size_t i = 0; i < lights.size() && selectedLightData.size() < MAX_LIGHTS; ++i) {
+            if (lights[i] && lights[i]->isEnabled()) {
+                selectedLightData.push_back(lights[i]->getLightData());
+            }
         }
     }
-    
-    while (lightDataArray.size() < MAX_LIGHTS) {
-        LightComponent::LightData emptyLight;
-        emptyLight.position = glm::vec4(0.0f);
-        emptyLight.direction = glm::vec4(0.0f);
-        emptyLight.color = glm::vec4(0.0f);
-        emptyLight.params = glm::vec4(0.0f);
-        emptyLight.attenuation = glm::vec4(0.0f);
-        lightDataArray.push_back(emptyLight);
+    padSelection();
+    defaultSelectionDirty = false;
+}
+
+void LightingManager::clearSelection() {
+    if (hasSelection) {
+        hasSelection = false;
+        defaultSelectionDirty = true;
+    }
+}
+
+void LightingManager::captureLights() {
+    frameLightData.clear();
+    frameClusterLights.clear();
+
+    for (size_t i = 0; i < lights.size(); ++i) {
+        LightComponent* light = lights[i];
+        if (!light || !light->isEnabled()) continue;
+
+        LightComponent::LightData data = light->getLightData();
+        frameLightData.push_back(data);
+        frameClusterLights.push_back(ClusterLight(glm::vec3(data.position), data.color.w,
+                                                  light->getType() == LightType::DIRECTIONAL));
+    }
+    lightsCaptured = true;
+    defaultSelectionDirty = true;
+}
+
+void LightingManager::buildClusters(const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane) {
+    if (!lightsCaptured) {
+        captureLights();
+    }
+
+    clusterGrid.build(view, projection, nearPlane, farPlane, frameClusterLights);
+    clustersBuilt = true;
+    clearSelection();
+}
+
+void LightingManager::selectLightsForBounds(const glm::vec3& localMin, const glm::vec3& localMax, const glm::mat4& modelMatrix) {
+    if (!clustersBuilt) {
+        clearSelection();
+        return;
+    }
+
+    selectedLightData.clear();
+    hasSelection = true;
+
+    const std::vector<uint32_t>& globalLights = clusterGrid.getGlobalLights();
+    for (size_t i = 0; i < globalLights.size() && selectedLightData.size() < MAX_LIGHTS; ++i) {
+        selectedLightData.push_back(frameLightData[globalLights[i]]);
+    }
+
+    candidateLights.clear();
+    bool boundsValid = (localMin.x <= localMax.x && localMin.y <= localMax.y && localMin.z <= localMax.z);
+    if (boundsValid) {
+        clusterGrid.gatherLights(localMin, localMax, modelMatrix, candidateLights);
+    } else {
+        // No usable bounds: treat the object as a point at its origin
+        glm::vec3 origin(0.0f);
+        clusterGrid.gatherLights(origin, origin, modelMatrix, candidateLights);
+    }
+
+    size_t slots = MAX_LIGHTS - selectedLightData.size();
+    if (candidateLights.size() > slots) {
+        // Rank by distance to the object's center relative to each light's
+        // range, so lights that barely reach it are dropped first
+        glm::vec3 center = boundsValid ? (localMin + localMax) * 0.5f : glm::vec3(0.0f);
+        glm::vec3 worldCenter = glm::vec3(modelMatrix * glm::vec4(center, 1.0f));
+        const std::vector<LightComponent::LightData>& data = frameLightData;
+        std::partial_sort(candidateLights.begin(), candidateLights.begin() + slots, candidateLights.end(),
+            [&data, &worldCenter](uint32_t a, uint32_t b) {
+                glm::vec3 toA = glm::vec3(data[a].position) - worldCenter;
+                glm::vec3 toB = glm::vec3(data[b].position) - worldCenter;
+                float rangeA = std::max(data[a].color.w, 0.001f);
+                float rangeB = std::max(data[b].color.w, 0.001f);
+                return glm::dot(toA, toA) / (rangeA * rangeA) < glm::dot(toB, toB) / (rangeB * rangeB);
+            });
+        candidateLights.resize(slots);
+    }
+
+    for (size_t i = 0; i < candidateLights.size(); ++i) {
+        selectedLightData.push_back(frameLightData[candidateLights[i]]);
     }
-    
-    return lightDataArray;
+    padSelection();
 }
 
 void LightingManager::update() {
@@ -57,6 +182,11 @@ void LightingManager::update() {
             }),
         lights.end()
     );
+    // Cluster data belongs to the frame it was built for
+    lightsCaptured = false;
+    clustersBuilt = false;
+    hasSelection = false;
+    defaultSelectionDirty = true;
 }
 
 } // namespace GameEngine
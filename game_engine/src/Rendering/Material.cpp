@@ -11,15 +11,12 @@
 
 namespace GameEngine {
 
+std::atomic<uint32_t> Material::nextSortId(0);
+
 Material::Material()
-    : shader(nullptr)
-    , color(1.0f, 1.0f, 1.0f)
+    : sortId(nextSortId++)
     , metallic(0.0f)
     , roughness(0.5f)
-    , reflectionStrength(0.0f)
-    , diffuseTexture(nullptr)
-    , normalTexture(nullptr)
-    , armTexture(nullptr)
     , diffuseTexturePath("")
     , normalTexturePath("")
     , armTexturePath("")
@@ -27,65 +24,67 @@ Material::Material()
 }
 
 Material::Material(std::shared_ptr<Shader> materialShader)
-    : shader(materialShader)
-    , color(1.0f, 1.0f, 1.0f)
+    : sortId(nextSortId++)
     , metallic(0.0f)
     , roughness(0.5f)
-    , reflectionStrength(0.0f)
-    , diffuseTexture(nullptr)
-    , normalTexture(nullptr)
-    , armTexture(nullptr)
     , diffuseTexturePath("")
     , normalTexturePath("")
     , armTexturePath("")
 {
+    uniforms.shader = materialShader;
 }
 
 Material::~Material() {
 }
 
+std::shared_ptr<Material> Material::clone() const {
+    auto copy = std::make_shared<Material>(*this);
+    copy->sortId = nextSortId++;
+    return copy;
+}
+
 void Material::setShader(std::shared_ptr<Shader> materialShader) {
-    shader = materialShader;
+    uniforms.shader = materialShader;
 }
 
 void Material::setFloat(const std::string& name, float value) {
-    floatProperties[name] = value;
+    uniforms.floatProperties[name] = value;
 }
 
 void Material::setInt(const std::string& name, int value) {
-    intProperties[name] = value;
+    uniforms.intProperties[name] = value;
 }
 
 void Material::setBool(const std::string& name, bool value) {
-    boolProperties[name] = value;
+    uniforms.boolProperties[name] = value;
 }
 
 void Material::setVec2(const std::string& name, const glm::vec2& value) {
-    vec2Properties[name] = value;
+    uniforms.vec2Properties[name] = value;
 }
 
 void Material::setVec3(const std::string& name, const glm::vec3& value) {
-    vec3Properties[name] = value;
+    uniforms.vec3Properties[name] = value;
 }
 
 void Material::setVec4(const std::string& name, const glm::vec4& value) {
-    vec4Properties[name] = value;
+    uniforms.vec4Properties[name] = value;
 }
 
 void Material::setMat3(const std::string& name, const glm::mat3& value) {
-    mat3Properties[name] = value;
+    uniforms.mat3Properties[name] = value;
 }
 
 void Material::setMat4(const std::string& name, const glm::mat4& value) {
-    mat4Properties[name] = value;
+    uniforms.mat4Properties[name] = value;
 }
 
 void Material::setTexture(const std::string& name, std::shared_ptr<Texture> texture) {
-    textureProperties[name] = texture;
+    uniforms.textureProperties[name] = texture;
 }
 
 void Material::setDiffuseTexture(std::shared_ptr<Texture> texture, const std::string& path) {
-    diffuseTexture = texture;
+    uniforms.diffuseTexture = texture;
     if (!path.empty()) {
         diffuseTexturePath = path;
     }
@@ -94,7 +93,7 @@ void Material::setDiffuseTexture(std::shared_ptr<Texture> texture, const std::st
 }
 
 void Material::setNormalTexture(std::shared_ptr<Texture> texture, const std::string& path) {
-    normalTexture = texture;
+    uniforms.normalTexture = texture;
     if (!path.empty()) {
         normalTexturePath = path;
     }
@@ -103,7 +102,7 @@ void Material::setNormalTexture(std::shared_ptr<Texture> texture, const std::str
 }
 
 void Material::setARMTexture(std::shared_ptr<Texture> texture, const std::string& path) {
-    armTexture = texture;
+    uniforms.armTexture = texture;
     if (!path.empty()) {
         armTexturePath = path;
     }
@@ -112,34 +111,39 @@ void Material::setARMTexture(std::shared_ptr<Texture> texture, const std::string
 }
 
 void Material::setCameraPosition(const glm::vec3& cameraPos) {
-    vec3Properties["u_CameraPos"] = cameraPos;
+    uniforms.vec3Properties["u_CameraPos"] = cameraPos;
 }
 
 void Material::apply() const {
     // Only fall back to the default lighting shader if this material
     // doesn't already have an explicit shader (e.g. skybox materials).
-    if (!shader) {
-        const_cast<Material*>(this)->shader = Shader::getLightingShader();
+    if (!uniforms.shader) {
+        const_cast<Material*>(this)->uniforms.shader = Shader::getLightingShader();
     }
     
+    applyUniforms(uniforms);
+}
+
+void Material::applyUniforms(const MaterialUniforms& uniforms) {
+    const auto& shader = uniforms.shader;
     if (!shader || !shader->isValid()) {
         return;
     }
     
     shader->use();
-    applyProperties();
+    applyProperties(uniforms);
     // Only lighting shader needs light uniforms; other shaders (like skybox)
     // should not get lighting uniforms pushed.
     if (shader == Shader::getLightingShader()) {
-        setupLightingUniforms();
+        setupLightingUniforms(uniforms);
     }
 }
 
 void Material::drawInspector() {
 #ifdef EDITOR_BUILD
     if (ImGui::CollapsingHeader("Material", ImGuiTreeNodeFlags_DefaultOpen)) {
-        if (ImGui::ColorEdit3("Color", &color.x)) {
-            setColor(color);
+        if (ImGui::ColorEdit3("Color", &uniforms.color.x)) {
+            setColor(uniforms.color);
         }
         
         if (ImGui::SliderFloat("Metallic", &metallic, 0.0f, 1.0f)) {
@@ -150,15 +154,15 @@ void Material::drawInspector() {
             setFloat("u_Roughness", roughness);
         }
         
-        if (ImGui::SliderFloat("Reflection Strength", &reflectionStrength, 0.0f, 1.0f)) {
-            setReflectionStrength(reflectionStrength);
+        if (ImGui::SliderFloat("Reflection Strength", &uniforms.reflectionStrength, 0.0f, 1.0f)) {
+            setReflectionStrength(uniforms.reflectionStrength);
         }
         
         ImGui::Separator();
         ImGui::Text("Textures");
         
-        if (ImGui::BeginCombo("Diffuse Texture", diffuseTexture ? "Loaded" : "None")) {
-            if (ImGui::Selectable("None", !diffuseTexture)) {
+        if (ImGui::BeginCombo("Diffuse Texture", uniforms.diffuseTexture ? "Loaded" : "None")) {
+            if (ImGui::Selectable("None", !uniforms.diffuseTexture)) {
                 setDiffuseTexture(nullptr);
             }
             
@@ -168,7 +172,7 @@ void Material::drawInspector() {
             for (const auto& texturePath : availableTextures) {
                 if (texturePath.find("_diff") != std::string::npos || 
                     texturePath.find("diffuse") != std::string::npos) {
-                    if (ImGui::Selectable(texturePath.c_str(), diffuseTexture && 
+                    if (ImGui::Selectable(texturePath.c_str(), uniforms.diffuseTexture && 
                         texturePath == "u_DiffuseTexture")) {
                         auto texture = textureManager.getTexture(texturePath);
                         setDiffuseTexture(texture, texturePath);
@@ -178,8 +182,8 @@ void Material::drawInspector() {
             ImGui::EndCombo();
         }
         
-        if (ImGui::BeginCombo("Normal Texture", normalTexture ? "Loaded" : "None")) {
-            if (ImGui::Selectable("None", !normalTexture)) {
+        if (ImGui::BeginCombo("Normal Texture", uniforms.normalTexture ? "Loaded" : "None")) {
+            if (ImGui::Selectable("None", !uniforms.normalTexture)) {
                 setNormalTexture(nullptr);
             }
             
@@ -189,7 +193,7 @@ void Material::drawInspector() {
             for (const auto& texturePath : availableTextures) {
                 if (texturePath.find("_nor") != std::string::npos || 
                     texturePath.find("normal") != std::string::npos) {
-                    if (ImGui::Selectable(texturePath.c_str(), normalTexture && 
+                    if (ImGui::Selectable(texturePath.c_str(), uniforms.normalTexture && 
                         texturePath == "u_NormalTexture")) {
                         auto texture = textureManager.getTexture(texturePath);
                         setNormalTexture(texture, texturePath);
@@ -199,8 +203,8 @@ void Material::drawInspector() {
             ImGui::EndCombo();
         }
         
-        if (ImGui::BeginCombo("ARM Texture", armTexture ? "Loaded" : "None")) {
-            if (ImGui::Selectable("None", !armTexture)) {
+        if (ImGui::BeginCombo("ARM Texture", uniforms.armTexture ? "Loaded" : "None")) {
+            if (ImGui::Selectable("None", !uniforms.armTexture)) {
                 setARMTexture(nullptr);
             }
             
@@ -210,7 +214,7 @@ void Material::drawInspector() {
             for (const auto& texturePath : availableTextures) {
                 if (texturePath.find("_arm") != std::string::npos || 
                     texturePath.find("arm") != std::string::npos) {
-                    if (ImGui::Selectable(texturePath.c_str(), armTexture && 
+                    if (ImGui::Selectable(texturePath.c_str(), uniforms.armTexture && 
                         texturePath == "u_ARMTexture")) {
                         auto texture = textureManager.getTexture(texturePath);
                         setARMTexture(texture, texturePath);
@@ -221,10 +225,10 @@ void Material::drawInspector() {
         }
         
         ImGui::Separator();
-        ImGui::Text("Shader: %s", shader ? "Loaded" : "None");
+        ImGui::Text("Shader: %s", uniforms.shader ? "Loaded" : "None");
         
-        if (!textureProperties.empty()) {
-            ImGui::Text("Texture Properties: %zu", textureProperties.size());
+        if (!uniforms.textureProperties.empty()) {
+            ImGui::Text("Texture Properties: %zu", uniforms.textureProperties.size());
         }
     }
 #endif
@@ -253,55 +257,56 @@ std::shared_ptr<Material> Material::getErrorMaterial() {
     return errorMaterial;
 }
 
-void Material::applyProperties() const {
+void Material::applyProperties(const MaterialUniforms& uniforms) {
+    const auto& shader = uniforms.shader;
     if (!shader) return;
     
-    shader->setVec3("u_DiffuseColor", color);
-    shader->setFloat("u_ReflectionStrength", reflectionStrength);
+    shader->setVec3("u_DiffuseColor", uniforms.color);
+    shader->setFloat("u_ReflectionStrength", uniforms.reflectionStrength);
     
     bool hasEnvMap = false;
-    auto envIt = textureProperties.find("u_EnvironmentMap");
-    if (envIt != textureProperties.end() && envIt->second && envIt->second->isCubemap()) {
+    auto envIt = uniforms.textureProperties.find("u_EnvironmentMap");
+    if (envIt != uniforms.textureProperties.end() && envIt->second && envIt->second->isCubemap()) {
         hasEnvMap = true;
     }
     shader->setBool("u_HasEnvironmentMap", hasEnvMap);
     
-    for (const auto& prop : floatProperties) {
+    for (const auto& prop : uniforms.floatProperties) {
         shader->setFloat(prop.first, prop.second);
     }
     
-    for (const auto& prop : intProperties) {
+    for (const auto& prop : uniforms.intProperties) {
         shader->setInt(prop.first, prop.second);
     }
     
-    for (const auto& prop : boolProperties) {
+    for (const auto& prop : uniforms.boolProperties) {
         shader->setBool(prop.first, prop.second);
     }
     
-    for (const auto& prop : vec2Properties) {
+    for (const auto& prop : uniforms.vec2Properties) {
         shader->setVec2(prop.first, prop.second);
     }
     
-    for (const auto& prop : vec3Properties) {
+    for (const auto& prop : uniforms.vec3Properties) {
         shader->setVec3(prop.first, prop.second);
     }
     
-    for (const auto& prop : vec4Properties) {
+    for (const auto& prop : uniforms.vec4Properties) {
         shader->setVec4(prop.first, prop.second);
     }
     
-    for (const auto& prop : mat3Properties) {
+    for (const auto& prop : uniforms.mat3Properties) {
         shader->setMat3(prop.first, prop.second);
     }
     
-    for (const auto& prop : mat4Properties) {
+    for (const auto& prop : uniforms.mat4Properties) {
         shader->setMat4(prop.first, prop.second);
     }
     
     int textureUnit = 0;
     
-    if (diffuseTexture) {
-        diffuseTexture->bind(textureUnit);
+    if (uniforms.diffuseTexture) {
+        uniforms.diffuseTexture->bind(textureUnit);
         shader->setInt("u_DiffuseTexture", textureUnit);
         shader->setBool("u_HasDiffuseTexture", true);
         textureUnit++;
@@ -309,8 +314,8 @@ void Material::applyProperties() const {
         shader->setBool("u_HasDiffuseTexture", false);
     }
     
-    if (normalTexture) {
-        normalTexture->bind(textureUnit);
+    if (uniforms.normalTexture) {
+        uniforms.normalTexture->bind(textureUnit);
         shader->setInt("u_NormalTexture", textureUnit);
         shader->setBool("u_HasNormalTexture", true);
         textureUnit++;
@@ -318,8 +323,8 @@ void Material::applyProperties() const {
         shader->setBool("u_HasNormalTexture", false);
     }
     
-    if (armTexture) {
-        armTexture->bind(textureUnit);
+    if (uniforms.armTexture) {
+        uniforms.armTexture->bind(textureUnit);
         shader->setInt("u_ARMTexture", textureUnit);
         shader->setBool("u_HasARMTexture", true);
         textureUnit++;
@@ -327,7 +332,7 @@ void Material::applyProperties() const {
         shader->setBool("u_HasARMTexture", false);
     }
     
-    for (const auto& prop : textureProperties) {
+    for (const auto& prop : uniforms.textureProperties) {
         if (prop.second) {
             if ((prop.first == "skybox" || prop.first == "u_EnvironmentMap") && prop.second->isCubemap()) {
                 prop.second->bindCubemap(textureUnit);
@@ -340,19 +345,22 @@ void Material::applyProperties() const {
     }
 }
 
-void Material::setupLightingUniforms() const {
+void Material::setupLightingUniforms(const MaterialUniforms& uniforms) {
+    const auto& shader = uniforms.shader;
     if (!shader) return;
     
-    if (floatProperties.find("Kd") == floatProperties.end()) {
+    if (uniforms.floatProperties.find("Kd") == uniforms.floatProperties.end()) {
         shader->setFloat("Kd", 1.0f);
     }
     
     auto& lightingManager = LightingManager::getInstance();
-    auto lightDataArray = lightingManager.getLightDataArray();
+    const auto& lightDataArray = lightingManager.getLightDataArray();
+    size_t numLights = lightingManager.getActiveLightCount();
     
-    shader->setInt("u_NumLights", static_cast<int>(lightingManager.getActiveLightCount()));
+    shader->setInt("u_NumLights", static_cast<int>(numLights));
     
-    for (size_t i = 0; i < lightDataArray.size(); ++i) {
+    // Shaders stop at u_NumLights, so only the selected lights are uploaded
+    for (size_t i = 0; i < numLights; ++i) {
         const auto& lightData = lightDataArray[i];
         std::string lightIndex = "u_Lights[" + std::to_string(i) + "]";
         
@@ -363,8 +371,8 @@ void Material::setupLightingUniforms() const {
         shader->setVec4(lightIndex + ".attenuation", lightData.attenuation);
     }
     
-    auto cameraPosIt = vec3Properties.find("u_CameraPos");
-    if (cameraPosIt != vec3Properties.end()) {
+    auto cameraPosIt = uniforms.vec3Properties.find("u_CameraPos");
+    if (cameraPosIt != uniforms.vec3Properties.end()) {
         shader->setVec3("u_CameraPos", cameraPosIt->second);
     } else {
         shader->setVec3("u_CameraPos", glm::vec3(0.0f, 0.0f, 5.0f));
@@ -1,11 +1,23 @@
 #include "Rendering/Mesh.h"
 #include "Rendering/Material.h"
+#include "Rendering/MeshSimplifier.h"
+#include "Rendering/RenderDevice.h"
 #include <iostream>
 #include <limits>
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace GameEngine {
 
+static bool compactVertexFormatsEnabled = true;
+
+void Mesh::setCompactVertexFormats(bool enabled) {
+    compactVertexFormatsEnabled = enabled;
+}
+
+bool Mesh::getCompactVertexFormats() {
+    return compactVertexFormatsEnabled;
+}
+
 Mesh::Mesh()
     : VAO(0), VBO(0), EBO(0), uploaded(false)
     , cpuDataCleared(false)
@@ -15,6 +27,10 @@ Mesh::Mesh()
     , boundsMax(std::numeric_limits<float>::lowest())
     , meshType(MeshType::UNKNOWN)
     , renderMode(GL_TRIANGLES)
+    , indexType(GL_UNSIGNED_INT)
+    , vertexFormat(VertexFormat::AUTO)
+    , constantBoneWeights(0.0f)
+    , constantBoneIndices(0.0f)
 {
 }
 
@@ -28,6 +44,10 @@ Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>&
     , boundsMax(std::numeric_limits<float>::lowest())
     , meshType(MeshType::UNKNOWN)
     , renderMode(GL_TRIANGLES)
+    , indexType(GL_UNSIGNED_INT)
+    , vertexFormat(VertexFormat::AUTO)
+    , constantBoneWeights(0.0f)
+    , constantBoneIndices(0.0f)
 {
     calculateBounds();
 }
@@ -47,6 +67,62 @@ void Mesh::setIndices(const std::vector<unsigned int>& newIndices) {
     uploaded = false;
 }
 
+void Mesh::setVertexFormat(VertexFormat format) {
+    if (vertexFormat != format) {
+        vertexFormat = format;
+        // Without CPU data the existing buffers are kept as they are
+        if (!cpuDataCleared) {
+            uploaded = false;
+        }
+    }
+}
+
+MeshOptimizer::Stats Mesh::optimize(const MeshOptimizer::Options& options) {
+    if (cpuDataCleared || renderMode != GL_TRIANGLES) {
+        MeshOptimizer::Stats stats = MeshOptimizer::Stats();
+        stats.verticesBefore = stats.verticesAfter = getVertexCount();
+        stats.triangles = getTriangleCount();
+        return stats;
+    }
+
+    MeshOptimizer::Stats stats = MeshOptimizer::optimize(vertices, indices, options);
+    calculateBounds();
+    uploaded = false;
+    return stats;
+}
+
+std::shared_ptr<Mesh> Mesh::createSimplified(float triangleRatio, float maxError, float* resultError) const {
+    if (cpuDataCleared || renderMode != GL_TRIANGLES || vertices.empty()) {
+        return nullptr;
+    }
+
+    std::vector<unsigned int> sourceIndices = indices;
+    if (sourceIndices.empty()) {
+        if (vertices.size() % 3 != 0) return nullptr;
+        sourceIndices.resize(vertices.size());
+        for (size_t i = 0; i < sourceIndices.size(); ++i) {
+            sourceIndices[i] = static_cast<unsigned int>(i);
+        }
+    }
+
+    size_t targetIndexCount = static_cast<size_t>(sourceIndices.size() / 3 * triangleRatio) * 3;
+    std::vector<unsigned int> simplifiedIndices;
+    float error = MeshSimplifier::simplify(vertices, sourceIndices, targetIndexCount, maxError, simplifiedIndices);
+    if (simplifiedIndices.empty() || simplifiedIndices.size() >= sourceIndices.size()) {
+        return nullptr;
+    }
+
+    // Vertex fetch optimization drops the vertices no longer referenced
+    auto lod = std::make_shared<Mesh>(vertices, simplifiedIndices);
+    lod->optimize();
+    lod->setMeshType(meshType);
+    lod->setVertexFormat(vertexFormat);
+    if (resultError) {
+        *resultError = error;
+    }
+    return lod;
+}
+
 void Mesh::upload() {
     if (uploaded) {
         cleanupBuffers();
@@ -71,18 +147,27 @@ void Mesh::uploadAndClearCPUData() {
 }
 
 void Mesh::bind() const {
+    auto& device = RenderDevice::getInstance();
     if (!uploaded) {
         const_cast<Mesh*>(this)->upload();
     }
     
-    glBindVertexArray(VAO);
+    device.bindVertexArray(VAO);
+
+    // Constant attributes are context state, not part of the VAO
+    if (!vertexLayout.getAttribute(ATTRIB_BONE_WEIGHTS).enabled) {
+        device.vertexAttrib4fv(ATTRIB_BONE_WEIGHTS, &constantBoneWeights[0]);
+        device.vertexAttrib4fv(ATTRIB_BONE_INDICES, &constantBoneIndices[0]);
+    }
 }
 
 void Mesh::unbind() const {
-    glBindVertexArray(0);
+    auto& device = RenderDevice::getInstance();
+    device.bindVertexArray(0);
 }
 
 void Mesh::draw() const {
+    auto& device = RenderDevice::getInstance();
     if (!uploaded) {
         const_cast<Mesh*>(this)->upload();
     }
@@ -93,15 +178,16 @@ void Mesh::draw() const {
     size_t vertexCount = cpuDataCleared ? cachedVertexCount : vertices.size();
     
     if (indexCount > 0) {
-        glDrawElements(renderMode, indexCount, GL_UNSIGNED_INT, 0);
+        device.drawElements(renderMode, indexCount, indexType, 0);
     } else {
-        glDrawArrays(renderMode, 0, vertexCount);
+        device.drawArrays(renderMode, 0, vertexCount);
     }
     
     unbind();
 }
 
 void Mesh::draw(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) const {
+    auto& device = RenderDevice::getInstance();
     // Both Linux and Vita builds now use the lighting shader system
     // The material.apply() should have already set up the lighting shader
     
@@ -116,15 +202,16 @@ void Mesh::draw(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix, const
     size_t vertexCount = cpuDataCleared ? cachedVertexCount : vertices.size();
     
     if (indexCount > 0) {
-        glDrawElements(renderMode, indexCount, GL_UNSIGNED_INT, 0);
+        device.drawElements(renderMode, indexCount, indexType, 0);
     } else {
-        glDrawArrays(renderMode, 0, vertexCount);
+        device.drawArrays(renderMode, 0, vertexCount);
     }
     
     unbind();
 }
 
 void Mesh::draw(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const Material& material) const {
+    auto& device = RenderDevice::getInstance();
     if (!uploaded) {
         const_cast<Mesh*>(this)->upload();
     }
@@ -135,9 +222,9 @@ void Mesh::draw(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix, const
     size_t vertexCount = cpuDataCleared ? cachedVertexCount : vertices.size();
     
     if (indexCount > 0) {
-        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+        device.drawElements(GL_TRIANGLES, indexCount, indexType, 0);
     } else {
-        glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+        device.drawArrays(GL_TRIANGLES, 0, vertexCount);
     }
     
     unbind();
@@ -157,6 +244,7 @@ std::shared_ptr<Mesh> Mesh::createQuad() {
     };
     
     auto mesh = std::make_shared<Mesh>(vertices, indices);
+    mesh->optimize();
     mesh->calculateTangents();
     mesh->setMeshType(MeshType::QUAD);
     return mesh;
@@ -201,6 +289,7 @@ std::shared_ptr<Mesh> Mesh::createPlane(float width, float height, int subdivisi
     }
     
     auto mesh = std::make_shared<Mesh>(vertices, indices);
+    mesh->optimize();
     mesh->calculateTangents();
     mesh->setMeshType(MeshType::PLANE);
     return mesh;
@@ -254,6 +343,7 @@ std::shared_ptr<Mesh> Mesh::createCube() {
     std::vector<unsigned int> indices;
     
     auto mesh = std::make_shared<Mesh>(vertices, indices);
+    mesh->optimize();
     mesh->calculateTangents();
     mesh->setMeshType(MeshType::CUBE);
     return mesh;
@@ -300,6 +390,7 @@ std::shared_ptr<Mesh> Mesh::createSphere(int segments, int rings, float radius)
     }
 
     auto mesh = std::make_shared<Mesh>(vertices, indices);
+    mesh->optimize();
     mesh->calculateTangents();
     mesh->setMeshType(MeshType::SPHERE);
     return mesh;
@@ -388,6 +479,7 @@ std::shared_ptr<Mesh> Mesh::createCapsule(float radius, float halfHeight, int se
     addHemisphere(-halfHeight, true); // bottom
 
     auto mesh = std::make_shared<Mesh>(vertices, indices);
+    mesh->optimize();
     mesh->calculateTangents();
     mesh->setMeshType(MeshType::CAPSULE);
     return mesh;
@@ -451,6 +543,7 @@ std::shared_ptr<Mesh> Mesh::createCylinder(float radius, float halfHeight, int s
     addDisk(-halfHeight, -1);
 
     auto mesh = std::make_shared<Mesh>(vertices, indices);
+    mesh->optimize();
     mesh->calculateTangents();
     mesh->setMeshType(MeshType::CYLINDER);
     return mesh;
@@ -510,39 +603,42 @@ void Mesh::calculateTangents() {
 }
 
 void Mesh::setupBuffers() {
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
+    auto& device = RenderDevice::getInstance();
+    device.genVertexArrays(1, &VAO);
+    device.genBuffers(1, &VBO);
+    device.genBuffers(1, &EBO);
     
-    glBindVertexArray(VAO);
+    device.bindVertexArray(VAO);
     
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    VertexFormat format = compactVertexFormatsEnabled ? VertexLayout::choose(vertexFormat, vertices) : VertexFormat::FULL;
+    vertexLayout = VertexLayout::create(format, VertexFormatSupport::get());
+    if (!vertices.empty()) {
+        constantBoneWeights = vertices[0].boneWeights;
+        constantBoneIndices = vertices[0].boneIndices;
+    }
+
+    std::vector<uint8_t> packedVertices;
+    vertexLayout.pack(vertices, packedVertices);
+
+    device.bindBuffer(GL_ARRAY_BUFFER, VBO);
+    device.bufferData(GL_ARRAY_BUFFER, packedVertices.size(), packedVertices.data(), GL_STATIC_DRAW);
     
     if (!indices.empty()) {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        device.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+        if (vertices.size() <= 65536) {
+            // Half the index bandwidth; every index fits in 16 bits
+            std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+            device.bufferData(GL_ELEMENT_ARRAY_BUFFER, shortIndices.size() * sizeof(uint16_t), shortIndices.data(), GL_STATIC_DRAW);
+            indexType = GL_UNSIGNED_SHORT;
+        } else {
+            device.bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+            indexType = GL_UNSIGNED_INT;
+        }
     }
     
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-    
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-    
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
-    
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, tangent));
-    
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, boneWeights));
-    
-    glEnableVertexAttribArray(5);
-    glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, boneIndices));
+    vertexLayout.applyAttributes();
     
-    glBindVertexArray(0);
+    device.bindVertexArray(0);
 }
 
 void Mesh::drawDirectCube(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, const glm::vec3& color) const {
@@ -797,16 +893,17 @@ std::shared_ptr<Mesh> Mesh::createWireframePlane(float width, float height) {
 }
 
 void Mesh::cleanupBuffers() {
+    auto& device = RenderDevice::getInstance();
     if (VAO) {
-        glDeleteVertexArrays(1, &VAO);
+        device.deleteVertexArrays(1, &VAO);
         VAO = 0;
     }
     if (VBO) {
-        glDeleteBuffers(1, &VBO);
+        device.deleteBuffers(1, &VBO);
         VBO = 0;
     }
     if (EBO) {
-        glDeleteBuffers(1, &EBO);
+        device.deleteBuffers(1, &EBO);
         EBO = 0;
     }
     uploaded = false;
@@ -0,0 +1,387 @@
+#include "Rendering/MeshOptimizer.h"
+#include "Rendering/Mesh.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace GameEngine {
+
+namespace {
+
+const unsigned int INVALID_INDEX = ~0u;
+
+uint32_t hashVertex(const Vertex& vertex) {
+    // FNV-1a over the raw floats; Vertex has no padding
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&vertex);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(Vertex); ++i) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Returns 1 on a miss of the FIFO cache and records the vertex as cached
+unsigned int updateCache(unsigned int vertex, unsigned int cacheSize,
+                         std::vector<unsigned int>& timestamps, unsigned int& timestamp) {
+    if (timestamp - timestamps[vertex] > cacheSize) {
+        timestamps[vertex] = timestamp++;
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+MeshOptimizer::Stats MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                             const Options& options) {
+    std::chrono::high_resolution_clock::time_point startTime = std::chrono::high_resolution_clock::now();
+
+    Stats stats = Stats();
+    stats.verticesBefore = vertices.size();
+    stats.verticesAfter = vertices.size();
+    stats.triangles = indices.size() / 3;
+    stats.fitsIn16Bit = vertices.size() <= 65536;
+
+    if (vertices.empty()) return stats;
+
+    if (indices.empty()) {
+        if (vertices.size() % 3 != 0) return stats;
+        indices.resize(vertices.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            indices[i] = static_cast<unsigned int>(i);
+        }
+    }
+    if (indices.size() % 3 != 0) return stats;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (indices[i] >= vertices.size()) return stats;
+    }
+
+    stats.acmrBefore = computeACMR(indices, vertices.size(), options.cacheSize);
+    stats.atvrBefore = stats.acmrBefore * (indices.size() / 3) / vertices.size();
+
+    if (options.deduplicate) {
+        std::vector<unsigned int> remap;
+        size_t uniqueCount = generateDeduplicationRemap(vertices, remap);
+        if (uniqueCount < vertices.size()) {
+            applyRemap(vertices, indices, remap, uniqueCount);
+        }
+        removeDegenerateTriangles(indices);
+    }
+
+    if (options.optimizeVertexCache) {
+        std::vector<unsigned int> clusterStarts;
+        optimizeVertexCache(indices, vertices.size(), options.cacheSize,
+                            options.optimizeOverdraw ? &clusterStarts : nullptr);
+        if (options.optimizeOverdraw) {
+            optimizeOverdraw(indices, vertices, clusterStarts, options.cacheSize, options.overdrawThreshold);
+        }
+    }
+
+    if (options.optimizeVertexFetch) {
+        optimizeVertexFetch(vertices, indices);
+    }
+
+    stats.verticesAfter = vertices.size();
+    stats.triangles = indices.size() / 3;
+    stats.acmrAfter = computeACMR(indices, vertices.size(), options.cacheSize);
+    stats.atvrAfter = vertices.empty() ? 0.0f : stats.acmrAfter * stats.triangles / vertices.size();
+    stats.fitsIn16Bit = vertices.size() <= 65536;
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - startTime;
+    stats.optimizeMs = elapsed.count();
+    return stats;
+}
+
+size_t MeshOptimizer::generateDeduplicationRemap(const std::vector<Vertex>& vertices, std::vector<unsigned int>& remap) {
+    remap.assign(vertices.size(), INVALID_INDEX);
+
+    // Open addressing table of first occurrences, at most half full
+    size_t tableSize = 1;
+    while (tableSize < vertices.size() * 2) tableSize <<= 1;
+    std::vector<unsigned int> table(tableSize, INVALID_INDEX);
+    size_t mask = tableSize - 1;
+
+    size_t uniqueCount = 0;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        size_t slot = hashVertex(vertices[i]) & mask;
+        while (true) {
+            unsigned int existing = table[slot];
+            if (existing == INVALID_INDEX) {
+                table[slot] = static_cast<unsigned int>(i);
+                remap[i] = static_cast<unsigned int>(uniqueCount++);
+                break;
+            }
+            if (std::memcmp(&vertices[existing], &vertices[i], sizeof(Vertex)) == 0) {
+                remap[i] = remap[existing];
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+    return uniqueCount;
+}
+
+void MeshOptimizer::applyRemap(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                               const std::vector<unsigned int>& remap, size_t newVertexCount) {
+    std::vector<Vertex> remapped(newVertexCount);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        if (remap[i] != INVALID_INDEX) {
+            remapped[remap[i]] = vertices[i];
+        }
+    }
+    vertices.swap(remapped);
+
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = remap[indices[i]];
+    }
+}
+
+size_t MeshOptimizer::removeDegenerateTriangles(std::vector<unsigned int>& indices) {
+    size_t write = 0;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        unsigned int a = indices[i];
+        unsigned int b = indices[i + 1];
+        unsigned int c = indices[i + 2];
+        if (a == b || b == c || a == c) continue;
+        indices[write++] = a;
+        indices[write++] = b;
+        indices[write++] = c;
+    }
+    size_t removed = (indices.size() - write) / 3;
+    indices.resize(write);
+    return removed;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount,
+                                        unsigned int cacheSize, std::vector<unsigned int>* clusterStarts) {
+    size_t triangleCount = indices.size() / 3;
+    if (clusterStarts) {
+        clusterStarts->clear();
+    }
+    if (triangleCount == 0 || vertexCount == 0) return;
+
+    // Vertex -> triangle adjacency, and live (not yet emitted) triangle counts
+    std::vector<unsigned int> liveCount(vertexCount, 0);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        liveCount[indices[i]]++;
+    }
+    std::vector<unsigned int> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveCount[v];
+    }
+    std::vector<unsigned int> adjacency(indices.size());
+    std::vector<unsigned int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+    }
+
+    std::vector<unsigned int> timestamps(vertexCount, 0);
+    unsigned int timestamp = cacheSize + 1;
+    std::vector<char> emitted(triangleCount, 0);
+    std::vector<unsigned int> deadEnd;
+    deadEnd.reserve(indices.size());
+    std::vector<unsigned int> candidates;
+    std::vector<unsigned int> output;
+    output.reserve(indices.size());
+
+    unsigned int cursor = 0;
+    while (cursor < vertexCount && liveCount[cursor] == 0) ++cursor;
+    unsigned int current = cursor < vertexCount ? cursor : INVALID_INDEX;
+    if (clusterStarts && current != INVALID_INDEX) {
+        clusterStarts->push_back(0);
+    }
+
+    while (current != INVALID_INDEX) {
+        // Fan out: emit every remaining triangle around the current vertex
+        candidates.clear();
+        for (unsigned int k = adjacencyOffsets[current]; k < adjacencyOffsets[current + 1]; ++k) {
+            unsigned int triangle = adjacency[k];
+            if (emitted[triangle]) continue;
+            for (int c = 0; c < 3; ++c) {
+                unsigned int v = indices[triangle * 3 + c];
+                output.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                liveCount[v]--;
+                updateCache(v, cacheSize, timestamps, timestamp);
+            }
+            emitted[triangle] = 1;
+        }
+
+        // Prefer the oldest candidate that will still be cached after its own fan
+        unsigned int next = INVALID_INDEX;
+        int bestPriority = -1;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            unsigned int v = candidates[i];
+            if (liveCount[v] == 0) continue;
+            int priority = 0;
+            if (timestamp - timestamps[v] + 2 * liveCount[v] <= cacheSize) {
+                priority = static_cast<int>(timestamp - timestamps[v]);
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+
+        if (next == INVALID_INDEX) {
+            // Dead end: recently used vertices first, then input order
+            while (!deadEnd.empty()) {
+                unsigned int v = deadEnd.back();
+                deadEnd.pop_back();
+                if (liveCount[v] > 0) {
+                    next = v;
+                    break;
+                }
+            }
+            while (next == INVALID_INDEX && cursor < vertexCount) {
+                if (liveCount[cursor] > 0) {
+                    next = cursor;
+                } else {
+                    ++cursor;
+                }
+            }
+            if (clusterStarts && next != INVALID_INDEX) {
+                clusterStarts->push_back(static_cast<unsigned int>(output.size() / 3));
+            }
+        }
+        current = next;
+    }
+
+    indices.swap(output);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+                                     const std::vector<unsigned int>& clusterStarts,
+                                     unsigned int cacheSize, float threshold) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    std::vector<unsigned int> hardClusters(clusterStarts);
+    if (hardClusters.empty() || hardClusters[0] != 0) {
+        hardClusters.insert(hardClusters.begin(), 0);
+    }
+
+    // Split hard clusters wherever the run so far already reaches the
+    // cluster's own ACMR (within threshold), giving more pieces to sort
+    std::vector<unsigned int> timestamps(vertices.size(), 0);
+    unsigned int timestamp = cacheSize + 1;
+    std::vector<unsigned int> clusters;
+    for (size_t c = 0; c < hardClusters.size(); ++c) {
+        unsigned int start = hardClusters[c];
+        unsigned int end = (c + 1 < hardClusters.size()) ? hardClusters[c + 1] : static_cast<unsigned int>(triangleCount);
+        if (start >= end) continue;
+
+        timestamp += cacheSize + 1;
+        unsigned int clusterMisses = 0;
+        for (unsigned int t = start; t < end; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                clusterMisses += updateCache(indices[t * 3 + k], cacheSize, timestamps, timestamp);
+            }
+        }
+        float clusterThreshold = threshold * static_cast<float>(clusterMisses) / (end - start);
+
+        clusters.push_back(start);
+        timestamp += cacheSize + 1;
+        unsigned int runningMisses = 0;
+        unsigned int runningTriangles = 0;
+        for (unsigned int t = start; t < end; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                runningMisses += updateCache(indices[t * 3 + k], cacheSize, timestamps, timestamp);
+            }
+            ++runningTriangles;
+            if (static_cast<float>(runningMisses) / runningTriangles <= clusterThreshold) {
+                clusters.push_back(t + 1);
+                timestamp += cacheSize + 1;
+                runningMisses = 0;
+                runningTriangles = 0;
+            }
+        }
+        if (clusters.back() == end) {
+            clusters.pop_back();
+        }
+    }
+
+    // Area-weighted centroid and summed normal of each cluster
+    size_t clusterCount = clusters.size();
+    std::vector<glm::vec3> centroids(clusterCount, glm::vec3(0.0f));
+    std::vector<glm::vec3> normals(clusterCount, glm::vec3(0.0f));
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusterCount; ++c) {
+        unsigned int start = clusters[c];
+        unsigned int end = (c + 1 < clusterCount) ? clusters[c + 1] : static_cast<unsigned int>(triangleCount);
+        float clusterArea = 0.0f;
+        for (unsigned int t = start; t < end; ++t) {
+            const glm::vec3& p0 = vertices[indices[t * 3]].position;
+            const glm::vec3& p1 = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3& p2 = vertices[indices[t * 3 + 2]].position;
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float area = glm::length(normal);
+            centroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+            normals[c] += normal;
+            clusterArea += area;
+        }
+        meshCentroid += centroids[c];
+        meshArea += clusterArea;
+        if (clusterArea > 0.0f) {
+            centroids[c] /= clusterArea;
+        }
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    // Clusters facing away from the mesh center tend to occlude the rest
+    std::vector<float> sortKeys(clusterCount, 0.0f);
+    std::vector<unsigned int> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c) {
+        float normalLength = glm::length(normals[c]);
+        if (normalLength > 0.0f) {
+            sortKeys[c] = glm::dot(centroids[c] - meshCentroid, normals[c] / normalLength);
+        }
+        order[c] = static_cast<unsigned int>(c);
+    }
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](unsigned int a, unsigned int b) {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<unsigned int> output;
+    output.reserve(indices.size());
+    for (size_t i = 0; i < clusterCount; ++i) {
+        unsigned int c = order[i];
+        unsigned int start = clusters[c];
+        unsigned int end = (c + 1 < clusterCount) ? clusters[c + 1] : static_cast<unsigned int>(triangleCount);
+        output.insert(output.end(), indices.begin() + start * 3, indices.begin() + end * 3);
+    }
+    indices.swap(output);
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    std::vector<unsigned int> remap(vertices.size(), INVALID_INDEX);
+    unsigned int nextIndex = 0;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        unsigned int& index = remap[indices[i]];
+        if (index == INVALID_INDEX) {
+            index = nextIndex++;
+        }
+    }
+    // Unreferenced vertices are dropped
+    applyRemap(vertices, indices, remap, nextIndex);
+}
+
+float MeshOptimizer::computeACMR(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return 0.0f;
+
+    std::vector<unsigned int> timestamps(vertexCount, 0);
+    unsigned int timestamp = cacheSize + 1;
+    unsigned int misses = 0;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        misses += updateCache(indices[i], cacheSize, timestamps, timestamp);
+    }
+    return static_cast<float>(misses) / triangleCount;
+}
+
+} // namespace GameEngine
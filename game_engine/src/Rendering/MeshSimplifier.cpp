@@ -0,0 +1,319 @@
+#include "Rendering/MeshSimplifier.h"
+#include "Rendering/Mesh.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_set>
+
+namespace GameEngine {
+
+namespace {
+
+const unsigned int INVALID_INDEX = ~0u;
+const int MAX_PASSES = 64;
+
+// Symmetric 4x4 plane quadric, accumulated in double for stability
+struct Quadric {
+    double a00, a11, a22, a10, a20, a21;
+    double b0, b1, b2;
+    double c;
+    double weight;
+
+    Quadric() : a00(0), a11(0), a22(0), a10(0), a20(0), a21(0), b0(0), b1(0), b2(0), c(0), weight(0) {}
+
+    void addPlane(const glm::vec3& normal, double distance, double planeWeight) {
+        double nx = normal.x, ny = normal.y, nz = normal.z;
+        a00 += planeWeight * nx * nx;
+        a11 += planeWeight * ny * ny;
+        a22 += planeWeight * nz * nz;
+        a10 += planeWeight * ny * nx;
+        a20 += planeWeight * nz * nx;
+        a21 += planeWeight * nz * ny;
+        b0 += planeWeight * nx * distance;
+        b1 += planeWeight * ny * distance;
+        b2 += planeWeight * nz * distance;
+        c += planeWeight * distance * distance;
+        weight += planeWeight;
+    }
+
+    void add(const Quadric& other) {
+        a00 += other.a00; a11 += other.a11; a22 += other.a22;
+        a10 += other.a10; a20 += other.a20; a21 += other.a21;
+        b0 += other.b0; b1 += other.b1; b2 += other.b2;
+        c += other.c;
+        weight += other.weight;
+    }
+
+    // Area-weighted mean squared distance of p to the accumulated planes
+    double error(const glm::vec3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        double result = a00 * x * x + a11 * y * y + a22 * z * z
+                      + 2.0 * (a10 * x * y + a20 * x * z + a21 * y * z)
+                      + 2.0 * (b0 * x + b1 * y + b2 * z)
+                      + c;
+        return weight > 0.0 ? std::fabs(result) / weight : 0.0;
+    }
+};
+
+struct Collapse {
+    double cost;
+    unsigned int from;
+    unsigned int to;
+
+    bool operator<(const Collapse& other) const { return cost < other.cost; }
+};
+
+uint32_t hashPosition(const glm::vec3& position) {
+    // Adding zero folds -0.0 into +0.0 so equal positions hash equally
+    float canonical[3] = { position.x + 0.0f, position.y + 0.0f, position.z + 0.0f };
+    uint32_t bits[3];
+    std::memcpy(bits, canonical, sizeof(bits));
+    return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+}
+
+// Maps every vertex to the first vertex with an equal position
+void buildPositionGroups(const std::vector<Vertex>& vertices, std::vector<unsigned int>& group) {
+    group.assign(vertices.size(), INVALID_INDEX);
+
+    size_t tableSize = 1;
+    while (tableSize < vertices.size() * 2) tableSize <<= 1;
+    std::vector<unsigned int> table(tableSize, INVALID_INDEX);
+    size_t mask = tableSize - 1;
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        size_t slot = hashPosition(vertices[i].position) & mask;
+        while (true) {
+            unsigned int existing = table[slot];
+            if (existing == INVALID_INDEX) {
+                table[slot] = static_cast<unsigned int>(i);
+                group[i] = static_cast<unsigned int>(i);
+                break;
+            }
+            if (vertices[existing].position == vertices[i].position) {
+                group[i] = existing;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+}
+
+bool isDegenerate(unsigned int a, unsigned int b, unsigned int c, const std::vector<unsigned int>& group) {
+    return group[a] == group[b] || group[b] == group[c] || group[a] == group[c];
+}
+
+} // namespace
+
+float MeshSimplifier::computeExtent(const std::vector<Vertex>& vertices) {
+    if (vertices.empty()) return 0.0f;
+    glm::vec3 boundsMin = vertices[0].position;
+    glm::vec3 boundsMax = vertices[0].position;
+    for (size_t i = 1; i < vertices.size(); ++i) {
+        boundsMin = glm::min(boundsMin, vertices[i].position);
+        boundsMax = glm::max(boundsMax, vertices[i].position);
+    }
+    glm::vec3 size = boundsMax - boundsMin;
+    return std::max(size.x, std::max(size.y, size.z));
+}
+
+float MeshSimplifier::simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                               size_t targetIndexCount, float targetError, std::vector<unsigned int>& result) {
+    result.clear();
+    size_t vertexCount = vertices.size();
+    if (vertexCount == 0 || indices.size() % 3 != 0) return 0.0f;
+
+    std::vector<unsigned int> group;
+    buildPositionGroups(vertices, group);
+
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount) {
+            result.clear();
+            return 0.0f;
+        }
+        if (isDegenerate(indices[i], indices[i + 1], indices[i + 2], group)) continue;
+        result.insert(result.end(), indices.begin() + i, indices.begin() + i + 3);
+    }
+
+    // Work in positions normalized to the unit box so errors are relative
+    glm::vec3 boundsMin = vertices[0].position;
+    for (size_t i = 1; i < vertexCount; ++i) {
+        boundsMin = glm::min(boundsMin, vertices[i].position);
+    }
+    float extent = computeExtent(vertices);
+    float scale = extent > 0.0f ? 1.0f / extent : 1.0f;
+    std::vector<glm::vec3> positions(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        positions[i] = (vertices[i].position - boundsMin) * scale;
+    }
+
+    // Lock seam vertices (several wedges at one position) and open borders
+    std::vector<unsigned int> groupSize(vertexCount, 0);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        groupSize[group[i]]++;
+    }
+    std::unordered_set<uint64_t> directedEdges;
+    directedEdges.reserve(result.size());
+    for (size_t i = 0; i < result.size(); i += 3) {
+        for (int e = 0; e < 3; ++e) {
+            uint64_t a = group[result[i + e]];
+            uint64_t b = group[result[i + (e + 1) % 3]];
+            directedEdges.insert((a << 32) | b);
+        }
+    }
+    std::vector<char> lockedGroup(vertexCount, 0);
+    for (size_t i = 0; i < result.size(); i += 3) {
+        for (int e = 0; e < 3; ++e) {
+            uint64_t a = group[result[i + e]];
+            uint64_t b = group[result[i + (e + 1) % 3]];
+            if (directedEdges.find((b << 32) | a) == directedEdges.end()) {
+                lockedGroup[a] = 1;
+                lockedGroup[b] = 1;
+            }
+        }
+    }
+    std::vector<char> locked(vertexCount, 0);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        locked[i] = (groupSize[group[i]] > 1 || lockedGroup[group[i]]) ? 1 : 0;
+    }
+
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < result.size(); i += 3) {
+        const glm::vec3& p0 = positions[result[i]];
+        const glm::vec3& p1 = positions[result[i + 1]];
+        const glm::vec3& p2 = positions[result[i + 2]];
+        glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        float area = glm::length(normal);
+        if (area <= 0.0f) continue;
+        normal /= area;
+        double distance = -glm::dot(normal, p0);
+        for (int c = 0; c < 3; ++c) {
+            quadrics[result[i + c]].addPlane(normal, distance, area);
+        }
+    }
+
+    double errorLimit = static_cast<double>(targetError) * targetError;
+    double maxError = 0.0;
+    size_t targetTriangles = targetIndexCount / 3;
+
+    std::vector<unsigned int> adjacencyOffsets(vertexCount + 1);
+    std::vector<unsigned int> adjacency;
+    std::vector<unsigned int> fill;
+    std::vector<Collapse> collapses;
+    std::vector<unsigned int> remap(vertexCount);
+    std::vector<char> touched(vertexCount);
+
+    for (int pass = 0; pass < MAX_PASSES && result.size() / 3 > targetTriangles; ++pass) {
+        size_t triangleCount = result.size() / 3;
+
+        // Vertex -> triangle adjacency for the current triangles
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+        for (size_t i = 0; i < result.size(); ++i) {
+            adjacencyOffsets[result[i] + 1]++;
+        }
+        for (size_t v = 0; v < vertexCount; ++v) {
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        }
+        adjacency.resize(result.size());
+        fill.assign(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < result.size(); ++i) {
+            adjacency[fill[result[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+
+        collapses.clear();
+        for (size_t i = 0; i < result.size(); i += 3) {
+            for (int e = 0; e < 3; ++e) {
+                unsigned int a = result[i + e];
+                unsigned int b = result[i + (e + 1) % 3];
+                if (!locked[a]) {
+                    Collapse collapse;
+                    collapse.cost = quadrics[a].error(positions[b]);
+                    collapse.from = a;
+                    collapse.to = b;
+                    collapses.push_back(collapse);
+                }
+                if (!locked[b]) {
+                    Collapse collapse;
+                    collapse.cost = quadrics[b].error(positions[a]);
+                    collapse.from = b;
+                    collapse.to = a;
+                    collapses.push_back(collapse);
+                }
+            }
+        }
+        if (collapses.empty()) break;
+        std::sort(collapses.begin(), collapses.end());
+
+        for (size_t v = 0; v < vertexCount; ++v) {
+            remap[v] = static_cast<unsigned int>(v);
+        }
+        std::fill(touched.begin(), touched.end(), 0);
+
+        size_t removedTriangles = 0;
+        size_t performed = 0;
+        for (size_t c = 0; c < collapses.size(); ++c) {
+            const Collapse& collapse = collapses[c];
+            if (collapse.cost > errorLimit) break;
+            unsigned int a = collapse.from;
+            unsigned int b = collapse.to;
+            if (touched[a] || touched[b]) continue;
+
+            // Reject collapses that flip or sharply rotate a surviving triangle
+            bool valid = true;
+            size_t collapsing = 0;
+            for (unsigned int k = adjacencyOffsets[a]; k < adjacencyOffsets[a + 1] && valid; ++k) {
+                unsigned int t = adjacency[k];
+                unsigned int corners[3] = { result[t * 3], result[t * 3 + 1], result[t * 3 + 2] };
+                if (corners[0] == b || corners[1] == b || corners[2] == b) {
+                    ++collapsing;
+                    continue;
+                }
+                glm::vec3 before[3];
+                glm::vec3 after[3];
+                for (int j = 0; j < 3; ++j) {
+                    before[j] = positions[corners[j]];
+                    after[j] = (corners[j] == a) ? positions[b] : before[j];
+                }
+                glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+                glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+                float alignment = glm::dot(normalBefore, normalAfter);
+                if (alignment < 0.25f * glm::length(normalBefore) * glm::length(normalAfter)) {
+                    valid = false;
+                }
+            }
+            if (!valid) continue;
+
+            remap[a] = b;
+            quadrics[b].add(quadrics[a]);
+            maxError = std::max(maxError, collapse.cost);
+            ++performed;
+            removedTriangles += collapsing;
+
+            // Keep this pass's collapses independent of each other
+            for (unsigned int k = adjacencyOffsets[a]; k < adjacencyOffsets[a + 1]; ++k) {
+                unsigned int t = adjacency[k];
+                touched[result[t * 3]] = 1;
+                touched[result[t * 3 + 1]] = 1;
+                touched[result[t * 3 + 2]] = 1;
+            }
+
+            if (triangleCount - removedTriangles <= targetTriangles) break;
+        }
+        if (performed == 0) break;
+
+        size_t write = 0;
+        for (size_t i = 0; i < result.size(); i += 3) {
+            unsigned int a = remap[result[i]];
+            unsigned int b = remap[result[i + 1]];
+            unsigned int c = remap[result[i + 2]];
+            if (isDegenerate(a, b, c, group)) continue;
+            result[write++] = a;
+            result[write++] = b;
+            result[write++] = c;
+        }
+        result.resize(write);
+    }
+
+    return static_cast<float>(std::sqrt(maxError));
+}
+
+} // namespace GameEngine
@@ -0,0 +1,567 @@
+#include "Rendering/NullRenderDevice.h"
+#include <cstring>
+
+namespace GameEngine {
+
+namespace {
+
+size_t bytesPerPixel(GLenum format, GLenum type) {
+    size_t components = 4;
+    switch (format) {
+        case GL_RED:
+        case GL_ALPHA:
+        case GL_LUMINANCE:
+        case GL_DEPTH_COMPONENT:
+            components = 1;
+            break;
+        case GL_LUMINANCE_ALPHA:
+            components = 2;
+            break;
+        case GL_RGB:
+            components = 3;
+            break;
+        default:
+            break;
+    }
+    switch (type) {
+        case GL_UNSIGNED_SHORT_5_6_5:
+        case GL_UNSIGNED_SHORT_4_4_4_4:
+        case GL_UNSIGNED_SHORT_5_5_5_1:
+            return 2;
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+            return components * 2;
+        case GL_UNSIGNED_INT:
+        case GL_INT:
+        case GL_FLOAT:
+            return components * 4;
+        default:
+            return components;
+    }
+}
+
+} // namespace
+
+NullRenderDevice::NullRenderDevice()
+    : recording(false)
+    , nextName(1)
+    , cullFaceMode(GL_BACK)
+    , depthFuncValue(GL_LESS)
+    , depthMaskValue(GL_TRUE)
+    , polygonModeValue(GL_FILL)
+    , blendSource(GL_ONE)
+    , blendDestination(GL_ZERO)
+    , activeTextureUnit(GL_TEXTURE0)
+    , currentProgram(0)
+    , boundVertexArray(0)
+    , boundFramebuffer(0) {
+    viewportRect[0] = 0;
+    viewportRect[1] = 0;
+    viewportRect[2] = VITA_WIDTH;
+    viewportRect[3] = VITA_HEIGHT;
+    clearColorValue[0] = clearColorValue[1] = clearColorValue[2] = clearColorValue[3] = 0.0f;
+    enabledCaps.insert(GL_DITHER);
+}
+
+void NullRenderDevice::record(const char* name, uint32_t a, uint32_t b, uint32_t c) {
+    stats.commands++;
+    if (recording) {
+        RenderDeviceCommand command;
+        command.name = name;
+        command.args[0] = a;
+        command.args[1] = b;
+        command.args[2] = c;
+        commands.push_back(command);
+    }
+}
+
+template<typename T>
+bool NullRenderDevice::changeState(T& current, const T& value) {
+    if (current == value) {
+        stats.redundantStateChanges++;
+        return false;
+    }
+    current = value;
+    stats.stateChanges++;
+    return true;
+}
+
+void NullRenderDevice::generateNames(GLsizei n, GLuint* names) {
+    for (GLsizei i = 0; i < n; ++i) {
+        names[i] = nextName++;
+        liveObjects.insert(names[i]);
+    }
+}
+
+void NullRenderDevice::deleteNames(GLsizei n, const GLuint* names) {
+    for (GLsizei i = 0; i < n; ++i) {
+        liveObjects.erase(names[i]);
+    }
+}
+
+void NullRenderDevice::uploadUniform(GLint location, size_t bytes) {
+    // Location -1 is silently ignored by GL, so nothing would be uploaded
+    if (location < 0) return;
+    stats.uniformUploads++;
+    stats.bytesUploaded += bytes;
+}
+
+void NullRenderDevice::countDraw(GLsizei count) {
+    stats.drawCalls++;
+    if (count > 0) {
+        stats.verticesSubmitted += static_cast<unsigned int>(count);
+    }
+}
+
+// State
+
+void NullRenderDevice::enable(GLenum cap) {
+    record("enable", cap);
+    if (enabledCaps.insert(cap).second) {
+        stats.stateChanges++;
+    } else {
+        stats.redundantStateChanges++;
+    }
+}
+
+void NullRenderDevice::disable(GLenum cap) {
+    record("disable", cap);
+    if (enabledCaps.erase(cap) > 0) {
+        stats.stateChanges++;
+    } else {
+        stats.redundantStateChanges++;
+    }
+}
+
+GLboolean NullRenderDevice::isEnabled(GLenum cap) {
+    record("isEnabled", cap);
+    return enabledCaps.count(cap) ? GL_TRUE : GL_FALSE;
+}
+
+void NullRenderDevice::getIntegerv(GLenum pname, GLint* data) {
+    record("getIntegerv", pname);
+    switch (pname) {
+        case GL_VIEWPORT:
+            memcpy(data, viewportRect, sizeof(viewportRect));
+            break;
+        case GL_POLYGON_MODE:
+            data[0] = static_cast<GLint>(polygonModeValue);
+            data[1] = static_cast<GLint>(polygonModeValue);
+            break;
+        case GL_DEPTH_FUNC:
+            data[0] = static_cast<GLint>(depthFuncValue);
+            break;
+        case GL_CULL_FACE_MODE:
+            data[0] = static_cast<GLint>(cullFaceMode);
+            break;
+        case GL_BLEND_SRC:
+            data[0] = static_cast<GLint>(blendSource);
+            break;
+        case GL_BLEND_DST:
+            data[0] = static_cast<GLint>(blendDestination);
+            break;
+        case GL_ACTIVE_TEXTURE:
+            data[0] = static_cast<GLint>(activeTextureUnit);
+            break;
+        case GL_CURRENT_PROGRAM:
+            data[0] = static_cast<GLint>(currentProgram);
+            break;
+        case GL_ARRAY_BUFFER_BINDING:
+            data[0] = static_cast<GLint>(boundBuffers[GL_ARRAY_BUFFER]);
+            break;
+        case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+            data[0] = static_cast<GLint>(boundBuffers[GL_ELEMENT_ARRAY_BUFFER]);
+            break;
+        case GL_TEXTURE_BINDING_2D:
+            data[0] = static_cast<GLint>(boundTextures[std::make_pair(activeTextureUnit, static_cast<GLenum>(GL_TEXTURE_2D))]);
+            break;
+        case GL_FRAMEBUFFER_BINDING:
+            data[0] = static_cast<GLint>(boundFramebuffer);
+            break;
+        case GL_MAX_TEXTURE_SIZE:
+            data[0] = 4096;
+            break;
+        default:
+            data[0] = 0;
+            break;
+    }
+}
+
+void NullRenderDevice::getBooleanv(GLenum pname, GLboolean* data) {
+    record("getBooleanv", pname);
+    if (pname == GL_DEPTH_WRITEMASK) {
+        data[0] = depthMaskValue;
+    } else {
+        data[0] = enabledCaps.count(pname) ? GL_TRUE : GL_FALSE;
+    }
+}
+
+void NullRenderDevice::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    record("viewport", static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+    bool changed = viewportRect[0] != x || viewportRect[1] != y ||
+                   viewportRect[2] != width || viewportRect[3] != height;
+    if (changed) {
+        viewportRect[0] = x;
+        viewportRect[1] = y;
+        viewportRect[2] = width;
+        viewportRect[3] = height;
+        stats.stateChanges++;
+    } else {
+        stats.redundantStateChanges++;
+    }
+}
+
+void NullRenderDevice::clearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+    record("clearColor");
+    clearColorValue[0] = r;
+    clearColorValue[1] = g;
+    clearColorValue[2] = b;
+    clearColorValue[3] = a;
+}
+
+void NullRenderDevice::clear(GLbitfield mask) {
+    record("clear", mask);
+}
+
+void NullRenderDevice::cullFace(GLenum mode) {
+    record("cullFace", mode);
+    changeState(cullFaceMode, mode);
+}
+
+void NullRenderDevice::depthFunc(GLenum func) {
+    record("depthFunc", func);
+    changeState(depthFuncValue, func);
+}
+
+void NullRenderDevice::depthMask(GLboolean flag) {
+    record("depthMask", flag);
+    changeState(depthMaskValue, flag);
+}
+
+void NullRenderDevice::polygonMode(GLenum face, GLenum mode) {
+    record("polygonMode", face, mode);
+    changeState(polygonModeValue, mode);
+}
+
+void NullRenderDevice::blendFunc(GLenum sfactor, GLenum dfactor) {
+    record("blendFunc", sfactor, dfactor);
+    if (blendSource == sfactor && blendDestination == dfactor) {
+        stats.redundantStateChanges++;
+        return;
+    }
+    blendSource = sfactor;
+    blendDestination = dfactor;
+    stats.stateChanges++;
+}
+
+void NullRenderDevice::pixelStorei(GLenum pname, GLint param) {
+    record("pixelStorei", pname, static_cast<uint32_t>(param));
+}
+
+// Buffers and vertex arrays
+
+void NullRenderDevice::genBuffers(GLsizei n, GLuint* buffers) {
+    record("genBuffers", static_cast<uint32_t>(n));
+    generateNames(n, buffers);
+}
+
+void NullRenderDevice::deleteBuffers(GLsizei n, const GLuint* buffers) {
+    record("deleteBuffers", static_cast<uint32_t>(n));
+    deleteNames(n, buffers);
+}
+
+void NullRenderDevice::bindBuffer(GLenum target, GLuint buffer) {
+    record("bindBuffer", target, buffer);
+    changeState(boundBuffers[target], buffer);
+}
+
+void NullRenderDevice::bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    record("bufferData", target, static_cast<uint32_t>(size), usage);
+    if (data && size > 0) {
+        stats.bufferUploads++;
+        stats.bytesUploaded += static_cast<size_t>(size);
+    }
+}
+
+void NullRenderDevice::bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    record("bufferSubData", target, static_cast<uint32_t>(offset), static_cast<uint32_t>(size));
+    if (data && size > 0) {
+        stats.bufferUploads++;
+        stats.bytesUploaded += static_cast<size_t>(size);
+    }
+}
+
+void NullRenderDevice::genVertexArrays(GLsizei n, GLuint* arrays) {
+    record("genVertexArrays", static_cast<uint32_t>(n));
+    generateNames(n, arrays);
+}
+
+void NullRenderDevice::deleteVertexArrays(GLsizei n, const GLuint* arrays) {
+    record("deleteVertexArrays", static_cast<uint32_t>(n));
+    deleteNames(n, arrays);
+}
+
+void NullRenderDevice::bindVertexArray(GLuint array) {
+    record("bindVertexArray", array);
+    changeState(boundVertexArray, array);
+}
+
+void NullRenderDevice::enableVertexAttribArray(GLuint index) {
+    record("enableVertexAttribArray", index);
+}
+
+void NullRenderDevice::disableVertexAttribArray(GLuint index) {
+    record("disableVertexAttribArray", index);
+}
+
+void NullRenderDevice::vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                                           GLsizei stride, const void* pointer) {
+    (void)type;
+    (void)normalized;
+    (void)pointer;
+    record("vertexAttribPointer", index, static_cast<uint32_t>(size), static_cast<uint32_t>(stride));
+}
+
+void NullRenderDevice::vertexAttrib4fv(GLuint index, const GLfloat* values) {
+    (void)values;
+    record("vertexAttrib4fv", index);
+}
+
+// Drawing
+
+void NullRenderDevice::drawArrays(GLenum mode, GLint first, GLsizei count) {
+    record("drawArrays", mode, static_cast<uint32_t>(first), static_cast<uint32_t>(count));
+    countDraw(count);
+}
+
+void NullRenderDevice::drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    (void)indices;
+    record("drawElements", mode, static_cast<uint32_t>(count), type);
+    countDraw(count);
+}
+
+// Textures
+
+void NullRenderDevice::activeTexture(GLenum unit) {
+    record("activeTexture", unit);
+    changeState(activeTextureUnit, unit);
+}
+
+void NullRenderDevice::genTextures(GLsizei n, GLuint* textures) {
+    record("genTextures", static_cast<uint32_t>(n));
+    generateNames(n, textures);
+}
+
+void NullRenderDevice::deleteTextures(GLsizei n, const GLuint* textures) {
+    record("deleteTextures", static_cast<uint32_t>(n));
+    deleteNames(n, textures);
+}
+
+void NullRenderDevice::bindTexture(GLenum target, GLuint texture) {
+    record("bindTexture", target, texture);
+    changeState(boundTextures[std::make_pair(activeTextureUnit, target)], texture);
+}
+
+void NullRenderDevice::texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                                  GLint border, GLenum format, GLenum type, const void* pixels) {
+    (void)internalFormat;
+    (void)border;
+    record("texImage2D", target, static_cast<uint32_t>(level), static_cast<uint32_t>(width));
+    if (pixels && width > 0 && height > 0) {
+        stats.textureUploads++;
+        stats.bytesUploaded += static_cast<size_t>(width) * height * bytesPerPixel(format, type);
+    }
+}
+
+void NullRenderDevice::texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                                     GLsizei height, GLenum format, GLenum type, const void* pixels) {
+    (void)xoffset;
+    (void)yoffset;
+    record("texSubImage2D", target, static_cast<uint32_t>(level), static_cast<uint32_t>(width));
+    if (pixels && width > 0 && height > 0) {
+        stats.textureUploads++;
+        stats.bytesUploaded += static_cast<size_t>(width) * height * bytesPerPixel(format, type);
+    }
+}
+
+void NullRenderDevice::compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width,
+                                            GLsizei height, GLint border, GLsizei imageSize, const void* data) {
+    (void)width;
+    (void)height;
+    (void)border;
+    record("compressedTexImage2D", target, static_cast<uint32_t>(level), internalFormat);
+    if (data && imageSize > 0) {
+        stats.textureUploads++;
+        stats.bytesUploaded += static_cast<size_t>(imageSize);
+    }
+}
+
+void NullRenderDevice::texParameteri(GLenum target, GLenum pname, GLint param) {
+    record("texParameteri", target, pname, static_cast<uint32_t>(param));
+}
+
+void NullRenderDevice::generateMipmap(GLenum target) {
+    record("generateMipmap", target);
+}
+
+// Framebuffers
+
+void NullRenderDevice::genFramebuffers(GLsizei n, GLuint* framebuffers) {
+    record("genFramebuffers", static_cast<uint32_t>(n));
+    generateNames(n, framebuffers);
+}
+
+void NullRenderDevice::deleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+    record("deleteFramebuffers", static_cast<uint32_t>(n));
+    deleteNames(n, framebuffers);
+}
+
+void NullRenderDevice::bindFramebuffer(GLenum target, GLuint framebuffer) {
+    record("bindFramebuffer", target, framebuffer);
+    changeState(boundFramebuffer, framebuffer);
+}
+
+void NullRenderDevice::framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget,
+                                            GLuint texture, GLint level) {
+    (void)textarget;
+    (void)level;
+    record("framebufferTexture2D", target, attachment, texture);
+}
+
+GLenum NullRenderDevice::checkFramebufferStatus(GLenum target) {
+    record("checkFramebufferStatus", target);
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+// Shaders and uniforms
+
+GLuint NullRenderDevice::createShader(GLenum type) {
+    GLuint shader = 0;
+    generateNames(1, &shader);
+    record("createShader", type, shader);
+    return shader;
+}
+
+void NullRenderDevice::deleteShader(GLuint shader) {
+    record("deleteShader", shader);
+    deleteNames(1, &shader);
+}
+
+void NullRenderDevice::shaderSource(GLuint shader, GLsizei count, const GLchar* const* source, const GLint* length) {
+    (void)source;
+    (void)length;
+    record("shaderSource", shader, static_cast<uint32_t>(count));
+}
+
+void NullRenderDevice::compileShader(GLuint shader) {
+    record("compileShader", shader);
+}
+
+void NullRenderDevice::getShaderiv(GLuint shader, GLenum pname, GLint* params) {
+    record("getShaderiv", shader, pname);
+    params[0] = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+}
+
+void NullRenderDevice::getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    record("getShaderInfoLog", shader);
+    if (length) *length = 0;
+    if (infoLog && bufSize > 0) infoLog[0] = '\0';
+}
+
+GLuint NullRenderDevice::createProgram() {
+    GLuint program = 0;
+    generateNames(1, &program);
+    record("createProgram", program);
+    return program;
+}
+
+void NullRenderDevice::deleteProgram(GLuint program) {
+    record("deleteProgram", program);
+    deleteNames(1, &program);
+}
+
+void NullRenderDevice::attachShader(GLuint program, GLuint shader) {
+    record("attachShader", program, shader);
+}
+
+void NullRenderDevice::bindAttribLocation(GLuint program, GLuint index, const GLchar* name) {
+    record("bindAttribLocation", program, index);
+    locations[std::make_pair(program, std::string(name))] = static_cast<GLint>(index);
+}
+
+void NullRenderDevice::linkProgram(GLuint program) {
+    record("linkProgram", program);
+}
+
+void NullRenderDevice::getProgramiv(GLuint program, GLenum pname, GLint* params) {
+    record("getProgramiv", program, pname);
+    params[0] = (pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+}
+
+void NullRenderDevice::getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    record("getProgramInfoLog", program);
+    if (length) *length = 0;
+    if (infoLog && bufSize > 0) infoLog[0] = '\0';
+}
+
+void NullRenderDevice::useProgram(GLuint program) {
+    record("useProgram", program);
+    changeState(currentProgram, program);
+}
+
+GLint NullRenderDevice::getUniformLocation(GLuint program, const GLchar* name) {
+    std::pair<GLuint, std::string> key(program, name);
+    auto it = locations.find(key);
+    GLint location = (it != locations.end()) ? it->second : (locations[key] = nextLocation[program]++);
+    record("getUniformLocation", program, static_cast<uint32_t>(location));
+    return location;
+}
+
+GLint NullRenderDevice::getAttribLocation(GLuint program, const GLchar* name) {
+    return getUniformLocation(program, name);
+}
+
+void NullRenderDevice::uniform1i(GLint location, GLint value) {
+    record("uniform1i", static_cast<uint32_t>(location), static_cast<uint32_t>(value));
+    uploadUniform(location, sizeof(GLint));
+}
+
+void NullRenderDevice::uniform1f(GLint location, GLfloat value) {
+    (void)value;
+    record("uniform1f", static_cast<uint32_t>(location));
+    uploadUniform(location, sizeof(GLfloat));
+}
+
+void NullRenderDevice::uniform2fv(GLint location, GLsizei count, const GLfloat* value) {
+    (void)value;
+    record("uniform2fv", static_cast<uint32_t>(location), static_cast<uint32_t>(count));
+    uploadUniform(location, sizeof(GLfloat) * 2 * count);
+}
+
+void NullRenderDevice::uniform3fv(GLint location, GLsizei count, const GLfloat* value) {
+    (void)value;
+    record("uniform3fv", static_cast<uint32_t>(location), static_cast<uint32_t>(count));
+    uploadUniform(location, sizeof(GLfloat) * 3 * count);
+}
+
+void NullRenderDevice::uniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+    (void)value;
+    record("uniform4fv", static_cast<uint32_t>(location), static_cast<uint32_t>(count));
+    uploadUniform(location, sizeof(GLfloat) * 4 * count);
+}
+
+void NullRenderDevice::uniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    (void)transpose;
+    (void)value;
+    record("uniformMatrix3fv", static_cast<uint32_t>(location), static_cast<uint32_t>(count));
+    uploadUniform(location, sizeof(GLfloat) * 9 * count);
+}
+
+void NullRenderDevice::uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    (void)transpose;
+    (void)value;
+    record("uniformMatrix4fv", static_cast<uint32_t>(location), static_cast<uint32_t>(count));
+    uploadUniform(location, sizeof(GLfloat) * 16 * count);
+}
+
+} // namespace GameEngine
@@ -0,0 +1,294 @@
+#include "Rendering/ProxyRenderDevice.h"
+
+namespace GameEngine {
+
+// Called inside run(), i.e. on the render thread, where it is the backend
+static RenderDevice& device() {
+    return RenderDevice::getInstance();
+}
+
+void ProxyRenderDevice::enable(GLenum cap) {
+    run([&]() { device().enable(cap); });
+}
+
+void ProxyRenderDevice::disable(GLenum cap) {
+    run([&]() { device().disable(cap); });
+}
+
+GLboolean ProxyRenderDevice::isEnabled(GLenum cap) {
+    GLboolean result = 0;
+    run([&]() { result = device().isEnabled(cap); });
+    return result;
+}
+
+void ProxyRenderDevice::getIntegerv(GLenum pname, GLint* data) {
+    run([&]() { device().getIntegerv(pname, data); });
+}
+
+void ProxyRenderDevice::getBooleanv(GLenum pname, GLboolean* data) {
+    run([&]() { device().getBooleanv(pname, data); });
+}
+
+void ProxyRenderDevice::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    run([&]() { device().viewport(x, y, width, height); });
+}
+
+void ProxyRenderDevice::clearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+    run([&]() { device().clearColor(r, g, b, a); });
+}
+
+void ProxyRenderDevice::clear(GLbitfield mask) {
+    run([&]() { device().clear(mask); });
+}
+
+void ProxyRenderDevice::cullFace(GLenum mode) {
+    run([&]() { device().cullFace(mode); });
+}
+
+void ProxyRenderDevice::depthFunc(GLenum func) {
+    run([&]() { device().depthFunc(func); });
+}
+
+void ProxyRenderDevice::depthMask(GLboolean flag) {
+    run([&]() { device().depthMask(flag); });
+}
+
+void ProxyRenderDevice::polygonMode(GLenum face, GLenum mode) {
+    run([&]() { device().polygonMode(face, mode); });
+}
+
+void ProxyRenderDevice::blendFunc(GLenum sfactor, GLenum dfactor) {
+    run([&]() { device().blendFunc(sfactor, dfactor); });
+}
+
+void ProxyRenderDevice::pixelStorei(GLenum pname, GLint param) {
+    run([&]() { device().pixelStorei(pname, param); });
+}
+
+void ProxyRenderDevice::genBuffers(GLsizei n, GLuint* buffers) {
+    run([&]() { device().genBuffers(n, buffers); });
+}
+
+void ProxyRenderDevice::deleteBuffers(GLsizei n, const GLuint* buffers) {
+    run([&]() { device().deleteBuffers(n, buffers); });
+}
+
+void ProxyRenderDevice::bindBuffer(GLenum target, GLuint buffer) {
+    run([&]() { device().bindBuffer(target, buffer); });
+}
+
+void ProxyRenderDevice::bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    run([&]() { device().bufferData(target, size, data, usage); });
+}
+
+void ProxyRenderDevice::bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    run([&]() { device().bufferSubData(target, offset, size, data); });
+}
+
+void ProxyRenderDevice::genVertexArrays(GLsizei n, GLuint* arrays) {
+    run([&]() { device().genVertexArrays(n, arrays); });
+}
+
+void ProxyRenderDevice::deleteVertexArrays(GLsizei n, const GLuint* arrays) {
+    run([&]() { device().deleteVertexArrays(n, arrays); });
+}
+
+void ProxyRenderDevice::bindVertexArray(GLuint array) {
+    run([&]() { device().bindVertexArray(array); });
+}
+
+void ProxyRenderDevice::enableVertexAttribArray(GLuint index) {
+    run([&]() { device().enableVertexAttribArray(index); });
+}
+
+void ProxyRenderDevice::disableVertexAttribArray(GLuint index) {
+    run([&]() { device().disableVertexAttribArray(index); });
+}
+
+void ProxyRenderDevice::vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                                            GLsizei stride, const void* pointer) {
+    run([&]() { device().vertexAttribPointer(index, size, type, normalized, stride, pointer); });
+}
+
+void ProxyRenderDevice::vertexAttrib4fv(GLuint index, const GLfloat* values) {
+    run([&]() { device().vertexAttrib4fv(index, values); });
+}
+
+void ProxyRenderDevice::drawArrays(GLenum mode, GLint first, GLsizei count) {
+    run([&]() { device().drawArrays(mode, first, count); });
+}
+
+void ProxyRenderDevice::drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    run([&]() { device().drawElements(mode, count, type, indices); });
+}
+
+void ProxyRenderDevice::activeTexture(GLenum unit) {
+    run([&]() { device().activeTexture(unit); });
+}
+
+void ProxyRenderDevice::genTextures(GLsizei n, GLuint* textures) {
+    run([&]() { device().genTextures(n, textures); });
+}
+
+void ProxyRenderDevice::deleteTextures(GLsizei n, const GLuint* textures) {
+    run([&]() { device().deleteTextures(n, textures); });
+}
+
+void ProxyRenderDevice::bindTexture(GLenum target, GLuint texture) {
+    run([&]() { device().bindTexture(target, texture); });
+}
+
+void ProxyRenderDevice::texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width,
+                                   GLsizei height, GLint border, GLenum format, GLenum type,
+                                   const void* pixels) {
+    run([&]() { device().texImage2D(target, level, internalFormat, width, height, border, format, type, pixels); });
+}
+
+void ProxyRenderDevice::texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                                      GLsizei height, GLenum format, GLenum type, const void* pixels) {
+    run([&]() { device().texSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels); });
+}
+
+void ProxyRenderDevice::compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width,
+                                             GLsizei height, GLint border, GLsizei imageSize,
+                                             const void* data) {
+    run([&]() {
+        device().compressedTexImage2D(target, level, internalFormat, width, height, border, imageSize, data);
+    });
+}
+
+void ProxyRenderDevice::texParameteri(GLenum target, GLenum pname, GLint param) {
+    run([&]() { device().texParameteri(target, pname, param); });
+}
+
+void ProxyRenderDevice::generateMipmap(GLenum target) {
+    run([&]() { device().generateMipmap(target); });
+}
+
+void ProxyRenderDevice::genFramebuffers(GLsizei n, GLuint* framebuffers) {
+    run([&]() { device().genFramebuffers(n, framebuffers); });
+}
+
+void ProxyRenderDevice::deleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+    run([&]() { device().deleteFramebuffers(n, framebuffers); });
+}
+
+void ProxyRenderDevice::bindFramebuffer(GLenum target, GLuint framebuffer) {
+    run([&]() { device().bindFramebuffer(target, framebuffer); });
+}
+
+void ProxyRenderDevice::framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget,
+                                             GLuint texture, GLint level) {
+    run([&]() { device().framebufferTexture2D(target, attachment, textarget, texture, level); });
+}
+
+GLenum ProxyRenderDevice::checkFramebufferStatus(GLenum target) {
+    GLenum result = 0;
+    run([&]() { result = device().checkFramebufferStatus(target); });
+    return result;
+}
+
+GLuint ProxyRenderDevice::createShader(GLenum type) {
+    GLuint result = 0;
+    run([&]() { result = device().createShader(type); });
+    return result;
+}
+
+void ProxyRenderDevice::deleteShader(GLuint shader) {
+    run([&]() { device().deleteShader(shader); });
+}
+
+void ProxyRenderDevice::shaderSource(GLuint shader, GLsizei count, const GLchar* const* source,
+                                     const GLint* length) {
+    run([&]() { device().shaderSource(shader, count, source, length); });
+}
+
+void ProxyRenderDevice::compileShader(GLuint shader) {
+    run([&]() { device().compileShader(shader); });
+}
+
+void ProxyRenderDevice::getShaderiv(GLuint shader, GLenum pname, GLint* params) {
+    run([&]() { device().getShaderiv(shader, pname, params); });
+}
+
+void ProxyRenderDevice::getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    run([&]() { device().getShaderInfoLog(shader, bufSize, length, infoLog); });
+}
+
+GLuint ProxyRenderDevice::createProgram() {
+    GLuint result = 0;
+    run([&]() { result = device().createProgram(); });
+    return result;
+}
+
+void ProxyRenderDevice::deleteProgram(GLuint program) {
+    run([&]() { device().deleteProgram(program); });
+}
+
+void ProxyRenderDevice::attachShader(GLuint program, GLuint shader) {
+    run([&]() { device().attachShader(program, shader); });
+}
+
+void ProxyRenderDevice::bindAttribLocation(GLuint program, GLuint index, const GLchar* name) {
+    run([&]() { device().bindAttribLocation(program, index, name); });
+}
+
+void ProxyRenderDevice::linkProgram(GLuint program) {
+    run([&]() { device().linkProgram(program); });
+}
+
+void ProxyRenderDevice::getProgramiv(GLuint program, GLenum pname, GLint* params) {
+    run([&]() { device().getProgramiv(program, pname, params); });
+}
+
+void ProxyRenderDevice::getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    run([&]() { device().getProgramInfoLog(program, bufSize, length, infoLog); });
+}
+
+void ProxyRenderDevice::useProgram(GLuint program) {
+    run([&]() { device().useProgram(program); });
+}
+
+GLint ProxyRenderDevice::getUniformLocation(GLuint program, const GLchar* name) {
+    GLint result = 0;
+    run([&]() { result = device().getUniformLocation(program, name); });
+    return result;
+}
+
+GLint ProxyRenderDevice::getAttribLocation(GLuint program, const GLchar* name) {
+    GLint result = 0;
+    run([&]() { result = device().getAttribLocation(program, name); });
+    return result;
+}
+
+void ProxyRenderDevice::uniform1i(GLint location, GLint value) {
+    run([&]() { device().uniform1i(location, value); });
+}
+
+void ProxyRenderDevice::uniform1f(GLint location, GLfloat value) {
+    run([&]() { device().uniform1f(location, value); });
+}
+
+void ProxyRenderDevice::uniform2fv(GLint location, GLsizei count, const GLfloat* value) {
+    run([&]() { device().uniform2fv(location, count, value); });
+}
+
+void ProxyRenderDevice::uniform3fv(GLint location, GLsizei count, const GLfloat* value) {
+    run([&]() { device().uniform3fv(location, count, value); });
+}
+
+void ProxyRenderDevice::uniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+    run([&]() { device().uniform4fv(location, count, value); });
+}
+
+void ProxyRenderDevice::uniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose,
+                                         const GLfloat* value) {
+    run([&]() { device().uniformMatrix3fv(location, count, transpose, value); });
+}
+
+void ProxyRenderDevice::uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose,
+                                         const GLfloat* value) {
+    run([&]() { device().uniformMatrix4fv(location, count, transpose, value); });
+}
+
+} // namespace GameEngine
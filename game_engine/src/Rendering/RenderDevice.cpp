@@ -0,0 +1,180 @@
+#include "Rendering/RenderDevice.h"
+#include "Rendering/NullRenderDevice.h"
+#include <cstdlib>
+#include <iostream>
+
+namespace GameEngine {
+
+RenderBackend RenderDevice::backend = RenderBackend::OPENGL;
+
+namespace {
+
+thread_local RenderDevice* threadDevice = nullptr;
+
+} // namespace
+
+RenderDevice& RenderDevice::getInstance() {
+    if (threadDevice) {
+        return *threadDevice;
+    }
+    // Never destroyed: textures and meshes held by other singletons release
+    // their GL names during static destruction
+    static GLRenderDevice* glDevice = new GLRenderDevice();
+    static NullRenderDevice* nullDevice = new NullRenderDevice();
+    if (backend == RenderBackend::NULL_DEVICE) {
+        return *nullDevice;
+    }
+    return *glDevice;
+}
+
+void RenderDevice::setThreadDevice(RenderDevice* device) {
+    threadDevice = device;
+}
+
+void RenderDevice::setBackend(RenderBackend newBackend) {
+    backend = newBackend;
+}
+
+bool RenderDevice::parseBackend(const std::string& name, RenderBackend& result) {
+    if (name == "gl" || name == "opengl") {
+        result = RenderBackend::OPENGL;
+    } else if (name == "software" || name == "llvmpipe" || name == "osmesa") {
+        result = RenderBackend::SOFTWARE;
+    } else if (name == "null") {
+        result = RenderBackend::NULL_DEVICE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool RenderDevice::selectBackendFromEnvironment() {
+#ifdef LINUX_BUILD
+    const char* name = getenv("GAME_ENGINE_RENDER_BACKEND");
+    if (!name || !*name) {
+        return true;
+    }
+    RenderBackend selected;
+    if (!parseBackend(name, selected)) {
+        std::cerr << "RenderDevice: Unknown GAME_ENGINE_RENDER_BACKEND '" << name << "' (gl, software or null)" << std::endl;
+        return false;
+    }
+    setBackend(selected);
+#endif
+    return true;
+}
+
+const char* RenderDevice::getBackendName(RenderBackend backend) {
+    switch (backend) {
+        case RenderBackend::OPENGL: return "gl";
+        case RenderBackend::SOFTWARE: return "software";
+        case RenderBackend::NULL_DEVICE: return "null";
+    }
+    return "unknown";
+}
+
+void GLRenderDevice::enable(GLenum cap) { glEnable(cap); }
+void GLRenderDevice::disable(GLenum cap) { glDisable(cap); }
+GLboolean GLRenderDevice::isEnabled(GLenum cap) { return glIsEnabled(cap); }
+void GLRenderDevice::getIntegerv(GLenum pname, GLint* data) { glGetIntegerv(pname, data); }
+void GLRenderDevice::getBooleanv(GLenum pname, GLboolean* data) { glGetBooleanv(pname, data); }
+void GLRenderDevice::viewport(GLint x, GLint y, GLsizei width, GLsizei height) { glViewport(x, y, width, height); }
+void GLRenderDevice::clearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) { glClearColor(r, g, b, a); }
+void GLRenderDevice::clear(GLbitfield mask) { glClear(mask); }
+void GLRenderDevice::cullFace(GLenum mode) { glCullFace(mode); }
+void GLRenderDevice::depthFunc(GLenum func) { glDepthFunc(func); }
+void GLRenderDevice::depthMask(GLboolean flag) { glDepthMask(flag); }
+void GLRenderDevice::polygonMode(GLenum face, GLenum mode) { glPolygonMode(face, mode); }
+void GLRenderDevice::blendFunc(GLenum sfactor, GLenum dfactor) { glBlendFunc(sfactor, dfactor); }
+void GLRenderDevice::pixelStorei(GLenum pname, GLint param) { glPixelStorei(pname, param); }
+
+void GLRenderDevice::genBuffers(GLsizei n, GLuint* buffers) { glGenBuffers(n, buffers); }
+void GLRenderDevice::deleteBuffers(GLsizei n, const GLuint* buffers) { glDeleteBuffers(n, buffers); }
+void GLRenderDevice::bindBuffer(GLenum target, GLuint buffer) { glBindBuffer(target, buffer); }
+void GLRenderDevice::bufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    glBufferData(target, size, data, usage);
+}
+void GLRenderDevice::bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    glBufferSubData(target, offset, size, data);
+}
+void GLRenderDevice::genVertexArrays(GLsizei n, GLuint* arrays) { glGenVertexArrays(n, arrays); }
+void GLRenderDevice::deleteVertexArrays(GLsizei n, const GLuint* arrays) { glDeleteVertexArrays(n, arrays); }
+void GLRenderDevice::bindVertexArray(GLuint array) { glBindVertexArray(array); }
+void GLRenderDevice::enableVertexAttribArray(GLuint index) { glEnableVertexAttribArray(index); }
+void GLRenderDevice::disableVertexAttribArray(GLuint index) { glDisableVertexAttribArray(index); }
+void GLRenderDevice::vertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                                         GLsizei stride, const void* pointer) {
+    glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+}
+void GLRenderDevice::vertexAttrib4fv(GLuint index, const GLfloat* values) { glVertexAttrib4fv(index, values); }
+
+void GLRenderDevice::drawArrays(GLenum mode, GLint first, GLsizei count) { glDrawArrays(mode, first, count); }
+void GLRenderDevice::drawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    glDrawElements(mode, count, type, indices);
+}
+
+void GLRenderDevice::activeTexture(GLenum unit) { glActiveTexture(unit); }
+void GLRenderDevice::genTextures(GLsizei n, GLuint* textures) { glGenTextures(n, textures); }
+void GLRenderDevice::deleteTextures(GLsizei n, const GLuint* textures) { glDeleteTextures(n, textures); }
+void GLRenderDevice::bindTexture(GLenum target, GLuint texture) { glBindTexture(target, texture); }
+void GLRenderDevice::texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                                GLint border, GLenum format, GLenum type, const void* pixels) {
+    glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+}
+void GLRenderDevice::texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                                   GLsizei height, GLenum format, GLenum type, const void* pixels) {
+    glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+void GLRenderDevice::compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width,
+                                          GLsizei height, GLint border, GLsizei imageSize, const void* data) {
+    glCompressedTexImage2D(target, level, internalFormat, width, height, border, imageSize, data);
+}
+void GLRenderDevice::texParameteri(GLenum target, GLenum pname, GLint param) { glTexParameteri(target, pname, param); }
+void GLRenderDevice::generateMipmap(GLenum target) { glGenerateMipmap(target); }
+
+void GLRenderDevice::genFramebuffers(GLsizei n, GLuint* framebuffers) { glGenFramebuffers(n, framebuffers); }
+void GLRenderDevice::deleteFramebuffers(GLsizei n, const GLuint* framebuffers) { glDeleteFramebuffers(n, framebuffers); }
+void GLRenderDevice::bindFramebuffer(GLenum target, GLuint framebuffer) { glBindFramebuffer(target, framebuffer); }
+void GLRenderDevice::framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget,
+                                          GLuint texture, GLint level) {
+    glFramebufferTexture2D(target, attachment, textarget, texture, level);
+}
+GLenum GLRenderDevice::checkFramebufferStatus(GLenum target) { return glCheckFramebufferStatus(target); }
+
+GLuint GLRenderDevice::createShader(GLenum type) { return glCreateShader(type); }
+void GLRenderDevice::deleteShader(GLuint shader) { glDeleteShader(shader); }
+void GLRenderDevice::shaderSource(GLuint shader, GLsizei count, const GLchar* const* source, const GLint* length) {
+    glShaderSource(shader, count, source, length);
+}
+void GLRenderDevice::compileShader(GLuint shader) { glCompileShader(shader); }
+void GLRenderDevice::getShaderiv(GLuint shader, GLenum pname, GLint* params) { glGetShaderiv(shader, pname, params); }
+void GLRenderDevice::getShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    glGetShaderInfoLog(shader, bufSize, length, infoLog);
+}
+GLuint GLRenderDevice::createProgram() { return glCreateProgram(); }
+void GLRenderDevice::deleteProgram(GLuint program) { glDeleteProgram(program); }
+void GLRenderDevice::attachShader(GLuint program, GLuint shader) { glAttachShader(program, shader); }
+void GLRenderDevice::bindAttribLocation(GLuint program, GLuint index, const GLchar* name) {
+    glBindAttribLocation(program, index, name);
+}
+void GLRenderDevice::linkProgram(GLuint program) { glLinkProgram(program); }
+void GLRenderDevice::getProgramiv(GLuint program, GLenum pname, GLint* params) { glGetProgramiv(program, pname, params); }
+void GLRenderDevice::getProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    glGetProgramInfoLog(program, bufSize, length, infoLog);
+}
+void GLRenderDevice::useProgram(GLuint program) { glUseProgram(program); }
+GLint GLRenderDevice::getUniformLocation(GLuint program, const GLchar* name) { return glGetUniformLocation(program, name); }
+GLint GLRenderDevice::getAttribLocation(GLuint program, const GLchar* name) { return glGetAttribLocation(program, name); }
+void GLRenderDevice::uniform1i(GLint location, GLint value) { glUniform1i(location, value); }
+void GLRenderDevice::uniform1f(GLint location, GLfloat value) { glUniform1f(location, value); }
+void GLRenderDevice::uniform2fv(GLint location, GLsizei count, const GLfloat* value) { glUniform2fv(location, count, value); }
+void GLRenderDevice::uniform3fv(GLint location, GLsizei count, const GLfloat* value) { glUniform3fv(location, count, value); }
+void GLRenderDevice::uniform4fv(GLint location, GLsizei count, const GLfloat* value) { glUniform4fv(location, count, value); }
+void GLRenderDevice::uniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    glUniformMatrix3fv(location, count, transpose, value);
+}
+void GLRenderDevice::uniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    glUniformMatrix4fv(location, count, transpose, value);
+}
+
+} // namespace GameEngine
@@ -9,24 +9,23 @@
 #include "Rendering/Shader.h"
 #include "Rendering/Texture.h"
 #include "Rendering/LightingManager.h"
+#include "Rendering/TextRenderer.h"
+#include "Rendering/RenderDevice.h"
+#include "Core/Profiler.h"
+#include "Core/Stats.h"
 #include <algorithm>
-#include <iostream>
-#include <iomanip>
 #include <limits>
 
 namespace GameEngine {
 
 Renderer::Renderer()
     : activeCamera(nullptr)
-    , currentScene(nullptr)
     , viewport(0, 0, 800, 600)
     , clearColor(0.2f, 0.3f, 0.3f)
     , wireframeEnabled(false)
     , depthTestEnabled(true)
     , cullFaceEnabled(true)  // Enabled by default for better performance
     , frustumCullingEnabled(true)  // Enabled by default, but can be disabled for debugging
-    , matricesCached(false)
-    , frustumPlanes(6)
 {
 }
 
@@ -35,24 +34,26 @@ Renderer::~Renderer() {
 }
 
 bool Renderer::initialize() {
+    auto& device = RenderDevice::getInstance();
     if (depthTestEnabled) {
-        glEnable(GL_DEPTH_TEST);
+        device.enable(GL_DEPTH_TEST);
     }
     
     if (cullFaceEnabled) {
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
+        device.enable(GL_CULL_FACE);
+        device.cullFace(GL_BACK);
     }
     
     return true;
 }
 
 void Renderer::shutdown() {
+    TextRenderer::getInstance().shutdown();
 }
 
 void Renderer::beginFrame() {
     stats.reset();
-    renderQueue.clear();
+    frame.clear();
 }
 
 void Renderer::endFrame() {
@@ -64,44 +65,49 @@ void Renderer::present() {
 }
 
 void Renderer::renderScene(Scene& scene) {
-    currentScene = &scene;
+    PROFILE_ZONE("Renderer::renderScene");
+    captureScene(scene);
+    submitScene();
+}
+
+void Renderer::captureScene(Scene& scene) {
+    PROFILE_ZONE("Renderer::captureScene");
     setupCamera();
     
-    if (activeCamera) {
-        updateFrustum();
-    }
-    
-    renderQueue.clear();
+    frame.commands.clear();
+    frame.materials.clear();
+    frame.materialIndices.clear();
     
     if (scene.getRootNode()) {
+        PROFILE_ZONE("Renderer::renderNodes");
         renderNode(*scene.getRootNode(), glm::mat4(1.0f));
     }
     
+    captureSkybox(scene);
+    LightingManager::getInstance().captureLights();
+    frame.sceneCaptured = true;
+}
+
+void Renderer::submitScene() {
+    if (!frame.sceneCaptured) {
+        return;
+    }
+    PROFILE_ZONE("Renderer::submitScene");
     processRenderQueue();
     
-    renderSkybox(scene);
+    renderSkybox();
     
-    currentScene = nullptr;
+    // Text queued by renderNode goes out last, one draw per atlas page
+    renderText();
+    frame.sceneCaptured = false;
     
-    static int frameCount = 0;
-    frameCount++;
-    if (frameCount % 60 == 0) {
-        float cullPercent = 0.0f;
-        if (stats.totalObjectsTested > 0) {
-            cullPercent = (stats.culledObjects * 100.0f) / stats.totalObjectsTested;
-        }
-        
-        std::cout << "Render Stats - Draw calls: " << stats.drawCalls 
-                  << ", Triangles: " << stats.triangles;
-        
-        if (frustumCullingEnabled && stats.totalObjectsTested > 0) {
-            std::cout << ", Frustum culled: " << stats.culledObjects 
-                      << "/" << stats.totalObjectsTested 
-                      << " (" << std::fixed << std::setprecision(1) << cullPercent << "%)";
-        }
-        
-        std::cout << std::endl;
-    }
+    // Totals so far this frame (stats reset in beginFrame)
+    static Stat& drawCalls = Stats::getInstance().getGauge("Draw calls");
+    static Stat& triangles = Stats::getInstance().getGauge("Triangles");
+    static Stat& culledObjects = Stats::getInstance().getGauge("Culled objects");
+    drawCalls.set(stats.drawCalls);
+    triangles.set(stats.triangles);
+    culledObjects.set(stats.culledObjects);
 }
 
 void Renderer::renderNode(SceneNode& node, const glm::mat4& parentTransform) {
@@ -145,7 +151,25 @@ void Renderer::renderMesh(const Mesh& mesh, const Material& material, const glm:
 }
 
 void Renderer::submitRenderCommand(const RenderCommand& command) {
-    renderQueue.push_back(command);
+    frame.commands.push_back(command);
+    frame.commands.back().materialIndex = captureMaterial(command.material ? *command.material : *Material::getDefaultMaterial());
+}
+
+// Commands are queued while the simulation is idle, so this is the last
+// safe moment to read the material
+uint32_t Renderer::captureMaterial(const Material& material) {
+    auto it = frame.materialIndices.find(&material);
+    if (it != frame.materialIndices.end()) {
+        return it->second;
+    }
+    
+    uint32_t index = static_cast<uint32_t>(frame.materials.size());
+    frame.materials.push_back(material.getUniforms());
+    if (!frame.materials.back().shader) {
+        frame.materials.back().shader = Shader::getLightingShader();
+    }
+    frame.materialIndices[&material] = index;
+    return index;
 }
 
 void Renderer::setActiveCamera(CameraComponent* camera) {
@@ -153,8 +177,9 @@ void Renderer::setActiveCamera(CameraComponent* camera) {
 }
 
 void Renderer::setViewport(int x, int y, int width, int height) {
+    auto& device = RenderDevice::getInstance();
     viewport = glm::ivec4(x, y, width, height);
-    glViewport(x, y, width, height);
+    device.viewport(x, y, width, height);
     
     if (activeCamera && width > 0 && height > 0) {
         activeCamera->setAspectRatio((float)width / (float)height);
@@ -162,8 +187,9 @@ void Renderer::setViewport(int x, int y, int width, int height) {
 }
 
 void Renderer::setClearColor(const glm::vec3& color) {
+    auto& device = RenderDevice::getInstance();
     clearColor = color;
-    glClearColor(color.r, color.g, color.b, 1.0f);
+    device.clearColor(color.r, color.g, color.b, 1.0f);
 }
 
 void Renderer::setClearColor(float r, float g, float b) {
@@ -171,66 +197,93 @@ void Renderer::setClearColor(float r, float g, float b) {
 }
 
 void Renderer::clear() {
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    auto& device = RenderDevice::getInstance();
+    device.clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
 void Renderer::setWireframe(bool enabled) {
+    auto& device = RenderDevice::getInstance();
     wireframeEnabled = enabled;
     if (enabled) {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        device.polygonMode(GL_FRONT_AND_BACK, GL_LINE);
     } else {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        device.polygonMode(GL_FRONT_AND_BACK, GL_FILL);
     }
 }
 
 void Renderer::setDepthTest(bool enabled) {
+    auto& device = RenderDevice::getInstance();
     depthTestEnabled = enabled;
     if (enabled) {
-        glEnable(GL_DEPTH_TEST);
+        device.enable(GL_DEPTH_TEST);
     } else {
-        glDisable(GL_DEPTH_TEST);
+        device.disable(GL_DEPTH_TEST);
     }
 }
 
 void Renderer::setCullFace(bool enabled) {
+    auto& device = RenderDevice::getInstance();
     cullFaceEnabled = enabled;
     if (enabled) {
-        glEnable(GL_CULL_FACE);
+        device.enable(GL_CULL_FACE);
     } else {
-        glDisable(GL_CULL_FACE);
+        device.disable(GL_CULL_FACE);
     }
 }
 
 void Renderer::processRenderQueue() {
-    std::sort(renderQueue.begin(), renderQueue.end(), 
-        [](const RenderCommand& a, const RenderCommand& b) {
+    PROFILE_ZONE("Renderer::processRenderQueue");
+    auto& device = RenderDevice::getInstance();
+    const std::vector<MaterialUniforms>& materials = frame.materials;
+    std::sort(frame.commands.begin(), frame.commands.end(), 
+        [&materials](const RenderCommand& a, const RenderCommand& b) {
             if (!a.material && !b.material) return false;
             if (!a.material) return false;
             if (!b.material) return true;
             
-            auto shaderA = a.material->getShader();
-            auto shaderB = b.material->getShader();
+            const auto& shaderA = materials[a.materialIndex].shader;
+            const auto& shaderB = materials[b.materialIndex].shader;
             
-            if (shaderA != shaderB) {
-                return shaderA.get() < shaderB.get();
+            // Program names and material ids rather than pointers, so the
+            // draw order (and a recorded command stream) is the same every run
+            GLuint programA = shaderA ? shaderA->getProgram() : 0;
+            GLuint programB = shaderB ? shaderB->getProgram() : 0;
+            if (programA != programB) {
+                return programA < programB;
             }
             
-            return a.material.get() < b.material.get();
+            return a.material->getSortId() < b.material->getSortId();
         });
     
-    glm::vec3 cameraPos(0.0f);
-    if (activeCamera) {
-        cachedViewMatrix = activeCamera->getViewMatrix();
-        cachedProjectionMatrix = activeCamera->getProjectionMatrix();
-        cameraPos = extractCameraPosition(cachedViewMatrix);
-        matricesCached = true;
-        
+    // Commands queued outside renderScene still need this frame's camera
+    if (!frame.cameraCaptured) {
+        setupCamera();
     }
     
-    for (const auto& command : renderQueue) {
+    // Per-frame uniforms go into this frame's copies; the Materials are left alone
+    for (MaterialUniforms& uniforms : frame.materials) {
+        if (frame.cameraValid) {
+            uniforms.vec3Properties["u_CameraPos"] = frame.camera.position;
+        }
+        if (frame.sceneCaptured) {
+            if (frame.environmentMap) {
+                uniforms.textureProperties["u_EnvironmentMap"] = frame.environmentMap;
+            }
+            uniforms.boolProperties["u_HasEnvironmentMap"] = frame.environmentMap != nullptr;
+        }
+    }
+    
+    auto& lightingManager = LightingManager::getInstance();
+    
+    if (frame.cameraValid) {
+        lightingManager.buildClusters(frame.camera.view, frame.camera.projection,
+                                      frame.camera.nearPlane, frame.camera.farPlane);
+    }
+    
+    for (const auto& command : frame.commands) {
         if (!command.mesh) continue;
         
-        if (frustumCullingEnabled && activeCamera && frustumPlanes.size() == 6) {
+        if (frustumCullingEnabled && frame.cameraValid) {
             glm::vec3 boundsMin = command.mesh->getBoundsMin();
             glm::vec3 boundsMax = command.mesh->getBoundsMax();
             
@@ -246,57 +299,32 @@ void Renderer::processRenderQueue() {
             
             if (boundsValid) {
                 stats.totalObjectsTested++;
-                if (!isAABBInFrustum(boundsMin, boundsMax, command.modelMatrix)) {
+                if (!frame.camera.isAABBVisible(boundsMin, boundsMax, command.modelMatrix)) {
                     stats.culledObjects++;
                     continue;
                 }
             }
         }
         
-        std::shared_ptr<Material> material = command.material;
-        if (!material) {
-            material = Material::getDefaultMaterial();
-        }
+        const MaterialUniforms& material = frame.materials[command.materialIndex];
         
         bool shouldDisableCulling = command.disableCulling;
         
         bool cullingWasEnabled = cullFaceEnabled;
         if (shouldDisableCulling && cullFaceEnabled) {
-            glDisable(GL_CULL_FACE);
+            device.disable(GL_CULL_FACE);
         }
         
-        if (activeCamera && matricesCached) {
-            material->setCameraPosition(cameraPos);
-        }
-        
-        if (currentScene) {
-            auto activeSkyboxNode = currentScene->getActiveSkybox();
-            if (activeSkyboxNode) {
-                auto skyboxComp = activeSkyboxNode->getComponent<SkyboxComponent>();
-                if (skyboxComp && skyboxComp->isActive()) {
-                    auto envMap = skyboxComp->getCubemapTexture();
-                    if (envMap) {
-                        material->setTexture("u_EnvironmentMap", envMap);
-                        material->setBool("u_HasEnvironmentMap", true);
-                    } else {
-                        material->setBool("u_HasEnvironmentMap", false);
-                    }
-                } else {
-                    material->setBool("u_HasEnvironmentMap", false);
-                }
-            } else {
-                material->setBool("u_HasEnvironmentMap", false);
-            }
-        }
-        
-        applyMaterial(*material);
+        // Only the lights whose clusters overlap the mesh bounds reach the shader
+        lightingManager.selectLightsForBounds(command.mesh->getBoundsMin(), command.mesh->getBoundsMax(), command.modelMatrix);
+        Material::applyUniforms(material);
         
-        auto shader = material->getShader();
-        if (shader && activeCamera && matricesCached) {
+        const auto& shader = material.shader;
+        if (shader && frame.cameraValid) {
             shader->setMat4("modelMatrix", command.modelMatrix);
             shader->setMat3("normalMatrix", command.normalMatrix);
-            shader->setMat4("viewMatrix", cachedViewMatrix);
-            shader->setMat4("projectionMatrix", cachedProjectionMatrix);
+            shader->setMat4("viewMatrix", frame.camera.view);
+            shader->setMat4("projectionMatrix", frame.camera.projection);
             
             if (!command.boneTransforms.empty()) {
                 shader->setMat4Array("u_BoneMatrices", command.boneTransforms.data(), command.boneTransforms.size());
@@ -309,7 +337,7 @@ void Renderer::processRenderQueue() {
         command.mesh->draw();
         
         if (shouldDisableCulling && cullingWasEnabled) {
-            glEnable(GL_CULL_FACE);
+            device.enable(GL_CULL_FACE);
         }
         
         stats.drawCalls++;
@@ -317,15 +345,39 @@ void Renderer::processRenderQueue() {
         stats.vertices += command.mesh->getVertexCount();
     }
     
-    matricesCached = false;
+    lightingManager.clearSelection();
+    
+    // Commands are consumed so endFrame() does not draw the scene a second time
+    frame.commands.clear();
+    frame.materials.clear();
+    frame.materialIndices.clear();
 }
 
 void Renderer::setupCamera() {
-    if (!activeCamera) return;
+    frame.cameraCaptured = true;
+    frame.cameraValid = (activeCamera != nullptr);
+    if (frame.cameraValid) {
+        frame.camera = activeCamera->getSnapshot();
+    }
 }
 
-void Renderer::applyMaterial(const Material& material) {
-    material.apply();
+void Renderer::captureSkybox(Scene& scene) {
+    frame.environmentMap.reset();
+    frame.skyboxMesh.reset();
+    frame.skyboxMaterial = MaterialUniforms();
+    
+    auto activeSkyboxNode = scene.getActiveSkybox();
+    if (!activeSkyboxNode) return;
+    
+    auto skyboxComp = activeSkyboxNode->getComponent<SkyboxComponent>();
+    if (!skyboxComp || !skyboxComp->isActive()) return;
+    
+    frame.environmentMap = skyboxComp->getCubemapTexture();
+    frame.skyboxMesh = skyboxComp->getSkyboxMesh();
+    // SkyboxComponent::setTextures may edit the material during the next simulation
+    if (auto material = skyboxComp->getSkyboxMaterial()) {
+        frame.skyboxMaterial = material->getUniforms();
+    }
 }
 
 void Renderer::updateLightingUniforms() {
@@ -333,149 +385,46 @@ void Renderer::updateLightingUniforms() {
     lightingManager.update();
 }
 
-glm::vec3 Renderer::extractCameraPosition(const glm::mat4& viewMatrix) {
-    glm::mat4 invView = glm::inverse(viewMatrix);
-    return glm::vec3(invView[3]);
-}
-
-void Renderer::updateFrustum() {
-    if (!activeCamera) {
-        frustumPlanes.clear();
+void Renderer::renderText() {
+    PROFILE_ZONE("Renderer::renderText");
+    auto& textRenderer = TextRenderer::getInstance();
+    if (!frame.cameraValid) {
+        textRenderer.discard();
         return;
     }
     
-    glm::mat4 viewMatrix = activeCamera->getViewMatrix();
-    glm::mat4 projMatrix = activeCamera->getProjectionMatrix();
-    
-    glm::mat4 viewProj = projMatrix * viewMatrix;
-    
-    frustumPlanes[0].normal.x = viewProj[0][3] + viewProj[0][0];
-    frustumPlanes[0].normal.y = viewProj[1][3] + viewProj[1][0];
-    frustumPlanes[0].normal.z = viewProj[2][3] + viewProj[2][0];
-    frustumPlanes[0].distance = viewProj[3][3] + viewProj[3][0];
-    
-    frustumPlanes[1].normal.x = viewProj[0][3] - viewProj[0][0];
-    frustumPlanes[1].normal.y = viewProj[1][3] - viewProj[1][0];
-    frustumPlanes[1].normal.z = viewProj[2][3] - viewProj[2][0];
-    frustumPlanes[1].distance = viewProj[3][3] - viewProj[3][0];
-    
-    frustumPlanes[2].normal.x = viewProj[0][3] + viewProj[0][1];
-    frustumPlanes[2].normal.y = viewProj[1][3] + viewProj[1][1];
-    frustumPlanes[2].normal.z = viewProj[2][3] + viewProj[2][1];
-    frustumPlanes[2].distance = viewProj[3][3] + viewProj[3][1];
-    
-    frustumPlanes[3].normal.x = viewProj[0][3] - viewProj[0][1];
-    frustumPlanes[3].normal.y = viewProj[1][3] - viewProj[1][1];
-    frustumPlanes[3].normal.z = viewProj[2][3] - viewProj[2][1];
-    frustumPlanes[3].distance = viewProj[3][3] - viewProj[3][1];
-    
-    frustumPlanes[4].normal.x = viewProj[0][3] + viewProj[0][2];
-    frustumPlanes[4].normal.y = viewProj[1][3] + viewProj[1][2];
-    frustumPlanes[4].normal.z = viewProj[2][3] + viewProj[2][2];
-    frustumPlanes[4].distance = viewProj[3][3] + viewProj[3][2];
-    
-    frustumPlanes[5].normal.x = viewProj[0][3] - viewProj[0][2];
-    frustumPlanes[5].normal.y = viewProj[1][3] - viewProj[1][2];
-    frustumPlanes[5].normal.z = viewProj[2][3] - viewProj[2][2];
-    frustumPlanes[5].distance = viewProj[3][3] - viewProj[3][2];
-    
-    const float epsilon = 0.0001f;
-    for (auto& plane : frustumPlanes) {
-        float length = glm::length(plane.normal);
-        if (length > epsilon) {
-            plane.normal /= length;
-            plane.distance /= length;
-        }
-    }
-}
-
-bool Renderer::isMeshInFrustum(const Mesh& mesh, const glm::mat4& modelMatrix) const {
-    if (frustumPlanes.empty() || frustumPlanes.size() != 6) {
-        return true;
-    }
-    
-    glm::vec3 boundsMin = mesh.getBoundsMin();
-    glm::vec3 boundsMax = mesh.getBoundsMax();
-    
-    if (boundsMin.x >= boundsMax.x || boundsMin.y >= boundsMax.y || boundsMin.z >= boundsMax.z) {
-        return true;
-    }
-    
-    return isAABBInFrustum(boundsMin, boundsMax, modelMatrix);
+    stats.drawCalls += textRenderer.flush(frame.camera.viewProjection, frame.camera.aspectRatio);
+    stats.triangles += textRenderer.getLastFlushStats().glyphs * 2;
 }
 
-bool Renderer::isAABBInFrustum(const glm::vec3& min, const glm::vec3& max, const glm::mat4& transform) const {
-    if (frustumPlanes.empty() || frustumPlanes.size() != 6) {
-        return true;
-    }
+void Renderer::renderSkybox() {
+    PROFILE_ZONE("Renderer::renderSkybox");
+    auto& device = RenderDevice::getInstance();
+    const auto& cubemapTexture = frame.environmentMap;
+    const auto& skyboxMesh = frame.skyboxMesh;
+    const auto& skyboxMaterial = frame.skyboxMaterial;
     
-    if (min.x >= max.x || min.y >= max.y || min.z >= max.z) {
-        return true;
-    }
-    
-    glm::vec3 corners[8];
-    corners[0] = glm::vec3(transform * glm::vec4(min.x, min.y, min.z, 1.0f));
-    corners[1] = glm::vec3(transform * glm::vec4(max.x, min.y, min.z, 1.0f));
-    corners[2] = glm::vec3(transform * glm::vec4(min.x, max.y, min.z, 1.0f));
-    corners[3] = glm::vec3(transform * glm::vec4(max.x, max.y, min.z, 1.0f));
-    corners[4] = glm::vec3(transform * glm::vec4(min.x, min.y, max.z, 1.0f));
-    corners[5] = glm::vec3(transform * glm::vec4(max.x, min.y, max.z, 1.0f));
-    corners[6] = glm::vec3(transform * glm::vec4(min.x, max.y, max.z, 1.0f));
-    corners[7] = glm::vec3(transform * glm::vec4(max.x, max.y, max.z, 1.0f));
-    
-    for (const auto& plane : frustumPlanes) {
-        bool inside = false;
-        
-        const float margin = -0.1f;
-        for (int i = 0; i < 8; i++) {
-            float distance = glm::dot(plane.normal, corners[i]) + plane.distance;
-            if (distance > margin) {
-                inside = true;
-                break;
-            }
-        }
-        
-        if (!inside) {
-            return false;
-        }
-    }
-    
-    return true;
-}
-
-void Renderer::renderSkybox(Scene& scene) {
-    auto activeSkyboxNode = scene.getActiveSkybox();
-    if (!activeSkyboxNode) return;
-    
-    auto skyboxComp = activeSkyboxNode->getComponent<SkyboxComponent>();
-    if (!skyboxComp || !skyboxComp->isActive()) return;
-    
-    auto cubemapTexture = skyboxComp->getCubemapTexture();
-    auto skyboxMesh = skyboxComp->getSkyboxMesh();
-    auto skyboxMaterial = skyboxComp->getSkyboxMaterial();
-    
-    if (!cubemapTexture || !skyboxMesh || !skyboxMaterial || !activeCamera) return;
+    if (!cubemapTexture || !skyboxMesh || !skyboxMaterial.shader || !frame.cameraValid) return;
     
     GLboolean depthMaskEnabled;
     GLint depthFunc;
-    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMaskEnabled);
-    glGetIntegerv(GL_DEPTH_FUNC, &depthFunc);
+    device.getBooleanv(GL_DEPTH_WRITEMASK, &depthMaskEnabled);
+    device.getIntegerv(GL_DEPTH_FUNC, &depthFunc);
     
-    glDepthMask(GL_FALSE);
-    glDepthFunc(GL_LEQUAL);
+    device.depthMask(GL_FALSE);
+    device.depthFunc(GL_LEQUAL);
     
     bool cullingWasEnabled = cullFaceEnabled;
     if (cullFaceEnabled) {
-        glDisable(GL_CULL_FACE);
+        device.disable(GL_CULL_FACE);
     }
     
-    glm::mat4 viewMatrix = glm::mat4(glm::mat3(activeCamera->getViewMatrix()));
-    
-    glm::mat4 projectionMatrix = activeCamera->getProjectionMatrix();
+    glm::mat4 viewMatrix = glm::mat4(glm::mat3(frame.camera.view));
+    const glm::mat4& projectionMatrix = frame.camera.projection;
     
-    skyboxMaterial->apply();
+    Material::applyUniforms(skyboxMaterial);
     
-    auto shader = skyboxMaterial->getShader();
+    const auto& shader = skyboxMaterial.shader;
     if (shader && shader->isValid()) {
         shader->use();
         shader->setMat4("view", viewMatrix);
@@ -489,11 +438,11 @@ void Renderer::renderSkybox(Scene& scene) {
     skyboxMesh->draw();
     skyboxMesh->unbind();
     
-    glDepthMask(depthMaskEnabled);
-    glDepthFunc(GL_LESS);
+    device.depthMask(depthMaskEnabled);
+    device.depthFunc(GL_LESS);
     
     if (cullingWasEnabled && cullFaceEnabled) {
-        glEnable(GL_CULL_FACE);
+        device.enable(GL_CULL_FACE);
     }
     
     stats.drawCalls++;
@@ -1,4 +1,5 @@
 #include "Rendering/Shader.h"
+#include "Rendering/RenderDevice.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -11,14 +12,15 @@ Shader::Shader()
 }
 
 Shader::~Shader() {
+    auto& device = RenderDevice::getInstance();
     if (program) {
-        glDeleteProgram(program);
+        device.deleteProgram(program);
     }
     if (vertexShader) {
-        glDeleteShader(vertexShader);
+        device.deleteShader(vertexShader);
     }
     if (fragmentShader) {
-        glDeleteShader(fragmentShader);
+        device.deleteShader(fragmentShader);
     }
 }
 
@@ -49,26 +51,30 @@ bool Shader::loadFromSource(const std::string& vertexSource, const std::string&
 }
 
 void Shader::use() const {
+    auto& device = RenderDevice::getInstance();
     if (program) {
-        glUseProgram(program);
+        device.useProgram(program);
     }
 }
 
 void Shader::unuse() const {
-    glUseProgram(0);
+    auto& device = RenderDevice::getInstance();
+    device.useProgram(0);
 }
 
 void Shader::setFloat(const std::string& name, float value) {
+    auto& device = RenderDevice::getInstance();
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform1f(location, value);
+        device.uniform1f(location, value);
     }
 }
 
 void Shader::setInt(const std::string& name, int value) {
+    auto& device = RenderDevice::getInstance();
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform1i(location, value);
+        device.uniform1i(location, value);
     }
 }
 
@@ -77,52 +83,59 @@ void Shader::setBool(const std::string& name, bool value) {
 }
 
 void Shader::setVec2(const std::string& name, const glm::vec2& value) {
+    auto& device = RenderDevice::getInstance();
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform2fv(location, 1, &value[0]);
+        device.uniform2fv(location, 1, &value[0]);
     }
 }
 
 void Shader::setVec3(const std::string& name, const glm::vec3& value) {
+    auto& device = RenderDevice::getInstance();
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform3fv(location, 1, &value[0]);
+        device.uniform3fv(location, 1, &value[0]);
     }
 }
 
 void Shader::setVec4(const std::string& name, const glm::vec4& value) {
+    auto& device = RenderDevice::getInstance();
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform4fv(location, 1, &value[0]);
+        device.uniform4fv(location, 1, &value[0]);
     }
 }
 
 void Shader::setVec4Array(const std::string& name, const glm::vec4* values, size_t count) {
+    auto& device = RenderDevice::getInstance();
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform4fv(location, count, &values[0][0]);
+        device.uniform4fv(location, count, &values[0][0]);
     }
 }
 
 void Shader::setMat3(const std::string& name, const glm::mat3& value) {
+    auto& device = RenderDevice::getInstance();
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniformMatrix3fv(location, 1, GL_FALSE, &value[0][0]);
+        device.uniformMatrix3fv(location, 1, GL_FALSE, &value[0][0]);
     }
 }
 
 void Shader::setMat4(const std::string& name, const glm::mat4& value) {
+    auto& device = RenderDevice::getInstance();
     GLint location = getUniformLocation(name);
     if (location == -1) return;
 
     #ifdef LINUX_BUILD
-        glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]); // always column-major
+        device.uniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]); // always column-major
     #else
-        glUniformMatrix4fv(location, 1, needsTranspose ? GL_TRUE : GL_FALSE, &value[0][0]);
+        device.uniformMatrix4fv(location, 1, needsTranspose ? GL_TRUE : GL_FALSE, &value[0][0]);
     #endif
 }
 
 void Shader::setMat4Array(const std::string& name, const glm::mat4* values, size_t count) {
+    auto& device = RenderDevice::getInstance();
     GLint location = getUniformLocation(name);
     if (location == -1) {
         static int warnCount = 0;
@@ -135,9 +148,9 @@ void Shader::setMat4Array(const std::string& name, const glm::mat4* values, size
     if (count == 0) return;
 
     #ifdef LINUX_BUILD
-        glUniformMatrix4fv(location, static_cast<GLsizei>(count), GL_FALSE, &values[0][0][0]);
+        device.uniformMatrix4fv(location, static_cast<GLsizei>(count), GL_FALSE, &values[0][0][0]);
     #else
-        glUniformMatrix4fv(location, static_cast<GLsizei>(count), needsTranspose ? GL_TRUE : GL_FALSE, &values[0][0][0]);
+        device.uniformMatrix4fv(location, static_cast<GLsizei>(count), needsTranspose ? GL_TRUE : GL_FALSE, &values[0][0][0]);
     #endif
 }
 
@@ -321,13 +334,14 @@ std::shared_ptr<Shader> Shader::getLightingShader() {
         lightingShader = std::make_shared<Shader>();
         
 #ifdef LINUX_BUILD
+        auto& device = RenderDevice::getInstance();
         // Try to load the external lighting shaders first
         // Try multiple possible paths for the editor
         if (lightingShader->loadFromFiles("assets/linux_shaders/lighting.vert", "assets/linux_shaders/lighting.frag")) {
             // Verify bone matrix uniform exists in external shader
             lightingShader->use();
-            GLint boneMatLoc = glGetUniformLocation(lightingShader->getProgram(), "u_BoneMatrices");
-            GLint numBonesLoc = glGetUniformLocation(lightingShader->getProgram(), "u_NumBones");
+            GLint boneMatLoc = device.getUniformLocation(lightingShader->getProgram(), "u_BoneMatrices");
+            GLint numBonesLoc = device.getUniformLocation(lightingShader->getProgram(), "u_NumBones");
             if (boneMatLoc == -1) {
                 std::cerr << "ERROR: u_BoneMatrices uniform NOT FOUND in EXTERNAL shader (assets/linux_shaders/lighting.vert)" << std::endl;
                 std::cerr << "The shader file needs bone animation support added!" << std::endl;
@@ -343,8 +357,8 @@ std::shared_ptr<Shader> Shader::getLightingShader() {
         if (lightingShader->loadFromFiles("./assets/linux_shaders/lighting.vert", "./assets/linux_shaders/lighting.frag")) {
             // Verify bone matrix uniform exists
             lightingShader->use();
-            GLint boneMatLoc = glGetUniformLocation(lightingShader->getProgram(), "u_BoneMatrices");
-            GLint numBonesLoc = glGetUniformLocation(lightingShader->getProgram(), "u_NumBones");
+            GLint boneMatLoc = device.getUniformLocation(lightingShader->getProgram(), "u_BoneMatrices");
+            GLint numBonesLoc = device.getUniformLocation(lightingShader->getProgram(), "u_NumBones");
             if (boneMatLoc == -1) {
                 std::cerr << "WARNING: u_BoneMatrices uniform NOT FOUND in EXTERNAL shader (./assets/linux_shaders/lighting.vert)" << std::endl;
             }
@@ -359,7 +373,7 @@ std::shared_ptr<Shader> Shader::getLightingShader() {
         if (lightingShader->loadFromFiles("../assets/linux_shaders/lighting.vert", "../assets/linux_shaders/lighting.frag")) {
             // Verify bone matrix uniform exists
             lightingShader->use();
-            GLint boneMatLoc = glGetUniformLocation(lightingShader->getProgram(), "u_BoneMatrices");
+            GLint boneMatLoc = device.getUniformLocation(lightingShader->getProgram(), "u_BoneMatrices");
             if (boneMatLoc == -1) {
                 std::cerr << "WARNING: u_BoneMatrices uniform NOT FOUND in EXTERNAL shader" << std::endl;
             }
@@ -481,8 +495,8 @@ std::shared_ptr<Shader> Shader::getLightingShader() {
             std::cout << "Using embedded lighting shader (external files not found)" << std::endl;
             // Verify bone matrix uniform exists
             lightingShader->use();
-            GLint boneMatLoc = glGetUniformLocation(lightingShader->getProgram(), "u_BoneMatrices");
-            GLint numBonesLoc = glGetUniformLocation(lightingShader->getProgram(), "u_NumBones");
+            GLint boneMatLoc = device.getUniformLocation(lightingShader->getProgram(), "u_BoneMatrices");
+            GLint numBonesLoc = device.getUniformLocation(lightingShader->getProgram(), "u_NumBones");
             if (boneMatLoc == -1) {
                 std::cerr << "WARNING: u_BoneMatrices uniform not found in embedded lighting shader!" << std::endl;
             } else {
@@ -516,20 +530,21 @@ std::shared_ptr<Shader> Shader::getLightingShader() {
 }
 
 bool Shader::compileShader(GLuint& shader, GLenum type, const std::string& source) {
-    shader = glCreateShader(type);
+    auto& device = RenderDevice::getInstance();
+    shader = device.createShader(type);
     const char* sourceCStr = source.c_str();
-    glShaderSource(shader, 1, &sourceCStr, NULL);
-    glCompileShader(shader);
+    device.shaderSource(shader, 1, &sourceCStr, NULL);
+    device.compileShader(shader);
     
     GLint success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    device.getShaderiv(shader, GL_COMPILE_STATUS, &success);
     if (!success) {
         GLchar infoLog[1024];
-        glGetShaderInfoLog(shader, 1024, NULL, infoLog);
+        device.getShaderInfoLog(shader, 1024, NULL, infoLog);
         std::cerr << "Shader compilation failed (" << (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << "):" << std::endl;
         std::cerr << infoLog << std::endl;
         
-        glDeleteShader(shader);
+        device.deleteShader(shader);
         shader = 0;
         return false;
     }
@@ -538,27 +553,28 @@ bool Shader::compileShader(GLuint& shader, GLenum type, const std::string& sourc
 }
 
 bool Shader::linkProgram() {
-    program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
+    auto& device = RenderDevice::getInstance();
+    program = device.createProgram();
+    device.attachShader(program, vertexShader);
+    device.attachShader(program, fragmentShader);
     
     // Bind attribute locations (for GLSL 120 compatibility)
-    glBindAttribLocation(program, 0, "position");
-    glBindAttribLocation(program, 1, "normal");
-    glBindAttribLocation(program, 2, "texCoords");
-    glBindAttribLocation(program, 3, "tangent");
-    glBindAttribLocation(program, 4, "boneWeights");
-    glBindAttribLocation(program, 5, "boneIndices");
+    device.bindAttribLocation(program, 0, "position");
+    device.bindAttribLocation(program, 1, "normal");
+    device.bindAttribLocation(program, 2, "texCoords");
+    device.bindAttribLocation(program, 3, "tangent");
+    device.bindAttribLocation(program, 4, "boneWeights");
+    device.bindAttribLocation(program, 5, "boneIndices");
     
-    glLinkProgram(program);
+    device.linkProgram(program);
     
     GLint success;
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    device.getProgramiv(program, GL_LINK_STATUS, &success);
     if (!success) {
         GLchar infoLog[1024];
-        glGetProgramInfoLog(program, 1024, NULL, infoLog);
+        device.getProgramInfoLog(program, 1024, NULL, infoLog);
         
-        glDeleteProgram(program);
+        device.deleteProgram(program);
         program = 0;
         return false;
     }
@@ -567,12 +583,13 @@ bool Shader::linkProgram() {
 }
 
 GLint Shader::getUniformLocation(const std::string& name) const {
+    auto& device = RenderDevice::getInstance();
     auto it = uniformCache.find(name);
     if (it != uniformCache.end()) {
         return it->second;
     }
     
-    GLint location = glGetUniformLocation(program, name.c_str());
+    GLint location = device.getUniformLocation(program, name.c_str());
     uniformCache[name] = location;
     return location;
 }
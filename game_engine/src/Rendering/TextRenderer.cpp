@@ -0,0 +1,394 @@
+#include "Rendering/TextRenderer.h"
+#include "Rendering/Shader.h"
+#include "Rendering/Texture.h"
+#include "Rendering/RenderDevice.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstddef>
+#include <iostream>
+
+namespace GameEngine {
+
+TextRenderer& TextRenderer::getInstance() {
+    static TextRenderer instance;
+    return instance;
+}
+
+TextRenderer::TextRenderer()
+    : activeBatches(0)
+    , vao(0)
+    , vbo(0)
+    , ebo(0)
+    , vboCapacity(0)
+    , quadCapacity(0)
+    , shaderFailed(false)
+{
+    lastFlushStats.reset();
+}
+
+TextRenderer::Batch& TextRenderer::getBatch(const std::shared_ptr<Texture>& page, TextSpace space) {
+    // Only a handful of pages are live at once, a linear scan beats hashing
+    for (size_t i = 0; i < activeBatches; ++i) {
+        if (batches[i].page == page && batches[i].space == space) {
+            return batches[i];
+        }
+    }
+
+    if (activeBatches == batches.size()) {
+        batches.push_back(Batch());
+    }
+    Batch& batch = batches[activeBatches++];
+    batch.page = page;
+    batch.space = space;
+    batch.vertices.clear();
+    batch.streamOffset = 0;
+    return batch;
+}
+
+void TextRenderer::submit(const GlyphRun& run, const glm::mat4& transform, const glm::vec4& color, TextSpace space) {
+    if (run.empty()) {
+        return;
+    }
+
+    for (const GlyphRun::Span& span : run.spans) {
+        if (!span.page || span.vertexCount == 0) {
+            continue;
+        }
+
+        Batch& batch = getBatch(span.page, space);
+        size_t base = batch.vertices.size();
+        batch.vertices.resize(base + span.vertexCount);
+
+        const TextVertex* in = &run.vertices[span.firstVertex];
+        TextVertex* out = &batch.vertices[base];
+        for (size_t i = 0; i < span.vertexCount; ++i, ++in, ++out) {
+            out->position = glm::vec3(transform * glm::vec4(in->position, 1.0f));
+            out->color = color;
+            out->texCoord = in->texCoord;
+        }
+    }
+}
+
+void TextRenderer::discard() {
+    for (size_t i = 0; i < activeBatches; ++i) {
+        batches[i].page.reset();
+        batches[i].vertices.clear();
+    }
+    activeBatches = 0;
+}
+
+int TextRenderer::flush(const glm::mat4& viewProjection, float screenAspectRatio) {
+    auto& device = RenderDevice::getInstance();
+    lastFlushStats.reset();
+    if (activeBatches == 0) {
+        return 0;
+    }
+
+    if (!ensureResources()) {
+        discard();
+        return 0;
+    }
+
+    // Lay every batch out back to back: world-space text first, overlays last
+    streamVertices.clear();
+    for (int pass = 0; pass < 2; ++pass) {
+        TextSpace space = pass == 0 ? TextSpace::WORLD : TextSpace::SCREEN;
+        for (size_t i = 0; i < activeBatches; ++i) {
+            Batch& batch = batches[i];
+            if (batch.space != space) {
+                continue;
+            }
+            batch.streamOffset = streamVertices.size();
+            streamVertices.insert(streamVertices.end(), batch.vertices.begin(), batch.vertices.end());
+        }
+    }
+
+    // Orphan and refill the stream buffer so we never wait on last frame's draw
+    device.bindBuffer(GL_ARRAY_BUFFER, vbo);
+    if (streamVertices.size() > vboCapacity) {
+        vboCapacity = streamVertices.size() + streamVertices.size() / 2;
+    }
+    device.bufferData(GL_ARRAY_BUFFER, sizeof(TextVertex) * vboCapacity, nullptr, GL_STREAM_DRAW);
+    device.bufferSubData(GL_ARRAY_BUFFER, 0, sizeof(TextVertex) * streamVertices.size(), streamVertices.data());
+
+    device.bindVertexArray(vao);
+    ensureQuadIndices(streamVertices.size() / 4);
+
+    textShader->use();
+    textShader->setMat4("uModelMat", glm::mat4(1.0f));
+    textShader->setInt("uFontAtlasTexture", 0);
+    device.activeTexture(GL_TEXTURE0);
+
+    GLboolean blendWasEnabled = device.isEnabled(GL_BLEND);
+    device.enable(GL_BLEND);
+    device.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    int drawCalls = drawBatches(TextSpace::WORLD, viewProjection);
+
+    float orthoHeight = 2.0f;
+    float orthoWidth = orthoHeight * screenAspectRatio;
+    glm::mat4 screenProjection = glm::ortho(-orthoWidth / 2, orthoWidth / 2, -orthoHeight / 2, orthoHeight / 2, -1.0f, 1.0f);
+
+    GLboolean depthWasEnabled = device.isEnabled(GL_DEPTH_TEST);
+    device.disable(GL_DEPTH_TEST);
+    drawCalls += drawBatches(TextSpace::SCREEN, screenProjection);
+    if (depthWasEnabled) {
+        device.enable(GL_DEPTH_TEST);
+    }
+
+    if (!blendWasEnabled) {
+        device.disable(GL_BLEND);
+    }
+
+    device.bindVertexArray(0);
+    textShader->unuse();
+
+    lastFlushStats.drawCalls = drawCalls;
+    lastFlushStats.glyphs = static_cast<int>(streamVertices.size() / 4);
+    lastFlushStats.batches = static_cast<int>(activeBatches);
+
+    discard();
+    return drawCalls;
+}
+
+int TextRenderer::drawBatches(TextSpace space, const glm::mat4& viewProjection) {
+    auto& device = RenderDevice::getInstance();
+    int drawCalls = 0;
+    bool matrixSet = false;
+
+    for (size_t i = 0; i < activeBatches; ++i) {
+        const Batch& batch = batches[i];
+        if (batch.space != space || batch.vertices.empty()) {
+            continue;
+        }
+
+        if (!matrixSet) {
+            textShader->setMat4("uViewProjectionMat", viewProjection);
+            matrixSet = true;
+        }
+
+        batch.page->bind();
+
+        // Indices are absolute, so a batch starting at vertex N starts at quad N/4
+        size_t firstQuad = batch.streamOffset / 4;
+        size_t quadCount = batch.vertices.size() / 4;
+        device.drawElements(GL_TRIANGLES, static_cast<GLsizei>(quadCount * 6), GL_UNSIGNED_INT,
+                       (void*)(firstQuad * 6 * sizeof(unsigned int)));
+        drawCalls++;
+    }
+
+    return drawCalls;
+}
+
+void TextRenderer::ensureQuadIndices(size_t quadCount) {
+    auto& device = RenderDevice::getInstance();
+    if (quadCount <= quadCapacity) {
+        return;
+    }
+
+    size_t newCapacity = quadCapacity ? quadCapacity : 256;
+    while (newCapacity < quadCount) {
+        newCapacity *= 2;
+    }
+
+    std::vector<unsigned int> indices(newCapacity * 6);
+    for (size_t q = 0; q < newCapacity; ++q) {
+        unsigned int base = static_cast<unsigned int>(q * 4);
+        indices[q * 6 + 0] = base + 0;
+        indices[q * 6 + 1] = base + 1;
+        indices[q * 6 + 2] = base + 2;
+        indices[q * 6 + 3] = base + 0;
+        indices[q * 6 + 4] = base + 2;
+        indices[q * 6 + 5] = base + 3;
+    }
+
+    // VAO is bound by the caller, so this also records the element binding
+    device.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    device.bufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * indices.size(), indices.data(), GL_STATIC_DRAW);
+    quadCapacity = newCapacity;
+}
+
+bool TextRenderer::ensureResources() {
+    auto& device = RenderDevice::getInstance();
+    if (vao) {
+        return true;
+    }
+    if (shaderFailed || !createShader()) {
+        shaderFailed = true;
+        return false;
+    }
+
+    device.genVertexArrays(1, &vao);
+    device.genBuffers(1, &vbo);
+    device.genBuffers(1, &ebo);
+
+    device.bindVertexArray(vao);
+    device.bindBuffer(GL_ARRAY_BUFFER, vbo);
+    device.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+
+    #ifdef LINUX_BUILD
+        GLint posLoc   = device.getAttribLocation(textShader->getProgram(), "aPosition");
+        GLint colorLoc = device.getAttribLocation(textShader->getProgram(), "aColor");
+        GLint texLoc   = device.getAttribLocation(textShader->getProgram(), "aTexCoord");
+    #else
+        GLint posLoc   = 0; // POSITION
+        GLint colorLoc = 1; // COLOR
+        GLint texLoc   = 2; // TEXCOORD0
+    #endif
+
+    if (posLoc >= 0) {
+        device.enableVertexAttribArray((GLuint)posLoc);
+        device.vertexAttribPointer((GLuint)posLoc, 3, GL_FLOAT, GL_FALSE,
+                              sizeof(TextVertex), (void*)offsetof(TextVertex, position));
+    }
+    if (colorLoc >= 0) {
+        device.enableVertexAttribArray((GLuint)colorLoc);
+        device.vertexAttribPointer((GLuint)colorLoc, 4, GL_FLOAT, GL_FALSE,
+                              sizeof(TextVertex), (void*)offsetof(TextVertex, color));
+    }
+    if (texLoc >= 0) {
+        device.enableVertexAttribArray((GLuint)texLoc);
+        device.vertexAttribPointer((GLuint)texLoc, 2, GL_FLOAT, GL_FALSE,
+                              sizeof(TextVertex), (void*)offsetof(TextVertex, texCoord));
+    }
+
+    device.bindVertexArray(0);
+    return true;
+}
+
+bool TextRenderer::createShader() {
+    textShader = std::make_shared<Shader>();
+    #ifdef VITA_BUILD
+    // Vita CG shaders need matrices transposed
+        textShader->needsTranspose = true;
+    #else
+        textShader->needsTranspose = false; // Linux or other platforms
+    #endif
+
+#ifdef LINUX_BUILD
+    // Try to load external shaders first
+    if (!textShader->loadFromFiles("assets/linux_shaders/text.vert", "assets/linux_shaders/text.frag")) {
+        // Fallback to embedded shaders
+        std::string vertexSource = R"(
+            #version 120
+            attribute vec3 aPosition;
+            attribute vec4 aColor;
+            attribute vec2 aTexCoord;
+
+            uniform mat4 uViewProjectionMat;
+            uniform mat4 uModelMat;
+
+            varying vec4 color;
+            varying vec2 texCoord;
+
+            void main()
+            {
+                gl_Position = uViewProjectionMat * uModelMat * vec4(aPosition, 1.0);
+                color = aColor;
+                texCoord = aTexCoord;
+            }
+        )";
+
+        std::string fragmentSource = R"(
+            #version 120
+            varying vec4 color;
+            varying vec2 texCoord;
+
+            uniform sampler2D uFontAtlasTexture;
+
+            void main()
+            {
+                // Glyphs are signed distance fields with the edge at 0.5
+                float distance = texture2D(uFontAtlasTexture, texCoord).r;
+                float smoothing = fwidth(distance);
+                float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+                gl_FragColor = vec4(color.rgb, color.a * alpha);
+            }
+        )";
+
+        textShader->loadFromSource(vertexSource, fragmentSource);
+    }
+#else
+    // Vita builds - try to load external shaders first
+    if (!textShader->loadFromFiles("app0:/assets/shaders/text.vert", "app0:/assets/shaders/text.frag")) {
+        // Fallback to embedded CG/HLSL shaders (VitaGL uses CG/HLSL)
+        std::string vertexSource = R"(
+            struct VS_INPUT {
+                float3 aPosition : POSITION;
+                float4 aColor : COLOR;
+                float2 aTexCoord : TEXCOORD0;
+            };
+
+            struct VS_OUTPUT {
+                float4 Position : POSITION;
+                float4 color : COLOR;
+                float2 texCoord : TEXCOORD0;
+            };
+
+            float4x4 uViewProjectionMat;
+            float4x4 uModelMat;
+
+            VS_OUTPUT main(VS_INPUT input) {
+                VS_OUTPUT output;
+                output.Position = mul(uViewProjectionMat, mul(uModelMat, float4(input.aPosition, 1.0)));
+                output.color = input.aColor;
+                output.texCoord = input.aTexCoord;
+                return output;
+            }
+        )";
+
+        std::string fragmentSource = R"(
+            struct PS_INPUT {
+                float4 color : COLOR;
+                float2 texCoord : TEXCOORD0;
+            };
+
+            sampler2D uFontAtlasTexture;
+
+            float4 main(PS_INPUT input) : COLOR {
+                // Glyphs are signed distance fields with the edge at 0.5
+                float distance = tex2D(uFontAtlasTexture, input.texCoord).r;
+                float smoothing = fwidth(distance);
+                float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+                return float4(input.color.rgb, input.color.a * alpha);
+            }
+        )";
+
+        if (!textShader->loadFromSource(vertexSource, fragmentSource)) {
+            std::cerr << "Failed to load embedded CG/HLSL text shaders!" << std::endl;
+        }
+    }
+#endif
+
+    if (!textShader->isValid()) {
+        std::cerr << "Failed to create text shader!" << std::endl;
+        textShader.reset();
+        return false;
+    }
+    return true;
+}
+
+void TextRenderer::shutdown() {
+    auto& device = RenderDevice::getInstance();
+    discard();
+    batches.clear();
+    streamVertices.clear();
+
+    if (vao) {
+        device.deleteVertexArrays(1, &vao);
+        vao = 0;
+    }
+    if (vbo) {
+        device.deleteBuffers(1, &vbo);
+        vbo = 0;
+    }
+    if (ebo) {
+        device.deleteBuffers(1, &ebo);
+        ebo = 0;
+    }
+    vboCapacity = 0;
+    quadCapacity = 0;
+    textShader.reset();
+    shaderFailed = false;
+}
+
+} // namespace GameEngine
@@ -1,181 +1,198 @@
  #include "Rendering/Texture.h"
+#include "Rendering/ImageDecoder.h"
+#include "Rendering/RenderDevice.h"
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <cstring>
 
 #ifdef LINUX_BUILD
     #include <png.h>
-    // Use STB Image from tinygltf (already included)
-    #include "../../vendor/tinygltf/stb_image.h"
+    #include <filesystem>
 #else
     #include <psp2/io/fcntl.h>  // Vita SDK file I/O
     #include <psp2/io/stat.h>   // Vita SDK file stat
     #include <cstring>  // For memcpy
     #include <cstdint>  // For uint32_t, uint16_t
-    // Use STB Image from tinygltf to avoid multiple definitions
-    #include "../../vendor/tinygltf/stb_image.h"
+#endif
+
+// Older GL headers may lack the compressed format enums
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RG_RGTC2
+    #define GL_COMPRESSED_RG_RGTC2 0x8DBD
 #endif
 
 namespace GameEngine {
 
+namespace {
+
+// Cooked textures are read piecewise, one range per resident level change
+bool readFileRange(const std::string& path, size_t offset, size_t size, std::vector<uint8_t>& out) {
+#ifdef LINUX_BUILD
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    if (fseek(file, static_cast<long>(offset), SEEK_SET) != 0) {
+        fclose(file);
+        return false;
+    }
+    out.resize(size);
+    size_t bytesRead = fread(out.data(), 1, size, file);
+    fclose(file);
+    return bytesRead == size;
+#else
+    SceUID fd = sceIoOpen(path.c_str(), SCE_O_RDONLY, 0);
+    if (fd < 0) return false;
+    if (sceIoLseek(fd, static_cast<SceOff>(offset), SCE_SEEK_SET) < 0) {
+        sceIoClose(fd);
+        return false;
+    }
+    out.resize(size);
+    int bytesRead = sceIoRead(fd, out.data(), size);
+    sceIoClose(fd);
+    return bytesRead == static_cast<int>(size);
+#endif
+}
+
+#ifdef LINUX_BUILD
+// A cooked file older than its source is stale; fall back to the source
+bool isCookedUpToDate(const std::string& sourcePath, const std::string& cookedPath) {
+    std::error_code error;
+    auto cookedTime = std::filesystem::last_write_time(cookedPath, error);
+    if (error) return false;
+    auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+    if (error) return true;
+    return cookedTime >= sourceTime;
+}
+#endif
+
+GLenum getGLCompressedFormat(CookedTextureFormat format) {
+    switch (format) {
+        case CookedTextureFormat::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case CookedTextureFormat::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case CookedTextureFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+        default: return GL_RGBA;
+    }
+}
+
+} // namespace
+
+unsigned int Texture::currentFrame = 0;
+const int Texture::STREAM_INITIAL_SIZE;
+
 Texture::Texture()
     : textureID(0), width(0), height(0), format(TextureFormat::RGBA), isCubemapTexture(false)
+    , minFilterMode(GL_LINEAR_MIPMAP_LINEAR), magFilterMode(GL_LINEAR)
+    , wrapSMode(GL_REPEAT), wrapTMode(GL_REPEAT)
+    , cookedFormat(CookedTextureFormat::RGBA8), residentMip(0), residentBytes(0), lastUsedFrame(0)
 {
 }
 
 Texture::~Texture() {
+    auto& device = RenderDevice::getInstance();
     if (textureID) {
-        glDeleteTextures(1, &textureID);
+        device.deleteTextures(1, &textureID);
         textureID = 0;
     }
 }
 
-#ifndef LINUX_BUILD
-
 bool Texture::loadSTBImage(const std::string& filepath) {
-    this->filepath = filepath; // Store the filepath
-    
-    // Read file into memory first (STB Image needs this)
-    SceUID fd = sceIoOpen(filepath.c_str(), SCE_O_RDONLY, 0);
-    if (fd < 0) {
-        std::cerr << "Failed to open image file: " << filepath << std::endl;
-        return false;
-    }
-    
-    SceOff fileSize = sceIoLseek(fd, 0, SCE_SEEK_END);
-    sceIoLseek(fd, 0, SCE_SEEK_SET);
-    
-    if (fileSize <= 0) {
-        std::cerr << "Invalid file size: " << filepath << std::endl;
-        sceIoClose(fd);
-        return false;
-    }
-    
-    unsigned char* fileData = new unsigned char[fileSize];
-    int bytesRead = sceIoRead(fd, fileData, fileSize);
-    sceIoClose(fd);
-    
-    if (bytesRead != fileSize) {
-        std::cerr << "Failed to read complete file: " << filepath << std::endl;
-        delete[] fileData;
-        return false;
-    }
-    
-    int channels;
-    unsigned char* imageData = stbi_load_from_memory(fileData, fileSize, &width, &height, &channels, 0);
-    delete[] fileData;
-    
-    if (!imageData) {
-        std::cerr << "STB Image failed to load: " << filepath << " - " << stbi_failure_reason() << std::endl;
-        return false;
-    }
+    this->filepath = filepath;
     
-    if (channels == 3) {
-        format = TextureFormat::RGB;
-    } else if (channels == 4) {
-        format = TextureFormat::RGBA;
-    } else {
-        std::cerr << "Unsupported channel count: " << channels << std::endl;
-        stbi_image_free(imageData);
+    DecodedImage image;
+    if (!ImageDecoder::decode(filepath, image)) {
+        std::cerr << "STB Image failed to load: " << filepath << " - " << image.error << std::endl;
         return false;
     }
     
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    
-    GLenum glFormat = (channels == 3) ? GL_RGB : GL_RGBA;
-    glTexImage2D(GL_TEXTURE_2D, 0, glFormat, width, height, 0, glFormat, GL_UNSIGNED_BYTE, imageData);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    
-    stbi_image_free(imageData);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    
-    std::cout << "Successfully loaded STB image: " << filepath << " (" << width << "x" << height << ", " << channels << " channels)" << std::endl;
-    return true;
+    return loadFromImage(filepath, image);
 }
 
-#endif
-
-#ifdef LINUX_BUILD
-bool Texture::loadSTBImage(const std::string& filepath) {
+bool Texture::loadFromImage(const std::string& filepath, const DecodedImage& image) {
+    auto& device = RenderDevice::getInstance();
     this->filepath = filepath;
     
-    FILE* file = fopen(filepath.c_str(), "rb");
-    if (!file) {
-        std::cerr << "Failed to open image file: " << filepath << std::endl;
-        return false;
-    }
-    
-    fseek(file, 0, SEEK_END);
-    long fileSize = ftell(file);
-    fseek(file, 0, SEEK_SET);
-    
-    if (fileSize <= 0) {
-        std::cerr << "Invalid file size: " << filepath << std::endl;
-        fclose(file);
-        return false;
-    }
-    
-    // Read file data
-    unsigned char* fileData = new unsigned char[fileSize];
-    if (fread(fileData, 1, fileSize, file) != static_cast<size_t>(fileSize)) {
-        std::cerr << "Failed to read file data: " << filepath << std::endl;
-        delete[] fileData;
-        fclose(file);
+    if (!image.isValid()) {
         return false;
     }
-    fclose(file);
-    
-    // Use STB Image to load the image
-    int channels;
-    unsigned char* imageData = stbi_load_from_memory(fileData, fileSize, &width, &height, &channels, 0);
-    delete[] fileData; // Free file data
     
-    if (!imageData) {
-        std::cerr << "STB Image failed to load: " << filepath << " - " << stbi_failure_reason() << std::endl;
-        return false;
-    }
-    
-    // Determine format based on channel count
-    if (channels == 4) {
+    if (image.channels == 4) {
         format = TextureFormat::RGBA;
-    } else if (channels == 3) {
+    } else if (image.channels == 3) {
         format = TextureFormat::RGB;
     } else {
-        std::cerr << "Unsupported channel count: " << channels << std::endl;
-        stbi_image_free(imageData);
+        std::cerr << "Unsupported channel count: " << image.channels << std::endl;
         return false;
     }
+    width = image.width;
+    height = image.height;
     
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    device.genTextures(1, &textureID);
+    device.bindTexture(GL_TEXTURE_2D, textureID);
     
-    GLenum glFormat = (format == TextureFormat::RGBA) ? GL_RGBA : GL_RGB;
-    GLenum internalFormat = glFormat;
-    
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, glFormat, GL_UNSIGNED_BYTE, imageData);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    GLenum glFormat = getGLFormat(format);
+    device.texImage2D(GL_TEXTURE_2D, 0, glFormat, width, height, 0, glFormat, GL_UNSIGNED_BYTE, image.pixels.data());
     
-    stbi_image_free(imageData);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+#ifdef LINUX_BUILD
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    device.generateMipmap(GL_TEXTURE_2D);
+    // Base level plus a third for the generated mips
+    residentBytes = static_cast<size_t>(width) * height * image.channels * 4 / 3;
+#else
+    minFilterMode = GL_LINEAR;
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    residentBytes = static_cast<size_t>(width) * height * image.channels;
+#endif
     
-    glBindTexture(GL_TEXTURE_2D, 0);
+    device.bindTexture(GL_TEXTURE_2D, 0);
     
-    std::cout << "Successfully loaded texture with STB Image: " << filepath << " (" << width << "x" << height << ")" << std::endl;
+    std::cout << "Successfully loaded texture with STB Image: " << filepath << " (" << width << "x" << height << ", " << image.channels << " channels)" << std::endl;
     return true;
 }
+
+std::string Texture::getSourcePath(const std::string& filepath) {
+#ifdef LINUX_BUILD
+    return filepath;
+#else
+    // The VPK flattens assets/textures into app0:/
+    if (filepath.find("assets/textures/") != std::string::npos) {
+        size_t lastSlash = filepath.find_last_of("/");
+        if (lastSlash != std::string::npos) {
+            return "app0:/" + filepath.substr(lastSlash + 1);
+        }
+        return "app0:/" + filepath;
+    } else if (filepath.find("app0:/") == std::string::npos) {
+        return "app0:/" + filepath;
+    }
+    return filepath;
+#endif
+}
+
+bool Texture::hasCookedVersion(const std::string& filepath) {
+#ifdef LINUX_BUILD
+    return isCookedUpToDate(filepath, TextureCooker::getCookedPath(filepath));
+#else
+    SceIoStat stat;
+    return sceIoGetstat(TextureCooker::getCookedPath(getSourcePath(filepath)).c_str(), &stat) >= 0;
 #endif
+}
 
 bool Texture::loadFromFile(const std::string& filepath) {
     this->filepath = filepath;
     
 #ifdef LINUX_BUILD
+    std::string cooked = TextureCooker::getCookedPath(filepath);
+    if (isCookedUpToDate(filepath, cooked) && loadCooked(cooked)) {
+        return true;
+    }
+    
     if (loadSTBImage(filepath)) {
         return true;
     }
@@ -302,24 +319,26 @@ bool Texture::loadFromFile(const std::string& filepath) {
         format = TextureFormat::RGB;
     }
     
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    auto& device = RenderDevice::getInstance();
+    device.genTextures(1, &textureID);
+    device.bindTexture(GL_TEXTURE_2D, textureID);
     
     GLenum glFormat = getGLFormat(format);
     GLenum internalFormat = glFormat;
     
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, glFormat, GL_UNSIGNED_BYTE, nullptr);
+    device.texImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, glFormat, GL_UNSIGNED_BYTE, nullptr);
     
     for (int i = 0; i < height; i++) {
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, height - 1 - i, width, 1, glFormat, GL_UNSIGNED_BYTE, row_pointers[i]);
+        device.texSubImage2D(GL_TEXTURE_2D, 0, 0, height - 1 - i, width, 1, glFormat, GL_UNSIGNED_BYTE, row_pointers[i]);
     }
     
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     
-    glGenerateMipmap(GL_TEXTURE_2D);
+    device.generateMipmap(GL_TEXTURE_2D);
+    residentBytes = static_cast<size_t>(width) * height * channels * 4 / 3;
     
     for (int i = 0; i < height; i++) {
         delete[] row_pointers[i];
@@ -329,26 +348,19 @@ bool Texture::loadFromFile(const std::string& filepath) {
     png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
     fclose(file);
     
-    glBindTexture(GL_TEXTURE_2D, 0);
+    device.bindTexture(GL_TEXTURE_2D, 0);
     
     std::cout << "Successfully loaded texture: " << filepath << " (" << width << "x" << height << ")" << std::endl;
     return true;
 #else
-    std::string vitaPath = filepath;
-    
-    if (filepath.find("assets/textures/") != std::string::npos) {
-        size_t lastSlash = filepath.find_last_of("/");
-        if (lastSlash != std::string::npos) {
-            vitaPath = "app0:/" + filepath.substr(lastSlash + 1);
-        } else {
-            vitaPath = "app0:/" + filepath;
-        }
-    } else if (filepath.find("app0:/") == std::string::npos) {
-        vitaPath = "app0:/" + filepath;
-    }
+    std::string vitaPath = getSourcePath(filepath);
     
     std::cout << "Vita: Attempting to load texture from: " << vitaPath << std::endl;
     
+    if (loadCooked(TextureCooker::getCookedPath(vitaPath))) {
+        return true;
+    }
+    
     if (loadSTBImage(vitaPath)) {
         return true;
     }
@@ -359,52 +371,55 @@ bool Texture::loadFromFile(const std::string& filepath) {
 }
 
 bool Texture::createEmpty(int w, int h, TextureFormat fmt) {
+    auto& device = RenderDevice::getInstance();
     width = w;
     height = h;
     format = fmt;
     
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    device.genTextures(1, &textureID);
+    device.bindTexture(GL_TEXTURE_2D, textureID);
     
     GLenum glFormat = getGLFormat(format);
     GLenum internalFormat = glFormat;
     
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, glFormat, GL_UNSIGNED_BYTE, nullptr);
+    device.texImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, glFormat, GL_UNSIGNED_BYTE, nullptr);
     
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     
-    glBindTexture(GL_TEXTURE_2D, 0);
+    device.bindTexture(GL_TEXTURE_2D, 0);
     
     return true;
 }
 
 bool Texture::createFromData(const void* data, int w, int h, TextureFormat fmt) {
+    auto& device = RenderDevice::getInstance();
     width = w;
     height = h;
     format = fmt;
     
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    device.genTextures(1, &textureID);
+    device.bindTexture(GL_TEXTURE_2D, textureID);
     
     GLenum glFormat = getGLFormat(format);
     GLenum internalFormat = glFormat;
     
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, glFormat, GL_UNSIGNED_BYTE, data);
+    device.texImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, glFormat, GL_UNSIGNED_BYTE, data);
     
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
     
-    glBindTexture(GL_TEXTURE_2D, 0);
+    device.bindTexture(GL_TEXTURE_2D, 0);
     
     return true;
 }
 
 bool Texture::createCubemap(const std::vector<std::string>& facePaths) {
+    auto& device = RenderDevice::getInstance();
     if (facePaths.size() != 6) {
         std::cerr << "Cubemap requires exactly 6 face textures" << std::endl;
         return false;
@@ -419,64 +434,29 @@ bool Texture::createCubemap(const std::vector<std::string>& facePaths) {
         GL_TEXTURE_CUBE_MAP_NEGATIVE_Z
     };
     
-    glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+    // Decode the six faces in parallel, then upload them in order on this thread
+    std::vector<std::string> sourcePaths;
+    for (size_t i = 0; i < facePaths.size(); ++i) {
+        sourcePaths.push_back(getSourcePath(facePaths[i]));
+    }
+    std::vector<DecodedImage> images;
+    ImageDecoder::decodeAll(sourcePaths, images);
+    
+    device.genTextures(1, &textureID);
+    device.bindTexture(GL_TEXTURE_CUBE_MAP, textureID);
     
     isCubemapTexture = true;
     
     for (unsigned int i = 0; i < 6; i++) {
-        int w, h, channels;
-        unsigned char* imageData = nullptr;
-        
-#ifdef LINUX_BUILD
-        imageData = stbi_load(facePaths[i].c_str(), &w, &h, &channels, 0);
-#else
-        std::string vitaPath = facePaths[i];
-        if (vitaPath.find("assets/textures/") != std::string::npos) {
-            size_t lastSlash = vitaPath.find_last_of("/");
-            if (lastSlash != std::string::npos) {
-                vitaPath = "app0:/" + vitaPath.substr(lastSlash + 1);
-            } else {
-                vitaPath = "app0:/" + vitaPath;
-            }
-        } else if (vitaPath.find("app0:/") == std::string::npos) {
-            vitaPath = "app0:/" + vitaPath;
-        }
-        
-        SceUID fd = sceIoOpen(vitaPath.c_str(), SCE_O_RDONLY, 0);
-        if (fd < 0) {
-            std::cerr << "Failed to open cubemap face: " << vitaPath << std::endl;
-            continue;
-        }
-        
-        SceOff fileSize = sceIoLseek(fd, 0, SCE_SEEK_END);
-        sceIoLseek(fd, 0, SCE_SEEK_SET);
-        
-        if (fileSize <= 0) {
-            std::cerr << "Invalid file size for cubemap face: " << vitaPath << std::endl;
-            sceIoClose(fd);
-            continue;
-        }
-        
-        unsigned char* fileData = new unsigned char[fileSize];
-        int bytesRead = sceIoRead(fd, fileData, fileSize);
-        sceIoClose(fd);
-        
-        if (bytesRead != fileSize) {
-            std::cerr << "Failed to read cubemap face: " << vitaPath << std::endl;
-            delete[] fileData;
-            continue;
-        }
-        
-        imageData = stbi_load_from_memory(fileData, fileSize, &w, &h, &channels, 0);
-        delete[] fileData;
-#endif
-        
-        if (!imageData) {
-            std::cerr << "Failed to load cubemap face " << i << ": " << facePaths[i] << std::endl;
+        const DecodedImage& image = images[i];
+        if (!image.isValid()) {
+            std::cerr << "Failed to load cubemap face " << i << ": " << sourcePaths[i] << " - " << image.error << std::endl;
             continue;
         }
         
+        int w = image.width;
+        int h = image.height;
+        int channels = image.channels;
         GLenum glFormat = (channels == 3) ? GL_RGB : GL_RGBA;
         GLenum internalFormat = glFormat;
         
@@ -486,69 +466,218 @@ bool Texture::createCubemap(const std::vector<std::string>& facePaths) {
             format = (channels == 3) ? TextureFormat::RGB : TextureFormat::RGBA;
         }
         
-        glTexImage2D(faces[i], 0, internalFormat, w, h, 0, glFormat, GL_UNSIGNED_BYTE, imageData);
-        stbi_image_free(imageData);
+        device.texImage2D(faces[i], 0, internalFormat, w, h, 0, glFormat, GL_UNSIGNED_BYTE, image.pixels.data());
     }
     
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    device.texParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    device.texParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    device.texParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     // VitaGL headers may not expose GL_TEXTURE_WRAP_R
 #ifdef GL_TEXTURE_WRAP_R
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    device.texParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 #endif
     
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    device.bindTexture(GL_TEXTURE_CUBE_MAP, 0);
     
     std::cout << "Successfully created cubemap texture (" << width << "x" << height << ")" << std::endl;
     return true;
 }
 
 void Texture::bindCubemap(int textureUnit) const {
-    glActiveTexture(GL_TEXTURE0 + textureUnit);
+    auto& device = RenderDevice::getInstance();
+    lastUsedFrame = currentFrame;
+    device.activeTexture(GL_TEXTURE0 + textureUnit);
     if (isCubemapTexture) {
-        glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+        device.bindTexture(GL_TEXTURE_CUBE_MAP, textureID);
     } else {
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        device.bindTexture(GL_TEXTURE_2D, textureID);
     }
 }
 
 void Texture::bind(int textureUnit) const {
-    glActiveTexture(GL_TEXTURE0 + textureUnit);
+    auto& device = RenderDevice::getInstance();
+    lastUsedFrame = currentFrame;
+    device.activeTexture(GL_TEXTURE0 + textureUnit);
     if (isCubemapTexture) {
-        glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+        device.bindTexture(GL_TEXTURE_CUBE_MAP, textureID);
     } else {
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        device.bindTexture(GL_TEXTURE_2D, textureID);
     }
 }
 
 void Texture::unbind() const {
+    auto& device = RenderDevice::getInstance();
     if (isCubemapTexture) {
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+        device.bindTexture(GL_TEXTURE_CUBE_MAP, 0);
     } else {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        device.bindTexture(GL_TEXTURE_2D, 0);
     }
 }
 
 void Texture::setFilter(TextureFilter minFilter, TextureFilter magFilter) {
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, getGLFilter(minFilter));
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, getGLFilter(magFilter));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    auto& device = RenderDevice::getInstance();
+    minFilterMode = getGLFilter(minFilter);
+    magFilterMode = getGLFilter(magFilter);
+    device.bindTexture(GL_TEXTURE_2D, textureID);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilterMode);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilterMode);
+    device.bindTexture(GL_TEXTURE_2D, 0);
 }
 
 void Texture::setWrap(TextureWrap wrapS, TextureWrap wrapT) {
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, getGLWrap(wrapS));
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, getGLWrap(wrapT));
-    glBindTexture(GL_TEXTURE_2D, 0);
+    auto& device = RenderDevice::getInstance();
+    wrapSMode = getGLWrap(wrapS);
+    wrapTMode = getGLWrap(wrapT);
+    device.bindTexture(GL_TEXTURE_2D, textureID);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapSMode);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapTMode);
+    device.bindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture::applySamplerState() const {
+    auto& device = RenderDevice::getInstance();
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilterMode);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilterMode);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapSMode);
+    device.texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapTMode);
+}
+
+bool Texture::isFormatSupported(CookedTextureFormat format) {
+    switch (format) {
+#ifdef LINUX_BUILD
+        case CookedTextureFormat::BC1:
+        case CookedTextureFormat::BC3:
+            return GLEW_EXT_texture_compression_s3tc ? true : false;
+        case CookedTextureFormat::BC5:
+            return (GLEW_VERSION_3_0 || GLEW_ARB_texture_compression_rgtc) ? true : false;
+#else
+        // vitaGL uploads DXT1/DXT5 as native UBC1/UBC3; it has no RGTC
+        case CookedTextureFormat::BC1:
+        case CookedTextureFormat::BC3:
+            return true;
+        case CookedTextureFormat::BC5:
+            return false;
+#endif
+        case CookedTextureFormat::RGBA8:
+        default:
+            return true;
+    }
+}
+
+bool Texture::loadCooked(const std::string& cookedPath) {
+    // A missing cooked file is normal (uncooked asset), so stay quiet
+    std::vector<uint8_t> bytes;
+    if (!readFileRange(cookedPath, 0, sizeof(CookedTextureHeader), bytes)) {
+        return false;
+    }
+    CookedTextureHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    std::vector<CookedMipLevel> mips;
+    if (header.mipCount > TextureCooker::MAX_MIP_COUNT ||
+        !readFileRange(cookedPath, 0, TextureCooker::getHeaderSize(header.mipCount), bytes) ||
+        !TextureCooker::parseHeader(bytes.data(), bytes.size(), header, mips)) {
+        std::cerr << "Invalid cooked texture: " << cookedPath << std::endl;
+        return false;
+    }
+    
+    this->cookedPath = cookedPath;
+    cookedMips = mips;
+    cookedFormat = static_cast<CookedTextureFormat>(header.format);
+    width = static_cast<int>(header.width);
+    height = static_cast<int>(header.height);
+    format = (cookedFormat == CookedTextureFormat::BC3 || cookedFormat == CookedTextureFormat::RGBA8)
+        ? TextureFormat::RGBA : TextureFormat::RGB;
+    
+    // Only the small levels at first so the texture is drawable right away;
+    // TextureManager streams the rest in
+    if (!uploadCookedLevels(getStreamFloorMip())) {
+        cookedMips.clear();
+        this->cookedPath.clear();
+        return false;
+    }
+    
+    std::cout << "Loaded cooked texture: " << cookedPath << " (" << width << "x" << height << ", "
+              << TextureCooker::getFormatName(cookedFormat) << ", " << cookedMips.size() << " mips"
+              << (isFormatSupported(cookedFormat) ? "" : ", decoded on CPU") << ")" << std::endl;
+    return true;
+}
+
+int Texture::getStreamFloorMip() const {
+    for (size_t i = 0; i < cookedMips.size(); ++i) {
+        if (cookedMips[i].width <= static_cast<uint32_t>(STREAM_INITIAL_SIZE) &&
+            cookedMips[i].height <= static_cast<uint32_t>(STREAM_INITIAL_SIZE)) {
+            return static_cast<int>(i);
+        }
+    }
+    return cookedMips.empty() ? 0 : static_cast<int>(cookedMips.size()) - 1;
+}
+
+size_t Texture::getMipChainBytes(int level) const {
+    bool compressed = isFormatSupported(cookedFormat);
+    size_t total = 0;
+    for (size_t i = std::max(level, 0); i < cookedMips.size(); ++i) {
+        total += compressed ? cookedMips[i].size : static_cast<size_t>(cookedMips[i].width) * cookedMips[i].height * 4;
+    }
+    return total;
+}
+
+bool Texture::setResidentMip(int level) {
+    if (!isStreamed()) return false;
+    level = std::max(0, std::min(level, getMipCount() - 1));
+    if (level == residentMip && textureID) return true;
+    return uploadCookedLevels(level);
+}
+
+bool Texture::uploadCookedLevels(int firstLevel) {
+    auto& device = RenderDevice::getInstance();
+    // Levels [firstLevel, mipCount) are contiguous in the file
+    const CookedMipLevel& first = cookedMips[firstLevel];
+    const CookedMipLevel& last = cookedMips.back();
+    size_t offset = first.offset;
+    std::vector<uint8_t> data;
+    if (!readFileRange(cookedPath, offset, last.offset + last.size - offset, data)) {
+        std::cerr << "Failed to read cooked texture levels: " << cookedPath << std::endl;
+        return false;
+    }
+    
+    bool compressed = isFormatSupported(cookedFormat);
+    GLenum compressedFormat = getGLCompressedFormat(cookedFormat);
+    std::vector<uint8_t> decoded;
+    
+    // Build the new chain in a fresh texture so the old one stays valid
+    // until the swap
+    GLuint newID = 0;
+    device.genTextures(1, &newID);
+    device.bindTexture(GL_TEXTURE_2D, newID);
+    for (int level = firstLevel; level < getMipCount(); ++level) {
+        const CookedMipLevel& mip = cookedMips[level];
+        const uint8_t* levelData = data.data() + (mip.offset - offset);
+        GLint glLevel = level - firstLevel;
+        if (compressed) {
+            device.compressedTexImage2D(GL_TEXTURE_2D, glLevel, compressedFormat, mip.width, mip.height, 0, mip.size, levelData);
+        } else {
+            TextureCooker::decompress(levelData, mip.size, cookedFormat, mip.width, mip.height, decoded);
+            device.texImage2D(GL_TEXTURE_2D, glLevel, GL_RGBA, mip.width, mip.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, decoded.data());
+        }
+    }
+    applySamplerState();
+    device.bindTexture(GL_TEXTURE_2D, 0);
+    
+    if (textureID) {
+        device.deleteTextures(1, &textureID);
+    }
+    textureID = newID;
+    residentMip = firstLevel;
+    residentBytes = getMipChainBytes(firstLevel);
+    return true;
 }
 
 void Texture::generateMipmaps() {
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glGenerateMipmap(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    auto& device = RenderDevice::getInstance();
+    device.bindTexture(GL_TEXTURE_2D, textureID);
+    device.generateMipmap(GL_TEXTURE_2D);
+    device.bindTexture(GL_TEXTURE_2D, 0);
 }
 
 std::shared_ptr<Texture> Texture::getWhiteTexture() {
@@ -0,0 +1,532 @@
+#include "Rendering/TextureCooker.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
+namespace GameEngine {
+
+namespace {
+
+const char BTEX_MAGIC[4] = { 'B', 'T', 'E', 'X' };
+
+// 4x4 block with edge pixels repeated for sizes that aren't a multiple of 4
+void fetchBlock(const TextureCooker::Image& image, int blockX, int blockY, uint8_t block[64]) {
+    for (int y = 0; y < 4; ++y) {
+        int sy = std::min(blockY * 4 + y, image.height - 1);
+        for (int x = 0; x < 4; ++x) {
+            int sx = std::min(blockX * 4 + x, image.width - 1);
+            std::memcpy(&block[(y * 4 + x) * 4], &image.pixels[(static_cast<size_t>(sy) * image.width + sx) * 4], 4);
+        }
+    }
+}
+
+uint16_t packColor565(const float color[3]) {
+    int r = static_cast<int>(std::max(0.0f, std::min(255.0f, color[0])) * 31.0f / 255.0f + 0.5f);
+    int g = static_cast<int>(std::max(0.0f, std::min(255.0f, color[1])) * 63.0f / 255.0f + 0.5f);
+    int b = static_cast<int>(std::max(0.0f, std::min(255.0f, color[2])) * 31.0f / 255.0f + 0.5f);
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void unpackColor565(uint16_t packed, int color[3]) {
+    int r = (packed >> 11) & 31;
+    int g = (packed >> 5) & 63;
+    int b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+void buildColorPalette(uint16_t c0, uint16_t c1, bool fourColor, int palette[4][4]) {
+    unpackColor565(c0, palette[0]);
+    unpackColor565(c1, palette[1]);
+    palette[0][3] = 255;
+    palette[1][3] = 255;
+    for (int c = 0; c < 3; ++c) {
+        if (fourColor) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = fourColor ? 255 : 0;
+}
+
+// Picks the nearest palette entry per pixel; returns the summed squared error
+int assignColorIndices(const uint8_t block[64], uint16_t c0, uint16_t c1, uint32_t& indices) {
+    int palette[4][4];
+    buildColorPalette(c0, c1, true, palette);
+    indices = 0;
+    int totalError = 0;
+    for (int i = 0; i < 16; ++i) {
+        int best = 0;
+        int bestError = 0x7fffffff;
+        for (int p = 0; p < 4; ++p) {
+            int dr = block[i * 4] - palette[p][0];
+            int dg = block[i * 4 + 1] - palette[p][1];
+            int db = block[i * 4 + 2] - palette[p][2];
+            int error = dr * dr + dg * dg + db * db;
+            if (error < bestError) {
+                bestError = error;
+                best = p;
+            }
+        }
+        indices |= static_cast<uint32_t>(best) << (i * 2);
+        totalError += bestError;
+    }
+    return totalError;
+}
+
+// Least-squares endpoints for a fixed index assignment
+bool refineEndpoints(const uint8_t block[64], uint32_t indices, float end0[3], float end1[3]) {
+    static const float weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+    float ax[3] = { 0.0f, 0.0f, 0.0f };
+    float bx[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; ++i) {
+        float a = weights[(indices >> (i * 2)) & 3];
+        float b = 1.0f - a;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (int c = 0; c < 3; ++c) {
+            ax[c] += a * block[i * 4 + c];
+            bx[c] += b * block[i * 4 + c];
+        }
+    }
+    float determinant = aa * bb - ab * ab;
+    if (std::fabs(determinant) < 1e-6f) return false;
+    float inverse = 1.0f / determinant;
+    for (int c = 0; c < 3; ++c) {
+        end0[c] = (ax[c] * bb - bx[c] * ab) * inverse;
+        end1[c] = (bx[c] * aa - ax[c] * ab) * inverse;
+    }
+    return true;
+}
+
+void writeColorBlock(uint16_t c0, uint16_t c1, uint32_t indices, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(c0 & 0xff);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1 & 0xff);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    for (int i = 0; i < 4; ++i) {
+        out[4 + i] = static_cast<uint8_t>((indices >> (i * 8)) & 0xff);
+    }
+}
+
+// Endpoints along the principal axis of the block's colours, then one
+// least-squares refinement. Always emits four-colour mode (c0 > c1)
+void encodeColorBlock(const uint8_t block[64], uint8_t* out) {
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) mean[c] += block[i * 4 + c];
+    }
+    for (int c = 0; c < 3; ++c) mean[c] /= 16.0f;
+
+    float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; ++i) {
+        float r = block[i * 4] - mean[0];
+        float g = block[i * 4 + 1] - mean[1];
+        float b = block[i * 4 + 2] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+        cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+    }
+
+    // Power iteration for the dominant eigenvector, seeded with the
+    // covariance column of the channel that varies most
+    float axis[3] = { cov[0], cov[1], cov[2] };
+    if (cov[3] >= cov[0] && cov[3] >= cov[5]) {
+        axis[0] = cov[1]; axis[1] = cov[3]; axis[2] = cov[4];
+    } else if (cov[5] >= cov[0] && cov[5] >= cov[3]) {
+        axis[0] = cov[2]; axis[1] = cov[4]; axis[2] = cov[5];
+    }
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float x = axis[0] * cov[0] + axis[1] * cov[1] + axis[2] * cov[2];
+        float y = axis[0] * cov[1] + axis[1] * cov[3] + axis[2] * cov[4];
+        float z = axis[0] * cov[2] + axis[1] * cov[4] + axis[2] * cov[5];
+        float length = std::max(std::fabs(x), std::max(std::fabs(y), std::fabs(z)));
+        if (length < 1e-6f) break;
+        axis[0] = x / length;
+        axis[1] = y / length;
+        axis[2] = z / length;
+    }
+    float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    if (axisLength < 1e-6f) {
+        // Flat block: a single colour
+        axis[0] = 1.0f; axis[1] = 0.0f; axis[2] = 0.0f;
+        axisLength = 1.0f;
+    }
+    for (int c = 0; c < 3; ++c) axis[c] /= axisLength;
+
+    float minT = 0.0f, maxT = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float t = (block[i * 4] - mean[0]) * axis[0] + (block[i * 4 + 1] - mean[1]) * axis[1] + (block[i * 4 + 2] - mean[2]) * axis[2];
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+    // Inset so the endpoints sit where the palette interpolants work best
+    float inset = (maxT - minT) / 16.0f;
+    float end0[3], end1[3];
+    for (int c = 0; c < 3; ++c) {
+        end0[c] = mean[c] + axis[c] * (maxT - inset);
+        end1[c] = mean[c] + axis[c] * (minT + inset);
+    }
+
+    uint16_t c0 = packColor565(end0);
+    uint16_t c1 = packColor565(end1);
+    if (c0 < c1) std::swap(c0, c1);
+    uint32_t indices = 0;
+    if (c0 == c1) {
+        writeColorBlock(c0, c1, 0, out);
+        return;
+    }
+    int error = assignColorIndices(block, c0, c1, indices);
+
+    float refined0[3], refined1[3];
+    if (refineEndpoints(block, indices, refined0, refined1)) {
+        uint16_t r0 = packColor565(refined0);
+        uint16_t r1 = packColor565(refined1);
+        if (r0 < r1) std::swap(r0, r1);
+        if (r0 != r1) {
+            uint32_t refinedIndices = 0;
+            int refinedError = assignColorIndices(block, r0, r1, refinedIndices);
+            if (refinedError < error) {
+                c0 = r0;
+                c1 = r1;
+                indices = refinedIndices;
+            }
+        }
+    }
+    writeColorBlock(c0, c1, indices, out);
+}
+
+void buildChannelPalette(int a0, int a1, int palette[8]) {
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1) {
+        for (int i = 1; i < 7; ++i) {
+            palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+        }
+    } else {
+        for (int i = 1; i < 5; ++i) {
+            palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+// BC4 block (BC3 alpha, each BC5 channel) from one byte of every pixel
+void encodeChannelBlock(const uint8_t block[64], int channel, uint8_t* out) {
+    int minValue = 255, maxValue = 0;
+    for (int i = 0; i < 16; ++i) {
+        minValue = std::min(minValue, static_cast<int>(block[i * 4 + channel]));
+        maxValue = std::max(maxValue, static_cast<int>(block[i * 4 + channel]));
+    }
+    out[0] = static_cast<uint8_t>(maxValue);
+    out[1] = static_cast<uint8_t>(minValue);
+
+    uint64_t bits = 0;
+    if (maxValue > minValue) {
+        int palette[8];
+        buildChannelPalette(maxValue, minValue, palette);
+        for (int i = 0; i < 16; ++i) {
+            int value = block[i * 4 + channel];
+            int best = 0;
+            int bestError = 256;
+            for (int p = 0; p < 8; ++p) {
+                int error = std::abs(value - palette[p]);
+                if (error < bestError) {
+                    bestError = error;
+                    best = p;
+                }
+            }
+            bits |= static_cast<uint64_t>(best) << (i * 3);
+        }
+    }
+    for (int i = 0; i < 6; ++i) {
+        out[2 + i] = static_cast<uint8_t>((bits >> (i * 8)) & 0xff);
+    }
+}
+
+void decodeColorBlock(const uint8_t* in, bool forceFourColor, uint8_t block[64]) {
+    uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+    uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+    uint32_t indices = in[4] | (in[5] << 8) | (in[6] << 16) | (static_cast<uint32_t>(in[7]) << 24);
+    int palette[4][4];
+    buildColorPalette(c0, c1, forceFourColor || c0 > c1, palette);
+    for (int i = 0; i < 16; ++i) {
+        const int* color = palette[(indices >> (i * 2)) & 3];
+        for (int c = 0; c < 4; ++c) block[i * 4 + c] = static_cast<uint8_t>(color[c]);
+    }
+}
+
+void decodeChannelBlock(const uint8_t* in, int channel, uint8_t block[64]) {
+    int palette[8];
+    buildChannelPalette(in[0], in[1], palette);
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i) {
+        bits |= static_cast<uint64_t>(in[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < 16; ++i) {
+        block[i * 4 + channel] = static_cast<uint8_t>(palette[(bits >> (i * 3)) & 7]);
+    }
+}
+
+uint8_t rebuildNormalZ(uint8_t r, uint8_t g) {
+    float x = r / 127.5f - 1.0f;
+    float y = g / 127.5f - 1.0f;
+    float z = std::sqrt(std::max(0.0f, 1.0f - x * x - y * y));
+    return static_cast<uint8_t>(z * 127.5f + 127.5f);
+}
+
+} // namespace
+
+const uint32_t TextureCooker::VERSION;
+const uint32_t TextureCooker::FLAG_NORMAL_MAP;
+const uint32_t TextureCooker::MAX_MIP_COUNT;
+
+void TextureCooker::generateMipChain(const Image& base, bool normalMap, std::vector<Image>& mips) {
+    mips.clear();
+    if (base.width <= 0 || base.height <= 0) return;
+    mips.push_back(base);
+
+    while (mips.back().width > 1 || mips.back().height > 1) {
+        const Image& source = mips.back();
+        Image level;
+        level.width = std::max(1, source.width / 2);
+        level.height = std::max(1, source.height / 2);
+        level.pixels.resize(static_cast<size_t>(level.width) * level.height * 4);
+
+        for (int y = 0; y < level.height; ++y) {
+            int y0 = std::min(y * 2, source.height - 1);
+            int y1 = std::min(y * 2 + 1, source.height - 1);
+            for (int x = 0; x < level.width; ++x) {
+                int x0 = std::min(x * 2, source.width - 1);
+                int x1 = std::min(x * 2 + 1, source.width - 1);
+                const uint8_t* taps[4] = {
+                    &source.pixels[(static_cast<size_t>(y0) * source.width + x0) * 4],
+                    &source.pixels[(static_cast<size_t>(y0) * source.width + x1) * 4],
+                    &source.pixels[(static_cast<size_t>(y1) * source.width + x0) * 4],
+                    &source.pixels[(static_cast<size_t>(y1) * source.width + x1) * 4]
+                };
+                uint8_t* out = &level.pixels[(static_cast<size_t>(y) * level.width + x) * 4];
+
+                if (normalMap) {
+                    float n[3] = { 0.0f, 0.0f, 0.0f };
+                    for (int t = 0; t < 4; ++t) {
+                        for (int c = 0; c < 3; ++c) n[c] += taps[t][c] / 127.5f - 1.0f;
+                    }
+                    float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                    if (length < 1e-6f) {
+                        n[0] = 0.0f; n[1] = 0.0f; n[2] = 1.0f;
+                        length = 1.0f;
+                    }
+                    for (int c = 0; c < 3; ++c) {
+                        out[c] = static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, (n[c] / length) * 127.5f + 127.5f + 0.5f)));
+                    }
+                    out[3] = static_cast<uint8_t>((taps[0][3] + taps[1][3] + taps[2][3] + taps[3][3] + 2) / 4);
+                } else {
+                    for (int c = 0; c < 4; ++c) {
+                        out[c] = static_cast<uint8_t>((taps[0][c] + taps[1][c] + taps[2][c] + taps[3][c] + 2) / 4);
+                    }
+                }
+            }
+        }
+        mips.push_back(level);
+    }
+}
+
+CookedTextureFormat TextureCooker::chooseFormat(const Image& image, bool normalMap, CookTarget target) {
+    if (normalMap) {
+        return (target == CookTarget::LINUX) ? CookedTextureFormat::BC5 : CookedTextureFormat::BC1;
+    }
+    for (size_t i = 3; i < image.pixels.size(); i += 4) {
+        if (image.pixels[i] != 255) return CookedTextureFormat::BC3;
+    }
+    return CookedTextureFormat::BC1;
+}
+
+size_t TextureCooker::getLevelSize(CookedTextureFormat format, uint32_t width, uint32_t height) {
+    size_t blocks = static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4);
+    switch (format) {
+        case CookedTextureFormat::BC1: return blocks * 8;
+        case CookedTextureFormat::BC3: return blocks * 16;
+        case CookedTextureFormat::BC5: return blocks * 16;
+        case CookedTextureFormat::RGBA8:
+        default: return static_cast<size_t>(width) * height * 4;
+    }
+}
+
+void TextureCooker::compress(const Image& image, CookedTextureFormat format, std::vector<uint8_t>& out) {
+    out.assign(getLevelSize(format, image.width, image.height), 0);
+    if (format == CookedTextureFormat::RGBA8) {
+        out = image.pixels;
+        return;
+    }
+
+    int blocksX = (image.width + 3) / 4;
+    int blocksY = (image.height + 3) / 4;
+    size_t blockBytes = (format == CookedTextureFormat::BC1) ? 8 : 16;
+    uint8_t block[64];
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            fetchBlock(image, bx, by, block);
+            uint8_t* dst = &out[(static_cast<size_t>(by) * blocksX + bx) * blockBytes];
+            switch (format) {
+                case CookedTextureFormat::BC1:
+                    encodeColorBlock(block, dst);
+                    break;
+                case CookedTextureFormat::BC3:
+                    encodeChannelBlock(block, 3, dst);
+                    encodeColorBlock(block, dst + 8);
+                    break;
+                case CookedTextureFormat::BC5:
+                    encodeChannelBlock(block, 0, dst);
+                    encodeChannelBlock(block, 1, dst + 8);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+bool TextureCooker::decompress(const uint8_t* data, size_t size, CookedTextureFormat format,
+                               uint32_t width, uint32_t height, std::vector<uint8_t>& rgba) {
+    if (size < getLevelSize(format, width, height)) return false;
+    rgba.resize(static_cast<size_t>(width) * height * 4);
+    if (format == CookedTextureFormat::RGBA8) {
+        std::memcpy(rgba.data(), data, rgba.size());
+        return true;
+    }
+
+    uint32_t blocksX = (width + 3) / 4;
+    uint32_t blocksY = (height + 3) / 4;
+    size_t blockBytes = (format == CookedTextureFormat::BC1) ? 8 : 16;
+    uint8_t block[64];
+    for (uint32_t by = 0; by < blocksY; ++by) {
+        for (uint32_t bx = 0; bx < blocksX; ++bx) {
+            const uint8_t* src = data + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+            switch (format) {
+                case CookedTextureFormat::BC1:
+                    decodeColorBlock(src, false, block);
+                    break;
+                case CookedTextureFormat::BC3:
+                    decodeColorBlock(src + 8, true, block);
+                    decodeChannelBlock(src, 3, block);
+                    break;
+                case CookedTextureFormat::BC5:
+                    decodeChannelBlock(src, 0, block);
+                    decodeChannelBlock(src + 8, 1, block);
+                    for (int i = 0; i < 16; ++i) {
+                        block[i * 4 + 2] = rebuildNormalZ(block[i * 4], block[i * 4 + 1]);
+                        block[i * 4 + 3] = 255;
+                    }
+                    break;
+                default:
+                    return false;
+            }
+            for (uint32_t y = 0; y < 4 && by * 4 + y < height; ++y) {
+                for (uint32_t x = 0; x < 4 && bx * 4 + x < width; ++x) {
+                    std::memcpy(&rgba[((by * 4 + y) * static_cast<size_t>(width) + bx * 4 + x) * 4], &block[(y * 4 + x) * 4], 4);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+size_t TextureCooker::getHeaderSize(uint32_t mipCount) {
+    return sizeof(CookedTextureHeader) + mipCount * sizeof(CookedMipLevel);
+}
+
+void TextureCooker::cook(const Image& image, CookedTextureFormat format, bool normalMap, std::vector<uint8_t>& file) {
+    std::vector<Image> mips;
+    generateMipChain(image, normalMap, mips);
+    if (mips.size() > MAX_MIP_COUNT) mips.resize(MAX_MIP_COUNT);
+
+    CookedTextureHeader header;
+    std::memcpy(header.magic, BTEX_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.width = static_cast<uint32_t>(image.width);
+    header.height = static_cast<uint32_t>(image.height);
+    header.mipCount = static_cast<uint32_t>(mips.size());
+    header.format = static_cast<uint32_t>(format);
+    header.flags = normalMap ? FLAG_NORMAL_MAP : 0;
+    header.reserved = 0;
+
+    std::vector<CookedMipLevel> table(mips.size());
+    std::vector<std::vector<uint8_t> > levels(mips.size());
+    size_t offset = getHeaderSize(header.mipCount);
+    for (size_t i = 0; i < mips.size(); ++i) {
+        compress(mips[i], format, levels[i]);
+        table[i].width = static_cast<uint32_t>(mips[i].width);
+        table[i].height = static_cast<uint32_t>(mips[i].height);
+        table[i].offset = static_cast<uint32_t>(offset);
+        table[i].size = static_cast<uint32_t>(levels[i].size());
+        offset += levels[i].size();
+    }
+
+    file.resize(offset);
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + sizeof(header), table.data(), table.size() * sizeof(CookedMipLevel));
+    for (size_t i = 0; i < levels.size(); ++i) {
+        std::memcpy(file.data() + table[i].offset, levels[i].data(), levels[i].size());
+    }
+}
+
+bool TextureCooker::parseHeader(const uint8_t* data, size_t size, CookedTextureHeader& header,
+                                std::vector<CookedMipLevel>& mips) {
+    if (size < sizeof(CookedTextureHeader)) return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, BTEX_MAGIC, sizeof(header.magic)) != 0) return false;
+    if (header.version != VERSION) return false;
+    if (header.mipCount == 0 || header.mipCount > MAX_MIP_COUNT) return false;
+    if (header.format > static_cast<uint32_t>(CookedTextureFormat::BC5)) return false;
+    if (size < getHeaderSize(header.mipCount)) return false;
+
+    mips.resize(header.mipCount);
+    std::memcpy(mips.data(), data + sizeof(header), mips.size() * sizeof(CookedMipLevel));
+
+    CookedTextureFormat format = static_cast<CookedTextureFormat>(header.format);
+    size_t expectedOffset = getHeaderSize(header.mipCount);
+    for (size_t i = 0; i < mips.size(); ++i) {
+        if (mips[i].width == 0 || mips[i].height == 0) return false;
+        if (mips[i].offset != expectedOffset) return false;
+        if (mips[i].size != getLevelSize(format, mips[i].width, mips[i].height)) return false;
+        expectedOffset += mips[i].size;
+    }
+    return mips[0].width == header.width && mips[0].height == header.height;
+}
+
+std::string TextureCooker::getCookedPath(const std::string& sourcePath) {
+    size_t slash = sourcePath.find_last_of("/\\");
+    size_t dot = sourcePath.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return sourcePath + ".btex";
+    }
+    return sourcePath.substr(0, dot) + ".btex";
+}
+
+bool TextureCooker::isNormalMapPath(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    return name.find("_nor") != std::string::npos;
+}
+
+const char* TextureCooker::getFormatName(CookedTextureFormat format) {
+    switch (format) {
+        case CookedTextureFormat::RGBA8: return "RGBA8";
+        case CookedTextureFormat::BC1: return "BC1";
+        case CookedTextureFormat::BC3: return "BC3";
+        case CookedTextureFormat::BC5: return "BC5";
+        default: return "unknown";
+    }
+}
+
+} // namespace GameEngine
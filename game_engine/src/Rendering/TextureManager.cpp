@@ -1,4 +1,5 @@
 #include "Rendering/TextureManager.h"
+#include "Rendering/ImageDecoder.h"
 #include <iostream>
 #include <algorithm>
 #include <fstream>
@@ -13,6 +14,27 @@
 
 namespace GameEngine {
 
+#ifdef LINUX_BUILD
+const size_t TextureManager::DEFAULT_MEMORY_BUDGET = 512 * 1024 * 1024;
+#else
+// Textures share the Vita's video memory with framebuffers and meshes
+const size_t TextureManager::DEFAULT_MEMORY_BUDGET = 48 * 1024 * 1024;
+#endif
+#ifdef LINUX_BUILD
+const size_t TextureManager::PRELOAD_BATCH_SIZE = 32;
+#else
+// Decoded RGBA is large next to the Vita's main memory; keep batches small
+const size_t TextureManager::PRELOAD_BATCH_SIZE = 6;
+#endif
+const size_t TextureManager::STREAM_BYTES_PER_FRAME = 2 * 1024 * 1024;
+const unsigned int TextureManager::STREAM_IN_FRAMES;
+
+TextureManager::TextureManager()
+    : memoryBudget(DEFAULT_MEMORY_BUDGET)
+    , frame(0)
+{
+}
+
 TextureManager& TextureManager::getInstance() {
     static TextureManager instance;
     return instance;
@@ -44,6 +66,57 @@ std::shared_ptr<Texture> TextureManager::getTexture(const std::string& filepath)
     return loadTexture(filepath);
 }
 
+void TextureManager::preloadTextures(const std::vector<std::string>& filepaths) {
+    std::vector<std::string> pending;
+    selectTexturesToDecode(filepaths, pending);
+    
+    for (size_t first = 0; first < pending.size(); first += PRELOAD_BATCH_SIZE) {
+        size_t last = std::min(pending.size(), first + PRELOAD_BATCH_SIZE);
+        std::vector<std::string> sources;
+        for (size_t i = first; i < last; ++i) {
+            sources.push_back(Texture::getSourcePath(pending[i]));
+        }
+        
+        std::vector<DecodedImage> images;
+        ImageDecoder::decodeAll(sources, images);
+        
+        for (size_t i = first; i < last; ++i) {
+            addDecodedTexture(pending[i], images[i - first]);
+        }
+    }
+}
+
+void TextureManager::selectTexturesToDecode(const std::vector<std::string>& filepaths, std::vector<std::string>& pending) {
+    pending.clear();
+    for (const auto& filepath : filepaths) {
+        if (filepath.empty() || textureCache.find(filepath) != textureCache.end()) {
+            continue;
+        }
+        if (std::find(pending.begin(), pending.end(), filepath) != pending.end()) {
+            continue;
+        }
+        // Cooked files only read their small initial mips, nothing to fan out
+        if (Texture::hasCookedVersion(filepath)) {
+            loadTexture(filepath);
+            continue;
+        }
+        pending.push_back(filepath);
+    }
+}
+
+void TextureManager::addDecodedTexture(const std::string& filepath, DecodedImage& image) {
+    auto texture = std::make_shared<Texture>();
+    if (texture->loadFromImage(filepath, image)) {
+        textureCache[filepath] = texture;
+        std::cout << "Cached texture: " << filepath << std::endl;
+    } else {
+        // Takes the regular path, which logs the failure or falls back to libpng
+        loadTexture(filepath);
+    }
+    // Release each image as soon as it is on the GPU
+    std::vector<uint8_t>().swap(image.pixels);
+}
+
 std::vector<std::string> TextureManager::discoverTextures(const std::string& directory) {
     discoveredTextures.clear();
     
@@ -95,6 +168,96 @@ void TextureManager::clearCache() {
     discoveredTextures.clear();
 }
 
+size_t TextureManager::getResidentBytes() const {
+    size_t total = 0;
+    for (const auto& entry : textureCache) {
+        total += entry.second->getResidentBytes();
+    }
+    return total;
+}
+
+void TextureManager::update() {
+    ++frame;
+    Texture::setCurrentFrame(frame);
+    
+    size_t resident = getResidentBytes();
+    if (resident > memoryBudget) {
+        resident = evict(resident);
+    }
+    streamIn(resident);
+}
+
+size_t TextureManager::evict(size_t residentBytes) {
+    // Least recently bound first
+    std::vector<std::pair<unsigned int, std::string>> order;
+    order.reserve(textureCache.size());
+    for (const auto& entry : textureCache) {
+        order.push_back(std::make_pair(entry.second->getLastUsedFrame(), entry.first));
+    }
+    std::sort(order.begin(), order.end());
+    
+    size_t released = 0;
+    for (size_t i = 0; i < order.size() && residentBytes > memoryBudget; ++i) {
+        auto it = textureCache.find(order[i].second);
+        if (it != textureCache.end() && it->second.use_count() == 1) {
+            residentBytes -= it->second->getResidentBytes();
+            textureCache.erase(it);
+            ++released;
+        }
+    }
+    
+    int droppedLevels = 0;
+    for (size_t i = 0; i < order.size() && residentBytes > memoryBudget; ++i) {
+        auto it = textureCache.find(order[i].second);
+        if (it == textureCache.end()) continue;
+        Texture& texture = *it->second;
+        while (residentBytes > memoryBudget && texture.isStreamed() &&
+               texture.getResidentMip() < texture.getStreamFloorMip()) {
+            size_t before = texture.getResidentBytes();
+            if (!texture.setResidentMip(texture.getResidentMip() + 1)) break;
+            residentBytes -= before - texture.getResidentBytes();
+            ++droppedLevels;
+        }
+    }
+    
+    if (released > 0 || droppedLevels > 0) {
+        std::cout << "TextureManager: Over budget, released " << released << " textures and "
+                  << droppedLevels << " mip levels (" << residentBytes / 1024 << " / "
+                  << memoryBudget / 1024 << " KB)" << std::endl;
+    }
+    return residentBytes;
+}
+
+void TextureManager::streamIn(size_t residentBytes) {
+    // Most recently bound first, one level per texture per frame
+    std::vector<std::pair<unsigned int, Texture*>> candidates;
+    for (const auto& entry : textureCache) {
+        Texture* texture = entry.second.get();
+        if (texture->isStreamed() && texture->getResidentMip() > 0 &&
+            frame - texture->getLastUsedFrame() <= STREAM_IN_FRAMES) {
+            candidates.push_back(std::make_pair(texture->getLastUsedFrame(), texture));
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const std::pair<unsigned int, Texture*>& a, const std::pair<unsigned int, Texture*>& b) {
+                  return a.first > b.first;
+              });
+    
+    size_t uploaded = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        Texture* texture = candidates[i].second;
+        int level = texture->getResidentMip() - 1;
+        size_t extra = texture->getMipChainBytes(level) - texture->getResidentBytes();
+        if (residentBytes + extra > memoryBudget) continue;
+        // Always allow one upload so large top levels still get through
+        if (uploaded > 0 && uploaded + extra > STREAM_BYTES_PER_FRAME) break;
+        if (texture->setResidentMip(level)) {
+            residentBytes += extra;
+            uploaded += extra;
+        }
+    }
+}
+
 bool TextureManager::discoverTexturesInDirectory(const std::string& directory) {
 #ifdef LINUX_BUILD
     try {
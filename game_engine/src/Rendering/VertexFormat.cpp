@@ -0,0 +1,333 @@
+#include "Rendering/VertexFormat.h"
+#include "Rendering/Mesh.h"
+#include "Rendering/RenderDevice.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace GameEngine {
+
+namespace {
+
+float sanitizeUnit(float value) {
+    if (!(value == value)) return 0.0f; // NaN from degenerate tangents
+    return std::max(-1.0f, std::min(1.0f, value));
+}
+
+template<typename T>
+void writeValue(uint8_t* dst, const T& value) {
+    std::memcpy(dst, &value, sizeof(T));
+}
+
+void writePackedDirection(uint8_t* dst, const glm::vec3& direction, const VertexAttribute& attribute) {
+    glm::vec4 value(direction, 1.0f);
+    if (attribute.size == 4 && attribute.type == GL_BYTE) {
+        int8_t packed[4];
+        VertexPacking::packSnorm8x4(value, packed);
+        std::memcpy(dst, packed, sizeof(packed));
+    } else {
+        writeValue(dst, VertexPacking::packSnorm1010102(value));
+    }
+}
+
+} // namespace
+
+namespace VertexPacking {
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t rawExponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (rawExponent == 0xFFu) {
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+    }
+
+    int32_t exponent = static_cast<int32_t>(rawExponent) - 127 + 15;
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (exponent <= 0) {
+        // Denormal half, or zero when too small
+        if (exponent < -10) return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000u;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        if ((mantissa >> (shift - 1)) & 1u) ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    // Round to nearest; a carry into the exponent is still the right value
+    if (mantissa & 0x1000u) ++half;
+    return static_cast<uint16_t>(half);
+}
+
+float halfToFloat(uint16_t value) {
+    uint32_t sign = (value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+
+    uint32_t bits;
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // Renormalize the denormal
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400u) == 0) {
+                mantissa <<= 1;
+                --exponent;
+            }
+            mantissa &= 0x3FFu;
+            bits = sign | (exponent << 23) | (mantissa << 13);
+        }
+    } else if (exponent == 0x1Fu) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+uint32_t packSnorm1010102(const glm::vec4& value) {
+    int32_t x = static_cast<int32_t>(std::lround(sanitizeUnit(value.x) * 511.0f));
+    int32_t y = static_cast<int32_t>(std::lround(sanitizeUnit(value.y) * 511.0f));
+    int32_t z = static_cast<int32_t>(std::lround(sanitizeUnit(value.z) * 511.0f));
+    int32_t w = static_cast<int32_t>(std::lround(sanitizeUnit(value.w)));
+
+    return (static_cast<uint32_t>(x) & 0x3FFu)
+         | ((static_cast<uint32_t>(y) & 0x3FFu) << 10)
+         | ((static_cast<uint32_t>(z) & 0x3FFu) << 20)
+         | ((static_cast<uint32_t>(w) & 0x3u) << 30);
+}
+
+glm::vec4 unpackSnorm1010102(uint32_t packed) {
+    // Sign-extend each field
+    int32_t x = static_cast<int32_t>(packed << 22) >> 22;
+    int32_t y = static_cast<int32_t>(packed << 12) >> 22;
+    int32_t z = static_cast<int32_t>(packed << 2) >> 22;
+    int32_t w = static_cast<int32_t>(packed) >> 30;
+    return glm::vec4(std::max(x / 511.0f, -1.0f),
+                     std::max(y / 511.0f, -1.0f),
+                     std::max(z / 511.0f, -1.0f),
+                     std::max(static_cast<float>(w), -1.0f));
+}
+
+void packSnorm8x4(const glm::vec4& value, int8_t out[4]) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<int8_t>(std::lround(sanitizeUnit(value[i]) * 127.0f));
+    }
+}
+
+void packWeights(const glm::vec4& weights, uint8_t out[4]) {
+    float total = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        total += std::max(weights[i], 0.0f);
+    }
+    if (total <= 0.0f) {
+        out[0] = out[1] = out[2] = out[3] = 0;
+        return;
+    }
+
+    int sum = 0;
+    int largest = 0;
+    for (int i = 0; i < 4; ++i) {
+        float normalized = std::max(weights[i], 0.0f) / total;
+        out[i] = static_cast<uint8_t>(std::lround(normalized * 255.0f));
+        sum += out[i];
+        if (weights[i] > weights[largest]) largest = i;
+    }
+    // Push the rounding error onto the dominant influence
+    out[largest] = static_cast<uint8_t>(out[largest] + (255 - sum));
+}
+
+} // namespace VertexPacking
+
+const VertexFormatSupport& VertexFormatSupport::get() {
+    static VertexFormatSupport support = []() {
+        VertexFormatSupport result;
+#ifdef LINUX_BUILD
+        result.halfFloat = GLEW_VERSION_3_0 || GLEW_ARB_half_float_vertex;
+        result.packed1010102 = GLEW_VERSION_3_3 || GLEW_ARB_vertex_type_2_10_10_10_rev;
+#else
+        // vitaGL maps GL_HALF_FLOAT to F16 attributes but has no packed 10-10-10-2 format
+    #ifdef GL_HALF_FLOAT
+        result.halfFloat = true;
+    #else
+        result.halfFloat = false;
+    #endif
+        result.packed1010102 = false;
+#endif
+        return result;
+    }();
+    return support;
+}
+
+VertexLayout::VertexLayout()
+    : format(VertexFormat::FULL)
+    , stride(0)
+{
+    for (int i = 0; i < ATTRIB_COUNT; ++i) {
+        attributes[i].enabled = false;
+        attributes[i].size = 0;
+        attributes[i].type = GL_FLOAT;
+        attributes[i].normalized = GL_FALSE;
+        attributes[i].offset = 0;
+    }
+}
+
+void VertexLayout::addAttribute(int slot, GLint size, GLenum type, GLboolean normalized, uint32_t bytes) {
+    VertexAttribute& attribute = attributes[slot];
+    attribute.enabled = true;
+    attribute.size = size;
+    attribute.type = type;
+    attribute.normalized = normalized;
+    attribute.offset = stride;
+    stride += bytes;
+}
+
+VertexLayout VertexLayout::create(VertexFormat format, const VertexFormatSupport& support) {
+    VertexLayout layout;
+
+    if (format == VertexFormat::AUTO || format == VertexFormat::FULL) {
+        layout.format = VertexFormat::FULL;
+        layout.addAttribute(ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3));
+        layout.addAttribute(ATTRIB_NORMAL, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3));
+        layout.addAttribute(ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2));
+        layout.addAttribute(ATTRIB_TANGENT, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3));
+        layout.addAttribute(ATTRIB_BONE_WEIGHTS, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4));
+        layout.addAttribute(ATTRIB_BONE_INDICES, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4));
+        return layout;
+    }
+
+    layout.format = format;
+    layout.addAttribute(ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3));
+
+    GLenum directionType = GL_BYTE;
+#ifdef GL_INT_2_10_10_10_REV
+    if (support.packed1010102) directionType = GL_INT_2_10_10_10_REV;
+#endif
+    layout.addAttribute(ATTRIB_NORMAL, 4, directionType, GL_TRUE, 4);
+
+#ifdef GL_HALF_FLOAT
+    if (support.halfFloat) {
+        layout.addAttribute(ATTRIB_TEXCOORD, 2, GL_HALF_FLOAT, GL_FALSE, 2 * sizeof(uint16_t));
+    } else
+#endif
+    {
+        layout.addAttribute(ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2));
+    }
+
+    layout.addAttribute(ATTRIB_TANGENT, 4, directionType, GL_TRUE, 4);
+
+    if (format == VertexFormat::SKINNED_COMPACT) {
+        layout.addAttribute(ATTRIB_BONE_WEIGHTS, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4);
+        // Not normalized, so the shader still reads whole-number float indices
+        layout.addAttribute(ATTRIB_BONE_INDICES, 4, GL_UNSIGNED_BYTE, GL_FALSE, 4);
+    }
+    return layout;
+}
+
+VertexFormat VertexLayout::choose(VertexFormat requested, const std::vector<Vertex>& vertices) {
+    if (requested == VertexFormat::FULL || vertices.empty()) {
+        return VertexFormat::FULL;
+    }
+
+    // Bone data shared by every vertex can be supplied as a constant
+    // attribute, so such meshes take the static layout even when rigged
+    const Vertex& first = vertices[0];
+    bool constantBones = true;
+    float minIndex = 0.0f;
+    float maxIndex = 0.0f;
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex& vertex = vertices[i];
+        if (vertex.boneWeights != first.boneWeights || vertex.boneIndices != first.boneIndices) {
+            constantBones = false;
+        }
+        for (int c = 0; c < 4; ++c) {
+            minIndex = std::min(minIndex, vertex.boneIndices[c]);
+            maxIndex = std::max(maxIndex, vertex.boneIndices[c]);
+        }
+    }
+
+    if (constantBones && requested != VertexFormat::SKINNED_COMPACT) {
+        return VertexFormat::STATIC_COMPACT;
+    }
+    if (minIndex < 0.0f || maxIndex > 255.0f) {
+        return VertexFormat::FULL;
+    }
+    return VertexFormat::SKINNED_COMPACT;
+}
+
+void VertexLayout::pack(const std::vector<Vertex>& vertices, std::vector<uint8_t>& out) const {
+    out.assign(vertices.size() * stride, 0);
+    if (format == VertexFormat::FULL) {
+        // Vertex is all floats, so the full layout is its exact memory image
+        if (!vertices.empty()) {
+            std::memcpy(out.data(), vertices.data(), out.size());
+        }
+        return;
+    }
+
+    const VertexAttribute& position = attributes[ATTRIB_POSITION];
+    const VertexAttribute& normal = attributes[ATTRIB_NORMAL];
+    const VertexAttribute& texCoord = attributes[ATTRIB_TEXCOORD];
+    const VertexAttribute& tangent = attributes[ATTRIB_TANGENT];
+    const VertexAttribute& weights = attributes[ATTRIB_BONE_WEIGHTS];
+    const VertexAttribute& boneIndices = attributes[ATTRIB_BONE_INDICES];
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        const Vertex& vertex = vertices[i];
+        uint8_t* dst = &out[i * stride];
+
+        writeValue(dst + position.offset, vertex.position);
+        writePackedDirection(dst + normal.offset, vertex.normal, normal);
+        writePackedDirection(dst + tangent.offset, vertex.tangent, tangent);
+
+        if (texCoord.type == GL_FLOAT) {
+            writeValue(dst + texCoord.offset, vertex.texCoords);
+        } else {
+            uint16_t uv[2] = {
+                VertexPacking::floatToHalf(vertex.texCoords.x),
+                VertexPacking::floatToHalf(vertex.texCoords.y)
+            };
+            std::memcpy(dst + texCoord.offset, uv, sizeof(uv));
+        }
+
+        if (weights.enabled) {
+            uint8_t packedWeights[4];
+            VertexPacking::packWeights(vertex.boneWeights, packedWeights);
+            std::memcpy(dst + weights.offset, packedWeights, sizeof(packedWeights));
+        }
+        if (boneIndices.enabled) {
+            uint8_t packedIndices[4];
+            for (int c = 0; c < 4; ++c) {
+                packedIndices[c] = static_cast<uint8_t>(std::lround(vertex.boneIndices[c]));
+            }
+            std::memcpy(dst + boneIndices.offset, packedIndices, sizeof(packedIndices));
+        }
+    }
+}
+
+void VertexLayout::applyAttributes() const {
+    auto& device = RenderDevice::getInstance();
+    for (int i = 0; i < ATTRIB_COUNT; ++i) {
+        const VertexAttribute& attribute = attributes[i];
+        if (!attribute.enabled) {
+            device.disableVertexAttribArray(i);
+            continue;
+        }
+        device.enableVertexAttribArray(i);
+        device.vertexAttribPointer(i, attribute.size, attribute.type, attribute.normalized,
+                              stride, reinterpret_cast<void*>(static_cast<uintptr_t>(attribute.offset)));
+    }
+}
+
+} // namespace GameEngine
@@ -0,0 +1,300 @@
+#include "Scene/PrefabLibrary.h"
+#include "Scene/SceneJsonReader.h"
+#include "Scene/SceneNode.h"
+#include "Editor/SceneSerializer.h"
+#include "Rendering/Material.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef LINUX_BUILD
+#include <iostream>
+#else
+#include <cstdio>
+#endif
+
+namespace GameEngine {
+
+namespace {
+
+// Node i's subtree is [i, ends[i]); nodes are in depth-first order
+std::vector<size_t> getSubtreeEnds(const SceneDescription& description) {
+    const size_t count = description.nodes.size();
+    std::vector<size_t> ends(count);
+    for (size_t i = 0; i < count; ++i) {
+        ends[i] = i + 1;
+    }
+    for (size_t i = count; i-- > 1;) {
+        size_t parent = static_cast<size_t>(description.nodes[i].parent);
+        ends[parent] = std::max(ends[parent], ends[i]);
+    }
+    return ends;
+}
+
+void reportPrefabError(const std::string& path, const char* reason) {
+#ifdef VITA_BUILD
+    printf("Prefab %s: %s\n", path.c_str(), reason);
+#else
+    std::cerr << "Prefab " << path << ": " << reason << std::endl;
+#endif
+}
+
+// Rebuilds a description node by node into `out`, replacing instances with
+// their merged prefab subtree
+class InstanceExpander {
+public:
+    InstanceExpander(PrefabLibrary& library, const SceneDescription& source, SceneDescription& out)
+        : library(library), source(source), out(out), sourceEnds(getSubtreeEnds(source)) {}
+
+    void copyNode(size_t index, int32_t parent) {
+        const SceneNodeRecord& record = source.nodes[index];
+        if (record.prefab != SceneDescription::NO_STRING) {
+            std::string path = source.getString(record.prefab);
+            const SceneDescription* prefab = library.getPrefab(path);
+            if (prefab && !prefab->nodes.empty()) {
+                std::vector<size_t> prefabEnds = getSubtreeEnds(*prefab);
+                merge(*prefab, prefabEnds, 0, static_cast<int32_t>(index), parent, record.prefab);
+                return;
+            }
+            // Kept as written, still naming its prefab so a save doesn't lose it
+        }
+
+        int32_t node = beginNode(out.importNode(source, record), parent);
+        for (uint32_t c = 0; c < record.componentCount; ++c) {
+            addComponent(out.importComponent(source, source.components[record.firstComponent + c]), node);
+        }
+        for (size_t child = index + 1; child < sourceEnds[index]; child = sourceEnds[child]) {
+            copyNode(child, node);
+        }
+    }
+
+private:
+    // Prefab node `index` with source node `overrideIndex` (-1 for none)
+    // applied. `prefabPath` is set for an instance root
+    void merge(const SceneDescription& prefab, const std::vector<size_t>& prefabEnds, size_t index,
+               int32_t overrideIndex, int32_t parent, uint32_t prefabPath) {
+        const SceneNodeRecord& base = prefab.nodes[index];
+        SceneNodeRecord record = out.importNode(prefab, base);
+        if (prefabPath != SceneDescription::NO_STRING) {
+            record.prefab = out.addString(source.getString(prefabPath));
+        }
+        const SceneNodeRecord* overrides = overrideIndex >= 0 ? &source.nodes[overrideIndex] : nullptr;
+        if (overrides) {
+            applyNodeOverride(record, *overrides);
+        }
+        int32_t node = beginNode(record, parent);
+
+        // Components: the k-th override of a type merges into the k-th
+        // prefab component of that type
+        std::vector<bool> usedComponents(overrides ? overrides->componentCount : 0, false);
+        for (uint32_t c = 0; c < base.componentCount; ++c) {
+            const SceneComponentRecord& templateRecord = prefab.components[base.firstComponent + c];
+            SceneComponentRecord component = out.importComponent(prefab, templateRecord);
+            component.origin |= SceneComponentRecord::FROM_PREFAB;
+
+            if (overrides) {
+                uint32_t ordinal = 0;
+                for (uint32_t k = 0; k < c; ++k) {
+                    if (prefab.components[base.firstComponent + k].type == templateRecord.type) ordinal++;
+                }
+                for (uint32_t o = 0; o < overrides->componentCount; ++o) {
+                    const SceneComponentRecord& candidate = source.components[overrides->firstComponent + o];
+                    if (candidate.type != templateRecord.type) continue;
+                    if (ordinal-- == 0) {
+                        SceneDescription::applyOverride(component, out.importComponent(source, candidate));
+                        component.origin &= ~static_cast<uint16_t>(SceneComponentRecord::FROM_PREFAB);
+                        usedComponents[o] = true;
+                        break;
+                    }
+                }
+            }
+            addComponent(component, node);
+        }
+        for (uint32_t o = 0; o < usedComponents.size(); ++o) {
+            if (!usedComponents[o]) {
+                addComponent(out.importComponent(source, source.components[overrides->firstComponent + o]), node);
+            }
+        }
+
+        // Children: overrides match prefab children by name. An override
+        // child that names a prefab of its own is a new instance, not a match
+        std::vector<size_t> overrideChildren;
+        if (overrides) {
+            for (size_t child = overrideIndex + 1; child < sourceEnds[overrideIndex]; child = sourceEnds[child]) {
+                overrideChildren.push_back(child);
+            }
+        }
+        std::vector<bool> usedChildren(overrideChildren.size(), false);
+        for (size_t child = index + 1; child < prefabEnds[index]; child = prefabEnds[child]) {
+            std::string name = prefab.getString(prefab.nodes[child].name);
+            int32_t match = -1;
+            for (size_t o = 0; o < overrideChildren.size() && match < 0; ++o) {
+                const SceneNodeRecord& candidate = source.nodes[overrideChildren[o]];
+                if (!usedChildren[o] && candidate.prefab == SceneDescription::NO_STRING &&
+                    source.getString(candidate.name) == name) {
+                    usedChildren[o] = true;
+                    match = static_cast<int32_t>(overrideChildren[o]);
+                }
+            }
+            merge(prefab, prefabEnds, child, match, node, SceneDescription::NO_STRING);
+        }
+        for (size_t o = 0; o < overrideChildren.size(); ++o) {
+            if (!usedChildren[o]) {
+                copyNode(overrideChildren[o], node);
+            }
+        }
+    }
+
+    void applyNodeOverride(SceneNodeRecord& record, const SceneNodeRecord& overrides) {
+        record.name = out.addString(source.getString(overrides.name));
+        if (overrides.flags & SceneNodeRecord::HAS_POSITION) {
+            std::memcpy(record.position, overrides.position, sizeof(record.position));
+        }
+        if (overrides.flags & SceneNodeRecord::HAS_ROTATION) {
+            std::memcpy(record.rotation, overrides.rotation, sizeof(record.rotation));
+        }
+        if (overrides.flags & SceneNodeRecord::HAS_SCALE) {
+            std::memcpy(record.scale, overrides.scale, sizeof(record.scale));
+        }
+        if (overrides.flags & SceneNodeRecord::HAS_VISIBLE) {
+            record.flags = (record.flags & ~static_cast<uint32_t>(SceneNodeRecord::VISIBLE)) |
+                           (overrides.flags & SceneNodeRecord::VISIBLE);
+        }
+        if (overrides.flags & SceneNodeRecord::HAS_ACTIVE) {
+            record.flags = (record.flags & ~static_cast<uint32_t>(SceneNodeRecord::ACTIVE)) |
+                           (overrides.flags & SceneNodeRecord::ACTIVE);
+        }
+        record.flags |= overrides.flags & (SceneNodeRecord::HAS_POSITION | SceneNodeRecord::HAS_ROTATION |
+                                           SceneNodeRecord::HAS_SCALE | SceneNodeRecord::HAS_VISIBLE |
+                                           SceneNodeRecord::HAS_ACTIVE);
+    }
+
+    int32_t beginNode(SceneNodeRecord record, int32_t parent) {
+        record.parent = parent;
+        record.firstComponent = static_cast<uint32_t>(out.components.size());
+        record.componentCount = 0;
+        out.nodes.push_back(record);
+        return static_cast<int32_t>(out.nodes.size() - 1);
+    }
+
+    void addComponent(const SceneComponentRecord& record, int32_t node) {
+        out.components.push_back(record);
+        out.nodes[node].componentCount++;
+    }
+
+    PrefabLibrary& library;
+    const SceneDescription& source;
+    SceneDescription& out;
+    std::vector<size_t> sourceEnds;
+};
+
+} // namespace
+
+PrefabLibrary& PrefabLibrary::getInstance() {
+    static PrefabLibrary instance;
+    return instance;
+}
+
+const SceneDescription* PrefabLibrary::getPrefab(const std::string& path) {
+    auto it = prefabs.find(path);
+    if (it != prefabs.end()) {
+        return it->second.get();
+    }
+    if (std::find(loading.begin(), loading.end(), path) != loading.end()) {
+        reportPrefabError(path, "instances itself");
+        return nullptr;
+    }
+
+    std::vector<uint8_t> data;
+    std::unique_ptr<SceneDescription> prefab(new SceneDescription());
+    loading.push_back(path);
+    bool loaded = SceneSerializer::readSceneFile(path, data) &&
+                  SceneJsonReader::read(std::string(data.begin(), data.end()), *prefab) && !prefab->nodes.empty();
+    loading.pop_back();
+
+    if (!loaded) {
+        reportPrefabError(path, "failed to load");
+        prefab.reset();
+    }
+    const SceneDescription* result = prefab.get();
+    prefabs[path] = std::move(prefab);
+    return result;
+}
+
+void PrefabLibrary::expandInstances(SceneDescription& description) {
+    bool hasInstances = false;
+    for (const auto& node : description.nodes) {
+        hasInstances = hasInstances || node.prefab != SceneDescription::NO_STRING;
+    }
+    if (!hasInstances) {
+        return;
+    }
+
+    SceneDescription expanded;
+    auto copyString = [&](uint32_t index) {
+        return index != SceneDescription::NO_STRING ? expanded.addString(description.getString(index))
+                                                    : SceneDescription::NO_STRING;
+    };
+    expanded.name = copyString(description.name);
+    expanded.activeCamera = copyString(description.activeCamera);
+    expanded.activeSkybox = copyString(description.activeSkybox);
+
+    InstanceExpander(*this, description, expanded).copyNode(0, -1);
+    description = std::move(expanded);
+}
+
+std::shared_ptr<SceneNode> PrefabLibrary::instantiate(const std::string& instanceJson) {
+    SceneDescription description;
+    if (!SceneJsonReader::read("{\"rootNode\":" + instanceJson + "}", description) || description.nodes.empty()) {
+        return nullptr;
+    }
+    return description.instantiateNode();
+}
+
+std::shared_ptr<SceneNode> PrefabLibrary::instantiatePrefab(const std::string& path, const std::string& name) {
+    const SceneDescription* prefab = getPrefab(path);
+    if (!prefab) {
+        return nullptr;
+    }
+
+    nlohmann::json instance;
+    instance["name"] = name.empty() ? prefab->getString(prefab->nodes[0].name) : name;
+    instance["prefab"] = path;
+    return instantiate(instance.dump());
+}
+
+void PrefabLibrary::reload(const std::string& path) {
+    prefabs.erase(path);
+}
+
+void PrefabLibrary::clear() {
+    prefabs.clear();
+}
+
+std::shared_ptr<Mesh> PrefabLibrary::getSharedMesh(MeshType type) const {
+    auto it = sharedMeshes.find(static_cast<int>(type));
+    return it != sharedMeshes.end() ? it->second.lock() : nullptr;
+}
+
+void PrefabLibrary::setSharedMesh(MeshType type, const std::shared_ptr<Mesh>& mesh) {
+    sharedMeshes[static_cast<int>(type)] = mesh;
+}
+
+std::shared_ptr<Material> PrefabLibrary::getSharedMaterial(const std::string& key) const {
+    auto it = sharedMaterials.find(key);
+    return it != sharedMaterials.end() ? it->second.lock() : nullptr;
+}
+
+void PrefabLibrary::setSharedMaterial(const std::string& key, const std::shared_ptr<Material>& material) {
+    // Expired entries go as new ones arrive, so the map stays as large as
+    // the set of live materials
+    for (auto it = sharedMaterials.begin(); it != sharedMaterials.end();) {
+        if (it->second.expired()) {
+            it = sharedMaterials.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    sharedMaterials[key] = material;
+}
+
+} // namespace GameEngine
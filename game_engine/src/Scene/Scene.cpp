@@ -4,12 +4,15 @@
 #include "Components/CameraComponent.h"
 #include "Components/SkyboxComponent.h"
 #include "Core/Engine.h"
+#include "Core/ScriptManager.h"
+#include "Core/MenuManager.h"
 
 namespace GameEngine {
 
 Scene::Scene(const std::string& name)
     : name(name)
     , nodeCounter(0)
+    , nameIndexVersion(0)
 {
     rootNode = std::make_shared<SceneNode>("Root");
 }
@@ -42,13 +45,38 @@ void Scene::removeNode(const std::string& nodeName) {
 }
 
 std::shared_ptr<SceneNode> Scene::findNode(const std::string& nodeName) {
-    if (!rootNode) return nullptr;
+    SceneNode* node = SceneNode::resolve(findNodeHandle(nodeName));
+    return node ? node->shared_from_this() : nullptr;
+}
+
+NodeHandle Scene::findNodeHandle(const std::string& nodeName) {
+    if (!rootNode) return NodeHandle();
     
-    if (rootNode->getName() == nodeName) {
-        return rootNode;
+    if (nameIndexVersion != rootNode->getHierarchyVersion()) {
+        rebuildNameIndex();
     }
     
-    return rootNode->findByName(nodeName, true);
+    auto it = nameIndex.find(nodeName);
+    return it != nameIndex.end() ? it->second : NodeHandle();
+}
+
+void Scene::rebuildNameIndex() {
+    nameIndex.clear();
+    nameIndex.emplace(rootNode->getName(), rootNode->getHandle());
+    indexChildren(rootNode.get());
+    nameIndexVersion = rootNode->getHierarchyVersion();
+}
+
+void Scene::indexChildren(SceneNode* node) {
+    // Same order as SceneNode::findByName: direct children first, then each subtree;
+    // emplace keeps the first node seen for a duplicated name
+    for (size_t i = 0; i < node->getChildCount(); ++i) {
+        auto child = node->getChild(i);
+        nameIndex.emplace(child->getName(), child->getHandle());
+    }
+    for (size_t i = 0; i < node->getChildCount(); ++i) {
+        indexChildren(node->getChild(i).get());
+    }
 }
 
 std::vector<std::shared_ptr<SceneNode>> Scene::findNodesByTag(const std::string& tag) {
@@ -65,6 +93,10 @@ void Scene::start() {
 
 void Scene::update(float deltaTime) {
     if (rootNode) {
+        // Scripts run first, in one batch, so components see this frame's script writes
+        bool paused = MenuManager::getInstance().isGamePaused();
+        ScriptManager::getInstance().updateScriptComponents(rootNode.get(), deltaTime, paused);
+        
         rootNode->update(deltaTime);
     }
 }
@@ -92,6 +124,11 @@ void Scene::destroy() {
 }
 
 void Scene::render(Renderer& renderer) {
+    capture(renderer);
+    renderer.submitScene();
+}
+
+void Scene::capture(Renderer& renderer) {
     auto activeGameCamera = getActiveGameCamera();
     if (activeGameCamera) {
         auto cameraComponent = activeGameCamera->getComponent<CameraComponent>();
@@ -100,7 +137,7 @@ void Scene::render(Renderer& renderer) {
         }
     }
     
-    renderer.renderScene(*this);
+    renderer.captureScene(*this);
 }
 
 void Scene::setActiveCamera(std::shared_ptr<SceneNode> cameraNode) {
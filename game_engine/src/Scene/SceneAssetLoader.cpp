@@ -0,0 +1,198 @@
+#include "Scene/SceneAssetLoader.h"
+#include "Scene/SceneDescription.h"
+#include "Components/ModelRenderer.h"
+#include "Rendering/TextureManager.h"
+#include "Rendering/ImageDecoder.h"
+#include "Rendering/Texture.h"
+#include "Audio/AudioManager.h"
+#include "Audio/AudioClip.h"
+#include "Core/Profiler.h"
+#include "Physics/ParallelFor.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace GameEngine {
+
+namespace {
+
+// A job is a whole file; one per task keeps every worker busy
+const int ASSET_GRAIN_SIZE = 1;
+
+// Node progress is reported about this many times per load
+const size_t NODE_REPORTS = 100;
+
+struct AssetJob {
+    enum Kind { MODEL, SOUND, TEXTURE };
+    Kind kind;
+    size_t index;                   // into the list of that kind
+};
+
+struct AssetBody : public btIParallelForBody {
+    const AssetJob* jobs;
+    const std::vector<std::string>* modelPaths;
+    const std::vector<std::string>* soundPaths;
+    const std::vector<std::string>* texturePaths;
+    std::vector<PreparedModel>* models;
+    std::vector<std::shared_ptr<const AudioClip>>* clips;
+    std::vector<DecodedImage>* images;
+    size_t firstTexture;            // texture index held by images[0]
+
+    void forLoop(int iBegin, int iEnd) const BT_OVERRIDE {
+        for (int i = iBegin; i < iEnd; ++i) {
+            const AssetJob& job = jobs[i];
+            switch (job.kind) {
+                case AssetJob::MODEL: {
+                    PROFILE_ZONE("SceneAssetLoader::prepareModel");
+                    ModelRenderer::prepareModel((*modelPaths)[job.index], (*models)[job.index]);
+                    break;
+                }
+                case AssetJob::SOUND: {
+                    PROFILE_ZONE("SceneAssetLoader::preloadClip");
+                    (*clips)[job.index] = AudioManager::getInstance().preloadClip((*soundPaths)[job.index]);
+                    break;
+                }
+                case AssetJob::TEXTURE: {
+                    PROFILE_ZONE("SceneAssetLoader::decodeTexture");
+                    ImageDecoder::decode(Texture::getSourcePath((*texturePaths)[job.index]),
+                                         (*images)[job.index - firstTexture]);
+                    break;
+                }
+            }
+        }
+    }
+};
+
+void addUnique(const std::string& path, std::unordered_set<std::string>& seen, std::vector<std::string>& paths) {
+    if (!path.empty() && seen.insert(path).second) {
+        paths.push_back(path);
+    }
+}
+
+} // namespace
+
+SceneAssetLoader::SceneAssetLoader(const SceneLoadCallback& callback)
+    : callback(callback)
+    , jobCount(0)
+    , nodeCount(0)
+{
+}
+
+SceneAssetLoader::~SceneAssetLoader() {
+    // Only left over if a node never asked for its model
+    ModelRenderer::clearPreparedModels();
+}
+
+void SceneAssetLoader::load(const SceneDescription& description) {
+    PROFILE_ZONE("SceneAssetLoader::load");
+    nodeCount = description.nodes.size();
+
+    std::vector<std::string> modelPaths;
+    std::vector<std::string> soundPaths;
+    std::unordered_set<std::string> seenModels;
+    std::unordered_set<std::string> seenSounds;
+    for (const auto& record : description.components) {
+        if (record.type == static_cast<uint16_t>(SceneComponentType::MODEL_RENDERER) &&
+            record.modelRenderer.modelPath != SceneDescription::NO_STRING) {
+            std::string path = description.getString(record.modelRenderer.modelPath);
+            if (ModelRenderer::canPrepareModel(path) && !ModelRenderer::hasCachedModel(path)) {
+                addUnique(path, seenModels, modelPaths);
+            }
+        } else if (record.type == static_cast<uint16_t>(SceneComponentType::SOUND) &&
+                   record.sound.soundFile != SceneDescription::NO_STRING) {
+            addUnique(description.getString(record.sound.soundFile), seenSounds, soundPaths);
+        }
+    }
+
+    auto& textureManager = TextureManager::getInstance();
+    std::vector<std::string> texturePaths;
+    std::vector<std::string> allTextures;
+    description.collectTexturePaths(allTextures);
+    textureManager.selectTexturesToDecode(allTextures, texturePaths);
+
+    // Models are the slowest jobs, so they go first
+    std::vector<AssetJob> jobs;
+    for (size_t i = 0; i < modelPaths.size(); ++i) {
+        AssetJob job = { AssetJob::MODEL, i };
+        jobs.push_back(job);
+    }
+    for (size_t i = 0; i < soundPaths.size(); ++i) {
+        AssetJob job = { AssetJob::SOUND, i };
+        jobs.push_back(job);
+    }
+    for (size_t i = 0; i < texturePaths.size(); ++i) {
+        AssetJob job = { AssetJob::TEXTURE, i };
+        jobs.push_back(job);
+    }
+    jobCount = jobs.size();
+
+    std::vector<PreparedModel> models(modelPaths.size());
+    clips.assign(soundPaths.size(), std::shared_ptr<const AudioClip>());
+
+    AssetBody body;
+    body.jobs = jobs.data();
+    body.modelPaths = &modelPaths;
+    body.soundPaths = &soundPaths;
+    body.texturePaths = &texturePaths;
+    body.models = &models;
+    body.clips = &clips;
+
+    // Batches bound the decoded images held at once; prepared models wait
+    // for their nodes
+    const size_t batchSize = TextureManager::getPreloadBatchSize();
+    report(SceneLoadProgress::LOADING_ASSETS, 0, jobCount);
+    for (size_t first = 0; first < jobs.size(); first += batchSize) {
+        size_t last = std::min(jobs.size(), first + batchSize);
+
+        size_t firstTexture = texturePaths.size();
+        size_t textureEnd = 0;
+        for (size_t i = first; i < last; ++i) {
+            if (jobs[i].kind == AssetJob::TEXTURE) {
+                firstTexture = std::min(firstTexture, jobs[i].index);
+                textureEnd = jobs[i].index + 1;
+            }
+        }
+        std::vector<DecodedImage> images(textureEnd > firstTexture ? textureEnd - firstTexture : 0);
+        body.images = &images;
+        body.firstTexture = firstTexture;
+
+        parallelForOrInline(static_cast<int>(first), static_cast<int>(last), ASSET_GRAIN_SIZE, body);
+
+        for (size_t i = 0; i < images.size(); ++i) {
+            textureManager.addDecodedTexture(texturePaths[firstTexture + i], images[i]);
+        }
+        report(SceneLoadProgress::LOADING_ASSETS, last, jobCount);
+    }
+
+    for (auto& model : models) {
+        ModelRenderer::addPreparedModel(model);
+    }
+}
+
+void SceneAssetLoader::reportNodes(size_t created) {
+    size_t step = std::max<size_t>(1, nodeCount / NODE_REPORTS);
+    if (created % step == 0 || created == nodeCount) {
+        report(SceneLoadProgress::CREATING_NODES, created, nodeCount);
+    }
+}
+
+void SceneAssetLoader::reportDone() {
+    report(SceneLoadProgress::DONE, nodeCount, nodeCount);
+}
+
+void SceneAssetLoader::report(SceneLoadProgress::Phase phase, size_t completed, size_t total) const {
+    if (!callback) {
+        return;
+    }
+
+    size_t done = (phase == SceneLoadProgress::LOADING_ASSETS) ? completed : jobCount + completed;
+    size_t steps = jobCount + nodeCount;
+
+    SceneLoadProgress progress;
+    progress.phase = phase;
+    progress.completed = completed;
+    progress.total = total;
+    progress.fraction = steps > 0 ? std::min(1.0f, static_cast<float>(done) / steps) : 1.0f;
+    callback(progress);
+}
+
+} // namespace GameEngine
@@ -0,0 +1,786 @@
+#include "Scene/SceneDescription.h"
+#include "Scene/Scene.h"
+#include "Scene/SceneNode.h"
+#include "Scene/PrefabLibrary.h"
+#include "Components/CameraComponent.h"
+#include "Components/MeshRenderer.h"
+#include "Components/ModelRenderer.h"
+#include "Components/LightComponent.h"
+#include "Components/PhysicsComponent.h"
+#include "Components/TextComponent.h"
+#include "Components/ScriptComponent.h"
+#include "Components/Area3DComponent.h"
+#include "Components/AnimationComponent.h"
+#include "Components/SoundComponent.h"
+#include "Components/SkyboxComponent.h"
+#include "Rendering/Mesh.h"
+#include "Rendering/Material.h"
+#include "Rendering/TextureManager.h"
+#include "Core/Log.h"
+#include <cstring>
+
+namespace GameEngine {
+
+namespace {
+
+const char BSCENE_MAGIC[4] = { 'B', 'S', 'C', 'N' };
+
+static_assert(sizeof(SceneNodeRecord) == 60, "SceneNodeRecord is part of the .bscene format");
+static_assert(sizeof(SceneComponentRecord) == 56, "SceneComponentRecord is part of the .bscene format");
+static_assert(sizeof(BinarySceneHeader) == 40, "BinarySceneHeader is part of the .bscene format");
+
+glm::vec3 toVec3(const float* values) {
+    return glm::vec3(values[0], values[1], values[2]);
+}
+
+std::shared_ptr<Mesh> createMesh(MeshType type) {
+    switch (type) {
+        case MeshType::QUAD: return Mesh::createQuad();
+        case MeshType::PLANE: return Mesh::createPlane(1.0f, 1.0f, 1);
+        case MeshType::SPHERE: return Mesh::createSphere(32, 16);
+        case MeshType::CAPSULE: return Mesh::createCapsule(0.5f, 0.5f);
+        case MeshType::CYLINDER: return Mesh::createCylinder(0.5f, 1.0f);
+        default: return Mesh::createCube();
+    }
+}
+
+// Every string index a record holds
+size_t getStringIndices(SceneComponentRecord& record, uint32_t* out[6]) {
+    switch (static_cast<SceneComponentType>(record.type)) {
+        case SceneComponentType::MESH_RENDERER:
+            out[0] = &record.meshRenderer.diffuseTexture;
+            out[1] = &record.meshRenderer.normalTexture;
+            out[2] = &record.meshRenderer.armTexture;
+            return 3;
+        case SceneComponentType::MODEL_RENDERER:
+            out[0] = &record.modelRenderer.modelPath;
+            return 1;
+        case SceneComponentType::TEXT:
+            out[0] = &record.text.text;
+            out[1] = &record.text.fontPath;
+            return 2;
+        case SceneComponentType::SCRIPT:
+            out[0] = &record.script.scriptPath;
+            return 1;
+        case SceneComponentType::SOUND:
+            out[0] = &record.sound.soundFile;
+            return 1;
+        case SceneComponentType::SKYBOX:
+            for (int i = 0; i < 6; ++i) {
+                out[i] = &record.skybox.faces[i];
+            }
+            return 6;
+        case SceneComponentType::AREA3D:
+            out[0] = &record.area3D.group;
+            return 1;
+        case SceneComponentType::ANIMATION:
+            out[0] = &record.animation.skeletonName;
+            out[1] = &record.animation.animationClipName;
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+// Copies a value an override set; memcpy so arrays copy too
+template <typename T>
+void take(uint32_t fields, uint32_t bit, T& to, const T& from) {
+    if (fields & bit) {
+        std::memcpy(&to, &from, sizeof(T));
+    }
+}
+
+// Everything a mesh renderer's material is built from, so equal keys build
+// equal materials
+std::string getMaterialKey(const SceneDescription& description, const SceneComponentRecord& record) {
+    MeshRendererRecord data = record.meshRenderer;
+    data.meshType = 0;
+    data.diffuseTexture = data.normalTexture = data.armTexture = 0;
+    uint32_t fields = record.fields & ~static_cast<uint32_t>(MeshRendererRecord::MESH);
+
+    std::string key(reinterpret_cast<const char*>(&fields), sizeof(fields));
+    key.append(reinterpret_cast<const char*>(&data), sizeof(data));
+    const uint32_t textures[] = { record.meshRenderer.diffuseTexture, record.meshRenderer.normalTexture,
+                                  record.meshRenderer.armTexture };
+    for (uint32_t texture : textures) {
+        key += '\n';
+        if (texture != SceneDescription::NO_STRING) key += description.getString(texture);
+    }
+    return key;
+}
+
+} // namespace
+
+const uint32_t SceneDescription::VERSION;
+const uint32_t SceneDescription::NO_STRING;
+
+SceneDescription::SceneDescription() {
+    clear();
+}
+
+void SceneDescription::clear() {
+    name = NO_STRING;
+    activeCamera = NO_STRING;
+    activeSkybox = NO_STRING;
+    nodes.clear();
+    components.clear();
+    stringOffsets.assign(1, 0);
+    stringData.clear();
+    stringLookup.clear();
+}
+
+uint32_t SceneDescription::addString(const std::string& value) {
+    auto it = stringLookup.find(value);
+    if (it != stringLookup.end()) {
+        return it->second;
+    }
+
+    uint32_t index = static_cast<uint32_t>(getStringCount());
+    stringData.insert(stringData.end(), value.begin(), value.end());
+    stringData.push_back('\0');
+    stringOffsets.push_back(static_cast<uint32_t>(stringData.size()));
+    stringLookup[value] = index;
+    return index;
+}
+
+std::string SceneDescription::getString(uint32_t index) const {
+    if (index >= getStringCount()) {
+        return std::string();
+    }
+    // Offsets bracket each string including its terminator
+    return std::string(stringData.data() + stringOffsets[index], stringOffsets[index + 1] - stringOffsets[index] - 1);
+}
+
+SceneNodeRecord& SceneDescription::addNode(const std::string& nodeName, int32_t parent) {
+    nodes.push_back(createNode(addString(nodeName), parent));
+    nodes.back().firstComponent = static_cast<uint32_t>(components.size());
+    return nodes.back();
+}
+
+SceneComponentRecord& SceneDescription::addComponent(SceneComponentType type) {
+    components.push_back(createComponent(type));
+    nodes.back().componentCount++;
+    return components.back();
+}
+
+SceneNodeRecord SceneDescription::createNode(uint32_t nodeName, int32_t parent) {
+    SceneNodeRecord node;
+    std::memset(&node, 0, sizeof(node));
+    node.name = nodeName;
+    node.parent = parent;
+    node.flags = SceneNodeRecord::VISIBLE | SceneNodeRecord::ACTIVE;
+    node.scale[0] = node.scale[1] = node.scale[2] = 1.0f;
+    node.prefab = NO_STRING;
+    return node;
+}
+
+SceneComponentRecord SceneDescription::createComponent(SceneComponentType type) {
+    SceneComponentRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.type = static_cast<uint16_t>(type);
+
+    // Leave every string unset so callers only fill what they have
+    uint32_t* strings[6];
+    size_t count = getStringIndices(record, strings);
+    for (size_t i = 0; i < count; ++i) {
+        *strings[i] = NO_STRING;
+    }
+    return record;
+}
+
+SceneNodeRecord SceneDescription::importNode(const SceneDescription& from, const SceneNodeRecord& node) {
+    SceneNodeRecord copy = node;
+    copy.name = addString(from.getString(node.name));
+    copy.prefab = (node.prefab != NO_STRING) ? addString(from.getString(node.prefab)) : NO_STRING;
+    return copy;
+}
+
+SceneComponentRecord SceneDescription::importComponent(const SceneDescription& from,
+                                                       const SceneComponentRecord& record) {
+    SceneComponentRecord copy = record;
+    uint32_t* strings[6];
+    size_t count = getStringIndices(copy, strings);
+    for (size_t i = 0; i < count; ++i) {
+        if (*strings[i] != NO_STRING) {
+            *strings[i] = addString(from.getString(*strings[i]));
+        }
+    }
+    return copy;
+}
+
+void SceneDescription::applyOverride(SceneComponentRecord& record, const SceneComponentRecord& override) {
+    if (record.type != override.type) {
+        return;
+    }
+
+    const uint32_t fields = override.fields;
+    switch (static_cast<SceneComponentType>(record.type)) {
+        case SceneComponentType::CAMERA: {
+            CameraRecord& to = record.camera;
+            const CameraRecord& from = override.camera;
+            take(fields, CameraRecord::FOV, to.fov, from.fov);
+            take(fields, CameraRecord::NEAR_PLANE, to.nearPlane, from.nearPlane);
+            take(fields, CameraRecord::FAR_PLANE, to.farPlane, from.farPlane);
+            break;
+        }
+        case SceneComponentType::MESH_RENDERER: {
+            MeshRendererRecord& to = record.meshRenderer;
+            const MeshRendererRecord& from = override.meshRenderer;
+            take(fields, MeshRendererRecord::MESH, to.meshType, from.meshType);
+            take(fields, MeshRendererRecord::COLOR, to.color, from.color);
+            take(fields, MeshRendererRecord::METALLIC, to.metallic, from.metallic);
+            take(fields, MeshRendererRecord::ROUGHNESS, to.roughness, from.roughness);
+            take(fields, MeshRendererRecord::REFLECTION_STRENGTH, to.reflectionStrength, from.reflectionStrength);
+            break;
+        }
+        case SceneComponentType::MODEL_RENDERER: {
+            ModelRendererRecord& to = record.modelRenderer;
+            const ModelRendererRecord& from = override.modelRenderer;
+            take(fields, ModelRendererRecord::CAST_SHADOWS, to.castShadows, from.castShadows);
+            take(fields, ModelRendererRecord::RECEIVE_SHADOWS, to.receiveShadows, from.receiveShadows);
+            break;
+        }
+        case SceneComponentType::LIGHT: {
+            LightRecord& to = record.light;
+            const LightRecord& from = override.light;
+            take(fields, LightRecord::TYPE, to.type, from.type);
+            take(fields, LightRecord::COLOR, to.color, from.color);
+            take(fields, LightRecord::INTENSITY, to.intensity, from.intensity);
+            take(fields, LightRecord::RANGE, to.range, from.range);
+            take(fields, LightRecord::SHOW_GIZMO, to.showGizmo, from.showGizmo);
+            take(fields, LightRecord::DIRECTION, to.direction, from.direction);
+            take(fields, LightRecord::CUT_OFF, to.cutOff, from.cutOff);
+            take(fields, LightRecord::OUTER_CUT_OFF, to.outerCutOff, from.outerCutOff);
+            break;
+        }
+        case SceneComponentType::PHYSICS: {
+            PhysicsRecord& to = record.physics;
+            const PhysicsRecord& from = override.physics;
+            take(fields, PhysicsRecord::SHAPE, to.shape, from.shape);
+            take(fields, PhysicsRecord::BODY_TYPE, to.bodyType, from.bodyType);
+            take(fields, PhysicsRecord::MASS, to.mass, from.mass);
+            take(fields, PhysicsRecord::FRICTION, to.friction, from.friction);
+            take(fields, PhysicsRecord::RESTITUTION, to.restitution, from.restitution);
+            take(fields, PhysicsRecord::LINEAR_DAMPING, to.linearDamping, from.linearDamping);
+            take(fields, PhysicsRecord::ANGULAR_DAMPING, to.angularDamping, from.angularDamping);
+            take(fields, PhysicsRecord::SHOW_COLLISION_SHAPE, to.showCollisionShape, from.showCollisionShape);
+            break;
+        }
+        case SceneComponentType::TEXT: {
+            TextRecord& to = record.text;
+            const TextRecord& from = override.text;
+            take(fields, TextRecord::FONT_SIZE, to.fontSize, from.fontSize);
+            take(fields, TextRecord::COLOR, to.color, from.color);
+            take(fields, TextRecord::RENDER_MODE, to.renderMode, from.renderMode);
+            take(fields, TextRecord::ALIGNMENT, to.alignment, from.alignment);
+            take(fields, TextRecord::SCALE, to.scale, from.scale);
+            take(fields, TextRecord::LINE_SPACING, to.lineSpacing, from.lineSpacing);
+            break;
+        }
+        case SceneComponentType::SCRIPT:
+            take(fields, ScriptRecord::PAUSE_EXEMPT, record.script.pauseExempt, override.script.pauseExempt);
+            break;
+        case SceneComponentType::SOUND: {
+            SoundRecord& to = record.sound;
+            const SoundRecord& from = override.sound;
+            take(fields, SoundRecord::VOLUME, to.volume, from.volume);
+            take(fields, SoundRecord::LOOP, to.loop, from.loop);
+            take(fields, SoundRecord::PITCH, to.pitch, from.pitch);
+            take(fields, SoundRecord::PRIORITY, to.priority, from.priority);
+            take(fields, SoundRecord::SPATIAL, to.spatial, from.spatial);
+            take(fields, SoundRecord::DISTANCE_RANGE, to.minDistance, from.minDistance);
+            take(fields, SoundRecord::DISTANCE_RANGE, to.maxDistance, from.maxDistance);
+            take(fields, SoundRecord::ROLLOFF, to.rolloff, from.rolloff);
+            break;
+        }
+        case SceneComponentType::SKYBOX:
+            take(fields, SkyboxRecord::ACTIVE, record.skybox.active, override.skybox.active);
+            break;
+        case SceneComponentType::AREA3D: {
+            Area3DRecord& to = record.area3D;
+            const Area3DRecord& from = override.area3D;
+            take(fields, Area3DRecord::SHAPE, to.shape, from.shape);
+            take(fields, Area3DRecord::DIMENSIONS, to.dimensions, from.dimensions);
+            take(fields, Area3DRecord::RADIUS, to.radius, from.radius);
+            take(fields, Area3DRecord::HEIGHT, to.height, from.height);
+            take(fields, Area3DRecord::MONITOR_MODE, to.monitorMode, from.monitorMode);
+            take(fields, Area3DRecord::SHOW_DEBUG_SHAPE, to.showDebugShape, from.showDebugShape);
+            break;
+        }
+        case SceneComponentType::ANIMATION: {
+            AnimationRecord& to = record.animation;
+            const AnimationRecord& from = override.animation;
+            take(fields, AnimationRecord::LOOP, to.loop, from.loop);
+            take(fields, AnimationRecord::SPEED, to.speed, from.speed);
+            take(fields, AnimationRecord::ROOT_MOTION, to.enableRootMotion, from.enableRootMotion);
+            break;
+        }
+    }
+    record.fields |= fields;
+
+    // Both records have the same type, so the same string slots
+    SceneComponentRecord source = override;
+    uint32_t* targets[6];
+    uint32_t* values[6];
+    size_t count = getStringIndices(record, targets);
+    getStringIndices(source, values);
+    for (size_t i = 0; i < count; ++i) {
+        if (*values[i] != NO_STRING) {
+            *targets[i] = *values[i];
+        }
+    }
+}
+
+void SceneDescription::collectTexturePaths(std::vector<std::string>& paths) const {
+    for (const auto& record : components) {
+        if (record.type != static_cast<uint16_t>(SceneComponentType::MESH_RENDERER) ||
+            !(record.fields & MeshRendererRecord::MATERIAL)) {
+            continue;
+        }
+        const uint32_t textures[] = { record.meshRenderer.diffuseTexture, record.meshRenderer.normalTexture,
+                                      record.meshRenderer.armTexture };
+        for (uint32_t texture : textures) {
+            if (texture != NO_STRING) {
+                paths.push_back(getString(texture));
+            }
+        }
+    }
+}
+
+std::shared_ptr<Scene> SceneDescription::instantiate(const SceneLoadCallback& progress) const {
+    auto scene = std::make_shared<Scene>(name != NO_STRING ? getString(name) : std::string("Loaded Scene"));
+    scene->getRootNode()->removeAllChildren();
+
+    // Models, sounds and textures load up front, in parallel, so node
+    // creation below only hits the caches. The loader keeps the sounds
+    // cached until the nodes hold them
+    SceneAssetLoader assets(progress);
+    assets.load(*this);
+
+    std::vector<std::shared_ptr<SceneNode>> created;
+    createNodes(scene->getRootNode(), assets, created);
+
+    if (activeCamera != NO_STRING) {
+        auto cameraNode = scene->findNode(getString(activeCamera));
+        if (cameraNode) {
+            scene->setActiveCamera(cameraNode);
+        }
+    }
+    if (activeSkybox != NO_STRING) {
+        auto skyboxNode = scene->findNode(getString(activeSkybox));
+        if (skyboxNode) {
+            scene->setActiveSkybox(skyboxNode);
+        }
+    }
+    assets.reportDone();
+    return scene;
+}
+
+std::shared_ptr<SceneNode> SceneDescription::instantiateNode() const {
+    if (nodes.empty()) {
+        return nullptr;
+    }
+
+    SceneAssetLoader assets;
+    assets.load(*this);
+
+    std::vector<std::shared_ptr<SceneNode>> created;
+    createNodes(std::make_shared<SceneNode>(getString(nodes[0].name)), assets, created);
+    return created[0];
+}
+
+void SceneDescription::createNodes(const std::shared_ptr<SceneNode>& root, SceneAssetLoader& assets,
+                                   std::vector<std::shared_ptr<SceneNode>>& created) const {
+    auto& prefabs = PrefabLibrary::getInstance();
+
+    // Components start while their node is still detached, as they did when
+    // the JSON loader built each subtree before attaching it
+    created.assign(nodes.size(), std::shared_ptr<SceneNode>());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const SceneNodeRecord& record = nodes[i];
+        std::shared_ptr<SceneNode> node;
+        if (i == 0) {
+            node = root;
+            node->setName(getString(record.name));
+        } else {
+            node = std::make_shared<SceneNode>(getString(record.name));
+        }
+        created[i] = node;
+        if (record.prefab != NO_STRING) {
+            node->setPrefabPath(getString(record.prefab));
+        }
+
+        node->setVisible((record.flags & SceneNodeRecord::VISIBLE) != 0);
+        node->setActive((record.flags & SceneNodeRecord::ACTIVE) != 0);
+
+        auto& transform = node->getTransform();
+        if (record.flags & SceneNodeRecord::HAS_POSITION) {
+            transform.setPosition(toVec3(record.position));
+        }
+        if (record.flags & SceneNodeRecord::HAS_ROTATION) {
+            transform.setEulerAngles(toVec3(record.rotation));
+        }
+        if (record.flags & SceneNodeRecord::HAS_SCALE) {
+            transform.setScale(toVec3(record.scale));
+        }
+
+        for (uint32_t c = 0; c < record.componentCount; ++c) {
+            const SceneComponentRecord& component = components[record.firstComponent + c];
+            const uint32_t fields = component.fields;
+
+            switch (static_cast<SceneComponentType>(component.type)) {
+                case SceneComponentType::CAMERA: {
+                    const CameraRecord& data = component.camera;
+                    auto cameraComp = node->addComponent<CameraComponent>();
+                    if (fields & CameraRecord::FOV) cameraComp->setFOV(data.fov);
+                    if (fields & CameraRecord::NEAR_PLANE) cameraComp->setNearPlane(data.nearPlane);
+                    if (fields & CameraRecord::FAR_PLANE) cameraComp->setFarPlane(data.farPlane);
+                    // Activation is left to scene->setActiveCamera() so the scene and component stay in sync
+                    break;
+                }
+                case SceneComponentType::MESH_RENDERER: {
+                    const MeshRendererRecord& data = component.meshRenderer;
+                    auto meshRenderer = node->addComponent<MeshRenderer>();
+                    // A prefab's untouched mesh renderer shares its mesh and
+                    // material with every other instance of it
+                    const bool shared = (component.origin & SceneComponentRecord::FROM_PREFAB) != 0;
+                    if (fields & MeshRendererRecord::MESH) {
+                        MeshType type = static_cast<MeshType>(data.meshType);
+                        std::shared_ptr<Mesh> mesh = shared ? prefabs.getSharedMesh(type) : nullptr;
+                        if (!mesh) {
+                            mesh = createMesh(type);
+                            if (shared) prefabs.setSharedMesh(type, mesh);
+                        }
+                        meshRenderer->setMesh(mesh);
+                    }
+                    if ((fields & MeshRendererRecord::MATERIAL) && shared) {
+                        std::string key = getMaterialKey(*this, component);
+                        std::shared_ptr<Material> material = prefabs.getSharedMaterial(key);
+                        if (!material) {
+                            material = createMaterial(data, fields);
+                            prefabs.setSharedMaterial(key, material);
+                        }
+                        meshRenderer->setSharedMaterial(material);
+                    } else if (fields & MeshRendererRecord::MATERIAL) {
+                        meshRenderer->setMaterial(createMaterial(data, fields));
+                    }
+                    break;
+                }
+                case SceneComponentType::MODEL_RENDERER: {
+                    const ModelRendererRecord& data = component.modelRenderer;
+                    auto modelRenderer = node->addComponent<ModelRenderer>();
+                    if (data.modelPath != NO_STRING) modelRenderer->loadModel(getString(data.modelPath));
+                    if (fields & ModelRendererRecord::CAST_SHADOWS) modelRenderer->setCastShadows(data.castShadows != 0);
+                    if (fields & ModelRendererRecord::RECEIVE_SHADOWS) {
+                        modelRenderer->setReceiveShadows(data.receiveShadows != 0);
+                    }
+                    break;
+                }
+                case SceneComponentType::LIGHT: {
+                    const LightRecord& data = component.light;
+                    auto lightComp = node->addComponent<LightComponent>();
+                    if (fields & LightRecord::TYPE) lightComp->setType(static_cast<LightType>(data.type));
+                    if (fields & LightRecord::COLOR) lightComp->setColor(toVec3(data.color));
+                    if (fields & LightRecord::INTENSITY) lightComp->setIntensity(data.intensity);
+                    if (fields & LightRecord::RANGE) lightComp->setRange(data.range);
+                    if (fields & LightRecord::SHOW_GIZMO) lightComp->setShowGizmo(data.showGizmo != 0);
+                    if (fields & LightRecord::DIRECTION) lightComp->setDirection(toVec3(data.direction));
+                    if (fields & LightRecord::CUT_OFF) lightComp->setCutOff(data.cutOff);
+                    if (fields & LightRecord::OUTER_CUT_OFF) lightComp->setOuterCutOff(data.outerCutOff);
+                    lightComp->start();
+                    break;
+                }
+                case SceneComponentType::PHYSICS: {
+                    const PhysicsRecord& data = component.physics;
+                    auto physicsComp = node->addComponent<PhysicsComponent>();
+                    if (fields & PhysicsRecord::SHAPE) {
+                        physicsComp->setCollisionShape(static_cast<CollisionShapeType>(data.shape));
+                    }
+                    if (fields & PhysicsRecord::BODY_TYPE) {
+                        physicsComp->setBodyType(static_cast<PhysicsBodyType>(data.bodyType));
+                    }
+                    if (fields & PhysicsRecord::MASS) physicsComp->setMass(data.mass);
+                    if (fields & PhysicsRecord::FRICTION) physicsComp->setFriction(data.friction);
+                    if (fields & PhysicsRecord::RESTITUTION) physicsComp->setRestitution(data.restitution);
+                    if (fields & PhysicsRecord::LINEAR_DAMPING) physicsComp->setLinearDamping(data.linearDamping);
+                    if (fields & PhysicsRecord::ANGULAR_DAMPING) physicsComp->setAngularDamping(data.angularDamping);
+                    if (fields & PhysicsRecord::SHOW_COLLISION_SHAPE) {
+                        physicsComp->setShowCollisionShape(data.showCollisionShape != 0);
+                    }
+                    break;
+                }
+                case SceneComponentType::TEXT: {
+                    const TextRecord& data = component.text;
+                    auto textComp = node->addComponent<TextComponent>();
+                    if (data.text != NO_STRING) textComp->setText(getString(data.text));
+                    if (data.fontPath != NO_STRING) textComp->setFontPath(getString(data.fontPath));
+                    if (fields & TextRecord::FONT_SIZE) textComp->setFontSize(data.fontSize);
+                    if (fields & TextRecord::COLOR) {
+                        textComp->setColor(glm::vec4(data.color[0], data.color[1], data.color[2], data.color[3]));
+                    }
+                    if (fields & TextRecord::RENDER_MODE) {
+                        textComp->setRenderMode(static_cast<TextRenderMode>(data.renderMode));
+                    }
+                    if (fields & TextRecord::ALIGNMENT) textComp->setAlignment(static_cast<TextAlignment>(data.alignment));
+                    if (fields & TextRecord::SCALE) textComp->setScale(data.scale);
+                    if (fields & TextRecord::LINE_SPACING) textComp->setLineSpacing(data.lineSpacing);
+                    textComp->start();
+                    break;
+                }
+                case SceneComponentType::SCRIPT: {
+                    const ScriptRecord& data = component.script;
+                    auto scriptComp = node->addComponent<ScriptComponent>();
+                    // Scripts start with Scene::start(), once every node they may look up exists
+                    if (data.scriptPath != NO_STRING) {
+                        std::string scriptPath = getString(data.scriptPath);
+                        if (!scriptPath.empty()) {
+                            scriptComp->loadScript(scriptPath);
+                        }
+                    }
+                    if (fields & ScriptRecord::PAUSE_EXEMPT) scriptComp->setPauseExempt(data.pauseExempt != 0);
+                    break;
+                }
+                case SceneComponentType::SOUND: {
+                    const SoundRecord& data = component.sound;
+                    auto soundComp = node->addComponent<SoundComponent>();
+                    if (fields & SoundRecord::VOLUME) soundComp->setVolume(data.volume);
+                    if (fields & SoundRecord::LOOP) soundComp->setLoop(data.loop != 0);
+                    if (fields & SoundRecord::PITCH) soundComp->setPitch(data.pitch);
+                    if (fields & SoundRecord::PRIORITY) soundComp->setPriority(data.priority);
+                    if (fields & SoundRecord::SPATIAL) soundComp->setSpatial(data.spatial != 0);
+                    if (fields & SoundRecord::DISTANCE_RANGE) soundComp->setDistanceRange(data.minDistance, data.maxDistance);
+                    if (fields & SoundRecord::ROLLOFF) soundComp->setRolloff(data.rolloff);
+                    if (data.soundFile != NO_STRING) soundComp->setSoundFile(getString(data.soundFile));
+                    soundComp->start();
+                    break;
+                }
+                case SceneComponentType::SKYBOX: {
+                    const SkyboxRecord& data = component.skybox;
+                    auto skyboxComp = node->addComponent<SkyboxComponent>();
+                    if (data.faces[0] != NO_STRING) skyboxComp->setRightTexture(getString(data.faces[0]));
+                    if (data.faces[1] != NO_STRING) skyboxComp->setLeftTexture(getString(data.faces[1]));
+                    if (data.faces[2] != NO_STRING) skyboxComp->setTopTexture(getString(data.faces[2]));
+                    if (data.faces[3] != NO_STRING) skyboxComp->setBottomTexture(getString(data.faces[3]));
+                    if (data.faces[4] != NO_STRING) skyboxComp->setFrontTexture(getString(data.faces[4]));
+                    if (data.faces[5] != NO_STRING) skyboxComp->setBackTexture(getString(data.faces[5]));
+                    skyboxComp->start();
+                    if (fields & SkyboxRecord::ACTIVE) skyboxComp->setActive(data.active != 0);
+                    break;
+                }
+                case SceneComponentType::AREA3D: {
+                    const Area3DRecord& data = component.area3D;
+                    auto area3DComp = node->addComponent<Area3DComponent>();
+                    if (fields & Area3DRecord::SHAPE) area3DComp->setShape(static_cast<Area3DShape>(data.shape));
+                    if (fields & Area3DRecord::DIMENSIONS) area3DComp->setDimensions(toVec3(data.dimensions));
+                    if (fields & Area3DRecord::RADIUS) area3DComp->setRadius(data.radius);
+                    if (fields & Area3DRecord::HEIGHT) area3DComp->setHeight(data.height);
+                    if (data.group != NO_STRING) area3DComp->setGroup(getString(data.group));
+                    if (fields & Area3DRecord::MONITOR_MODE) area3DComp->setMonitorMode(data.monitorMode != 0);
+                    if (fields & Area3DRecord::SHOW_DEBUG_SHAPE) area3DComp->setShowDebugShape(data.showDebugShape != 0);
+                    area3DComp->start();
+                    break;
+                }
+                case SceneComponentType::ANIMATION: {
+                    const AnimationRecord& data = component.animation;
+                    auto animComp = node->addComponent<AnimationComponent>();
+                    if (data.skeletonName != NO_STRING) animComp->setSkeleton(getString(data.skeletonName));
+                    if (data.animationClipName != NO_STRING) {
+                        animComp->setAnimationClip(getString(data.animationClipName));
+                    }
+                    if (fields & AnimationRecord::LOOP) animComp->setLoop(data.loop != 0);
+                    if (fields & AnimationRecord::SPEED) animComp->setSpeed(data.speed);
+                    if (fields & AnimationRecord::ROOT_MOTION) animComp->setRootMotionEnabled(data.enableRootMotion != 0);
+                    if (fields & AnimationRecord::AUTO_PLAY) animComp->play();
+                    break;
+                }
+            }
+        }
+        assets.reportNodes(i + 1);
+    }
+
+    for (size_t i = 1; i < nodes.size(); ++i) {
+        created[nodes[i].parent]->addChild(created[i]);
+    }
+}
+
+std::shared_ptr<Material> SceneDescription::createMaterial(const MeshRendererRecord& data, uint32_t fields) const {
+    auto& textureManager = TextureManager::getInstance();
+    auto material = std::make_shared<Material>();
+    if (fields & MeshRendererRecord::COLOR) material->setColor(toVec3(data.color));
+    if (fields & MeshRendererRecord::METALLIC) material->setMetallic(data.metallic);
+    if (fields & MeshRendererRecord::ROUGHNESS) material->setRoughness(data.roughness);
+    if (fields & MeshRendererRecord::REFLECTION_STRENGTH) material->setReflectionStrength(data.reflectionStrength);
+
+    if (data.diffuseTexture != NO_STRING) {
+        std::string path = getString(data.diffuseTexture);
+        auto texture = textureManager.getTexture(path);
+        if (texture) material->setDiffuseTexture(texture, path);
+    }
+    if (data.normalTexture != NO_STRING) {
+        std::string path = getString(data.normalTexture);
+        auto texture = textureManager.getTexture(path);
+        if (texture) material->setNormalTexture(texture, path);
+    }
+    if (data.armTexture != NO_STRING) {
+        std::string path = getString(data.armTexture);
+        auto texture = textureManager.getTexture(path);
+        if (texture) material->setARMTexture(texture, path);
+    }
+    return material;
+}
+
+bool SceneDescription::matches(const SceneDescription& other) const {
+    auto sameString = [this, &other](uint32_t a, uint32_t b) {
+        return (a == NO_STRING) == (b == NO_STRING) && getString(a) == other.getString(b);
+    };
+
+    if (nodes.size() != other.nodes.size() || components.size() != other.components.size() ||
+        !sameString(name, other.name) || !sameString(activeCamera, other.activeCamera) ||
+        !sameString(activeSkybox, other.activeSkybox)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        SceneNodeRecord a = nodes[i];
+        SceneNodeRecord b = other.nodes[i];
+        if (!sameString(a.name, b.name) || !sameString(a.prefab, b.prefab)) return false;
+        a.name = b.name = 0;
+        a.prefab = b.prefab = 0;
+        if (std::memcmp(&a, &b, sizeof(a)) != 0) return false;
+    }
+
+    for (size_t i = 0; i < components.size(); ++i) {
+        SceneComponentRecord a = components[i];
+        SceneComponentRecord b = other.components[i];
+        if (a.type != b.type) return false;
+        uint32_t* stringsA[6];
+        uint32_t* stringsB[6];
+        size_t count = getStringIndices(a, stringsA);
+        getStringIndices(b, stringsB);
+        for (size_t s = 0; s < count; ++s) {
+            if (!sameString(*stringsA[s], *stringsB[s])) return false;
+            *stringsA[s] = *stringsB[s] = 0;
+        }
+        if (std::memcmp(&a, &b, sizeof(a)) != 0) return false;
+    }
+    return true;
+}
+
+void SceneDescription::writeBinary(std::vector<uint8_t>& file) const {
+    BinarySceneHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BSCENE_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.nodeCount = static_cast<uint32_t>(nodes.size());
+    header.componentCount = static_cast<uint32_t>(components.size());
+    header.stringCount = static_cast<uint32_t>(getStringCount());
+    // Padded so the next file appended in a pack stays aligned
+    header.stringBytes = static_cast<uint32_t>((stringData.size() + 3) & ~static_cast<size_t>(3));
+    header.name = name;
+    header.activeCamera = activeCamera;
+    header.activeSkybox = activeSkybox;
+
+    size_t offsetsBytes = stringOffsets.size() * sizeof(uint32_t);
+    size_t nodesBytes = nodes.size() * sizeof(SceneNodeRecord);
+    size_t componentsBytes = components.size() * sizeof(SceneComponentRecord);
+
+    file.assign(sizeof(header) + offsetsBytes + nodesBytes + componentsBytes + header.stringBytes, 0);
+    uint8_t* out = file.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, stringOffsets.data(), offsetsBytes);
+    out += offsetsBytes;
+    if (nodesBytes > 0) std::memcpy(out, nodes.data(), nodesBytes);
+    out += nodesBytes;
+    if (componentsBytes > 0) std::memcpy(out, components.data(), componentsBytes);
+    out += componentsBytes;
+    if (!stringData.empty()) std::memcpy(out, stringData.data(), stringData.size());
+}
+
+bool SceneDescription::readBinary(const uint8_t* data, size_t size) {
+    clear();
+    if (!isBinary(data, size)) return false;
+
+    BinarySceneHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != VERSION) {
+        LOG_WARNING("SceneDescription: Binary scene is version %u, this build reads version %u (re-cook it)",
+                    header.version, VERSION);
+        return false;
+    }
+
+    // 64-bit sums so a corrupt count cannot wrap around the size check
+    uint64_t offsetsBytes = (static_cast<uint64_t>(header.stringCount) + 1) * sizeof(uint32_t);
+    uint64_t nodesBytes = static_cast<uint64_t>(header.nodeCount) * sizeof(SceneNodeRecord);
+    uint64_t componentsBytes = static_cast<uint64_t>(header.componentCount) * sizeof(SceneComponentRecord);
+    if (sizeof(header) + offsetsBytes + nodesBytes + componentsBytes + header.stringBytes > size) return false;
+
+    const uint8_t* in = data + sizeof(header);
+    stringOffsets.resize(header.stringCount + 1);
+    std::memcpy(stringOffsets.data(), in, offsetsBytes);
+    in += offsetsBytes;
+    nodes.resize(header.nodeCount);
+    if (nodesBytes > 0) std::memcpy(nodes.data(), in, nodesBytes);
+    in += nodesBytes;
+    components.resize(header.componentCount);
+    if (componentsBytes > 0) std::memcpy(components.data(), in, componentsBytes);
+    in += componentsBytes;
+    stringData.assign(in, in + header.stringBytes);
+
+    name = header.name;
+    activeCamera = header.activeCamera;
+    activeSkybox = header.activeSkybox;
+
+    // Strings: increasing offsets inside the data, each one terminated
+    const uint32_t stringCount = header.stringCount;
+    bool valid = stringOffsets[0] == 0;
+    for (uint32_t i = 0; valid && i < stringCount; ++i) {
+        valid = stringOffsets[i] < stringOffsets[i + 1] && stringOffsets[i + 1] <= stringData.size() &&
+                stringData[stringOffsets[i + 1] - 1] == '\0';
+    }
+
+    auto validString = [stringCount](uint32_t index) { return index == NO_STRING || index < stringCount; };
+    valid = valid && validString(name) && validString(activeCamera) && validString(activeSkybox);
+
+    // Nodes: parents come first, components are contiguous and in node order
+    uint32_t nextComponent = 0;
+    for (size_t i = 0; valid && i < nodes.size(); ++i) {
+        const SceneNodeRecord& node = nodes[i];
+        valid = node.name < stringCount && validString(node.prefab) && node.firstComponent == nextComponent &&
+                node.componentCount <= components.size() - nextComponent &&
+                (i == 0 ? node.parent == -1 : (node.parent >= 0 && static_cast<size_t>(node.parent) < i));
+        nextComponent += node.componentCount;
+    }
+    valid = valid && nextComponent == components.size();
+
+    for (size_t i = 0; valid && i < components.size(); ++i) {
+        SceneComponentRecord& record = components[i];
+        valid = record.type >= static_cast<uint16_t>(SceneComponentType::CAMERA) &&
+                record.type <= static_cast<uint16_t>(SceneComponentType::ANIMATION);
+        uint32_t* strings[6];
+        size_t count = valid ? getStringIndices(record, strings) : 0;
+        for (size_t s = 0; valid && s < count; ++s) {
+            valid = validString(*strings[s]);
+        }
+    }
+
+    if (!valid) {
+        clear();
+    }
+    return valid;
+}
+
+bool SceneDescription::isBinary(const uint8_t* data, size_t size) {
+    return size >= sizeof(BinarySceneHeader) && std::memcmp(data, BSCENE_MAGIC, sizeof(BSCENE_MAGIC)) == 0;
+}
+
+std::string SceneDescription::getBinaryPath(const std::string& sourcePath) {
+    size_t slash = sourcePath.find_last_of("/\\");
+    size_t dot = sourcePath.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return sourcePath + ".bscene";
+    }
+    return sourcePath.substr(0, dot) + ".bscene";
+}
+
+} // namespace GameEngine
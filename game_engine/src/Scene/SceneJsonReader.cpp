@@ -0,0 +1,842 @@
+#include "Scene/SceneJsonReader.h"
+#include "Scene/PrefabLibrary.h"
+#include "Rendering/Mesh.h"
+#include <cstring>
+#include <vector>
+
+#ifdef LINUX_BUILD
+#include <iostream>
+#else
+#include <cstdio>
+#endif
+
+using json = nlohmann::json;
+
+namespace GameEngine {
+
+namespace {
+
+// The mapping below reads its fields through one of two sources: a DOM
+// object, or the values the SAX handler buffered for the object it just
+// closed. Both are tolerant: a missing or mistyped value is left out of the
+// description, so the component keeps its default
+
+class DomFields {
+public:
+    explicit DomFields(const json* object = nullptr) : object(object) {}
+
+    bool getFloat(const char* key, float& out) const {
+        const json* value = find(key);
+        if (!value || !value->is_number()) return false;
+        out = value->get<float>();
+        return true;
+    }
+
+    bool getInt(const char* key, int32_t& out) const {
+        const json* value = find(key);
+        if (!value || !value->is_number()) return false;
+        out = value->get<int32_t>();
+        return true;
+    }
+
+    bool getFloats(const char* key, float* out, size_t count) const {
+        const json* value = find(key);
+        if (!value || !value->is_array() || value->size() < count) return false;
+        for (size_t i = 0; i < count; ++i) {
+            if (!(*value)[i].is_number()) return false;
+            out[i] = (*value)[i].get<float>();
+        }
+        return true;
+    }
+
+    bool getBool(const char* key, uint8_t& out) const {
+        const json* value = find(key);
+        if (!value || !value->is_boolean()) return false;
+        out = value->get<bool>() ? 1 : 0;
+        return true;
+    }
+
+    const std::string* getText(const char* key) const {
+        const json* value = find(key);
+        return (value && value->is_string()) ? &value->get_ref<const std::string&>() : nullptr;
+    }
+
+    bool getObject(const char* key, DomFields& out) const {
+        const json* value = find(key);
+        if (!value || !value->is_object()) return false;
+        out = DomFields(value);
+        return true;
+    }
+
+private:
+    const json* find(const char* key) const {
+        if (!object || !object->is_object()) return nullptr;
+        auto it = object->find(key);
+        return it != object->end() ? &*it : nullptr;
+    }
+
+    const json* object;
+};
+
+// One scalar, short number array or nested object seen by the SAX handler.
+// Slots are reused from object to object, so their strings keep their capacity
+struct BufferedField {
+    enum Type { OTHER, INTEGER, UNSIGNED, FLOAT, BOOLEAN, TEXT, ARRAY, OBJECT };
+    static const uint32_t MAX_ELEMENTS = 4;
+
+    std::string key;
+    Type type;
+    int64_t integer;
+    uint64_t unsignedInteger;
+    double number;
+    bool boolean;
+    std::string text;
+    // Only the first MAX_ELEMENTS are kept; the mapping never needs more
+    float elements[MAX_ELEMENTS];
+    uint32_t elementCount;
+    uint32_t numericMask;       // which of the kept elements were numbers
+    size_t object;              // FieldBuffer index for OBJECT
+
+    bool isNumber() const { return type == INTEGER || type == UNSIGNED || type == FLOAT; }
+
+    // Same conversions as json::get<float>() / get<int32_t>()
+    float toFloat() const {
+        if (type == INTEGER) return static_cast<float>(integer);
+        if (type == UNSIGNED) return static_cast<float>(unsignedInteger);
+        return static_cast<float>(number);
+    }
+
+    int32_t toInt() const {
+        if (type == INTEGER) return static_cast<int32_t>(integer);
+        if (type == UNSIGNED) return static_cast<int32_t>(unsignedInteger);
+        return static_cast<int32_t>(number);
+    }
+};
+
+struct FieldBuffer {
+    std::vector<BufferedField> fields;
+    size_t count;
+
+    FieldBuffer() : count(0) {}
+
+    // A repeated key replaces the earlier value, as it does in the DOM
+    BufferedField& set(const std::string& key) {
+        size_t slot = 0;
+        while (slot < count && fields[slot].key != key) ++slot;
+        if (slot == count) {
+            if (count == fields.size()) fields.push_back(BufferedField());
+            fields[count++].key.assign(key);
+        }
+        BufferedField& field = fields[slot];
+        field.type = BufferedField::OTHER;
+        field.elementCount = 0;
+        field.numericMask = 0;
+        return field;
+    }
+
+    const BufferedField* find(const char* key) const {
+        for (size_t i = 0; i < count; ++i) {
+            if (fields[i].key == key) return &fields[i];
+        }
+        return nullptr;
+    }
+};
+
+class BufferedFields {
+public:
+    BufferedFields() : pool(nullptr), index(0) {}
+    BufferedFields(const std::vector<FieldBuffer>* pool, size_t index) : pool(pool), index(index) {}
+
+    bool getFloat(const char* key, float& out) const {
+        const BufferedField* field = find(key);
+        if (!field || !field->isNumber()) return false;
+        out = field->toFloat();
+        return true;
+    }
+
+    bool getInt(const char* key, int32_t& out) const {
+        const BufferedField* field = find(key);
+        if (!field || !field->isNumber()) return false;
+        out = field->toInt();
+        return true;
+    }
+
+    bool getFloats(const char* key, float* out, size_t count) const {
+        const BufferedField* field = find(key);
+        if (!field || field->type != BufferedField::ARRAY || field->elementCount < count) return false;
+        for (size_t i = 0; i < count; ++i) {
+            if (!(field->numericMask & (1u << i))) return false;
+            out[i] = field->elements[i];
+        }
+        return true;
+    }
+
+    bool getBool(const char* key, uint8_t& out) const {
+        const BufferedField* field = find(key);
+        if (!field || field->type != BufferedField::BOOLEAN) return false;
+        out = field->boolean ? 1 : 0;
+        return true;
+    }
+
+    const std::string* getText(const char* key) const {
+        const BufferedField* field = find(key);
+        return (field && field->type == BufferedField::TEXT) ? &field->text : nullptr;
+    }
+
+    bool getObject(const char* key, BufferedFields& out) const {
+        const BufferedField* field = find(key);
+        if (!field || field->type != BufferedField::OBJECT) return false;
+        out = BufferedFields(pool, field->object);
+        return true;
+    }
+
+private:
+    const BufferedField* find(const char* key) const { return (*pool)[index].find(key); }
+
+    const std::vector<FieldBuffer>* pool;
+    size_t index;
+};
+
+template <typename Fields>
+uint32_t readString(const Fields& fields, const char* key, SceneDescription& description) {
+    const std::string* text = fields.getText(key);
+    return text ? description.addString(*text) : SceneDescription::NO_STRING;
+}
+
+// Index of the value in `names` (the engine enum's order), -1 if absent or unknown
+template <typename Fields>
+int readEnum(const Fields& fields, const char* key, const char* const* names, int count) {
+    const std::string* text = fields.getText(key);
+    if (!text) return -1;
+    for (int i = 0; i < count; ++i) {
+        if (*text == names[i]) return i;
+    }
+    return -1;
+}
+
+// Name, flags, transform and prefab; components and children are added by
+// the caller
+template <typename Fields>
+void describeNode(const Fields& fields, SceneDescription& description, SceneNodeRecord& node) {
+    const std::string* name = fields.getText("name");
+    node.name = description.addString(name ? *name : std::string("Node"));
+    node.prefab = readString(fields, "prefab", description);
+
+    uint8_t flag = 0;
+    if (fields.getBool("visible", flag)) {
+        node.flags |= SceneNodeRecord::HAS_VISIBLE;
+        if (!flag) node.flags &= ~SceneNodeRecord::VISIBLE;
+    }
+    if (fields.getBool("active", flag)) {
+        node.flags |= SceneNodeRecord::HAS_ACTIVE;
+        if (!flag) node.flags &= ~SceneNodeRecord::ACTIVE;
+    }
+
+    Fields transform;
+    if (fields.getObject("transform", transform)) {
+        if (transform.getFloats("position", node.position, 3)) node.flags |= SceneNodeRecord::HAS_POSITION;
+        if (transform.getFloats("rotation", node.rotation, 3)) node.flags |= SceneNodeRecord::HAS_ROTATION;
+        if (transform.getFloats("scale", node.scale, 3)) node.flags |= SceneNodeRecord::HAS_SCALE;
+    }
+}
+
+// False for a component without a type or of a type the loader doesn't know
+template <typename Fields>
+bool describeComponent(const Fields& fields, SceneDescription& description, SceneComponentRecord& record) {
+    const std::string* typeName = fields.getText("type");
+    if (!typeName) {
+        return false;
+    }
+    const std::string& type = *typeName;
+
+    if (type == "CameraComponent") {
+        record = SceneDescription::createComponent(SceneComponentType::CAMERA);
+        CameraRecord& camera = record.camera;
+        if (fields.getFloat("fov", camera.fov)) record.fields |= CameraRecord::FOV;
+        if (fields.getFloat("nearPlane", camera.nearPlane)) record.fields |= CameraRecord::NEAR_PLANE;
+        if (fields.getFloat("farPlane", camera.farPlane)) record.fields |= CameraRecord::FAR_PLANE;
+        // "active" is not restored; the scene's activeCamera decides
+    } else if (type == "MeshRenderer") {
+        record = SceneDescription::createComponent(SceneComponentType::MESH_RENDERER);
+        MeshRendererRecord& mesh = record.meshRenderer;
+
+        // Same order as MeshType; anything unknown becomes a cube
+        static const char* const meshTypes[] = { "UNKNOWN", "QUAD", "PLANE", "CUBE", "SPHERE", "CAPSULE", "CYLINDER" };
+        if (fields.getText("meshType")) {
+            int meshType = readEnum(fields, "meshType", meshTypes, 7);
+            mesh.meshType = static_cast<uint32_t>(meshType > 0 ? meshType : static_cast<int>(MeshType::CUBE));
+            record.fields |= MeshRendererRecord::MESH;
+        }
+
+        Fields material;
+        if (fields.getObject("material", material)) {
+            record.fields |= MeshRendererRecord::MATERIAL;
+            if (material.getFloats("color", mesh.color, 3)) record.fields |= MeshRendererRecord::COLOR;
+            if (material.getFloat("metallic", mesh.metallic)) record.fields |= MeshRendererRecord::METALLIC;
+            if (material.getFloat("roughness", mesh.roughness)) record.fields |= MeshRendererRecord::ROUGHNESS;
+            if (material.getFloat("reflectionStrength", mesh.reflectionStrength)) {
+                record.fields |= MeshRendererRecord::REFLECTION_STRENGTH;
+            }
+            mesh.diffuseTexture = readString(material, "diffuseTexture", description);
+            mesh.normalTexture = readString(material, "normalTexture", description);
+            mesh.armTexture = readString(material, "armTexture", description);
+        }
+    } else if (type == "ModelRenderer") {
+        record = SceneDescription::createComponent(SceneComponentType::MODEL_RENDERER);
+        ModelRendererRecord& model = record.modelRenderer;
+        model.modelPath = readString(fields, "modelPath", description);
+        if (fields.getBool("castShadows", model.castShadows)) record.fields |= ModelRendererRecord::CAST_SHADOWS;
+        if (fields.getBool("receiveShadows", model.receiveShadows)) {
+            record.fields |= ModelRendererRecord::RECEIVE_SHADOWS;
+        }
+    } else if (type == "LightComponent") {
+        record = SceneDescription::createComponent(SceneComponentType::LIGHT);
+        LightRecord& light = record.light;
+        static const char* const lightTypes[] = { "DIRECTIONAL", "POINT", "SPOT" };
+        int lightType = readEnum(fields, "lightType", lightTypes, 3);
+        if (lightType >= 0) {
+            light.type = static_cast<uint32_t>(lightType);
+            record.fields |= LightRecord::TYPE;
+        }
+        if (fields.getFloats("color", light.color, 3)) record.fields |= LightRecord::COLOR;
+        if (fields.getFloat("intensity", light.intensity)) record.fields |= LightRecord::INTENSITY;
+        if (fields.getFloat("range", light.range)) record.fields |= LightRecord::RANGE;
+        if (fields.getBool("showGizmo", light.showGizmo)) record.fields |= LightRecord::SHOW_GIZMO;
+        if (fields.getFloats("direction", light.direction, 3)) record.fields |= LightRecord::DIRECTION;
+        if (fields.getFloat("cutOff", light.cutOff)) record.fields |= LightRecord::CUT_OFF;
+        if (fields.getFloat("outerCutOff", light.outerCutOff)) record.fields |= LightRecord::OUTER_CUT_OFF;
+    } else if (type == "PhysicsComponent") {
+        record = SceneDescription::createComponent(SceneComponentType::PHYSICS);
+        PhysicsRecord& physics = record.physics;
+        static const char* const shapes[] = { "BOX", "SPHERE", "CAPSULE", "CYLINDER", "PLANE" };
+        static const char* const bodyTypes[] = { "STATIC", "DYNAMIC", "KINEMATIC" };
+        int shape = readEnum(fields, "collisionShapeType", shapes, 5);
+        if (shape >= 0) {
+            physics.shape = static_cast<uint32_t>(shape);
+            record.fields |= PhysicsRecord::SHAPE;
+        }
+        int bodyType = readEnum(fields, "bodyType", bodyTypes, 3);
+        if (bodyType >= 0) {
+            physics.bodyType = static_cast<uint32_t>(bodyType);
+            record.fields |= PhysicsRecord::BODY_TYPE;
+        }
+        if (fields.getFloat("mass", physics.mass)) record.fields |= PhysicsRecord::MASS;
+        if (fields.getFloat("friction", physics.friction)) record.fields |= PhysicsRecord::FRICTION;
+        if (fields.getFloat("restitution", physics.restitution)) record.fields |= PhysicsRecord::RESTITUTION;
+        if (fields.getFloat("linearDamping", physics.linearDamping)) record.fields |= PhysicsRecord::LINEAR_DAMPING;
+        if (fields.getFloat("angularDamping", physics.angularDamping)) record.fields |= PhysicsRecord::ANGULAR_DAMPING;
+        if (fields.getBool("showCollisionShape", physics.showCollisionShape)) {
+            record.fields |= PhysicsRecord::SHOW_COLLISION_SHAPE;
+        }
+    } else if (type == "TextComponent") {
+        record = SceneDescription::createComponent(SceneComponentType::TEXT);
+        TextRecord& text = record.text;
+        static const char* const renderModes[] = { "WORLD_SPACE", "SCREEN_SPACE" };
+        static const char* const alignments[] = { "LEFT", "CENTER", "RIGHT" };
+        text.text = readString(fields, "text", description);
+        text.fontPath = readString(fields, "fontPath", description);
+        if (fields.getFloat("fontSize", text.fontSize)) record.fields |= TextRecord::FONT_SIZE;
+        if (fields.getFloats("color", text.color, 4)) record.fields |= TextRecord::COLOR;
+        int renderMode = readEnum(fields, "renderMode", renderModes, 2);
+        if (renderMode >= 0) {
+            text.renderMode = static_cast<uint32_t>(renderMode);
+            record.fields |= TextRecord::RENDER_MODE;
+        }
+        int alignment = readEnum(fields, "alignment", alignments, 3);
+        if (alignment >= 0) {
+            text.alignment = static_cast<uint32_t>(alignment);
+            record.fields |= TextRecord::ALIGNMENT;
+        }
+        if (fields.getFloat("scale", text.scale)) record.fields |= TextRecord::SCALE;
+        if (fields.getFloat("lineSpacing", text.lineSpacing)) record.fields |= TextRecord::LINE_SPACING;
+    } else if (type == "ScriptComponent") {
+        record = SceneDescription::createComponent(SceneComponentType::SCRIPT);
+        ScriptRecord& script = record.script;
+        // "script" is the legacy key
+        script.scriptPath = readString(fields, "scriptPath", description);
+        if (script.scriptPath == SceneDescription::NO_STRING) {
+            script.scriptPath = readString(fields, "script", description);
+        }
+        if (fields.getBool("pauseExempt", script.pauseExempt)) record.fields |= ScriptRecord::PAUSE_EXEMPT;
+    } else if (type == "SoundComponent") {
+        record = SceneDescription::createComponent(SceneComponentType::SOUND);
+        SoundRecord& sound = record.sound;
+        sound.soundFile = readString(fields, "soundFile", description);
+        if (fields.getFloat("volume", sound.volume)) record.fields |= SoundRecord::VOLUME;
+        if (fields.getBool("loop", sound.loop)) record.fields |= SoundRecord::LOOP;
+        if (fields.getFloat("pitch", sound.pitch)) record.fields |= SoundRecord::PITCH;
+        if (fields.getInt("priority", sound.priority)) record.fields |= SoundRecord::PRIORITY;
+        if (fields.getBool("spatial", sound.spatial)) record.fields |= SoundRecord::SPATIAL;
+        if (fields.getFloat("minDistance", sound.minDistance) && fields.getFloat("maxDistance", sound.maxDistance)) {
+            record.fields |= SoundRecord::DISTANCE_RANGE;
+        }
+        if (fields.getFloat("rolloff", sound.rolloff)) record.fields |= SoundRecord::ROLLOFF;
+    } else if (type == "SkyboxComponent") {
+        record = SceneDescription::createComponent(SceneComponentType::SKYBOX);
+        SkyboxRecord& skybox = record.skybox;
+        static const char* const faces[] = { "rightTexture", "leftTexture", "topTexture",
+                                             "bottomTexture", "frontTexture", "backTexture" };
+        for (int i = 0; i < 6; ++i) {
+            skybox.faces[i] = readString(fields, faces[i], description);
+        }
+        if (fields.getBool("active", skybox.active)) record.fields |= SkyboxRecord::ACTIVE;
+    } else if (type == "Area3DComponent") {
+        record = SceneDescription::createComponent(SceneComponentType::AREA3D);
+        Area3DRecord& area = record.area3D;
+        static const char* const shapes[] = { "BOX", "SPHERE", "CAPSULE", "CYLINDER", "PLANE" };
+        int shape = readEnum(fields, "shapeType", shapes, 5);
+        if (shape >= 0) {
+            area.shape = static_cast<uint32_t>(shape);
+            record.fields |= Area3DRecord::SHAPE;
+        }
+        if (fields.getFloats("dimensions", area.dimensions, 3)) record.fields |= Area3DRecord::DIMENSIONS;
+        if (fields.getFloat("radius", area.radius)) record.fields |= Area3DRecord::RADIUS;
+        if (fields.getFloat("height", area.height)) record.fields |= Area3DRecord::HEIGHT;
+        area.group = readString(fields, "group", description);
+        if (fields.getBool("monitorMode", area.monitorMode)) record.fields |= Area3DRecord::MONITOR_MODE;
+        if (fields.getBool("showDebugShape", area.showDebugShape)) record.fields |= Area3DRecord::SHOW_DEBUG_SHAPE;
+    } else if (type == "AnimationComponent") {
+        record = SceneDescription::createComponent(SceneComponentType::ANIMATION);
+        AnimationRecord& animation = record.animation;
+        animation.skeletonName = readString(fields, "skeletonName", description);
+        animation.animationClipName = readString(fields, "animationClipName", description);
+        if (fields.getBool("loop", animation.loop)) record.fields |= AnimationRecord::LOOP;
+        if (fields.getFloat("speed", animation.speed)) record.fields |= AnimationRecord::SPEED;
+        if (fields.getBool("enableRootMotion", animation.enableRootMotion)) record.fields |= AnimationRecord::ROOT_MOTION;
+        uint8_t autoPlay = 0;
+        if (fields.getBool("autoPlay", autoPlay) && autoPlay) record.fields |= AnimationRecord::AUTO_PLAY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void readDomNode(const json& nodeJson, int32_t parent, SceneDescription& description) {
+    int32_t index = static_cast<int32_t>(description.nodes.size());
+    description.nodes.push_back(SceneDescription::createNode(SceneDescription::NO_STRING, parent));
+    describeNode(DomFields(&nodeJson), description, description.nodes[index]);
+    description.nodes[index].firstComponent = static_cast<uint32_t>(description.components.size());
+
+    auto componentsIt = nodeJson.find("components");
+    if (componentsIt != nodeJson.end() && componentsIt->is_array()) {
+        for (const auto& componentJson : *componentsIt) {
+            SceneComponentRecord record;
+            if (describeComponent(DomFields(&componentJson), description, record)) {
+                description.components.push_back(record);
+                description.nodes[index].componentCount++;
+            }
+        }
+    }
+
+    // Children, depth first so every parent precedes its subtree
+    auto childrenIt = nodeJson.find("children");
+    if (childrenIt != nodeJson.end() && childrenIt->is_array()) {
+        for (const auto& childJson : *childrenIt) {
+            if (childJson.is_object()) {
+                readDomNode(childJson, index, description);
+            }
+        }
+    }
+}
+
+// nlohmann::json::sax_parse handler for the scene schema. The structure
+// (rootNode, children, components) streams straight into the description;
+// everything else is buffered per object and mapped when the object closes,
+// since keys arrive in any order ("type" usually comes after the fields it
+// decides, and the editor writes "children" before a node's own name).
+// Components reach their node after its subtree, so they are collected with
+// their owner and put in node order at the end
+class SceneSaxHandler {
+public:
+    explicit SceneSaxHandler(SceneDescription& description)
+        : description(description), poolTop(0), hasName(false), hasCamera(false), hasSkybox(false),
+          errorPosition(0), structureError(false) {}
+
+    bool null() {
+        scalar(BufferedField::OTHER);
+        return !structureError;
+    }
+
+    bool boolean(bool val) {
+        BufferedField* field = scalar(BufferedField::BOOLEAN);
+        if (field) field->boolean = val;
+        return !structureError;
+    }
+
+    bool number_integer(json::number_integer_t val) {
+        BufferedField* field = scalar(BufferedField::INTEGER, static_cast<float>(val));
+        if (field) field->integer = val;
+        return !structureError;
+    }
+
+    bool number_unsigned(json::number_unsigned_t val) {
+        BufferedField* field = scalar(BufferedField::UNSIGNED, static_cast<float>(val));
+        if (field) field->unsignedInteger = val;
+        return !structureError;
+    }
+
+    bool number_float(json::number_float_t val, const std::string&) {
+        BufferedField* field = scalar(BufferedField::FLOAT, static_cast<float>(val));
+        if (field) field->number = val;
+        return !structureError;
+    }
+
+    bool string(std::string& val) {
+        if (!stack.empty() && stack.back().kind == Frame::SCENE) {
+            std::string* target = sceneString();
+            if (target) {
+                target->swap(val);
+                setSceneString(true);
+            }
+            return true;
+        }
+        BufferedField* field = scalar(BufferedField::TEXT);
+        if (field) field->text.assign(val);
+        return !structureError;
+    }
+
+    template <typename Binary>
+    bool binary(Binary&) {
+        scalar(BufferedField::OTHER);
+        return !structureError;
+    }
+
+    bool start_object(std::size_t) {
+        if (stack.empty()) {
+            stack.push_back(Frame(Frame::SCENE));
+            return true;
+        }
+        Frame& top = stack.back();
+        switch (top.kind) {
+            case Frame::SKIP:
+                top.depth++;
+                break;
+            case Frame::SCENE:
+                setSceneString(false);
+                if (currentKey == "rootNode" && description.nodes.empty()) {
+                    beginNode(-1);
+                } else {
+                    stack.push_back(Frame(Frame::SKIP));
+                }
+                break;
+            case Frame::CHILDREN:
+                beginNode(top.node);
+                break;
+            case Frame::COMPONENTS: {
+                Frame frame(Frame::COMPONENT);
+                frame.node = top.node;
+                frame.buffer = allocateBuffer();
+                stack.push_back(frame);
+                break;
+            }
+            case Frame::ARRAY:
+                addElement(false, 0.0f);
+                stack.push_back(Frame(Frame::SKIP));
+                break;
+            case Frame::NODE:
+                if (currentKey == "children" || currentKey == "components") {
+                    stack.push_back(Frame(Frame::SKIP));
+                    break;
+                }
+                // fall through: any other object is a field of the node
+            case Frame::COMPONENT:
+            case Frame::OBJECT: {
+                size_t child = allocateBuffer();
+                BufferedField& field = pool[stack.back().buffer].set(currentKey);
+                field.type = BufferedField::OBJECT;
+                field.object = child;
+                Frame frame(Frame::OBJECT);
+                frame.buffer = child;
+                stack.push_back(frame);
+                break;
+            }
+        }
+        return true;
+    }
+
+    bool end_object() {
+        Frame top = stack.back();
+        if (top.kind == Frame::SKIP) {
+            return endSkip();
+        }
+        stack.pop_back();
+
+        if (top.kind == Frame::NODE) {
+            describeNode(BufferedFields(&pool, top.buffer), description, description.nodes[top.node]);
+            poolTop = top.buffer;
+        } else if (top.kind == Frame::COMPONENT) {
+            SceneComponentRecord record;
+            if (describeComponent(BufferedFields(&pool, top.buffer), description, record)) {
+                components.push_back(record);
+                owners.push_back(static_cast<uint32_t>(top.node));
+            }
+            poolTop = top.buffer;
+        } else if (top.kind == Frame::SCENE) {
+            finish();
+        }
+        // OBJECT buffers stay until their owner closes
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        if (stack.empty()) return failStructure();
+        Frame& top = stack.back();
+        switch (top.kind) {
+            case Frame::SKIP:
+                top.depth++;
+                break;
+            case Frame::NODE:
+                if (currentKey == "children" || currentKey == "components") {
+                    Frame frame(currentKey == "children" ? Frame::CHILDREN : Frame::COMPONENTS);
+                    frame.node = top.node;
+                    stack.push_back(frame);
+                    break;
+                }
+                // fall through: any other array is a field of the node
+            case Frame::COMPONENT:
+            case Frame::OBJECT: {
+                BufferedField& field = pool[top.buffer].set(currentKey);
+                field.type = BufferedField::ARRAY;
+                Frame frame(Frame::ARRAY);
+                frame.buffer = top.buffer;
+                frame.field = static_cast<size_t>(&field - &pool[top.buffer].fields[0]);
+                stack.push_back(frame);
+                break;
+            }
+            case Frame::ARRAY:
+                addElement(false, 0.0f);
+                stack.push_back(Frame(Frame::SKIP));
+                break;
+            case Frame::SCENE:
+                setSceneString(false);
+                stack.push_back(Frame(Frame::SKIP));
+                break;
+            default:
+                stack.push_back(Frame(Frame::SKIP));
+                break;
+        }
+        return true;
+    }
+
+    bool end_array() {
+        if (stack.back().kind == Frame::SKIP) {
+            return endSkip();
+        }
+        stack.pop_back();
+        return true;
+    }
+
+    bool key(std::string& val) {
+        if (stack.back().kind != Frame::SKIP) {
+            currentKey.swap(val);
+        }
+        return true;
+    }
+
+    template <typename Exception>
+    bool parse_error(std::size_t position, const std::string&, const Exception&) {
+        errorPosition = position;
+        return false;
+    }
+
+    size_t getErrorPosition() const { return errorPosition; }
+    bool hasStructureError() const { return structureError; }
+
+private:
+    struct Frame {
+        enum Kind { SCENE, NODE, CHILDREN, COMPONENTS, COMPONENT, OBJECT, ARRAY, SKIP };
+
+        explicit Frame(Kind kind) : kind(kind), node(-1), buffer(0), field(0), depth(0) {}
+
+        Kind kind;
+        int32_t node;           // NODE, CHILDREN, COMPONENTS, COMPONENT
+        size_t buffer;          // NODE, COMPONENT, OBJECT, ARRAY: fields being collected
+        size_t field;           // ARRAY: slot in that buffer
+        int depth;              // SKIP: containers opened inside the skipped value
+    };
+
+    void beginNode(int32_t parent) {
+        Frame frame(Frame::NODE);
+        frame.node = static_cast<int32_t>(description.nodes.size());
+        frame.buffer = allocateBuffer();
+        description.nodes.push_back(SceneDescription::createNode(SceneDescription::NO_STRING, parent));
+        stack.push_back(frame);
+    }
+
+    // Buffers form a stack alongside the frames; slots keep their storage
+    size_t allocateBuffer() {
+        if (poolTop == pool.size()) pool.push_back(FieldBuffer());
+        pool[poolTop].count = 0;
+        return poolTop++;
+    }
+
+    // A scalar becomes a field of the object being buffered (the returned
+    // slot) or an element of the array being read; anywhere else it is dropped
+    BufferedField* scalar(BufferedField::Type type, float element = 0.0f) {
+        if (stack.empty()) {
+            failStructure();
+            return nullptr;
+        }
+        Frame& top = stack.back();
+        switch (top.kind) {
+            case Frame::NODE:
+            case Frame::COMPONENT:
+            case Frame::OBJECT: {
+                BufferedField& field = pool[top.buffer].set(currentKey);
+                field.type = type;
+                return &field;
+            }
+            case Frame::ARRAY:
+                addElement(type == BufferedField::INTEGER || type == BufferedField::UNSIGNED ||
+                           type == BufferedField::FLOAT, element);
+                return nullptr;
+            case Frame::SCENE:
+                setSceneString(false);
+                return nullptr;
+            default:
+                return nullptr;
+        }
+    }
+
+    void addElement(bool numeric, float element) {
+        const Frame& top = stack.back();
+        BufferedField& field = pool[top.buffer].fields[top.field];
+        if (numeric && field.elementCount < BufferedField::MAX_ELEMENTS) {
+            field.elements[field.elementCount] = element;
+            field.numericMask |= 1u << field.elementCount;
+        }
+        field.elementCount++;
+    }
+
+    // The scene-level strings, kept until the document closes
+    std::string* sceneString() {
+        if (currentKey == "name") return &sceneName;
+        if (currentKey == "activeCamera") return &activeCamera;
+        if (currentKey == "activeSkybox") return &activeSkybox;
+        return nullptr;
+    }
+
+    // Any other value for one of them (null included) leaves it unset
+    void setSceneString(bool present) {
+        if (currentKey == "name") hasName = present;
+        else if (currentKey == "activeCamera") hasCamera = present;
+        else if (currentKey == "activeSkybox") hasSkybox = present;
+    }
+
+    bool endSkip() {
+        Frame& top = stack.back();
+        if (top.depth == 0) {
+            stack.pop_back();
+        } else {
+            top.depth--;
+        }
+        return true;
+    }
+
+    // The document has to be an object; anything else isn't a scene
+    bool failStructure() {
+        structureError = true;
+        return false;
+    }
+
+    void finish() {
+        description.name = description.addString(hasName ? sceneName : std::string("Loaded Scene"));
+        // null when the scene had none
+        description.activeCamera = hasCamera ? description.addString(activeCamera) : SceneDescription::NO_STRING;
+        description.activeSkybox = hasSkybox ? description.addString(activeSkybox) : SceneDescription::NO_STRING;
+
+        // Counting sort by owner: each node's components end up contiguous, in
+        // node order, and in the order they were written
+        std::vector<SceneNodeRecord>& nodes = description.nodes;
+        for (size_t i = 0; i < owners.size(); ++i) {
+            nodes[owners[i]].componentCount++;
+        }
+        uint32_t next = 0;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            nodes[i].firstComponent = next;
+            next += nodes[i].componentCount;
+        }
+        description.components.resize(components.size());
+        std::vector<uint32_t> cursor(nodes.size(), 0);
+        for (size_t i = 0; i < components.size(); ++i) {
+            const SceneNodeRecord& node = nodes[owners[i]];
+            description.components[node.firstComponent + cursor[owners[i]]++] = components[i];
+        }
+    }
+
+    SceneDescription& description;
+    std::vector<Frame> stack;
+    std::vector<FieldBuffer> pool;
+    size_t poolTop;
+    std::string currentKey;
+
+    std::vector<SceneComponentRecord> components;
+    std::vector<uint32_t> owners;
+
+    std::string sceneName;
+    std::string activeCamera;
+    std::string activeSkybox;
+    bool hasName;
+    bool hasCamera;
+    bool hasSkybox;
+
+    size_t errorPosition;
+    bool structureError;
+};
+
+void reportParseError(size_t position) {
+#ifdef VITA_BUILD
+    printf("Error parsing scene JSON at byte %u\n", static_cast<unsigned>(position));
+#else
+    std::cerr << "Error parsing scene JSON at byte " << position << std::endl;
+#endif
+}
+
+} // namespace
+
+bool SceneJsonReader::read(const std::string& jsonData, SceneDescription& description) {
+    description.clear();
+
+    // sax_parse reports errors through the handler rather than by throwing, so
+    // the Vita build (no exceptions) gets them too
+    SceneSaxHandler handler(description);
+    if (!json::sax_parse(jsonData, &handler)) {
+        if (handler.hasStructureError()) {
+#ifdef VITA_BUILD
+            printf("Error parsing scene JSON: not an object\n");
+#else
+            std::cerr << "Error parsing scene JSON: not an object" << std::endl;
+#endif
+        } else {
+            reportParseError(handler.getErrorPosition());
+        }
+        description.clear();
+        return false;
+    }
+    PrefabLibrary::getInstance().expandInstances(description);
+    return true;
+}
+
+bool SceneJsonReader::readDom(const json& sceneJson, SceneDescription& description) {
+    description.clear();
+    if (!sceneJson.is_object()) {
+        return false;
+    }
+
+    DomFields scene(&sceneJson);
+    uint32_t name = readString(scene, "name", description);
+    description.name = (name != SceneDescription::NO_STRING) ? name : description.addString("Loaded Scene");
+
+    auto root = sceneJson.find("rootNode");
+    if (root != sceneJson.end() && root->is_object()) {
+        readDomNode(*root, -1, description);
+    }
+
+    // null when the scene had none
+    description.activeCamera = readString(scene, "activeCamera", description);
+    description.activeSkybox = readString(scene, "activeSkybox", description);
+    PrefabLibrary::getInstance().expandInstances(description);
+    return true;
+}
+
+} // namespace GameEngine
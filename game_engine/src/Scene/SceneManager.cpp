@@ -77,6 +77,13 @@ void SceneManager::render() {
     }
 }
 
+void SceneManager::capture() {
+    if (currentScene) {
+        auto& renderer = GetEngine().getRenderer();
+        currentScene->capture(renderer);
+    }
+}
+
 std::vector<std::string> SceneManager::getSceneNames() const {
     std::vector<std::string> names;
     for (const auto& pair : scenes) {
@@ -96,7 +103,7 @@ bool SceneManager::saveScene(const std::string& name, const std::string& filepat
 bool SceneManager::loadSceneFromFile(const std::string& name, const std::string& filepath) {
     unloadCurrentScene();
     
-    auto scene = SceneSerializer::loadSceneFromFile(filepath);
+    auto scene = SceneSerializer::loadSceneFromFile(filepath, loadProgressCallback);
     if (scene) {
         scene->setName(name);
         scenes[name] = scene;
@@ -11,16 +11,75 @@
 
 namespace GameEngine {
 
+// Handle table shared by all nodes; a slot's generation advances when its node
+// is destroyed so outstanding handles to it stop resolving
+namespace {
+struct NodeSlot {
+    SceneNode* node;
+    uint32_t generation;
+};
+
+// Never freed: nodes owned by static objects may be destroyed during exit
+std::vector<NodeSlot>& nodeSlots() {
+    static std::vector<NodeSlot>* slots = new std::vector<NodeSlot>();
+    return *slots;
+}
+
+std::vector<uint32_t>& freeNodeSlots() {
+    static std::vector<uint32_t>* freeSlots = new std::vector<uint32_t>();
+    return *freeSlots;
+}
+
+NodeHandle allocateNodeHandle(SceneNode* node) {
+    auto& slots = nodeSlots();
+    auto& freeSlots = freeNodeSlots();
+    
+    NodeHandle handle;
+    if (!freeSlots.empty()) {
+        handle.index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        handle.index = static_cast<uint32_t>(slots.size());
+        slots.push_back(NodeSlot{ nullptr, 1 });
+    }
+    slots[handle.index].node = node;
+    handle.generation = slots[handle.index].generation;
+    return handle;
+}
+
+void releaseNodeHandle(NodeHandle handle) {
+    NodeSlot& slot = nodeSlots()[handle.index];
+    slot.node = nullptr;
+    if (++slot.generation == 0) {
+        slot.generation = 1; // 0 is reserved for the null handle
+    }
+    freeNodeSlots().push_back(handle.index);
+}
+} // namespace
+
+SceneNode* SceneNode::resolve(NodeHandle handle) {
+    const auto& slots = nodeSlots();
+    if (handle.isNull() || handle.index >= slots.size()) {
+        return nullptr;
+    }
+    const NodeSlot& slot = slots[handle.index];
+    return slot.generation == handle.generation ? slot.node : nullptr;
+}
+
 SceneNode::SceneNode(const std::string& name)
     : name(name)
     , parent(nullptr)
+    , hierarchyVersion(1)
     , visible(true)
     , active(true)
     , selected(false)
 {
+    handle = allocateNodeHandle(this);
 }
 
 SceneNode::~SceneNode() {
+    releaseNodeHandle(handle);
+    
     for (auto& component : components) {
         if (component->getTypeName() == "LightComponent") {
             auto& lightingManager = LightingManager::getInstance();
@@ -56,6 +115,7 @@ void SceneNode::addChild(std::shared_ptr<SceneNode> child) {
     
     child->parent = this;
     children.push_back(child);
+    markHierarchyChanged();
 }
 
 void SceneNode::removeChild(std::shared_ptr<SceneNode> child) {
@@ -65,6 +125,7 @@ void SceneNode::removeChild(std::shared_ptr<SceneNode> child) {
     if (it != children.end()) {
         (*it)->parent = nullptr;
         children.erase(it);
+        markHierarchyChanged();
     }
 }
 
@@ -82,6 +143,7 @@ void SceneNode::removeAllChildren() {
         }
     }
     children.clear();
+    markHierarchyChanged();
 }
 
 std::shared_ptr<SceneNode> SceneNode::getChild(const std::string& childName) {
@@ -126,14 +188,9 @@ void SceneNode::update(float deltaTime) {
     
     for (auto& component : components) {
         if (component->isEnabled()) {
-            if (auto* scriptComp = dynamic_cast<ScriptComponent*>(component.get())) {
-                if (paused) {
-                    if (scriptComp->isPauseExempt()) {
-                        scriptComp->update(deltaTime);
-                    }
-                } else {
-                    scriptComp->update(deltaTime);
-                }
+            if (dynamic_cast<ScriptComponent*>(component.get())) {
+                // Driven by ScriptManager::updateScriptComponents from Scene::update
+                continue;
             } else if (auto* soundComp = dynamic_cast<SoundComponent*>(component.get())) {
                 soundComp->update(deltaTime);
             } else {
@@ -239,6 +296,15 @@ void SceneNode::reorderChild(size_t fromIndex, size_t toIndex) {
     children.erase(children.begin() + fromIndex);
     
     children.insert(children.begin() + toIndex, childToMove);
+    markHierarchyChanged();
+}
+
+void SceneNode::markHierarchyChanged() {
+    SceneNode* root = this;
+    while (root->parent) {
+        root = root->parent;
+    }
+    ++root->hierarchyVersion;
 }
 
 } // namespace GameEngine
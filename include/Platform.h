@@ -57,5 +57,8 @@ void platformSwapBuffers();
 void platformSetVSync(bool enabled);
 float platformGetTime(); // Returns time in seconds
 void platformSleep(int microseconds);
+// Linux only: the next platformInit() creates a hidden window with a
+// software (OSMesa/llvmpipe) context, for CI runs without a display
+void platformSetHeadless(bool enabled);
 
 #endif // PLATFORM_H
@@ -7,13 +7,18 @@ local scoreNodeName = "Score"
 local score = 0
 local ballRespawnPosition = {0.0, 0.0, 0.0}
 local hasScored = false
+local ballNode = nil
+local ballBody = nil
 
 function start()
     goalArea3D = area3D.getComponent(goalAreaNodeName)
     ballArea3D = area3D.getComponent(ballAreaNodeName)
     
-    local bx, by, bz = getNodePosition(ballNodeName)
-    if bx and by and bz then
+    ballNode = getNode(ballNodeName)
+    ballBody = getNode("SphereCollision")
+    
+    if ballNode then
+        local bx, by, bz = ballNode:getPosition()
         ballRespawnPosition[1] = bx
         ballRespawnPosition[2] = by
         ballRespawnPosition[3] = bz
@@ -63,27 +68,27 @@ function update(deltaTime)
         
         renderer.setText(scoreNodeName, "Score : " .. score)
         
-        if setNodeVelocity then
-            setNodeVelocity("SphereCollision", 0, 0, 0)
-        end
+        if not (ballNode and ballNode:isValid()) then ballNode = getNode(ballNodeName) end
+        if not (ballBody and ballBody:isValid()) then ballBody = getNode("SphereCollision") end
         
-        if setNodeAngularVelocity then
-            setNodeAngularVelocity("SphereCollision", 0, 0, 0)
+        if ballBody then
+            ballBody:setVelocity(0, 0, 0)
+            ballBody:setAngularVelocity(0, 0, 0)
         end
         
-        setNodePosition(ballNodeName, ballRespawnPosition[1], ballRespawnPosition[2], ballRespawnPosition[3])
-        
-        if setNodeVelocity then
-            setNodeVelocity("SphereCollision", 0, 0, 0)
+        if ballNode then
+            ballNode:setPosition(ballRespawnPosition[1], ballRespawnPosition[2], ballRespawnPosition[3])
         end
-        if setNodeAngularVelocity then
-            setNodeAngularVelocity("SphereCollision", 0, 0, 0)
+        
+        if ballBody then
+            ballBody:setVelocity(0, 0, 0)
+            ballBody:setAngularVelocity(0, 0, 0)
         end
         
         print("Goal! Score: " .. score .. " - Respawned ball to (" .. ballRespawnPosition[1] .. ", " .. ballRespawnPosition[2] .. ", " .. ballRespawnPosition[3] .. ")")
         
-        local checkX, checkY, checkZ = getNodePosition(ballNodeName)
-        if checkX and checkY and checkZ then
+        if ballNode then
+            local checkX, checkY, checkZ = ballNode:getPosition()
             print("Ball position after respawn: (" .. checkX .. ", " .. checkY .. ", " .. checkZ .. ")")
         end
     elseif not ballInGoal and hasScored then
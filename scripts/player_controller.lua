@@ -38,6 +38,17 @@ local runPitch = 1.5
 local lastMovementState = false
 local stopSoundFrameCount = 0
 
+-- Node handles, resolved once instead of looked up by name every frame
+local playerNode = nil
+local playerBody = nil
+local cameraNode = nil
+
+local function resolveNodes()
+    if not (playerNode and playerNode:isValid()) then playerNode = getNode(playerRootName) end
+    if not (playerBody and playerBody:isValid()) then playerBody = getNode("PlayerCollision") end
+    if not (cameraNode and cameraNode:isValid()) then cameraNode = getNode(cameraName) end
+end
+
 function start()
     lastJumpTime = getTime()
     
@@ -96,8 +107,10 @@ function update(deltaTime)
         stopSoundFrameCount = stopSoundFrameCount - 1
     end
 
-    if setNodeAngularFactor then
-        setNodeAngularFactor("PlayerCollision", 0, 0, 0)
+    resolveNodes()
+
+    if playerBody then
+        playerBody:setAngularFactor(0, 0, 0)
     end
 
     local moveH = input.getActionAxis("MoveHorizontal")
@@ -216,17 +229,13 @@ function update(deltaTime)
 
 		currentPlayerYaw = currentPlayerYaw + diff * math.min(turnSpeed * deltaTime, 1)
 
-		if setNodeRotation then
-			setNodeRotation(playerRootName, 0, currentPlayerYaw, 0)
+		if playerNode then
+			playerNode:setRotation(0, currentPlayerYaw, 0)
 		end
 	end
 
-    if setNodeVelocity then
-        local vx, vy, vz = 0, 0, 0
-        if getNodeVelocity then
-            local gvx, gvy, gvz = getNodeVelocity("PlayerCollision")
-            if gvx and gvy and gvz then vx, vy, vz = gvx, gvy, gvz end
-        end
+    if playerBody then
+        local vx, vy, vz = playerBody:getVelocity()
 
         vx = (moveH ~= 0 or moveV ~= 0) and desiredVelX or 0
         vz = (moveH ~= 0 or moveV ~= 0) and desiredVelZ or 0
@@ -239,19 +248,17 @@ function update(deltaTime)
             end
         end
 
-        setNodeVelocity("PlayerCollision", vx, vy, vz)
-    else
-        local px, py, pz = getNodePosition(playerRootName)
-        if px and py and pz then
-            setNodePosition(playerRootName,
-                px + desiredVelX * deltaTime,
-                py + moveY * currentMoveSpeed * deltaTime,
-                pz + desiredVelZ * deltaTime)
-        end
+        playerBody:setVelocity(vx, vy, vz)
+    elseif playerNode then
+        local px, py, pz = playerNode:getPosition()
+        playerNode:setPosition(
+            px + desiredVelX * deltaTime,
+            py + moveY * currentMoveSpeed * deltaTime,
+            pz + desiredVelZ * deltaTime)
     end
 
-    local px, py, pz = getNodePosition(playerRootName)
-    if px and py and pz then
+    if playerNode and cameraNode then
+        local px, py, pz = playerNode:getPosition()
         local radYaw = math.rad(cameraYaw)
         local radPitch = math.rad(cameraPitch)
 
@@ -264,11 +271,8 @@ function update(deltaTime)
             camY = minY
         end
 
-        setNodePosition(cameraName, camX, camY, camZ)
-
-        if setNodeLookAt then
-            setNodeLookAt(cameraName, px, py + cameraHeight, pz)
-        end
+        cameraNode:setPosition(camX, camY, camZ)
+        cameraNode:lookAt(px, py + cameraHeight, pz)
     end
 
     if input.isActionPressed("Interact") then
@@ -0,0 +1,16 @@
+-- Script dispatch check (lua_test --dispatch-check)
+-- Loaded on three nodes. Each update counts itself in the node's x position;
+-- the "Remover" script also has C++ destroy the "Victim" node, whose script
+-- was dispatched just before it
+
+function start()
+end
+
+function update(deltaTime)
+    if node().getName() == "Remover" then
+        removeVictim()
+    end
+    
+    local x = node().getPosition()
+    setPosition(x + 1, 0, 0)
+end
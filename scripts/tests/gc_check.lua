@@ -0,0 +1,13 @@
+-- Script GC check (lua_test --gc-check)
+-- Makes a few hundred KB of garbage every frame, more than a tiny step budget
+-- can reclaim, so only the memory limit keeps the heap bounded
+
+function start()
+end
+
+function update(deltaTime)
+    local junk = {}
+    for i = 1, 2000 do
+        junk[i] = { i, i * 2 }
+    end
+end
@@ -0,0 +1,84 @@
+-- Script math check (lua_test --math-check)
+-- Exercises the vec3 / quat / mat4 metamethods and the out-argument form of
+-- the vector getters. Reports through the node position: x counts passed
+-- checks, y failed ones, and z is 1 once every check has run
+
+local passed = 0
+local failed = 0
+
+local function check(name, condition)
+    if condition then
+        passed = passed + 1
+    else
+        failed = failed + 1
+        print("math check failed: " .. name)
+    end
+end
+
+local function near(a, b)
+    return math.abs(a - b) < 0.0001
+end
+
+local function nearVec3(v, x, y, z)
+    return near(v.x, x) and near(v.y, y) and near(v.z, z)
+end
+
+function start()
+    -- vec3 metamethods
+    local a = vec3(1, 2, 3)
+    local b = vec3(4, 5, 6)
+    check("vec3 __add", nearVec3(a + b, 5, 7, 9))
+    check("vec3 __sub", nearVec3(b - a, 3, 3, 3))
+    check("vec3 __mul scalar", nearVec3(a * 2, 2, 4, 6))
+    check("vec3 __mul scalar first", nearVec3(2 * a, 2, 4, 6))
+    check("vec3 __mul component-wise", nearVec3(a * b, 4, 10, 18))
+    check("vec3 __div", nearVec3(b / 2, 2, 2.5, 3))
+    check("vec3 __unm", nearVec3(-a, -1, -2, -3))
+    check("vec3 __eq", a == vec3(1, 2, 3) and a ~= b)
+    check("vec3 __tostring", tostring(a):sub(1, 5) == "vec3(")
+    check("vec3 __newindex", pcall(function() a.w = 1 end) == false)
+    a.x = 7
+    check("vec3 field write", nearVec3(a, 7, 2, 3))
+    check("vec3 operators allocate", (a + b) ~= a and nearVec3(a, 7, 2, 3))
+    
+    -- quat metamethods
+    local yaw = quat.fromAxisAngle(vec3(0, 1, 0), 90)
+    check("quat __mul vec3", nearVec3(yaw * vec3(1, 0, 0), 0, 0, -1))
+    local half = quat.fromAxisAngle(vec3(0, 1, 0), 45)
+    local composed = half * half
+    check("quat __mul quat", near(composed.w, yaw.w) and near(composed.y, yaw.y))
+    check("quat __eq", quat() == quat(1, 0, 0, 0) and yaw ~= quat())
+    check("quat __tostring", tostring(quat()):sub(1, 5) == "quat(")
+    
+    -- mat4 metamethods
+    local move = mat4():compose(vec3(1, 2, 3), quat(), vec3(1, 1, 1))
+    local scale = mat4():compose(vec3(0, 0, 0), quat(), vec3(2, 2, 2))
+    check("mat4 __mul", nearVec3((move * scale):transformPoint(vec3(1, 1, 1)), 3, 4, 5))
+    check("mat4 __eq", mat4() == mat4() and move ~= mat4())
+    check("mat4 __tostring", tostring(move):sub(1, 5) == "mat4(")
+    
+    -- Out-argument form: the result lands in the vec3 passed in, which is
+    -- also what comes back; without one the getter returns plain numbers
+    setPosition(1, 2, 3)
+    local out = vec3()
+    local returned = node().getPosition(out)
+    check("node().getPosition(out) writes out", nearVec3(out, 1, 2, 3))
+    check("node().getPosition(out) returns out", rawequal(returned, out))
+    local x, y, z = node().getPosition()
+    check("node().getPosition() numbers", near(x, 1) and near(y, 2) and near(z, 3))
+    
+    local self = getNode(node().getName())
+    local localOut = vec3(9, 9, 9)
+    check("handle:getLocalPosition(out)", rawequal(self:getLocalPosition(localOut), localOut)
+        and nearVec3(localOut, 1, 2, 3))
+    x, y, z = self:getLocalPosition()
+    check("handle:getLocalPosition() numbers", near(x, 1) and near(y, 2) and near(z, 3))
+    
+    local translation = vec3()
+    check("mat4:getTranslation(out)", rawequal(move:getTranslation(translation), translation)
+        and nearVec3(translation, 1, 2, 3))
+    local euler = vec3()
+    check("quat:toEuler(out)", rawequal(half:toEuler(euler), euler) and near(euler.y, 45))
+    
+    setPosition(passed, failed, 1)
+end
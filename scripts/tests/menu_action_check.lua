@@ -0,0 +1,22 @@
+-- Menu action and callback check (lua_test --menu-check)
+-- Registers a menu whose action and show callback are this script's own
+-- functions, which live in its environment rather than in _G
+
+function start()
+    MenuManager.createMenu("menu_check")
+    MenuManager.addMenuItem("menu_check", "confirm", "Confirm", "onConfirm")
+    MenuManager.setMenuProperties("menu_check", false, "onShown")
+    MenuManager.showMenu("menu_check")
+end
+
+function onShown(menuId)
+    if menuId == "menu_check" then
+        setPosition(1, 0, 0)
+    end
+end
+
+function onConfirm(menuId, itemId)
+    if menuId == "menu_check" and itemId == "confirm" then
+        setPosition(1, 2, 0)
+    end
+end
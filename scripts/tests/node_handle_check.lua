@@ -0,0 +1,23 @@
+-- Node handle check (lua_test --hierarchy-check)
+-- Holds a handle to "Target". C++ destroys that node and hands its slot to a
+-- new one, after which the handle must stop resolving rather than reach it
+
+local target = nil
+
+function start()
+    target = getNode("Target")
+end
+
+function checkLive()
+    if target and target:isValid() and target:getName() == "Target" then
+        setPosition(1, 0, 0)
+    end
+end
+
+function checkStale()
+    -- Writes through a stale handle must not land on the slot's new node
+    target:setPosition(5, 5, 5)
+    if not target:isValid() and target:getName() == nil then
+        setPosition(1, 2, 0)
+    end
+end
@@ -0,0 +1,21 @@
+-- Pickup zone check (lua_test --pickup-check)
+-- Loaded on two nodes: each script puts its own node in a zone called
+-- "pickup" and must find only that node there, not the other script's
+
+function start()
+    pickupZone.createZone("pickup", 0, 0, 0, 1, 1, 1)
+    pickupZone.addObjectToZone("pickup", node().getName())
+end
+
+function update(deltaTime)
+    local count = 0
+    for _ in pairs(pickupZone.getObjectsInZone("pickup")) do
+        count = count + 1
+    end
+    
+    if count == 1 and pickupZone.isObjectInZone("pickup", node().getName()) then
+        setPosition(1, 0, 0)
+    else
+        setPosition(-1, 0, 0)
+    end
+end
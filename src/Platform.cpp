@@ -4,10 +4,13 @@
 
 #ifdef LINUX_BUILD
     #include <unistd.h>  // For usleep
+    #include <chrono>
+    #include <cstdlib>
 #endif
 
 #ifdef LINUX_BUILD
     GLFWwindow* window = nullptr;
+    static bool headless = false;
     
     // Input state tracking
     static uint32_t currentButtons = 0;
@@ -98,7 +101,20 @@
         }
     }
     
+    void platformSetHeadless(bool enabled) {
+        headless = enabled;
+    }
+    
     bool platformInit() {
+        if (headless) {
+            // Keep Mesa on llvmpipe even when a GPU driver is installed
+            setenv("LIBGL_ALWAYS_SOFTWARE", "1", 1);
+#ifdef GLFW_PLATFORM_NULL
+            // GLFW 3.4+: no X11/Wayland display needed at all
+            glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+        }
+        
         // Initialize GLFW
         if (!glfwInit()) {
             return false;
@@ -108,6 +124,13 @@
         glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
         
+        if (headless) {
+            glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef GLFW_OSMESA_CONTEXT_API
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+        }
+        
         // Create window with Vita resolution
         window = glfwCreateWindow(VITA_WIDTH, VITA_HEIGHT, "First Game - Linux Build", nullptr, nullptr);
         if (!window) {
@@ -177,10 +200,18 @@
     }
     
     void platformSetVSync(bool enabled) {
+        if (!window) {
+            return;
+        }
         glfwSwapInterval(enabled ? 1 : 0);
     }
     
     float platformGetTime() {
+        if (!window) {
+            // Null render backend: GLFW was never initialized
+            static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            return std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+        }
         return (float)glfwGetTime();
     }
     
@@ -216,4 +247,9 @@
     void platformSleep(int microseconds) {
         sceKernelDelayThread(microseconds);
     }
+    
+    void platformSetHeadless(bool enabled) {
+        // Always a real vitaGL context on the device
+        (void)enabled;
+    }
 #endif
@@ -0,0 +1,545 @@
+#ifdef LINUX_BUILD
+
+// Headless check of the software audio mixer (no sound card, no OpenAL).
+// Mixes synthetic clips and compares the output against a double precision
+// reference: native-rate stereo and mono, linear-interpolated resampling and
+// pitch, live pitch changes, looping, saturation, voice end and priority
+// voice stealing, 3D pan, attenuation, Doppler and virtual voices. Streams a WAV through the decoder ring and checks it plays
+// exactly like the same clip held in memory, and that the AudioManager cache
+// shares one clip per path. Then times a full voice pool into the null output.
+//
+// Usage:
+//   audio_mixer_test [--voices N] [--seconds S] [--seed N]
+
+#include "../game_engine/include/Audio/AudioMixer.h"
+#include "../game_engine/include/Audio/AudioManager.h"
+#include "../game_engine/include/Audio/AudioOutput.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace GameEngine;
+
+static const int OUTPUT_RATE = 48000;
+
+static std::shared_ptr<AudioClip> makeNoise(int channels, int sampleRate, size_t frames, int amplitude, std::mt19937& rng) {
+    std::shared_ptr<AudioClip> clip = std::make_shared<AudioClip>();
+    clip->channels = channels;
+    clip->sampleRate = sampleRate;
+    clip->samples.resize(frames * channels);
+    std::uniform_int_distribution<int> value(-amplitude, amplitude);
+    for (auto& sample : clip->samples) {
+        sample = static_cast<int16_t>(value(rng));
+    }
+    return clip;
+}
+
+static std::shared_ptr<AudioClip> makeConstant(int channels, size_t frames, int16_t value) {
+    std::shared_ptr<AudioClip> clip = std::make_shared<AudioClip>();
+    clip->channels = channels;
+    clip->sampleRate = OUTPUT_RATE;
+    clip->samples.assign(frames * channels, value);
+    return clip;
+}
+
+// Linear interpolation at a fractional clip frame, as the mixer is specified to do
+static double referenceSample(const AudioClip& clip, double position, int channel, bool loop) {
+    size_t frameCount = clip.getFrameCount();
+    size_t index = static_cast<size_t>(position);
+    size_t next = index + 1;
+    if (next >= frameCount) next = loop ? 0 : index;
+    double fraction = position - index;
+    int c = std::min(channel, clip.channels - 1);
+    double a = clip.samples[index * clip.channels + c];
+    double b = clip.samples[next * clip.channels + c];
+    return a + (b - a) * fraction;
+}
+
+static int maxError(const std::vector<int16_t>& output, const std::vector<double>& expected) {
+    int worst = 0;
+    for (size_t i = 0; i < output.size(); ++i) {
+        double clamped = std::max(-32768.0, std::min(32767.0, expected[i]));
+        worst = std::max(worst, static_cast<int>(std::fabs(output[i] - clamped) + 0.5));
+    }
+    return worst;
+}
+
+static bool report(const char* name, bool ok, const std::string& detail) {
+    printf("  %-22s %s  %s\n", name, ok ? "OK    " : "FAILED", detail.c_str());
+    return ok;
+}
+
+// One voice through the mixer against the reference, in uneven period sizes
+static bool runPlaybackCase(const char* name, const std::shared_ptr<AudioClip>& clip, float pitch, float volume, bool loop,
+                            int frames) {
+    AudioMixer mixer(8, OUTPUT_RATE);
+    VoiceParams params;
+    params.pitch = pitch;
+    params.volume = volume;
+    params.loop = loop;
+    VoiceId voice = mixer.play(clip, params);
+
+    std::vector<int16_t> output(frames * AudioMixer::OUTPUT_CHANNELS);
+    const int periods[3] = { 256, 77, 1500 };
+    int done = 0;
+    for (int p = 0; done < frames; ++p) {
+        int count = std::min(periods[p % 3], frames - done);
+        mixer.mix(output.data() + done * AudioMixer::OUTPUT_CHANNELS, count);
+        done += count;
+    }
+
+    std::vector<double> expected(output.size(), 0.0);
+    double step = static_cast<double>(pitch) * clip->sampleRate / OUTPUT_RATE;
+    double length = static_cast<double>(clip->getFrameCount());
+    double position = 0.0;
+    for (int i = 0; i < frames; ++i) {
+        if (position >= length) {
+            if (!loop) break;
+            position = std::fmod(position, length);
+        }
+        for (int c = 0; c < AudioMixer::OUTPUT_CHANNELS; ++c) {
+            expected[i * 2 + c] = referenceSample(*clip, position, c, loop) * volume;
+        }
+        position += step;
+    }
+
+    int error = maxError(output, expected);
+    bool finished = !loop && step * frames > length;
+    bool stateOk = (mixer.isPlaying(voice) != finished) && (mixer.getActiveVoiceCount() == (finished ? 0 : 1));
+    char detail[128];
+    snprintf(detail, sizeof(detail), "max error %d%s", error, stateOk ? "" : ", wrong voice state");
+    return report(name, error <= 2 && stateOk, detail);
+}
+
+// setPitch mid-stream keeps the cursor where it was
+static bool runPitchChangeCase(std::mt19937& rng) {
+    std::shared_ptr<AudioClip> clip = makeNoise(1, OUTPUT_RATE, 4000, 12000, rng);
+    AudioMixer mixer(4, OUTPUT_RATE);
+    VoiceId voice = mixer.play(clip, VoiceParams());
+
+    std::vector<int16_t> first(300 * 2);
+    std::vector<int16_t> second(500 * 2);
+    mixer.mix(first.data(), 300);
+    mixer.setPitch(voice, 2.0f);
+    mixer.mix(second.data(), 500);
+
+    std::vector<double> expected(second.size());
+    for (int i = 0; i < 500; ++i) {
+        expected[i * 2] = expected[i * 2 + 1] = clip->samples[300 + i * 2];
+    }
+    int error = maxError(second, expected);
+    char detail[64];
+    snprintf(detail, sizeof(detail), "max error %d", error);
+    return report("pitch change", error <= 1, detail);
+}
+
+static bool runSaturationCase() {
+    AudioMixer mixer(8, OUTPUT_RATE);
+    for (int i = 0; i < 4; ++i) {
+        mixer.play(makeConstant(2, 1000, 30000), VoiceParams());
+        mixer.play(makeConstant(1, 1000, -30000), VoiceParams());
+    }
+    // Four loud positive voices alone, then everything cancelling out
+    std::vector<int16_t> output(64 * 2);
+    mixer.mix(output.data(), 64);
+    bool cancelled = std::all_of(output.begin(), output.end(), [](int16_t s) { return s == 0; });
+
+    AudioMixer loud(8, OUTPUT_RATE);
+    for (int i = 0; i < 4; ++i) {
+        loud.play(makeConstant(2, 1000, 30000), VoiceParams());
+    }
+    loud.mix(output.data(), 64);
+    bool clippedHigh = std::all_of(output.begin(), output.end(), [](int16_t s) { return s == 32767; });
+
+    AudioMixer quiet(8, OUTPUT_RATE);
+    for (int i = 0; i < 4; ++i) {
+        quiet.play(makeConstant(1, 1000, -30000), VoiceParams());
+    }
+    quiet.mix(output.data(), 64);
+    bool clippedLow = std::all_of(output.begin(), output.end(), [](int16_t s) { return s == -32768; });
+
+    bool ok = cancelled && clippedHigh && clippedLow;
+    return report("saturation", ok, ok ? "clamped to int16, no wrap" : "output wrapped or did not cancel");
+}
+
+static bool runStealingCase() {
+    std::shared_ptr<AudioClip> clip = makeConstant(1, 48000, 1000);
+    AudioMixer mixer(4, OUTPUT_RATE);
+    VoiceParams low;
+    VoiceParams high;
+    high.priority = 5;
+
+    VoiceId lowVoices[4];
+    for (int i = 0; i < 4; ++i) {
+        lowVoices[i] = mixer.play(clip, low);
+    }
+
+    // Full pool: a higher priority voice takes the oldest low one
+    VoiceId stealer = mixer.play(clip, high);
+    bool stoleOldest = stealer != INVALID_VOICE && !mixer.isPlaying(lowVoices[0]) && mixer.isPlaying(lowVoices[1]);
+
+    // Equal priority steals too, paused voices before playing ones
+    mixer.pause(lowVoices[3]);
+    VoiceId equal = mixer.play(clip, low);
+    bool stolePaused = equal != INVALID_VOICE && !mixer.isPaused(lowVoices[3]) && mixer.isPlaying(lowVoices[1]);
+
+    // Fill with high priority voices; a low one is turned away
+    mixer.play(clip, high);
+    mixer.play(clip, high);
+    mixer.play(clip, high);
+    VoiceId rejected = mixer.play(clip, low);
+    AudioMixerStats stats = mixer.getStats();
+    bool rejectedLow = rejected == INVALID_VOICE && stats.voicesRejected == 1 && mixer.getActiveVoiceCount() == 4;
+
+    // Stale handles stay harmless
+    mixer.setVolume(lowVoices[0], 0.0f);
+    mixer.stop(lowVoices[1]);
+    bool staleOk = mixer.getActiveVoiceCount() == 4;
+
+    bool ok = stoleOldest && stolePaused && rejectedLow && staleOk;
+    char detail[128];
+    snprintf(detail, sizeof(detail), "%u started, %u stolen, %u rejected%s%s%s%s", stats.voicesStarted,
+             stats.voicesStolen, stats.voicesRejected, stoleOldest ? "" : ", wrong victim",
+             stolePaused ? "" : ", paused voice kept", rejectedLow ? "" : ", low priority admitted",
+             staleOk ? "" : ", stale handle hit a new voice");
+    return report("voice stealing", ok, detail);
+}
+
+static bool runPauseCase(std::mt19937& rng) {
+    std::shared_ptr<AudioClip> clip = makeNoise(2, OUTPUT_RATE, 2000, 8000, rng);
+    AudioMixer mixer(4, OUTPUT_RATE);
+    VoiceId voice = mixer.play(clip, VoiceParams());
+
+    std::vector<int16_t> output(100 * 2);
+    mixer.mix(output.data(), 100);
+    mixer.pause(voice);
+    mixer.mix(output.data(), 100);
+    bool silentWhilePaused = std::all_of(output.begin(), output.end(), [](int16_t s) { return s == 0; });
+    mixer.resume(voice);
+    mixer.setPaused(true);
+    mixer.mix(output.data(), 100);
+    bool silentWhileMixerPaused = std::all_of(output.begin(), output.end(), [](int16_t s) { return s == 0; });
+    mixer.setPaused(false);
+    mixer.mix(output.data(), 100);
+    // Paused time must not advance the voice: this period continues at frame 100
+    bool resumedInPlace = output[0] == clip->samples[200] && output[1] == clip->samples[201];
+
+    bool ok = silentWhilePaused && silentWhileMixerPaused && resumedInPlace;
+    return report("pause/resume", ok, ok ? "silent while paused, resumes in place" : "paused voice advanced or was audible");
+}
+
+static bool runNullOutputCase() {
+    AudioMixer mixer(4, OUTPUT_RATE);
+    mixer.play(makeConstant(2, 10000, 1234), VoiceParams());
+    NullAudioOutput output(false);
+    output.open(OUTPUT_RATE, 256);
+    std::vector<int16_t> period(256 * 2);
+    for (int i = 0; i < 100; ++i) {
+        mixer.mix(period.data(), 256);
+        output.write(period.data());
+    }
+    bool ok = output.getFramesWritten() == 25600 && output.getPeakSample() == 1234 && mixer.getActiveVoiceCount() == 0;
+    char detail[96];
+    snprintf(detail, sizeof(detail), "%llu frames, peak %d", (unsigned long long)output.getFramesWritten(),
+             output.getPeakSample());
+    return report("null output", ok, detail);
+}
+
+static bool writeWav(const std::string& path, const AudioClip& clip) {
+    std::ofstream file(path, std::ios::binary);
+    uint32_t dataBytes = static_cast<uint32_t>(clip.samples.size() * sizeof(int16_t));
+    uint32_t riffSize = 36 + dataBytes;
+    uint32_t fmtSize = 16;
+    uint16_t format = 1;
+    uint16_t channels = static_cast<uint16_t>(clip.channels);
+    uint32_t rate = static_cast<uint32_t>(clip.sampleRate);
+    uint32_t byteRate = rate * channels * 2;
+    uint16_t blockAlign = static_cast<uint16_t>(channels * 2);
+    uint16_t bits = 16;
+    file.write("RIFF", 4);
+    file.write(reinterpret_cast<const char*>(&riffSize), 4);
+    file.write("WAVEfmt ", 8);
+    file.write(reinterpret_cast<const char*>(&fmtSize), 4);
+    file.write(reinterpret_cast<const char*>(&format), 2);
+    file.write(reinterpret_cast<const char*>(&channels), 2);
+    file.write(reinterpret_cast<const char*>(&rate), 4);
+    file.write(reinterpret_cast<const char*>(&byteRate), 4);
+    file.write(reinterpret_cast<const char*>(&blockAlign), 2);
+    file.write(reinterpret_cast<const char*>(&bits), 2);
+    file.write("data", 4);
+    file.write(reinterpret_cast<const char*>(&dataBytes), 4);
+    file.write(reinterpret_cast<const char*>(clip.samples.data()), dataBytes);
+    return static_cast<bool>(file);
+}
+
+// The clip streamed from disk through the ring must mix bit-identically to
+// the clip held in memory, across ring wraps, loops and a restart
+static bool runStreamCase(const char* name, const std::shared_ptr<AudioClip>& clip, float pitch, bool loop, int frames) {
+    const std::string path = "audio_mixer_test_stream.wav";
+    std::unique_ptr<AudioDecoder> decoder;
+    if (writeWav(path, *clip)) {
+        decoder = AudioDecoder::open(path);
+    }
+    if (!decoder) {
+        remove(path.c_str());
+        return report(name, false, "could not write and reopen the WAV");
+    }
+    std::shared_ptr<AudioStream> stream = std::make_shared<AudioStream>(std::move(decoder));
+    stream->fill();
+
+    VoiceParams params;
+    params.pitch = pitch;
+    params.loop = loop;
+    params.volume = 0.9f;
+    AudioMixer streamMixer(4, OUTPUT_RATE);
+    AudioMixer clipMixer(4, OUTPUT_RATE);
+
+    // A short false start first, so the second playStream has to rewind
+    std::vector<int16_t> scratch(700 * 2);
+    streamMixer.playStream(stream, params);
+    streamMixer.updateStreams();
+    streamMixer.mix(scratch.data(), 700);
+    VoiceId streamVoice = streamMixer.playStream(stream, params);
+    VoiceId clipVoice = clipMixer.play(clip, params);
+
+    std::vector<int16_t> streamed(frames * AudioMixer::OUTPUT_CHANNELS);
+    std::vector<int16_t> reference(frames * AudioMixer::OUTPUT_CHANNELS);
+    const int periods[3] = { 256, 77, 1500 };
+    int done = 0;
+    for (int p = 0; done < frames; ++p) {
+        int count = std::min(periods[p % 3], frames - done);
+        streamMixer.updateStreams();
+        streamMixer.mix(streamed.data() + done * AudioMixer::OUTPUT_CHANNELS, count);
+        clipMixer.mix(reference.data() + done * AudioMixer::OUTPUT_CHANNELS, count);
+        done += count;
+    }
+    remove(path.c_str());
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < streamed.size(); ++i) {
+        if (streamed[i] != reference[i]) mismatches++;
+    }
+    bool stateOk = streamMixer.isPlaying(streamVoice) == clipMixer.isPlaying(clipVoice);
+    uint32_t underruns = streamMixer.getStats().streamUnderruns;
+    char detail[128];
+    snprintf(detail, sizeof(detail), "%zu mismatched samples, %u underruns%s", mismatches, underruns,
+             stateOk ? "" : ", wrong voice state");
+    return report(name, mismatches == 0 && underruns == 0 && stateOk, detail);
+}
+
+// Loading a path twice shares one clip; a long file streams instead of caching
+static bool runCacheCase(std::mt19937& rng) {
+    const std::string shortPath = "audio_mixer_test_short.wav";
+    const std::string longPath = "audio_mixer_test_long.wav";
+    AudioManager& audioManager = AudioManager::getInstance();
+    bool written = writeWav(shortPath, *makeNoise(1, 22050, 11025, 8000, rng)) &&
+                   writeWav(longPath, *makeNoise(2, 44100, 300000, 8000, rng));
+
+    std::shared_ptr<const AudioClip> first, second, longClip;
+    std::shared_ptr<AudioStream> firstStream, secondStream, longStream;
+    bool loaded = written && audioManager.loadSound(shortPath, first, firstStream) &&
+                  audioManager.loadSound(shortPath, second, secondStream) &&
+                  audioManager.loadSound(longPath, longClip, longStream);
+    remove(shortPath.c_str());
+    remove(longPath.c_str());
+
+    bool shared = loaded && first && first == second && !firstStream && !secondStream;
+    bool streamed = loaded && !longClip && longStream && !audioManager.hasClip(longPath);
+    size_t cachedCount = audioManager.getCachedClipCount();
+    size_t cachedBytes = audioManager.getCachedClipBytes();
+    first.reset();
+    second.reset();
+    bool released = !audioManager.hasClip(shortPath) && audioManager.getCachedClipCount() == 0;
+
+    bool ok = shared && streamed && cachedCount == 1 && cachedBytes == 11025 * 2 && released;
+    char detail[128];
+    snprintf(detail, sizeof(detail), "%zu clip, %zu bytes cached; long file %s", cachedCount, cachedBytes,
+             streamed ? "streams" : "did not stream");
+    return report("clip cache", ok, detail);
+}
+
+static VoiceId playSpatial(AudioMixer& mixer, const std::shared_ptr<AudioClip>& clip, const glm::vec3& position,
+                          const glm::vec3& velocity) {
+    VoiceParams params;
+    params.spatial = true;
+    params.minDistance = 1.0f;
+    params.maxDistance = 50.0f;
+    params.position = position;
+    params.velocity = velocity;
+    return mixer.play(clip, params);
+}
+
+static void moveEmitter(AudioMixer& mixer, VoiceId voice, const glm::vec3& position) {
+    VoiceEmitter emitter;
+    emitter.voice = voice;
+    emitter.position = position;
+    emitter.velocity = glm::vec3(0.0f);
+    mixer.updateSpatial(AudioListener(), &emitter, 1);
+}
+
+// Default listener at the origin facing -Z, so +X is to its right
+static bool runSpatialCase() {
+    AudioMixer mixer(4, OUTPUT_RATE);
+    std::shared_ptr<AudioClip> clip = makeConstant(1, 48000, 10000);
+    std::vector<int16_t> period(256 * 2);
+
+    // 5 m to the right: 1 / (1 + (5 - 1)) = 0.2, all in the right channel
+    VoiceId voice = playSpatial(mixer, clip, glm::vec3(5.0f, 0.0f, 0.0f), glm::vec3(0.0f));
+    mixer.mix(period.data(), 256);
+    bool right = period[0] == 0 && period[1] == 2000;
+
+    // 2 m straight ahead: 0.5 in both channels
+    moveEmitter(mixer, voice, glm::vec3(0.0f, 0.0f, -2.0f));
+    mixer.mix(period.data(), 256);
+    bool ahead = period[0] == 5000 && period[1] == 5000;
+
+    // Past maxDistance: silent and virtual, but still playing
+    moveEmitter(mixer, voice, glm::vec3(-60.0f, 0.0f, 0.0f));
+    mixer.mix(period.data(), 256);
+    bool outOfRange = period[0] == 0 && period[1] == 0 && mixer.isVirtual(voice) && mixer.isPlaying(voice);
+
+    // Closing at a tenth of the speed of sound raises the pitch by 1/0.9,
+    // so a 4800 frame clip ends after about 4320 output frames
+    AudioMixer dopplerMixer(4, OUTPUT_RATE);
+    std::vector<int16_t> tail(4400 * 2);
+    VoiceId approaching = playSpatial(dopplerMixer, makeConstant(1, 4800, 1000), glm::vec3(0.0f, 0.0f, -10.0f),
+                                      glm::vec3(0.0f, 0.0f, 34.33f));
+    dopplerMixer.mix(tail.data(), 4400);
+    bool doppler = !dopplerMixer.isPlaying(approaching) && tail[4200 * 2] != 0 && tail[4399 * 2] == 0;
+
+    bool ok = right && ahead && outOfRange && doppler;
+    char detail[128];
+    snprintf(detail, sizeof(detail), "pan %s, distance %s, virtual %s, doppler %s", right ? "ok" : "wrong",
+             ahead ? "ok" : "wrong", outOfRange ? "ok" : "wrong", doppler ? "ok" : "wrong");
+    return report("3D voices", ok, detail);
+}
+
+// Only the loudest voices are mixed, and a virtual voice keeps its place in the clip
+static bool runVirtualVoiceCase(std::mt19937& rng) {
+    AudioMixer mixer(8, OUTPUT_RATE, 2);
+    std::shared_ptr<AudioClip> constant = makeConstant(2, 48000, 10000);
+    VoiceId quiet = INVALID_VOICE;
+    for (int i = 1; i <= 4; ++i) {
+        VoiceParams params;
+        params.volume = 0.1f * i;
+        VoiceId voice = mixer.play(constant, params);
+        if (i == 1) quiet = voice;
+    }
+    std::vector<int16_t> period(256 * 2);
+    mixer.mix(period.data(), 256);
+    bool loudestMixed = period[0] == 7000 && mixer.isVirtual(quiet) && mixer.getStats().peakVirtualVoices == 2;
+
+    AudioMixer spatialMixer(4, OUTPUT_RATE);
+    std::shared_ptr<AudioClip> noise = makeNoise(1, OUTPUT_RATE, 4000, 12000, rng);
+    VoiceId voice = playSpatial(spatialMixer, noise, glm::vec3(0.0f, 0.0f, -100.0f), glm::vec3(0.0f));
+    std::vector<int16_t> silent(1000 * 2);
+    std::vector<int16_t> audible(500 * 2);
+    spatialMixer.mix(silent.data(), 1000);
+    moveEmitter(spatialMixer, voice, glm::vec3(0.0f, 0.0f, -0.5f));
+    spatialMixer.mix(audible.data(), 500);
+
+    std::vector<double> expected(audible.size());
+    for (int i = 0; i < 500; ++i) {
+        expected[i * 2] = expected[i * 2 + 1] = noise->samples[1000 + i];
+    }
+    bool silentWhileVirtual = *std::max_element(silent.begin(), silent.end()) == 0;
+    int error = maxError(audible, expected);
+
+    bool ok = loudestMixed && silentWhileVirtual && error == 0;
+    char detail[128];
+    snprintf(detail, sizeof(detail), "2 of 4 mixed%s, resumed with max error %d", loudestMixed ? "" : " (wrong voices)",
+             error);
+    return report("virtual voices", ok, detail);
+}
+
+// Mixes `voices` looping voices for `seconds` of output in 256 frame periods
+static double benchmark(int voices, double seconds, bool nativeRate, std::mt19937& rng) {
+    std::vector<std::shared_ptr<AudioClip>> clips;
+    clips.push_back(makeNoise(2, nativeRate ? OUTPUT_RATE : 44100, 48000, 4000, rng));
+    clips.push_back(makeNoise(1, nativeRate ? OUTPUT_RATE : 22050, 24000, 4000, rng));
+
+    AudioMixer mixer(voices, OUTPUT_RATE);
+    std::uniform_real_distribution<float> pitch(0.5f, 2.0f);
+    for (int i = 0; i < voices; ++i) {
+        VoiceParams params;
+        params.loop = true;
+        params.volume = 0.25f;
+        params.pitch = nativeRate ? 1.0f : pitch(rng);
+        mixer.play(clips[i % clips.size()], params);
+    }
+
+    NullAudioOutput output(false);
+    output.open(OUTPUT_RATE, 256);
+    std::vector<int16_t> period(256 * 2);
+    int periods = static_cast<int>(seconds * OUTPUT_RATE / 256);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < periods; ++i) {
+        mixer.mix(period.data(), 256);
+        output.write(period.data());
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - begin).count() / std::max(1, periods);
+}
+
+int main(int argc, char** argv) {
+    int voices = 32;
+    double seconds = 10.0;
+    unsigned int seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--voices" && hasValue) {
+            voices = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seconds" && hasValue) {
+            seconds = std::max(0.1, std::atof(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<unsigned int>(std::atoi(argv[++i]));
+        } else {
+            std::cerr << "audio_mixer_test: Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::mt19937 rng(seed);
+    printf("Audio mixer test (%d Hz stereo out)\n", OUTPUT_RATE);
+    bool ok = true;
+    ok = runPlaybackCase("stereo native", makeNoise(2, OUTPUT_RATE, 5000, 20000, rng), 1.0f, 0.5f, false, 6000) && ok;
+    ok = runPlaybackCase("mono native", makeNoise(1, OUTPUT_RATE, 5000, 20000, rng), 1.0f, 0.8f, false, 4000) && ok;
+    ok = runPlaybackCase("stereo 44.1k", makeNoise(2, 44100, 5000, 20000, rng), 1.0f, 1.0f, false, 6000) && ok;
+    ok = runPlaybackCase("mono 22k pitch 1.37", makeNoise(1, 22050, 3000, 20000, rng), 1.37f, 0.7f, false, 6000) && ok;
+    ok = runPlaybackCase("stereo pitch 0.5 loop", makeNoise(2, OUTPUT_RATE, 333, 20000, rng), 0.5f, 1.0f, true, 5000) && ok;
+    ok = runPlaybackCase("mono native loop", makeNoise(1, OUTPUT_RATE, 101, 20000, rng), 1.0f, 1.0f, true, 5000) && ok;
+    ok = runPitchChangeCase(rng) && ok;
+    ok = runSaturationCase() && ok;
+    ok = runStealingCase() && ok;
+    ok = runPauseCase(rng) && ok;
+    ok = runNullOutputCase() && ok;
+    ok = runSpatialCase() && ok;
+    ok = runVirtualVoiceCase(rng) && ok;
+    ok = runStreamCase("stream stereo native", makeNoise(2, OUTPUT_RATE, 40000, 20000, rng), 1.0f, false, 45000) && ok;
+    ok = runStreamCase("stream mono 22k", makeNoise(1, 22050, 9000, 20000, rng), 1.0f, false, 25000) && ok;
+    ok = runStreamCase("stream loop pitch 1.37", makeNoise(2, 44100, 30001, 20000, rng), 1.37f, true, 120000) && ok;
+    ok = runStreamCase("stream native loop", makeNoise(1, OUTPUT_RATE, 5003, 20000, rng), 1.0f, true, 60000) && ok;
+    ok = runCacheCase(rng) && ok;
+
+    double periodBudget = 256.0 * 1000000.0 / OUTPUT_RATE;
+    double nativeUs = benchmark(voices, seconds, true, rng);
+    double resampledUs = benchmark(voices, seconds, false, rng);
+    printf("Mix cost, %d voices, 256 frame periods (budget %.0f us)\n", voices, periodBudget);
+    printf("  native rate, pitch 1   %8.2f us/period  %6.1fx realtime\n", nativeUs, periodBudget / nativeUs);
+    printf("  resampled, pitched     %8.2f us/period  %6.1fx realtime\n", resampledUs, periodBudget / resampledUs);
+
+    return ok ? 0 : 2;
+}
+
+#endif
@@ -0,0 +1,223 @@
+#ifdef LINUX_BUILD
+
+// Headless check of the clustered light assignment (no window, no GL context).
+// Scatters random point/spot lights in front of a camera, builds the froxel
+// grid and compares every cluster's light list against a brute-force
+// sphere/cluster-box test, then checks that per-object light gathering finds
+// every light touching objects inside the frustum. Prints build timings.
+//
+// Usage:
+//   light_cluster_test [--lights N] [--objects N] [--iterations N]
+//                      [--threads N] [--seed N] [--ortho]
+
+#include "../game_engine/include/Rendering/LightClusters.h"
+#include "LinearMath/btThreads.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace GameEngine;
+
+struct TestCamera {
+    glm::mat4 view;
+    glm::mat4 projection;
+    float nearPlane;
+    float farPlane;
+};
+
+static bool insideFrustum(const TestCamera& camera, const glm::vec3& worldPoint) {
+    glm::vec4 viewPoint = camera.view * glm::vec4(worldPoint, 1.0f);
+    float depth = -viewPoint.z;
+    if (depth < camera.nearPlane || depth > camera.farPlane) return false;
+    glm::vec4 clip = camera.projection * viewPoint;
+    if (clip.w <= 0.0f) return false;
+    glm::vec2 ndc = glm::vec2(clip) / clip.w;
+    return ndc.x >= -1.0f && ndc.x <= 1.0f && ndc.y >= -1.0f && ndc.y <= 1.0f;
+}
+
+// Every cluster must hold exactly the lights whose sphere touches its box
+static int checkClusters(const LightClusterGrid& grid, const std::vector<ClusterLight>& lights) {
+    int mismatches = 0;
+    std::vector<uint32_t> expected;
+    std::vector<uint32_t> actual;
+
+    for (size_t c = 0; c < grid.getClusterCount(); ++c) {
+        glm::vec3 boxMin, boxMax;
+        grid.getClusterBounds(c, boxMin, boxMax);
+
+        expected.clear();
+        for (size_t i = 0; i < lights.size(); ++i) {
+            if (lights[i].directional || lights[i].range <= 0.0f) continue;
+            uint32_t lightIndex = static_cast<uint32_t>(i);
+            if (LightClusterGrid::sphereIntersectsAABB(grid.getViewPosition(lightIndex), lights[i].range, boxMin, boxMax)) {
+                expected.push_back(lightIndex);
+            }
+        }
+
+        const LightCluster& cluster = grid.getCluster(c);
+        actual.assign(grid.getLightIndices().begin() + cluster.offset,
+                      grid.getLightIndices().begin() + cluster.offset + cluster.count);
+        std::sort(actual.begin(), actual.end());
+
+        if (actual != expected) {
+            if (mismatches < 5) {
+                printf("  cluster %zu: expected %zu lights, grid has %zu\n", c, expected.size(), actual.size());
+            }
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// Gathering for a box fully inside the frustum must not miss any light whose
+// sphere touches the box
+static int checkObjects(const LightClusterGrid& grid, const std::vector<ClusterLight>& lights,
+                        const TestCamera& camera, std::mt19937& rng, int objectCount, int& checkedObjects) {
+    std::uniform_real_distribution<float> coord(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> depth(2.0f, 60.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 3.0f);
+
+    int missing = 0;
+    checkedObjects = 0;
+    std::vector<uint32_t> gathered;
+    for (int attempt = 0; attempt < objectCount * 20 && checkedObjects < objectCount; ++attempt) {
+        glm::vec3 center(coord(rng), coord(rng) * 0.5f, -depth(rng));
+        glm::vec3 halfSize(extent(rng), extent(rng), extent(rng));
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), center);
+
+        bool inside = true;
+        for (int corner = 0; corner < 8 && inside; ++corner) {
+            glm::vec3 offset((corner & 1) ? halfSize.x : -halfSize.x,
+                             (corner & 2) ? halfSize.y : -halfSize.y,
+                             (corner & 4) ? halfSize.z : -halfSize.z);
+            inside = insideFrustum(camera, center + offset);
+        }
+        if (!inside) continue;
+        ++checkedObjects;
+
+        gathered.clear();
+        grid.gatherLights(-halfSize, halfSize, model, gathered);
+        std::sort(gathered.begin(), gathered.end());
+        if (std::adjacent_find(gathered.begin(), gathered.end()) != gathered.end()) {
+            printf("  object %d: duplicate light indices\n", checkedObjects);
+            ++missing;
+        }
+
+        for (size_t i = 0; i < lights.size(); ++i) {
+            if (lights[i].directional || lights[i].range <= 0.0f) continue;
+            if (!LightClusterGrid::sphereIntersectsAABB(lights[i].position, lights[i].range,
+                                                        center - halfSize, center + halfSize)) continue;
+            if (!std::binary_search(gathered.begin(), gathered.end(), static_cast<uint32_t>(i))) {
+                if (missing < 5) {
+                    printf("  object %d: light %zu touches the box but was not gathered\n", checkedObjects, i);
+                }
+                ++missing;
+            }
+        }
+    }
+    return missing;
+}
+
+int main(int argc, char** argv) {
+    int lightCount = 512;
+    int objectCount = 200;
+    int iterations = 100;
+    int threads = 0;
+    unsigned int seed = 1234;
+    bool orthographic = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--lights" && hasValue) {
+            lightCount = std::atoi(argv[++i]);
+        } else if (arg == "--objects" && hasValue) {
+            objectCount = std::atoi(argv[++i]);
+        } else if (arg == "--iterations" && hasValue) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<unsigned int>(std::atoi(argv[++i]));
+        } else if (arg == "--ortho") {
+            orthographic = true;
+        } else {
+            std::cerr << "light_cluster_test: Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    btSetTaskScheduler(btGetSequentialTaskScheduler());
+    if (threads > 1) {
+        btITaskScheduler* scheduler = btCreateDefaultTaskScheduler();
+        if (scheduler) {
+            scheduler->setNumThreads(threads);
+            btSetTaskScheduler(scheduler);
+        } else {
+            printf("light_cluster_test: Bullet built without BT_THREADSAFE, running serially\n");
+        }
+    }
+
+    TestCamera camera;
+    camera.nearPlane = 0.1f;
+    camera.farPlane = 100.0f;
+    camera.view = glm::lookAt(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    if (orthographic) {
+        camera.projection = glm::ortho(-30.0f, 30.0f, -17.0f, 17.0f, camera.nearPlane, camera.farPlane);
+    } else {
+        camera.projection = glm::perspective(glm::radians(60.0f), 960.0f / 544.0f, camera.nearPlane, camera.farPlane);
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> spread(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> depth(-10.0f, 110.0f);
+    std::uniform_real_distribution<float> radius(0.5f, 12.0f);
+
+    std::vector<ClusterLight> lights;
+    lights.reserve(lightCount + 2);
+    lights.push_back(ClusterLight(glm::vec3(0.0f), 1000.0f, true));
+    for (int i = 0; i < lightCount; ++i) {
+        lights.push_back(ClusterLight(glm::vec3(spread(rng), spread(rng) * 0.5f, -depth(rng)), radius(rng), false));
+    }
+
+    LightClusterGrid grid;
+    double totalMs = 0.0;
+    double worstMs = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+        grid.build(camera.view, camera.projection, camera.nearPlane, camera.farPlane, lights);
+        totalMs += grid.getLastBuildStats().buildMs;
+        worstMs = std::max(worstMs, grid.getLastBuildStats().buildMs);
+    }
+
+    int clusterMismatches = checkClusters(grid, lights);
+    int checkedObjects = 0;
+    int missingLights = checkObjects(grid, lights, camera, rng, objectCount, checkedObjects);
+    bool globalOk = (grid.getGlobalLights().size() == 1 && grid.getGlobalLights()[0] == 0);
+
+    const LightClusterGrid::Stats& stats = grid.getLastBuildStats();
+    btITaskScheduler* activeScheduler = btGetTaskScheduler();
+    printf("Light cluster test (%s, %dx%dx%d clusters, %d thread(s))\n",
+           orthographic ? "orthographic" : "perspective",
+           grid.getTilesX(), grid.getTilesY(), grid.getSlices(),
+           activeScheduler ? activeScheduler->getNumThreads() : 1);
+    printf("  lights:      %zu (%zu in depth range, %zu global)\n",
+           lights.size(), grid.getVisibleLights().size(), grid.getGlobalLights().size());
+    printf("  build:       %.3f ms avg, %.3f ms worst over %d iterations\n",
+           totalMs / iterations, worstMs, iterations);
+    printf("  assignments: %zu, %.2f avg / %u max lights per cluster\n",
+           stats.assignments, static_cast<double>(stats.assignments) / grid.getClusterCount(),
+           stats.maxLightsPerCluster);
+    printf("  clusters:    %s (%d mismatches)\n", clusterMismatches == 0 ? "OK" : "FAILED", clusterMismatches);
+    printf("  objects:     %s (%d checked, %d missed lights)\n", missingLights == 0 ? "OK" : "FAILED",
+           checkedObjects, missingLights);
+    printf("  global:      %s\n", globalOk ? "OK" : "FAILED");
+
+    return (clusterMismatches == 0 && missingLights == 0 && globalOk) ? 0 : 2;
+}
+
+#endif
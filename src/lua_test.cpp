@@ -8,6 +8,13 @@
 #include "Components/LightComponent.h"
 #include "Components/PhysicsComponent.h"
 #include "Rendering/TextureManager.h"
+#include "Rendering/RenderDevice.h"
+#include "Core/MenuManager.h"
+#include "Core/ScriptManager.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 
 using namespace GameEngine;
@@ -191,7 +198,321 @@ private:
     }
 };
 
-int main() {
+// Headless checks run the engine on the null render backend, without a window
+static bool initializeHeadless(Engine& engine) {
+    RenderDevice::setBackend(RenderBackend::NULL_DEVICE);
+    if (!engine.initialize(EngineMode::GAME)) {
+        std::cerr << "Failed to initialize engine!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// A node under the scene root running one script; nullptr if it fails to load
+static ScriptComponent* addScriptNode(Scene& scene, const std::string& name, const std::string& scriptPath,
+                                      std::shared_ptr<SceneNode>& node) {
+    node = scene.createNode(name);
+    scene.getRootNode()->addChild(node);
+    auto script = node->addComponent<ScriptComponent>();
+    return script->loadScript(scriptPath) ? script : nullptr;
+}
+
+static int reportCheck(Engine& engine, bool passed) {
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    engine.shutdown();
+    return passed ? 0 : 1;
+}
+
+// Headless: a component script registers a menu action and a show callback
+// by the names of its own functions, then both are fired from C++ and must
+// run in that script (they move its node)
+static int runMenuCheck() {
+    Engine engine;
+    if (!initializeHeadless(engine)) {
+        return -1;
+    }
+    
+    auto scene = engine.getSceneManager().createScene("Menu Check");
+    std::shared_ptr<SceneNode> node;
+    bool loaded = addScriptNode(*scene, "Menu Owner", "scripts/tests/menu_action_check.lua", node) != nullptr;
+    engine.getSceneManager().loadScene(scene);
+    
+    // start() creates and shows the menu, which fires onShown
+    engine.runFrame();
+    glm::vec3 shown = node->getTransform().getPosition();
+    
+    MenuManager::getInstance().activateSelectedItem("menu_check");
+    glm::vec3 confirmed = node->getTransform().getPosition();
+    
+    bool passed = loaded
+        && shown == glm::vec3(1.0f, 0.0f, 0.0f)
+        && confirmed == glm::vec3(1.0f, 2.0f, 0.0f);
+    std::cout << "menu callback: " << (shown.x == 1.0f ? "ok" : "not called") << std::endl;
+    std::cout << "menu action:   " << (confirmed.y == 2.0f ? "ok" : "not called") << std::endl;
+    return reportCheck(engine, passed);
+}
+
+// Headless: a script outruns a tiny GC step budget; the engine must still
+// step the collector every frame and force full collections at the limit
+static int runGCCheck() {
+    Engine engine;
+    if (!initializeHeadless(engine)) {
+        return -1;
+    }
+    
+    auto scene = engine.getSceneManager().createScene("GC Check");
+    std::shared_ptr<SceneNode> node;
+    bool loaded = addScriptNode(*scene, "Garbage Maker", "scripts/tests/gc_check.lua", node) != nullptr;
+    engine.getSceneManager().loadScene(scene);
+    engine.runFrame();
+    
+    ScriptManager& scripts = ScriptManager::getInstance();
+    lua_State* L = scripts.getComponentLuaState();
+    int limit = lua_gc(L, LUA_GCCOUNT, 0) + 1024;
+    scripts.setScriptGCBudget(0.001);
+    scripts.setScriptMemoryLimit(limit);
+    
+    int peak = 0;
+    for (int frame = 0; frame < 60; ++frame) {
+        engine.runFrame();
+        peak = std::max(peak, lua_gc(L, LUA_GCCOUNT, 0));
+    }
+    
+    bool stepped = scripts.getLastGCStepMs() > 0.0;
+    bool collected = scripts.getFullCollectionCount() > 0;
+    // At most one frame of garbage on top of the limit
+    bool bounded = peak < limit + 1024;
+    std::cout << "gc stepped per frame: " << (stepped ? "ok" : "no") << std::endl;
+    std::cout << "full collections:     " << scripts.getFullCollectionCount() << std::endl;
+    std::cout << "peak heap:            " << peak << " KB (limit " << limit << " KB)" << std::endl;
+    return reportCheck(engine, loaded && stepped && collected && bounded);
+}
+
+// Headless: two scripts each put their own node in a zone of the same name;
+// neither may see the other's object there
+static int runPickupCheck() {
+    Engine engine;
+    if (!initializeHeadless(engine)) {
+        return -1;
+    }
+    
+    auto scene = engine.getSceneManager().createScene("Pickup Check");
+    std::shared_ptr<SceneNode> first;
+    std::shared_ptr<SceneNode> second;
+    bool loaded = addScriptNode(*scene, "Zone Owner A", "scripts/tests/pickup_zone_check.lua", first) != nullptr
+        && addScriptNode(*scene, "Zone Owner B", "scripts/tests/pickup_zone_check.lua", second) != nullptr;
+    engine.getSceneManager().loadScene(scene);
+    engine.runFrame();
+    
+    bool firstOk = first->getTransform().getPosition().x == 1.0f;
+    bool secondOk = second->getTransform().getPosition().x == 1.0f;
+    std::cout << "zones of script A: " << (firstOk ? "ok" : "shared") << std::endl;
+    std::cout << "zones of script B: " << (secondOk ? "ok" : "shared") << std::endl;
+    return reportCheck(engine, loaded && firstOk && secondOk);
+}
+
+static bool writeScript(const char* path, const char* source) {
+    std::ofstream file(path);
+    file << source;
+    return file.good();
+}
+
+// Headless: after a script file changes, reloadScript() must call the new
+// version's callbacks, not the refs resolved from the old one
+static int runReloadCheck() {
+    Engine engine;
+    if (!initializeHeadless(engine)) {
+        return -1;
+    }
+    
+    const char* path = "scripts/tests/reload_check.tmp.lua";
+    bool written = writeScript(path, "function start() end\nfunction update(dt) setPosition(1, 0, 0) end\n");
+    
+    auto scene = engine.getSceneManager().createScene("Reload Check");
+    std::shared_ptr<SceneNode> node;
+    ScriptComponent* script = addScriptNode(*scene, "Reloaded", path, node);
+    engine.getSceneManager().loadScene(scene);
+    engine.runFrame();
+    bool firstVersion = node->getTransform().getPosition().x == 1.0f;
+    
+    written = written && writeScript(path, "function start() end\nfunction update(dt) setPosition(2, 0, 0) end\n");
+    if (script) {
+        script->reloadScript();
+        script->start();
+    }
+    engine.runFrame();
+    bool secondVersion = node->getTransform().getPosition().x == 2.0f;
+    std::remove(path);
+    
+    std::cout << "update before reload: " << (firstVersion ? "ok" : "not run") << std::endl;
+    std::cout << "update after reload:  " << (secondVersion ? "ok" : "old version") << std::endl;
+    return reportCheck(engine, written && script && firstVersion && secondVersion);
+}
+
+static std::shared_ptr<SceneNode> dispatchVictim;
+
+// Registered for dispatch_check.lua: drops the victim node, and with it its
+// script component, from inside another script's update
+static int removeVictim(lua_State* L) {
+    (void)L;
+    if (dispatchVictim && dispatchVictim->getParent()) {
+        dispatchVictim->getParent()->removeChild(dispatchVictim);
+    }
+    dispatchVictim.reset();
+    return 0;
+}
+
+// Headless: a script component destroyed while the script list is being
+// dispatched must not disturb the scripts after it; the list is compacted
+// once the loop ends
+static int runDispatchCheck() {
+    Engine engine;
+    if (!initializeHeadless(engine)) {
+        return -1;
+    }
+    
+    ScriptManager& scripts = ScriptManager::getInstance();
+    lua_register(scripts.getComponentLuaState(), "removeVictim", removeVictim);
+    
+    auto scene = engine.getSceneManager().createScene("Dispatch Check");
+    std::shared_ptr<SceneNode> remover;
+    std::shared_ptr<SceneNode> survivor;
+    size_t before = scripts.getScriptComponentCount();
+    // The victim sits ahead of the remover, so erasing it mid-loop would
+    // shift the survivor into the slot just dispatched and skip it
+    bool loaded = addScriptNode(*scene, "Victim", "scripts/tests/dispatch_check.lua", dispatchVictim) != nullptr
+        && addScriptNode(*scene, "Remover", "scripts/tests/dispatch_check.lua", remover) != nullptr
+        && addScriptNode(*scene, "Survivor", "scripts/tests/dispatch_check.lua", survivor) != nullptr;
+    engine.getSceneManager().loadScene(scene);
+    engine.runFrame();
+    engine.runFrame();
+    
+    bool removed = !dispatchVictim && !scene->findNode("Victim");
+    bool compacted = scripts.getScriptComponentCount() == before + 2;
+    bool othersRan = remover->getTransform().getPosition().x == 2.0f
+        && survivor->getTransform().getPosition().x == 2.0f;
+    std::cout << "victim removed:      " << (removed ? "ok" : "no") << std::endl;
+    std::cout << "script list compact: " << (compacted ? "ok" : "no") << std::endl;
+    std::cout << "other scripts ran:   " << (othersRan ? "ok" : "no") << std::endl;
+    return reportCheck(engine, loaded && removed && compacted && othersRan);
+}
+
+// Headless: the vec3 / quat / mat4 metamethods and the out-argument form of
+// the vector getters, checked from a script
+static int runMathCheck() {
+    Engine engine;
+    if (!initializeHeadless(engine)) {
+        return -1;
+    }
+    
+    auto scene = engine.getSceneManager().createScene("Math Check");
+    std::shared_ptr<SceneNode> node;
+    bool loaded = addScriptNode(*scene, "Math Checker", "scripts/tests/math_check.lua", node) != nullptr;
+    engine.getSceneManager().loadScene(scene);
+    engine.runFrame();
+    
+    glm::vec3 result = node->getTransform().getPosition();
+    bool finished = result.z == 1.0f;
+    std::cout << "math checks passed: " << result.x << std::endl;
+    std::cout << "math checks failed: " << result.y << std::endl;
+    std::cout << "script finished:    " << (finished ? "ok" : "no") << std::endl;
+    return reportCheck(engine, loaded && finished && result.x > 0.0f && result.y == 0.0f);
+}
+
+// Headless: a handle held by a script goes stale once its node is destroyed
+// and the slot reused, and the scene's name index follows renames,
+// reparenting and removal
+static int runHierarchyCheck() {
+    Engine engine;
+    if (!initializeHeadless(engine)) {
+        return -1;
+    }
+    
+    auto scene = engine.getSceneManager().createScene("Hierarchy Check");
+    auto root = scene->getRootNode();
+    auto target = scene->createNode("Target");
+    root->addChild(target);
+    std::shared_ptr<SceneNode> holder;
+    ScriptComponent* script = addScriptNode(*scene, "Handle Holder", "scripts/tests/node_handle_check.lua", holder);
+    engine.getSceneManager().loadScene(scene);
+    bool loaded = script != nullptr;
+    
+    // Stale handles: destroy the node, then take its slot with a new one
+    if (loaded) {
+        script->callScriptFunction("checkLive");
+    }
+    bool live = holder->getTransform().getPosition() == glm::vec3(1.0f, 0.0f, 0.0f);
+    
+    NodeHandle oldHandle = target->getHandle();
+    root->removeChild(target);
+    target.reset();
+    auto reuse = scene->createNode("Reuse");
+    root->addChild(reuse);
+    bool reused = reuse->getHandle().index == oldHandle.index && reuse->getHandle() != oldHandle;
+    bool staleInCpp = SceneNode::resolve(oldHandle) == nullptr && SceneNode::resolve(reuse->getHandle()) == reuse.get();
+    
+    if (loaded) {
+        script->callScriptFunction("checkStale");
+    }
+    bool staleInLua = holder->getTransform().getPosition() == glm::vec3(1.0f, 2.0f, 0.0f)
+        && reuse->getTransform().getPosition() == glm::vec3(0.0f);
+    
+    // Name index: root -> A -> Leaf, root -> B, and a Limbo node outside the scene
+    auto a = scene->createNode("A");
+    auto b = scene->createNode("B");
+    auto leaf = scene->createNode("Leaf");
+    auto limbo = std::make_shared<SceneNode>("Limbo");
+    root->addChild(a);
+    root->addChild(b);
+    a->addChild(leaf);
+    bool found = scene->findNode("Leaf") == leaf;
+    
+    leaf->setName("Renamed");
+    bool renamed = !scene->findNode("Leaf") && scene->findNode("Renamed") == leaf;
+    
+    limbo->addChild(leaf);
+    bool leftScene = !scene->findNode("Renamed");
+    b->addChild(leaf);
+    bool reparented = scene->findNode("Renamed") == leaf && leaf->getParent() == b.get();
+    
+    root->removeChild(b);
+    bool removed = !scene->findNode("B") && !scene->findNode("Renamed") && scene->findNodeHandle("Renamed").isNull();
+    
+    std::cout << "handle before destroy:  " << (live ? "ok" : "not resolved") << std::endl;
+    std::cout << "slot reused:            " << (reused ? "ok" : "no") << std::endl;
+    std::cout << "stale handle (C++):     " << (staleInCpp ? "ok" : "resolves") << std::endl;
+    std::cout << "stale handle (Lua):     " << (staleInLua ? "ok" : "resolves") << std::endl;
+    std::cout << "name index after build: " << (found ? "ok" : "missing") << std::endl;
+    std::cout << "after rename:           " << (renamed ? "ok" : "stale") << std::endl;
+    std::cout << "after reparent:         " << (leftScene && reparented ? "ok" : "stale") << std::endl;
+    std::cout << "after remove:           " << (removed ? "ok" : "stale") << std::endl;
+    return reportCheck(engine, loaded && live && reused && staleInCpp && staleInLua
+                       && found && renamed && leftScene && reparented && removed);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--menu-check") == 0) {
+        return runMenuCheck();
+    }
+    if (argc > 1 && strcmp(argv[1], "--gc-check") == 0) {
+        return runGCCheck();
+    }
+    if (argc > 1 && strcmp(argv[1], "--pickup-check") == 0) {
+        return runPickupCheck();
+    }
+    if (argc > 1 && strcmp(argv[1], "--reload-check") == 0) {
+        return runReloadCheck();
+    }
+    if (argc > 1 && strcmp(argv[1], "--dispatch-check") == 0) {
+        return runDispatchCheck();
+    }
+    if (argc > 1 && strcmp(argv[1], "--math-check") == 0) {
+        return runMathCheck();
+    }
+    if (argc > 1 && strcmp(argv[1], "--hierarchy-check") == 0) {
+        return runHierarchyCheck();
+    }
+    
     std::cout << "Starting Lua Scripting Test..." << std::endl;
     
     LuaTestApp app;
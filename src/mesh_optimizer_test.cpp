@@ -0,0 +1,277 @@
+#ifdef LINUX_BUILD
+
+// Headless check of the mesh optimization pipeline (no window, no GL context).
+// Builds a grid and a UV sphere, scrambles their triangle order and splits
+// them into triangle soups, runs MeshOptimizer and verifies that the same
+// triangles (with the same winding) come out, that duplicate vertices were
+// merged, that vertices are in first-use order and that ACMR did not get
+// worse. Prints ACMR/ATVR before and after and the optimization time.
+// Then simplifies both meshes to 50/25/12.5% of their triangles and checks
+// that the result is smaller, within the error limit and (for the sphere)
+// has no triangles flipped inward.
+//
+// Usage:
+//   mesh_optimizer_test [--size N] [--cache N] [--seed N]
+
+#include "../game_engine/include/Rendering/Mesh.h"
+#include "../game_engine/include/Rendering/MeshOptimizer.h"
+#include "../game_engine/include/Rendering/MeshSimplifier.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace GameEngine;
+
+struct TestMesh {
+    std::string name;
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    size_t uniqueVertices;
+};
+
+static TestMesh makeGrid(int size) {
+    TestMesh mesh;
+    mesh.name = "grid";
+    for (int y = 0; y <= size; ++y) {
+        for (int x = 0; x <= size; ++x) {
+            float u = static_cast<float>(x) / size;
+            float v = static_cast<float>(y) / size;
+            mesh.vertices.push_back(Vertex(glm::vec3(u - 0.5f, 0.0f, v - 0.5f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(u, v)));
+        }
+    }
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            unsigned int i0 = y * (size + 1) + x;
+            unsigned int i1 = i0 + 1;
+            unsigned int i2 = i0 + (size + 1);
+            unsigned int i3 = i2 + 1;
+            unsigned int quad[6] = { i0, i1, i2, i1, i3, i2 };
+            mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+        }
+    }
+    mesh.uniqueVertices = mesh.vertices.size();
+    return mesh;
+}
+
+static TestMesh makeSphere(int segments, int rings) {
+    TestMesh mesh;
+    mesh.name = "sphere";
+    for (int y = 0; y <= rings; ++y) {
+        float v = static_cast<float>(y) / rings;
+        float phi = v * glm::pi<float>();
+        // Exact zero at the poles so their vertices share one position
+        float ringRadius = (y == 0 || y == rings) ? 0.0f : std::sin(phi);
+        for (int x = 0; x <= segments; ++x) {
+            float u = static_cast<float>(x) / segments;
+            float theta = u * glm::two_pi<float>();
+            glm::vec3 normal(ringRadius * std::cos(theta), std::cos(phi), ringRadius * std::sin(theta));
+            mesh.vertices.push_back(Vertex(normal * 0.5f, normal, glm::vec2(u, v)));
+        }
+    }
+    for (int y = 0; y < rings; ++y) {
+        for (int x = 0; x < segments; ++x) {
+            unsigned int i0 = y * (segments + 1) + x;
+            unsigned int i1 = i0 + 1;
+            unsigned int i2 = i0 + (segments + 1);
+            unsigned int i3 = i2 + 1;
+            unsigned int quad[6] = { i0, i1, i2, i1, i3, i2 };
+            mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+        }
+    }
+    mesh.uniqueVertices = mesh.vertices.size();
+    return mesh;
+}
+
+// Shuffles triangles and rotates each one's corners (keeping the winding)
+static void scramble(TestMesh& mesh, std::mt19937& rng) {
+    size_t triangleCount = mesh.indices.size() / 3;
+    std::vector<size_t> order(triangleCount);
+    for (size_t i = 0; i < triangleCount; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    std::vector<unsigned int> shuffled;
+    shuffled.reserve(mesh.indices.size());
+    std::uniform_int_distribution<int> rotation(0, 2);
+    for (size_t i = 0; i < triangleCount; ++i) {
+        int r = rotation(rng);
+        for (int c = 0; c < 3; ++c) {
+            shuffled.push_back(mesh.indices[order[i] * 3 + (c + r) % 3]);
+        }
+    }
+    mesh.indices.swap(shuffled);
+}
+
+// Unindexed copy: every triangle gets its own three vertices
+static TestMesh toSoup(const TestMesh& mesh) {
+    TestMesh soup;
+    soup.name = mesh.name + " soup";
+    soup.uniqueVertices = mesh.uniqueVertices;
+    for (size_t i = 0; i < mesh.indices.size(); ++i) {
+        soup.vertices.push_back(mesh.vertices[mesh.indices[i]]);
+    }
+    return soup;
+}
+
+typedef std::array<unsigned int, 3> TriangleKey;
+
+// Triangles as vertex-content ids, rotated so the smallest id comes first
+static std::vector<TriangleKey> triangleKeys(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+                                             std::map<std::string, unsigned int>& contentIds) {
+    std::vector<unsigned int> resolved;
+    if (indices.empty()) {
+        for (size_t i = 0; i < vertices.size(); ++i) resolved.push_back(static_cast<unsigned int>(i));
+    } else {
+        resolved = indices;
+    }
+
+    std::vector<TriangleKey> keys;
+    for (size_t t = 0; t + 2 < resolved.size(); t += 3) {
+        TriangleKey key;
+        for (int c = 0; c < 3; ++c) {
+            const Vertex& vertex = vertices[resolved[t + c]];
+            std::string bytes(reinterpret_cast<const char*>(&vertex), sizeof(Vertex));
+            std::map<std::string, unsigned int>::iterator it = contentIds.find(bytes);
+            if (it == contentIds.end()) {
+                it = contentIds.insert(std::make_pair(bytes, static_cast<unsigned int>(contentIds.size()))).first;
+            }
+            key[c] = it->second;
+        }
+        if (key[0] == key[1] || key[1] == key[2] || key[0] == key[2]) continue;
+        while (key[0] > key[1] || key[0] > key[2]) {
+            std::rotate(key.begin(), key.begin() + 1, key.end());
+        }
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+static bool runCase(TestMesh mesh, unsigned int cacheSize) {
+    std::map<std::string, unsigned int> contentIds;
+    std::vector<TriangleKey> before = triangleKeys(mesh.vertices, mesh.indices, contentIds);
+
+    MeshOptimizer::Options options;
+    options.cacheSize = cacheSize;
+    MeshOptimizer::Stats stats = MeshOptimizer::optimize(mesh.vertices, mesh.indices, options);
+
+    std::vector<TriangleKey> after = triangleKeys(mesh.vertices, mesh.indices, contentIds);
+
+    bool trianglesOk = (before == after);
+    bool indicesOk = true;
+    bool fetchOrderOk = true;
+    unsigned int nextNew = 0;
+    for (size_t i = 0; i < mesh.indices.size(); ++i) {
+        unsigned int index = mesh.indices[i];
+        if (index >= mesh.vertices.size()) {
+            indicesOk = false;
+            break;
+        }
+        if (index == nextNew) {
+            ++nextNew;
+        } else if (index > nextNew) {
+            fetchOrderOk = false;
+        }
+    }
+    bool dedupOk = (mesh.vertices.size() == mesh.uniqueVertices);
+    bool acmrOk = (stats.acmrAfter <= stats.acmrBefore);
+    bool ok = trianglesOk && indicesOk && fetchOrderOk && dedupOk && acmrOk;
+
+    printf("  %-12s %7zu -> %6zu verts  %7zu tris  ACMR %.3f -> %.3f  ATVR %.3f -> %.3f  %s  %.2f ms  %s\n",
+           mesh.name.c_str(), stats.verticesBefore, stats.verticesAfter, stats.triangles,
+           stats.acmrBefore, stats.acmrAfter, stats.atvrBefore, stats.atvrAfter,
+           stats.fitsIn16Bit ? "16-bit" : "32-bit", stats.optimizeMs, ok ? "OK" : "FAILED");
+    if (!trianglesOk) printf("    triangle set changed (%zu before, %zu after)\n", before.size(), after.size());
+    if (!indicesOk) printf("    index out of range\n");
+    if (!fetchOrderOk) printf("    vertices not in first-use order\n");
+    if (!dedupOk) printf("    expected %zu unique vertices\n", mesh.uniqueVertices);
+    if (!acmrOk) printf("    ACMR got worse\n");
+    return ok;
+}
+
+static bool runSimplifyCase(const TestMesh& mesh, float ratio, float maxError, bool closedAroundOrigin) {
+    size_t targetIndexCount = static_cast<size_t>(mesh.indices.size() * ratio) / 3 * 3;
+    std::vector<unsigned int> result;
+    float error = MeshSimplifier::simplify(mesh.vertices, mesh.indices, targetIndexCount, maxError, result);
+
+    bool indicesOk = (result.size() % 3 == 0);
+    for (size_t i = 0; i < result.size() && indicesOk; ++i) {
+        indicesOk = (result[i] < mesh.vertices.size());
+    }
+    bool reducedOk = !result.empty() && result.size() < mesh.indices.size();
+    bool errorOk = (error <= maxError);
+
+    // Every sphere triangle must still face away from the center
+    size_t flipped = 0;
+    if (closedAroundOrigin && indicesOk) {
+        for (size_t t = 0; t + 2 < result.size(); t += 3) {
+            glm::vec3 p0 = mesh.vertices[result[t]].position;
+            glm::vec3 p1 = mesh.vertices[result[t + 1]].position;
+            glm::vec3 p2 = mesh.vertices[result[t + 2]].position;
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            if (glm::dot(normal, p0 + p1 + p2) <= 0.0f) ++flipped;
+        }
+    }
+    bool ok = indicesOk && reducedOk && errorOk && flipped == 0;
+
+    printf("  %-12s %5.1f%%  %7zu -> %6zu tris (target %zu)  error %.4f  %s\n",
+           mesh.name.c_str(), ratio * 100.0f, mesh.indices.size() / 3, result.size() / 3,
+           targetIndexCount / 3, error, ok ? "OK" : "FAILED");
+    if (!indicesOk) printf("    invalid index buffer\n");
+    if (!reducedOk) printf("    nothing was simplified\n");
+    if (!errorOk) printf("    error above limit %.4f\n", maxError);
+    if (flipped > 0) printf("    %zu triangles flipped\n", flipped);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    int size = 128;
+    unsigned int cacheSize = 16;
+    unsigned int seed = 1234;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--size" && hasValue) {
+            size = std::max(2, std::atoi(argv[++i]));
+        } else if (arg == "--cache" && hasValue) {
+            cacheSize = static_cast<unsigned int>(std::max(3, std::atoi(argv[++i])));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<unsigned int>(std::atoi(argv[++i]));
+        } else {
+            std::cerr << "mesh_optimizer_test: Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::mt19937 rng(seed);
+    TestMesh grid = makeGrid(size);
+    TestMesh sphere = makeSphere(size, size / 2);
+    scramble(grid, rng);
+    scramble(sphere, rng);
+
+    printf("Mesh optimizer test (FIFO cache %u)\n", cacheSize);
+    bool ok = true;
+    ok = runCase(grid, cacheSize) && ok;
+    ok = runCase(sphere, cacheSize) && ok;
+    ok = runCase(toSoup(grid), cacheSize) && ok;
+    ok = runCase(toSoup(sphere), cacheSize) && ok;
+
+    const float maxError = 0.05f;
+    printf("Mesh simplifier test (max error %.3f)\n", maxError);
+    const float ratios[3] = { 0.5f, 0.25f, 0.125f };
+    for (int r = 0; r < 3; ++r) {
+        ok = runSimplifyCase(grid, ratios[r], maxError, false) && ok;
+        ok = runSimplifyCase(sphere, ratios[r], maxError, true) && ok;
+    }
+
+    return ok ? 0 : 2;
+}
+
+#endif
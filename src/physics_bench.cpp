@@ -0,0 +1,421 @@
+#ifdef LINUX_BUILD
+
+// Headless physics harness: loads the physics part of a scene JSON (no window,
+// no GL context), steps PhysicsManager a fixed number of times and reports
+// per-step timings, body/contact counts and a state hash.
+//
+// Usage:
+//   physics_bench [scene.json] [--steps N] [--threads N] [--spawn N]
+//                 [--input track.txt] [--record trace.csv] [--verify trace.csv]
+//
+// Input track format (one command per line, '#' starts a comment):
+//   <step> <nodeName> impulse|velocity|position <x> <y> <z>
+
+#include "../game_engine/include/Physics/PhysicsManager.h"
+#include "../game_engine/include/Scene/Scene.h"
+#include "../game_engine/include/Scene/SceneNode.h"
+#include "../game_engine/include/Components/PhysicsComponent.h"
+#include "../vendor/json/single_include/nlohmann/json.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace GameEngine;
+using json = nlohmann::json;
+
+struct InputCommand {
+    int step;
+    std::string nodeName;
+    std::string action;
+    glm::vec3 value;
+};
+
+struct StepRecord {
+    int step;
+    double milliseconds;
+    int bodies;
+    int contacts;
+    uint64_t hash;
+};
+
+static void readVec3(const json& value, glm::vec3& out) {
+    if (value.is_array() && value.size() >= 3) {
+        out = glm::vec3(value[0].get<float>(), value[1].get<float>(), value[2].get<float>());
+    }
+}
+
+// Mirrors the transform and PhysicsComponent parts of SceneDescription::instantiate.
+// Render, audio and script components are skipped so no GL or Lua state is needed.
+static std::shared_ptr<SceneNode> buildPhysicsNode(const json& nodeJson,
+                                                   std::vector<PhysicsComponent*>& physicsComponents,
+                                                   std::map<std::string, PhysicsComponent*>& byName) {
+    std::string name = nodeJson.value("name", "Node");
+    auto node = std::make_shared<SceneNode>(name);
+    node->setActive(nodeJson.value("active", true));
+
+    if (nodeJson.contains("transform")) {
+        const json& transformJson = nodeJson["transform"];
+        glm::vec3 value(0.0f);
+        if (transformJson.contains("position")) {
+            readVec3(transformJson["position"], value);
+            node->getTransform().setPosition(value);
+        }
+        if (transformJson.contains("rotation")) {
+            value = glm::vec3(0.0f);
+            readVec3(transformJson["rotation"], value);
+            node->getTransform().setEulerAngles(value);
+        }
+        if (transformJson.contains("scale")) {
+            value = glm::vec3(1.0f);
+            readVec3(transformJson["scale"], value);
+            node->getTransform().setScale(value);
+        }
+    }
+
+    if (nodeJson.contains("components") && nodeJson["components"].is_array()) {
+        for (const auto& componentJson : nodeJson["components"]) {
+            if (componentJson.value("type", "") != "PhysicsComponent") continue;
+
+            auto physicsComp = node->addComponent<PhysicsComponent>();
+
+            std::string shapeType = componentJson.value("collisionShapeType", "BOX");
+            if (shapeType == "SPHERE") {
+                physicsComp->setCollisionShape(CollisionShapeType::SPHERE);
+            } else if (shapeType == "CAPSULE") {
+                physicsComp->setCollisionShape(CollisionShapeType::CAPSULE);
+            } else if (shapeType == "CYLINDER") {
+                physicsComp->setCollisionShape(CollisionShapeType::CYLINDER);
+            } else if (shapeType == "PLANE") {
+                physicsComp->setCollisionShape(CollisionShapeType::PLANE);
+            } else {
+                physicsComp->setCollisionShape(CollisionShapeType::BOX);
+            }
+
+            std::string bodyType = componentJson.value("bodyType", "STATIC");
+            if (bodyType == "DYNAMIC") {
+                physicsComp->setBodyType(PhysicsBodyType::DYNAMIC);
+            } else if (bodyType == "KINEMATIC") {
+                physicsComp->setBodyType(PhysicsBodyType::KINEMATIC);
+            } else {
+                physicsComp->setBodyType(PhysicsBodyType::STATIC);
+            }
+
+            if (componentJson.contains("mass")) physicsComp->setMass(componentJson["mass"]);
+            if (componentJson.contains("friction")) physicsComp->setFriction(componentJson["friction"]);
+            if (componentJson.contains("restitution")) physicsComp->setRestitution(componentJson["restitution"]);
+            if (componentJson.contains("linearDamping")) physicsComp->setLinearDamping(componentJson["linearDamping"]);
+            if (componentJson.contains("angularDamping")) physicsComp->setAngularDamping(componentJson["angularDamping"]);
+
+            physicsComponents.push_back(physicsComp);
+            byName[name] = physicsComp;
+        }
+    }
+
+    if (nodeJson.contains("children") && nodeJson["children"].is_array()) {
+        for (const auto& childJson : nodeJson["children"]) {
+            auto child = buildPhysicsNode(childJson, physicsComponents, byName);
+            if (child) {
+                node->addChild(child);
+            }
+        }
+    }
+
+    return node;
+}
+
+static bool loadPhysicsScene(const std::string& path, Scene& scene,
+                             std::vector<PhysicsComponent*>& physicsComponents,
+                             std::map<std::string, PhysicsComponent*>& byName) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "physics_bench: Failed to open scene: " << path << std::endl;
+        return false;
+    }
+
+    try {
+        json sceneJson = json::parse(file);
+        if (sceneJson.contains("rootNode")) {
+            auto root = buildPhysicsNode(sceneJson["rootNode"], physicsComponents, byName);
+            std::vector<std::shared_ptr<SceneNode>> children;
+            for (size_t i = 0; i < root->getChildCount(); ++i) {
+                children.push_back(root->getChild(i));
+            }
+            for (auto& child : children) {
+                scene.addNode(child);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "physics_bench: Error parsing scene: " << e.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Adds a grid of dynamic spheres above the origin so the solver has real work to do
+static void spawnBodies(Scene& scene, int count, std::vector<PhysicsComponent*>& physicsComponents,
+                        std::map<std::string, PhysicsComponent*>& byName) {
+    int side = std::max(1, (int)std::ceil(std::cbrt((double)count)));
+    for (int i = 0; i < count; ++i) {
+        int x = i % side;
+        int z = (i / side) % side;
+        int y = i / (side * side);
+
+        std::string name = "BenchBody_" + std::to_string(i);
+        auto node = std::make_shared<SceneNode>(name);
+        node->getTransform().setPosition(glm::vec3((x - side * 0.5f) * 1.1f, 5.0f + y * 1.1f, (z - side * 0.5f) * 1.1f));
+        node->getTransform().setScale(glm::vec3(0.5f));
+
+        auto physicsComp = node->addComponent<PhysicsComponent>();
+        physicsComp->setCollisionShape(CollisionShapeType::SPHERE);
+        physicsComp->setBodyType(PhysicsBodyType::DYNAMIC);
+        physicsComp->setMass(1.0f);
+        scene.addNode(node);
+
+        physicsComponents.push_back(physicsComp);
+        byName[name] = physicsComp;
+    }
+}
+
+static bool loadInputTrack(const std::string& path, std::vector<InputCommand>& commands) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "physics_bench: Failed to open input track: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+
+        std::istringstream stream(line);
+        InputCommand command;
+        if (stream >> command.step >> command.nodeName >> command.action
+                   >> command.value.x >> command.value.y >> command.value.z) {
+            commands.push_back(command);
+        }
+    }
+
+    std::stable_sort(commands.begin(), commands.end(),
+        [](const InputCommand& a, const InputCommand& b) { return a.step < b.step; });
+    return true;
+}
+
+static void applyInput(const InputCommand& command, std::map<std::string, PhysicsComponent*>& byName) {
+    auto it = byName.find(command.nodeName);
+    if (it == byName.end()) {
+        std::cerr << "physics_bench: Input references unknown physics node: " << command.nodeName << std::endl;
+        return;
+    }
+
+    PhysicsComponent* physicsComp = it->second;
+    if (command.action == "impulse") {
+        physicsComp->applyImpulse(command.value);
+    } else if (command.action == "velocity") {
+        physicsComp->setLinearVelocity(command.value);
+    } else if (command.action == "position") {
+        SceneNode* owner = physicsComp->getOwner();
+        if (owner) {
+            owner->getTransform().setPosition(command.value);
+            physicsComp->forceUpdateCollisionShape();
+        }
+    } else {
+        std::cerr << "physics_bench: Unknown input action: " << command.action << std::endl;
+    }
+}
+
+static bool writeTrace(const std::string& path, const std::vector<StepRecord>& records) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "physics_bench: Failed to open trace for writing: " << path << std::endl;
+        return false;
+    }
+
+    file << "step,ms,bodies,contacts,hash\n";
+    for (const auto& record : records) {
+        char hash[17];
+        snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)record.hash);
+        file << record.step << "," << record.milliseconds << "," << record.bodies << ","
+             << record.contacts << "," << hash << "\n";
+    }
+    return true;
+}
+
+static const int TRACE_LENGTH_MISMATCH = -3;
+
+// Compares hashes against a previously recorded trace. Returns the first
+// diverging step, -1 when everything matches, -2 if the trace is unreadable,
+// or TRACE_LENGTH_MISMATCH if it has a different number of steps than the run.
+static int verifyTrace(const std::string& path, const std::vector<StepRecord>& records) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "physics_bench: Failed to open trace for verification: " << path << std::endl;
+        return -2;
+    }
+
+    std::string line;
+    std::getline(file, line); // header
+    size_t index = 0;
+    while (std::getline(file, line)) {
+        size_t lastComma = line.rfind(',');
+        if (lastComma == std::string::npos) continue;
+
+        // Steps past the end of the run are only counted
+        if (index < records.size()) {
+            uint64_t expected = std::strtoull(line.c_str() + lastComma + 1, nullptr, 16);
+            if (expected != records[index].hash) {
+                return records[index].step;
+            }
+        }
+        index++;
+    }
+
+    if (index != records.size()) {
+        std::cerr << "physics_bench: Trace has " << index << " steps, the run has " << records.size() << std::endl;
+        return TRACE_LENGTH_MISMATCH;
+    }
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    std::string scenePath = "assets/scenes/first_game_demo.json";
+    std::string inputPath;
+    std::string recordPath;
+    std::string verifyPath;
+    int steps = 600;
+    int threads = 0;
+    int spawnCount = 0;
+    const float fixedTimeStep = 1.0f / 60.0f;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--steps" && hasValue) {
+            steps = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--spawn" && hasValue) {
+            spawnCount = std::atoi(argv[++i]);
+        } else if (arg == "--input" && hasValue) {
+            inputPath = argv[++i];
+        } else if (arg == "--record" && hasValue) {
+            recordPath = argv[++i];
+        } else if (arg == "--verify" && hasValue) {
+            verifyPath = argv[++i];
+        } else if (arg[0] != '-') {
+            scenePath = arg;
+        } else {
+            std::cerr << "physics_bench: Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    auto& physics = PhysicsManager::getInstance();
+    physics.setRequestedThreadCount(threads);
+    if (!physics.initialize()) {
+        std::cerr << "physics_bench: Failed to initialize physics" << std::endl;
+        return 1;
+    }
+
+    Scene scene("PhysicsBench");
+    std::vector<PhysicsComponent*> physicsComponents;
+    std::map<std::string, PhysicsComponent*> byName;
+
+    if (!loadPhysicsScene(scenePath, scene, physicsComponents, byName)) {
+        return 1;
+    }
+    spawnBodies(scene, spawnCount, physicsComponents, byName);
+
+    std::vector<InputCommand> commands;
+    if (!inputPath.empty() && !loadInputTrack(inputPath, commands)) {
+        return 1;
+    }
+
+    // Creates the rigid bodies now that the hierarchy (and thus world transforms) is final
+    scene.start();
+
+    std::vector<StepRecord> records;
+    records.reserve(steps);
+    size_t nextCommand = 0;
+
+    for (int step = 0; step < steps; ++step) {
+        while (nextCommand < commands.size() && commands[nextCommand].step <= step) {
+            applyInput(commands[nextCommand], byName);
+            nextCommand++;
+        }
+
+        for (auto* physicsComp : physicsComponents) {
+            physicsComp->update(fixedTimeStep);
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        physics.stepFixed(fixedTimeStep);
+        auto end = std::chrono::steady_clock::now();
+
+        StepRecord record;
+        record.step = step;
+        record.milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+        record.bodies = physics.getRigidBodyCount();
+        record.contacts = physics.getContactCount();
+        record.hash = physics.computeStateHash();
+        records.push_back(record);
+    }
+
+    std::vector<double> timings;
+    double total = 0.0;
+    int maxContacts = 0;
+    for (const auto& record : records) {
+        timings.push_back(record.milliseconds);
+        total += record.milliseconds;
+        maxContacts = std::max(maxContacts, record.contacts);
+    }
+    std::sort(timings.begin(), timings.end());
+
+    printf("physics_bench: %s\n", scenePath.c_str());
+    printf("  threads:    %d\n", physics.getThreadCount());
+    printf("  steps:      %d (dt %.4f s)\n", steps, fixedTimeStep);
+    printf("  bodies:     %d\n", physics.getRigidBodyCount());
+    printf("  contacts:   %d max\n", maxContacts);
+    if (!timings.empty()) {
+        printf("  step ms:    total %.3f  mean %.4f  min %.4f  p50 %.4f  p95 %.4f  max %.4f\n",
+               total, total / timings.size(), timings.front(), timings[timings.size() / 2],
+               timings[(timings.size() * 95) / 100], timings.back());
+        printf("  final hash: %016llx\n", (unsigned long long)records.back().hash);
+    }
+
+    int exitCode = 0;
+    if (!recordPath.empty() && !writeTrace(recordPath, records)) {
+        exitCode = 1;
+    }
+
+    if (!verifyPath.empty()) {
+        int divergence = verifyTrace(verifyPath, records);
+        if (divergence == -1) {
+            printf("  verify:     OK, all step hashes match %s\n", verifyPath.c_str());
+        } else if (divergence >= 0) {
+            printf("  verify:     FAILED, state diverges at step %d\n", divergence);
+            exitCode = 2;
+        } else if (divergence == TRACE_LENGTH_MISMATCH) {
+            printf("  verify:     FAILED, trace length differs from the run\n");
+            exitCode = 2;
+        } else {
+            exitCode = 1;
+        }
+    }
+
+    scene.destroy();
+    physics.shutdown();
+    return exitCode;
+}
+
+#endif
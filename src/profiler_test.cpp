@@ -0,0 +1,494 @@
+#ifdef LINUX_BUILD
+
+// Headless check of the scoped-zone profiler. Checks zone nesting and depth,
+// the depth limit, zones that straddle the profiler being switched on or off,
+// ring wraparound, worker threads writing while the main thread captures
+// (every copied record must be whole), hitch capture and the Chrome trace
+// export. Then the stats registry (counters from several threads, gauges,
+// history, allocation counting) and the asynchronous logger (compile-time
+// stripping, every message either written whole or counted as dropped).
+// Finally times a zone with the profiler on and off, and a log call.
+//
+// Usage:
+//   profiler_test [--threads N] [--zones N]
+
+#include "../game_engine/include/Core/Profiler.h"
+#include "../game_engine/include/Core/Stats.h"
+#include "../game_engine/include/Core/Log.h"
+#include "../vendor/json/single_include/nlohmann/json.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace GameEngine;
+
+static bool report(const char* name, bool ok, const std::string& detail) {
+    printf("  %-22s %s  %s\n", name, ok ? "OK    " : "FAILED", detail.c_str());
+    return ok;
+}
+
+static const ProfileThreadCapture* findThread(const ProfileCapture& capture, const std::string& name) {
+    for (const auto& thread : capture.threads) {
+        if (thread.name == name) return &thread;
+    }
+    return nullptr;
+}
+
+static void spin(uint64_t nanoseconds) {
+    uint64_t end = Profiler::getTime() + nanoseconds;
+    while (Profiler::getTime() < end) {}
+}
+
+// Each zone must lie inside the last open zone one level up
+static bool runNestingCase() {
+    auto& profiler = Profiler::getInstance();
+    profiler.markFrame();
+    {
+        PROFILE_ZONE("Outer");
+        spin(20000);
+        {
+            PROFILE_ZONE("Middle");
+            spin(20000);
+            {
+                PROFILE_ZONE("Inner");
+                spin(20000);
+            }
+        }
+        {
+            PROFILE_ZONE("Sibling");
+            spin(20000);
+        }
+    }
+    profiler.markFrame();
+
+    ProfileCapture capture;
+    profiler.capture(1, capture);
+    const ProfileThreadCapture* main = findThread(capture, "Main");
+    std::vector<std::string> names;
+    bool nested = main && main->zones.size() == 4;
+    if (main) {
+        for (const auto& zone : main->zones) names.push_back(zone.name);
+    }
+    nested = nested && names[0] == "Inner" && names[1] == "Middle" && names[2] == "Sibling" && names[3] == "Outer";
+    if (nested) {
+        const auto& zones = main->zones;
+        nested = zones[0].depth == 2 && zones[1].depth == 1 && zones[2].depth == 1 && zones[3].depth == 0 &&
+                 zones[3].begin <= zones[1].begin && zones[1].begin <= zones[0].begin &&
+                 zones[0].end <= zones[1].end && zones[1].end <= zones[2].begin && zones[2].end <= zones[3].end &&
+                 zones[3].begin >= capture.getBegin() && zones[3].end <= capture.getEnd();
+    }
+    return report("nesting", nested, std::to_string(names.size()) + " zones in the frame");
+}
+
+static void recurse(uint32_t depth) {
+    PROFILE_ZONE("Deep");
+    if (depth > 1) recurse(depth - 1);
+}
+
+// Zones past MAX_DEPTH are dropped, and the zones after them still pair up
+static bool runDepthCase() {
+    auto& profiler = Profiler::getInstance();
+    const uint32_t depth = Profiler::MAX_DEPTH + 8;
+    profiler.markFrame();
+    recurse(depth);
+    {
+        PROFILE_ZONE("After");
+    }
+    profiler.markFrame();
+
+    ProfileCapture capture;
+    profiler.capture(1, capture);
+    const ProfileThreadCapture* main = findThread(capture, "Main");
+    uint32_t deep = 0;
+    uint32_t maxDepth = 0;
+    bool after = false;
+    if (main) {
+        for (const auto& zone : main->zones) {
+            if (std::string(zone.name) == "Deep") {
+                deep++;
+                maxDepth = std::max(maxDepth, zone.depth);
+            } else if (std::string(zone.name) == "After") {
+                after = zone.depth == 0;
+            }
+        }
+    }
+    bool ok = deep == Profiler::MAX_DEPTH && maxDepth == Profiler::MAX_DEPTH - 1 && after;
+    return report("depth limit", ok, std::to_string(deep) + " of " + std::to_string(depth) + " zones recorded");
+}
+
+// A zone is recorded if the profiler was on when it began
+static bool runToggleCase() {
+    auto& profiler = Profiler::getInstance();
+    profiler.markFrame();
+    profiler.setEnabled(false);
+    {
+        PROFILE_ZONE("Off");
+        profiler.setEnabled(true);
+        {
+            PROFILE_ZONE("On");
+            profiler.setEnabled(false);
+        }
+        PROFILE_ZONE("OffAgain");
+    }
+    profiler.setEnabled(true);
+    profiler.markFrame();
+
+    ProfileCapture capture;
+    profiler.capture(1, capture);
+    const ProfileThreadCapture* main = findThread(capture, "Main");
+    bool ok = main && main->zones.size() == 1 && std::string(main->zones[0].name) == "On" && main->zones[0].depth == 1;
+    return report("on/off", ok, std::to_string(main ? main->zones.size() : 0) + " zones recorded");
+}
+
+// Only the newest zones survive a frame that writes more than a ring holds.
+// A capture never trusts the oldest slot (the writer may be in it), so a
+// full ring gives ZONE_CAPACITY - 1
+static bool runWraparoundCase() {
+    auto& profiler = Profiler::getInstance();
+    const uint32_t count = Profiler::ZONE_CAPACITY * 2 + 5;
+    std::vector<const char*> names;
+    for (uint32_t i = 0; i < 7; ++i) {
+        names.push_back(Profiler::internName("Wrap " + std::to_string(i)));
+    }
+
+    profiler.markFrame();
+    for (uint32_t i = 0; i < count; ++i) {
+        PROFILE_ZONE(names[i % names.size()]);
+    }
+    profiler.markFrame();
+
+    ProfileCapture capture;
+    profiler.capture(1, capture);
+    const ProfileThreadCapture* main = findThread(capture, "Main");
+    const uint32_t kept = Profiler::ZONE_CAPACITY - 1;
+    bool ok = main && main->zones.size() == kept;
+    for (uint32_t i = 0; ok && i < main->zones.size(); ++i) {
+        uint32_t written = count - kept + i;
+        ok = main->zones[i].name == names[written % names.size()] &&
+             (i == 0 || main->zones[i].begin >= main->zones[i - 1].end);
+    }
+    return report("wraparound", ok, std::to_string(main ? main->zones.size() : 0) + " of " +
+                                    std::to_string(count) + " zones kept");
+}
+
+// Workers write nested zones as fast as they can, lapping their rings while
+// the main thread captures. A torn record would break the nesting pattern
+static bool runThreadCase(int threadCount, int frames) {
+    auto& profiler = Profiler::getInstance();
+    std::atomic<bool> stop(false);
+    std::atomic<int> started(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t) {
+        workers.push_back(std::thread([&profiler, &stop, &started, t]() {
+            profiler.setThreadName("Worker " + std::to_string(t));
+            started++;
+            while (!stop.load(std::memory_order_relaxed)) {
+                PROFILE_ZONE("Job");
+                PROFILE_ZONE("Task");
+            }
+        }));
+    }
+    while (started.load() < threadCount) {
+        std::this_thread::yield();
+    }
+
+    ProfileCapture capture;
+    size_t captured = 0;
+    int bad = 0;
+    int threadsSeen = 0;
+    for (int frame = 0; frame < frames; ++frame) {
+        profiler.markFrame();
+        spin(200000);
+        profiler.capture(2, capture);
+        threadsSeen = 0;
+        for (const auto& thread : capture.threads) {
+            if (thread.name.compare(0, 7, "Worker ") != 0) continue;
+            threadsSeen++;
+            captured += thread.zones.size();
+            for (size_t i = 0; i < thread.zones.size(); ++i) {
+                const ProfileZoneRecord& zone = thread.zones[i];
+                std::string name = zone.name;
+                bool whole = zone.begin <= zone.end &&
+                             ((name == "Task" && zone.depth == 1) || (name == "Job" && zone.depth == 0));
+                if (whole && i > 0) {
+                    // Records are written in the order zones end
+                    whole = zone.end >= thread.zones[i - 1].end;
+                }
+                if (!whole) bad++;
+            }
+        }
+    }
+    stop = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    bool ok = bad == 0 && threadsSeen == threadCount && captured > 0;
+    return report("threads", ok, std::to_string(threadCount) + " writers, " + std::to_string(captured) +
+                                 " zones copied, " + std::to_string(bad) + " torn");
+}
+
+static bool runHitchCase() {
+    auto& profiler = Profiler::getInstance();
+    uint32_t before = profiler.getHitchCount();
+    profiler.markFrame();
+    profiler.setHitchThreshold(5.0f);
+    profiler.markFrame();
+    {
+        PROFILE_ZONE("Hitch");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    profiler.markFrame();
+    profiler.setHitchThreshold(0.0f);
+
+    const ProfileCapture& hitch = profiler.getLastHitch();
+    const ProfileThreadCapture* main = findThread(hitch, "Main");
+    bool found = false;
+    if (main) {
+        for (const auto& zone : main->zones) {
+            found = found || std::string(zone.name) == "Hitch";
+        }
+    }
+    bool ok = profiler.getHitchCount() == before + 1 && !hitch.frames.empty() &&
+              hitch.frames.size() <= Profiler::HITCH_FRAMES &&
+              (hitch.frames.back().end - hitch.frames.back().begin) > 5000000 && found;
+    return report("hitch capture", ok, std::to_string(hitch.frames.size()) + " frames kept, " +
+                                       std::to_string(profiler.getLastFrameMs()) + " ms last frame");
+}
+
+// The trace must parse and hold one complete event per frame and zone
+static bool runTraceCase() {
+    auto& profiler = Profiler::getInstance();
+    ProfileCapture capture;
+    profiler.capture(4, capture);
+    size_t zones = 0;
+    for (const auto& thread : capture.threads) {
+        zones += thread.zones.size();
+    }
+
+    std::string text = Profiler::toChromeTrace(capture);
+    nlohmann::json trace = nlohmann::json::parse(text, nullptr, false);
+    size_t complete = 0;
+    size_t threadNames = 0;
+    bool timesOk = true;
+    if (!trace.is_discarded() && trace.contains("traceEvents")) {
+        for (const auto& event : trace["traceEvents"]) {
+            if (event["ph"] == "X") {
+                complete++;
+                // Microseconds, overlapping the captured frames
+                double begin = event["ts"].get<double>() * 1000.0;
+                double end = begin + event["dur"].get<double>() * 1000.0;
+                timesOk = timesOk && begin <= end && end >= capture.getBegin() - 1000.0 &&
+                          begin <= capture.getEnd() + 1000.0;
+            } else if (event["ph"] == "M" && event["name"] == "thread_name") {
+                threadNames++;
+            }
+        }
+    }
+    bool ok = !trace.is_discarded() && complete == capture.frames.size() + zones &&
+              threadNames == capture.threads.size() + 1 && timesOk;
+    return report("chrome trace", ok, std::to_string(complete) + " events, " + std::to_string(text.size()) + " bytes");
+}
+
+// Counters sum across threads and reset each frame; gauges hold their level
+static bool runStatsCase(int threadCount) {
+    Stats& stats = Stats::getInstance();
+    Stat& counter = stats.getCounter("Test counter");
+    Stat& gauge = stats.getGauge("Test gauge");
+    const int adds = 100000;
+
+    stats.sampleFrame();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t) {
+        workers.push_back(std::thread([&counter]() {
+            for (int i = 0; i < adds; ++i) {
+                counter.add();
+            }
+        }));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    gauge.set(42);
+    std::vector<std::unique_ptr<int>> allocations;
+    for (int i = 0; i < 100; ++i) {
+        allocations.push_back(std::unique_ptr<int>(new int(i)));
+    }
+    stats.sampleFrame();
+    stats.sampleFrame();
+
+    int counterIndex = stats.findStat("Test counter");
+    int gaugeIndex = stats.findStat("Test gauge");
+    int allocationIndex = stats.findStat("Allocations");
+    std::vector<float> history;
+    stats.getHistory(static_cast<uint32_t>(counterIndex), history);
+    int64_t counted = stats.getSample(counterIndex, 1);
+    bool ok = counterIndex >= 0 && gaugeIndex >= 0 && &stats.getCounter("Test counter") == &counter &&
+              counted == static_cast<int64_t>(adds) * threadCount && stats.getSample(counterIndex) == 0 &&
+              stats.getSample(gaugeIndex) == 42 && stats.getSample(gaugeIndex, 1) == 42 &&
+              history.size() >= 3 && history[history.size() - 2] == static_cast<float>(counted) &&
+              stats.findStat("No such stat") < 0;
+#if ENGINE_COUNT_ALLOCATIONS
+    ok = ok && allocationIndex >= 0 && stats.getSample(allocationIndex, 1) >= 100;
+#endif
+    return report("stats", ok, std::to_string(counted) + " counted, " +
+                               std::to_string(stats.getSample(allocationIndex, 1)) + " allocations");
+}
+
+// Floods the logger from several threads with stdout sent to a file, then
+// checks every line that arrived is whole and that arrived + dropped = sent
+static bool runLogCase(int threadCount, double& writeNs) {
+    Log& log = Log::getInstance();
+    int evaluated = 0;
+    LOG_TRACE("stripped %d", ++evaluated);
+
+    char path[] = "/tmp/profiler_test_log_XXXXXX";
+    int file = mkstemp(path);
+    if (file < 0) {
+        return report("logger", false, "no temporary file");
+    }
+    fflush(stdout);
+    int savedStdout = dup(STDOUT_FILENO);
+    dup2(file, STDOUT_FILENO);
+
+    // A burst that fits the queue must arrive whole; a flood is counted
+    const int burst = static_cast<int>(Log::QUEUE_CAPACITY) / threadCount;
+    const int flood = 20000;
+    log.setLevel(LogLevel::INFO);
+    uint32_t droppedBefore = log.getDroppedCount();
+    log.start();
+    std::atomic<int64_t> totalNs(0);
+    uint32_t burstDropped = 0;
+    for (int messages : {burst, flood}) {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threadCount; ++t) {
+            workers.push_back(std::thread([&log, &totalNs, t, messages]() {
+                auto begin = std::chrono::steady_clock::now();
+                for (int i = 0; i < messages; ++i) {
+                    log.write(LogLevel::INFO, "logtest %d %d end", t, i);
+                    log.write(LogLevel::VERBOSE, "logtest filtered");
+                }
+                auto end = std::chrono::steady_clock::now();
+                totalNs += std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+            }));
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        if (messages == burst) {
+            burstDropped = log.getDroppedCount() - droppedBefore;
+            // Let the writer catch up before the flood
+            while (true) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                FILE* probe = fopen(path, "r");
+                int arrived = 0;
+                char text[512];
+                while (probe && fgets(text, sizeof(text), probe)) {
+                    arrived += strncmp(text, "logtest", 7) == 0;
+                }
+                if (probe) fclose(probe);
+                if (arrived >= burst * threadCount) break;
+            }
+        }
+    }
+    log.stop();
+
+    fflush(stdout);
+    dup2(savedStdout, STDOUT_FILENO);
+    close(savedStdout);
+    close(file);
+
+    int lines = 0;
+    int torn = 0;
+    FILE* input = fopen(path, "r");
+    char line[512];
+    while (input && fgets(line, sizeof(line), input)) {
+        if (strncmp(line, "logtest", 7) != 0) continue;
+        int thread = -1;
+        int index = -1;
+        char tail[8] = {0};
+        if (sscanf(line, "logtest %d %d %7s", &thread, &index, tail) == 3 && strcmp(tail, "end") == 0) {
+            lines++;
+        } else {
+            torn++;
+        }
+    }
+    if (input) {
+        fclose(input);
+    }
+    remove(path);
+
+    int sent = (burst + flood) * threadCount;
+    int dropped = static_cast<int>(log.getDroppedCount() - droppedBefore);
+    writeNs = static_cast<double>(totalNs.load()) / (sent * 2);
+    bool ok = evaluated == 0 && burstDropped == 0 && torn == 0 && lines + dropped == sent &&
+              lines >= burst * threadCount;
+    return report("logger", ok, std::to_string(lines) + " written, " + std::to_string(dropped) + " dropped, " +
+                                std::to_string(torn) + " torn");
+}
+
+static double zoneCost(bool enabled, int zones) {
+    auto& profiler = Profiler::getInstance();
+    profiler.setEnabled(enabled);
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < zones; ++i) {
+        PROFILE_ZONE("Cost");
+    }
+    auto end = std::chrono::steady_clock::now();
+    profiler.setEnabled(true);
+    return std::chrono::duration<double, std::nano>(end - begin).count() / zones;
+}
+
+int main(int argc, char** argv) {
+    int threads = 4;
+    int zones = 2000000;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--threads" && hasValue) {
+            threads = std::max(1, std::min(std::atoi(argv[++i]), static_cast<int>(Profiler::MAX_THREADS) - 1));
+        } else if (arg == "--zones" && hasValue) {
+            zones = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "profiler_test: Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    Profiler::getInstance().setThreadName("Main");
+    printf("Profiler test (%u zones per thread ring)\n", Profiler::ZONE_CAPACITY);
+    bool ok = true;
+    ok = runNestingCase() && ok;
+    ok = runDepthCase() && ok;
+    ok = runToggleCase() && ok;
+    ok = runWraparoundCase() && ok;
+    ok = runThreadCase(threads, 50) && ok;
+    ok = runHitchCase() && ok;
+    ok = runTraceCase() && ok;
+    ok = runStatsCase(threads) && ok;
+    double logNs = 0.0;
+    ok = runLogCase(threads, logNs) && ok;
+
+    double enabledNs = zoneCost(true, zones);
+    double disabledNs = zoneCost(false, zones);
+    printf("Zone cost, %d zones\n", zones);
+    printf("  recording              %8.2f ns/zone\n", enabledNs);
+    printf("  switched off           %8.2f ns/zone\n", disabledNs);
+    printf("Log call, %d threads flooding (half filtered out at run time)\n", threads);
+    printf("  queued or dropped      %8.2f ns/call\n", logNs);
+
+    return ok ? 0 : 2;
+}
+
+#endif
@@ -0,0 +1,331 @@
+#ifdef LINUX_BUILD
+
+// Headless render harness: runs the full engine frame (update, scene render,
+// menus, present) on the null or software render backend and reports per-frame
+// timings plus what the frame asked of the GPU. On the null backend every
+// device call is recorded and hashed, so a command stream can be recorded once
+// and verified in CI without a GPU or a display.
+//
+// Usage:
+//   render_bench [scene.json] [--backend null|software] [--frames N]
+//                [--record trace.csv] [--verify trace.csv] [--dump commands.txt]
+//                [--profile trace.json] [--frame-latency 0|1]
+//
+// --profile writes the profiler's zones for the last frames as a Chrome trace
+// (chrome://tracing, ui.perfetto.dev) and prints where the frame time went.
+// --frame-latency 1 simulates the next frame on a second thread while this
+// one is submitted; frame N then draws what frame N-1 simulated, so a scene
+// that moves should be verified against a trace recorded at the same latency.
+
+#include "../game_engine/include/Core/Engine.h"
+#include "../game_engine/include/Rendering/RenderDevice.h"
+#include "../game_engine/include/Rendering/NullRenderDevice.h"
+#include "../game_engine/include/Core/Profiler.h"
+#include "../game_engine/include/Core/Stats.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace GameEngine;
+
+struct FrameRecord {
+    int frame;
+    double milliseconds;
+    int drawCalls;                  // from the Renderer, valid on every backend
+    RenderDeviceStats device;       // zero unless the backend counts (null)
+    uint64_t hash;
+};
+
+static uint64_t hashCommands(const std::vector<RenderDeviceCommand>& commands) {
+    // FNV-1a over every command's name and arguments
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto& command : commands) {
+        for (const char* c = command.name; *c; ++c) {
+            hash = (hash ^ static_cast<uint8_t>(*c)) * 1099511628211ULL;
+        }
+        for (uint32_t arg : command.args) {
+            hash = (hash ^ arg) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+static bool writeTrace(const std::string& path, const std::vector<FrameRecord>& records) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "render_bench: Failed to open trace for writing: " << path << std::endl;
+        return false;
+    }
+
+    file << "frame,ms,draws,commands,state_changes,redundant,uniforms,bytes_uploaded,hash\n";
+    for (const auto& record : records) {
+        char hash[17];
+        snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)record.hash);
+        file << record.frame << "," << record.milliseconds << "," << record.drawCalls << ","
+             << record.device.commands << "," << record.device.stateChanges << ","
+             << record.device.redundantStateChanges << "," << record.device.uniformUploads << ","
+             << record.device.bytesUploaded << "," << hash << "\n";
+    }
+    return true;
+}
+
+// Compares command hashes against a previously recorded trace. Returns the
+// first diverging frame, -1 when everything matches, or -2 if the trace is unreadable.
+static int verifyTrace(const std::string& path, const std::vector<FrameRecord>& records) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "render_bench: Failed to open trace for verification: " << path << std::endl;
+        return -2;
+    }
+
+    std::string line;
+    std::getline(file, line); // header
+    size_t index = 0;
+    while (std::getline(file, line) && index < records.size()) {
+        size_t lastComma = line.rfind(',');
+        if (lastComma == std::string::npos) continue;
+
+        uint64_t expected = std::strtoull(line.c_str() + lastComma + 1, nullptr, 16);
+        if (expected != records[index].hash) {
+            return records[index].frame;
+        }
+        index++;
+    }
+
+    if (index < records.size()) {
+        std::cerr << "render_bench: Trace is shorter than the run (" << index << " frames)" << std::endl;
+    }
+    return -1;
+}
+
+static bool dumpCommands(const std::string& path, const std::vector<RenderDeviceCommand>& commands) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "render_bench: Failed to open command dump: " << path << std::endl;
+        return false;
+    }
+    for (const auto& command : commands) {
+        file << command.name << " " << command.args[0] << " " << command.args[1] << " " << command.args[2] << "\n";
+    }
+    return true;
+}
+
+static bool writeProfile(const std::string& path) {
+    // Closes the last frame so it is captured whole
+    auto& profiler = Profiler::getInstance();
+    profiler.markFrame();
+    ProfileCapture capture;
+    profiler.capture(Profiler::FRAME_CAPACITY, capture);
+    if (capture.frames.empty()) {
+        std::cerr << "render_bench: No frames to profile" << std::endl;
+        return false;
+    }
+
+    // Nested zones count in their parents too, as in the editor's table
+    std::map<std::string, std::pair<size_t, double>> totals;
+    for (const auto& thread : capture.threads) {
+        for (const auto& zone : thread.zones) {
+            auto& total = totals[zone.name];
+            total.first++;
+            total.second += (zone.end - zone.begin) / 1.0e6;
+        }
+    }
+    std::vector<std::pair<std::string, std::pair<size_t, double>>> sorted(totals.begin(), totals.end());
+    std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, std::pair<size_t, double>>& a,
+                                               const std::pair<std::string, std::pair<size_t, double>>& b) {
+        return a.second.second > b.second.second;
+    });
+
+    const double frameCount = static_cast<double>(capture.frames.size());
+    printf("  profile:    %zu frames, zone ms per frame\n", capture.frames.size());
+    for (size_t i = 0; i < sorted.size() && i < 20; ++i) {
+        printf("    %9.4f  %7.1f calls  %s\n", sorted[i].second.second / frameCount,
+               sorted[i].second.first / frameCount, sorted[i].first.c_str());
+    }
+
+    if (!Profiler::saveChromeTrace(capture, path)) {
+        return false;
+    }
+    printf("  trace:      %s\n", path.c_str());
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::string scenePath = "assets/scenes/first_game_demo.json";
+    std::string backendName = "null";
+    std::string recordPath;
+    std::string verifyPath;
+    std::string dumpPath;
+    std::string profilePath;
+    int frames = 300;
+    int frameLatency = -1;
+    const float fixedTimeStep = 1.0f / 60.0f;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--backend" && hasValue) {
+            backendName = argv[++i];
+        } else if (arg == "--frames" && hasValue) {
+            frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--record" && hasValue) {
+            recordPath = argv[++i];
+        } else if (arg == "--verify" && hasValue) {
+            verifyPath = argv[++i];
+        } else if (arg == "--dump" && hasValue) {
+            dumpPath = argv[++i];
+        } else if (arg == "--profile" && hasValue) {
+            profilePath = argv[++i];
+        } else if (arg == "--frame-latency" && hasValue) {
+            frameLatency = std::atoi(argv[++i]);
+        } else if (arg[0] != '-') {
+            scenePath = arg;
+        } else {
+            std::cerr << "render_bench: Unknown argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    RenderBackend backend;
+    if (!RenderDevice::parseBackend(backendName, backend) || backend == RenderBackend::OPENGL) {
+        std::cerr << "render_bench: Backend must be null or software, got " << backendName << std::endl;
+        return 1;
+    }
+    RenderDevice::setBackend(backend);
+
+    Engine engine;
+    if (!engine.initialize(EngineMode::GAME)) {
+        std::cerr << "render_bench: Failed to initialize the engine on the "
+                  << RenderDevice::getBackendName(RenderDevice::getBackend()) << " backend" << std::endl;
+        return 1;
+    }
+    engine.getTime().setFixedDeltaTime(fixedTimeStep);
+    if (frameLatency >= 0) {
+        engine.setFrameLatency(frameLatency);
+    }
+
+    if (!engine.getSceneManager().loadSceneFromFile("RenderBench", scenePath)) {
+        return 1;
+    }
+
+    auto& device = RenderDevice::getInstance();
+    NullRenderDevice* nullDevice = nullptr;
+    if (RenderDevice::getBackend() == RenderBackend::NULL_DEVICE) {
+        nullDevice = static_cast<NullRenderDevice*>(&device);
+        nullDevice->setRecording(true);
+    }
+
+    std::vector<FrameRecord> records;
+    records.reserve(frames);
+
+    for (int frame = 0; frame < frames; ++frame) {
+        device.resetStats();
+        if (nullDevice) {
+            nullDevice->clearCommands();
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        bool running = engine.runFrame();
+        auto end = std::chrono::steady_clock::now();
+
+        FrameRecord record;
+        record.frame = frame;
+        record.milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+        record.drawCalls = engine.getRenderer().getStats().drawCalls;
+        record.device = device.getStats();
+        record.hash = nullDevice ? hashCommands(nullDevice->getCommands()) : 0;
+        records.push_back(record);
+
+        if (!running) {
+            std::cerr << "render_bench: Engine stopped after " << (frame + 1) << " frames" << std::endl;
+            break;
+        }
+    }
+
+    // The first frame uploads most of the scene, so it is reported apart from the steady state
+    std::vector<double> timings;
+    double total = 0.0;
+    for (size_t i = 1; i < records.size(); ++i) {
+        timings.push_back(records[i].milliseconds);
+        total += records[i].milliseconds;
+    }
+    std::sort(timings.begin(), timings.end());
+    const FrameRecord& first = records.front();
+    const FrameRecord& last = records.back();
+
+    printf("render_bench: %s\n", scenePath.c_str());
+    printf("  backend:    %s\n", RenderDevice::getBackendName(RenderDevice::getBackend()));
+    printf("  frames:     %zu (dt %.4f s, latency %d)\n", records.size(), fixedTimeStep, engine.getFrameLatency());
+    printf("  first:      %.3f ms, %zu bytes uploaded\n", first.milliseconds, first.device.bytesUploaded);
+    if (!timings.empty()) {
+        printf("  frame ms:   mean %.4f  min %.4f  p50 %.4f  p95 %.4f  max %.4f\n",
+               total / timings.size(), timings.front(), timings[timings.size() / 2],
+               timings[(timings.size() * 95) / 100], timings.back());
+    }
+    printf("  last frame: %d draws", last.drawCalls);
+    if (nullDevice) {
+        printf(", %u commands, %u state changes (%u redundant), %u uniforms, %zu bytes uploaded\n",
+               last.device.commands, last.device.stateChanges, last.device.redundantStateChanges,
+               last.device.uniformUploads, last.device.bytesUploaded);
+        printf("  live GL objects: %zu\n", nullDevice->getLiveObjectCount());
+        printf("  final hash: %016llx\n", (unsigned long long)last.hash);
+    } else {
+        printf("\n");
+    }
+
+    // Engine stats averaged over the frames the history still holds
+    const Stats& stats = Stats::getInstance();
+    std::vector<float> history;
+    printf("  stats:      mean over the last %u frames\n",
+           static_cast<unsigned>(std::min<uint64_t>(stats.getSampleCount(), Stats::HISTORY_FRAMES)));
+    for (uint32_t i = 0; i < stats.getStatCount(); ++i) {
+        stats.getHistory(i, history);
+        double sum = 0.0;
+        for (float value : history) {
+            sum += value;
+        }
+        printf("    %12.1f  %s\n", history.empty() ? 0.0 : sum / history.size(), stats.getStatAt(i).getName());
+    }
+
+    int exitCode = 0;
+    if (!recordPath.empty() && !writeTrace(recordPath, records)) {
+        exitCode = 1;
+    }
+
+    if (!verifyPath.empty()) {
+        if (!nullDevice) {
+            std::cerr << "render_bench: --verify needs the null backend (only it records commands)" << std::endl;
+            exitCode = 1;
+        } else {
+            int divergence = verifyTrace(verifyPath, records);
+            if (divergence == -1) {
+                printf("  verify:     OK, all frame hashes match %s\n", verifyPath.c_str());
+            } else if (divergence >= 0) {
+                printf("  verify:     FAILED, command stream diverges at frame %d\n", divergence);
+                exitCode = 2;
+            } else {
+                exitCode = 1;
+            }
+        }
+    }
+
+    if (!dumpPath.empty() && nullDevice && !dumpCommands(dumpPath, nullDevice->getCommands())) {
+        exitCode = 1;
+    }
+
+    if (!profilePath.empty() && !writeProfile(profilePath)) {
+        exitCode = 1;
+    }
+
+    engine.shutdown();
+    return exitCode;
+}
+
+#endif
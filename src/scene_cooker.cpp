@@ -0,0 +1,135 @@
+#ifdef LINUX_BUILD
+
+// Offline scene cooker. Converts authoring JSON scenes into .bscene files
+// next to each source (or into --output-dir), which
+// SceneSerializer::loadSceneFromFile picks up in place of the JSON while the
+// cooked file is newer. --check reads every cooked file back, checks it
+// re-encodes to the same bytes, and times the JSON parse against the binary read.
+//
+// Usage:
+//   scene_cooker [--output-dir DIR] [--check] [--repeat N] <scene.json>...
+
+#include "../game_engine/include/Scene/SceneDescription.h"
+#include "../game_engine/include/Scene/SceneJsonReader.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace GameEngine;
+
+static bool readText(const std::string& path, std::string& text) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "scene_cooker: Failed to open " << path << std::endl;
+        return false;
+    }
+    text.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// Best of `repeat` runs, in milliseconds
+template <typename F>
+static double timeBest(int repeat, F&& run) {
+    double best = 0.0;
+    for (int i = 0; i < repeat; ++i) {
+        auto begin = std::chrono::steady_clock::now();
+        run();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        best = (i == 0) ? ms : std::min(best, ms);
+    }
+    return best;
+}
+
+static bool checkCooked(const std::string& json, const std::vector<uint8_t>& cooked, int repeat) {
+    SceneDescription reloaded;
+    if (!reloaded.readBinary(cooked.data(), cooked.size())) {
+        std::cerr << "scene_cooker: Cooked file failed to load" << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> reencoded;
+    reloaded.writeBinary(reencoded);
+    if (reencoded != cooked) {
+        std::cerr << "scene_cooker: Cooked file does not round trip" << std::endl;
+        return false;
+    }
+
+    SceneDescription description;
+    double jsonMs = timeBest(repeat, [&]() { SceneJsonReader::read(json, description); });
+    double binaryMs = timeBest(repeat, [&]() { description.readBinary(cooked.data(), cooked.size()); });
+    std::cout << "  parse: json " << jsonMs << " ms, binary " << binaryMs << " ms ("
+              << (binaryMs > 0.0 ? jsonMs / binaryMs : 0.0) << "x)" << std::endl;
+    return true;
+}
+
+static bool cookFile(const std::string& input, const std::string& outputDir, bool check, int repeat) {
+    std::string json;
+    if (!readText(input, json)) return false;
+
+    SceneDescription description;
+    if (!SceneJsonReader::read(json, description)) {
+        std::cerr << "scene_cooker: " << input << " is not a valid scene" << std::endl;
+        return false;
+    }
+
+    std::vector<uint8_t> cooked;
+    description.writeBinary(cooked);
+
+    std::string output = SceneDescription::getBinaryPath(input);
+    if (!outputDir.empty()) {
+        size_t slash = output.find_last_of("/\\");
+        output = outputDir + "/" + (slash == std::string::npos ? output : output.substr(slash + 1));
+    }
+
+    std::ofstream file(output, std::ios::binary);
+    if (!file.is_open() || !file.write(reinterpret_cast<const char*>(cooked.data()), cooked.size())) {
+        std::cerr << "scene_cooker: Failed to write " << output << std::endl;
+        return false;
+    }
+    file.close();
+
+    std::cout << input << " -> " << output << ": " << description.nodes.size() << " nodes, "
+              << description.components.size() << " components, " << description.getStringCount() << " strings, "
+              << json.size() << " -> " << cooked.size() << " bytes" << std::endl;
+
+    return !check || checkCooked(json, cooked, repeat);
+}
+
+int main(int argc, char** argv) {
+    bool check = false;
+    int repeat = 10;
+    std::string outputDir;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--output-dir" && i + 1 < argc) {
+            outputDir = argv[++i];
+        } else if (arg == "--check") {
+            check = true;
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "scene_cooker: Unknown argument: " << arg << std::endl;
+            return 1;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        std::cerr << "Usage: scene_cooker [--output-dir DIR] [--check] [--repeat N] <scene.json>..." << std::endl;
+        return 1;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        ok = cookFile(inputs[i], outputDir, check, repeat) && ok;
+    }
+    return ok ? 0 : 2;
+}
+
+#endif
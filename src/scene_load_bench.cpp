@@ -0,0 +1,275 @@
+#ifdef LINUX_BUILD
+
+// Scene load benchmark: scales a scene JSON up by repeating the root node's
+// children (renamed so names stay unique), then times the DOM path
+// (nlohmann::json::parse, then SceneJsonReader::readDom) against the
+// streaming SceneJsonReader::read and the cooked binary read. Peak heap is
+// counted through the global allocator, and both JSON paths must produce the
+// same description.
+//
+// With --prefab, the scene is instead N copies of a prefab, written once
+// flattened and once as prefab instances; both must describe the same nodes.
+//
+// Usage:
+//   scene_load_bench [scene.json] [--scale N] [--repeat N]
+//   scene_load_bench --prefab prefab.json [--scale N] [--repeat N]
+
+#include "../game_engine/include/Scene/SceneDescription.h"
+#include "../game_engine/include/Scene/SceneJsonReader.h"
+#include <malloc.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace GameEngine;
+using json = nlohmann::json;
+
+// Heap accounting for operator new/delete; the benchmark is single threaded
+static size_t liveBytes = 0;
+static size_t peakBytes = 0;
+
+void* operator new(size_t size) {
+    void* block = std::malloc(size ? size : 1);
+    if (!block) throw std::bad_alloc();
+    liveBytes += malloc_usable_size(block);
+    peakBytes = std::max(peakBytes, liveBytes);
+    return block;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void* block) noexcept {
+    if (!block) return;
+    liveBytes -= malloc_usable_size(block);
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept { operator delete(block); }
+void operator delete(void* block, size_t) noexcept { operator delete(block); }
+void operator delete[](void* block, size_t) noexcept { operator delete(block); }
+
+struct RunStats {
+    double bestMs;
+    size_t peakHeap;    // above what was live before the run
+};
+
+// Best time of `repeat` runs and the largest heap growth any of them needed
+template <typename F>
+static RunStats measure(int repeat, F&& run) {
+    RunStats stats = { 0.0, 0 };
+    for (int i = 0; i < repeat; ++i) {
+        size_t baseline = liveBytes;
+        peakBytes = liveBytes;
+        auto begin = std::chrono::steady_clock::now();
+        run();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        stats.bestMs = (i == 0) ? ms : std::min(stats.bestMs, ms);
+        stats.peakHeap = std::max(stats.peakHeap, peakBytes - baseline);
+    }
+    return stats;
+}
+
+static void renameSubtree(json& node, const std::string& suffix) {
+    if (node.contains("name") && node["name"].is_string()) {
+        node["name"] = node["name"].get<std::string>() + suffix;
+    }
+    if (node.contains("children") && node["children"].is_array()) {
+        for (auto& child : node["children"]) {
+            renameSubtree(child, suffix);
+        }
+    }
+}
+
+static bool buildScaledScene(const std::string& path, int scale, std::string& text) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "scene_load_bench: Failed to open " << path << std::endl;
+        return false;
+    }
+    json scene = json::parse(file, nullptr, false);
+    if (scene.is_discarded() || !scene.contains("rootNode") || !scene["rootNode"]["children"].is_array()) {
+        std::cerr << "scene_load_bench: " << path << " is not a scene" << std::endl;
+        return false;
+    }
+
+    json& children = scene["rootNode"]["children"];
+    json original = children;
+    for (int copy = 1; copy < scale; ++copy) {
+        for (const auto& child : original) {
+            json clone = child;
+            renameSubtree(clone, "_" + std::to_string(copy));
+            children.push_back(clone);
+        }
+    }
+    // Same layout the editor saves
+    text = scene.dump(2);
+    return true;
+}
+
+// N copies of the prefab in a row, flattened and as instances
+static bool buildPrefabScenes(const std::string& prefabPath, int count, std::string& flattened, std::string& instanced) {
+    std::ifstream file(prefabPath, std::ios::binary);
+    json prefab = json::parse(file, nullptr, false);
+    if (prefab.is_discarded() || !prefab.contains("rootNode") || !prefab["rootNode"].is_object()) {
+        std::cerr << "scene_load_bench: " << prefabPath << " is not a prefab" << std::endl;
+        return false;
+    }
+
+    const json& prefabRoot = prefab["rootNode"];
+    std::string rootName = prefabRoot.value("name", "Node");
+    json flatScene = { { "name", "Prefab Bench" }, { "rootNode", { { "name", "Root" }, { "children", json::array() } } } };
+    json instanceScene = { { "name", "Prefab Bench" }, { "rootNode", { { "name", "Root" }, { "children", json::array() } } } };
+    for (int i = 0; i < count; ++i) {
+        std::string name = rootName + "_" + std::to_string(i);
+        json transform = { { "position", { 2.0f * i, 0.0f, 0.0f } }, { "rotation", { 0.0f, 0.0f, 0.0f } },
+                           { "scale", { 1.0f, 1.0f, 1.0f } } };
+
+        json copy = prefabRoot;
+        copy["name"] = name;
+        copy["transform"] = transform;
+        flatScene["rootNode"]["children"].push_back(copy);
+
+        json instance = { { "name", name }, { "prefab", prefabPath }, { "transform", transform } };
+        instanceScene["rootNode"]["children"].push_back(instance);
+    }
+    flattened = flatScene.dump(2);
+    instanced = instanceScene.dump(2);
+    return true;
+}
+
+// What stays once the prefab bookkeeping is dropped, for comparing an
+// expanded scene with its flattened twin
+static void stripPrefabs(SceneDescription& description) {
+    for (auto& node : description.nodes) {
+        node.prefab = SceneDescription::NO_STRING;
+    }
+    for (auto& component : description.components) {
+        component.origin = 0;
+    }
+}
+
+static void report(const char* label, const RunStats& stats, size_t inputBytes) {
+    double mb = inputBytes / (1024.0 * 1024.0);
+    std::cout << "  " << label << ": " << stats.bestMs << " ms";
+    if (stats.bestMs > 0.0) std::cout << " (" << mb / (stats.bestMs / 1000.0) << " MB/s)";
+    std::cout << ", peak heap " << stats.peakHeap / 1024 << " KB ("
+              << static_cast<double>(stats.peakHeap) / inputBytes << "x input)" << std::endl;
+}
+
+static int comparePrefab(const std::string& prefabPath, int count, int repeat) {
+    std::string flattened;
+    std::string instanced;
+    if (!buildPrefabScenes(prefabPath, count, flattened, instanced)) {
+        return 1;
+    }
+
+    SceneDescription flatDescription;
+    SceneDescription instanceDescription;
+    if (!SceneJsonReader::read(flattened, flatDescription) || !SceneJsonReader::read(instanced, instanceDescription)) {
+        std::cerr << "scene_load_bench: Prefab scenes failed to parse" << std::endl;
+        return 1;
+    }
+    stripPrefabs(instanceDescription);
+    if (!instanceDescription.matches(flatDescription)) {
+        std::cerr << "scene_load_bench: Instanced and flattened descriptions differ" << std::endl;
+        return 2;
+    }
+
+    std::cout << prefabPath << " x" << count << ": " << flatDescription.nodes.size() << " nodes, "
+              << flatDescription.components.size() << " components" << std::endl;
+    std::cout << "  flattened JSON " << flattened.size() / 1024 << " KB, instanced JSON " << instanced.size() / 1024
+              << " KB (" << static_cast<double>(flattened.size()) / instanced.size() << "x smaller)" << std::endl;
+
+    RunStats flat = measure(repeat, [&]() {
+        SceneDescription description;
+        SceneJsonReader::read(flattened, description);
+    });
+    RunStats instances = measure(repeat, [&]() {
+        SceneDescription description;
+        SceneJsonReader::read(instanced, description);
+    });
+    report("flattened", flat, flattened.size());
+    report("instanced", instances, instanced.size());
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::string path = "assets/scenes/first_game_demo.json";
+    std::string prefabPath;
+    int scale = 256;
+    int repeat = 5;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--scale" && i + 1 < argc) {
+            scale = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--prefab" && i + 1 < argc) {
+            prefabPath = argv[++i];
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "scene_load_bench: Unknown argument: " << arg << std::endl;
+            return 1;
+        } else {
+            path = arg;
+        }
+    }
+
+    if (!prefabPath.empty()) {
+        return comparePrefab(prefabPath, scale, repeat);
+    }
+
+    std::string text;
+    if (!buildScaledScene(path, scale, text)) {
+        return 1;
+    }
+
+    SceneDescription domDescription;
+    SceneDescription saxDescription;
+    if (!SceneJsonReader::readDom(json::parse(text, nullptr, false), domDescription) ||
+        !SceneJsonReader::read(text, saxDescription)) {
+        std::cerr << "scene_load_bench: Scaled scene failed to parse" << std::endl;
+        return 1;
+    }
+    if (!saxDescription.matches(domDescription)) {
+        std::cerr << "scene_load_bench: Streaming and DOM descriptions differ" << std::endl;
+        return 2;
+    }
+
+    std::vector<uint8_t> cooked;
+    saxDescription.writeBinary(cooked);
+
+    std::cout << path << " x" << scale << ": " << text.size() / 1024 << " KB JSON, "
+              << saxDescription.nodes.size() << " nodes, " << saxDescription.components.size() << " components, "
+              << cooked.size() / 1024 << " KB cooked" << std::endl;
+
+    // Each run fills a fresh description, so its own growth is part of the peak
+    RunStats dom = measure(repeat, [&]() {
+        SceneDescription description;
+        json scene = json::parse(text, nullptr, false);
+        SceneJsonReader::readDom(scene, description);
+    });
+    RunStats sax = measure(repeat, [&]() {
+        SceneDescription description;
+        SceneJsonReader::read(text, description);
+    });
+    RunStats binary = measure(repeat, [&]() {
+        SceneDescription description;
+        description.readBinary(cooked.data(), cooked.size());
+    });
+
+    report("dom   ", dom, text.size());
+    report("stream", sax, text.size());
+    report("binary", binary, text.size());
+    std::cout << "  stream vs dom: " << (sax.bestMs > 0.0 ? dom.bestMs / sax.bestMs : 0.0) << "x faster, "
+              << (sax.peakHeap > 0 ? static_cast<double>(dom.peakHeap) / sax.peakHeap : 0.0) << "x less heap"
+              << std::endl;
+    return 0;
+}
+
+#endif
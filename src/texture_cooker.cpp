@@ -0,0 +1,245 @@
+#ifdef LINUX_BUILD
+
+// Offline texture cooker. Decodes PNG/JPG sources, builds the full mip chain
+// and writes a block-compressed .btex next to each source (or into
+// --output-dir), which Texture::loadFromFile picks up in place of the
+// original. --check prints
+// the PSNR of every cooked level against the uncompressed chain; --selftest
+// runs the round trip on generated images and exits non-zero on failure.
+//
+// Usage:
+//   texture_cooker [--target linux|vita] [--output-dir DIR] [--normal] [--check] <image>...
+//   texture_cooker --selftest
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../vendor/tinygltf/stb_image.h"
+#include "../game_engine/include/Rendering/TextureCooker.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace GameEngine;
+
+// Squared error over the channels the format is meant to keep
+static void accumulateError(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, CookedTextureFormat format,
+                            double& sum, size_t& count) {
+    int channels = (format == CookedTextureFormat::BC5) ? 2 : (format == CookedTextureFormat::BC1 ? 3 : 4);
+    for (size_t i = 0; i + 3 < a.size() && i + 3 < b.size(); i += 4) {
+        for (int c = 0; c < channels; ++c) {
+            double d = static_cast<double>(a[i + c]) - b[i + c];
+            sum += d * d;
+            ++count;
+        }
+    }
+}
+
+static double toPSNR(double sum, size_t count) {
+    if (count == 0 || sum == 0.0) return 99.0;
+    return 10.0 * std::log10(255.0 * 255.0 * count / sum);
+}
+
+// PSNR of a whole cooked chain against the uncompressed one
+static double checkCooked(const std::vector<uint8_t>& file, const TextureCooker::Image& image, bool normalMap, bool verbose) {
+    CookedTextureHeader header;
+    std::vector<CookedMipLevel> mips;
+    if (!TextureCooker::parseHeader(file.data(), file.size(), header, mips)) {
+        std::cerr << "texture_cooker: Cooked header failed to parse" << std::endl;
+        return 0.0;
+    }
+    std::vector<TextureCooker::Image> reference;
+    TextureCooker::generateMipChain(image, normalMap, reference);
+    if (reference.size() != mips.size()) return 0.0;
+
+    CookedTextureFormat format = static_cast<CookedTextureFormat>(header.format);
+    double totalSum = 0.0;
+    size_t totalCount = 0;
+    for (size_t i = 0; i < mips.size(); ++i) {
+        std::vector<uint8_t> decoded;
+        if (!TextureCooker::decompress(file.data() + mips[i].offset, mips[i].size, format, mips[i].width, mips[i].height, decoded)) {
+            return 0.0;
+        }
+        double sum = 0.0;
+        size_t count = 0;
+        accumulateError(reference[i].pixels, decoded, format, sum, count);
+        totalSum += sum;
+        totalCount += count;
+        if (verbose) {
+            printf("    level %2zu %5ux%-5u %8u bytes  PSNR %.2f dB\n", i, mips[i].width, mips[i].height, mips[i].size, toPSNR(sum, count));
+        }
+    }
+    return toPSNR(totalSum, totalCount);
+}
+
+static size_t uncompressedChainBytes(int width, int height) {
+    size_t total = 0;
+    while (true) {
+        total += static_cast<size_t>(width) * height * 4;
+        if (width == 1 && height == 1) break;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+    return total;
+}
+
+static bool cookFile(const std::string& path, const std::string& outputDir, CookTarget target, bool forceNormal, bool check) {
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+    if (!pixels) {
+        std::cerr << "texture_cooker: Failed to load " << path << " - " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+    TextureCooker::Image image;
+    image.width = width;
+    image.height = height;
+    image.pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+    stbi_image_free(pixels);
+
+    bool normalMap = forceNormal || TextureCooker::isNormalMapPath(path);
+    CookedTextureFormat format = TextureCooker::chooseFormat(image, normalMap, target);
+    std::vector<uint8_t> file;
+    TextureCooker::cook(image, format, normalMap, file);
+
+    std::string outPath = TextureCooker::getCookedPath(path);
+    if (!outputDir.empty()) {
+        size_t slash = outPath.find_last_of("/\\");
+        outPath = outputDir + "/" + (slash == std::string::npos ? outPath : outPath.substr(slash + 1));
+    }
+    std::ofstream out(outPath.c_str(), std::ios::binary);
+    if (!out.is_open() || !out.write(reinterpret_cast<const char*>(file.data()), file.size())) {
+        std::cerr << "texture_cooker: Failed to write " << outPath << std::endl;
+        return false;
+    }
+
+    printf("%s: %dx%d %s%s, %zu KB (RGBA8 with mips %zu KB)\n", outPath.c_str(), width, height,
+           TextureCooker::getFormatName(format), normalMap ? " normal map" : "",
+           file.size() / 1024, uncompressedChainBytes(width, height) / 1024);
+    if (check) {
+        checkCooked(file, image, normalMap, true);
+    }
+    return true;
+}
+
+static TextureCooker::Image makeTestImage(int width, int height, int kind) {
+    TextureCooker::Image image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            uint8_t* p = &image.pixels[(static_cast<size_t>(y) * width + x) * 4];
+            float u = static_cast<float>(x) / width;
+            float v = static_cast<float>(y) / height;
+            if (kind == 2) {
+                // Tangent-space normals of a field of bumps
+                float nx = 0.5f * std::sin(u * 25.0f);
+                float ny = 0.5f * std::cos(v * 19.0f);
+                float length = std::sqrt(nx * nx + ny * ny + 1.0f);
+                p[0] = static_cast<uint8_t>((nx / length) * 127.5f + 127.5f);
+                p[1] = static_cast<uint8_t>((ny / length) * 127.5f + 127.5f);
+                p[2] = static_cast<uint8_t>((1.0f / length) * 127.5f + 127.5f);
+                p[3] = 255;
+            } else {
+                p[0] = static_cast<uint8_t>(255.0f * u);
+                p[1] = static_cast<uint8_t>(255.0f * v);
+                p[2] = static_cast<uint8_t>(127.5f + 127.0f * std::sin((u + v) * 6.0f));
+                p[3] = (kind == 1) ? static_cast<uint8_t>(255.0f * (1.0f - u)) : 255;
+            }
+        }
+    }
+    return image;
+}
+
+static bool runSelfTest() {
+    struct Case {
+        const char* name;
+        int kind;
+        bool normalMap;
+        CookTarget target;
+        CookedTextureFormat expected;
+        double minPSNR;
+    };
+    const Case cases[] = {
+        { "opaque", 0, false, CookTarget::LINUX, CookedTextureFormat::BC1, 30.0 },
+        { "alpha", 1, false, CookTarget::LINUX, CookedTextureFormat::BC3, 30.0 },
+        { "normal", 2, true, CookTarget::LINUX, CookedTextureFormat::BC5, 36.0 },
+        { "normal vita", 2, true, CookTarget::VITA, CookedTextureFormat::BC1, 28.0 },
+    };
+    const int sizes[2][2] = { { 256, 256 }, { 100, 37 } };
+
+    bool ok = true;
+    printf("Texture cooker self test\n");
+    for (size_t s = 0; s < 2; ++s) {
+        for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+            const Case& test = cases[c];
+            TextureCooker::Image image = makeTestImage(sizes[s][0], sizes[s][1], test.kind);
+            CookedTextureFormat format = TextureCooker::chooseFormat(image, test.normalMap, test.target);
+            std::vector<uint8_t> file;
+            TextureCooker::cook(image, format, test.normalMap, file);
+
+            double psnr = checkCooked(file, image, test.normalMap, false);
+            bool formatOk = (format == test.expected);
+            bool qualityOk = (psnr >= test.minPSNR);
+            bool caseOk = formatOk && qualityOk;
+            printf("  %-12s %4dx%-4d %-4s %7zu bytes  chain PSNR %.2f dB  %s\n", test.name,
+                   image.width, image.height, TextureCooker::getFormatName(format), file.size(), psnr,
+                   caseOk ? "OK" : "FAILED");
+            if (!formatOk) printf("    expected %s\n", TextureCooker::getFormatName(test.expected));
+            if (!qualityOk) printf("    below %.1f dB\n", test.minPSNR);
+            ok = caseOk && ok;
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    CookTarget target = CookTarget::LINUX;
+    bool forceNormal = false;
+    bool check = false;
+    std::string outputDir;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--selftest") {
+            return runSelfTest() ? 0 : 2;
+        } else if (arg == "--target" && i + 1 < argc) {
+            std::string value = argv[++i];
+            if (value == "linux") {
+                target = CookTarget::LINUX;
+            } else if (value == "vita") {
+                target = CookTarget::VITA;
+            } else {
+                std::cerr << "texture_cooker: Unknown target: " << value << std::endl;
+                return 1;
+            }
+        } else if (arg == "--output-dir" && i + 1 < argc) {
+            outputDir = argv[++i];
+        } else if (arg == "--normal") {
+            forceNormal = true;
+        } else if (arg == "--check") {
+            check = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "texture_cooker: Unknown argument: " << arg << std::endl;
+            return 1;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        std::cerr << "Usage: texture_cooker [--target linux|vita] [--output-dir DIR] [--normal] [--check] <image>..." << std::endl;
+        return 1;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        ok = cookFile(inputs[i], outputDir, target, forceNormal, check) && ok;
+    }
+    return ok ? 0 : 2;
+}
+
+#endif
@@ -0,0 +1,185 @@
+#ifdef LINUX_BUILD
+
+// Headless texture decode benchmark (no window, no GL context). Collects
+// every PNG/JPG under a directory, decodes the whole set with
+// ImageDecoder::decodeAll at each requested thread count and reports the wall
+// time against the single-threaded run. Every run's pixels are checksummed
+// against the serial decode; a mismatch or failed decode exits non-zero.
+//
+// Usage:
+//   texture_decode_bench [--threads 1,2,4,8] [--repeat N] [directory]
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "../vendor/tinygltf/stb_image.h"
+#include "../game_engine/include/Rendering/ImageDecoder.h"
+#include "LinearMath/btThreads.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GameEngine;
+
+static std::vector<std::string> findImages(const std::string& directory) {
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (std::filesystem::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file()) continue;
+        std::string extension = it->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension == ".png" || extension == ".jpg" || extension == ".jpeg") {
+            paths.push_back(it->path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+static uint64_t checksum(const std::vector<DecodedImage>& images) {
+    // FNV-1a over every image's size and pixels
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto& image : images) {
+        uint64_t values[3] = { static_cast<uint64_t>(image.width), static_cast<uint64_t>(image.height),
+                               static_cast<uint64_t>(image.channels) };
+        for (uint64_t value : values) {
+            hash = (hash ^ value) * 1099511628211ULL;
+        }
+        for (uint8_t byte : image.pixels) {
+            hash = (hash ^ byte) * 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+static double decodeOnce(const std::vector<std::string>& paths, std::vector<DecodedImage>& images) {
+    auto start = std::chrono::steady_clock::now();
+    ImageDecoder::decodeAll(paths, images);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::string directory = "assets/textures";
+    std::vector<int> threadCounts;
+    int repeat = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--threads" && hasValue) {
+            std::stringstream list(argv[++i]);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                int count = std::atoi(item.c_str());
+                if (count > 0) threadCounts.push_back(count);
+            }
+        } else if (arg == "--repeat" && hasValue) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::cerr << "texture_decode_bench: Unknown argument: " << arg << std::endl;
+            return 1;
+        } else {
+            directory = arg;
+        }
+    }
+
+    btITaskScheduler* scheduler = btCreateDefaultTaskScheduler();
+    int maxThreads = scheduler ? scheduler->getMaxNumThreads() : 1;
+    if (threadCounts.empty()) {
+        int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        for (int count = 1; count < hardware; count *= 2) {
+            threadCounts.push_back(count);
+        }
+        threadCounts.push_back(hardware);
+    }
+    // Speedups are against the serial decode, so it always runs first
+    if (std::find(threadCounts.begin(), threadCounts.end(), 1) == threadCounts.end()) {
+        threadCounts.push_back(1);
+    }
+    for (size_t t = 0; t < threadCounts.size(); ++t) {
+        if (threadCounts[t] > maxThreads) {
+            printf("texture_decode_bench: %d threads requested, scheduler has %d\n", threadCounts[t], maxThreads);
+            threadCounts[t] = maxThreads;
+        }
+    }
+    std::sort(threadCounts.begin(), threadCounts.end());
+    threadCounts.erase(std::unique(threadCounts.begin(), threadCounts.end()), threadCounts.end());
+    if (!scheduler) {
+        printf("texture_decode_bench: Bullet built without BT_THREADSAFE, running serially\n");
+    }
+
+    std::vector<std::string> paths = findImages(directory);
+    if (paths.empty()) {
+        std::cerr << "texture_decode_bench: No PNG/JPG files under " << directory << std::endl;
+        return 1;
+    }
+
+    // Serial reference decode, also warms the file cache
+    btSetTaskScheduler(btGetSequentialTaskScheduler());
+    std::vector<DecodedImage> reference;
+    decodeOnce(paths, reference);
+
+    bool ok = true;
+    size_t sourceBytes = 0;
+    size_t decodedBytes = 0;
+    for (const auto& image : reference) {
+        if (!image.isValid()) {
+            std::cerr << "texture_decode_bench: Failed to decode " << image.path << " - " << image.error << std::endl;
+            ok = false;
+        }
+        decodedBytes += image.pixels.size();
+    }
+    for (const auto& path : paths) {
+        std::error_code error;
+        sourceBytes += static_cast<size_t>(std::filesystem::file_size(path, error));
+    }
+    uint64_t referenceHash = checksum(reference);
+    reference.clear();
+
+    printf("Texture decode benchmark (%zu images, %.1f MB on disk, %.1f MB decoded, best of %d)\n",
+           paths.size(), sourceBytes / (1024.0 * 1024.0), decodedBytes / (1024.0 * 1024.0), repeat);
+    printf("  threads   wall ms   speedup   decoded MB/s   pixels\n");
+
+    double serialMs = 0.0;
+    for (size_t t = 0; t < threadCounts.size(); ++t) {
+        int threads = threadCounts[t];
+        if (threads > 1 && scheduler) {
+            scheduler->setNumThreads(threads);
+            btSetTaskScheduler(scheduler);
+        } else {
+            threads = 1;
+            btSetTaskScheduler(btGetSequentialTaskScheduler());
+        }
+
+        double bestMs = 0.0;
+        bool match = true;
+        for (int r = 0; r < repeat; ++r) {
+            std::vector<DecodedImage> images;
+            double ms = decodeOnce(paths, images);
+            bestMs = (r == 0) ? ms : std::min(bestMs, ms);
+            match = match && (checksum(images) == referenceHash);
+        }
+        if (threads == 1) {
+            serialMs = bestMs;
+        }
+        ok = ok && match;
+        printf("  %7d %9.1f %8.2fx %14.1f   %s\n", threads, bestMs,
+               serialMs > 0.0 ? serialMs / bestMs : 0.0,
+               decodedBytes / (1024.0 * 1024.0) / (bestMs / 1000.0),
+               match ? "OK" : "MISMATCH");
+    }
+
+    btSetTaskScheduler(btGetSequentialTaskScheduler());
+    delete scheduler;
+    return ok ? 0 : 2;
+}
+
+#endif